@@ -119,8 +119,12 @@ static int RealMain(int argc, char* argv[], vtkProcessModule::ProcessTypes type)
     pm->RegisterSession(session);
     if (controller->GetLocalProcessId() == 0)
     {
-      while (pm->GetNetworkAccessManager()->ProcessEvents(0) != -1)
+      // wake up in time to send the collaboration notifications that were
+      // held back to limit their rate.
+      while (pm->GetNetworkAccessManager()->ProcessEvents(
+               session->GetNotificationFlushTimeout()) != -1)
       {
+        session->FlushNotifications();
       }
     }
     else
@@ -0,0 +1,183 @@
+import os
+import shutil
+import tempfile
+import time
+
+from paraview import servermanager
+
+# Make sure the test driver know that process has properly started
+print ("Process started")
+
+PUSH = servermanager.vtkPVSessionServer.PUSH
+PULL = servermanager.vtkPVSessionServer.PULL
+EXECUTE_STREAM = servermanager.vtkPVSessionServer.EXECUTE_STREAM
+GATHER_INFORMATION = servermanager.vtkPVSessionServer.GATHER_INFORMATION
+PUSH_BATCH = servermanager.vtkPVSessionServer.PUSH_BATCH
+
+THRESHOLD = 1024
+
+
+def getHost(url):
+   return url.split(':')[1][2:]
+
+
+def getPort(url):
+   return int(url.split(':')[2])
+
+
+def printStatistics(session, type):
+    print("%s: %d messages, %d (%d) bytes sent, %d (%d) bytes received" % (
+        session.GetMessageTypeName(type), session.GetNumberOfMessages(type),
+        session.GetBytesSent(type), session.GetUncompressedBytesSent(type),
+        session.GetBytesReceived(type), session.GetUncompressedBytesReceived(type)))
+
+
+def assertCompressedSent(session, type):
+    printStatistics(session, type)
+    assert session.GetNumberOfMessages(type) > 0
+    assert session.GetUncompressedBytesSent(type) >= THRESHOLD
+    assert session.GetBytesSent(type) < session.GetUncompressedBytesSent(type) // 2
+
+
+def assertCompressedReceived(session, type):
+    printStatistics(session, type)
+    assert session.GetNumberOfMessages(type) > 0
+    assert session.GetUncompressedBytesReceived(type) >= THRESHOLD
+    assert session.GetBytesReceived(type) < session.GetUncompressedBytesReceived(type) // 2
+
+
+def newProxy(pxm, group, name):
+    proxy = pxm.NewProxy(group, name)
+    proxy.UpdateVTKObjects()
+    return proxy
+
+
+def testCompression(session, pxm):
+    """Large payloads sent and received in each direction are compressed."""
+    session.SetCoalescingWindow(0)
+    session.ResetMessageStatistics()
+
+    # a large property value is pushed as is.
+    text = newProxy(pxm, "sources", "VectorText")
+    text.GetProperty("Text").SetElement(0, "ParaView " * 4096)
+    text.UpdateVTKObjects()
+    assertCompressedSent(session, PUSH)
+
+    # a large stream executed on the servers.
+    documentation = "The definition is large enough to be compressed. " * 1024
+    assert pxm.LoadConfigurationXML(
+        '<ServerManagerConfiguration><ProxyGroup name="channel_compression">'
+        '<SourceProxy name="LargeDefinition" class="vtkSphereSource">'
+        '<Documentation>%s</Documentation>'
+        '</SourceProxy></ProxyGroup></ServerManagerConfiguration>' % documentation)
+    assertCompressedSent(session, EXECUTE_STREAM)
+
+    # the state pulled from the server holds all the proxy definitions,
+    # including the one just loaded.
+    definitions = pxm.GetProxyDefinitionManager()
+    definitions.SynchronizeDefinitions()
+    assert definitions.HasDefinition("channel_compression", "LargeDefinition")
+    assertCompressedReceived(session, PULL)
+
+
+def testGatherInformation(session, pxm):
+    """Large gathered information is compressed, pending pushes are flushed
+    before the information is gathered."""
+    directory = tempfile.mkdtemp()
+    try:
+        for i in range(400):
+            open(os.path.join(directory, "channel_compression_file_%03d.txt" % i), "w").close()
+
+        helper = newProxy(pxm, "misc", "FileInformationHelper")
+        session.SetCoalescingWindow(3600)
+        session.ResetMessageStatistics()
+        helper.GetProperty("DirectoryListing").SetElement(0, True)
+        helper.GetProperty("Path").SetElement(0, directory)
+        helper.GetProperty("GroupFileSequences").SetElement(0, False)
+        helper.UpdateVTKObjects()
+        assert session.GetNumberOfMessages(PUSH) == 0
+        assert session.GetNumberOfMessages(PUSH_BATCH) == 0
+
+        info = servermanager.vtkPVFileInformation()
+        helper.GatherInformation(info)
+        assert session.GetNumberOfMessages(PUSH_BATCH) == 1
+        assert info.GetContents().GetNumberOfItems() == 400
+        assertCompressedReceived(session, GATHER_INFORMATION)
+    finally:
+        shutil.rmtree(directory)
+
+
+def testCoalescing(session, pxm):
+    """Pushes and streams without a reply are held within the coalescing
+    window and sent, in order, before the next request expecting a reply."""
+    source = newProxy(pxm, "sources", "SpatioTemporalHarmonicsSource")
+    source.UpdatePipelineInformation()
+
+    windows = []
+    tag = session.AddObserver(session.CoalescingWindowOpenedEvent,
+        lambda obj, event: windows.append(event))
+    session.SetCoalescingWindow(3600)
+    session.ResetMessageStatistics()
+
+    values = [0.5, 1.5, 2.5]
+    property = source.GetProperty("TimeStepValuesToGenerate")
+    property.SetNumberOfElements(len(values))
+    for i, value in enumerate(values):
+        property.SetElement(i, value)
+    source.UpdateVTKObjects()
+    source.GetProperty("WholeExtent").SetElement(1, 12)
+    source.UpdateVTKObjects()
+    assert session.GetNumberOfMessages(PUSH) == 0
+    assert session.GetNumberOfMessages(PUSH_BATCH) == 0
+    assert len(windows) == 1
+
+    # the held pushes, and the stream updating the pipeline information, reach
+    # the server before the time steps are pulled.
+    source.UpdatePipelineInformation()
+    assert session.GetNumberOfMessages(PUSH_BATCH) == 1
+    assert session.GetNumberOfMessages(PULL) > 0
+    timesteps = source.GetProperty("TimestepValues")
+    assert [timesteps.GetElement(i) for i in range(timesteps.GetNumberOfElements())] == values
+
+    # messages held for longer than the window are sent with the next one.
+    session.SetCoalescingWindow(0.2)
+    session.ResetMessageStatistics()
+    source.GetProperty("WholeExtent").SetElement(1, 14)
+    source.UpdateVTKObjects()
+    time.sleep(0.3)
+    source.GetProperty("WholeExtent").SetElement(1, 16)
+    source.UpdateVTKObjects()
+    assert session.GetNumberOfMessages(PUSH_BATCH) == 1
+    assert len(windows) == 2
+
+    # FlushMessages() sends the rest.
+    source.GetProperty("WholeExtent").SetElement(1, 18)
+    source.UpdateVTKObjects()
+    session.FlushMessages()
+    assert session.GetNumberOfMessages(PUSH_BATCH) == 2
+    session.RemoveObserver(tag)
+    session.SetCoalescingWindow(0)
+
+
+def runTest():
+    options = servermanager.vtkRemotingCoreConfiguration.GetInstance()
+    url = options.GetServerURL()
+    connection = servermanager.Connect(getHost(url), getPort(url))
+    session = connection.Session
+    assert session.IsA("vtkSMSessionClient")
+
+    # compression and coalescing are off by default.
+    assert session.GetCompressionThreshold() == 0
+    assert session.GetCoalescingWindow() == 0
+
+    session.SetCompressionThreshold(THRESHOLD)
+    pxm = session.GetSessionProxyManager()
+    testCompression(session, pxm)
+    testGatherInformation(session, pxm)
+    testCoalescing(session, pxm)
+
+    servermanager.Disconnect(connection)
+
+
+if __name__ == "__main__":
+    runTest()
@@ -0,0 +1,78 @@
+import time
+
+from paraview import servermanager
+
+# Make sure the test driver know that process has properly started
+print ("Process started")
+
+
+def getHost(url):
+   return url.split(':')[1][2:]
+
+
+def getPort(url):
+   return int(url.split(':')[2])
+
+
+def waitFor(condition, timeout=10):
+    """Processes the server notifications until `condition` is met."""
+    nam = servermanager.vtkProcessModule.GetProcessModule().GetNetworkAccessManager()
+    end = time.time() + timeout
+    while not condition() and time.time() < end:
+        nam.ProcessEvents(50)
+    return condition()
+
+
+def setRadius(sphere, value):
+    sphere.GetProperty("Radius").SetElement(0, value)
+    sphere.UpdateVTKObjects()
+
+
+def getRadius(sphere):
+    return sphere.GetProperty("Radius").GetElement(0)
+
+
+def runTest():
+    options = servermanager.vtkRemotingCoreConfiguration.GetInstance()
+    url = options.GetServerURL()
+
+    # two clients collaborate on the same server.
+    servermanager.vtkProcessModule.GetProcessModule().SetMultipleSessionsSupport(True)
+    first = servermanager.Connect(getHost(url), getPort(url))
+    second = servermanager.Connect(getHost(url), getPort(url))
+    assert first.Session.IsMultiClients() and second.Session.IsMultiClients()
+
+    firstPxm = first.Session.GetSessionProxyManager()
+    secondPxm = second.Session.GetSessionProxyManager()
+    firstSphere = firstPxm.NewProxy("sources", "SphereSource")
+    firstPxm.RegisterProxy("sources", "sphere", firstSphere)
+    assert waitFor(lambda: secondPxm.GetProxy("sources", "sphere") is not None)
+    secondSphere = secondPxm.GetProxy("sources", "sphere")
+
+    changes = []
+    secondSphere.GetProperty("Radius").AddObserver(
+        "ModifiedEvent", lambda obj, event: changes.append(obj.GetElement(0)))
+
+    # the updates made within the notification interval are merged, and the
+    # last one is always delivered.
+    for value in range(1, 21):
+        setRadius(firstSphere, value)
+    assert waitFor(lambda: getRadius(secondSphere) == 20)
+    assert 1 <= len(changes) < 20
+    assert changes[-1] == 20
+
+    # a client is not notified of the values it pushed, but still receives
+    # the ones pushed afterwards by the other client.
+    del changes[:]
+    setRadius(secondSphere, 3)
+    assert waitFor(lambda: getRadius(firstSphere) == 3)
+    setRadius(firstSphere, 20)
+    assert waitFor(lambda: getRadius(secondSphere) == 20)
+    assert changes == [3, 20]
+
+    servermanager.Disconnect(second)
+    servermanager.Disconnect(first)
+
+
+if __name__ == "__main__":
+    runTest()
@@ -0,0 +1,77 @@
+from paraview import servermanager
+from paraview import simple as smp
+from paraview.vtk import vtkDataObject
+
+# Make sure the test driver know that process has properly started
+print ("Process started")
+
+
+def getHost(url):
+   return url.split(':')[1][2:]
+
+
+def getPort(url):
+   return int(url.split(':')[2])
+
+
+def getDeliveredData(display):
+    representation = display.GetClientSideObject().GetActiveRepresentation()
+    return representation.GetActor().GetMapper().GetInputDataObject(0, 0)
+
+
+def getProcessIds(dataObject):
+    if dataObject.IsA("vtkCompositeDataSet"):
+        ids = []
+        iterator = dataObject.NewIterator()
+        iterator.InitTraversal()
+        while not iterator.IsDoneWithTraversal():
+            ids += getProcessIds(iterator.GetCurrentDataObject())
+            iterator.GoToNextItem()
+        return ids
+    array = dataObject.GetCellData().GetArray("ProcessId")
+    return [int(array.GetValue(i)) for i in range(array.GetNumberOfTuples())]
+
+
+def deliver(sphere, display, resolution):
+    sphere.ThetaResolution = resolution
+    smp.Render()
+    dataObject = getDeliveredData(display)
+    numberOfCells = dataObject.GetNumberOfElements(vtkDataObject.CELL)
+    assert numberOfCells == sphere.GetDataInformation().GetNumberOfCells()
+    return getProcessIds(dataObject)
+
+
+def runTest():
+    options = servermanager.vtkRemotingCoreConfiguration.GetInstance()
+    url = options.GetServerURL()
+    smp.Connect(getHost(url), getPort(url))
+
+    session = servermanager.ActiveConnection.Session
+    assert session.GetNumberOfProcesses(session.DATA_SERVER) == 2
+    assert session.GetStripedDeliveryConnection() is None
+
+    # render on the client so that the geometry is collected to it.
+    view = smp.CreateRenderView()
+    view.RemoteRenderThreshold = 1000
+    sphere = smp.Sphere(PhiResolution=32)
+    processIds = smp.ProcessIds(Input=sphere)
+    display = smp.Show(processIds, view)
+
+    # the pieces of both ranks are gathered on the root, in rank order.
+    gathered = deliver(sphere, display, 32)
+    assert set(gathered) == set([0, 1])
+    assert gathered == sorted(gathered)
+
+    # striped delivery sends the same pieces, merged in the same order.
+    assert session.SetupStripedDeliveryConnection(2)
+    assert session.GetStripedDeliveryConnection() is not None
+    assert session.GetStripedDeliveryConnection().GetNumberOfSocketCommunicators() == 2
+
+    assert set(deliver(sphere, display, 16)) == set([0, 1])
+    assert deliver(sphere, display, 32) == gathered
+
+    smp.Disconnect()
+
+
+if __name__ == "__main__":
+    runTest()
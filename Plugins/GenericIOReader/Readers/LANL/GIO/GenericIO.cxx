@@ -53,10 +53,13 @@ extern "C" {
 #include <cassert>
 #include <cstddef>
 #include <cstring>
+#include <deque>
 #include <fstream>
+#include <future>
 #include <iterator>
 #include <sstream>
 #include <stdexcept>
+#include <thread>
 
 #ifndef LANL_GENERICIO_NO_MPI
 #include <ctime>
@@ -139,7 +142,7 @@ using namespace std;
 namespace gio
 {
 
-#ifndef LANL_GENERICIO_NO_MPI
+#ifdef LANL_GENERICIO_USE_MPIIO
 GenericFileIO_MPI::~GenericFileIO_MPI()
 {
   (void)MPI_File_close(&FH);
@@ -150,8 +153,23 @@ void GenericFileIO_MPI::open(const std::string& FN, bool ForReading)
   FileName = FN;
 
   int amode = ForReading ? MPI_MODE_RDONLY : (MPI_MODE_WRONLY | MPI_MODE_CREATE);
-  if (MPI_File_open(Comm, const_cast<char*>(FileName.c_str()), amode, MPI_INFO_NULL, &FH) !=
-    MPI_SUCCESS)
+
+  MPI_Info Info = MPI_INFO_NULL;
+  if (ForReading && NumAggregators > 0)
+  {
+    stringstream ss;
+    ss << NumAggregators;
+
+    MPI_Info_create(&Info);
+    MPI_Info_set(Info, const_cast<char*>("cb_nodes"), const_cast<char*>(ss.str().c_str()));
+    MPI_Info_set(Info, const_cast<char*>("romio_cb_read"), const_cast<char*>("enable"));
+  }
+
+  int Err = MPI_File_open(Comm, const_cast<char*>(FileName.c_str()), amode, Info, &FH);
+  if (Info != MPI_INFO_NULL)
+    MPI_Info_free(&Info);
+
+  if (Err != MPI_SUCCESS)
     throw runtime_error(
       (!ForReading ? "Unable to create the file: " : "Unable to open the file: ") + FileName);
 }
@@ -1079,11 +1097,18 @@ void GenericIO::openAndReadHeader(MismatchBehavior MB, int EffRank, bool CheckPa
 
   if (SplitRank == 0)
   {
+#ifdef LANL_GENERICIO_USE_MPIIO
 #ifndef LANL_GENERICIO_NO_MPI
+    MPI_Comm OpenComm = MPI_COMM_SELF;
+#else
+    // Without MPI, the file stays open to read the data. A file without rank
+    // map is shared by the ranks of FileComm, which read it collectively.
+    MPI_Comm OpenComm = RankMap.empty() ? FileComm : MPI_COMM_SELF;
+#endif
     if (FileIOType == FileIOMPI)
-      FH.get() = new GenericFileIO_MPI(MPI_COMM_SELF);
+      FH.get() = new GenericFileIO_MPI(OpenComm, NumAggregators);
     else if (FileIOType == FileIOMPICollective)
-      FH.get() = new GenericFileIO_MPICollective(MPI_COMM_SELF);
+      FH.get() = new GenericFileIO_MPICollective(OpenComm, NumAggregators);
     else
 #endif
       FH.get() = new GenericFileIO_POSIX();
@@ -1161,9 +1186,9 @@ void GenericIO::openAndReadHeader(MismatchBehavior MB, int EffRank, bool CheckPa
     MPI_Barrier(Comm);
 
   if (FileIOType == FileIOMPI)
-    FH.get() = new GenericFileIO_MPI(SplitComm);
+    FH.get() = new GenericFileIO_MPI(SplitComm, NumAggregators);
   else if (FileIOType == FileIOMPICollective)
-    FH.get() = new GenericFileIO_MPICollective(SplitComm);
+    FH.get() = new GenericFileIO_MPICollective(SplitComm, NumAggregators);
   else
     FH.get() = new GenericFileIO_POSIX();
 
@@ -1417,9 +1442,45 @@ size_t GenericIO::readNumElems(int EffRank)
   return (size_t)RH->NElems;
 }
 
+// Throws if the type of the variable V does not match the one stored in the file.
+template <bool IsBigEndian>
+static void checkVariableType(
+  VariableHeader<IsBigEndian>* VH, const GenericIO::Variable& V, const string& OpenFileName)
+{
+  bool IsFloat = (VH->Flags & FloatValue) != 0, IsSigned = (VH->Flags & SignedValue) != 0;
+  if (VH->Size != V.Size)
+  {
+    stringstream ss;
+    ss << "Size mismatch for variable " << V.Name << " in: " << OpenFileName
+       << ": current: " << V.Size << ", file: " << VH->Size;
+    throw runtime_error(ss.str());
+  }
+  else if (IsFloat != V.IsFloat)
+  {
+    string Float("float"), Int("integer");
+    stringstream ss;
+    ss << "Type mismatch for variable " << V.Name << " in: " << OpenFileName
+       << ": current: " << (V.IsFloat ? Float : Int) << ", file: " << (IsFloat ? Float : Int);
+    throw runtime_error(ss.str());
+  }
+  else if (IsSigned != V.IsSigned)
+  {
+    string Signed("signed"), Uns("unsigned");
+    stringstream ss;
+    ss << "Type mismatch for variable " << V.Name << " in: " << OpenFileName
+       << ": current: " << (V.IsSigned ? Signed : Uns) << ", file: " << (IsSigned ? Signed : Uns);
+    throw runtime_error(ss.str());
+  }
+}
+
 void GenericIO::readDataSection(size_t readOffset, size_t readNumRows, int EffRank,
   size_t RowOffset, int Rank, uint64_t& TotalReadSize, int NErrs[3])
 {
+  if (AggregateReads &&
+    readAggregated(
+      true, readOffset, readNumRows, EffRank, RowOffset, Rank, TotalReadSize, NErrs))
+    return;
+
   if (FH.isBigEndian())
     readDataSection<true>(readOffset, readNumRows, EffRank, RowOffset, Rank, TotalReadSize, NErrs);
   else
@@ -1561,32 +1622,7 @@ void GenericIO::readDataSection(size_t readOffset, size_t readNumRows, int EffRa
       }
 
       VarFound = true;
-      bool IsFloat = (VH->Flags & FloatValue) != 0, IsSigned = (VH->Flags & SignedValue) != 0;
-      if (VH->Size != Vars[i].Size)
-      {
-        stringstream ss;
-        ss << "Size mismatch for variable " << Vars[i].Name << " in: " << OpenFileName
-           << ": current: " << Vars[i].Size << ", file: " << VH->Size;
-        throw runtime_error(ss.str());
-      }
-      else if (IsFloat != Vars[i].IsFloat)
-      {
-        string Float("float"), Int("integer");
-        stringstream ss;
-        ss << "Type mismatch for variable " << Vars[i].Name << " in: " << OpenFileName
-           << ": current: " << (Vars[i].IsFloat ? Float : Int)
-           << ", file: " << (IsFloat ? Float : Int);
-        throw runtime_error(ss.str());
-      }
-      else if (IsSigned != Vars[i].IsSigned)
-      {
-        string Signed("signed"), Uns("unsigned");
-        stringstream ss;
-        ss << "Type mismatch for variable " << Vars[i].Name << " in: " << OpenFileName
-           << ": current: " << (Vars[i].IsSigned ? Signed : Uns)
-           << ", file: " << (IsSigned ? Signed : Uns);
-        throw runtime_error(ss.str());
-      }
+      checkVariableType(VH, Vars[i], OpenFileName);
 
       size_t VarOffset = RowOffset * Vars[i].Size;
       void* VarData = ((char*)Vars[i].Data) + VarOffset;
@@ -1699,6 +1735,375 @@ void GenericIO::readDataSection(size_t readOffset, size_t readNumRows, int EffRa
   }
 }
 
+struct GenericIO::ReadExtent
+{
+  size_t Var;
+  uint64_t Offset;
+  // Number of bytes read, including the CRC trailer when CheckCRC is set.
+  uint64_t Size;
+  char* Dest;
+  bool CheckCRC;
+  char CRC[CRCSize];
+};
+
+bool GenericIO::readWithRetries(void* Buf, size_t Count, uint64_t Offset, const string& D)
+{
+  int RetryCount = 300;
+  const char* EnvStr = getenv("GENERICIO_RETRY_COUNT");
+  if (EnvStr)
+    RetryCount = atoi(EnvStr);
+
+  int RetrySleep = 100; // ms
+  EnvStr = getenv("GENERICIO_RETRY_SLEEP");
+  if (EnvStr)
+    RetrySleep = atoi(EnvStr);
+
+  int Retry = 0;
+  for (; Retry < RetryCount; ++Retry)
+  {
+    try
+    {
+      FH.get()->read(Buf, Count, static_cast<off_t>(Offset), D);
+      break;
+    }
+    catch (...)
+    {
+    }
+
+    usleep(1000 * RetrySleep);
+  }
+
+  if (Retry == RetryCount)
+    return false;
+
+  if (Retry > 0)
+  {
+    EnvStr = getenv("GENERICIO_VERBOSE");
+    if (EnvStr && atoi(EnvStr) > 0)
+    {
+      int RankTmp;
+#ifndef LANL_GENERICIO_NO_MPI
+      MPI_Comm_rank(MPI_COMM_WORLD, &RankTmp);
+#else
+      RankTmp = 0;
+#endif
+
+      std::cerr << "Rank " << RankTmp << ": " << Retry << " I/O retries were necessary for reading "
+                << D << " from: " << OpenFileName << "\n";
+      std::cerr.flush();
+    }
+  }
+
+  return true;
+}
+
+bool GenericIO::readAggregated(bool Section, size_t readOffset, size_t readNumRows, int EffRank,
+  size_t RowOffset, int Rank, uint64_t& TotalReadSize, int NErrs[3])
+{
+  openAndReadHeader(Redistributing ? MismatchRedistribute : MismatchAllowed, EffRank, false);
+
+  vector<ReadExtent> Extents;
+  int Supported = FH.isBigEndian()
+    ? gatherReadExtents<true>(
+        Section, readOffset, readNumRows, EffRank, RowOffset, Rank, Extents)
+    : gatherReadExtents<false>(
+        Section, readOffset, readNumRows, EffRank, RowOffset, Rank, Extents);
+#ifdef LANL_GENERICIO_USE_MPIIO
+  // Collective reads require all the ranks to take the same path.
+  MPI_Comm CollComm = getCollectiveReadComm();
+  if (CollComm != MPI_COMM_NULL)
+  {
+    int AllSupported;
+    MPI_Allreduce(&Supported, &AllSupported, 1, MPI_INT, MPI_MIN, CollComm);
+    Supported = AllSupported;
+  }
+#ifdef LANL_GENERICIO_NO_MPI
+  // Variables read one at a time issue a number of reads that the other
+  // ranks cannot match.
+  if (!Supported && CollComm != MPI_COMM_NULL)
+    throw runtime_error("Filtered variables cannot be read collectively from: " + OpenFileName);
+#endif
+#endif
+  if (!Supported)
+    return false;
+
+  readExtents(Extents, FH.isBigEndian() != isBigEndian(), TotalReadSize, NErrs);
+  return true;
+}
+
+void GenericIO::readEmptySection()
+{
+#ifdef LANL_GENERICIO_USE_MPIIO
+  MPI_Comm CollComm = getCollectiveReadComm();
+  if (!AggregateReads || CollComm == MPI_COMM_NULL)
+    return;
+
+  // Matches the steps of readAggregated() on the ranks reading a block.
+  int Supported = 1, AllSupported;
+  MPI_Allreduce(&Supported, &AllSupported, 1, MPI_INT, MPI_MIN, CollComm);
+  if (!AllSupported)
+    throw runtime_error("Filtered variables cannot be read collectively from: " + OpenFileName);
+
+  vector<ReadExtent> Extents;
+  uint64_t TotalReadSize = 0;
+  int NErrs[3] = { 0, 0, 0 };
+  readExtents(Extents, false, TotalReadSize, NErrs);
+#endif
+}
+
+#ifdef LANL_GENERICIO_USE_MPIIO
+MPI_Comm GenericIO::getCollectiveReadComm() const
+{
+  if (FileIOType != FileIOMPICollective)
+    return MPI_COMM_NULL;
+#ifndef LANL_GENERICIO_NO_MPI
+  return DisableCollErrChecking ? MPI_COMM_NULL : SplitComm;
+#else
+  return FileComm == MPI_COMM_SELF ? MPI_COMM_NULL : FileComm;
+#endif
+}
+#endif
+
+// Collects the extents of the requested variables for the rank block EffRank.
+// Returns false if one of them is stored with a filter, in which case the
+// variables must be read one at a time.
+template <bool IsBigEndian>
+bool GenericIO::gatherReadExtents(bool Section, size_t readOffset, size_t readNumRows,
+  int EffRank, size_t RowOffset, int Rank, vector<ReadExtent>& Extents)
+{
+  assert(FH.getHeaderCache().size() && "HeaderCache must not be empty");
+
+  if (EffRank == -1)
+    EffRank = Rank;
+
+  GlobalHeader<IsBigEndian>* GH = (GlobalHeader<IsBigEndian>*)&FH.getHeaderCache()[0];
+  size_t RankIndex = getRankIndex<IsBigEndian>(EffRank, GH, RankMap, FH.getHeaderCache());
+
+  assert(RankIndex < GH->NRanks && "Invalid rank specified");
+
+  RankHeader<IsBigEndian>* RH =
+    (RankHeader<IsBigEndian>*)&FH.getHeaderCache()[GH->RanksStart + RankIndex * GH->RanksSize];
+
+  // A section covering the whole rank block is read with its CRC.
+  bool WholeBlock = !Section || (readOffset == 0 && readNumRows == RH->NElems);
+  bool HasBlocks = offsetof_safe(GH, BlocksStart) < GH->GlobalHeaderSize && GH->BlocksSize > 0;
+
+  for (size_t i = 0; i < Vars.size(); ++i)
+  {
+    uint64_t Offset = RH->Start;
+    bool VarFound = false;
+    for (uint64_t j = 0; j < GH->NVars; ++j)
+    {
+      VariableHeader<IsBigEndian>* VH =
+        (VariableHeader<IsBigEndian>*)&FH.getHeaderCache()[GH->VarsStart + j * GH->VarsSize];
+
+      string VName(VH->Name, VH->Name + NameSize);
+      size_t VNameNull = VName.find('\0');
+      if (VNameNull < NameSize)
+        VName.resize(VNameNull);
+
+      uint64_t ReadSize = RH->NElems * VH->Size + CRCSize;
+      if (VName != Vars[i].Name)
+      {
+        Offset += ReadSize;
+        continue;
+      }
+
+      VarFound = true;
+      checkVariableType(VH, Vars[i], OpenFileName);
+
+      if (HasBlocks)
+      {
+        BlockHeader<IsBigEndian>* BH =
+          (BlockHeader<IsBigEndian>*)&FH
+            .getHeaderCache()[GH->BlocksStart + (RankIndex * GH->NVars + j) * GH->BlocksSize];
+        if (BH->Filters[0][0] != '\0')
+          return false;
+
+        ReadSize = BH->Size + CRCSize;
+        Offset = BH->Start;
+      }
+
+      ReadExtent E;
+      E.Var = i;
+      E.Dest = ((char*)Vars[i].Data) + RowOffset * Vars[i].Size;
+      E.CheckCRC = WholeBlock;
+      E.Offset = WholeBlock ? Offset : Offset + readOffset * VH->Size;
+      E.Size = WholeBlock ? ReadSize : readNumRows * VH->Size;
+      Extents.push_back(E);
+      break;
+    }
+
+    if (!VarFound)
+      throw runtime_error("Variable " + Vars[i].Name + " not found in: " + OpenFileName);
+  }
+
+  return true;
+}
+
+// Reads the extents using as few requests as possible. Extents are sorted by
+// file offset and merged into runs when they are less than AggregateGap bytes
+// apart. A run made of a single extent is read in place; otherwise it is
+// read into a staging buffer and its extents are copied out. Either way, the
+// CRC trailers are kept aside and the variables need no extra space. The
+// CRC of each extent is verified asynchronously, so that checksumming
+// overlaps with the reads that follow.
+void GenericIO::readExtents(
+  vector<ReadExtent>& Extents, bool SwapBytes, uint64_t& TotalReadSize, int NErrs[3])
+{
+  sort(Extents.begin(), Extents.end(),
+    [](const ReadExtent& A, const ReadExtent& B) { return A.Offset < B.Offset; });
+
+  // Each run is a range [first, last) of Extents.
+  vector<pair<size_t, size_t>> Runs;
+  for (size_t i = 0; i < Extents.size(); ++i)
+  {
+    if (!Runs.empty())
+    {
+      const ReadExtent& First = Extents[Runs.back().first];
+      const ReadExtent& Last = Extents[i - 1];
+      uint64_t LastEnd = Last.Offset + Last.Size;
+      uint64_t End = max(LastEnd, Extents[i].Offset + Extents[i].Size);
+      if (Extents[i].Offset <= LastEnd + AggregateGap &&
+        End - First.Offset <= (uint64_t)MaxAggregateSize)
+      {
+        Runs.back().second = i + 1;
+        continue;
+      }
+    }
+
+    Runs.push_back(make_pair(i, i + 1));
+  }
+
+  // With collective I/O, all the ranks of the communicator must issue the
+  // same number of requests.
+  size_t NumRequests = Runs.size();
+  for (size_t r = 0; r < Runs.size(); ++r)
+    if (Runs[r].second - Runs[r].first == 1 && Extents[Runs[r].first].CheckCRC)
+      ++NumRequests;
+  size_t MaxNumRequests = NumRequests;
+#ifdef LANL_GENERICIO_USE_MPIIO
+  MPI_Comm CollComm = getCollectiveReadComm();
+  if (CollComm != MPI_COMM_NULL)
+  {
+    unsigned long long LocalCount = NumRequests, MaxCount;
+    MPI_Allreduce(&LocalCount, &MaxCount, 1, MPI_UNSIGNED_LONG_LONG, MPI_MAX, CollComm);
+    MaxNumRequests = (size_t)MaxCount;
+  }
+#endif
+
+  size_t MaxPending = max(1u, thread::hardware_concurrency());
+  deque<pair<size_t, future<bool>>> Pending;
+  // 1 for extents which could not be read, 2 for the ones with a bad CRC.
+  vector<char> Failed(Extents.size(), 0);
+  auto waitOldest = [&]() {
+    if (!Pending.front().second.get())
+      Failed[Pending.front().first] = 2;
+    Pending.pop_front();
+  };
+
+  auto complete = [&](size_t k) {
+    ReadExtent& E = Extents[k];
+    if (!E.CheckCRC || !VerifyCRC)
+      return;
+
+    while (Pending.size() >= MaxPending)
+      waitOldest();
+
+    const char* Data = E.Dest;
+    size_t DataSize = E.Size - CRCSize;
+    const char* Expected = E.CRC;
+    Pending.push_back(make_pair(k, async(launch::async, [Data, DataSize, Expected]() {
+      unsigned char CRC[CRCSize];
+      crc64_invert(crc64_omp(Data, DataSize), CRC);
+      return memcmp(CRC, Expected, CRCSize) == 0;
+    })));
+  };
+
+  vector<char> Staging;
+  for (size_t r = 0; r < Runs.size(); ++r)
+  {
+    size_t First = Runs[r].first, Last = Runs[r].second;
+    ReadExtent& FE = Extents[First];
+    if (Last - First == 1)
+    {
+      // The CRC trailer is read separately, so that no extra space is needed.
+      size_t DataSize = FE.CheckCRC ? FE.Size - CRCSize : FE.Size;
+      bool Ok = readWithRetries(FE.Dest, DataSize, FE.Offset, Vars[FE.Var].Name);
+      if (FE.CheckCRC)
+        Ok = readWithRetries(FE.CRC, CRCSize, FE.Offset + DataSize, Vars[FE.Var].Name) && Ok;
+      if (!Ok)
+      {
+        ++NErrs[0];
+        Failed[First] = 1;
+        continue;
+      }
+
+      TotalReadSize += FE.Size;
+      complete(First);
+      continue;
+    }
+
+    uint64_t RunSize = 0;
+    for (size_t k = First; k < Last; ++k)
+      RunSize = max(RunSize, Extents[k].Offset + Extents[k].Size - FE.Offset);
+
+    Staging.resize(RunSize);
+    if (!readWithRetries(&Staging[0], RunSize, FE.Offset, "aggregated variables"))
+    {
+      ++NErrs[0];
+      std::fill(Failed.begin() + First, Failed.begin() + Last, 1);
+      continue;
+    }
+
+    TotalReadSize += RunSize;
+    for (size_t k = First; k < Last; ++k)
+    {
+      ReadExtent& E = Extents[k];
+      const char* Src = &Staging[E.Offset - FE.Offset];
+      size_t DataSize = E.CheckCRC ? E.Size - CRCSize : E.Size;
+      std::copy(Src, Src + DataSize, E.Dest);
+      if (E.CheckCRC)
+        std::copy(Src + DataSize, Src + E.Size, E.CRC);
+      complete(k);
+    }
+  }
+
+  // Pad with empty requests to match the ranks reading more runs.
+  for (size_t r = NumRequests; r < MaxNumRequests; ++r)
+  {
+    char Dummy;
+    FH.get()->read(&Dummy, 0, 0, "padding");
+  }
+
+  while (!Pending.empty())
+    waitOldest();
+
+  for (size_t k = 0; k < Extents.size(); ++k)
+  {
+    ReadExtent& E = Extents[k];
+    if (Failed[k])
+    {
+      if (Failed[k] == 2)
+      {
+        ++NErrs[1];
+        std::cerr << "CRC error reading: " << Vars[E.Var].Name << " from: " << OpenFileName
+                  << " (offset: " << E.Offset << ", size: " << E.Size << " bytes)\n";
+      }
+      continue;
+    }
+
+    // Byte swap the data if necessary.
+    if (SwapBytes)
+    {
+      size_t Size = Vars[E.Var].Size;
+      size_t NumElems = (E.CheckCRC ? E.Size - CRCSize : E.Size) / Size;
+      for (size_t n = 0; n < NumElems; ++n)
+        bswap(E.Dest + n * Size, Size);
+    }
+  }
+}
+
 void GenericIO::readCoords(int Coords[3], int EffRank)
 {
   if (EffRank == -1 && Redistributing)
@@ -1835,6 +2240,10 @@ void GenericIO::readData(int EffRank, bool PrintStats, bool CollStats)
 void GenericIO::readData(
   int EffRank, size_t RowOffset, int Rank, uint64_t& TotalReadSize, int NErrs[3])
 {
+  if (AggregateReads &&
+    readAggregated(false, 0, 0, EffRank, RowOffset, Rank, TotalReadSize, NErrs))
+    return;
+
   if (FH.isBigEndian())
     readData<true>(EffRank, RowOffset, Rank, TotalReadSize, NErrs);
   else
@@ -1884,32 +2293,7 @@ void GenericIO::readData(
       }
 
       VarFound = true;
-      bool IsFloat = (VH->Flags & FloatValue) != 0, IsSigned = (VH->Flags & SignedValue) != 0;
-      if (VH->Size != Vars[i].Size)
-      {
-        stringstream ss;
-        ss << "Size mismatch for variable " << Vars[i].Name << " in: " << OpenFileName
-           << ": current: " << Vars[i].Size << ", file: " << VH->Size;
-        throw runtime_error(ss.str());
-      }
-      else if (IsFloat != Vars[i].IsFloat)
-      {
-        string Float("float"), Int("integer");
-        stringstream ss;
-        ss << "Type mismatch for variable " << Vars[i].Name << " in: " << OpenFileName
-           << ": current: " << (Vars[i].IsFloat ? Float : Int)
-           << ", file: " << (IsFloat ? Float : Int);
-        throw runtime_error(ss.str());
-      }
-      else if (IsSigned != Vars[i].IsSigned)
-      {
-        string Signed("signed"), Uns("unsigned");
-        stringstream ss;
-        ss << "Type mismatch for variable " << Vars[i].Name << " in: " << OpenFileName
-           << ": current: " << (Vars[i].IsSigned ? Signed : Uns)
-           << ", file: " << (IsSigned ? Signed : Uns);
-        throw runtime_error(ss.str());
-      }
+      checkVariableType(VH, Vars[i], OpenFileName);
 
       size_t VarOffset = RowOffset * Vars[i].Size;
       void* VarData = ((char*)Vars[i].Data) + VarOffset;
@@ -2004,7 +2388,7 @@ void GenericIO::readData(
 
       TotalReadSize += ReadSize;
 
-      uint64_t CRC = crc64_omp(Data, ReadSize);
+      uint64_t CRC = VerifyCRC ? crc64_omp(Data, ReadSize) : (uint64_t)-1;
       if (CRC != (uint64_t)-1)
       {
         ++NErrs[1];
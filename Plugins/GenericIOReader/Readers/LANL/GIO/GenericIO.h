@@ -49,9 +49,18 @@
 #include <string>
 #include <vector>
 
-#ifndef LANL_GENERICIO_NO_MPI
+// MPI-IO file access is available with the full MPI build, and in the
+// serial build when LANL_GENERICIO_USE_MPIIO is defined. In the latter case,
+// each process opens the file on its own (MPI_COMM_SELF), unless a shared
+// communicator is given with setFileComm().
+#if !defined(LANL_GENERICIO_NO_MPI) && !defined(LANL_GENERICIO_USE_MPIIO)
+#define LANL_GENERICIO_USE_MPIIO
+#endif
+
+#ifdef LANL_GENERICIO_USE_MPIIO
 #include <mpi.h>
-#else
+#endif
+#ifdef LANL_GENERICIO_NO_MPI
 #include <fstream>
 #endif
 
@@ -80,13 +89,16 @@ protected:
   std::string FileName;
 };
 
-#ifndef LANL_GENERICIO_NO_MPI
+#ifdef LANL_GENERICIO_USE_MPIIO
 class GenericFileIO_MPI : public GenericFileIO
 {
 public:
-  GenericFileIO_MPI(const MPI_Comm& C)
+  // NA, when positive, is passed to MPI-IO as the number of collective
+  // buffering aggregators (the "cb_nodes" hint) used when reading.
+  GenericFileIO_MPI(const MPI_Comm& C, int NA = 0)
     : FH(MPI_FILE_NULL)
     , Comm(C)
+    , NumAggregators(NA)
   {
   }
   virtual ~GenericFileIO_MPI();
@@ -100,13 +112,14 @@ public:
 protected:
   MPI_File FH;
   MPI_Comm Comm;
+  int NumAggregators;
 };
 
 class GenericFileIO_MPICollective : public GenericFileIO_MPI
 {
 public:
-  GenericFileIO_MPICollective(const MPI_Comm& C)
-    : GenericFileIO_MPI(C)
+  GenericFileIO_MPICollective(const MPI_Comm& C, int NA = 0)
+    : GenericFileIO_MPI(C, NA)
   {
   }
 
@@ -232,6 +245,13 @@ public:
     , FileName(FN)
     , Redistributing(false)
     , DisableCollErrChecking(false)
+    , AggregateReads(false)
+    , VerifyCRC(true)
+    , AggregateGap(1024 * 1024)
+    , MaxAggregateSize(256 * 1024 * 1024)
+#ifndef LANL_GENERICIO_NO_MPI
+    , NumAggregators(0)
+#endif
     , SplitComm(MPI_COMM_NULL)
   {
     std::fill(PhysOrigin, PhysOrigin + 3, 0.0);
@@ -245,6 +265,14 @@ public:
     , FileName(FN)
     , Redistributing(false)
     , DisableCollErrChecking(false)
+    , AggregateReads(false)
+    , VerifyCRC(true)
+    , AggregateGap(1024 * 1024)
+    , MaxAggregateSize(256 * 1024 * 1024)
+#ifdef LANL_GENERICIO_USE_MPIIO
+    , NumAggregators(0)
+    , FileComm(MPI_COMM_SELF)
+#endif
   {
     std::fill(PhysOrigin, PhysOrigin + 3, 0.0);
     std::fill(PhysScale, PhysScale + 3, 0.0);
@@ -350,6 +378,12 @@ public:
   void readDataSection(size_t readOffset, size_t readNumRows, int EffRank = -1,
     bool PrintStats = true, bool CollStats = true);
 
+  // With collective aggregated reads, every read of the file must be
+  // matched by the other ranks. A rank with fewer rank blocks to read than
+  // the others calls this once per missing readData() or readDataSection(),
+  // to take part in the reads without reading anything.
+  void readEmptySection();
+
   void getSourceRanks(std::vector<int>& SR);
 
   template <typename T>
@@ -363,6 +397,40 @@ public:
 
   void setPartition(int P) { Partition = P; }
 
+  // When enabled, readData() and readDataSection() gather the extents of all
+  // the requested variables of the rank blocks being read, sort them by file
+  // offset and merge the ones separated by less than the aggregation gap
+  // into a few large requests (of at most the maximum aggregate size). This
+  // replaces one small request per variable and rank block by a handful of
+  // large ones, which matters most with MPI collective I/O. Variables stored
+  // with compression filters are read one at a time as before.
+  void setAggregateReads(bool A) { AggregateReads = A; }
+  bool getAggregateReads() const { return AggregateReads; }
+  void setAggregateGap(std::size_t G) { AggregateGap = G; }
+  void setMaxAggregateSize(std::size_t S) { MaxAggregateSize = S; }
+
+  // Enables (default) or disables the CRC64 verification of the data read.
+  // With aggregated reads, the checksum of a variable is computed on a
+  // worker thread while the next requests are read.
+  void setVerifyCRC(bool V) { VerifyCRC = V; }
+  bool getVerifyCRC() const { return VerifyCRC; }
+
+#ifdef LANL_GENERICIO_USE_MPIIO
+  // Number of MPI-IO collective buffering aggregators to use when reading
+  // (0, the default, leaves the choice to the MPI implementation). Must be
+  // set before the file is opened.
+  void setNumAggregators(int N) { NumAggregators = N; }
+  int getNumAggregators() const { return NumAggregators; }
+#endif
+
+#if defined(LANL_GENERICIO_NO_MPI) && defined(LANL_GENERICIO_USE_MPIIO)
+  // Communicator on which a file without rank map is opened with MPI-IO
+  // (MPI_COMM_SELF by default). With FileIOMPICollective, its ranks must
+  // open the same file, and read it with aggregated reads, padding with
+  // readEmptySection(). Must be set before the file is opened.
+  void setFileComm(const MPI_Comm& C) { FileComm = C; }
+#endif
+
   static void setDefaultFileIOType(unsigned FIOT) { DefaultFileIOType = FIOT; }
 
   static void setDefaultPartition(int P) { DefaultPartition = P; }
@@ -429,6 +497,28 @@ private:
   void readDataSection(size_t readOffset, size_t readNumRows, int EffRank, size_t RowOffset,
     int Rank, uint64_t& TotalReadSize, int NErrs[3]);
 
+  // A contiguous range of the file read into a variable by the aggregated
+  // read path.
+  struct ReadExtent;
+
+  bool readAggregated(bool Section, size_t readOffset, size_t readNumRows, int EffRank,
+    size_t RowOffset, int Rank, uint64_t& TotalReadSize, int NErrs[3]);
+
+  template <bool IsBigEndian>
+  bool gatherReadExtents(bool Section, size_t readOffset, size_t readNumRows, int EffRank,
+    size_t RowOffset, int Rank, std::vector<ReadExtent>& Extents);
+
+  void readExtents(
+    std::vector<ReadExtent>& Extents, bool SwapBytes, uint64_t& TotalReadSize, int NErrs[3]);
+
+  bool readWithRetries(void* Buf, size_t Count, uint64_t Offset, const std::string& D);
+
+#ifdef LANL_GENERICIO_USE_MPIIO
+  // The communicator whose ranks must match the collective reads of the
+  // open file, MPI_COMM_NULL when the reads are independent.
+  MPI_Comm getCollectiveReadComm() const;
+#endif
+
   template <bool IsBigEndian>
   void getVariableInfo(std::vector<VariableInfo>& VI);
 
@@ -457,6 +547,15 @@ protected:
   bool Redistributing, DisableCollErrChecking;
   std::vector<int> SourceRanks;
 
+  bool AggregateReads, VerifyCRC;
+  std::size_t AggregateGap, MaxAggregateSize;
+#ifdef LANL_GENERICIO_USE_MPIIO
+  int NumAggregators;
+#endif
+#if defined(LANL_GENERICIO_NO_MPI) && defined(LANL_GENERICIO_USE_MPIIO)
+  MPI_Comm FileComm;
+#endif
+
   std::vector<int> RankMap;
 #ifndef LANL_GENERICIO_NO_MPI
   MPI_Comm SplitComm;
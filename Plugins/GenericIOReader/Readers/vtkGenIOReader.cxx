@@ -117,6 +117,13 @@ vtkGenIOReader::vtkGenIOReader()
   dataPercentage = 0.1;
   percentageType = 1; // 0:normal, 1:power cube
 
+  // reading
+  aggregateReads = false;
+  aggregatorCount = 0;
+  verifyCRC = true;
+  currentFileIOMethod = lanl::gio::GenericIO::FileIOPOSIX;
+  currentAggregatorCount = 0;
+
   // Selections
   selectionChanged = false;
   randomSeed = std::chrono::system_clock::now().time_since_epoch().count();
@@ -192,6 +199,34 @@ void vtkGenIOReader::SetPercentageType(int _type)
   }
 }
 
+void vtkGenIOReader::SetAggregateReads(int a)
+{
+  if (aggregateReads != (a != 0))
+  {
+    aggregateReads = (a != 0);
+    this->Modified();
+  }
+}
+
+void vtkGenIOReader::SetAggregatorCount(int n)
+{
+  n = std::max(n, 0);
+  if (aggregatorCount != n)
+  {
+    aggregatorCount = n;
+    this->Modified();
+  }
+}
+
+void vtkGenIOReader::SetVerifyCRC(int v)
+{
+  if (verifyCRC != (v != 0))
+  {
+    verifyCRC = (v != 0);
+    this->Modified();
+  }
+}
+
 void vtkGenIOReader::SetResetSelection(int /* _x */)
 {
   selections.clear();
@@ -267,11 +302,43 @@ void vtkGenIOReader::InitMPICommunicator()
   msgLog << "myRank: " << myRank << ", num ranks:" << numRanks << "\n";
 }
 
+unsigned vtkGenIOReader::GetFileIOMethod()
+{
+  // MPI-IO needs MPI to be initialized, which is not the case in a serial
+  // client, even when ParaView is built with MPI.
+  if (aggregateReads && vtkMPIController::SafeDownCast(this->Controller) != nullptr)
+  {
+    return aggregatorCount > 0 ? lanl::gio::GenericIO::FileIOMPICollective
+                               : lanl::gio::GenericIO::FileIOMPI;
+  }
+  return lanl::gio::GenericIO::FileIOPOSIX;
+}
+
+void vtkGenIOReader::OpenGenericIO(unsigned method)
+{
+  gioReader = new lanl::gio::GenericIO(dataFilename, method);
+  gioReader->setNumAggregators(aggregatorCount);
+  if (method == lanl::gio::GenericIO::FileIOMPICollective)
+  {
+    // the aggregators are shared by all the processes reading the file.
+    vtkMPICommunicator* communicator =
+      vtkMPICommunicator::SafeDownCast(this->Controller->GetCommunicator());
+    gioReader->setFileComm(*communicator->GetMPIComm()->GetHandle());
+  }
+
+  currentFilename = dataFilename;
+  currentFileIOMethod = method;
+  currentAggregatorCount = aggregatorCount;
+}
+
 void vtkGenIOReader::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
   os << indent << "File: " << (this->dataFilename.c_str() ? this->dataFilename.c_str() : "none")
      << "\n";
+  os << indent << "AggregateReads: " << this->aggregateReads << "\n";
+  os << indent << "AggregatorCount: " << this->aggregatorCount << "\n";
+  os << indent << "VerifyCRC: " << this->verifyCRC << "\n";
 }
 
 void vtkGenIOReader::displayMsg(std::string msg)
@@ -523,9 +590,12 @@ int vtkGenIOReader::RequestInformation(vtkInformation* /*rqst*/,
   outInfo->Set(CAN_HANDLE_PIECE_REQUEST(), 1);
 
   fullClock.start();
+  // the file is reopened when the way it is accessed changes.
+  const unsigned Method = this->GetFileIOMethod();
   if (gioReader != nullptr)
   {
-    if (currentFilename != dataFilename)
+    if (currentFilename != dataFilename || currentFileIOMethod != Method ||
+      currentAggregatorCount != aggregatorCount)
     {
       msgLog << "currentFilename: " << currentFilename << ", dataFilename: " << dataFilename
              << "\n";
@@ -534,26 +604,20 @@ int vtkGenIOReader::RequestInformation(vtkInformation* /*rqst*/,
       gioReader = nullptr;
 
       metaDataBuilt = false; // signal to re-build metadata
-      unsigned Method = lanl::gio::GenericIO::FileIOPOSIX;
 
       randomNumGenerated = false;
-      gioReader = new lanl::gio::GenericIO(dataFilename, Method);
+      this->OpenGenericIO(Method);
       msgLog << "Opening ... \n";
-
-      currentFilename = dataFilename;
       msgLog << "gioReader != nullptr\n";
     }
   }
   else
   {
     metaDataBuilt = false; // signal to re-build metadata
-    unsigned Method = lanl::gio::GenericIO::FileIOPOSIX;
 
     randomNumGenerated = false;
-    gioReader = new lanl::gio::GenericIO(dataFilename, Method);
+    this->OpenGenericIO(Method);
     msgLog << "Opening . .. .\n";
-
-    currentFilename = dataFilename;
     msgLog << "gioReader == nullptr\n";
   }
 
@@ -908,8 +972,21 @@ int vtkGenIOReader::RequestData(
   msgLog << "\nReading now: " << numActiveTuples << " ... \n";
   debugLog.writeLogToDisk(msgLog);
 
+  gioReader->setAggregateReads(aggregateReads);
+  gioReader->setVerifyCRC(verifyCRC);
+
   totalPoints = 0;
   size_t totalPointsProcessed = 0;
+  // collective reads must be matched: processes with fewer data ranks to
+  // read than the others take part in the remaining reads without reading
+  // anything. The count is agreed on before reading.
+  int numSectionsRead = 0;
+  int maxSectionsRead = 0;
+  if (currentFileIOMethod == lanl::gio::GenericIO::FileIOMPICollective)
+  {
+    int numSections = ranksRangeToLoad[1] - ranksRangeToLoad[0] + 1;
+    this->Controller->AllReduce(&numSections, &maxSectionsRead, 1, vtkCommunicator::MAX_OP);
+  }
   populatingClock.start();
   switch (this->sampleType)
   {
@@ -964,6 +1041,7 @@ int vtkGenIOReader::RequestData(
                << ", time to create structures: " << _clock.getDuration() << " s.\n";
 
         loadClock.start();
+        numSectionsRead++;
 
         // Load data
         size_t numLoadingRows;
@@ -1102,6 +1180,7 @@ int vtkGenIOReader::RequestData(
                << ", time to create structures: " << _clock.getDuration() << " s.\n";
 
         loadClock.start();
+        numSectionsRead++;
 
         // Find the number of rows to read
         size_t numLoadingRows;
@@ -1171,6 +1250,10 @@ int vtkGenIOReader::RequestData(
     default:
       break;
   };
+  for (int i = numSectionsRead; i < maxSectionsRead; ++i)
+  {
+    gioReader->readEmptySection();
+  }
   populatingClock.stop();
 
   cleanupClock.start();
@@ -88,6 +88,11 @@ public:
   void SetDataPercentToShow(double t);
   void SetPercentageType(int _type);
 
+  // Reading
+  void SetAggregateReads(int a);
+  void SetAggregatorCount(int n);
+  void SetVerifyCRC(int v);
+
   void SetResetSelection(int _x);
   void SelectScalar(const char* selectedScalar);
   void SelectCriteria(int selectionCriteria);
@@ -123,6 +128,14 @@ protected:
 
   void displayMsg(std::string msg);
 
+  // FileIOMPI when reads are aggregated and MPI is in use, FileIOMPICollective
+  // when aggregators are also requested, FileIOPOSIX otherwise.
+  unsigned GetFileIOMethod();
+
+  // Creates the GenericIO reader of dataFilename. With collective reads, the
+  // file is opened on the communicator of the controller.
+  void OpenGenericIO(unsigned method);
+
 private:
   // MPI Stuff
   vtkMultiProcessController* Controller;
@@ -141,6 +154,11 @@ private:
   size_t dataNumShowElements;
   unsigned randomSeed;
 
+  // Reading
+  bool aggregateReads; // merge the reads of the variables of each data rank
+  int aggregatorCount; // collective reads through that many "cb_nodes" when positive
+  bool verifyCRC;
+
   // Selection
   bool selectionChanged;
   ParaviewSelection _sel;
@@ -171,6 +189,8 @@ private:
   // data
   std::string dataFilename;
   std::string currentFilename;
+  unsigned currentFileIOMethod;
+  int currentAggregatorCount;
 
   // timeseries
   bool justLoaded;
@@ -0,0 +1,38 @@
+# Tests that aggregated reads, which go through MPI-IO when running with MPI,
+# read the same particles as the default reads. With an aggregator count, the
+# processes read the file collectively, including when they have different
+# numbers of data ranks to read.
+from paraview.simple import *
+from paraview import servermanager as sm
+from paraview import smtesting
+import os.path
+smtesting.ProcessCommandLineArguments()
+
+LoadDistributedPlugin("GenericIOReader", ns=globals())
+fileName = os.path.join(smtesting.DataDir,
+                        "Testing/Data/GenericIOReader/m000.halo.499.fofproperties")
+
+def read(aggregateReads, aggregatorCount):
+    reader = vtkGenIOReader(FileNames=[fileName])
+    reader.AggregateReads = aggregateReads
+    reader.AggregatorCount = aggregatorCount
+    reader.PointArrayStatus = reader.PointArrayStatus.Available
+    # particles are shuffled when sampled, so compare sorted values.
+    reader.ShowData = 1.0
+    reader.UpdatePipeline()
+    data = sm.Fetch(reader)
+    Delete(reader)
+    values = {}
+    pd = data.GetPointData()
+    for i in range(pd.GetNumberOfArrays()):
+        array = pd.GetArray(i)
+        values[array.GetName()] = sorted(
+            array.GetTuple(j) for j in range(array.GetNumberOfTuples()))
+    return data.GetNumberOfPoints(), values
+
+expected = read(0, 0)
+if expected[0] == 0 or not expected[1]:
+    raise RuntimeError("No particle read")
+for aggregatorCount in (0, 1):
+    if read(1, aggregatorCount) != expected:
+        raise RuntimeError("Aggregated reads with %d aggregators differ" % aggregatorCount)
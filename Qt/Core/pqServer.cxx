@@ -38,6 +38,8 @@
 #include <QTimer>
 #include <QtDebug>
 
+#include <cmath>
+
 class pqServer::pqInternals
 {
 public:
@@ -48,6 +50,10 @@ public:
 
   QTimer ServerLifeTimeTimer;
 
+  // Used to send the messages held by the session's coalescing window once it
+  // has elapsed.
+  QTimer CoalescingTimer;
+
   // remaining time in minutes
   int RemainingLifeTime{ -1 };
 
@@ -117,6 +123,21 @@ pqServer::pqServer(vtkIdType connectionID, QObject* _parent)
   this->Internals->VTKConnect->Connect(this->Session, vtkPVSessionBase::ConnectionLost, this,
     SLOT(onConnectionLost(vtkObject*, ulong, void*, void*)));
 
+  // Send the messages held by the coalescing window even when idle.
+  if (auto sessionClient = vtkSMSessionClient::SafeDownCast(this->Session))
+  {
+    this->Internals->CoalescingTimer.setSingleShot(true);
+    QObject::connect(&this->Internals->CoalescingTimer, &QTimer::timeout, this, [this]() {
+      if (auto client = vtkSMSessionClient::SafeDownCast(this->session()))
+      {
+        client->FlushMessages();
+      }
+    });
+    this->Internals->VTKConnect->Connect(sessionClient,
+      vtkSMSessionClient::CoalescingWindowOpenedEvent, this,
+      SLOT(onCoalescingWindowOpened(vtkObject*, ulong, void*, void*)));
+  }
+
   // In case of Multi-clients connection, the client has to listen
   // server notification so collaboration could happen
   if (this->session()->IsMultiClients())
@@ -475,6 +496,16 @@ void pqServer::onConnectionLost(vtkObject*, unsigned long, void*, void*)
 {
   Q_EMIT serverSideDisconnected();
 }
+//-----------------------------------------------------------------------------
+void pqServer::onCoalescingWindowOpened(vtkObject*, unsigned long, void*, void* callData)
+{
+  if (!this->Internals->CoalescingTimer.isActive())
+  {
+    const double window = *reinterpret_cast<double*>(callData);
+    this->Internals->CoalescingTimer.start(static_cast<int>(std::ceil(window * 1000.0)));
+  }
+}
+
 //-----------------------------------------------------------------------------
 void pqServer::sendToOtherClients(vtkSMMessage* msg)
 {
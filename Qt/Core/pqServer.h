@@ -239,6 +239,12 @@ protected Q_SLOTS:
    */
   void onConnectionLost(vtkObject*, unsigned long, void*, void*);
 
+  /**
+   * Called by vtkSMSessionClient when it starts holding messages in its
+   * coalescing window, to send them once the window has elapsed.
+   */
+  void onCoalescingWindowOpened(vtkObject*, unsigned long, void*, void*);
+
 private:
   Q_DISABLE_COPY(pqServer)
 
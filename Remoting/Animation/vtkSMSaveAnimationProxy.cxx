@@ -10,14 +10,24 @@
 #include "vtkMultiProcessController.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkPNGReader.h"
+#include "vtkPVLogger.h"
 #include "vtkPVProgressHandler.h"
 #include "vtkPVXMLElement.h"
+#include "vtkProcessModule.h"
 #include "vtkRemoteWriterHelper.h"
 #include "vtkRenderWindow.h"
 #include "vtkSMAnimationScene.h"
 #include "vtkSMAnimationSceneWriter.h"
+#include "vtkSMImageWriterQueue.h"
+#include "vtkSMParaViewPipelineController.h"
 #include "vtkSMProperty.h"
 #include "vtkSMPropertyHelper.h"
+#include "vtkSMPropertyIterator.h"
+#include "vtkSMProxyListDomain.h"
+#include "vtkSMProxyManager.h"
+#include "vtkSMProxyProperty.h"
+#include "vtkSMSession.h"
 #include "vtkSMSessionClient.h"
 #include "vtkSMSessionProxyManager.h"
 #include "vtkSMSourceProxy.h"
@@ -27,6 +37,8 @@
 
 #include <algorithm>
 #include <sstream>
+#include <string>
+#include <vector>
 #include <vtksys/SystemTools.hxx>
 
 namespace vtkSMSaveAnimationProxyNS
@@ -49,6 +61,120 @@ public:
   }
 };
 
+/**
+ * Returns the number of frames in the animation for the scene's play mode, or
+ * -1 if the play mode has no fixed number of frames.
+ */
+int GetNumberOfFrames(vtkSMProxy* sceneProxy)
+{
+  switch (vtkSMPropertyHelper(sceneProxy, "PlayMode").GetAsInt())
+  {
+    case vtkCompositeAnimationPlayer::SEQUENCE:
+      return vtkSMPropertyHelper(sceneProxy, "NumberOfFrames").GetAsInt();
+    case vtkCompositeAnimationPlayer::SNAP_TO_TIMESTEPS:
+    {
+      vtkSMProxy* timeKeeper = vtkSMPropertyHelper(sceneProxy, "TimeKeeper").GetAsProxy();
+      return static_cast<int>(
+        vtkSMPropertyHelper(timeKeeper, "TimestepValues").GetNumberOfElements());
+    }
+    default:
+      return -1;
+  }
+}
+
+/**
+ * Copies the properties of `source` to `target`, a proxy of the same type in
+ * another session. Proxies referred to by `source` are located in the
+ * target's session using their global ids, hence the state must have been
+ * loaded in that session keeping original ids. For properties with a proxy
+ * list domain, the proxy of the same type is selected and its properties
+ * copied.
+ */
+void CopyToSession(vtkSMProxy* source, vtkSMProxy* target)
+{
+  vtkSMSession* session = target->GetSession();
+  vtkSmartPointer<vtkSMPropertyIterator> iter;
+  iter.TakeReference(source->NewPropertyIterator());
+  for (iter->Begin(); !iter->IsAtEnd(); iter->Next())
+  {
+    vtkSMProperty* sourceProperty = iter->GetProperty();
+    vtkSMProperty* targetProperty = target->GetProperty(iter->GetKey());
+    if (!targetProperty)
+    {
+      continue;
+    }
+
+    auto sourcePP = vtkSMProxyProperty::SafeDownCast(sourceProperty);
+    auto targetPP = vtkSMProxyProperty::SafeDownCast(targetProperty);
+    if (!sourcePP || !targetPP)
+    {
+      targetProperty->Copy(sourceProperty);
+    }
+    else if (auto pld = targetPP->FindDomain<vtkSMProxyListDomain>())
+    {
+      vtkSMProxy* sourceValue = vtkSMPropertyHelper(sourcePP).GetAsProxy();
+      vtkSMProxy* targetValue = sourceValue
+        ? pld->FindProxy(sourceValue->GetXMLGroup(), sourceValue->GetXMLName())
+        : nullptr;
+      if (targetValue)
+      {
+        targetValue->Copy(sourceValue);
+        targetValue->UpdateVTKObjects();
+        vtkSMPropertyHelper(targetPP).Set(targetValue);
+      }
+    }
+    else
+    {
+      std::vector<vtkSMProxy*> proxies;
+      for (unsigned int cc = 0; cc < sourcePP->GetNumberOfProxies(); ++cc)
+      {
+        vtkSMProxy* proxy = sourcePP->GetProxy(cc);
+        vtkObject* object = proxy ? session->GetRemoteObject(proxy->GetGlobalID()) : nullptr;
+        proxies.push_back(vtkSMProxy::SafeDownCast(object));
+      }
+      targetPP->SetProxies(static_cast<unsigned int>(proxies.size()), proxies.data());
+    }
+  }
+}
+
+/**
+ * Encodes the images in `frames`, in order, into a movie using the movie
+ * writer of `format`.
+ */
+bool EncodeMovie(vtkSMProxy* format, const char* filename, const std::vector<std::string>& frames)
+{
+  auto movieWriter = vtkGenericMovieWriter::SafeDownCast(format->GetClientSideObject());
+  vtkSMPropertyHelper(format, "FileName").Set(filename);
+  format->UpdateVTKObjects();
+
+  vtkNew<vtkPNGReader> reader;
+  bool status = true;
+  for (size_t cc = 0; cc < frames.size() && status; ++cc)
+  {
+    reader->SetFileName(frames[cc].c_str());
+    reader->Update();
+    if (reader->GetErrorCode() != vtkErrorCode::NoError)
+    {
+      vtkLogF(ERROR, "Failed to read frame '%s'.", frames[cc].c_str());
+      status = false;
+      break;
+    }
+    movieWriter->SetInputData(reader->GetOutput());
+    if (cc == 0)
+    {
+      movieWriter->Start();
+    }
+    movieWriter->Write();
+    status = movieWriter->GetError() == 0;
+  }
+  if (!frames.empty())
+  {
+    movieWriter->End();
+  }
+  movieWriter->SetInputData(nullptr);
+  return status;
+}
+
 class SceneImageWriter : public vtkSMAnimationSceneWriter
 {
   vtkWeakPointer<vtkSMSaveAnimationProxy> Helper;
@@ -60,6 +186,13 @@ public:
    */
   void SetHelper(vtkSMSaveAnimationProxy* helper) { this->Helper = helper; }
 
+  /**
+   * Set the queue used to encode and write frames in the background while the
+   * next frame is rendered. When not set, frames are written before the next
+   * one is rendered.
+   */
+  void SetQueue(vtkSMImageWriterQueue* queue) { this->Queue = queue; }
+
   /**
    * Get the vtkRemoteWriterHelper proxy.
    */
@@ -110,11 +243,14 @@ protected:
   bool SaveFinalize() override
   {
     this->AnimationScene->SetOverrideStillRender(0);
-    return true;
+    // wait for frames still being written.
+    return this->Queue ? this->Queue->Flush() : true;
   }
 
   virtual bool WriteFrameImage(double time, vtkImageData* dataLeft, vtkImageData* dataRight) = 0;
 
+  vtkSmartPointer<vtkSMImageWriterQueue> Queue;
+
   std::string GetStereoFileName(const std::string& filename, bool left)
   {
     return Friendship::GetStereoFileName(this->Helper, filename, left);
@@ -180,6 +316,33 @@ protected:
   {
     vtkImageData* data[] = { dataLeft, dataRight };
     bool status = true;
+    if (this->Queue)
+    {
+      // frames are encoded in order, on a background thread, while the next
+      // frame is rendered.
+      const bool start = !this->Started;
+      for (int cc = 0; cc < 2; ++cc)
+      {
+        if (auto movieWriter = this->GetMovieWriter(cc))
+        {
+          assert(data[cc] != nullptr);
+          vtkSmartPointer<vtkImageData> image = data[cc];
+          status &= this->Queue->Push(movieWriter, [movieWriter, image, start]() {
+            movieWriter->SetInputData(image);
+            if (start)
+            {
+              movieWriter->Start();
+            }
+            movieWriter->Write();
+            movieWriter->SetInputData(nullptr);
+            return movieWriter->GetError() == 0;
+          });
+        }
+      }
+      this->Started = true;
+      return status;
+    }
+
     for (int cc = 0; cc < 2; ++cc)
     {
       if (auto remoteWriterHelper = this->RemoteWriterHelpers[cc])
@@ -209,7 +372,20 @@ protected:
 
   bool SaveFinalize() override
   {
-    if (this->Started)
+    if (this->Started && this->Queue)
+    {
+      for (int cc = 0; cc < 2; ++cc)
+      {
+        if (auto movieWriter = this->GetMovieWriter(cc))
+        {
+          this->Queue->Push(movieWriter, [movieWriter]() {
+            movieWriter->End();
+            return movieWriter->GetError() == 0;
+          });
+        }
+      }
+    }
+    else if (this->Started)
     {
       for (int cc = 0; cc < 2; ++cc)
       {
@@ -225,6 +401,19 @@ protected:
     return this->Superclass::SaveFinalize();
   }
 
+  /**
+   * Returns the movie writer for the given eye, if any.
+   */
+  vtkSmartPointer<vtkGenericMovieWriter> GetMovieWriter(int index)
+  {
+    if (auto remoteWriterHelper = this->RemoteWriterHelpers[index])
+    {
+      const auto format = vtkSMPropertyHelper(remoteWriterHelper, "Writer").GetAsProxy();
+      return vtkGenericMovieWriter::SafeDownCast(format->GetClientSideObject());
+    }
+    return nullptr;
+  }
+
 private:
   SceneImageWriterMovie(const SceneImageWriterMovie&) = delete;
   void operator=(const SceneImageWriterMovie&) = delete;
@@ -291,6 +480,26 @@ protected:
     str << this->Prefix << buffer << this->Extension;
 
     const std::string filename = str.str();
+    if (this->Queue)
+    {
+      // images are encoded and written on background threads, using a copy of
+      // the format proxy for each image being written.
+      const auto format = vtkSMPropertyHelper(remoteWriterHelper, "Writer").GetAsProxy();
+      if (dataRight)
+      {
+        success &= this->Queue->WriteImage(
+          format, dataRight, this->GetStereoFileName(filename, /*left=*/false));
+        success &= this->Queue->WriteImage(
+          format, dataLeft, this->GetStereoFileName(filename, /*left=*/true));
+      }
+      else
+      {
+        success &= this->Queue->WriteImage(format, dataLeft, filename);
+      }
+      this->Counter += success ? this->Stride : 0;
+      return success;
+    }
+
     if (dataRight)
     {
       // write right image.
@@ -460,6 +669,12 @@ bool vtkSMSaveAnimationProxy::WriteAnimation(const char* filename, vtkTypeUInt32
     .arg("layout", layout)
     .arg("mode_screenshot", 0)
     .arg("location", static_cast<int>(location));
+
+  const int numberOfGroups = vtkSMPropertyHelper(this, "NumberOfRankGroups", true).GetAsInt();
+  if (numberOfGroups > 1)
+  {
+    return this->WriteAnimationPartitioned(filename, location, numberOfGroups);
+  }
   return this->WriteAnimationInternal(filename, location);
 }
 
@@ -530,6 +745,17 @@ bool vtkSMSaveAnimationProxy::WriteAnimationInternal(const char* filename, vtkTy
     return false;
   }
 
+  // when frames are written on this process, they are encoded and written in
+  // the background while the next ones are rendered.
+  const int maxPendingFrames =
+    vtkSMPropertyHelper(this, "MaximumNumberOfPendingFrames", true).GetAsInt();
+  if (maxPendingFrames > 0 && vtkSMImageWriterQueue::CanWriteLocally(this->GetSession(), location))
+  {
+    vtkNew<vtkSMImageWriterQueue> queue;
+    queue->SetMaximumNumberOfPendingFrames(maxPendingFrames);
+    vtkSMSaveAnimationProxyNS::SceneImageWriter::SafeDownCast(writer)->SetQueue(queue);
+  }
+
   writer->SetAnimationScene(sceneProxy);
   writer->SetFileName(filename);
   writer->SetStride(vtkSMPropertyHelper(this, "FrameStride").GetAsInt());
@@ -580,6 +806,141 @@ bool vtkSMSaveAnimationProxy::WriteAnimationInternal(const char* filename, vtkTy
   return status;
 }
 
+//----------------------------------------------------------------------------
+bool vtkSMSaveAnimationProxy::WriteAnimationPartitioned(
+  const char* filename, vtkTypeUInt32 location, int numberOfGroups)
+{
+  vtkProcessModule* pm = vtkProcessModule::GetProcessModule();
+  vtkMultiProcessController* globalController = vtkMultiProcessController::GetGlobalController();
+  const int numRanks = globalController ? globalController->GetNumberOfProcesses() : 1;
+  vtkSMProxy* sceneProxy = this->GetAnimationScene();
+  const int numFrames = sceneProxy ? vtkSMSaveAnimationProxyNS::GetNumberOfFrames(sceneProxy) : -1;
+  auto formatProxy = this->GetFormatProxy(filename);
+  const bool isMovie =
+    formatProxy && vtkGenericMovieWriter::SafeDownCast(formatProxy->GetClientSideObject());
+  const bool stereo = vtkSMPropertyHelper(this, "StereoMode").GetAsInt() == VTK_STEREO_EMULATE;
+  if (!pm->GetSymmetricMPIMode() || numRanks < 2 || numFrames < 0 ||
+    location != vtkPVSession::CLIENT || (isMovie && stereo))
+  {
+    vtkWarningMacro("Partitioned animation export requires symmetric MPI mode, an animation with "
+                    "a fixed number of frames saved locally and is not supported for stereo "
+                    "movies. Frames will be saved sequentially.");
+    return this->WriteAnimationInternal(filename, location);
+  }
+
+  // same frames as would be saved by WriteAnimationInternal().
+  int frameWindow[2] = { 0, 0 };
+  vtkSMPropertyHelper(this, "FrameWindow").Get(frameWindow, 2);
+  frameWindow[0] = std::max(frameWindow[0], 0);
+  frameWindow[1] = std::min(frameWindow[1], numFrames - 1);
+  const int stride = std::max(vtkSMPropertyHelper(this, "FrameStride").GetAsInt(), 1);
+  const int count =
+    frameWindow[1] >= frameWindow[0] ? (frameWindow[1] - frameWindow[0]) / stride + 1 : 0;
+  numberOfGroups = std::min({ numberOfGroups, numRanks, count });
+  if (numberOfGroups < 2)
+  {
+    return this->WriteAnimationInternal(filename, location);
+  }
+
+  // split ranks, and frames, in contiguous groups.
+  const int rank = globalController->GetLocalProcessId();
+  const int group = static_cast<int>(static_cast<vtkTypeInt64>(rank) * numberOfGroups / numRanks);
+  const int first = static_cast<int>(static_cast<vtkTypeInt64>(count) * group / numberOfGroups);
+  const int last =
+    static_cast<int>(static_cast<vtkTypeInt64>(count) * (group + 1) / numberOfGroups) - 1;
+  int groupWindow[2] = { frameWindow[0] + first * stride, frameWindow[0] + last * stride };
+  vtkVLogF(PARAVIEW_LOG_RENDERING_VERBOSITY(), "rank group %d of %d saves frames [%d, %d]", group,
+    numberOfGroups, groupWindow[0], groupWindow[1]);
+
+  // movies cannot be written in pieces; each group saves its frames as images
+  // which are encoded once all groups are done.
+  const std::string path = vtksys::SystemTools::GetFilenamePath(filename);
+  const std::string framesPrefix = (path.empty() ? std::string() : path + "/") +
+    vtksys::SystemTools::GetFilenameWithoutLastExtension(filename) + ".frames";
+  const char* framesSuffixFormat = "_%06d";
+  const std::string groupFileName = isMovie ? framesPrefix + ".png" : std::string(filename);
+
+  vtkSmartPointer<vtkPVXMLElement> state = this->GetSessionProxyManager()->GetXMLState();
+  vtkSmartPointer<vtkMultiProcessController> groupController;
+  groupController.TakeReference(globalController->PartitionController(group, rank));
+
+  bool status = false;
+  vtkSMSession* session = this->GetSession();
+  vtkMultiProcessController::SetGlobalController(groupController);
+  {
+    // the session core of a new session uses the global controller, i.e. the
+    // group's controller, for all parallel communication.
+    auto groupSession = vtkSmartPointer<vtkSMSession>::New();
+    const vtkIdType groupSessionId = pm->RegisterSession(groupSession);
+    auto groupPXM = groupSession->GetSessionProxyManager();
+    // keep original ids so that proxies referred to by this proxy can be located.
+    groupPXM->LoadXMLState(state, nullptr, /*keepOriginalIds=*/true);
+
+    auto helper = vtkSmartPointer<vtkSMSaveAnimationProxy>::Take(
+      vtkSMSaveAnimationProxy::SafeDownCast(
+        groupPXM->NewProxy(this->GetXMLGroup(), this->GetXMLName())));
+    if (helper)
+    {
+      vtkNew<vtkSMParaViewPipelineController> controller;
+      controller->InitializeProxy(helper);
+      vtkSMSaveAnimationProxyNS::CopyToSession(this, helper);
+      vtkSMPropertyHelper(helper, "FrameWindow").Set(groupWindow, 2);
+      if (isMovie)
+      {
+        auto framesFormat = helper->GetFormatProxy(groupFileName);
+        vtkSMPropertyHelper(framesFormat, "SuffixFormat").Set(framesSuffixFormat);
+        framesFormat->UpdateVTKObjects();
+      }
+      helper->UpdateVTKObjects();
+      status = helper->WriteAnimationInternal(groupFileName.c_str(), location);
+      helper = nullptr;
+    }
+    else
+    {
+      vtkErrorMacro("Failed to create '" << this->GetXMLName() << "' proxy for rank group.");
+    }
+
+    groupPXM->UnRegisterProxies();
+    pm->UnRegisterSession(groupSessionId);
+  }
+  vtkMultiProcessController::SetGlobalController(globalController);
+  vtkSMProxyManager::GetProxyManager()->SetActiveSession(session);
+
+  int localStatus = status ? 1 : 0;
+  int globalStatus = 0;
+  globalController->AllReduce(&localStatus, &globalStatus, 1, vtkCommunicator::MIN_OP);
+  status = globalStatus != 0;
+
+  if (isMovie)
+  {
+    std::vector<std::string> frames;
+    for (int cc = 0; cc < count; ++cc)
+    {
+      char buffer[1024];
+      snprintf(buffer, 1024, framesSuffixFormat, frameWindow[0] + cc * stride);
+      frames.push_back(framesPrefix + buffer + ".png");
+    }
+
+    int encodeStatus = status ? 1 : 0;
+    if (rank == 0)
+    {
+      if (status)
+      {
+        vtkSMPropertyHelper(formatProxy, "FrameRate", true)
+          .Set(vtkSMPropertyHelper(this, "FrameRate").GetAsInt());
+        encodeStatus = vtkSMSaveAnimationProxyNS::EncodeMovie(formatProxy, filename, frames);
+      }
+      for (const auto& frame : frames)
+      {
+        vtksys::SystemTools::RemoveFile(frame);
+      }
+    }
+    globalController->Broadcast(&encodeStatus, 1, 0);
+    status = encodeStatus != 0;
+  }
+  return status;
+}
+
 //----------------------------------------------------------------------------
 vtkSMViewLayoutProxy* vtkSMSaveAnimationProxy::GetLayout()
 {
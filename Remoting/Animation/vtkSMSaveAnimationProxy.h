@@ -51,6 +51,18 @@ protected:
   virtual bool WriteAnimationInternal(
     const char* filename, vtkTypeUInt32 location = vtkPVSession::CLIENT);
 
+  /**
+   * Write animation by splitting the frame window among `numberOfGroups`
+   * groups of ranks. Each group renders its share of the frames using its own
+   * sub-communicator and its own copy of the state. Images written by all
+   * groups are numbered as if written by WriteAnimationInternal(); for movies,
+   * frames are written to temporary images which are then encoded, in order,
+   * by the root rank. This is only supported in symmetric MPI mode, i.e.
+   * `pvbatch --symmetric`, and must be called on all ranks.
+   */
+  virtual bool WriteAnimationPartitioned(
+    const char* filename, vtkTypeUInt32 location, int numberOfGroups);
+
   /**
    * Prepares for saving animation.
    */
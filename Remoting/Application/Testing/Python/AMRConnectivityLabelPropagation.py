@@ -0,0 +1,54 @@
+# Tests that both equivalence resolution modes of the AMR connectivity filter
+# find the same fragments when they are split among processes. This must be
+# run with pvbatch in symmetric mode.
+from paraview.simple import *
+from paraview import smtesting
+from paraview.vtk import vtkIdTypeArray
+import os.path
+smtesting.ProcessCommandLineArguments()
+
+reader = OpenDataFile(os.path.join(smtesting.DataDir, "Testing/Data/SPCTH/spcth.0"))
+pairExchange = AMRConnectivity(Input=reader)
+arrayName = pairExchange.SelectMaterialArrays.Available[0]
+pairExchange.SelectMaterialArrays = [arrayName]
+pairExchange.VolumeFractionValue = 0.5
+pairExchange.EquivalenceResolution = "Pair Exchange"
+labelPropagation = AMRConnectivity(Input=reader)
+labelPropagation.SelectMaterialArrays = [arrayName]
+labelPropagation.VolumeFractionValue = 0.5
+labelPropagation.EquivalenceResolution = "Label Propagation"
+pairExchange.UpdatePipeline()
+labelPropagation.UpdatePipeline()
+
+controller = servermanager.vtkProcessModule.GetProcessModule().GetGlobalController()
+
+# pairs of region ids given to the same cell by both modes.
+regionName = "RegionId-" + arrayName
+localPairs = set()
+first = pairExchange.GetClientSideObject().GetOutputDataObject(0)
+second = labelPropagation.GetClientSideObject().GetOutputDataObject(0)
+iterator = first.NewIterator()
+iterator.InitTraversal()
+while not iterator.IsDoneWithTraversal():
+    firstIds = iterator.GetCurrentDataObject().GetCellData().GetArray(regionName)
+    secondIds = second.GetDataSet(iterator).GetCellData().GetArray(regionName)
+    for i in range(firstIds.GetNumberOfTuples()):
+        localPairs.add((firstIds.GetValue(i), secondIds.GetValue(i)))
+    iterator.GoToNextItem()
+sendPairs = vtkIdTypeArray()
+for a, b in localPairs:
+    sendPairs.InsertNextValue(a)
+    sendPairs.InsertNextValue(b)
+allPairs = vtkIdTypeArray()
+controller.AllGatherV(sendPairs, allPairs)
+
+# the region ids may differ, but they must match one to one.
+firstToSecond = {}
+secondToFirst = {}
+for i in range(0, allPairs.GetNumberOfTuples(), 2):
+    a = allPairs.GetValue(i)
+    b = allPairs.GetValue(i + 1)
+    if firstToSecond.setdefault(a, b) != b or secondToFirst.setdefault(b, a) != a:
+        raise RuntimeError("Region %d of pair exchange and %d of label propagation differ" % (a, b))
+if len([a for a in firstToSecond if a > 0]) < 2:
+    raise RuntimeError("Expected several fragments, found %d" % len(firstToSecond))
@@ -0,0 +1,32 @@
+# Tests that the AMR dual contour filter generates the same surface whether
+# blocks are processed one after the other or concurrently.
+from paraview.simple import *
+from paraview import smtesting
+from vtkmodules.vtkCommonCore import vtkSMPTools
+import os.path
+smtesting.ProcessCommandLineArguments()
+
+reader = OpenDataFile(os.path.join(smtesting.DataDir, "Testing/Data/SPCTH/spcth.0"))
+contour = AMRDualContour(Input=reader)
+contour.SelectMaterialArrays = [contour.SelectMaterialArrays.Available[0]]
+contour.VolumeFractionValue = 0.5
+
+def GetSurface(numberOfThreads):
+    vtkSMPTools.Initialize(numberOfThreads)
+    contour.GetClientSideObject().Modified()
+    contour.UpdatePipeline()
+    surface = contour.GetClientSideObject().GetOutputDataObject(0).GetBlock(0).GetPiece(0)
+    points = surface.GetPoints().GetData()
+    coordinates = [points.GetComponent(i, j)
+                   for i in range(points.GetNumberOfTuples()) for j in range(3)]
+    return surface.GetNumberOfCells(), coordinates
+
+serialCells, serialPoints = GetSurface(1)
+concurrentCells, concurrentPoints = GetSurface(4)
+if serialCells == 0:
+    raise RuntimeError("Empty surface")
+if serialCells != concurrentCells:
+    raise RuntimeError("%d cells with 1 thread and %d with 4" % (serialCells, concurrentCells))
+# points are merged and numbered as when blocks are processed serially.
+if serialPoints != concurrentPoints:
+    raise RuntimeError("Points differ with 1 thread and with 4")
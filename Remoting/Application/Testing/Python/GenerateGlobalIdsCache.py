@@ -0,0 +1,70 @@
+# Tests that global ids reused across updates on an unchanged mesh, or computed
+# from structured extents, are consistent. This should be run with pvbatch in
+# symmetric mode.
+from paraview.simple import *
+from paraview import smtesting
+from paraview.vtk import vtkIdTypeArray
+smtesting.ProcessCommandLineArguments()
+
+pm = servermanager.vtkProcessModule.GetProcessModule()
+controller = pm.GetGlobalController()
+
+def getIds(proxy, association):
+    data = proxy.GetClientSideObject().GetOutputDataObject(0)
+    if association == "points":
+        ids = data.GetPointData().GetArray("GlobalPointIds")
+        ghosts = data.GetPointData().GetArray("vtkGhostType")
+    else:
+        ids = data.GetCellData().GetArray("GlobalCellIds")
+        ghosts = data.GetCellData().GetArray("vtkGhostType")
+    return [ids.GetValue(i) for i in range(ids.GetNumberOfTuples())
+            if ghosts is None or ghosts.GetValue(i) == 0]
+
+def getAllIds(proxy, association):
+    localIds = vtkIdTypeArray()
+    for value in getIds(proxy, association):
+        localIds.InsertNextValue(value)
+    allIds = vtkIdTypeArray()
+    controller.AllGatherV(localIds, allIds)
+    return sorted(allIds.GetValue(i) for i in range(allIds.GetNumberOfTuples()))
+
+def check(name, extent):
+    numberOfPoints = (extent[1] - extent[0] + 1) * (extent[3] - extent[2] + 1) * \
+        (extent[5] - extent[4] + 1)
+    numberOfCells = (extent[1] - extent[0]) * (extent[3] - extent[2]) * (extent[5] - extent[4])
+    for proxy in (cached, reference, structured):
+        proxy.UpdatePipeline()
+    # every point and cell is owned by a single rank.
+    for proxy in (cached, structured):
+        if getAllIds(proxy, "points") != list(range(numberOfPoints)) or \
+           getAllIds(proxy, "cells") != list(range(numberOfCells)):
+            raise RuntimeError("%s: global ids are not unique" % name)
+    # reused ids match the ones generated from scratch.
+    for association in ("points", "cells"):
+        if getIds(cached, association) != getIds(reference, association):
+            raise RuntimeError("%s: cached %s ids differ" % (name, association))
+
+extent = [-10, 10, -10, 10, -10, 10]
+wavelet = Wavelet(WholeExtent=extent)
+calculator = Calculator(Input=wavelet, Function="RTData")
+cached = GlobalPointAndCellIds(Input=calculator)
+structured = GlobalPointAndCellIds(Input=calculator, ComputeStructuredIdsFromExtents=1)
+reference = GlobalPointAndCellIds(Input=calculator)
+check("first update", extent)
+
+# the reference is a new filter, which generates the ids from scratch.
+def newReference():
+    global reference
+    Delete(reference)
+    reference = GlobalPointAndCellIds(Input=calculator)
+
+# only the attributes change: the mesh is unchanged.
+calculator.Function = "2 * RTData"
+newReference()
+check("attributes changed", extent)
+
+# the mesh changes.
+extent = [-10, 12, -10, 10, -10, 10]
+wavelet.WholeExtent = extent
+newReference()
+check("mesh changed", extent)
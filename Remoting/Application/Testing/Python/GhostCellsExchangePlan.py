@@ -0,0 +1,57 @@
+# Tests that the ghost cells generator reuses its cached exchange plan while
+# the mesh is unchanged, rebuilds it when the mesh changes, and produces the
+# same output as without caching. This should be run with pvbatch in
+# symmetric mode.
+from paraview.simple import *
+from paraview import smtesting
+smtesting.ProcessCommandLineArguments()
+
+def compare(cached, reference, name):
+    cachedData = cached.GetClientSideObject().GetOutputDataObject(0)
+    referenceData = reference.GetClientSideObject().GetOutputDataObject(0)
+    if cachedData.GetNumberOfPoints() != referenceData.GetNumberOfPoints() or \
+       cachedData.GetNumberOfCells() != referenceData.GetNumberOfCells():
+        raise RuntimeError("%s: the cached output has a different mesh" % name)
+    for arrayName in ("Result", "vtkGhostType"):
+        cachedArray = cachedData.GetPointData().GetArray(arrayName)
+        referenceArray = referenceData.GetPointData().GetArray(arrayName)
+        if referenceArray is None or cachedArray is None:
+            if referenceArray is not cachedArray:
+                raise RuntimeError("%s: %s is missing" % (name, arrayName))
+            continue
+        for i in range(referenceArray.GetNumberOfTuples()):
+            if cachedArray.GetTuple(i) != referenceArray.GetTuple(i):
+                raise RuntimeError("%s: %s differs at point %d" % (name, arrayName, i))
+
+def update(cached, reference, name, expectReuse):
+    cached.UpdatePipeline()
+    reference.UpdatePipeline()
+    if cached.GetClientSideObject().GetExchangePlanReused() != expectReuse:
+        raise RuntimeError("%s: the exchange plan should%s be reused" %
+                           (name, "" if expectReuse else " not"))
+    if reference.GetClientSideObject().GetExchangePlanReused():
+        raise RuntimeError("%s: the plan is reused while caching is off" % name)
+    compare(cached, reference, name)
+
+wavelet = Wavelet(WholeExtent=[-10, 10, -10, 10, -10, 10])
+tetrahedralize = Tetrahedralize(Input=wavelet)
+for name, source in (("image", wavelet), ("unstructured", tetrahedralize)):
+    calculator = Calculator(Input=source, Function="RTData")
+    cached = GhostCells(Input=calculator, CacheExchangePlan=1)
+    reference = GhostCells(Input=calculator, CacheExchangePlan=0)
+    update(cached, reference, name, False)
+
+    # only the attributes change: the plan is reused.
+    calculator.Function = "2 * RTData + coordsX"
+    update(cached, reference, name, True)
+
+    # the mesh changes: ghosts are generated again.
+    wavelet.WholeExtent = [-10, 12, -10, 10, -10, 10]
+    update(cached, reference, name, False)
+    calculator.Function = "RTData - coordsY"
+    update(cached, reference, name, True)
+    wavelet.WholeExtent = [-10, 10, -10, 10, -10, 10]
+
+    Delete(reference)
+    Delete(cached)
+    Delete(calculator)
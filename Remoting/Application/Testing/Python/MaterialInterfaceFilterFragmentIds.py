@@ -0,0 +1,57 @@
+# Tests that the fragments of the material interface filter are numbered
+# consistently when they are split among processes, and that every process
+# gets the resolved attributes of its fragments. This must be run with
+# pvbatch in symmetric mode.
+from paraview.simple import *
+from paraview import smtesting
+from paraview.vtk import vtkDoubleArray, vtkIntArray
+import os.path
+smtesting.ProcessCommandLineArguments()
+
+reader = OpenDataFile(os.path.join(smtesting.DataDir, "Testing/Data/SPCTH/spcth.0"))
+fragments = MaterialInterfaceFilter(Input=reader)
+fragments.MaterialFractionThreshold = 0.5
+fragments.UpdatePipeline()
+
+pm = servermanager.vtkProcessModule.GetProcessModule()
+controller = pm.GetGlobalController()
+
+# each resolved fragment is owned by a single process.
+localIds = vtkIntArray()
+localVolumes = vtkDoubleArray()
+geometry = fragments.GetClientSideObject().GetOutputDataObject(0)
+iterator = geometry.NewIterator()
+iterator.InitTraversal()
+while not iterator.IsDoneWithTraversal():
+    fieldData = iterator.GetCurrentDataObject().GetFieldData()
+    localIds.InsertNextValue(fieldData.GetArray("Id").GetValue(0))
+    localVolumes.InsertNextValue(fieldData.GetArray("Volume").GetValue(0))
+    iterator.GoToNextItem()
+allIds = vtkIntArray()
+controller.AllGatherV(localIds, allIds)
+allVolumes = vtkDoubleArray()
+controller.AllGatherV(localVolumes, allVolumes)
+ids = sorted(allIds.GetValue(i) for i in range(allIds.GetNumberOfTuples()))
+
+# the statistics are resolved on the first process.
+if controller.GetLocalProcessId() == 0:
+    statistics = fragments.GetClientSideObject().GetOutputDataObject(1)
+    centers = statistics.GetBlock(0)
+    numberOfFragments = centers.GetNumberOfPoints()
+    if numberOfFragments == 0:
+        raise RuntimeError("No fragment found")
+    if ids != list(range(numberOfFragments)):
+        raise RuntimeError("Fragment ids %s do not match the %d fragments" %
+                           (ids, numberOfFragments))
+    volumes = centers.GetPointData().GetArray("Volume")
+    for i in range(numberOfFragments):
+        if volumes.GetValue(i) <= 0:
+            raise RuntimeError("Fragment %d has no volume" % i)
+    # the attributes are reduced on other processes and sent back to the
+    # processes holding the fragments.
+    for i in range(allIds.GetNumberOfTuples()):
+        fragment = allIds.GetValue(i)
+        volume = volumes.GetValue(fragment)
+        if abs(allVolumes.GetValue(i) - volume) > 1e-6 * volume:
+            raise RuntimeError("Fragment %d has a volume of %f instead of %f" %
+                               (fragment, allVolumes.GetValue(i), volume))
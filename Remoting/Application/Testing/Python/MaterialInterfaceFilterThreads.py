@@ -0,0 +1,32 @@
+# Tests that the material interface filter finds the same fragments, with
+# the same ids, whether blocks are processed one after the other or
+# concurrently.
+from paraview.simple import *
+from paraview import smtesting
+from vtkmodules.vtkCommonCore import vtkSMPTools
+import os.path
+smtesting.ProcessCommandLineArguments()
+
+reader = OpenDataFile(os.path.join(smtesting.DataDir, "Testing/Data/SPCTH/spcth.0"))
+fragments = MaterialInterfaceFilter(Input=reader)
+fragments.MaterialFractionThreshold = 0.5
+
+def GetFragments(numberOfThreads):
+    vtkSMPTools.Initialize(numberOfThreads)
+    fragments.GetClientSideObject().Modified()
+    fragments.UpdatePipeline()
+    centers = fragments.GetClientSideObject().GetOutputDataObject(1).GetBlock(0)
+    volumes = centers.GetPointData().GetArray("Volume")
+    return [volumes.GetValue(i) for i in range(centers.GetNumberOfPoints())]
+
+serial = GetFragments(1)
+concurrent = GetFragments(4)
+if not serial:
+    raise RuntimeError("No fragment found")
+if len(serial) != len(concurrent):
+    raise RuntimeError("Found %d fragments with 1 thread and %d with 4" %
+                       (len(serial), len(concurrent)))
+for i, (expected, actual) in enumerate(zip(serial, concurrent)):
+    if abs(expected - actual) > 1e-9 * max(abs(expected), 1.0):
+        raise RuntimeError("Fragment %d has volume %g with 1 thread and %g with 4" %
+                           (i, expected, actual))
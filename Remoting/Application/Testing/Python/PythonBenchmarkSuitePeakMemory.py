@@ -0,0 +1,61 @@
+from paraview.simple import *
+from paraview import servermanager
+from paraview.benchmark import suite
+
+import copy
+
+MIB = 64
+
+
+class AllocateScenario(suite.Scenario):
+    name = 'allocate'
+    parameters = {'mib': MIB}
+
+    def iteration(self, index):
+        # the bytes are written, so that the pages are resident.
+        block = b'\x01' * (self.params['mib'] << 20)
+        del block
+
+    def teardown(self):
+        pass
+
+
+class IdleScenario(AllocateScenario):
+    name = 'idle'
+    parameters = {'mib': 0}
+
+
+def current_memory_use():
+    session = servermanager.ActiveConnection.Session
+    info = servermanager.vtkPVMemoryUseInformation()
+    session.GatherInformation(session.CLIENT_AND_SERVERS, info, 0)
+    return max(info.GetProcMemoryUse(i) for i in range(info.GetSize()))
+
+
+# memory allocated and released within an iteration is part of the peak.
+allocate = suite.run_scenario(AllocateScenario, repeat=2, warmup=0)
+print(allocate['memory_peak_scope'], allocate['memory_peak_kib'], current_memory_use())
+assert allocate['memory_peak_scope'] in ('scenario', 'process')
+assert allocate['memory_peak_kib'] - current_memory_use() >= 0.9 * MIB * 1024
+
+# peaks reset between scenarios do not carry the allocations of earlier ones.
+idle = suite.run_scenario(IdleScenario, repeat=2, warmup=0)
+print(idle['memory_peak_scope'], idle['memory_peak_kib'])
+assert idle['memory_peak_scope'] == allocate['memory_peak_scope']
+if idle['memory_peak_scope'] == 'scenario':
+    assert idle['memory_peak_kib'] <= allocate['memory_peak_kib'] - 0.5 * MIB * 1024
+
+# baselines are compared on the peaks, when they have the same scope.
+results = {'scenarios': {'allocate': allocate}}
+baseline = copy.deepcopy(results)
+baseline['scenarios']['allocate']['memory_peak_kib'] = allocate['memory_peak_kib'] // 2
+entry = suite.compare(results, baseline)[0]
+assert entry['memory_change'] > 0.9 and entry['regression']
+
+other = 'process' if allocate['memory_peak_scope'] == 'scenario' else 'scenario'
+baseline['scenarios']['allocate']['memory_peak_scope'] = other
+entry = suite.compare(results, baseline)[0]
+assert entry['memory_change'] is None
+suite.print_comparison([entry])
+
+print('SUCCESS')
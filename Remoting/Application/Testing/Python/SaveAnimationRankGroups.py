@@ -0,0 +1,53 @@
+# Tests saving an animation with the frames split among groups of ranks. This
+# must be run with pvbatch in symmetric mode on at least 2 ranks.
+from paraview.simple import *
+from paraview import smtesting
+import os.path
+smtesting.ProcessCommandLineArguments()
+
+tempdir = smtesting.GetUniqueTempDirectory("SaveAnimationRankGroups-")
+print("Generating output files in `%s`" % tempdir)
+
+renderView1 = CreateView('RenderView')
+renderView1.ViewSize = [200, 200]
+
+sphere = Sphere()
+Show(sphere, renderView1)
+
+animationScene1 = GetAnimationScene()
+animationScene1.PlayMode = 'Sequence'
+animationScene1.StartTime = 0
+animationScene1.EndTime = 1
+animationScene1.NumberOfFrames = 6
+
+# each group saves a contiguous part of the frames, numbered as when saved by
+# a single group.
+if not SaveAnimation(tempdir + "/groups.png", renderView1, ImageResolution=[200, 200],
+        NumberOfRankGroups=2):
+    raise RuntimeError("Failed to save animation using 2 rank groups")
+
+# the frame window and stride are split the same way.
+if not SaveAnimation(tempdir + "/strided.png", renderView1, ImageResolution=[200, 200],
+        NumberOfRankGroups=2, FrameWindow=[1, 5], FrameStride=2):
+    raise RuntimeError("Failed to save strided animation using 2 rank groups")
+
+# more groups than frames.
+if not SaveAnimation(tempdir + "/window.png", renderView1, ImageResolution=[200, 200],
+        NumberOfRankGroups=4, FrameWindow=[4, 4]):
+    raise RuntimeError("Failed to save a single frame using 4 rank groups")
+
+def CheckFiles(prefix, expected, unexpected):
+    for frame in expected:
+        name = os.path.join(tempdir, "%s.%04d.png" % (prefix, frame))
+        if not os.path.exists(name):
+            raise RuntimeError("Missing frame `%s`" % name)
+    for frame in unexpected:
+        name = os.path.join(tempdir, "%s.%04d.png" % (prefix, frame))
+        if os.path.exists(name):
+            raise RuntimeError("Unexpected frame `%s`" % name)
+
+pm = servermanager.vtkProcessModule.GetProcessModule()
+if pm.GetPartitionId() == 0:
+    CheckFiles("groups", range(6), [6])
+    CheckFiles("strided", [1, 3, 5], [0, 2, 4])
+    CheckFiles("window", [4], [0, 3, 5])
@@ -0,0 +1,161 @@
+# Tests that balancing polygonal data by cost gives every process the same
+# share of a user-supplied cost, and that lazy rebalancing leaves a balanced
+# input alone, that tracked cells stay with their owner and that measured
+# execution times are balanced. This should be run with pvbatch in symmetric
+# mode.
+from paraview.simple import *
+from paraview import smtesting
+from paraview.vtk import vtkDoubleArray
+smtesting.ProcessCommandLineArguments()
+
+pm = servermanager.vtkProcessModule.GetProcessModule()
+controller = pm.GetGlobalController()
+numberOfProcesses = controller.GetNumberOfProcesses()
+
+sphere = Sphere(ThetaResolution=128, PhiResolution=64)
+# cells of process p cost p + 1.
+costs = ProgrammableFilter(Input=sphere)
+costs.Script = """
+from vtkmodules.vtkCommonCore import vtkDoubleArray
+from vtkmodules.vtkParallelCore import vtkMultiProcessController
+rank = vtkMultiProcessController.GetGlobalController().GetLocalProcessId()
+output.ShallowCopy(inputs[0].VTKObject)
+cost = vtkDoubleArray()
+cost.SetName("Cost")
+cost.SetNumberOfTuples(output.GetNumberOfCells())
+cost.Fill(rank + 1)
+output.GetCellData().AddArray(cost)
+"""
+
+def gather(value):
+    local = vtkDoubleArray()
+    local.InsertNextValue(value)
+    values = vtkDoubleArray()
+    controller.AllGatherV(local, values)
+    return [values.GetValue(i) for i in range(values.GetNumberOfTuples())]
+
+def getCosts(proxy):
+    proxy.UpdatePipeline()
+    data = proxy.GetClientSideObject().GetOutputDataObject(0)
+    cost = data.GetCellData().GetArray("Cost")
+    return gather(sum(cost.GetValue(i) for i in range(cost.GetNumberOfTuples())))
+
+inputCosts = getCosts(costs)
+total = sum(inputCosts)
+goal = total / numberOfProcesses
+
+balanced = WeightedRedistributePolyData(Input=costs, BalanceMode="Cost", CostArrayName="Cost")
+outputCosts = getCosts(balanced)
+if abs(sum(outputCosts) - total) > 1e-6 * total:
+    raise RuntimeError("Cells were lost: %s != %s" % (outputCosts, inputCosts))
+# a sender can only miss its goal by a fraction of a cell per receiver.
+for cost in outputCosts:
+    if abs(cost - goal) > numberOfProcesses * numberOfProcesses:
+        raise RuntimeError("Costs %s are not balanced around %f" % (outputCosts, goal))
+
+# the balanced output is within the tolerance: nothing moves.
+lazy = WeightedRedistributePolyData(Input=balanced, BalanceMode="Cost", CostArrayName="Cost",
+                                    LazyRebalancing=1, ImbalanceTolerance=0.05)
+if getCosts(lazy) != outputCosts:
+    raise RuntimeError("Lazy rebalancing moved cells of a balanced input")
+
+# the imbalanced input is rebalanced.
+lazy.Input = costs
+lazyCosts = getCosts(lazy)
+for cost in lazyCosts:
+    if cost > goal * 1.05 + numberOfProcesses * numberOfProcesses:
+        raise RuntimeError("Costs %s are not within the tolerance of %f" % (lazyCosts, goal))
+
+# cells carry global ids. Piece p holds cells p * cellsPerPiece + i, and
+# process r produces the piece (r + shift) % numberOfProcesses.
+cellsPerPiece = 1000
+pieces = ProgrammableSource(OutputDataSetType="vtkPolyData")
+def producePieces(shift, heavyPiece):
+    pieces.Script = """
+from vtkmodules.vtkCommonCore import vtkDoubleArray, vtkIdTypeArray, vtkPoints
+from vtkmodules.vtkCommonDataModel import vtkCellArray
+from vtkmodules.vtkParallelCore import vtkMultiProcessController
+controller = vtkMultiProcessController.GetGlobalController()
+piece = (controller.GetLocalProcessId() + SHIFT) % controller.GetNumberOfProcesses()
+points = vtkPoints()
+verts = vtkCellArray()
+ids = vtkIdTypeArray()
+ids.SetName("GlobalIds")
+cost = vtkDoubleArray()
+cost.SetName("Cost")
+for i in range(CELLS):
+    verts.InsertNextCell(1)
+    verts.InsertCellPoint(points.InsertNextPoint(piece, i, 0))
+    ids.InsertNextValue(piece * CELLS + i)
+    cost.InsertNextValue(COST)
+output.SetPoints(points)
+output.SetVerts(verts)
+output.GetCellData().SetGlobalIds(ids)
+output.GetCellData().AddArray(cost)
+""".replace("SHIFT", str(shift)).replace("CELLS", str(cellsPerPiece)).replace(
+        "COST", "(%d if piece == %d else piece + 1)" % (2 * numberOfProcesses, heavyPiece))
+
+def cellCost(globalId, heavyPiece):
+    piece = globalId // cellsPerPiece
+    return 2 * numberOfProcesses if piece == heavyPiece else piece + 1
+
+def getGlobalIds(proxy):
+    proxy.UpdatePipeline()
+    ids = proxy.GetClientSideObject().GetOutputDataObject(0).GetCellData().GetGlobalIds()
+    return set(int(ids.GetTuple1(i)) for i in range(ids.GetNumberOfTuples()))
+
+producePieces(0, -1)
+tracked = WeightedRedistributePolyData(Input=pieces, BalanceMode="Cost", CostArrayName="Cost",
+                                       TrackCellOwners=1, LazyRebalancing=1)
+owned = getGlobalIds(tracked)
+
+# the same cells produced by other processes go back to their owner.
+producePieces(1, -1)
+if getGlobalIds(tracked) != owned:
+    raise RuntimeError("Tracked cells did not go back to their owner")
+
+# cells of piece 0 now cost more. Only the cost an owner holds above the goal
+# moves, up to a fraction of a cell per receiver.
+producePieces(0, 0)
+rebalanced = getGlobalIds(tracked)
+trackedCosts = getCosts(tracked)
+goal = sum(trackedCosts) / numberOfProcesses
+excess = max(0., sum(cellCost(i, 0) for i in owned) - goal)
+moved = sum(cellCost(i, 0) for i in owned - rebalanced)
+slack = numberOfProcesses * numberOfProcesses * 2 * numberOfProcesses
+if moved > excess + slack:
+    raise RuntimeError("Moved a cost of %f for an excess of %f" % (moved, excess))
+for cost in trackedCosts:
+    if cost > goal * 1.05 + slack:
+        raise RuntimeError("Costs %s are not within the tolerance of %f" % (trackedCosts, goal))
+
+# process p takes 0.05 * (p + 1) seconds to produce its cells: the measured
+# time, shared among its cells, is balanced.
+slow = ProgrammableFilter(Input=sphere)
+slow.Script = """
+import time
+from vtkmodules.vtkCommonCore import vtkIntArray
+from vtkmodules.vtkParallelCore import vtkMultiProcessController
+rank = vtkMultiProcessController.GetGlobalController().GetLocalProcessId()
+time.sleep(0.05 * (rank + 1))
+output.ShallowCopy(inputs[0].VTKObject)
+ranks = vtkIntArray()
+ranks.SetName("Rank")
+ranks.SetNumberOfTuples(output.GetNumberOfCells())
+ranks.Fill(rank)
+output.GetCellData().AddArray(ranks)
+"""
+measured = WeightedRedistributePolyData(Input=slow, BalanceMode="Cost", UseMeasuredCosts=1)
+measured.UpdatePipeline()
+times = gather(slow.GetClientSideObject().GetExecutive().GetLastExecutionTime())
+numberOfCells = gather(slow.GetClientSideObject().GetOutputDataObject(0).GetNumberOfCells())
+ranks = measured.GetClientSideObject().GetOutputDataObject(0).GetCellData().GetArray("Rank")
+measuredCosts = gather(sum(times[int(ranks.GetValue(i))] / numberOfCells[int(ranks.GetValue(i))]
+                           for i in range(ranks.GetNumberOfTuples())))
+goal = sum(times) / numberOfProcesses
+for cost in measuredCosts:
+    if abs(cost - goal) > 0.1 * goal:
+        raise RuntimeError("Measured costs %s are not balanced around %f" % (measuredCosts, goal))
+outputCells = gather(ranks.GetNumberOfTuples())
+if outputCells[0] <= outputCells[-1]:
+    raise RuntimeError("The fastest process did not get more cells: %s" % outputCells)
@@ -0,0 +1,205 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkDataSetAttributes.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkIntArray.h"
+#include "vtkLogger.h"
+#include "vtkMath.h"
+#include "vtkMathUtilities.h"
+#include "vtkNew.h"
+#include "vtkPVArrayInformation.h"
+#include "vtkPVDataInformation.h"
+#include "vtkPVDataSetAttributesInformation.h"
+#include "vtkPointData.h"
+#include "vtkProcessModule.h"
+#include "vtkSOADataArrayTemplate.h"
+#include "vtkTable.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+#define TEST_ASSERT(x, msg)                                                                        \
+  do                                                                                               \
+  {                                                                                                \
+    if (!(x))                                                                                      \
+    {                                                                                              \
+      vtkLogF(ERROR, "Check failed: %s (%s)", #x, std::string(msg).c_str());                      \
+      return false;                                                                                \
+    }                                                                                              \
+  } while (false)
+
+namespace
+{
+constexpr vtkIdType NB_TUPLES = 1000;
+
+// Deterministic values spread over [-500, 500).
+double Value(vtkIdType tuple, int comp)
+{
+  return static_cast<double>((tuple * 7919 + comp * 104729) % 1000) - 500.0;
+}
+
+template <typename ArrayT>
+vtkSmartPointer<ArrayT> CreateArray(const char* name, int numComps)
+{
+  auto array = vtkSmartPointer<ArrayT>::New();
+  array->SetName(name);
+  array->SetNumberOfComponents(numComps);
+  array->SetNumberOfTuples(NB_TUPLES);
+  for (vtkIdType tuple = 0; tuple < NB_TUPLES; ++tuple)
+  {
+    for (int comp = 0; comp < numComps; ++comp)
+    {
+      array->SetComponent(tuple, comp, Value(tuple, comp));
+    }
+  }
+  // extreme values on tuples that are hidden ghosts, see CreateGhosts().
+  array->SetComponent(5, 0, 1e6);
+  array->SetComponent(6, numComps - 1, -1e6);
+  return array;
+}
+
+vtkSmartPointer<vtkUnsignedCharArray> CreateGhosts()
+{
+  auto ghosts = vtkSmartPointer<vtkUnsignedCharArray>::New();
+  ghosts->SetName(vtkDataSetAttributes::GhostArrayName());
+  ghosts->SetNumberOfTuples(NB_TUPLES);
+  ghosts->FillValue(0);
+  ghosts->SetValue(5, vtkDataSetAttributes::HIDDENPOINT);
+  ghosts->SetValue(6, vtkDataSetAttributes::HIDDENPOINT);
+  // duplicate points are not skipped by vtkPointData.
+  ghosts->SetValue(7, vtkDataSetAttributes::DUPLICATEPOINT);
+  return ghosts;
+}
+
+bool SameRange(const double* actual, const double* expected, bool fuzzy)
+{
+  if (fuzzy)
+  {
+    return vtkMathUtilities::FuzzyCompare(actual[0], expected[0]) &&
+      vtkMathUtilities::FuzzyCompare(actual[1], expected[1]);
+  }
+  return actual[0] == expected[0] && actual[1] == expected[1];
+}
+
+// Compares the ranges computed in a single pass with the ones of
+// vtkDataArray::GetRange() and GetFiniteRange(), which take a pass each.
+bool CompareRanges(vtkPointData* pd, const char* name)
+{
+  int idx = -1;
+  auto array = pd->GetArray(name, idx);
+  auto ghosts = pd->GetGhostArray();
+  const unsigned char* ghostValues = ghosts ? ghosts->GetPointer(0) : nullptr;
+  const std::string where = std::string(name) + (ghosts ? " with ghosts" : "");
+
+  vtkNew<vtkPVArrayInformation> info;
+  info->CopyFromArray(pd, idx);
+  TEST_ASSERT(!info->GetIsRangeApproximate(), where);
+  for (int comp = -1; comp < array->GetNumberOfComponents(); ++comp)
+  {
+    // magnitudes are square roots, computed in a different order.
+    const bool fuzzy = comp < 0;
+    double expected[2];
+    array->GetRange(expected, comp, ghostValues, pd->GetGhostsToSkip());
+    TEST_ASSERT(SameRange(info->GetComponentRange(comp), expected, fuzzy),
+      where + ", range of component " + std::to_string(comp));
+    array->GetFiniteRange(expected, comp, ghostValues, pd->GetGhostsToSkip());
+    TEST_ASSERT(SameRange(info->GetComponentFiniteRange(comp), expected, fuzzy),
+      where + ", finite range of component " + std::to_string(comp));
+  }
+
+  // ranges computed on all the tuples are cached in the array as
+  // vtkDataArray::GetRange() does.
+  vtkInformationVector* perComponent = array->GetInformation()->Get(vtkDataArray::PER_COMPONENT());
+  const bool cached = perComponent != nullptr &&
+    perComponent->GetInformationObject(0)->Has(vtkDataArray::COMPONENT_RANGE());
+  TEST_ASSERT(cached == (ghosts == nullptr), where + ", cached ranges");
+  return true;
+}
+
+bool TestSinglePassRanges(bool withGhosts)
+{
+  vtkNew<vtkPointData> pd;
+  auto doubles = CreateArray<vtkDoubleArray>("doubles", 3);
+  doubles->SetComponent(10, 1, vtkMath::Inf());
+  doubles->SetComponent(11, 0, -vtkMath::Inf());
+  doubles->SetComponent(20, 2, vtkMath::Nan());
+  pd->AddArray(doubles);
+  pd->AddArray(CreateArray<vtkFloatArray>("floats", 2));
+  pd->AddArray(CreateArray<vtkIntArray>("ints", 1));
+  pd->AddArray(CreateArray<vtkSOADataArrayTemplate<double>>("soa", 2));
+  if (withGhosts)
+  {
+    pd->AddArray(CreateGhosts());
+  }
+
+  for (const char* name : { "doubles", "floats", "ints", "soa" })
+  {
+    if (!CompareRanges(pd, name))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+vtkPVArrayInformation* GatherValuesInformation(vtkTable* table, vtkPVDataInformation* info)
+{
+  info->Initialize();
+  info->CopyFromObject(table);
+  return info->GetRowDataInformation()->GetArrayInformation("values");
+}
+
+bool TestEstimatedRanges()
+{
+  // the estimate visits about 65536 tuples, i.e. one in eight here. The
+  // extreme value is not on one of them.
+  const vtkIdType numTuples = 8 * 65536;
+  vtkNew<vtkDoubleArray> values;
+  values->SetName("values");
+  values->SetNumberOfTuples(numTuples);
+  values->FillValue(0.0);
+  values->SetValue(3, 100.0);
+  vtkNew<vtkTable> table;
+  table->AddColumn(values);
+
+  // exact unless requested.
+  vtkNew<vtkPVDataInformation> info;
+  auto ainfo = GatherValuesInformation(table, info);
+  TEST_ASSERT(ainfo && !ainfo->GetIsRangeApproximate(), "exact ranges by default");
+  TEST_ASSERT(ainfo->GetComponentRange(0)[1] == 100.0, "exact ranges by default");
+
+  values->Modified();
+  info->SetEstimateRanges(true);
+  ainfo = GatherValuesInformation(table, info);
+  TEST_ASSERT(ainfo && ainfo->GetIsRangeApproximate(), "estimated ranges");
+  TEST_ASSERT(info->HasApproximateRanges(), "estimated ranges");
+  TEST_ASSERT(ainfo->GetComponentRange(0)[1] == 0.0, "estimated ranges");
+
+  // the exact ranges are computed in the background.
+  for (int attempt = 0; attempt < 1000 && ainfo->GetIsRangeApproximate(); ++attempt)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    ainfo = GatherValuesInformation(table, info);
+  }
+  TEST_ASSERT(!ainfo->GetIsRangeApproximate(), "refined ranges");
+  TEST_ASSERT(!info->HasApproximateRanges(), "refined ranges");
+  TEST_ASSERT(ainfo->GetComponentRange(0)[1] == 100.0, "refined ranges");
+  return true;
+}
+}
+
+extern int TestPVArrayInformationRanges(int argc, char* argv[])
+{
+  // the process module runs the refinement of the estimated ranges.
+  vtkProcessModule::Initialize(vtkProcessModule::PROCESS_CLIENT, argc, argv);
+  const bool success =
+    TestSinglePassRanges(false) && TestSinglePassRanges(true) && TestEstimatedRanges();
+  vtkProcessModule::Finalize();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,207 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkClientServerStream.h"
+#include "vtkLogger.h"
+#include "vtkMultiProcessStream.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVTraceInformation.h"
+#include "vtkPVTraceRecorder.h"
+
+#include <cstdlib>
+#include <string>
+
+#define TEST_ASSERT(x)                                                                             \
+  do                                                                                               \
+  {                                                                                                \
+    if (!(x))                                                                                      \
+    {                                                                                              \
+      vtkLogF(ERROR, "Check failed: %s", #x);                                                      \
+      return false;                                                                                \
+    }                                                                                              \
+  } while (false)
+
+namespace
+{
+// Sets the times normally taken from the clock when a request is sent,
+// received and answered.
+class vtkTestTraceInformation : public vtkPVTraceInformation
+{
+public:
+  static vtkTestTraceInformation* New();
+  vtkTypeMacro(vtkTestTraceInformation, vtkPVTraceInformation);
+
+  void SetRequestTimes(vtkTypeInt64 request, vtkTypeInt64 sync)
+  {
+    this->RequestTime = request;
+    this->SyncTime = sync;
+  }
+  void SetResponseTime(vtkTypeInt64 response) { this->ResponseTime = response; }
+};
+vtkStandardNewMacro(vtkTestTraceInformation);
+
+struct StreamEvent
+{
+  vtkTypeInt64 Begin;
+  vtkTypeInt64 Duration;
+  vtkTypeUInt32 Thread;
+  std::string Category;
+  std::string Name;
+};
+
+// Appends a track as serialized by vtkPVTraceInformation::CopyToStream.
+void AddTrack(vtkClientServerStream& css, const std::string& name, vtkTypeInt64 syncTime,
+  const StreamEvent& event)
+{
+  css << name << syncTime << static_cast<vtkTypeUInt32>(1) << event.Begin << event.Duration
+      << event.Thread << event.Category << event.Name;
+}
+
+bool Contains(const std::string& trace, const std::string& expected)
+{
+  if (trace.find(expected) == std::string::npos)
+  {
+    vtkLogF(ERROR, "'%s' not found in:\n%s", expected.c_str(), trace.c_str());
+    return false;
+  }
+  return true;
+}
+
+// Tracks from the server root are moved to the client clock using the round
+// trip of the request; tracks of the server satellites are already aligned on
+// the server root.
+bool TestClientServer()
+{
+  // the server clock is 1 ms ahead, the request and the reply take 100 ns.
+  const vtkTypeInt64 request = 1000;
+  const vtkTypeInt64 serverSync = request + 100 + 1000000;
+  const vtkTypeInt64 serverReply = serverSync + 500;
+  const vtkTypeInt64 response = request + 100 + 500 + 100;
+
+  vtkPVTraceRecorder::Clear();
+  vtkPVTraceRecorder::SetEnabled(true);
+  vtkPVTraceRecorder::Record("PIPELINE", "update", 1050, 1150);
+  vtkPVTraceRecorder::SetEnabled(false);
+
+  vtkNew<vtkTestTraceInformation> client;
+  client->SetRequestTimes(request, request);
+  client->AddLocalTrack("client");
+
+  vtkClientServerStream css;
+  css << vtkClientServerStream::Reply << 0 << serverSync << serverReply
+      << static_cast<vtkTypeUInt32>(2);
+  AddTrack(css, "server 0", serverSync, { serverSync + 100, 50, 0, "RENDERING", "render" });
+  AddTrack(css, "server 1", serverSync,
+    { serverSync + 200, 20, 1, "DATA_MOVEMENT", "deliver \"x\"\n" });
+  css << vtkClientServerStream::End;
+
+  vtkNew<vtkTestTraceInformation> reply;
+  reply->CopyFromStream(&css);
+  reply->SetResponseTime(response);
+  client->AddInformation(reply);
+
+  TEST_ASSERT(client->GetNumberOfTracks() == 3);
+  TEST_ASSERT(client->GetNumberOfEvents() == 3);
+
+  // times are relative to the first event, the client update at 1050 ns. The
+  // server events happened at 1200 and 1300 ns on the client clock.
+  const std::string trace = client->GetChromeTrace();
+  TEST_ASSERT(trace.compare(0, 39, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[") == 0);
+  TEST_ASSERT(trace.compare(trace.size() - 4, 4, "\n]}\n") == 0);
+  return Contains(trace,
+           "{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":0,\"args\":{\"name\":\"client\"}}") &&
+    Contains(trace,
+      "{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":2,\"args\":{\"name\":\"server 1\"}}") &&
+    Contains(trace,
+      "{\"ph\":\"M\",\"name\":\"process_sort_index\",\"pid\":1,\"args\":{\"sort_index\":1}}") &&
+    Contains(trace,
+      "{\"ph\":\"X\",\"name\":\"update\",\"cat\":\"PIPELINE\",\"pid\":0,\"tid\":" +
+        std::to_string(vtkPVTraceRecorder::GetEvents()[0].Thread) +
+        ",\"ts\":0.000,\"dur\":0.100}") &&
+    Contains(trace,
+      "{\"ph\":\"X\",\"name\":\"render\",\"cat\":\"RENDERING\",\"pid\":1,\"tid\":0,"
+      "\"ts\":0.150,\"dur\":0.050}") &&
+    Contains(trace,
+      "{\"ph\":\"X\",\"name\":\"deliver \\\"x\\\"\\n\",\"cat\":\"DATA_MOVEMENT\",\"pid\":2,"
+      "\"tid\":1,\"ts\":0.250,\"dur\":0.020}");
+}
+
+// Satellites are aligned on the root at the time they received the request.
+bool TestSatellites()
+{
+  vtkPVTraceRecorder::Clear();
+  vtkPVTraceRecorder::SetEnabled(true);
+  vtkPVTraceRecorder::Record("RENDERING", "composite", 5050, 5060);
+  vtkPVTraceRecorder::SetEnabled(false);
+
+  vtkNew<vtkTestTraceInformation> root;
+  root->SetRequestTimes(-1, 5000);
+  root->AddLocalTrack("server 0");
+
+  // rank 1 received the request at 9000 on its own clock.
+  vtkClientServerStream css;
+  css << vtkClientServerStream::Reply << 1 << static_cast<vtkTypeInt64>(9000)
+      << static_cast<vtkTypeInt64>(9500) << static_cast<vtkTypeUInt32>(1);
+  AddTrack(css, "server 1", 9000, { 9100, 10, 0, "RENDERING", "composite" });
+  css << vtkClientServerStream::End;
+
+  vtkNew<vtkTestTraceInformation> satellite;
+  satellite->CopyFromStream(&css);
+  root->AddInformation(satellite);
+  TEST_ASSERT(root->GetNumberOfTracks() == 2);
+
+  const std::string trace = root->GetChromeTrace();
+  if (!Contains(trace, "\"pid\":1,\"tid\":0,\"ts\":0.050,\"dur\":0.010}"))
+  {
+    return false;
+  }
+
+  // the tracks survive serialization unchanged.
+  vtkClientServerStream serialized;
+  root->CopyToStream(&serialized);
+  vtkNew<vtkPVTraceInformation> received;
+  received->CopyFromStream(&serialized);
+  TEST_ASSERT(received->GetNumberOfTracks() == 2);
+  TEST_ASSERT(received->GetChromeTrace() == trace);
+  return true;
+}
+
+// The parameters enable, disable and clear recording where the information
+// is gathered.
+bool TestParameters()
+{
+  vtkNew<vtkPVTraceInformation> request;
+  request->SetEnableTracing(1);
+  request->SetClearEvents(true);
+  vtkMultiProcessStream stream;
+  request->CopyParametersToStream(stream);
+
+  vtkNew<vtkPVTraceInformation> gathered;
+  gathered->CopyParametersFromStream(stream);
+  TEST_ASSERT(gathered->GetEnableTracing() == 1 && gathered->GetClearEvents());
+
+  vtkPVTraceRecorder::SetEnabled(false);
+  vtkPVTraceRecorder::Clear();
+  gathered->CopyFromObject(nullptr);
+  TEST_ASSERT(vtkPVTraceRecorder::GetEnabled());
+  {
+    vtkPVTraceScopeF("PIPELINE", "execute %d", 1);
+  }
+  gathered->CopyFromObject(nullptr);
+  TEST_ASSERT(gathered->GetNumberOfTracks() == 1 && gathered->GetNumberOfEvents() == 1);
+  TEST_ASSERT(vtkPVTraceRecorder::GetEvents().empty());
+
+  gathered->SetEnableTracing(0);
+  gathered->CopyFromObject(nullptr);
+  TEST_ASSERT(!vtkPVTraceRecorder::GetEnabled());
+  return true;
+}
+}
+
+extern int TestPVTraceInformation(int, char*[])
+{
+  const bool success = TestClientServer() && TestSatellites() && TestParameters();
+  vtkPVTraceRecorder::SetEnabled(false);
+  vtkPVTraceRecorder::Clear();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
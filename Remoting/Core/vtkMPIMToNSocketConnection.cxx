@@ -5,12 +5,15 @@
 #include "vtkClientSocket.h"
 #include "vtkMPIMToNSocketConnectionPortInformation.h"
 #include "vtkMultiProcessController.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkProcessModule.h"
 #include "vtkRemotingCoreConfiguration.h"
 #include "vtkServerSocket.h"
+#include "vtkSmartPointer.h"
 #include "vtkSocketCommunicator.h"
 
+#include <algorithm>
 #include <cassert>
 #include <string>
 #include <vector>
@@ -30,6 +33,10 @@ public:
   std::vector<NodeInformation> ServerInformation;
 
   std::string SelfHostName;
+
+  // communicators for this process, with the remote process they connect to.
+  std::vector<vtkSmartPointer<vtkSocketCommunicator>> Communicators;
+  std::vector<int> RemoteProcessIds;
 };
 
 vtkMPIMToNSocketConnection::vtkMPIMToNSocketConnection()
@@ -52,6 +59,13 @@ vtkMPIMToNSocketConnection::~vtkMPIMToNSocketConnection()
     this->ServerSocket->Delete();
     this->ServerSocket = nullptr;
   }
+  for (const auto& communicator : this->Internals->Communicators)
+  {
+    if (communicator != this->SocketCommunicator)
+    {
+      communicator->CloseConnection();
+    }
+  }
   if (this->SocketCommunicator)
   {
     this->SocketCommunicator->CloseConnection();
@@ -172,6 +186,8 @@ void vtkMPIMToNSocketConnection::WaitForConnection()
   this->SocketCommunicator->Receive(&data, 1, 1, 1238);
   cout << "Received Hello from process " << data << "\n";
   cout.flush();
+  this->Internals->Communicators.emplace_back(this->SocketCommunicator);
+  this->Internals->RemoteProcessIds.push_back(data);
 }
 
 //------------------------------------------------------------------------------
@@ -188,20 +204,56 @@ void vtkMPIMToNSocketConnection::Connect()
     return;
   }
 
-  this->SocketCommunicator = vtkSocketCommunicator::New();
+  // when there are fewer processes on this side, connect to every waiting
+  // process with the same rank modulo the number of processes.
+  const unsigned int numProcs =
+    static_cast<unsigned int>(std::max(1, this->Controller->GetNumberOfProcesses()));
+  for (unsigned int target = myId; target < this->Internals->ServerInformation.size();
+       target += numProcs)
+  {
+    vtkNew<vtkSocketCommunicator> communicator;
 
-  const vtkMPIMToNSocketConnectionInternals::NodeInformation& targetNode =
-    this->Internals->ServerInformation[myId];
+    const vtkMPIMToNSocketConnectionInternals::NodeInformation& targetNode =
+      this->Internals->ServerInformation[target];
 
-  cout << "Connecting :"
-       << " rank :" << myId << " dest-host :" << targetNode.HostName.c_str()
-       << " dest-port :" << targetNode.PortNumber << endl;
+    cout << "Connecting :"
+         << " rank :" << myId << " dest-host :" << targetNode.HostName.c_str()
+         << " dest-port :" << targetNode.PortNumber << endl;
 
-  this->SocketCommunicator->ConnectTo(
-    const_cast<char*>(targetNode.HostName.c_str()), targetNode.PortNumber);
+    communicator->ConnectTo(const_cast<char*>(targetNode.HostName.c_str()), targetNode.PortNumber);
 
-  int id = static_cast<int>(myId);
-  this->SocketCommunicator->Send(&id, 1, 1, 1238);
+    int id = static_cast<int>(myId);
+    communicator->Send(&id, 1, 1, 1238);
+
+    if (this->SocketCommunicator == nullptr)
+    {
+      this->SetSocketCommunicator(communicator);
+    }
+    this->Internals->Communicators.emplace_back(communicator);
+    this->Internals->RemoteProcessIds.push_back(static_cast<int>(target));
+  }
+}
+
+//------------------------------------------------------------------------------
+int vtkMPIMToNSocketConnection::GetNumberOfSocketCommunicators()
+{
+  return static_cast<int>(this->Internals->Communicators.size());
+}
+
+//------------------------------------------------------------------------------
+vtkSocketCommunicator* vtkMPIMToNSocketConnection::GetSocketCommunicator(int index)
+{
+  return index >= 0 && index < this->GetNumberOfSocketCommunicators()
+    ? this->Internals->Communicators[index].GetPointer()
+    : nullptr;
+}
+
+//------------------------------------------------------------------------------
+int vtkMPIMToNSocketConnection::GetRemoteProcessId(int index)
+{
+  return index >= 0 && index < this->GetNumberOfSocketCommunicators()
+    ? this->Internals->RemoteProcessIds[index]
+    : -1;
 }
 
 //------------------------------------------------------------------------------
@@ -16,6 +16,12 @@
  * number of rendering processors are call N.  This class is used to create N
  * vtkSocketCommunicator's that connect the first N of the M processes on the
  * data server to the N processes on the render server.
+ *
+ * When the connecting side has fewer processes than connections, e.g. the
+ * client, each connecting process connects to several waiting processes:
+ * process `i` connects to processes `i`, `i + M`, `i + 2M`, etc. This is used
+ * to connect the client to several data server processes for striped data
+ * delivery (see vtkMPIMoveData).
  */
 
 #ifndef vtkMPIMToNSocketConnection_h
@@ -63,6 +69,18 @@ public:
   vtkGetObjectMacro(SocketCommunicator, vtkSocketCommunicator);
   ///@}
 
+  ///@{
+  /**
+   * Return the socket communicators for this process, with the index of the
+   * remote process each one is connected to. There are several communicators
+   * only on a connecting process connected to several waiting processes,
+   * otherwise this is the same as GetSocketCommunicator().
+   */
+  int GetNumberOfSocketCommunicators();
+  vtkSocketCommunicator* GetSocketCommunicator(int index);
+  int GetRemoteProcessId(int index);
+  ///@}
+
   /**
    * Fill the port information values into the port information object.
    */
@@ -3,26 +3,40 @@
 #include "vtkPVArrayInformation.h"
 
 #include "vtkAbstractArray.h"
+#include "vtkArrayDispatch.h"
 #include "vtkCellAttribute.h"
 #include "vtkCellGrid.h"
 #include "vtkClientServerStream.h"
 #include "vtkDataArray.h"
+#include "vtkDataArrayRange.h"
 #include "vtkFieldData.h"
 #include "vtkGenericAttribute.h"
 #include "vtkInformation.h"
 #include "vtkInformationIterator.h"
 #include "vtkInformationKey.h"
+#include "vtkInformationVector.h"
 #include "vtkNew.h"
 #include "vtkNumberToString.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVLogger.h"
 #include "vtkPVPostFilter.h"
+#include "vtkProcessModule.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkStringArray.h"
+#include "vtkThreadedCallbackQueue.h"
+#include "vtkUnsignedCharArray.h"
 
 #include <algorithm>
+#include <cmath>
+#include <limits>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <sstream>
+#include <type_traits>
 #include <vector>
 
 namespace
@@ -42,6 +56,403 @@ vtkTuple<double, 2> MergeRanges(const vtkTuple<double, 2>& r1, const vtkTuple<do
   return vtkTuple<double, 2>({ std::min(r1[0], r2[0]), std::max(r1[1], r2[1]) });
 }
 
+// Number of tuples visited when ranges are estimated.
+static constexpr vtkIdType RANGE_SAMPLE_SIZE = 65536;
+static constexpr size_t MAX_CACHED_RANGES = 4096;
+// Memory, in KiB, of the arrays referenced by the refinements waiting in the
+// callback queue. Their buffers stay allocated until the refinements are done.
+static constexpr vtkTypeUInt64 MAX_PENDING_REFINEMENTS_SIZE = 1 << 20;
+
+// Ranges of the magnitude followed by each component of an array: four values
+// per component, the range then the finite range.
+using RangesType = std::vector<double>;
+
+//----------------------------------------------------------------------------
+// Computes the range and the finite range of all the components and of the
+// magnitude of an array in a single pass, skipping ghosts. Visiting every
+// Stride-th tuple estimates the ranges from a sample. Component ranges are
+// accumulated in the value type of the array using selects rather than
+// branches, so that the inner loop vectorizes for arrays with the standard
+// memory layout.
+template <typename ArrayT>
+class RangeFunctor
+{
+  using ValueT = vtk::GetAPIType<ArrayT>;
+  static constexpr bool IsReal = std::is_floating_point<ValueT>::value;
+
+  static constexpr ValueT InitialMin()
+  {
+    return IsReal ? std::numeric_limits<ValueT>::infinity() : std::numeric_limits<ValueT>::max();
+  }
+  static constexpr ValueT InitialMax()
+  {
+    return IsReal ? -std::numeric_limits<ValueT>::infinity()
+                  : std::numeric_limits<ValueT>::lowest();
+  }
+
+  struct Accumulator
+  {
+    std::vector<ValueT> Min, Max, FiniteMin, FiniteMax;
+    // squared magnitudes
+    double Magnitude[4] = { std::numeric_limits<double>::infinity(),
+      -std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity(),
+      -std::numeric_limits<double>::infinity() };
+  };
+
+  ArrayT* Array;
+  const unsigned char* Ghosts;
+  unsigned char GhostsToSkip;
+  vtkIdType Stride;
+  int NumberOfComponents;
+  vtkSMPThreadLocal<Accumulator> TLAccumulator;
+
+public:
+  RangesType Ranges;
+
+  RangeFunctor(ArrayT* array, const unsigned char* ghosts, unsigned char ghostsToSkip,
+    vtkIdType stride)
+    : Array(array)
+    , Ghosts(ghosts)
+    , GhostsToSkip(ghostsToSkip)
+    , Stride(stride)
+    , NumberOfComponents(array->GetNumberOfComponents())
+  {
+  }
+
+  void Initialize()
+  {
+    auto& acc = this->TLAccumulator.Local();
+    acc.Min.assign(this->NumberOfComponents, InitialMin());
+    acc.Max.assign(this->NumberOfComponents, InitialMax());
+    acc.FiniteMin = acc.Min;
+    acc.FiniteMax = acc.Max;
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    auto& acc = this->TLAccumulator.Local();
+    const auto values = vtk::DataArrayValueRange(this->Array);
+    const int numComps = this->NumberOfComponents;
+    ValueT* min = acc.Min.data();
+    ValueT* max = acc.Max.data();
+    ValueT* finiteMin = acc.FiniteMin.data();
+    ValueT* finiteMax = acc.FiniteMax.data();
+    double* magnitude = acc.Magnitude;
+    for (vtkIdType step = begin; step < end; ++step)
+    {
+      const vtkIdType tuple = step * this->Stride;
+      if (this->Ghosts && (this->Ghosts[tuple] & this->GhostsToSkip))
+      {
+        continue;
+      }
+
+      double squaredNorm = 0.0;
+      for (int comp = 0; comp < numComps; ++comp)
+      {
+        const ValueT value = values[tuple * numComps + comp];
+        squaredNorm += static_cast<double>(value) * static_cast<double>(value);
+        // comparisons with NaN are false, so NaN are skipped.
+        min[comp] = value < min[comp] ? value : min[comp];
+        max[comp] = value > max[comp] ? value : max[comp];
+        if constexpr (IsReal)
+        {
+          const bool finite = std::isfinite(value);
+          finiteMin[comp] = (finite && value < finiteMin[comp]) ? value : finiteMin[comp];
+          finiteMax[comp] = (finite && value > finiteMax[comp]) ? value : finiteMax[comp];
+        }
+      }
+      magnitude[0] = squaredNorm < magnitude[0] ? squaredNorm : magnitude[0];
+      magnitude[1] = squaredNorm > magnitude[1] ? squaredNorm : magnitude[1];
+      if (std::isfinite(squaredNorm))
+      {
+        magnitude[2] = squaredNorm < magnitude[2] ? squaredNorm : magnitude[2];
+        magnitude[3] = squaredNorm > magnitude[3] ? squaredNorm : magnitude[3];
+      }
+    }
+  }
+
+  void Reduce()
+  {
+    const int numComps = this->NumberOfComponents;
+    const double inf = std::numeric_limits<double>::infinity();
+    std::vector<double> bounds(4 * (numComps + 1));
+    for (size_t cc = 0; cc < bounds.size(); cc += 2)
+    {
+      bounds[cc] = inf;
+      bounds[cc + 1] = -inf;
+    }
+
+    auto merge = [](double* bds, double min, double max) {
+      bds[0] = std::min(bds[0], min);
+      bds[1] = std::max(bds[1], max);
+    };
+    for (auto& acc : this->TLAccumulator)
+    {
+      if (acc.Min.empty())
+      {
+        continue;
+      }
+      merge(&bounds[0], acc.Magnitude[0], acc.Magnitude[1]);
+      merge(&bounds[2], acc.Magnitude[2], acc.Magnitude[3]);
+      for (int comp = 0; comp < numComps; ++comp)
+      {
+        double* bds = &bounds[4 * (comp + 1)];
+        merge(bds, static_cast<double>(acc.Min[comp]), static_cast<double>(acc.Max[comp]));
+        merge(bds + 2, static_cast<double>(IsReal ? acc.FiniteMin[comp] : acc.Min[comp]),
+          static_cast<double>(IsReal ? acc.FiniteMax[comp] : acc.Max[comp]));
+      }
+    }
+
+    // magnitudes were accumulated squared. Empty ranges are reported as
+    // vtkDataArray::GetRange() does.
+    for (int cc = 0; cc < 4; ++cc)
+    {
+      bounds[cc] = bounds[cc] == -inf ? bounds[cc] : std::sqrt(bounds[cc]);
+    }
+    this->Ranges.resize(bounds.size());
+    for (size_t cc = 0; cc < bounds.size(); cc += 2)
+    {
+      const bool empty = bounds[cc] > bounds[cc + 1];
+      this->Ranges[cc] = empty ? VTK_DOUBLE_MAX : bounds[cc];
+      this->Ranges[cc + 1] = empty ? -VTK_DOUBLE_MAX : bounds[cc + 1];
+    }
+
+    // vtkDataArray::GetRange() reports the range of the component as the
+    // magnitude range of single component arrays.
+    if (numComps == 1)
+    {
+      std::copy(this->Ranges.begin() + 4, this->Ranges.end(), this->Ranges.begin());
+    }
+  }
+};
+
+struct ComputeRangesWorker
+{
+  template <typename ArrayT>
+  void operator()(ArrayT* array, const unsigned char* ghosts, unsigned char ghostsToSkip,
+    vtkIdType stride, bool parallel, RangesType& ranges) const
+  {
+    RangeFunctor<ArrayT> functor(array, ghosts, ghostsToSkip, stride);
+    const vtkIdType numSteps = (array->GetNumberOfTuples() + stride - 1) / stride;
+    if (parallel)
+    {
+      vtkSMPTools::For(0, numSteps, functor);
+    }
+    else
+    {
+      functor.Initialize();
+      functor(0, numSteps);
+      functor.Reduce();
+    }
+    ranges = std::move(functor.Ranges);
+  }
+};
+
+RangesType ComputeRanges(vtkDataArray* array, vtkUnsignedCharArray* ghosts,
+  unsigned char ghostsToSkip, vtkIdType stride, bool parallel)
+{
+  const unsigned char* ghostValues =
+    (ghosts && ghostsToSkip && ghosts->GetNumberOfTuples() >= array->GetNumberOfTuples())
+    ? ghosts->GetPointer(0)
+    : nullptr;
+
+  RangesType ranges;
+  ComputeRangesWorker worker;
+  if (!vtkArrayDispatch::Dispatch::Execute(
+        array, worker, ghostValues, ghostsToSkip, stride, parallel, ranges))
+  {
+    worker(array, ghostValues, ghostsToSkip, stride, parallel, ranges);
+  }
+  return ranges;
+}
+
+//----------------------------------------------------------------------------
+// Stores exact ranges computed without skipping ghosts in the keys used by
+// vtkDataArray::GetRange() and GetFiniteRange() to cache ranges, so that
+// later users of the array, e.g. color mapping, do not scan it again.
+void StoreInRangeKeys(vtkDataArray* array, const RangesType& ranges)
+{
+  vtkInformation* info = array->GetInformation();
+  const int numComps = array->GetNumberOfComponents();
+  if (numComps > 1)
+  {
+    info->Set(vtkDataArray::L2_NORM_RANGE(), &ranges[0], 2);
+    info->Set(vtkDataArray::L2_NORM_FINITE_RANGE(), &ranges[2], 2);
+  }
+
+  auto getComponentsInfo = [&](vtkInformationInformationVectorKey* key) {
+    vtkInformationVector* infoVec = info->Get(key);
+    if (!infoVec || infoVec->GetNumberOfInformationObjects() < numComps)
+    {
+      infoVec = vtkInformationVector::New();
+      infoVec->SetNumberOfInformationObjects(numComps);
+      info->Set(key, infoVec);
+      infoVec->FastDelete();
+    }
+    return infoVec;
+  };
+  vtkInformationVector* componentsInfo = getComponentsInfo(vtkDataArray::PER_COMPONENT());
+  vtkInformationVector* finiteComponentsInfo =
+    getComponentsInfo(vtkDataArray::PER_FINITE_COMPONENT());
+  for (int comp = 0; comp < numComps; ++comp)
+  {
+    componentsInfo->GetInformationObject(comp)->Set(
+      vtkDataArray::COMPONENT_RANGE(), &ranges[4 * (comp + 1)], 2);
+    finiteComponentsInfo->GetInformationObject(comp)->Set(
+      vtkDataArray::COMPONENT_RANGE(), &ranges[4 * (comp + 1) + 2], 2);
+  }
+}
+
+//----------------------------------------------------------------------------
+// Identifies the state of an array ranges were computed for. Modification
+// times are unique, so an array reallocated at the address of a deleted one
+// never matches the stamp of its predecessor.
+struct RangeStamp
+{
+  vtkMTimeType ArrayMTime = 0;
+  vtkMTimeType GhostsMTime = 0;
+  vtkIdType NumberOfTuples = 0;
+  int NumberOfComponents = 0;
+  unsigned char GhostsToSkip = 0;
+
+  bool operator==(const RangeStamp& other) const
+  {
+    return this->ArrayMTime == other.ArrayMTime && this->GhostsMTime == other.GhostsMTime &&
+      this->NumberOfTuples == other.NumberOfTuples &&
+      this->NumberOfComponents == other.NumberOfComponents &&
+      this->GhostsToSkip == other.GhostsToSkip;
+  }
+};
+
+//----------------------------------------------------------------------------
+// Exact ranges of the arrays seen last, so that information about unmodified
+// arrays is gathered without scanning them again. Exact ranges of arrays whose
+// ranges were estimated are computed in the background, on the process
+// module's callback queue, and added here when done.
+class RangeCache
+{
+  struct Entry
+  {
+    RangeStamp Stamp;
+    RangesType Ranges;
+    vtkTypeUInt64 LastUse = 0;
+  };
+
+  std::mutex Mutex;
+  std::map<const vtkDataArray*, Entry> Entries;
+  std::map<const vtkDataArray*, RangeStamp> PendingRefinements;
+  vtkTypeUInt64 PendingRefinementsSize = 0;
+  vtkTypeUInt64 UseCounter = 0;
+
+  void AddLocked(const vtkDataArray* array, const RangeStamp& stamp, RangesType&& ranges)
+  {
+    if (this->Entries.size() >= MAX_CACHED_RANGES &&
+      this->Entries.find(array) == this->Entries.end())
+    {
+      // forget the half used least recently.
+      std::vector<vtkTypeUInt64> uses;
+      uses.reserve(this->Entries.size());
+      for (const auto& item : this->Entries)
+      {
+        uses.push_back(item.second.LastUse);
+      }
+      auto median = uses.begin() + uses.size() / 2;
+      std::nth_element(uses.begin(), median, uses.end());
+      for (auto iter = this->Entries.begin(); iter != this->Entries.end();)
+      {
+        iter = iter->second.LastUse <= *median ? this->Entries.erase(iter) : std::next(iter);
+      }
+    }
+    this->Entries[array] = Entry{ stamp, std::move(ranges), ++this->UseCounter };
+  }
+
+public:
+  static const std::shared_ptr<RangeCache>& GetInstance()
+  {
+    static const auto instance = std::make_shared<RangeCache>();
+    return instance;
+  }
+
+  bool Find(const vtkDataArray* array, const RangeStamp& stamp, RangesType& ranges)
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    auto iter = this->Entries.find(array);
+    if (iter == this->Entries.end() || !(iter->second.Stamp == stamp))
+    {
+      return false;
+    }
+    iter->second.LastUse = ++this->UseCounter;
+    ranges = iter->second.Ranges;
+    return true;
+  }
+
+  void Add(const vtkDataArray* array, const RangeStamp& stamp, RangesType ranges)
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    this->AddLocked(array, stamp, std::move(ranges));
+  }
+
+  /**
+   * Schedules the computation of the exact ranges of an array in the
+   * background. Returns false if that is not possible, in which case the
+   * caller must compute them.
+   */
+  bool Refine(vtkDataArray* array, vtkUnsignedCharArray* ghosts, const RangeStamp& stamp)
+  {
+    // shallow copies of arrays with the standard memory layout share their
+    // buffers, which outlive a reallocation of the original arrays.
+    auto pm = vtkProcessModule::GetProcessModule();
+    if (!pm || array->GetArrayType() != vtkAbstractArray::AoSDataArrayTemplate)
+    {
+      return false;
+    }
+
+    // in KiB, as vtkAbstractArray::GetActualMemorySize()
+    const vtkTypeUInt64 size =
+      array->GetActualMemorySize() + (ghosts ? ghosts->GetActualMemorySize() : 0);
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      auto iter = this->PendingRefinements.find(array);
+      if (iter != this->PendingRefinements.end() && iter->second == stamp)
+      {
+        return true;
+      }
+      // an array larger than the budget is refined when nothing else is pending.
+      if (this->PendingRefinementsSize > 0 &&
+        this->PendingRefinementsSize + size > MAX_PENDING_REFINEMENTS_SIZE)
+      {
+        return false;
+      }
+      this->PendingRefinements[array] = stamp;
+      this->PendingRefinementsSize += size;
+    }
+
+    auto arrayCopy = vtk::TakeSmartPointer(array->NewInstance());
+    arrayCopy->ShallowCopy(array);
+    vtkSmartPointer<vtkUnsignedCharArray> ghostsCopy;
+    if (ghosts)
+    {
+      ghostsCopy = vtkSmartPointer<vtkUnsignedCharArray>::New();
+      ghostsCopy->ShallowCopy(ghosts);
+    }
+
+    auto self = RangeCache::GetInstance();
+    const vtkDataArray* key = array;
+    pm->GetCallbackQueue()->Push([self, key, arrayCopy, ghostsCopy, stamp, size]() {
+      auto ranges = ::ComputeRanges(arrayCopy, ghostsCopy, stamp.GhostsToSkip, 1, false);
+      std::lock_guard<std::mutex> lock(self->Mutex);
+      self->PendingRefinementsSize -= size;
+      auto iter = self->PendingRefinements.find(key);
+      if (iter != self->PendingRefinements.end() && iter->second == stamp)
+      {
+        self->PendingRefinements.erase(iter);
+      }
+      self->AddLocked(key, stamp, std::move(ranges));
+    });
+    return true;
+  }
+};
+
 } // end of namespace
 
 vtkStandardNewMacro(vtkPVArrayInformation);
@@ -58,6 +469,7 @@ void vtkPVArrayInformation::Initialize()
   this->DataType = -1;
   this->NumberOfTuples = 0;
   this->IsPartial = false;
+  this->IsRangeApproximate = false;
   this->Components.clear();
   this->StringValues.clear();
   this->InformationKeys.clear();
@@ -74,6 +486,8 @@ void vtkPVArrayInformation::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "NumberOfComponents: " << this->Components.size() << endl;
   os << indent << "NumberOfTuples: " << this->NumberOfTuples << endl;
   os << indent << "IsPartial: " << this->IsPartial << endl;
+  os << indent << "IsRangeApproximate: " << this->IsRangeApproximate << endl;
+  os << indent << "EstimateRanges: " << this->EstimateRanges << endl;
   os << indent << "InformationKeys (count=" << this->InformationKeys.size() << "):" << endl;
   for (auto& pair : this->InformationKeys)
   {
@@ -245,6 +659,7 @@ void vtkPVArrayInformation::DeepCopy(vtkPVArrayInformation* other)
   this->DataType = other->DataType;
   this->NumberOfTuples = other->NumberOfTuples;
   this->IsPartial = other->IsPartial;
+  this->IsRangeApproximate = other->IsRangeApproximate;
   this->Components = other->Components;
   this->StringValues = other->StringValues;
   this->InformationKeys = other->InformationKeys;
@@ -253,33 +668,59 @@ void vtkPVArrayInformation::DeepCopy(vtkPVArrayInformation* other)
 //----------------------------------------------------------------------------
 struct vtkPVArrayInformation::GetRangeFunctor
 {
-  // Compute ranges using the appropriate method: if the containing field data is available, use its
-  // method which can handle caching ghost values. Fallback to the array's method.
-  void operator()(vtkDataArray* dataArray, int componentIdx, ComponentInfo& compInfo)
+  // Compute the ranges of all components and of the magnitude in a single pass, skipping the
+  // ghosts of the containing field data, if available. Ranges of unmodified arrays are reused.
+  // Returns true if the ranges were estimated from a sample.
+  bool operator()(vtkDataArray* dataArray, std::vector<ComponentInfo>& components)
   {
-    bool rangeFound = false, finiteRangeFound = false;
-    if (this->FieldData != nullptr && this->ArrayIdx >= 0)
+    auto ghosts = this->FieldData ? this->FieldData->GetGhostArray() : nullptr;
+
+    ::RangeStamp stamp;
+    stamp.ArrayMTime = dataArray->GetMTime();
+    stamp.NumberOfTuples = dataArray->GetNumberOfTuples();
+    stamp.NumberOfComponents = dataArray->GetNumberOfComponents();
+    if (ghosts)
     {
-      rangeFound =
-        this->FieldData->GetRange(this->ArrayIdx, compInfo.Range.GetData(), componentIdx);
-      finiteRangeFound = this->FieldData->GetFiniteRange(
-        this->ArrayIdx, compInfo.FiniteRange.GetData(), componentIdx);
+      stamp.GhostsMTime = ghosts->GetMTime();
+      stamp.GhostsToSkip = this->FieldData->GetGhostsToSkip();
     }
 
-    if (!rangeFound)
+    auto& cache = ::RangeCache::GetInstance();
+    ::RangesType ranges;
+    bool approximate = false;
+    if (!cache->Find(dataArray, stamp, ranges))
     {
-      dataArray->GetRange(compInfo.Range.GetData(), componentIdx);
+      if (this->Estimate && stamp.NumberOfTuples > 2 * ::RANGE_SAMPLE_SIZE &&
+        cache->Refine(dataArray, ghosts, stamp))
+      {
+        const vtkIdType stride = stamp.NumberOfTuples / ::RANGE_SAMPLE_SIZE;
+        ranges = ::ComputeRanges(dataArray, ghosts, stamp.GhostsToSkip, stride, true);
+        approximate = true;
+      }
+      else
+      {
+        ranges = ::ComputeRanges(dataArray, ghosts, stamp.GhostsToSkip, 1, true);
+        cache->Add(dataArray, stamp, ranges);
+      }
+    }
+    if (!approximate && stamp.GhostsToSkip == 0)
+    {
+      ::StoreInRangeKeys(dataArray, ranges);
     }
 
-    if (!finiteRangeFound)
+    assert(ranges.size() == 4 * components.size());
+    for (size_t cc = 0; cc < components.size(); ++cc)
     {
-      dataArray->GetFiniteRange(compInfo.FiniteRange.GetData(), componentIdx);
+      components[cc].Range = vtkTuple<double, 2>(&ranges[4 * cc]);
+      components[cc].FiniteRange = vtkTuple<double, 2>(&ranges[4 * cc + 2]);
     }
+    return approximate;
   };
 
   vtkAbstractArray* Array = nullptr;
   vtkFieldData* FieldData = nullptr;
   int ArrayIdx = -1;
+  bool Estimate = false;
 };
 
 //----------------------------------------------------------------------------
@@ -317,11 +758,8 @@ void vtkPVArrayInformation::CopyFromArrayInternal(
   auto dataArray = vtkDataArray::SafeDownCast(array);
   if (dataArray && dataArray->IsNumeric())
   {
-    for (int comp = -1; comp < numComponents; ++comp)
-    {
-      auto& compInfo = this->Components.at(comp + 1);
-      getRangeFn(dataArray, comp, compInfo);
-    }
+    getRangeFn.Estimate = this->EstimateRanges;
+    this->IsRangeApproximate = getRangeFn(dataArray, this->Components);
   }
   else if (auto sarray = vtkStringArray::SafeDownCast(array))
   {
@@ -449,6 +887,7 @@ void vtkPVArrayInformation::CopyToStream(vtkClientServerStream* css) const
   *css << this->DataType;
   *css << this->NumberOfTuples;
   *css << this->IsPartial;
+  *css << this->IsRangeApproximate;
   *css << static_cast<int>(this->Components.size());
 
   // components
@@ -486,7 +925,8 @@ bool vtkPVArrayInformation::CopyFromStream(const vtkClientServerStream* css)
   if (!css->GetArgument(0, argument++, &this->Name) ||
     !css->GetArgument(0, argument++, &this->DataType) ||
     !css->GetArgument(0, argument++, &this->NumberOfTuples) ||
-    !css->GetArgument(0, argument++, &this->IsPartial))
+    !css->GetArgument(0, argument++, &this->IsPartial) ||
+    !css->GetArgument(0, argument++, &this->IsRangeApproximate))
   {
     vtkErrorMacro("Error parsing message.");
     return false;
@@ -587,6 +1027,7 @@ void vtkPVArrayInformation::AddInformation(vtkPVArrayInformation* other, int fie
   {
     this->NumberOfTuples += other->NumberOfTuples;
   }
+  this->IsRangeApproximate = this->IsRangeApproximate || other->IsRangeApproximate;
 
   this->Components.resize(std::max(this->Components.size(), other->Components.size()));
   for (size_t cc = 0; cc < other->Components.size(); ++cc)
@@ -117,6 +117,14 @@ public:
   vtkGetMacro(IsPartial, bool);
   ///@}
 
+  /**
+   * Returns true if the ranges were estimated from a sample of the tuples
+   * rather than computed from all of them. This is only the case when the
+   * information was gathered with vtkPVDataInformation::EstimateRanges set
+   * and the exact ranges were still being computed in the background.
+   */
+  vtkGetMacro(IsRangeApproximate, bool);
+
   ///@{
   /**
    * Get information on the InformationKeys of this array
@@ -166,6 +174,7 @@ protected:
   void DeepCopy(vtkPVArrayInformation* info);
   void AddInformation(vtkPVArrayInformation*, int fieldAssociation);
   vtkSetMacro(IsPartial, bool);
+  vtkSetMacro(EstimateRanges, bool);
   ///@}
 
   vtkSetMacro(Name, std::string);
@@ -175,6 +184,8 @@ private:
   int DataType = -1;
   vtkTypeInt64 NumberOfTuples = 0;
   bool IsPartial = false;
+  bool IsRangeApproximate = false;
+  bool EstimateRanges = false;
 
   struct ComponentInfo
   {
@@ -59,6 +59,7 @@ public:
     assert(vtkCompositeDataSet::SafeDownCast(dobj) == nullptr);
 
     this->Current->Initialize();
+    this->Current->EstimateRanges = info->EstimateRanges;
     this->Current->CopyFromDataObject(dobj);
     if (this->Current->GetDataSetType() != -1)
     {
@@ -73,6 +74,7 @@ public:
   {
     this->Current->Initialize();
     auto fdi = this->Current->GetFieldDataInformation();
+    fdi->SetEstimateRanges(info->EstimateRanges);
     fdi->CopyFromDataObject(dobj);
     if (fdi->GetNumberOfArrays() > 0)
     {
@@ -145,25 +147,48 @@ vtkPVDataInformation::~vtkPVDataInformation()
   this->SetSubsetSelector(nullptr);
 }
 
+//----------------------------------------------------------------------------
+bool vtkPVDataInformation::HasApproximateRanges() const
+{
+  if (this->PointArrayInformation->GetIsRangeApproximate())
+  {
+    return true;
+  }
+  for (int cc = 0; cc < vtkDataObject::NUMBER_OF_ATTRIBUTE_TYPES; ++cc)
+  {
+    const auto& attributeInfo = this->AttributeInformations[cc];
+    for (int idx = 0, max = attributeInfo->GetNumberOfArrays(); idx < max; ++idx)
+    {
+      if (attributeInfo->GetArrayInformation(idx)->GetIsRangeApproximate())
+      {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
 //----------------------------------------------------------------------------
 void vtkPVDataInformation::CopyParametersToStream(vtkMultiProcessStream& str)
 {
   str << 828792 << this->PortNumber << std::string(this->SubsetSelector ? SubsetSelector : "")
-      << std::string(this->SubsetAssemblyName ? this->SubsetAssemblyName : "") << this->Rank;
+      << std::string(this->SubsetAssemblyName ? this->SubsetAssemblyName : "") << this->Rank
+      << (this->EstimateRanges ? 1 : 0);
 }
 
 //----------------------------------------------------------------------------
 void vtkPVDataInformation::CopyParametersFromStream(vtkMultiProcessStream& str)
 {
-  int magic_number;
+  int magic_number, estimateRanges;
   std::string path, name;
-  str >> magic_number >> this->PortNumber >> path >> name >> this->Rank;
+  str >> magic_number >> this->PortNumber >> path >> name >> this->Rank >> estimateRanges;
   if (magic_number != 828792)
   {
     vtkErrorMacro("Magic number mismatch.");
   }
   this->SetSubsetSelector(path.empty() ? nullptr : path.c_str());
   this->SetSubsetAssemblyName(name.empty() ? nullptr : name.c_str());
+  this->EstimateRanges = (estimateRanges != 0);
 }
 
 //----------------------------------------------------------------------------
@@ -179,6 +204,7 @@ void vtkPVDataInformation::PrintSelf(ostream& os, vtkIndent indent)
      << endl;
   os << indent << "SubsetAssemblyName: "
      << (this->SubsetAssemblyName ? this->SubsetAssemblyName : "(nullptr)") << endl;
+  os << indent << "EstimateRanges: " << this->EstimateRanges << endl;
   os << indent << "DataSetType: " << this->DataSetType << endl;
   os << indent << "CompositeDataSetType: " << this->CompositeDataSetType << endl;
   os << indent << "FirstLeafCompositeIndex: " << this->FirstLeafCompositeIndex << endl;
@@ -522,6 +548,7 @@ void vtkPVDataInformation::CopyFromDataObject(vtkDataObject* dobj)
 
   for (int cc = 0; cc < vtkDataObject::NUMBER_OF_ATTRIBUTE_TYPES; ++cc)
   {
+    this->AttributeInformations[cc]->SetEstimateRanges(this->EstimateRanges);
     this->AttributeInformations[cc]->CopyFromDataObject(dobj);
     switch (cc)
     {
@@ -560,6 +587,7 @@ void vtkPVDataInformation::CopyFromDataObject(vtkDataObject* dobj)
     {
       if (ps->GetPoints() && ps->GetPoints()->GetData())
       {
+        this->PointArrayInformation->SetEstimateRanges(this->EstimateRanges);
         this->PointArrayInformation->CopyFromArray(ps->GetPoints()->GetData());
         // irrespective of the name used by the internally vtkDataArray, always
         // rename the points as "Points" so the application always identifies
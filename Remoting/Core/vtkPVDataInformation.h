@@ -87,6 +87,30 @@ public:
   void SetSubsetAssemblyNameToHierarchy();
   ///@}
 
+  ///@{
+  /**
+   * When set, ranges of arrays with many tuples whose exact ranges are not
+   * known yet are estimated from a bounded sample of their tuples, while the
+   * exact ranges are computed in the background. Such ranges are flagged by
+   * vtkPVArrayInformation::GetIsRangeApproximate() and information gathered
+   * once the background computation is done reports the exact ranges.
+   *
+   * Default is false.
+   */
+  vtkSetMacro(EstimateRanges, bool);
+  vtkGetMacro(EstimateRanges, bool);
+  vtkBooleanMacro(EstimateRanges, bool);
+  ///@}
+
+  /**
+   * Returns true if the ranges of any array, points included, were estimated.
+   * Gathering the information again once the exact ranges are computed
+   * reports them instead.
+   *
+   * @sa SetEstimateRanges, vtkPVArrayInformation::GetIsRangeApproximate
+   */
+  bool HasApproximateRanges() const;
+
   /**
    * Populate vtkPVDataInformation using `object`. The object can be a
    * `vtkDataObject`, `vtkAlgorithm` or `vtkAlgorithmOutput`.
@@ -493,6 +517,7 @@ private:
   int Rank = -1;
   char* SubsetSelector = nullptr;
   char* SubsetAssemblyName = nullptr;
+  bool EstimateRanges = false;
 
   int DataSetType = -1;
   int CompositeDataSetType = -1;
@@ -196,6 +196,7 @@ void vtkPVDataSetAttributesInformation::CopyFromDataObject(vtkDataObject* dobj)
       if (array && !vtkSkipArray(array->GetName()))
       {
         vtkPVArrayInformation* ainfo = vtkPVArrayInformation::New();
+        ainfo->SetEstimateRanges(this->EstimateRanges);
         ainfo->CopyFromArray(fd, cc);
         internals.GetOrCreateArrayInformation(array->GetName()).TakeReference(ainfo);
       }
@@ -118,6 +118,12 @@ protected:
    */
   vtkSetMacro(FieldAssociation, int);
 
+  /**
+   * Set whether ranges of large arrays may be estimated, see
+   * vtkPVDataInformation::SetEstimateRanges.
+   */
+  vtkSetMacro(EstimateRanges, bool);
+
   ///@{
   /**
    * Manage a serialized version of the information.
@@ -146,6 +152,7 @@ private:
   void operator=(const vtkPVDataSetAttributesInformation&) = delete;
 
   int FieldAssociation;
+  bool EstimateRanges = false;
 
   class vtkInternals;
   vtkInternals* Internals;
@@ -3,11 +3,24 @@
 #include "vtkPVMemoryUseInformation.h"
 
 #include "vtkClientServerStream.h"
+#include "vtkMultiProcessStream.h"
 #include "vtkObjectFactory.h"
 #include "vtkProcessModule.h"
 
 #include <vtksys/SystemInformation.hxx>
 
+#if defined(_WIN32)
+#include <windows.h>
+// windows.h must come first
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
 //#define vtkPVMemoryUseInformationDEBUG
 
 #define vtkVerifyParseMacro(_call, _field)                                                         \
@@ -17,6 +30,61 @@
     return;                                                                                        \
   }
 
+namespace
+{
+// Peak resident memory of the process, in KiB.
+long long GetPeakMemoryUse()
+{
+#if defined(__linux__)
+  // unlike ru_maxrss, VmHWM follows the resets of ResetPeakMemoryUse().
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line))
+  {
+    if (line.compare(0, 6, "VmHWM:") == 0)
+    {
+      return std::atoll(line.c_str() + 6);
+    }
+  }
+#endif
+#if defined(_WIN32)
+  PROCESS_MEMORY_COUNTERS counters;
+  if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+  {
+    return static_cast<long long>(counters.PeakWorkingSetSize / 1024);
+  }
+  return 0;
+#else
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+  {
+    return 0;
+  }
+#if defined(__APPLE__)
+  // in bytes on macOS.
+  return static_cast<long long>(usage.ru_maxrss / 1024);
+#else
+  return static_cast<long long>(usage.ru_maxrss);
+#endif
+#endif
+}
+
+// Resets the peak resident memory of the process to its current resident
+// memory. Returns false if that is not supported.
+bool ResetPeakMemoryUse()
+{
+#if defined(__linux__)
+  // supported since Linux 4.0.
+  std::ofstream clearRefs("/proc/self/clear_refs");
+  clearRefs << "5";
+  clearRefs.close();
+  return !clearRefs.fail();
+#else
+  return false;
+#endif
+}
+}
+
 //----------------------------------------------------------------------------
 vtkStandardNewMacro(vtkPVMemoryUseInformation);
 
@@ -41,6 +109,8 @@ void vtkPVMemoryUseInformation::CopyFromObject(vtkObject* obj)
   info.Rank = vtkProcessModule::GetProcessModule()->GetPartitionId();
   info.ProcMemUse = sysInfo.GetProcMemoryUsed();
   info.HostMemUse = sysInfo.GetHostMemoryUsed();
+  info.ProcMemPeak = ::GetPeakMemoryUse();
+  info.ProcMemPeakReset = this->ResetPeakMemoryUse && ::ResetPeakMemoryUse();
 
 #ifdef vtkPVMemoryUseInformationDEBUG
   info.Print();
@@ -74,7 +144,8 @@ void vtkPVMemoryUseInformation::CopyToStream(vtkClientServerStream* css)
   for (size_t i = 0; i < count; ++i)
   {
     *css << this->MemInfos[i].ProcessType << this->MemInfos[i].Rank << this->MemInfos[i].ProcMemUse
-         << this->MemInfos[i].HostMemUse;
+         << this->MemInfos[i].HostMemUse << this->MemInfos[i].ProcMemPeak
+         << this->MemInfos[i].ProcMemPeakReset;
   }
 
   *css << vtkClientServerStream::End;
@@ -104,6 +175,30 @@ void vtkPVMemoryUseInformation::CopyFromStream(const vtkClientServerStream* css)
 
     vtkVerifyParseMacro(css->GetArgument(0, offset, &MemInfos[i].HostMemUse), "HostMemUse");
     ++offset;
+
+    vtkVerifyParseMacro(css->GetArgument(0, offset, &MemInfos[i].ProcMemPeak), "ProcMemPeak");
+    ++offset;
+
+    vtkVerifyParseMacro(
+      css->GetArgument(0, offset, &MemInfos[i].ProcMemPeakReset), "ProcMemPeakReset");
+    ++offset;
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVMemoryUseInformation::CopyParametersToStream(vtkMultiProcessStream& str)
+{
+  str << 402217 << this->ResetPeakMemoryUse;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVMemoryUseInformation::CopyParametersFromStream(vtkMultiProcessStream& str)
+{
+  int magic_number;
+  str >> magic_number >> this->ResetPeakMemoryUse;
+  if (magic_number != 402217)
+  {
+    vtkErrorMacro("Magic number mismatch.");
   }
 }
 
@@ -111,6 +206,7 @@ void vtkPVMemoryUseInformation::CopyFromStream(const vtkClientServerStream* css)
 void vtkPVMemoryUseInformation::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "ResetPeakMemoryUse: " << this->ResetPeakMemoryUse << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -119,5 +215,7 @@ void vtkPVMemoryUseInformation::MemInfo::Print()
   cerr << "ProcessType=" << this->ProcessType << endl
        << "Rank=" << this->Rank << endl
        << "ProcMemUse=" << this->ProcMemUse << endl
-       << "HostMemUse=" << this->HostMemUse << endl;
+       << "HostMemUse=" << this->HostMemUse << endl
+       << "ProcMemPeak=" << this->ProcMemPeak << endl
+       << "ProcMemPeakReset=" << this->ProcMemPeakReset << endl;
 }
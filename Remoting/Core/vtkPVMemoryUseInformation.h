@@ -4,7 +4,10 @@
  * @class   vtkPVMemoryUseInformation
  *
  * A vtkClientServerStream serializable container for a single process's
- * instantaneous memory usage.
+ * instantaneous memory usage and its peak memory usage.
+ *
+ * @sa vtkPVProxyMemoryUseInformation which attributes the memory held by data
+ * objects to the proxies holding them.
  */
 
 #ifndef vtkPVMemoryUseInformation_h
@@ -40,6 +43,22 @@ public:
    */
   void CopyToStream(vtkClientServerStream*) override;
   void CopyFromStream(const vtkClientServerStream*) override;
+  void CopyParametersToStream(vtkMultiProcessStream&) override;
+  void CopyParametersFromStream(vtkMultiProcessStream&) override;
+  ///@}
+
+  ///@{
+  /**
+   * When set, each process resets its peak memory usage to its current
+   * memory usage once it has been reported, so that the peak reported by the
+   * next request covers the time between the two requests. Resetting is only
+   * supported on Linux, see GetProcMemoryPeakReset().
+   *
+   * Default is false.
+   */
+  vtkSetMacro(ResetPeakMemoryUse, bool);
+  vtkGetMacro(ResetPeakMemoryUse, bool);
+  vtkBooleanMacro(ResetPeakMemoryUse, bool);
   ///@}
 
   /**
@@ -51,6 +70,18 @@ public:
   long long GetProcMemoryUse(size_t i) { return this->MemInfos[i].ProcMemUse; }
   long long GetHostMemoryUse(size_t i) { return this->MemInfos[i].HostMemUse; }
 
+  /**
+   * Peak resident memory of a process, in KiB. It covers the time since the
+   * peak was last reset, see SetResetPeakMemoryUse(), or the lifetime of the
+   * process if it never was.
+   */
+  long long GetProcMemoryPeak(size_t i) { return this->MemInfos[i].ProcMemPeak; }
+
+  /**
+   * Whether the process reset its peak memory usage after reporting it.
+   */
+  bool GetProcMemoryPeakReset(size_t i) { return this->MemInfos[i].ProcMemPeakReset; }
+
 protected:
   vtkPVMemoryUseInformation();
   ~vtkPVMemoryUseInformation() override;
@@ -64,6 +95,8 @@ private:
       , Rank(0)
       , ProcMemUse(0)
       , HostMemUse(0)
+      , ProcMemPeak(0)
+      , ProcMemPeakReset(false)
     {
     }
     void Print();
@@ -72,8 +105,11 @@ private:
     int Rank;
     long long ProcMemUse;
     long long HostMemUse;
+    long long ProcMemPeak;
+    bool ProcMemPeakReset;
   };
   vector<MemInfo> MemInfos;
+  bool ResetPeakMemoryUse = false;
 
   vtkPVMemoryUseInformation(const vtkPVMemoryUseInformation&) = delete;
   void operator=(const vtkPVMemoryUseInformation&) = delete;
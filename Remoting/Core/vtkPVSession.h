@@ -67,6 +67,12 @@ public:
    */
   virtual vtkMPIMToNSocketConnection* GetMPIMToNSocketConnection() { return nullptr; }
 
+  /**
+   * This is socket connection, if any, between the data-server nodes and the
+   * client used to deliver data to the client over several sockets.
+   */
+  virtual vtkMPIMToNSocketConnection* GetStripedDeliveryConnection() { return nullptr; }
+
   /**
    * vtkPVServerInformation is an information-object that provides information
    * about the server processes. These include server-side capabilities as well
@@ -0,0 +1,98 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkPVTimeStepCacheInformation.h"
+
+#include "vtkClientServerStream.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVCompositeDataPipeline.h"
+
+vtkStandardNewMacro(vtkPVTimeStepCacheInformation);
+//----------------------------------------------------------------------------
+vtkPVTimeStepCacheInformation::vtkPVTimeStepCacheInformation()
+{
+  this->Initialize();
+}
+
+//----------------------------------------------------------------------------
+vtkPVTimeStepCacheInformation::~vtkPVTimeStepCacheInformation() = default;
+
+//----------------------------------------------------------------------------
+void vtkPVTimeStepCacheInformation::CopyFromObject(vtkObject*)
+{
+  this->Hits = vtkPVCompositeDataPipeline::GetTimeStepCacheHits();
+  this->Misses = vtkPVCompositeDataPipeline::GetTimeStepCacheMisses();
+  this->Evictions = vtkPVCompositeDataPipeline::GetTimeStepCacheEvictions();
+  this->Size = vtkPVCompositeDataPipeline::GetTimeStepCacheSize();
+  this->Limit = vtkPVCompositeDataPipeline::GetTimeStepCacheLimit();
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTimeStepCacheInformation::AddInformation(vtkPVInformation* info)
+{
+  vtkPVTimeStepCacheInformation* other = vtkPVTimeStepCacheInformation::SafeDownCast(info);
+  if (!other)
+  {
+    vtkErrorMacro("Could not cast object to time step cache information.");
+    return;
+  }
+  this->Hits += other->Hits;
+  this->Misses += other->Misses;
+  this->Evictions += other->Evictions;
+  this->Size += other->Size;
+  this->Limit += other->Limit;
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTimeStepCacheInformation::CopyToStream(vtkClientServerStream* css)
+{
+  css->Reset();
+  *css << vtkClientServerStream::Reply;
+  *css << this->Hits << this->Misses << this->Evictions << this->Size << this->Limit;
+  *css << vtkClientServerStream::End;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTimeStepCacheInformation::CopyFromStream(const vtkClientServerStream* css)
+{
+  if (!css->GetArgument(0, 0, &this->Hits) || !css->GetArgument(0, 1, &this->Misses) ||
+    !css->GetArgument(0, 2, &this->Evictions) || !css->GetArgument(0, 3, &this->Size) ||
+    !css->GetArgument(0, 4, &this->Limit))
+  {
+    vtkErrorMacro("Error parsing time step cache statistics.");
+    this->Initialize();
+  }
+  else
+  {
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTimeStepCacheInformation::Initialize()
+{
+  this->Hits = 0;
+  this->Misses = 0;
+  this->Evictions = 0;
+  this->Size = 0;
+  this->Limit = 0;
+}
+
+//----------------------------------------------------------------------------
+double vtkPVTimeStepCacheInformation::GetHitRate() const
+{
+  const vtkTypeInt64 requests = this->Hits + this->Misses;
+  return requests > 0 ? static_cast<double>(this->Hits) / requests : 0.0;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTimeStepCacheInformation::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Hits: " << this->Hits << endl;
+  os << indent << "Misses: " << this->Misses << endl;
+  os << indent << "Evictions: " << this->Evictions << endl;
+  os << indent << "Size: " << this->Size << endl;
+  os << indent << "Limit: " << this->Limit << endl;
+}
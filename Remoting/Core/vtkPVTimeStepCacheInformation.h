@@ -0,0 +1,91 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkPVTimeStepCacheInformation
+ * @brief   statistics of the time step caches of the pipelines.
+ *
+ * vtkPVTimeStepCacheInformation gathers the statistics of the outputs cached
+ * for each time step by vtkPVCompositeDataPipeline executives, on each
+ * process. The values of all processes are summed. The object the
+ * information is gathered from is ignored.
+ *
+ * @sa vtkPVCompositeDataPipeline::SetCacheTimeSteps
+ */
+
+#ifndef vtkPVTimeStepCacheInformation_h
+#define vtkPVTimeStepCacheInformation_h
+
+#include "vtkPVInformation.h"
+#include "vtkRemotingCoreModule.h" //needed for exports
+
+class VTKREMOTINGCORE_EXPORT vtkPVTimeStepCacheInformation : public vtkPVInformation
+{
+public:
+  static vtkPVTimeStepCacheInformation* New();
+  vtkTypeMacro(vtkPVTimeStepCacheInformation, vtkPVInformation);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Transfer the statistics of this process into this object.
+   */
+  void CopyFromObject(vtkObject*) override;
+
+  /**
+   * Merge another information object.
+   */
+  void AddInformation(vtkPVInformation* info) override;
+
+  ///@{
+  /**
+   * Manage a serialized version of the information.
+   */
+  void CopyToStream(vtkClientServerStream*) override;
+  void CopyFromStream(const vtkClientServerStream*) override;
+  ///@}
+
+  /**
+   * Remove all information. The next add will be like a copy.
+   */
+  void Initialize();
+
+  ///@{
+  /**
+   * The number of requests served from the caches (hits), the number of
+   * executions for time steps that were not cached (misses) and the number of
+   * evicted outputs.
+   */
+  vtkGetMacro(Hits, vtkTypeInt64);
+  vtkGetMacro(Misses, vtkTypeInt64);
+  vtkGetMacro(Evictions, vtkTypeInt64);
+  ///@}
+
+  /**
+   * Returns the fraction of the requests served from the caches, or 0 if there
+   * were none.
+   */
+  double GetHitRate() const;
+
+  ///@{
+  /**
+   * Memory used by the caches and their memory budget, in KiB.
+   */
+  vtkGetMacro(Size, vtkTypeInt64);
+  vtkGetMacro(Limit, vtkTypeInt64);
+  ///@}
+
+protected:
+  vtkPVTimeStepCacheInformation();
+  ~vtkPVTimeStepCacheInformation() override;
+
+  vtkTypeInt64 Hits;
+  vtkTypeInt64 Misses;
+  vtkTypeInt64 Evictions;
+  vtkTypeInt64 Size;
+  vtkTypeInt64 Limit;
+
+private:
+  vtkPVTimeStepCacheInformation(const vtkPVTimeStepCacheInformation&) = delete;
+  void operator=(const vtkPVTimeStepCacheInformation&) = delete;
+};
+
+#endif
@@ -0,0 +1,337 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkPVTraceInformation.h"
+
+#include "vtkClientServerStream.h"
+#include "vtkMultiProcessStream.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVTraceRecorder.h"
+#include "vtkProcessModule.h"
+
+#include <vtksys/FStream.hxx>
+
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+#include <sstream>
+#include <utility>
+
+#define vtkVerifyParseMacro(_call, _field)                                                         \
+  if (!(_call))                                                                                    \
+  {                                                                                                \
+    vtkErrorMacro("Error parsing " _field ".");                                                    \
+    return;                                                                                        \
+  }
+
+namespace
+{
+const char* GetProcessTypeName(int type)
+{
+  switch (type)
+  {
+    case vtkProcessModule::PROCESS_CLIENT:
+      return "client";
+    case vtkProcessModule::PROCESS_SERVER:
+      return "server";
+    case vtkProcessModule::PROCESS_DATA_SERVER:
+      return "data server";
+    case vtkProcessModule::PROCESS_RENDER_SERVER:
+      return "render server";
+    case vtkProcessModule::PROCESS_BATCH:
+      return "batch";
+    default:
+      return "process";
+  }
+}
+
+void WriteJSONString(std::ostream& os, const std::string& value)
+{
+  os << '"';
+  for (const char c : value)
+  {
+    switch (c)
+    {
+      case '"':
+        os << "\\\"";
+        break;
+      case '\\':
+        os << "\\\\";
+        break;
+      case '\n':
+        os << "\\n";
+        break;
+      case '\t':
+        os << "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20)
+        {
+          char buffer[8];
+          std::snprintf(buffer, sizeof(buffer), "\\u%04x", static_cast<unsigned int>(c));
+          os << buffer;
+        }
+        else
+        {
+          os << c;
+        }
+    }
+  }
+  os << '"';
+}
+
+// Chrome traces use microseconds.
+void WriteMicroseconds(std::ostream& os, vtkTypeInt64 nanoseconds)
+{
+  os << nanoseconds / 1000 << '.';
+  char buffer[4];
+  std::snprintf(buffer, sizeof(buffer), "%03d", static_cast<int>(nanoseconds % 1000));
+  os << buffer;
+}
+}
+
+vtkStandardNewMacro(vtkPVTraceInformation);
+//----------------------------------------------------------------------------
+vtkPVTraceInformation::vtkPVTraceInformation() = default;
+
+//----------------------------------------------------------------------------
+vtkPVTraceInformation::~vtkPVTraceInformation() = default;
+
+//----------------------------------------------------------------------------
+void vtkPVTraceInformation::CopyFromObject(vtkObject*)
+{
+  if (this->EnableTracing != -1)
+  {
+    vtkPVTraceRecorder::SetEnabled(this->EnableTracing == 1);
+  }
+  if (this->SyncTime < 0)
+  {
+    this->SyncTime = vtkPVTraceRecorder::Now();
+  }
+
+  auto pm = vtkProcessModule::GetProcessModule();
+  std::ostringstream name;
+  name << ::GetProcessTypeName(vtkProcessModule::GetProcessType()) << " "
+       << (pm ? pm->GetPartitionId() : 0);
+  this->Tracks.clear();
+  this->AddLocalTrack(name.str().c_str());
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTraceInformation::AddLocalTrack(const char* name)
+{
+  Track track;
+  track.Name = name ? name : "";
+  track.SyncTime = this->SyncTime >= 0 ? this->SyncTime : vtkPVTraceRecorder::Now();
+  for (const auto& event : vtkPVTraceRecorder::GetEvents())
+  {
+    track.Events.push_back(TrackEvent{ event.Begin, event.Duration, event.Thread,
+      event.Category ? event.Category : "", event.Name });
+  }
+  if (this->ClearEvents)
+  {
+    vtkPVTraceRecorder::Clear();
+  }
+  this->Tracks.push_back(std::move(track));
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTraceInformation::AddInformation(vtkPVInformation* pvinfo)
+{
+  auto other = vtkPVTraceInformation::SafeDownCast(pvinfo);
+  if (!other)
+  {
+    return;
+  }
+
+  other->AlignTracks(this->RequestTime);
+
+  for (auto& track : other->Tracks)
+  {
+    if (other->SenderRank > 0 && this->SyncTime >= 0)
+    {
+      // from a satellite: all ranks received the request at about the same
+      // time, so align the clocks at that time.
+      vtkPVTraceInformation::ShiftTrack(track, this->SyncTime - track.SyncTime);
+      track.SyncTime = this->SyncTime;
+    }
+    this->Tracks.push_back(std::move(track));
+  }
+  other->Tracks.clear();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTraceInformation::AlignTracks(vtkTypeInt64 requestTime)
+{
+  if (this->SenderRank != 0 || requestTime < 0 || this->ReplyTime < 0)
+  {
+    return;
+  }
+
+  // from the server root: estimate the clock offset using the round trip,
+  // assuming the request and the reply took the same time.
+  const vtkTypeInt64 offset =
+    ((this->SyncTime - requestTime) + (this->ReplyTime - this->ResponseTime)) / 2;
+  for (auto& track : this->Tracks)
+  {
+    vtkPVTraceInformation::ShiftTrack(track, -offset);
+    track.SyncTime -= offset;
+  }
+  this->ReplyTime = -1;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTraceInformation::ShiftTrack(Track& track, vtkTypeInt64 shift)
+{
+  for (auto& event : track.Events)
+  {
+    event.Begin += shift;
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTraceInformation::CopyToStream(vtkClientServerStream* css)
+{
+  auto pm = vtkProcessModule::GetProcessModule();
+  this->ReplyTime = vtkPVTraceRecorder::Now();
+
+  css->Reset();
+  *css << vtkClientServerStream::Reply << (pm ? pm->GetPartitionId() : 0) << this->SyncTime
+       << this->ReplyTime << static_cast<vtkTypeUInt32>(this->Tracks.size());
+  for (const auto& track : this->Tracks)
+  {
+    *css << track.Name << track.SyncTime << static_cast<vtkTypeUInt32>(track.Events.size());
+    for (const auto& event : track.Events)
+    {
+      *css << event.Begin << event.Duration << event.Thread << event.Category << event.Name;
+    }
+  }
+  *css << vtkClientServerStream::End;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTraceInformation::CopyFromStream(const vtkClientServerStream* css)
+{
+  this->ResponseTime = vtkPVTraceRecorder::Now();
+  this->Tracks.clear();
+
+  int offset = 0;
+  vtkTypeUInt32 count = 0;
+  vtkVerifyParseMacro(css->GetArgument(0, offset++, &this->SenderRank), "rank");
+  vtkVerifyParseMacro(css->GetArgument(0, offset++, &this->SyncTime), "sync time");
+  vtkVerifyParseMacro(css->GetArgument(0, offset++, &this->ReplyTime), "reply time");
+  vtkVerifyParseMacro(css->GetArgument(0, offset++, &count), "number of tracks");
+  this->Tracks.resize(count);
+  for (auto& track : this->Tracks)
+  {
+    vtkTypeUInt32 numberOfEvents = 0;
+    vtkVerifyParseMacro(css->GetArgument(0, offset++, &track.Name), "track name");
+    vtkVerifyParseMacro(css->GetArgument(0, offset++, &track.SyncTime), "track sync time");
+    vtkVerifyParseMacro(css->GetArgument(0, offset++, &numberOfEvents), "number of events");
+    track.Events.resize(numberOfEvents);
+    for (auto& event : track.Events)
+    {
+      vtkVerifyParseMacro(css->GetArgument(0, offset++, &event.Begin), "event begin");
+      vtkVerifyParseMacro(css->GetArgument(0, offset++, &event.Duration), "event duration");
+      vtkVerifyParseMacro(css->GetArgument(0, offset++, &event.Thread), "event thread");
+      vtkVerifyParseMacro(css->GetArgument(0, offset++, &event.Category), "event category");
+      vtkVerifyParseMacro(css->GetArgument(0, offset++, &event.Name), "event name");
+    }
+  }
+  this->AlignTracks(this->RequestTime);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTraceInformation::CopyParametersToStream(vtkMultiProcessStream& str)
+{
+  this->RequestTime = this->SyncTime = vtkPVTraceRecorder::Now();
+  str << 829231 << this->EnableTracing << (this->ClearEvents ? 1 : 0);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTraceInformation::CopyParametersFromStream(vtkMultiProcessStream& str)
+{
+  this->SyncTime = vtkPVTraceRecorder::Now();
+  int magic_number, clear;
+  str >> magic_number >> this->EnableTracing >> clear;
+  if (magic_number != 829231)
+  {
+    vtkErrorMacro("Magic number mismatch.");
+  }
+  this->ClearEvents = (clear != 0);
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkPVTraceInformation::GetNumberOfEvents() const
+{
+  vtkIdType count = 0;
+  for (const auto& track : this->Tracks)
+  {
+    count += static_cast<vtkIdType>(track.Events.size());
+  }
+  return count;
+}
+
+//----------------------------------------------------------------------------
+std::string vtkPVTraceInformation::GetChromeTrace() const
+{
+  vtkTypeInt64 origin = std::numeric_limits<vtkTypeInt64>::max();
+  for (const auto& track : this->Tracks)
+  {
+    for (const auto& event : track.Events)
+    {
+      origin = std::min(origin, event.Begin);
+    }
+  }
+
+  std::ostringstream os;
+  os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  const char* separator = "\n";
+  for (size_t pid = 0; pid < this->Tracks.size(); ++pid)
+  {
+    const auto& track = this->Tracks[pid];
+    os << separator << "{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":" << pid
+       << ",\"args\":{\"name\":";
+    ::WriteJSONString(os, track.Name);
+    os << "}}";
+    separator = ",\n";
+    os << separator << "{\"ph\":\"M\",\"name\":\"process_sort_index\",\"pid\":" << pid
+       << ",\"args\":{\"sort_index\":" << pid << "}}";
+    for (const auto& event : track.Events)
+    {
+      os << separator << "{\"ph\":\"X\",\"name\":";
+      ::WriteJSONString(os, event.Name);
+      os << ",\"cat\":";
+      ::WriteJSONString(os, event.Category);
+      os << ",\"pid\":" << pid << ",\"tid\":" << event.Thread << ",\"ts\":";
+      ::WriteMicroseconds(os, event.Begin - origin);
+      os << ",\"dur\":";
+      ::WriteMicroseconds(os, event.Duration);
+      os << "}";
+    }
+  }
+  os << "\n]}\n";
+  return os.str();
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVTraceInformation::WriteChromeTrace(const char* filename) const
+{
+  vtksys::ofstream file(filename ? filename : "", std::ios::out | std::ios::binary);
+  if (!file)
+  {
+    vtkErrorMacro("Failed to open '" << (filename ? filename : "(null)") << "' for writing.");
+    return false;
+  }
+  file << this->GetChromeTrace();
+  return static_cast<bool>(file);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTraceInformation::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "EnableTracing: " << this->EnableTracing << endl;
+  os << indent << "ClearEvents: " << this->ClearEvents << endl;
+  os << indent << "NumberOfTracks: " << this->GetNumberOfTracks() << endl;
+  os << indent << "NumberOfEvents: " << this->GetNumberOfEvents() << endl;
+}
@@ -0,0 +1,161 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class vtkPVTraceInformation
+ * @brief gathers the events recorded by vtkPVTraceRecorder on all processes
+ *
+ * vtkPVTraceInformation collects the events recorded by vtkPVTraceRecorder on
+ * every process it is gathered from, with one track per process, and exports
+ * them as a Chrome trace that can be loaded in `chrome://tracing` or Perfetto.
+ * It is gathered with a global id of 0.
+ *
+ * Processes do not share a clock. Tracks from satellites are aligned on the
+ * root using the time at which each process received the request, and tracks
+ * from a remote server are aligned on the client using the round trip of the
+ * request to estimate the offset between both clocks.
+ *
+ * The parameters can also be used to enable, disable or clear the recording
+ * on all processes the information is gathered from.
+ */
+
+#ifndef vtkPVTraceInformation_h
+#define vtkPVTraceInformation_h
+
+#include "vtkPVInformation.h"
+#include "vtkRemotingCoreModule.h" // needed for exports
+
+#include <string> // for std::string
+#include <vector> // for std::vector
+
+class VTKREMOTINGCORE_EXPORT vtkPVTraceInformation : public vtkPVInformation
+{
+public:
+  static vtkPVTraceInformation* New();
+  vtkTypeMacro(vtkPVTraceInformation, vtkPVInformation);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Transfer information about a single object into this object.
+   */
+  void CopyFromObject(vtkObject*) override;
+
+  /**
+   * Merge another information object.
+   */
+  void AddInformation(vtkPVInformation*) override;
+
+  ///@{
+  /**
+   * Manage a serialized version of the information.
+   */
+  void CopyToStream(vtkClientServerStream*) override;
+  void CopyFromStream(const vtkClientServerStream*) override;
+  ///@}
+
+  ///@{
+  /**
+   * Serialize/Deserialize the parameters that control how/what information is
+   * gathered.
+   */
+  void CopyParametersToStream(vtkMultiProcessStream&) override;
+  void CopyParametersFromStream(vtkMultiProcessStream&) override;
+  ///@}
+
+  ///@{
+  /**
+   * When set to 0 or 1, recording is disabled or enabled on every process the
+   * information is gathered from, before collecting events. Default is -1 i.e.
+   * leave recording unchanged.
+   */
+  vtkSetClampMacro(EnableTracing, int, -1, 1);
+  vtkGetMacro(EnableTracing, int);
+  ///@}
+
+  ///@{
+  /**
+   * When set, the recorded events are discarded on every process after they
+   * have been collected. Default is false.
+   */
+  vtkSetMacro(ClearEvents, bool);
+  vtkGetMacro(ClearEvents, bool);
+  vtkBooleanMacro(ClearEvents, bool);
+  ///@}
+
+  /**
+   * Adds a track with the events recorded by this process, e.g. to add the
+   * client events after gathering the information from the servers only.
+   */
+  void AddLocalTrack(const char* name);
+
+  /**
+   * Returns the number of tracks i.e. processes events were collected from.
+   */
+  int GetNumberOfTracks() const { return static_cast<int>(this->Tracks.size()); }
+
+  /**
+   * Returns the total number of collected events.
+   */
+  vtkIdType GetNumberOfEvents() const;
+
+  /**
+   * Returns the collected events as a Chrome trace (JSON object format) with
+   * one process per track. Times are in microseconds from the first event.
+   */
+  std::string GetChromeTrace() const;
+
+  /**
+   * Writes the Chrome trace to a file. Returns false on failure.
+   */
+  bool WriteChromeTrace(const char* filename) const;
+
+protected:
+  vtkPVTraceInformation();
+  ~vtkPVTraceInformation() override;
+
+  struct TrackEvent
+  {
+    vtkTypeInt64 Begin;
+    vtkTypeInt64 Duration;
+    vtkTypeUInt32 Thread;
+    std::string Category;
+    std::string Name;
+  };
+
+  struct Track
+  {
+    std::string Name;
+    // time when the process received the request, on its own clock.
+    vtkTypeInt64 SyncTime;
+    std::vector<TrackEvent> Events;
+  };
+
+  /**
+   * Shifts the times of all events in a track.
+   */
+  static void ShiftTrack(Track& track, vtkTypeInt64 shift);
+
+  /**
+   * Moves the tracks received from the server root to the clock of this
+   * process, given the time the request was sent.
+   */
+  void AlignTracks(vtkTypeInt64 requestTime);
+
+  int EnableTracing = -1;
+  bool ClearEvents = false;
+
+  // times on this process clock, -1 if unset.
+  vtkTypeInt64 RequestTime = -1;
+  vtkTypeInt64 SyncTime = -1;
+  vtkTypeInt64 ReplyTime = -1;
+  vtkTypeInt64 ResponseTime = -1;
+
+  // rank of the process that serialized this information, -1 if local.
+  int SenderRank = -1;
+  std::vector<Track> Tracks;
+
+private:
+  vtkPVTraceInformation(const vtkPVTraceInformation&) = delete;
+  void operator=(const vtkPVTraceInformation&) = delete;
+};
+
+#endif
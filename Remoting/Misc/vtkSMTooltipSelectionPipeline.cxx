@@ -3,7 +3,6 @@
 
 #include "vtkSMTooltipSelectionPipeline.h"
 
-#include "vtkCell.h"
 #include "vtkCellData.h"
 #include "vtkCompositeDataSet.h"
 #include "vtkCoordinate.h"
@@ -16,8 +15,10 @@
 #include "vtkPVDataMover.h"
 #include "vtkPVDataUtilities.h"
 #include "vtkPVExtractSelection.h"
+#include "vtkPVHoverInformation.h"
 #include "vtkPVRenderView.h"
 #include "vtkPVSelectionSource.h"
+#include "vtkPVSession.h"
 #include "vtkPointData.h"
 #include "vtkPointSet.h"
 #include "vtkProcessModule.h"
@@ -33,10 +34,82 @@
 #include "vtkSMSessionProxyManager.h"
 #include "vtkSMSourceProxy.h"
 #include "vtkSelectionNode.h"
-#include "vtkStringArray.h"
 
 #include <sstream>
 
+namespace
+{
+//----------------------------------------------------------------------------
+// Formats the values of the element (point or cell) described by `info`. `id`
+// is the id shown, if not negative.
+std::string FormatTooltipText(int association, vtkPVHoverInformation* info, vtkIdType id)
+{
+  std::ostringstream tooltipTextStream;
+  if (info->GetComposite())
+  {
+    tooltipTextStream << "\n<b>  Block: " << info->GetBlockName() << "</b>";
+  }
+
+  if (id >= 0)
+  {
+    tooltipTextStream << "\n  Id: " << id;
+  }
+  if (association == vtkDataObject::FIELD_ASSOCIATION_POINTS)
+  {
+    const double* point = info->GetCoordinates();
+    tooltipTextStream << "\n  Coords: (" << point[0] << ", " << point[1] << ", " << point[2] << ")";
+  }
+  else
+  {
+    tooltipTextStream << "\n  Type: "
+                      << vtkSMCoreUtilities::GetStringForCellType(info->GetCellType());
+  }
+
+  // point or cell attributes, then field data arrays with one tuple. Only the
+  // first components of field data arrays are available.
+  const auto& fieldDataValues = info->GetFieldDataValues();
+  for (const auto* values : { &info->GetAttributeValues(), &fieldDataValues })
+  {
+    if (values == &fieldDataValues && !fieldDataValues.empty())
+    {
+      tooltipTextStream << "<hr>";
+    }
+    for (const auto& value : *values)
+    {
+      tooltipTextStream << "\n  " << value.Name << ": ";
+      if (value.IsString)
+      {
+        tooltipTextStream << value.StringValue;
+        continue;
+      }
+
+      const int nbComps = value.NumberOfComponents;
+      if (nbComps > 1)
+      {
+        tooltipTextStream << "(";
+      }
+      for (size_t i_comp = 0; i_comp < value.Values.size(); i_comp++)
+      {
+        tooltipTextStream << value.Values[i_comp];
+        if (static_cast<int>(i_comp) + 1 < nbComps)
+        {
+          tooltipTextStream << ", ";
+        }
+      }
+      if (nbComps > 1)
+      {
+        if (nbComps > static_cast<int>(value.Values.size()))
+        {
+          tooltipTextStream << "...";
+        }
+        tooltipTextStream << ")";
+      }
+    }
+  }
+  return tooltipTextStream.str();
+}
+}
+
 vtkStandardNewMacro(vtkSMTooltipSelectionPipeline);
 
 //----------------------------------------------------------------------------
@@ -160,15 +233,9 @@ bool vtkSMTooltipSelectionPipeline::GetTooltipInfo(int association, std::string&
 bool vtkSMTooltipSelectionPipeline::GetTooltipInfo(
   int association, std::string& formatedTooltipText, std::string& plainTooltipText)
 {
-  vtkSMSourceProxy* extractSource = this->ExtractInteractiveSelection;
-  unsigned int extractOutputPort = extractSource->GetOutputPort((unsigned int)0)->GetPortIndex();
-  vtkDataObject* dataObject =
-    this->ConnectPVMoveSelectionToClient(extractSource, extractOutputPort);
-
-  bool compositeFound;
-  std::string compositeName;
-  vtkDataSet* ds = this->FindDataSet(dataObject, compositeFound, compositeName);
-  if (!ds)
+  std::string tooltipText;
+  if (!this->GetTooltipTextFromRepresentation(association, tooltipText) &&
+    !this->GetTooltipTextFromExtract(association, tooltipText))
   {
     return false;
   }
@@ -187,150 +254,95 @@ bool vtkSMTooltipSelectionPipeline::GetTooltipInfo(
     }
   }
 
-  std::ostringstream tooltipTextStream;
+  formatedTooltipText =
+    "<p style='white-space:pre'><b>" + proxyName + "</b>" + tooltipText + "</p>";
+  plainTooltipText = proxyName + tooltipText;
 
-  // Composite dataset name
-  if (compositeFound)
+  this->TooltipEnabled = false;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkSMTooltipSelectionPipeline::GetTooltipTextFromRepresentation(
+  int association, std::string& tooltipText)
+{
+  if (!this->PreviousRepresentation || !this->PreviousView)
   {
-    tooltipTextStream << "\n<b>  Block: " << compositeName << "</b>";
+    return false;
   }
 
-  vtkFieldData* fieldData = nullptr;
-  vtkDataArray* originalIds = nullptr;
-  double point[3];
-  if (association == vtkDataObject::FIELD_ASSOCIATION_POINTS)
+  vtkPVRenderView* rv = vtkPVRenderView::SafeDownCast(this->PreviousView->GetClientSideObject());
+  vtkSelection* selection = rv ? rv->GetLastSelection() : nullptr;
+  if (!selection || selection->GetNumberOfNodes() != 1)
   {
-    // point index
-    vtkPointData* pointData = ds->GetPointData();
-    fieldData = pointData;
-    originalIds = pointData->GetArray("vtkOriginalPointIds");
-    if (originalIds)
-    {
-      tooltipTextStream << "\n  Id: " << originalIds->GetTuple1(0);
-    }
-
-    // point coords
-    ds->GetPoint(0, point);
-    tooltipTextStream << "\n  Coords: (" << point[0] << ", " << point[1] << ", " << point[2] << ")";
+    return false;
   }
-  else if (association == vtkDataObject::FIELD_ASSOCIATION_CELLS)
+
+  vtkSelectionNode* selectionNode = selection->GetNode(0);
+  vtkIdTypeArray* selectionArray =
+    vtkIdTypeArray::SafeDownCast(selectionNode ? selectionNode->GetSelectionList() : nullptr);
+  if (!selectionArray || selectionArray->GetNumberOfTuples() != 1 ||
+    selectionNode->GetContentType() != vtkSelectionNode::INDICES)
   {
-    // cell index
-    vtkCellData* cellData = ds->GetCellData();
-    fieldData = cellData;
-    originalIds = cellData->GetArray("vtkOriginalCellIds");
-    if (originalIds)
-    {
-      tooltipTextStream << "\n  Id: " << originalIds->GetTuple1(0);
-    }
-    // cell type? cell points?
-    if (ds->GetNumberOfCells() > 0)
-    {
-      vtkCell* cell = ds->GetCell(0);
-      tooltipTextStream << "\n  Type: "
-                        << vtkSMCoreUtilities::GetStringForCellType(cell->GetCellType());
-    }
+    return false;
   }
 
-  if (fieldData)
+  // query the element directly from the representation on the data server. This
+  // only transfers the values shown in the tooltip back to the client.
+  vtkNew<vtkPVHoverInformation> hoverInfo;
+  hoverInfo->SetFieldAssociation(association);
+  hoverInfo->SetElementId(selectionArray->GetValue(0));
+  vtkInformation* properties = selectionNode->GetProperties();
+  if (properties->Has(vtkSelectionNode::COMPOSITE_INDEX()))
   {
-    // point or cell attributes
-    vtkIdType nbArrays = fieldData->GetNumberOfArrays();
-    for (vtkIdType i_arr = 0; i_arr < nbArrays; i_arr++)
-    {
-      vtkDataArray* array = fieldData->GetArray(i_arr);
-      if (!array || originalIds == array)
-      {
-        continue;
-      }
-      tooltipTextStream << "\n  " << array->GetName() << ": ";
-      vtkIdType nbComps = array->GetNumberOfComponents();
-
-      if (nbComps > 1)
-      {
-        tooltipTextStream << "(";
-      }
-      for (vtkIdType i_comp = 0; i_comp < nbComps; i_comp++)
-      {
-        tooltipTextStream << array->GetTuple(0)[i_comp];
-        if (i_comp + 1 < nbComps)
-        {
-          tooltipTextStream << ", ";
-        }
-      }
-      if (nbComps > 1)
-      {
-        tooltipTextStream << ")";
-      }
-    }
+    hoverInfo->SetCompositeIndex(
+      static_cast<unsigned int>(properties->Get(vtkSelectionNode::COMPOSITE_INDEX())));
   }
-
-  // Add field data arrays with one tuple
-  fieldData = ds->GetFieldData();
-
-  if (fieldData)
+  if (properties->Has(vtkSelectionNode::PROCESS_ID()))
   {
-    // Add separation line if needed
-    if (fieldData->GetNumberOfArrays() > 0)
-    {
-      tooltipTextStream << "<hr>";
-    }
-
-    for (vtkIdType i_arr = 0; i_arr < fieldData->GetNumberOfArrays(); i_arr++)
-    {
-      vtkAbstractArray* array = fieldData->GetAbstractArray(i_arr);
-      if (!array || array->GetNumberOfTuples() != 1)
-      {
-        continue;
-      }
-
-      tooltipTextStream << "\n  " << array->GetName() << ": ";
-
-      // String arrays are not data arrays
-      vtkStringArray* strArray = vtkStringArray::SafeDownCast(array);
-      vtkDataArray* dataArray = vtkDataArray::SafeDownCast(array);
-
-      if (strArray)
-      {
-        tooltipTextStream << strArray->GetValue(0);
-      }
-      else if (dataArray)
-      {
-        vtkIdType nbComps = array->GetNumberOfComponents();
-        vtkIdType maxDisplayedComp = 9;
+    hoverInfo->SetProcessId(properties->Get(vtkSelectionNode::PROCESS_ID()));
+  }
+  this->PreviousRepresentation->GatherInformation(hoverInfo, vtkPVSession::DATA_SERVER);
+  if (!hoverInfo->GetFound())
+  {
+    return false;
+  }
 
-        if (nbComps > 1)
-        {
-          tooltipTextStream << "(";
-        }
+  tooltipText = ::FormatTooltipText(association, hoverInfo, hoverInfo->GetResultElementId());
+  return true;
+}
 
-        for (vtkIdType i_comp = 0; i_comp < std::min(nbComps, maxDisplayedComp); i_comp++)
-        {
-          tooltipTextStream << dataArray->GetTuple(0)[i_comp];
+//----------------------------------------------------------------------------
+bool vtkSMTooltipSelectionPipeline::GetTooltipTextFromExtract(
+  int association, std::string& tooltipText)
+{
+  vtkSMSourceProxy* extractSource = this->ExtractInteractiveSelection;
+  unsigned int extractOutputPort = extractSource->GetOutputPort((unsigned int)0)->GetPortIndex();
+  vtkDataObject* dataObject =
+    this->ConnectPVMoveSelectionToClient(extractSource, extractOutputPort);
 
-          if (i_comp + 1 < nbComps && i_comp < maxDisplayedComp)
-          {
-            tooltipTextStream << ", ";
-          }
-        }
+  bool compositeFound;
+  std::string compositeName;
+  vtkDataSet* ds = this->FindDataSet(dataObject, compositeFound, compositeName);
+  if (!ds)
+  {
+    return false;
+  }
 
-        if (nbComps > 1)
-        {
-          if (nbComps > maxDisplayedComp)
-          {
-            tooltipTextStream << "...";
-          }
-          tooltipTextStream << ")";
-        }
-      }
-    }
+  vtkNew<vtkPVHoverInformation> hoverInfo;
+  hoverInfo->SetFieldAssociation(association);
+  if (!hoverInfo->CopyFromDataSet(ds, 0, compositeFound ? compositeName.c_str() : nullptr))
+  {
+    return false;
   }
 
-  formatedTooltipText =
-    "<p style='white-space:pre'><b>" + proxyName + "</b>" + tooltipTextStream.str() + "</p>";
-  plainTooltipText = proxyName + tooltipTextStream.str();
+  // the extracted element keeps its id in the original ids array.
+  vtkDataArray* originalIds = association == vtkDataObject::FIELD_ASSOCIATION_POINTS
+    ? ds->GetPointData()->GetArray("vtkOriginalPointIds")
+    : ds->GetCellData()->GetArray("vtkOriginalCellIds");
+  const vtkIdType id = originalIds ? static_cast<vtkIdType>(originalIds->GetTuple1(0)) : -1;
 
-  this->TooltipEnabled = false;
+  tooltipText = ::FormatTooltipText(association, hoverInfo, id);
   return true;
 }
 
@@ -75,6 +75,19 @@ protected:
   vtkDataObject* ConnectPVMoveSelectionToClient(
     vtkSMSourceProxy* source, unsigned int sourceOutputPort);
 
+  ///@{
+  /**
+   * Compute the tooltip text (without the source name) for the current
+   * selection. GetTooltipTextFromRepresentation() queries the element directly
+   * from the representation using vtkPVHoverInformation and is tried first.
+   * GetTooltipTextFromExtract() runs the extract-selection pipeline and moves
+   * its result to the client; it is used for data not supported by the former,
+   * e.g. hyper tree grids.
+   */
+  bool GetTooltipTextFromRepresentation(int association, std::string& tooltipText);
+  bool GetTooltipTextFromExtract(int association, std::string& tooltipText);
+  ///@}
+
   /**
    * Get the id of the selected point.
    */
@@ -0,0 +1,116 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkInitializationHelper.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPVDataInformation.h"
+#include "vtkPVXMLElement.h"
+#include "vtkProcessModule.h"
+#include "vtkSMParaViewPipelineController.h"
+#include "vtkSMPropertyHelper.h"
+#include "vtkSMSession.h"
+#include "vtkSMSessionProxyManager.h"
+#include "vtkSMSourceProxy.h"
+#include "vtkSmartPointer.h"
+
+#include <cstdlib>
+
+#define TEST_ASSERT(x)                                                                             \
+  do                                                                                               \
+  {                                                                                                \
+    if (!(x))                                                                                      \
+    {                                                                                              \
+      vtkLogF(ERROR, "Check failed: %s", #x);                                                      \
+      return EXIT_FAILURE;                                                                         \
+    }                                                                                              \
+  } while (false)
+
+namespace
+{
+// Loads the state in an empty proxy manager and checks the pipeline it
+// describes.
+int LoadAndCheck(vtkSMSessionProxyManager* pxm, vtkPVXMLElement* state, vtkIdType numberOfCells)
+{
+  pxm->UnRegisterProxies();
+  TEST_ASSERT(pxm->GetProxy("sources", "sphere") == nullptr);
+  pxm->LoadXMLState(state);
+
+  auto sphere = vtkSMSourceProxy::SafeDownCast(pxm->GetProxy("sources", "sphere"));
+  auto shrink = vtkSMSourceProxy::SafeDownCast(pxm->GetProxy("filters", "shrink"));
+  TEST_ASSERT(sphere != nullptr && shrink != nullptr);
+  TEST_ASSERT(vtkSMPropertyHelper(sphere, "ThetaResolution").GetAsInt() == 20);
+  TEST_ASSERT(vtkSMPropertyHelper(shrink, "Input").GetAsProxy() == sphere);
+  TEST_ASSERT(vtkSMPropertyHelper(shrink, "ShrinkFactor").GetAsDouble() == 0.25);
+
+  // the pipeline information is up to date even when it was deferred.
+  TEST_ASSERT(shrink->GetOutputPort(0u) != nullptr);
+  shrink->UpdatePipeline();
+  TEST_ASSERT(shrink->GetDataInformation(0)->GetNumberOfCells() == numberOfCells);
+  return EXIT_SUCCESS;
+}
+
+int Run(vtkSMSession* session)
+{
+  auto pxm = session->GetSessionProxyManager();
+  vtkNew<vtkSMParaViewPipelineController> controller;
+
+  vtkSmartPointer<vtkSMSourceProxy> sphere;
+  sphere.TakeReference(vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("sources", "SphereSource")));
+  controller->PreInitializeProxy(sphere);
+  vtkSMPropertyHelper(sphere, "PhiResolution").Set(20);
+  vtkSMPropertyHelper(sphere, "ThetaResolution").Set(20);
+  controller->PostInitializeProxy(sphere);
+  controller->RegisterPipelineProxy(sphere, "sphere");
+
+  vtkSmartPointer<vtkSMSourceProxy> shrink;
+  shrink.TakeReference(vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("filters", "ShrinkFilter")));
+  controller->PreInitializeProxy(shrink);
+  vtkSMPropertyHelper(shrink, "Input").Set(sphere);
+  vtkSMPropertyHelper(shrink, "ShrinkFactor").Set(0.25);
+  controller->PostInitializeProxy(shrink);
+  controller->RegisterPipelineProxy(shrink, "shrink");
+  shrink->UpdatePipeline();
+  const vtkIdType numberOfCells = shrink->GetDataInformation(0)->GetNumberOfCells();
+  TEST_ASSERT(numberOfCells > 0);
+
+  vtkSmartPointer<vtkPVXMLElement> state;
+  state.TakeReference(pxm->SaveXMLState());
+  sphere = nullptr;
+  shrink = nullptr;
+
+  // batched loading is opt-in.
+  TEST_ASSERT(!vtkSMSessionProxyManager::GetBatchedStateLoading());
+  if (LoadAndCheck(pxm, state, numberOfCells) != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+
+  // the loader created by LoadXMLState() honors the setting and loads the
+  // same pipeline.
+  vtkSMSessionProxyManager::SetBatchedStateLoading(true);
+  const int status = LoadAndCheck(pxm, state, numberOfCells);
+  vtkSMSessionProxyManager::SetBatchedStateLoading(false);
+  return status;
+}
+}
+
+extern int TestBatchedStateLoading(int, char* argv[])
+{
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_CLIENT);
+
+  vtkNew<vtkSMParaViewPipelineController> controller;
+  vtkSMSession* session = vtkSMSession::New();
+  if (!controller->InitializeSession(session))
+  {
+    vtkLogF(ERROR, "Failed to initialize ParaView session.");
+    session->Delete();
+    vtkInitializationHelper::Finalize();
+    return EXIT_FAILURE;
+  }
+
+  const int status = Run(session);
+
+  session->Delete();
+  vtkInitializationHelper::Finalize();
+  return status;
+}
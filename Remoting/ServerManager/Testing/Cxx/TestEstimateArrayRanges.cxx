@@ -0,0 +1,125 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkAlgorithm.h"
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkInitializationHelper.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPVArrayInformation.h"
+#include "vtkPVDataInformation.h"
+#include "vtkPVDataSetAttributesInformation.h"
+#include "vtkPointData.h"
+#include "vtkProcessModule.h"
+#include "vtkSMOutputPort.h"
+#include "vtkSMParaViewPipelineController.h"
+#include "vtkSMPropertyHelper.h"
+#include "vtkSMProxy.h"
+#include "vtkSMSession.h"
+#include "vtkSMSessionProxyManager.h"
+#include "vtkSMSourceProxy.h"
+#include "vtkSmartPointer.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+
+#define TEST_ASSERT(x)                                                                             \
+  do                                                                                               \
+  {                                                                                                \
+    if (!(x))                                                                                      \
+    {                                                                                              \
+      vtkLogF(ERROR, "Check failed: %s", #x);                                                      \
+      return EXIT_FAILURE;                                                                         \
+    }                                                                                              \
+  } while (false)
+
+namespace
+{
+vtkSmartPointer<vtkSMSourceProxy> CreateWavelet(vtkSMSession* session)
+{
+  vtkSmartPointer<vtkSMSourceProxy> proxy;
+  proxy.TakeReference(vtkSMSourceProxy::SafeDownCast(
+    session->GetSessionProxyManager()->NewProxy("sources", "RTAnalyticSource")));
+  vtkNew<vtkSMParaViewPipelineController> controller;
+  controller->InitializeProxy(proxy);
+  // 65^3 points, enough for their ranges to be estimated.
+  const int extent[6] = { -32, 32, -32, 32, -32, 32 };
+  vtkSMPropertyHelper(proxy, "WholeExtent").Set(extent, 6);
+  proxy->UpdateVTKObjects();
+  controller->RegisterPipelineProxy(proxy);
+  proxy->UpdatePipeline();
+  return proxy;
+}
+
+vtkPVArrayInformation* GetRTDataInformation(vtkSMSourceProxy* source)
+{
+  return source->GetDataInformation(0)->GetPointDataInformation()->GetArrayInformation("RTData");
+}
+
+int Run(vtkSMSession* session)
+{
+  vtkNew<vtkSMParaViewPipelineController> controller;
+
+  // estimation is opt-in.
+  TEST_ASSERT(!vtkSMOutputPort::GetEstimateRanges());
+  auto exact = CreateWavelet(session);
+  vtkPVArrayInformation* info = GetRTDataInformation(exact);
+  TEST_ASSERT(info != nullptr && !info->GetIsRangeApproximate());
+
+  vtkSMProxy* settings = session->GetSessionProxyManager()->GetProxy("settings", "GeneralSettings");
+  TEST_ASSERT(settings != nullptr);
+  vtkSMPropertyHelper(settings, "EstimateArrayRanges").Set(1);
+  settings->UpdateVTKObjects();
+  TEST_ASSERT(vtkSMOutputPort::GetEstimateRanges());
+
+  auto estimated = CreateWavelet(session);
+  info = GetRTDataInformation(estimated);
+  TEST_ASSERT(info != nullptr && info->GetIsRangeApproximate());
+  TEST_ASSERT(estimated->GetDataInformation(0)->HasApproximateRanges());
+
+  // the output port gathers the information again until the exact ranges,
+  // computed in the background, replace the estimates.
+  for (int attempt = 0; attempt < 100 && info->GetIsRangeApproximate(); ++attempt)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    info = GetRTDataInformation(estimated);
+  }
+  TEST_ASSERT(!info->GetIsRangeApproximate());
+
+  auto algorithm = vtkAlgorithm::SafeDownCast(estimated->GetClientSideObject());
+  auto output = vtkDataSet::SafeDownCast(algorithm->GetOutputDataObject(0));
+  double range[2];
+  output->GetPointData()->GetArray("RTData")->GetRange(range, 0);
+  TEST_ASSERT(info->GetComponentRange(0)[0] == range[0]);
+  TEST_ASSERT(info->GetComponentRange(0)[1] == range[1]);
+
+  vtkSMPropertyHelper(settings, "EstimateArrayRanges").Set(0);
+  settings->UpdateVTKObjects();
+  TEST_ASSERT(!vtkSMOutputPort::GetEstimateRanges());
+  controller->UnRegisterProxy(estimated);
+  controller->UnRegisterProxy(exact);
+  return EXIT_SUCCESS;
+}
+}
+
+extern int TestEstimateArrayRanges(int, char* argv[])
+{
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_CLIENT);
+
+  vtkNew<vtkSMParaViewPipelineController> controller;
+  vtkSMSession* session = vtkSMSession::New();
+  if (!controller->InitializeSession(session))
+  {
+    vtkLogF(ERROR, "Failed to initialize ParaView session.");
+    session->Delete();
+    vtkInitializationHelper::Finalize();
+    return EXIT_FAILURE;
+  }
+
+  const int status = Run(session);
+
+  session->Delete();
+  vtkInitializationHelper::Finalize();
+  return status;
+}
@@ -0,0 +1,135 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkClientServerStream.h"
+#include "vtkInitializationHelper.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPVSession.h"
+#include "vtkPVTimeStepCacheInformation.h"
+#include "vtkProcessModule.h"
+#include "vtkSMParaViewPipelineController.h"
+#include "vtkSMPropertyHelper.h"
+#include "vtkSMProxy.h"
+#include "vtkSMSession.h"
+#include "vtkSMSessionProxyManager.h"
+#include "vtkSMSourceProxy.h"
+#include "vtkSmartPointer.h"
+
+#include <cstdlib>
+
+#define TEST_ASSERT(x)                                                                             \
+  do                                                                                               \
+  {                                                                                                \
+    if (!(x))                                                                                      \
+    {                                                                                              \
+      vtkLogF(ERROR, "Check failed: %s", #x);                                                      \
+      return EXIT_FAILURE;                                                                         \
+    }                                                                                              \
+  } while (false)
+
+namespace
+{
+vtkSmartPointer<vtkSMSourceProxy> CreateTimeSource(vtkSMSession* session)
+{
+  vtkSmartPointer<vtkSMSourceProxy> proxy;
+  proxy.TakeReference(vtkSMSourceProxy::SafeDownCast(
+    session->GetSessionProxyManager()->NewProxy("sources", "TimeSource")));
+  vtkNew<vtkSMParaViewPipelineController> controller;
+  controller->InitializeProxy(proxy);
+  controller->RegisterPipelineProxy(proxy);
+  return proxy;
+}
+
+// Updates the source for its first time steps, then goes back to them.
+void Scrub(vtkSMSourceProxy* source)
+{
+  vtkSMPropertyHelper timesteps(source, "TimestepValues");
+  for (int pass = 0; pass < 2; ++pass)
+  {
+    for (unsigned int cc = 0; cc < 3; ++cc)
+    {
+      source->UpdatePipeline(timesteps.GetAsDouble(cc));
+    }
+  }
+}
+
+int Run(vtkSMSession* session)
+{
+  vtkNew<vtkSMParaViewPipelineController> controller;
+  vtkNew<vtkPVTimeStepCacheInformation> before;
+  vtkNew<vtkPVTimeStepCacheInformation> after;
+
+  // caching is opt-in: revisiting time steps executes the source again.
+  TEST_ASSERT(!vtkSMParaViewPipelineController::GetCacheTimeSteps());
+  auto uncached = CreateTimeSource(session);
+  TEST_ASSERT(vtkSMPropertyHelper(uncached, "TimestepValues").GetNumberOfElements() >= 3);
+  session->GatherInformation(vtkPVSession::DATA_SERVER, before, 0);
+  Scrub(uncached);
+  session->GatherInformation(vtkPVSession::DATA_SERVER, after, 0);
+  TEST_ASSERT(after->GetHits() == before->GetHits());
+  TEST_ASSERT(after->GetMisses() == before->GetMisses());
+
+  // the setting enables it on the pipeline proxies registered afterwards.
+  vtkSMProxy* settings = session->GetSessionProxyManager()->GetProxy("settings", "GeneralSettings");
+  TEST_ASSERT(settings != nullptr);
+  vtkSMPropertyHelper(settings, "CacheTimeSteps").Set(1);
+  settings->UpdateVTKObjects();
+  TEST_ASSERT(vtkSMParaViewPipelineController::GetCacheTimeSteps());
+  auto cached = CreateTimeSource(session);
+
+  session->GatherInformation(vtkPVSession::DATA_SERVER, before, 0);
+  Scrub(cached);
+  session->GatherInformation(vtkPVSession::DATA_SERVER, after, 0);
+  TEST_ASSERT(after->GetMisses() - before->GetMisses() == 3);
+  TEST_ASSERT(after->GetHits() - before->GetHits() == 3);
+  TEST_ASSERT(after->GetHitRate() > 0.0 && after->GetHitRate() <= 1.0);
+  TEST_ASSERT(after->GetSize() > 0 && after->GetSize() <= after->GetLimit());
+
+  // modifying the pipeline drops the cached outputs.
+  vtkSMPropertyHelper(cached, "X Amplitude").Set(1.0);
+  cached->UpdateVTKObjects();
+  session->GatherInformation(vtkPVSession::DATA_SERVER, before, 0);
+  cached->UpdatePipeline(vtkSMPropertyHelper(cached, "TimestepValues").GetAsDouble(0));
+  session->GatherInformation(vtkPVSession::DATA_SERVER, after, 0);
+  TEST_ASSERT(after->GetHits() == before->GetHits());
+  TEST_ASSERT(after->GetMisses() - before->GetMisses() == 1);
+
+  // the statistics survive the round trip to the client and are summed.
+  vtkClientServerStream css;
+  after->CopyToStream(&css);
+  vtkNew<vtkPVTimeStepCacheInformation> received;
+  received->CopyFromStream(&css);
+  TEST_ASSERT(received->GetHits() == after->GetHits());
+  TEST_ASSERT(received->GetLimit() == after->GetLimit());
+  received->AddInformation(after);
+  TEST_ASSERT(received->GetMisses() == 2 * after->GetMisses());
+  TEST_ASSERT(received->GetHitRate() == after->GetHitRate());
+
+  vtkSMPropertyHelper(settings, "CacheTimeSteps").Set(0);
+  settings->UpdateVTKObjects();
+  controller->UnRegisterProxy(cached);
+  controller->UnRegisterProxy(uncached);
+  return EXIT_SUCCESS;
+}
+}
+
+extern int TestTimeStepCache(int, char* argv[])
+{
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_CLIENT);
+
+  vtkNew<vtkSMParaViewPipelineController> controller;
+  vtkSMSession* session = vtkSMSession::New();
+  if (!controller->InitializeSession(session))
+  {
+    vtkLogF(ERROR, "Failed to initialize ParaView session.");
+    session->Delete();
+    vtkInitializationHelper::Finalize();
+    return EXIT_FAILURE;
+  }
+
+  const int status = Run(session);
+
+  session->Delete();
+  vtkInitializationHelper::Finalize();
+  return status;
+}
@@ -278,6 +278,12 @@ vtkMPIMToNSocketConnection* vtkPVSessionBase::GetMPIMToNSocketConnection()
   return this->SessionCore->GetMPIMToNSocketConnection();
 }
 
+//----------------------------------------------------------------------------
+vtkMPIMToNSocketConnection* vtkPVSessionBase::GetStripedDeliveryConnection()
+{
+  return this->SessionCore->GetStripedDeliveryConnection();
+}
+
 //----------------------------------------------------------------------------
 void vtkPVSessionBase::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -66,6 +66,12 @@ public:
    */
   vtkMPIMToNSocketConnection* GetMPIMToNSocketConnection() override;
 
+  /**
+   * This is socket connection, if any, between the data-server nodes and the
+   * client used for striped data delivery. Forwarded for vtkPVSessionCore.
+   */
+  vtkMPIMToNSocketConnection* GetStripedDeliveryConnection() override;
+
   //---------------------------------------------------------------------------
   // Remote communication API. This API is used for communication in the
   // CLIENT -> SERVER(s) direction.
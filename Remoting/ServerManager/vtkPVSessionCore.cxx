@@ -182,6 +182,18 @@ public:
     return nullptr; // Did not find it
   }
 
+  //---------------------------------------------------------------------------
+  void GetAllSIObjects(vtkCollection* collection)
+  {
+    for (const auto& pair : this->SIObjectMap)
+    {
+      if (pair.second)
+      {
+        collection->AddItem(pair.second);
+      }
+    }
+  }
+
   //---------------------------------------------------------------------------
   void GetAllRemoteObjects(vtkCollection* collection)
   {
@@ -230,6 +242,7 @@ vtkPVSessionCore::vtkPVSessionCore()
 
   this->Interpreter = vtkClientServerInterpreterInitializer::GetInitializer()->NewInterpreter();
   this->MPIMToNSocketConnection = nullptr;
+  this->StripedDeliveryConnection = nullptr;
   this->SymmetricMPIMode = false;
 
   vtkPVSessionCoreInterpreterHelper* helper = vtkPVSessionCoreInterpreterHelper::New();
@@ -308,6 +321,7 @@ vtkPVSessionCore::~vtkPVSessionCore()
   this->Internals = nullptr;
 
   this->SetMPIMToNSocketConnection(nullptr);
+  this->SetStripedDeliveryConnection(nullptr);
 }
 
 //----------------------------------------------------------------------------
@@ -320,6 +334,16 @@ void vtkPVSessionCore::SetMPIMToNSocketConnection(vtkMPIMToNSocketConnection* m2
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkPVSessionCore::SetStripedDeliveryConnection(vtkMPIMToNSocketConnection* m2c)
+{
+  vtkSetObjectBodyMacro(StripedDeliveryConnection, vtkMPIMToNSocketConnection, m2c);
+  if (m2c)
+  {
+    m2c->ConnectMtoN();
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkPVSessionCore::OnInterpreterError(vtkObject*, unsigned long, void* calldata)
 {
@@ -979,6 +1003,12 @@ void vtkPVSessionCore::GetAllRemoteObjects(vtkCollection* collection)
   this->Internals->GetAllRemoteObjects(collection);
 }
 
+//----------------------------------------------------------------------------
+void vtkPVSessionCore::GetAllSIObjects(vtkCollection* collection)
+{
+  this->Internals->GetAllSIObjects(collection);
+}
+
 //----------------------------------------------------------------------------
 const vtkClientServerStream& vtkPVSessionCore::GetLastResult()
 {
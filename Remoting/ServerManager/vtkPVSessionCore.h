@@ -131,6 +131,16 @@ public:
   vtkGetObjectMacro(MPIMToNSocketConnection, vtkMPIMToNSocketConnection);
   ///@}
 
+  ///@{
+  /**
+   * Get/Set the socket connection used to deliver data from several
+   * data-server processes to the client. This is valid only on data-server
+   * and client processes.
+   */
+  void SetStripedDeliveryConnection(vtkMPIMToNSocketConnection*);
+  vtkGetObjectMacro(StripedDeliveryConnection, vtkMPIMToNSocketConnection);
+  ///@}
+
   /**
    * Provides the next available identifier. This implementation works locally.
    * without any code distribution. To support the distributed architecture
@@ -170,6 +180,12 @@ public:
    */
   virtual void GetAllRemoteObjects(vtkCollection* collection);
 
+  /**
+   * Fill a vtkCollection with all the SIObjects on this process, sorted by
+   * global id.
+   */
+  void GetAllSIObjects(vtkCollection* collection);
+
   /**
    * Delete SIObject that are held by clients that disappeared
    * from the given list.
@@ -230,6 +246,7 @@ protected:
   vtkWeakPointer<vtkMultiProcessController> ParallelController;
   vtkClientServerInterpreter* Interpreter;
   vtkMPIMToNSocketConnection* MPIMToNSocketConnection;
+  vtkMPIMToNSocketConnection* StripedDeliveryConnection;
 
 private:
   vtkPVSessionCore(const vtkPVSessionCore&) = delete;
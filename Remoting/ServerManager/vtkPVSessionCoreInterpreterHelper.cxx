@@ -80,6 +80,13 @@ void vtkPVSessionCoreInterpreterHelper::SetMPIMToNSocketConnection(vtkMPIMToNSoc
   this->Core->SetMPIMToNSocketConnection(m2n);
 }
 
+//----------------------------------------------------------------------------
+void vtkPVSessionCoreInterpreterHelper::SetStripedDeliveryConnection(
+  vtkMPIMToNSocketConnection* m2c)
+{
+  this->Core->SetStripedDeliveryConnection(m2c);
+}
+
 //----------------------------------------------------------------------------
 void vtkPVSessionCoreInterpreterHelper::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -61,6 +61,12 @@ public:
    */
   void SetMPIMToNSocketConnection(vtkMPIMToNSocketConnection*);
 
+  /**
+   * Sets and initializes the connection used to deliver data from several
+   * data-server processes to the client.
+   */
+  void SetStripedDeliveryConnection(vtkMPIMToNSocketConnection*);
+
   /**
    * Used by vtkPVSessionCore to pass the core. This is not reference counted.
    */
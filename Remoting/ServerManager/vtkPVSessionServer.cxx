@@ -23,13 +23,22 @@
 #include "vtkSmartPointer.h"
 #include "vtkSocketCommunicator.h"
 #include "vtkSocketController.h"
+#include "vtkTimerLog.h"
 
+#include "vtk_lz4.h"
+
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <iterator>
 #include <map>
+#include <set>
 #include <sstream>
 #include <string>
 #include <vector>
 #include <vtksys/RegularExpression.hxx>
+#include <vtksys/SystemTools.hxx>
 
 //****************************************************************************/
 //                    Internal Classes and typedefs
@@ -224,16 +233,296 @@ public:
   //-----------------------------------------------------------------
   void NotifyOtherClients(const vtkSMMessage* msgToBroadcast)
   {
-    std::string data = msgToBroadcast->SerializeAsString();
-    this->CompositeMultiProcessController->TriggerRMI2All(1, (void*)data.c_str(),
-      static_cast<int>(data.size()), vtkPVSessionServer::SERVER_NOTIFICATION_MESSAGE_RMI, false);
+    this->Notify(msgToBroadcast, false);
   }
   //-----------------------------------------------------------------
   void NotifyAllClients(const vtkSMMessage* msgToBroadcast)
   {
-    std::string data = msgToBroadcast->SerializeAsString();
-    this->CompositeMultiProcessController->TriggerRMI2All(1, (void*)data.c_str(),
-      static_cast<int>(data.size()), vtkPVSessionServer::SERVER_NOTIFICATION_MESSAGE_RMI, true);
+    this->Notify(msgToBroadcast, true);
+  }
+  //-----------------------------------------------------------------
+  // Sends a notification to each connected client, minus the properties it
+  // already knows. Property updates arriving within the notification interval
+  // of the previous one for the same proxy are coalesced instead.
+  void Notify(const vtkSMMessage* msg, bool sendToActiveToo)
+  {
+    const double interval = this->Owner->NotificationInterval / 1000.0;
+    const bool coalesce = interval > 0 && vtkInternals::IsPropertyUpdate(msg);
+    const double now = vtkTimerLog::GetUniversalTime();
+    vtkCompositeMultiProcessController* composite =
+      this->CompositeMultiProcessController.GetPointer();
+    vtkMultiProcessController* active = composite->GetActiveController();
+    const int nbCtrls = composite->GetNumberOfControllers();
+    for (int cc = 0; cc < nbCtrls; ++cc)
+    {
+      vtkMultiProcessController* controller = composite->GetController(cc);
+      if ((!sendToActiveToo && controller == active) || !vtkInternals::IsConnected(controller))
+      {
+        continue;
+      }
+
+      const int clientId = composite->GetControllerId(cc);
+      ClientNotifications& client = this->Notifications[clientId];
+      vtkSMMessage toSend;
+      if (coalesce)
+      {
+        auto last = client.LastSent.find(msg->global_id());
+        const bool due = last == client.LastSent.end() || now - last->second >= interval;
+        auto pending = std::find_if(client.Pending.begin(), client.Pending.end(),
+          [msg](const vtkSMMessage& item) { return item.global_id() == msg->global_id(); });
+        if (pending == client.Pending.end() && due)
+        {
+          toSend.CopyFrom(*msg);
+        }
+        else if (pending == client.Pending.end())
+        {
+          client.Pending.push_back(*msg);
+          ++this->Owner->NumberOfCoalescedNotifications;
+          continue;
+        }
+        else
+        {
+          vtkInternals::MergeProperties(*pending, *msg);
+          ++this->Owner->NumberOfCoalescedNotifications;
+          if (!due)
+          {
+            continue;
+          }
+          toSend.Swap(&(*pending));
+          client.Pending.erase(pending);
+        }
+      }
+      else
+      {
+        // keep the updates in order: whatever is pending goes first.
+        this->FlushClient(controller, clientId, now, true);
+        toSend.CopyFrom(*msg);
+      }
+      this->SendNotification(controller, clientId, toSend, now);
+    }
+  }
+  //-----------------------------------------------------------------
+  // Sends the coalesced notifications whose interval has elapsed, or all of
+  // them when `force` is true.
+  void FlushNotifications(bool force)
+  {
+    const double now = vtkTimerLog::GetUniversalTime();
+    vtkCompositeMultiProcessController* composite =
+      this->CompositeMultiProcessController.GetPointer();
+    const int nbCtrls = composite->GetNumberOfControllers();
+    for (int cc = 0; cc < nbCtrls; ++cc)
+    {
+      vtkMultiProcessController* controller = composite->GetController(cc);
+      if (vtkInternals::IsConnected(controller))
+      {
+        this->FlushClient(controller, composite->GetControllerId(cc), now, force);
+      }
+    }
+  }
+  //-----------------------------------------------------------------
+  void FlushClient(vtkMultiProcessController* controller, int clientId, double now, bool force)
+  {
+    auto iter = this->Notifications.find(clientId);
+    if (iter == this->Notifications.end() || iter->second.Pending.empty())
+    {
+      return;
+    }
+    ClientNotifications& client = iter->second;
+    const double interval = this->Owner->NotificationInterval / 1000.0;
+    std::vector<vtkSMMessage> pending;
+    pending.swap(client.Pending);
+    for (auto& msg : pending)
+    {
+      if (force || now - client.LastSent[msg.global_id()] >= interval)
+      {
+        this->SendNotification(controller, clientId, msg, now);
+      }
+      else
+      {
+        client.Pending.push_back(msg);
+      }
+    }
+  }
+  //-----------------------------------------------------------------
+  // Returns the time, in seconds, until the next coalesced notification is
+  // due, or a negative value if there is none.
+  double GetTimeToNextNotification()
+  {
+    const double interval = this->Owner->NotificationInterval / 1000.0;
+    const double now = vtkTimerLog::GetUniversalTime();
+    double next = -1;
+    for (auto& item : this->Notifications)
+    {
+      for (const auto& msg : item.second.Pending)
+      {
+        const double delay =
+          std::max(0.0, item.second.LastSent[msg.global_id()] + interval - now);
+        next = next < 0 ? delay : std::min(next, delay);
+      }
+    }
+    return next;
+  }
+  //-----------------------------------------------------------------
+  void SendNotification(
+    vtkMultiProcessController* controller, int clientId, vtkSMMessage& msg, double now)
+  {
+    if (!this->RemoveKnownProperties(clientId, msg))
+    {
+      ++this->Owner->NumberOfSkippedNotifications;
+      return;
+    }
+    this->RecordProperties(clientId, &msg);
+    if (vtkInternals::IsPropertyUpdate(&msg))
+    {
+      this->Notifications[clientId].LastSent[msg.global_id()] = now;
+    }
+
+    std::string data = msg.SerializeAsString();
+    controller->TriggerRMI(1, (void*)data.c_str(), static_cast<int>(data.size()),
+      vtkPVSessionServer::SERVER_NOTIFICATION_MESSAGE_RMI);
+  }
+  //-----------------------------------------------------------------
+  // Keeps track of the property values known by a client i.e. the values it
+  // pushed, pulled or was notified of.
+  void RecordProperties(int clientId, const vtkSMMessage* msg)
+  {
+    const int count = msg->ExtensionSize(ProxyState::property);
+    if (!this->Owner->DeltaNotifications || count == 0)
+    {
+      return;
+    }
+    auto& known = this->Notifications[clientId].Properties[msg->global_id()];
+    for (int cc = 0; cc < count; ++cc)
+    {
+      const ProxyState_Property& prop = msg->GetExtension(ProxyState::property, cc);
+      known[prop.name()] = prop.SerializeAsString();
+    }
+  }
+  //-----------------------------------------------------------------
+  // Called with the messages pushed or pulled by the active client.
+  void RecordActiveClientProperties(const vtkSMMessage* msg)
+  {
+    const int clientId = this->CompositeMultiProcessController->GetActiveControllerID();
+    this->RecordProperties(clientId, msg);
+
+    // pending updates of these properties are older than the client's values.
+    auto iter = this->Notifications.find(clientId);
+    if (iter == this->Notifications.end())
+    {
+      return;
+    }
+    auto& pending = iter->second.Pending;
+    auto item = std::find_if(pending.begin(), pending.end(),
+      [msg](const vtkSMMessage& other) { return other.global_id() == msg->global_id(); });
+    if (item != pending.end())
+    {
+      vtkSMMessage remaining;
+      remaining.CopyFrom(*item);
+      remaining.ClearExtension(ProxyState::property);
+      vtkInternals::MergeProperties(remaining, *item, msg);
+      if (remaining.ExtensionSize(ProxyState::property) == 0)
+      {
+        pending.erase(item);
+      }
+      else
+      {
+        item->Swap(&remaining);
+      }
+    }
+  }
+  //-----------------------------------------------------------------
+  // Removes the properties whose value is already known by the client.
+  // Returns false when nothing is left worth sending.
+  bool RemoveKnownProperties(int clientId, vtkSMMessage& msg)
+  {
+    const int count = msg.ExtensionSize(ProxyState::property);
+    if (!this->Owner->DeltaNotifications || count == 0)
+    {
+      return true;
+    }
+    auto& proxies = this->Notifications[clientId].Properties;
+    auto known = proxies.find(msg.global_id());
+    if (known == proxies.end())
+    {
+      return true;
+    }
+
+    std::vector<ProxyState_Property> changed;
+    for (int cc = 0; cc < count; ++cc)
+    {
+      const ProxyState_Property& prop = msg.GetExtension(ProxyState::property, cc);
+      auto value = known->second.find(prop.name());
+      if (value == known->second.end() || value->second != prop.SerializeAsString())
+      {
+        changed.push_back(prop);
+      }
+    }
+    if (static_cast<int>(changed.size()) == count)
+    {
+      return true;
+    }
+
+    this->Owner->NumberOfSkippedProperties += count - static_cast<int>(changed.size());
+    msg.ClearExtension(ProxyState::property);
+    for (const auto& prop : changed)
+    {
+      msg.AddExtension(ProxyState::property)->CopyFrom(prop);
+    }
+    return !changed.empty() || msg.GetExtension(ProxyState::has_annotation) ||
+      msg.ExtensionSize(ProxyState::subproxy) > 0 || msg.HasExtension(ProxyState::xml_group);
+  }
+  //-----------------------------------------------------------------
+  // Forgets about a proxy that is no longer used.
+  void ForgetProxy(vtkTypeUInt32 globalId)
+  {
+    for (auto& item : this->Notifications)
+    {
+      item.second.Properties.erase(globalId);
+      item.second.LastSent.erase(globalId);
+    }
+  }
+  //-----------------------------------------------------------------
+  // Only plain property updates, as pushed by vtkSMProxy::UpdateVTKObjects(),
+  // can be coalesced.
+  static bool IsPropertyUpdate(const vtkSMMessage* msg)
+  {
+    return msg->ExtensionSize(ProxyState::property) > 0 &&
+      msg->ExtensionSize(ProxyState::subproxy) == 0 &&
+      !msg->GetExtension(ProxyState::has_annotation) && !msg->HasExtension(ProxyState::xml_group);
+  }
+  //-----------------------------------------------------------------
+  // Adds the properties of `update` to `pending`, replacing older values.
+  static void MergeProperties(vtkSMMessage& pending, const vtkSMMessage& update)
+  {
+    vtkSMMessage merged;
+    merged.CopyFrom(update);
+    vtkInternals::MergeProperties(merged, pending, &update);
+    pending.Swap(&merged);
+  }
+  // Adds the properties of `source` that are not in `excluded` to `target`.
+  static void MergeProperties(
+    vtkSMMessage& target, const vtkSMMessage& source, const vtkSMMessage* excluded)
+  {
+    std::set<std::string> names;
+    for (int cc = 0; cc < excluded->ExtensionSize(ProxyState::property); ++cc)
+    {
+      names.insert(excluded->GetExtension(ProxyState::property, cc).name());
+    }
+    for (int cc = 0; cc < source.ExtensionSize(ProxyState::property); ++cc)
+    {
+      const ProxyState_Property& prop = source.GetExtension(ProxyState::property, cc);
+      if (names.find(prop.name()) == names.end())
+      {
+        target.AddExtension(ProxyState::property)->CopyFrom(prop);
+      }
+    }
+  }
+  //-----------------------------------------------------------------
+  static bool IsConnected(vtkMultiProcessController* controller)
+  {
+    vtkSocketCommunicator* comm =
+      controller ? vtkSocketCommunicator::SafeDownCast(controller->GetCommunicator()) : nullptr;
+    return comm && comm->GetIsConnected();
   }
   //-----------------------------------------------------------------
   vtkCompositeMultiProcessController* GetActiveController()
@@ -259,6 +548,21 @@ public:
   //-----------------------------------------------------------------
   bool IsSatelliteSession() { return this->SatelliteServerSession; }
 
+  //-----------------------------------------------------------------
+  // Replies to the active client at least this large are compressed, 0 if the
+  // client did not ask for compressed replies.
+  int GetReplyCompressionThreshold()
+  {
+    auto iter = this->ReplyCompressionThresholds.find(
+      this->CompositeMultiProcessController->GetActiveControllerID());
+    return iter != this->ReplyCompressionThresholds.end() ? iter->second : 0;
+  }
+  void SetReplyCompressionThreshold(int threshold)
+  {
+    const int id = this->CompositeMultiProcessController->GetActiveControllerID();
+    this->ReplyCompressionThresholds[id] = threshold;
+  }
+
   //-----------------------------------------------------------------
   // Return true if the message was updated by the ShareOnlyCache
   bool RetreiveShareOnly(vtkSMMessage* msg)
@@ -288,6 +592,22 @@ public:
       this->Owner->SessionCore->GarbageCollectSIObject(
         &alivedClients[0], static_cast<int>(alivedClients.size()));
     }
+
+    // drop the notification state and channel options of the clients that
+    // are gone.
+    auto isDead = [&alivedClients](int clientId) {
+      return std::find(alivedClients.begin(), alivedClients.end(), clientId) ==
+        alivedClients.end();
+    };
+    for (auto iter = this->Notifications.begin(); iter != this->Notifications.end();)
+    {
+      iter = isDead(iter->first) ? this->Notifications.erase(iter) : std::next(iter);
+    }
+    for (auto iter = this->ReplyCompressionThresholds.begin();
+         iter != this->ReplyCompressionThresholds.end();)
+    {
+      iter = isDead(iter->first) ? this->ReplyCompressionThresholds.erase(iter) : std::next(iter);
+    }
   }
   //-----------------------------------------------------------------
   void CallBackProxyDefinitionManagerHasChanged(
@@ -301,11 +621,25 @@ public:
   }
 
 private:
+  // What is known about each client, to send it property deltas and coalesce
+  // its notifications.
+  struct ClientNotifications
+  {
+    // serialized value of the properties of each proxy known by the client.
+    std::map<vtkTypeUInt32, std::map<std::string, std::string>> Properties;
+    // time the last property update of each proxy was sent to the client.
+    std::map<vtkTypeUInt32, double> LastSent;
+    // coalesced property updates, at most one per proxy, in arrival order.
+    std::vector<vtkSMMessage> Pending;
+  };
+
   vtkNew<vtkCompositeMultiProcessController> CompositeMultiProcessController;
   vtkWeakPointer<vtkPVSessionServer> Owner;
   std::string ClientURL;
   std::string BaseURL;
   std::map<vtkTypeUInt32, vtkSMMessage> ShareOnlyCache;
+  std::map<int, int> ReplyCompressionThresholds;
+  std::map<int, ClientNotifications> Notifications;
   bool SatelliteServerSession;
 };
 //****************************************************************************/
@@ -319,6 +653,12 @@ vtkPVSessionServer::vtkPVSessionServer()
   this->MultipleConnection = false;
   this->DisableFurtherConnections = false;
 
+  std::string value;
+  if (vtksys::SystemTools::GetEnv("PARAVIEW_NOTIFICATION_INTERVAL", value))
+  {
+    this->NotificationInterval = std::max(0, std::atoi(value.c_str()));
+  }
+
   // On server side only one session is available so we just set it Active()
   // forever
   if (vtkProcessModule::GetProcessModule())
@@ -526,12 +866,52 @@ void vtkPVSessionServer::OnClientServerMessageRMI(void* message, int message_len
         this->PushState(&msg);
       }
 
+      // the pushing client knows these values, no need to send them back.
+      this->Internal->RecordActiveClientProperties(&msg);
+
       // Notify when ProxyManager state has changed
       // or any other state change
       this->NotifyOtherClients(&msg);
     }
     break;
 
+    case vtkPVSessionServer::PUSH_BATCH:
+    {
+      // a batch is a count followed by that many complete messages, none of
+      // which expects a reply, in the order the client sent them.
+      int count = 0;
+      stream >> count;
+      for (int cc = 0; cc < count; ++cc)
+      {
+        unsigned char* data = nullptr;
+        unsigned int size = 0;
+        stream.Pop(data, size);
+        vtkMultiProcessStream batched;
+        batched.SetRawData(data, size);
+        int batchedType;
+        batched >> batchedType;
+        if (batchedType == vtkPVSessionServer::EXECUTE_STREAM)
+        {
+          // streams in a batch carry their data instead of sending it apart.
+          int ignore_errors;
+          unsigned char* css_data = nullptr;
+          unsigned int css_size = 0;
+          batched >> ignore_errors;
+          batched.Pop(css_data, css_size);
+          vtkClientServerStream cssStream;
+          cssStream.SetData(css_data, css_size);
+          this->ExecuteStream(vtkPVSession::CLIENT_AND_SERVERS, cssStream, ignore_errors != 0);
+          delete[] css_data;
+        }
+        else
+        {
+          this->OnClientServerMessageRMI(data, static_cast<int>(size));
+        }
+        delete[] data;
+      }
+    }
+    break;
+
     case vtkPVSessionServer::PULL:
     {
       std::string string;
@@ -544,10 +924,29 @@ void vtkPVSessionServer::OnClientServerMessageRMI(void* message, int message_len
       {
         this->PullState(&msg);
       }
+      this->Internal->RecordActiveClientProperties(&msg);
 
       // Send the result back to client
       vtkMultiProcessStream css;
-      css << msg.SerializeAsString();
+      const std::string reply = msg.SerializeAsString();
+      const int threshold = this->Internal->GetReplyCompressionThreshold();
+      std::vector<unsigned char> compressed;
+      if (threshold <= 0)
+      {
+        css << reply;
+      }
+      else if (reply.size() >= static_cast<size_t>(threshold) &&
+        vtkPVSessionServer::CompressPayload(
+          reinterpret_cast<const unsigned char*>(reply.data()), reply.size(), compressed))
+      {
+        // the client expects a flag telling whether the reply is compressed.
+        css << 1;
+        css.Push(compressed.data(), static_cast<unsigned int>(compressed.size()));
+      }
+      else
+      {
+        css << 0 << reply;
+      }
       this->Internal->GetActiveController()->Send(css, 1, vtkPVSessionServer::REPLY_PULL);
     }
     break;
@@ -567,6 +966,7 @@ void vtkPVSessionServer::OnClientServerMessageRMI(void* message, int message_len
       vtkSMMessage msg;
       msg.ParseFromString(string);
       this->UnRegisterSIObject(&msg);
+      this->Internal->ForgetProxy(msg.global_id());
     }
     break;
 
@@ -574,12 +974,29 @@ void vtkPVSessionServer::OnClientServerMessageRMI(void* message, int message_len
     {
       int ignore_errors, size;
       stream >> ignore_errors >> size;
-      unsigned char* css_data = new unsigned char[size + 1];
+      // a negative size is the size of a stream compressed by the client.
+      const int length = size < 0 ? -size : size;
+      unsigned char* css_data = new unsigned char[length + 1];
       this->Internal->GetActiveController()->Receive(
-        css_data, size, 1, vtkPVSessionServer::EXECUTE_STREAM_TAG);
-      vtkClientServerStream cssStream;
-      cssStream.SetData(css_data, size);
-      this->ExecuteStream(vtkPVSession::CLIENT_AND_SERVERS, cssStream, ignore_errors != 0);
+        css_data, length, 1, vtkPVSessionServer::EXECUTE_STREAM_TAG);
+      std::vector<unsigned char> payload;
+      if (size >= 0 || vtkPVSessionServer::UncompressPayload(css_data, length, payload))
+      {
+        vtkClientServerStream cssStream;
+        if (size < 0)
+        {
+          cssStream.SetData(payload.data(), payload.size());
+        }
+        else
+        {
+          cssStream.SetData(css_data, size);
+        }
+        this->ExecuteStream(vtkPVSession::CLIENT_AND_SERVERS, cssStream, ignore_errors != 0);
+      }
+      else
+      {
+        vtkErrorMacro("Failed to uncompress the stream received from the client.");
+      }
       delete[] css_data;
     }
     break;
@@ -598,6 +1015,33 @@ void vtkPVSessionServer::OnClientServerMessageRMI(void* message, int message_len
       this->GatherInformationInternal(location, classname.c_str(), globalid, stream);
     }
     break;
+
+    case vtkPVSessionServer::COMPRESSED:
+    {
+      // a message compressed by the client, dispatched once uncompressed.
+      unsigned char* data = nullptr;
+      unsigned int size = 0;
+      stream.Pop(data, size);
+      std::vector<unsigned char> payload;
+      if (vtkPVSessionServer::UncompressPayload(data, size, payload))
+      {
+        this->OnClientServerMessageRMI(payload.data(), static_cast<int>(payload.size()));
+      }
+      else
+      {
+        vtkErrorMacro("Failed to uncompress the message received from the client.");
+      }
+      delete[] data;
+    }
+    break;
+
+    case vtkPVSessionServer::CHANNEL_OPTIONS:
+    {
+      int threshold;
+      stream >> threshold;
+      this->Internal->SetReplyCompressionThreshold(threshold);
+    }
+    break;
   }
 }
 
@@ -613,8 +1057,77 @@ void vtkPVSessionServer::SendLastResultToClient()
   reply.GetData(&data, &size_size_t);
   size = static_cast<int>(size_size_t);
 
-  this->Internal->GetActiveController()->Send(&size, 1, 1, vtkPVSessionServer::REPLY_LAST_RESULT);
-  this->Internal->GetActiveController()->Send(data, size, 1, vtkPVSessionServer::REPLY_LAST_RESULT);
+  this->SendPayloadToClient(data, size, vtkPVSessionServer::REPLY_LAST_RESULT);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVSessionServer::SendPayloadToClient(const unsigned char* data, int size, int tag)
+{
+  vtkMultiProcessController* controller = this->Internal->GetActiveController();
+  const int threshold = this->Internal->GetReplyCompressionThreshold();
+  std::vector<unsigned char> compressed;
+  if (threshold > 0 && size >= threshold &&
+    vtkPVSessionServer::CompressPayload(data, static_cast<size_t>(size), compressed))
+  {
+    int length = -static_cast<int>(compressed.size());
+    controller->Send(&length, 1, 1, tag);
+    controller->Send(compressed.data(), -length, 1, tag);
+  }
+  else
+  {
+    controller->Send(&size, 1, 1, tag);
+    controller->Send(data, size, 1, tag);
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVSessionServer::CompressPayload(
+  const unsigned char* data, size_t size, std::vector<unsigned char>& compressed)
+{
+  if (size == 0 || size > static_cast<size_t>(LZ4_MAX_INPUT_SIZE))
+  {
+    return false;
+  }
+
+  // the uncompressed size is stored first, in little-endian order.
+  const int bound = LZ4_compressBound(static_cast<int>(size));
+  compressed.resize(4 + static_cast<size_t>(bound));
+  for (int cc = 0; cc < 4; ++cc)
+  {
+    compressed[cc] = static_cast<unsigned char>((size >> (8 * cc)) & 0xff);
+  }
+  const int length = LZ4_compress_default(reinterpret_cast<const char*>(data),
+    reinterpret_cast<char*>(&compressed[4]), static_cast<int>(size), bound);
+  if (length <= 0 || 4 + static_cast<size_t>(length) >= size)
+  {
+    return false;
+  }
+  compressed.resize(4 + static_cast<size_t>(length));
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVSessionServer::UncompressPayload(
+  const unsigned char* data, size_t size, std::vector<unsigned char>& payload)
+{
+  if (data == nullptr || size <= 4)
+  {
+    return false;
+  }
+
+  size_t length = 0;
+  for (int cc = 0; cc < 4; ++cc)
+  {
+    length |= static_cast<size_t>(data[cc]) << (8 * cc);
+  }
+  if (length == 0 || length > static_cast<size_t>(LZ4_MAX_INPUT_SIZE))
+  {
+    return false;
+  }
+  payload.resize(length);
+  const int result = LZ4_decompress_safe(reinterpret_cast<const char*>(data + 4),
+    reinterpret_cast<char*>(payload.data()), static_cast<int>(size - 4), static_cast<int>(length));
+  return result == static_cast<int>(length);
 }
 
 //----------------------------------------------------------------------------
@@ -638,11 +1151,8 @@ void vtkPVSessionServer::GatherInformationInternal(vtkTypeUInt32 location, const
     size_t length;
     const unsigned char* data;
     css.GetData(&data, &length);
-    int len = static_cast<int>(length);
-    this->Internal->GetActiveController()->Send(
-      &len, 1, 1, vtkPVSessionServer::REPLY_GATHER_INFORMATION_TAG);
-    this->Internal->GetActiveController()->Send(const_cast<unsigned char*>(data), length, 1,
-      vtkPVSessionServer::REPLY_GATHER_INFORMATION_TAG);
+    this->SendPayloadToClient(
+      data, static_cast<int>(length), vtkPVSessionServer::REPLY_GATHER_INFORMATION_TAG);
   }
   else
   {
@@ -664,10 +1174,33 @@ void vtkPVSessionServer::OnCloseSessionRMI()
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkPVSessionServer::FlushNotifications(bool force)
+{
+  this->Internal->FlushNotifications(force);
+}
+
+//----------------------------------------------------------------------------
+int vtkPVSessionServer::GetNotificationFlushTimeout()
+{
+  const double delay = this->Internal->GetTimeToNextNotification();
+  if (delay < 0)
+  {
+    return 0;
+  }
+  return std::max(1, static_cast<int>(std::ceil(delay * 1000.0)));
+}
+
 //----------------------------------------------------------------------------
 void vtkPVSessionServer::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "DeltaNotifications: " << this->DeltaNotifications << endl;
+  os << indent << "NotificationInterval: " << this->NotificationInterval << endl;
+  os << indent << "NumberOfCoalescedNotifications: " << this->NumberOfCoalescedNotifications
+     << endl;
+  os << indent << "NumberOfSkippedNotifications: " << this->NumberOfSkippedNotifications << endl;
+  os << indent << "NumberOfSkippedProperties: " << this->NumberOfSkippedProperties << endl;
 }
 //----------------------------------------------------------------------------
 void vtkPVSessionServer::NotifyOtherClients(const vtkSMMessage* msg)
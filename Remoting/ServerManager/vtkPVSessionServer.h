@@ -16,6 +16,8 @@
 #include "vtkPVSessionBase.h"
 #include "vtkRemotingServerManagerModule.h" //needed for exports
 
+#include <vector> // for std::vector
+
 class vtkMultiProcessController;
 class vtkMultiProcessStream;
 
@@ -71,6 +73,9 @@ public:
     REGISTER_SI = 16,
     UNREGISTER_SI = 17,
     LAST_RESULT = 18,
+    PUSH_BATCH = 19,
+    COMPRESSED = 20,
+    CHANNEL_OPTIONS = 21,
     SERVER_NOTIFICATION_MESSAGE_RMI = 55624,
     CLIENT_SERVER_MESSAGE_RMI = 55625,
     CLOSE_SESSION = 55626,
@@ -114,6 +119,19 @@ public:
   void OnClientServerMessageRMI(void* message, int message_length);
   void OnCloseSessionRMI();
 
+  ///@{
+  /**
+   * Compress/uncompress the payload of a client-server message with LZ4. The
+   * compressed payload starts with the size of the uncompressed one.
+   * CompressPayload() returns false when compression does not reduce the size
+   * of the payload, in which case it should be sent as is.
+   */
+  static bool CompressPayload(
+    const unsigned char* data, size_t size, std::vector<unsigned char>& compressed);
+  static bool UncompressPayload(
+    const unsigned char* data, size_t size, std::vector<unsigned char>& payload);
+  ///@}
+
   /**
    * Sends the message to all clients.
    */
@@ -124,6 +142,54 @@ public:
    */
   void NotifyOtherClients(const vtkSMMessage*) override;
 
+  ///@{
+  /**
+   * When enabled, the property updates sent to a client only carry the
+   * properties whose value differs from the one last known by that client,
+   * i.e. the value it last pushed, pulled or was notified of. Default is true.
+   */
+  vtkSetMacro(DeltaNotifications, bool);
+  vtkGetMacro(DeltaNotifications, bool);
+  vtkBooleanMacro(DeltaNotifications, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Minimum interval, in milliseconds, between two property updates of the
+   * same proxy sent to a client. Updates made within the interval, e.g. while
+   * dragging a slider, are merged and sent once it has elapsed by
+   * FlushNotifications(). Default is 0 i.e. updates are sent immediately, or
+   * the value of the PARAVIEW_NOTIFICATION_INTERVAL environment variable.
+   */
+  vtkSetClampMacro(NotificationInterval, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NotificationInterval, int);
+  ///@}
+
+  /**
+   * Sends the merged property updates whose interval has elapsed, or all of
+   * them when `force` is true.
+   */
+  void FlushNotifications(bool force = false);
+
+  /**
+   * Returns the time, in milliseconds, until the next merged property update
+   * is due, or 0 if there is none. The event loop should not wait longer than
+   * that before calling FlushNotifications().
+   */
+  int GetNotificationFlushTimeout();
+
+  ///@{
+  /**
+   * Statistics about the notifications: the number of property updates merged
+   * into a pending one, the number of notifications not sent because the
+   * client already knew all their properties, and the number of properties
+   * removed from notifications for the same reason.
+   */
+  vtkGetMacro(NumberOfCoalescedNotifications, vtkTypeInt64);
+  vtkGetMacro(NumberOfSkippedNotifications, vtkTypeInt64);
+  vtkGetMacro(NumberOfSkippedProperties, vtkTypeInt64);
+  ///@}
+
 protected:
   vtkPVSessionServer();
   ~vtkPVSessionServer() override;
@@ -139,10 +205,22 @@ protected:
    */
   void SendLastResultToClient();
 
+  /**
+   * Sends the size of a reply followed by its data to the active client. The
+   * data is compressed when the client asked for it and it is large enough, in
+   * which case the size is negated.
+   */
+  void SendPayloadToClient(const unsigned char* data, int size, int tag);
+
   vtkMPIMToNSocketConnection* MPIMToNSocketConnection;
 
   bool MultipleConnection;
   bool DisableFurtherConnections;
+  bool DeltaNotifications = true;
+  int NotificationInterval = 0;
+  vtkTypeInt64 NumberOfCoalescedNotifications = 0;
+  vtkTypeInt64 NumberOfSkippedNotifications = 0;
+  vtkTypeInt64 NumberOfSkippedProperties = 0;
 
   class vtkInternals;
   vtkInternals* Internal;
@@ -109,32 +109,19 @@ int vtkRemoteWriterHelper::RequestData(
     vtkPVSession::SafeDownCast(vtkProcessModule::GetProcessModule()->GetActiveSession());
   const vtkPVSession::ServerFlags roles = session->GetProcessRoles();
 
-  vtkThreadedCallbackQueue* callbackQueue =
-    vtkProcessModule::GetProcessModule()->GetCallbackQueue();
-
-  auto writeLocally = [this, callbackQueue](vtkSmartPointer<vtkDataObject>&& input) {
+  auto writeLocally = [this](vtkSmartPointer<vtkDataObject>&& input) {
     if (!this->TryWritingInBackground)
     {
       this->WriteLocally(input);
     }
-    else if (auto imageWriter =
-               vtkSmartPointer<vtkImageWriter>(vtkImageWriter::SafeDownCast(this->Writer)))
+    else if (auto imageWriter = vtkImageWriter::SafeDownCast(this->Writer))
     {
       this->Writer->SetInputDataObject(std::move(input));
+      if (this->GetState() != vtkRemoteWriterHelper::WRITE)
       {
-        if (this->GetState() != vtkRemoteWriterHelper::WRITE)
-        {
-          return;
-        }
-        ::FutureWorker worker{ imageWriter->GetFileName() };
-        // We need to lock guard modifying SharedFutures because the function
-        // we are pushing removes its futures from it in an asynchronous way
-        std::lock_guard<std::mutex> lock(::FutureMutex);
-        auto future = callbackQueue->Push(worker, imageWriter);
-        worker.FileName = imageWriter->GetFileName();
-        ::SharedFutures.emplace(vtksys::SystemTools::CollapseFullPath(imageWriter->GetFileName()),
-          std::make_pair(worker.TimeStamp, future));
+        return;
       }
+      vtkRemoteWriterHelper::WriteInBackground(imageWriter);
     }
     else
     {
@@ -201,6 +188,26 @@ int vtkRemoteWriterHelper::RequestData(
   return 1;
 }
 
+//----------------------------------------------------------------------------
+vtkThreadedCallbackQueue::SharedFutureBasePointer vtkRemoteWriterHelper::WriteInBackground(
+  vtkImageWriter* writer)
+{
+  vtkSmartPointer<vtkImageWriter> imageWriter = writer;
+  vtkThreadedCallbackQueue* callbackQueue =
+    vtkProcessModule::GetProcessModule()->GetCallbackQueue();
+
+  ::FutureWorker worker{ imageWriter->GetFileName() };
+  // We need to lock guard modifying SharedFutures because the function
+  // we are pushing removes its futures from it in an asynchronous way
+  std::lock_guard<std::mutex> lock(::FutureMutex);
+  auto future = callbackQueue->Push(worker, imageWriter);
+  // overwrites any previous write to the same file; Wait(fileName) only needs
+  // to wait for the latest one.
+  ::SharedFutures[vtksys::SystemTools::CollapseFullPath(imageWriter->GetFileName())] =
+    std::make_pair(worker.TimeStamp, future);
+  return future;
+}
+
 //----------------------------------------------------------------------------
 void vtkRemoteWriterHelper::Wait(const std::string& fileName)
 {
@@ -25,10 +25,12 @@
 #include "vtkDataObjectAlgorithm.h"
 #include "vtkPVSession.h"                   // for vtkPVSession::ServerFlags
 #include "vtkRemotingServerManagerModule.h" // for exports
+#include "vtkThreadedCallbackQueue.h"       // for SharedFutureBasePointer
 
 class vtkAlgorithm;
 class vtkClientServerInterpreter;
 class vtkDataObject;
+class vtkImageWriter;
 
 class VTKREMOTINGSERVERMANAGER_EXPORT vtkRemoteWriterHelper : public vtkDataObjectAlgorithm
 {
@@ -122,6 +124,15 @@ public:
    */
   static void Wait();
 
+  /**
+   * Push `writer->Write()` on the process module's callback queue. The write
+   * is tracked so that `Wait()` and `Wait(fileName)` account for it. The input
+   * and the file name must be set on the writer before calling this method and
+   * the writer must not be modified until the returned future is ready.
+   */
+  static vtkThreadedCallbackQueue::SharedFutureBasePointer WriteInBackground(
+    vtkImageWriter* writer);
+
   /**
    * Write the data.
    */
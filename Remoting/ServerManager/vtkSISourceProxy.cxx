@@ -112,6 +112,21 @@ void vtkSISourceProxy::OnCreateVTKObjects()
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkSISourceProxy::SetCacheTimeSteps(bool value)
+{
+  vtkAlgorithm* algo = vtkAlgorithm::SafeDownCast(this->GetVTKObject());
+  auto executive = algo ? vtkPVCompositeDataPipeline::SafeDownCast(algo->GetExecutive()) : nullptr;
+  if (executive)
+  {
+    executive->SetCacheTimeSteps(value);
+  }
+  else if (value)
+  {
+    vtkWarningMacro("Time step caching requires vtkPVCompositeDataPipeline.");
+  }
+}
+
 //----------------------------------------------------------------------------
 bool vtkSISourceProxy::CreateOutputPorts()
 {
@@ -210,8 +225,8 @@ void vtkSISourceProxy::UpdatePipeline(int port, double time, bool doTime)
     return;
   }
 
-  vtkVLogScopeF(PARAVIEW_LOG_PIPELINE_VERBOSITY(), "%s: update pipeline(%d, %f, %s) ",
-    this->GetLogNameOrDefault(), port, time, (doTime ? "true" : "false"));
+  PARAVIEW_LOG_SCOPE_F(PIPELINE, "%s: update pipeline(%d, %f, %s) ", this->GetLogNameOrDefault(),
+    port, time, (doTime ? "true" : "false"));
 
   vtkAlgorithm* algo = output_port->GetProducer();
   assert(algo);
@@ -271,8 +286,7 @@ void vtkSISourceProxy::UpdatePipelineInformation()
     return;
   }
 
-  vtkVLogScopeF(PARAVIEW_LOG_PIPELINE_VERBOSITY(), "%s: update pipeline information",
-    this->GetLogNameOrDefault());
+  PARAVIEW_LOG_SCOPE_F(PIPELINE, "%s: update pipeline information", this->GetLogNameOrDefault());
 
   if (this->GetVTKObject())
   {
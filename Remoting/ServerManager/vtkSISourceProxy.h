@@ -54,6 +54,13 @@ public:
    */
   virtual void SetDisablePipelineExecution(bool value) { this->DisablePipelineExecution = value; }
 
+  /**
+   * Enable/disable caching the outputs of the algorithm for each time step.
+   * Only supported when the algorithm uses vtkPVCompositeDataPipeline.
+   * @sa vtkPVCompositeDataPipeline::SetCacheTimeSteps
+   */
+  virtual void SetCacheTimeSteps(bool value);
+
   /**
    * Overridden to update the output ports.
    */
@@ -15,6 +15,7 @@
 #include "vtkSMExtractTriggerProxy.h"
 #include "vtkSMExtractWriterProxy.h"
 #include "vtkSMFileUtilities.h"
+#include "vtkSMImageWriterQueue.h"
 #include "vtkSMOutputPort.h"
 #include "vtkSMParaViewPipelineController.h"
 #include "vtkSMProperty.h"
@@ -89,6 +90,7 @@ vtkSMExtractsController::vtkSMExtractsController()
   , ExtractsOutputDirectory(nullptr)
   , EnvironmentExtractsOutputDirectory(nullptr)
   , SummaryTable(nullptr)
+  , ImageWriterQueue(vtkSmartPointer<vtkSMImageWriterQueue>::New())
   , ExtractsOutputDirectoryValid(false)
 {
   if (vtksys::SystemTools::HasEnv("PARAVIEW_OVERRIDE_EXTRACTS_OUTPUT_DIRECTORY"))
@@ -101,6 +103,7 @@ vtkSMExtractsController::vtkSMExtractsController()
 //----------------------------------------------------------------------------
 vtkSMExtractsController::~vtkSMExtractsController()
 {
+  this->Flush();
   this->SetExtractsOutputDirectory(nullptr);
   this->SetEnvironmentExtractsOutputDirectory(nullptr);
 }
@@ -614,6 +617,12 @@ bool vtkSMExtractsController::SaveSummaryTable(
     return false;
   }
 
+  // ensure all extracts listed in the summary table have been written.
+  if (!this->Flush())
+  {
+    vtkErrorMacro("Write failed! Extracts may not be generated correctly!");
+  }
+
   if (!this->CreateExtractsOutputDirectory(pxm))
   {
     return false;
@@ -646,6 +655,18 @@ bool vtkSMExtractsController::SaveSummaryTable(
   return true;
 }
 
+//----------------------------------------------------------------------------
+vtkSMImageWriterQueue* vtkSMExtractsController::GetImageWriterQueue() const
+{
+  return this->ImageWriterQueue;
+}
+
+//----------------------------------------------------------------------------
+bool vtkSMExtractsController::Flush()
+{
+  return this->ImageWriterQueue->Flush();
+}
+
 //----------------------------------------------------------------------------
 std::string vtkSMExtractsController::GetSummaryTableFilenameColumnName(const std::string& fname)
 {
@@ -38,6 +38,7 @@
 
 class vtkCollection;
 class vtkSMExtractWriterProxy;
+class vtkSMImageWriterQueue;
 class vtkSMProxy;
 class vtkSMSessionProxyManager;
 class vtkTable;
@@ -196,10 +197,24 @@ public:
 
   /**
    * Saves summary table to a file. Path is relative to the
-   * ExtractsOutputDirectory.
+   * ExtractsOutputDirectory. Images still being written in the background are
+   * completed first.
    */
   bool SaveSummaryTable(const std::string& fname, vtkSMSessionProxyManager* pxm);
 
+  /**
+   * Returns the queue used by image extract writers to encode and write images
+   * in the background while the next extracts are generated.
+   */
+  vtkSMImageWriterQueue* GetImageWriterQueue() const;
+
+  /**
+   * Wait for all extracts being written in the background to be written.
+   * Returns false if any of them failed. This also happens when the controller
+   * is destroyed.
+   */
+  bool Flush();
+
   ///@{
   /**
    * Called by vtkSMExtractWriterProxy subclasses to add an entry to the summary table.
@@ -258,6 +273,7 @@ private:
   char* ExtractsOutputDirectory;
   char* EnvironmentExtractsOutputDirectory;
   vtkSmartPointer<vtkTable> SummaryTable;
+  vtkSmartPointer<vtkSMImageWriterQueue> ImageWriterQueue;
   mutable std::string LastExtractsOutputDirectory;
   mutable bool ExtractsOutputDirectoryValid;
 
@@ -0,0 +1,263 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkSMImageWriterQueue.h"
+
+#include "vtkErrorCode.h"
+#include "vtkImageData.h"
+#include "vtkImageWriter.h"
+#include "vtkLogger.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVSession.h"
+#include "vtkProcessModule.h"
+#include "vtkRemoteWriterHelper.h"
+#include "vtkSMPropertyHelper.h"
+#include "vtkSMProxy.h"
+#include "vtkSMSession.h"
+#include "vtkSMSessionProxyManager.h"
+#include "vtkSmartPointer.h"
+#include "vtkThreadedCallbackQueue.h"
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+class vtkSMImageWriterQueue::vtkInternals
+{
+public:
+  struct PendingJob
+  {
+    vtkThreadedCallbackQueue::SharedFutureBasePointer Future;
+    std::string FileName;
+
+    // set for images written using WriteImage().
+    std::string FormatKey;
+    vtkSmartPointer<vtkSMProxy> Format;
+
+    // set for jobs pushed using Push(); only read once Future is ready.
+    std::shared_ptr<bool> Status;
+  };
+
+  std::deque<PendingJob> PendingJobs;
+
+  // idle copies of format proxies, keyed by the format's XML group and name.
+  std::map<std::string, std::vector<vtkSmartPointer<vtkSMProxy>>> IdleFormats;
+
+  // last job pushed for each stream.
+  std::map<vtkObject*, vtkThreadedCallbackQueue::SharedFutureBasePointer> Streams;
+
+  bool Failed = false;
+
+  static std::string GetKey(vtkSMProxy* format)
+  {
+    return std::string(format->GetXMLGroup()) + ":" + format->GetXMLName();
+  }
+
+  bool IsPending(const std::string& fileName) const
+  {
+    for (const auto& job : this->PendingJobs)
+    {
+      if (!job.FileName.empty() && job.FileName == fileName)
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+vtkStandardNewMacro(vtkSMImageWriterQueue);
+//----------------------------------------------------------------------------
+vtkSMImageWriterQueue::vtkSMImageWriterQueue()
+  : MaximumNumberOfPendingFrames(4)
+  , Internals(new vtkSMImageWriterQueue::vtkInternals())
+{
+}
+
+//----------------------------------------------------------------------------
+vtkSMImageWriterQueue::~vtkSMImageWriterQueue()
+{
+  this->Flush();
+  delete this->Internals;
+  this->Internals = nullptr;
+}
+
+//----------------------------------------------------------------------------
+bool vtkSMImageWriterQueue::CanWriteLocally(vtkSMSession* session, vtkTypeUInt32 location)
+{
+  if (!session)
+  {
+    return false;
+  }
+  // CLIENT and DATA_SERVER_ROOT are the same process unless connected to a
+  // remote server.
+  return location == vtkPVSession::CLIENT || session->GetProcessRoles() != vtkPVSession::CLIENT;
+}
+
+//----------------------------------------------------------------------------
+bool vtkSMImageWriterQueue::WriteImage(
+  vtkSMProxy* format, vtkImageData* image, const std::string& fileName)
+{
+  auto& internals = *this->Internals;
+  if (!format || !image || fileName.empty())
+  {
+    return false;
+  }
+
+  if (!vtkImageWriter::SafeDownCast(format->GetClientSideObject()))
+  {
+    vtkErrorMacro("Format '" << format->GetXMLName() << "' is not an image writer.");
+    return false;
+  }
+
+  // two jobs must never write to the same file at the same time.
+  while (internals.IsPending(fileName))
+  {
+    this->CompleteOldest();
+  }
+  while (this->GetNumberOfPendingFrames() >= this->MaximumNumberOfPendingFrames)
+  {
+    this->CompleteOldest();
+  }
+
+  const std::string key = vtkInternals::GetKey(format);
+  auto& idle = internals.IdleFormats[key];
+  vtkSmartPointer<vtkSMProxy> copy;
+  if (idle.empty())
+  {
+    auto pxm = format->GetSessionProxyManager();
+    copy.TakeReference(pxm->NewProxy(format->GetXMLGroup(), format->GetXMLName()));
+    if (!copy)
+    {
+      vtkErrorMacro("Failed to create a copy of format '" << format->GetXMLName() << "'.");
+      return false;
+    }
+    // the copy is only ever used on this process.
+    copy->SetLocation(vtkPVSession::CLIENT);
+  }
+  else
+  {
+    copy = idle.back();
+    idle.pop_back();
+  }
+
+  copy->Copy(format);
+  vtkSMPropertyHelper(copy, "FileName").Set(fileName.c_str());
+  copy->UpdateVTKObjects();
+
+  auto writer = vtkImageWriter::SafeDownCast(copy->GetClientSideObject());
+  writer->SetInputData(image);
+
+  vtkLogF(TRACE, "Queue writing '%s'", fileName.c_str());
+  vtkInternals::PendingJob job;
+  job.Future = vtkRemoteWriterHelper::WriteInBackground(writer);
+  job.FileName = fileName;
+  job.FormatKey = key;
+  job.Format = copy;
+  internals.PendingJobs.push_back(std::move(job));
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkSMImageWriterQueue::Push(vtkObject* stream, std::function<bool()> job)
+{
+  auto& internals = *this->Internals;
+  if (!job)
+  {
+    return false;
+  }
+
+  while (this->GetNumberOfPendingFrames() >= this->MaximumNumberOfPendingFrames)
+  {
+    this->CompleteOldest();
+  }
+
+  auto status = std::make_shared<bool>(true);
+  auto worker = [job, status]() { *status = job(); };
+
+  vtkThreadedCallbackQueue* callbackQueue =
+    vtkProcessModule::GetProcessModule()->GetCallbackQueue();
+  vtkInternals::PendingJob pending;
+  pending.Status = status;
+  auto iter = stream ? internals.Streams.find(stream) : internals.Streams.end();
+  if (iter != internals.Streams.end())
+  {
+    std::vector<vtkThreadedCallbackQueue::SharedFutureBasePointer> prior{ iter->second };
+    pending.Future = callbackQueue->PushDependent(prior, worker);
+  }
+  else
+  {
+    pending.Future = callbackQueue->Push(worker);
+  }
+
+  if (stream)
+  {
+    internals.Streams[stream] = pending.Future;
+  }
+  internals.PendingJobs.push_back(std::move(pending));
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkSMImageWriterQueue::CompleteOldest()
+{
+  auto& internals = *this->Internals;
+  if (internals.PendingJobs.empty())
+  {
+    return;
+  }
+
+  auto job = std::move(internals.PendingJobs.front());
+  internals.PendingJobs.pop_front();
+  job.Future->Wait();
+
+  if (job.Format)
+  {
+    auto writer = vtkImageWriter::SafeDownCast(job.Format->GetClientSideObject());
+    const unsigned long errorCode = writer->GetErrorCode();
+    if (errorCode != vtkErrorCode::NoError)
+    {
+      vtkErrorMacro("Failed to write '" << job.FileName << "' ("
+                                        << vtkErrorCode::GetStringFromErrorCode(errorCode) << ").");
+      internals.Failed = true;
+    }
+    // release the image.
+    writer->SetInputData(nullptr);
+    internals.IdleFormats[job.FormatKey].push_back(job.Format);
+  }
+  else if (job.Status && !*job.Status)
+  {
+    vtkErrorMacro("Background write failed.");
+    internals.Failed = true;
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkSMImageWriterQueue::Flush()
+{
+  auto& internals = *this->Internals;
+  while (!internals.PendingJobs.empty())
+  {
+    this->CompleteOldest();
+  }
+  internals.Streams.clear();
+
+  const bool status = !internals.Failed;
+  internals.Failed = false;
+  return status;
+}
+
+//----------------------------------------------------------------------------
+int vtkSMImageWriterQueue::GetNumberOfPendingFrames() const
+{
+  return static_cast<int>(this->Internals->PendingJobs.size());
+}
+
+//----------------------------------------------------------------------------
+void vtkSMImageWriterQueue::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "MaximumNumberOfPendingFrames: " << this->MaximumNumberOfPendingFrames << endl;
+  os << indent << "NumberOfPendingFrames: " << this->GetNumberOfPendingFrames() << endl;
+}
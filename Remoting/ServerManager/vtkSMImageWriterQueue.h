@@ -0,0 +1,114 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class vtkSMImageWriterQueue
+ * @brief bounded queue of images being encoded and written in the background.
+ *
+ * vtkSMImageWriterQueue is used when saving a sequence of images, such as the
+ * frames of an animation or image extracts, to overlap encoding and writing
+ * of an image with the rendering of the next one. Images are written on the
+ * threads of the process module's callback queue (see
+ * vtkProcessModule::GetCallbackQueue).
+ *
+ * Since the writer of a format proxy cannot be used by more than one job at a
+ * time, each image written with WriteImage() uses its own copy of the format
+ * proxy, taken from a pool of idle copies. Writers that must receive their
+ * input in order, such as movie writers, can be driven using Push() instead.
+ *
+ * At most MaximumNumberOfPendingFrames images (or jobs) are in flight at any
+ * time; WriteImage() and Push() block until the oldest one completes when
+ * that limit is reached. This bounds the memory used by images waiting to be
+ * written. Call Flush() to wait for all pending jobs.
+ *
+ * Only images written on the local process can be queued, see
+ * CanWriteLocally().
+ *
+ * @sa vtkRemoteWriterHelper
+ */
+
+#ifndef vtkSMImageWriterQueue_h
+#define vtkSMImageWriterQueue_h
+
+#include "vtkObject.h"
+#include "vtkRemotingServerManagerModule.h" // for exports
+
+#include <functional> // for std::function
+#include <string>     // for std::string
+
+class vtkImageData;
+class vtkSMProxy;
+class vtkSMSession;
+
+class VTKREMOTINGSERVERMANAGER_EXPORT vtkSMImageWriterQueue : public vtkObject
+{
+public:
+  static vtkSMImageWriterQueue* New();
+  vtkTypeMacro(vtkSMImageWriterQueue, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /**
+   * Get/Set the maximum number of images (or jobs) being written at any time.
+   * Default is 4.
+   */
+  vtkSetClampMacro(MaximumNumberOfPendingFrames, int, 1, VTK_INT_MAX);
+  vtkGetMacro(MaximumNumberOfPendingFrames, int);
+  ///@}
+
+  /**
+   * Returns true if data to be written at `location` (one of
+   * vtkPVSession::CLIENT, vtkPVSession::DATA_SERVER or
+   * vtkPVSession::DATA_SERVER_ROOT) is written by the local process. This is
+   * the case when writing on the client, or when not connected to a remote
+   * server.
+   */
+  static bool CanWriteLocally(vtkSMSession* session, vtkTypeUInt32 location);
+
+  /**
+   * Queue `image` to be written to `fileName` using a writer configured as
+   * `format`, whose client-side object must be a vtkImageWriter. `format` is
+   * only read; it may be changed as soon as this method returns. Returns
+   * false if the image could not be queued. Errors raised while writing are
+   * reported by Flush().
+   */
+  bool WriteImage(vtkSMProxy* format, vtkImageData* image, const std::string& fileName);
+
+  /**
+   * Queue an arbitrary job. Jobs pushed with the same non-null `stream` are
+   * executed one at a time, in the order they were pushed; this is used to
+   * drive writers that must receive their input in order, such as movie
+   * writers. The job must return false on failure.
+   */
+  bool Push(vtkObject* stream, std::function<bool()> job);
+
+  /**
+   * Wait for all pending jobs to complete. Returns false if any job queued
+   * since the last call to Flush() failed.
+   */
+  bool Flush();
+
+  /**
+   * Returns the number of images (or jobs) that are queued or being written.
+   */
+  int GetNumberOfPendingFrames() const;
+
+protected:
+  vtkSMImageWriterQueue();
+  ~vtkSMImageWriterQueue() override;
+
+  int MaximumNumberOfPendingFrames;
+
+private:
+  vtkSMImageWriterQueue(const vtkSMImageWriterQueue&) = delete;
+  void operator=(const vtkSMImageWriterQueue&) = delete;
+
+  /**
+   * Wait for the oldest pending job and release the resources it used.
+   */
+  void CompleteOldest();
+
+  class vtkInternals;
+  vtkInternals* Internals;
+};
+
+#endif
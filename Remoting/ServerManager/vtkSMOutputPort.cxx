@@ -22,8 +22,15 @@
 
 #include <sstream>
 
+namespace
+{
+// Seconds before data information with estimated ranges is gathered again.
+constexpr double APPROXIMATE_INFORMATION_LIFETIME = 0.5;
+}
+
 //----------------------------------------------------------------------------
 vtkStandardNewMacro(vtkSMOutputPort);
+bool vtkSMOutputPort::EstimateRanges = false;
 
 //----------------------------------------------------------------------------
 vtkSMOutputPort::vtkSMOutputPort()
@@ -52,6 +59,16 @@ vtkSMOutputPort::~vtkSMOutputPort()
 //----------------------------------------------------------------------------
 vtkPVDataInformation* vtkSMOutputPort::GetDataInformation()
 {
+  // estimated ranges are replaced by the exact ones once they are computed.
+  if (this->DataInformationValid && this->ApproximateDataInformationTime > 0.0 &&
+    vtkTimerLog::GetUniversalTime() - this->ApproximateDataInformationTime >=
+      APPROXIMATE_INFORMATION_LIFETIME)
+  {
+    this->DataInformationValid = false;
+    this->SubsetDataInformations.clear();
+    this->RankDataInformations.clear();
+  }
+
   if (!this->DataInformationValid)
   {
     std::ostringstream mystr;
@@ -114,6 +131,7 @@ vtkPVDataInformation* vtkSMOutputPort::GetSubsetDataInformation(
   subsetInfo->SetPortNumber(this->PortIndex);
   subsetInfo->SetSubsetSelector(selector);
   subsetInfo->SetSubsetAssemblyName(assemblyName);
+  subsetInfo->SetEstimateRanges(vtkSMOutputPort::EstimateRanges);
   this->SourceProxy->GatherInformation(subsetInfo);
 
   this->SubsetDataInformations[key][nodes.front()] = subsetInfo;
@@ -221,6 +239,7 @@ vtkPVDataInformation* vtkSMOutputPort::GetRankDataInformation(int rank)
   rankInfo->Initialize();
   rankInfo->SetPortNumber(this->PortIndex);
   rankInfo->SetRank(rank);
+  rankInfo->SetEstimateRanges(vtkSMOutputPort::EstimateRanges);
   this->SourceProxy->GatherInformation(rankInfo);
   this->RankDataInformations[rank] = rankInfo;
   this->SourceProxy->GetSession()->CleanupPendingProgress();
@@ -254,6 +273,18 @@ void vtkSMOutputPort::InvalidateDataInformation()
   this->TemporalSubsetDataInformations.clear();
 }
 
+//----------------------------------------------------------------------------
+void vtkSMOutputPort::SetEstimateRanges(bool estimate)
+{
+  vtkSMOutputPort::EstimateRanges = estimate;
+}
+
+//----------------------------------------------------------------------------
+bool vtkSMOutputPort::GetEstimateRanges()
+{
+  return vtkSMOutputPort::EstimateRanges;
+}
+
 //----------------------------------------------------------------------------
 void vtkSMOutputPort::GatherDataInformation()
 {
@@ -266,8 +297,11 @@ void vtkSMOutputPort::GatherDataInformation()
   this->SourceProxy->GetSession()->PrepareProgress();
   this->DataInformation->Initialize();
   this->DataInformation->SetPortNumber(this->PortIndex);
+  this->DataInformation->SetEstimateRanges(vtkSMOutputPort::EstimateRanges);
   this->SourceProxy->GatherInformation(this->DataInformation);
   this->DataInformation->Modified();
+  this->ApproximateDataInformationTime =
+    this->DataInformation->HasApproximateRanges() ? vtkTimerLog::GetUniversalTime() : 0.0;
 
   this->DataInformationValid = true;
   this->SourceProxy->GetSession()->CleanupPendingProgress();
@@ -109,6 +109,19 @@ public:
    */
   virtual void InvalidateDataInformation();
 
+  ///@{
+  /**
+   * When set, the ranges of large arrays are estimated when gathering data
+   * information, see vtkPVDataInformation::SetEstimateRanges. Data information
+   * with estimated ranges is gathered again when requested, at most twice a
+   * second, until it reports the exact ranges computed in the background.
+   *
+   * Default is false.
+   */
+  static void SetEstimateRanges(bool estimate);
+  static bool GetEstimateRanges();
+  ///@}
+
   ///@{
   /**
    * Returns the index of the port the output is obtained from.
@@ -172,6 +185,8 @@ protected:
 
   vtkPVDataInformation* DataInformation;
   bool DataInformationValid;
+  // Time DataInformation was gathered if it has estimated ranges, 0 otherwise.
+  double ApproximateDataInformationTime = 0.0;
 
   vtkPVTemporalDataInformation* TemporalDataInformation;
   bool TemporalDataInformationValid;
@@ -192,6 +207,8 @@ private:
 
   // Update Pipeline with the given timestep request.
   void UpdatePipeline(double time);
+
+  static bool EstimateRanges;
 };
 
 #endif
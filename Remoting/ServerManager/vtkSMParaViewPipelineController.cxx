@@ -131,6 +131,8 @@ private:
   }                                                                                                \
   vtkPrepareForUnregisteringScopedObj __tmp(arg, this->Internals->ProxiesBeingUnRegistered);
 
+bool vtkSMParaViewPipelineController::CacheTimeSteps = false;
+
 vtkObjectFactoryNewMacro(vtkSMParaViewPipelineController);
 //----------------------------------------------------------------------------
 vtkSMParaViewPipelineController::vtkSMParaViewPipelineController()
@@ -154,6 +156,18 @@ std::string vtkSMParaViewPipelineController::GetHelperProxyGroupName(vtkSMProxy*
   return groupnamestr.str();
 }
 
+//----------------------------------------------------------------------------
+void vtkSMParaViewPipelineController::SetCacheTimeSteps(bool cache)
+{
+  vtkSMParaViewPipelineController::CacheTimeSteps = cache;
+}
+
+//----------------------------------------------------------------------------
+bool vtkSMParaViewPipelineController::GetCacheTimeSteps()
+{
+  return vtkSMParaViewPipelineController::CacheTimeSteps;
+}
+
 //----------------------------------------------------------------------------
 vtkSMProxy* vtkSMParaViewPipelineController::FindProxy(
   vtkSMSessionProxyManager* pxm, const char* reggroup, const char* xmlgroup, const char* xmltype)
@@ -502,6 +516,14 @@ bool vtkSMParaViewPipelineController::RegisterPipelineProxy(
   // Handle initialization helpers.
   this->ProcessInitializationHelperRegistration(proxy);
 
+  if (vtkSMParaViewPipelineController::CacheTimeSteps)
+  {
+    if (auto source = vtkSMSourceProxy::SafeDownCast(proxy))
+    {
+      source->SetCacheTimeSteps(true);
+    }
+  }
+
   // Now register the proxy itself.
   // If proxyname is nullptr, the proxy manager makes up a name.
   if (proxyname == nullptr || proxyname[0] == 0)
@@ -593,6 +615,14 @@ bool vtkSMParaViewPipelineController::RegisterViewProxy(vtkSMProxy* proxy, const
   // Handle initialization helpers.
   this->ProcessInitializationHelperRegistration(proxy);
 
+  if (vtkSMParaViewPipelineController::CacheTimeSteps)
+  {
+    if (auto source = vtkSMSourceProxy::SafeDownCast(proxy))
+    {
+      source->SetCacheTimeSteps(true);
+    }
+  }
+
   // Now register the proxy itself.
   if (proxyname == nullptr || proxyname[0] == 0)
   {
@@ -306,6 +306,16 @@ public:
    */
   static std::string GetHelperProxyGroupName(vtkSMProxy*);
 
+  ///@{
+  /**
+   * When enabled, RegisterPipelineProxy() enables caching the outputs of each
+   * time step on the source proxies it registers. Default is false.
+   * @sa vtkSMSourceProxy::SetCacheTimeSteps
+   */
+  static void SetCacheTimeSteps(bool);
+  static bool GetCacheTimeSteps();
+  ///@}
+
 protected:
   vtkSMParaViewPipelineController();
   ~vtkSMParaViewPipelineController() override;
@@ -371,6 +381,8 @@ private:
 
   class vtkInternals;
   vtkInternals* Internals;
+
+  static bool CacheTimeSteps;
 };
 
 #endif
@@ -132,6 +132,19 @@ public:
    */
   void PushState(vtkSMMessage* msg) override;
 
+  ///@{
+  /**
+   * Group the state pushed to remote processes. Between StartPushBatch() and
+   * the matching EndPushBatch(), sessions connected to remote servers may hold
+   * on to pushed messages and send them together when the outermost batch
+   * ends, or earlier when a request that is processed remotely needs them to
+   * have been applied. Calls can be nested. Default implementation does
+   * nothing since there are no remote processes.
+   */
+  virtual void StartPushBatch() {}
+  virtual void EndPushBatch() {}
+  ///@}
+
   /**
    * Sends the message to all clients.
    */
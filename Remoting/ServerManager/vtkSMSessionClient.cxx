@@ -28,15 +28,22 @@
 #include "vtkSMServerStateLocator.h"
 #include "vtkSMSessionProxyManager.h"
 #include "vtkSMSettings.h"
+#include "vtkSmartPointer.h"
 #include "vtkSocketCommunicator.h"
 #include "vtkTimerLog.h"
 
 #include <sstream>
 #include <string>
 #include <vtksys/RegularExpression.hxx>
+#include <vtksys/SystemTools.hxx>
 
+#include <algorithm>
 #include <cassert>
+#include <cstdlib>
+#include <functional>
+#include <map>
 #include <set>
+#include <vector>
 
 //****************************************************************************/
 //                    Internal Classes and typedefs
@@ -50,6 +57,188 @@ void RMICallback(
   self->OnServerNotificationMessageRMI(remoteArg, remoteArgLength);
 }
 };
+
+//****************************************************************************/
+class vtkSMSessionClient::vtkChannel
+{
+public:
+  struct vtkCounters
+  {
+    vtkTypeInt64 Count = 0;
+    vtkTypeInt64 BytesSent = 0;
+    vtkTypeInt64 BytesReceived = 0;
+    vtkTypeInt64 UncompressedBytesSent = 0;
+    vtkTypeInt64 UncompressedBytesReceived = 0;
+    double Latency = 0.0;
+  };
+
+  // counts a message and the time spent sending it and waiting for its reply.
+  class vtkRecord
+  {
+  public:
+    vtkRecord(vtkChannel* channel, int type)
+      : Counters(channel->Counters[type])
+      , StartTime(vtkTimerLog::GetUniversalTime())
+    {
+      this->Counters.Count++;
+    }
+    ~vtkRecord() { this->Counters.Latency += vtkTimerLog::GetUniversalTime() - this->StartTime; }
+
+    vtkCounters& Counters;
+
+  private:
+    double StartTime;
+  };
+
+  // payloads at least this large are compressed, 0 disables compression.
+  int CompressionThreshold = 0;
+
+  // threshold last sent to the servers, used to compress their replies.
+  int ReplyCompressionThreshold = 0;
+
+  std::map<int, vtkCounters> Counters;
+
+  bool Compress(const unsigned char* data, size_t size, std::vector<unsigned char>& compressed)
+  {
+    return this->CompressionThreshold > 0 &&
+      size >= static_cast<size_t>(this->CompressionThreshold) &&
+      vtkPVSessionServer::CompressPayload(data, size, compressed);
+  }
+
+  void Trigger(vtkMultiProcessController* controller, vtkMultiProcessStream& stream,
+    vtkCounters& counters)
+  {
+    std::vector<unsigned char> raw_message;
+    stream.GetRawData(raw_message);
+    counters.UncompressedBytesSent += static_cast<vtkTypeInt64>(raw_message.size());
+
+    std::vector<unsigned char> compressed;
+    if (this->Compress(raw_message.data(), raw_message.size(), compressed))
+    {
+      vtkMultiProcessStream wrapper;
+      wrapper << static_cast<int>(vtkPVSessionServer::COMPRESSED);
+      wrapper.Push(compressed.data(), static_cast<unsigned int>(compressed.size()));
+      wrapper.GetRawData(raw_message);
+    }
+    counters.BytesSent += static_cast<vtkTypeInt64>(raw_message.size());
+    controller->TriggerRMIOnAllChildren(&raw_message[0], static_cast<int>(raw_message.size()),
+      vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+  }
+
+  // receives the data of a reply sent by vtkPVSessionServer::SendPayloadToClient()
+  // given its size, which is negated when the data is compressed.
+  bool Receive(vtkMultiProcessController* controller, int size, int tag,
+    std::vector<unsigned char>& payload, vtkCounters& counters)
+  {
+    const int length = size < 0 ? -size : size;
+    std::vector<unsigned char> buffer(static_cast<size_t>(length) + 1);
+    if (!controller->Receive(buffer.data(), length, 1, tag))
+    {
+      return false;
+    }
+    buffer.resize(static_cast<size_t>(length));
+    counters.BytesReceived += static_cast<vtkTypeInt64>(sizeof(int) + buffer.size());
+    if (size >= 0)
+    {
+      payload.swap(buffer);
+    }
+    else if (!vtkPVSessionServer::UncompressPayload(buffer.data(), buffer.size(), payload))
+    {
+      return false;
+    }
+    counters.UncompressedBytesReceived += static_cast<vtkTypeInt64>(sizeof(int) + payload.size());
+    return true;
+  }
+};
+
+//****************************************************************************/
+class vtkSMSessionClient::vtkPushBatch
+{
+public:
+  // serialized messages are sent once this many bytes are pending.
+  static constexpr size_t MaximumSize = 4 * 1024 * 1024;
+
+  vtkPushBatch(vtkChannel* channel)
+    : Channel(channel)
+  {
+  }
+
+  int Depth = 0;
+  size_t Size = 0;
+
+  // when positive, messages sent outside of a batch are held for up to this
+  // many seconds, measured from the first pending message.
+  double CoalescingWindow = 0.0;
+  double WindowStartTime = 0.0;
+
+  // complete messages waiting to be sent to each server, in request order.
+  std::map<vtkMultiProcessController*, std::vector<std::vector<unsigned char>>> Messages;
+
+  // called when a message is held by the coalescing window while none was.
+  std::function<void()> WindowOpened;
+
+  // true when messages that do not expect a reply are held instead of sent.
+  bool IsHolding() const { return this->Depth > 0 || this->CoalescingWindow > 0.0; }
+
+  // sends, or holds, a message made of its type and a serialized vtkSMMessage.
+  void Send(vtkMultiProcessController* controller, int type, const std::string& message)
+  {
+    vtkMultiProcessStream stream;
+    stream << type << message;
+    if (!this->IsHolding())
+    {
+      vtkChannel::vtkRecord record(this->Channel, type);
+      this->Channel->Trigger(controller, stream, record.Counters);
+      return;
+    }
+    this->Hold(controller, stream);
+  }
+
+  void Hold(vtkMultiProcessController* controller, vtkMultiProcessStream& stream)
+  {
+    const double now = vtkTimerLog::GetUniversalTime();
+    const bool opened = this->Messages.empty();
+    if (opened)
+    {
+      this->WindowStartTime = now;
+    }
+    std::vector<unsigned char> raw_message;
+    stream.GetRawData(raw_message);
+    this->Size += raw_message.size();
+    this->Messages[controller].push_back(std::move(raw_message));
+    if (this->Size >= vtkPushBatch::MaximumSize ||
+      (this->Depth == 0 && now - this->WindowStartTime >= this->CoalescingWindow))
+    {
+      this->Flush();
+    }
+    else if (opened && this->Depth == 0 && this->WindowOpened)
+    {
+      this->WindowOpened();
+    }
+  }
+
+  void Flush()
+  {
+    for (auto& pending : this->Messages)
+    {
+      vtkChannel::vtkRecord record(this->Channel, vtkPVSessionServer::PUSH_BATCH);
+      vtkMultiProcessStream stream;
+      stream << static_cast<int>(vtkPVSessionServer::PUSH_BATCH)
+             << static_cast<int>(pending.second.size());
+      for (auto& message : pending.second)
+      {
+        stream.Push(message.data(), static_cast<unsigned int>(message.size()));
+      }
+      this->Channel->Trigger(pending.first, stream, record.Counters);
+    }
+    this->Messages.clear();
+    this->Size = 0;
+  }
+
+private:
+  vtkChannel* Channel;
+};
+
 //****************************************************************************/
 vtkStandardNewMacro(vtkSMSessionClient);
 vtkCxxSetObjectMacro(vtkSMSessionClient, RenderServerController, vtkMultiProcessController);
@@ -81,6 +270,22 @@ vtkSMSessionClient::vtkSMSessionClient()
   // Default value
   this->NoMoreDelete = false;
   this->NotBusy = 0;
+  this->Channel = new vtkChannel();
+  this->PushBatch = new vtkPushBatch(this->Channel);
+  this->PushBatch->WindowOpened = [this]() {
+    double window = this->PushBatch->CoalescingWindow;
+    this->InvokeEvent(vtkSMSessionClient::CoalescingWindowOpenedEvent, &window);
+  };
+
+  std::string value;
+  if (vtksys::SystemTools::GetEnv("PARAVIEW_CHANNEL_COMPRESSION_THRESHOLD", value))
+  {
+    this->Channel->CompressionThreshold = std::max(0, std::atoi(value.c_str()));
+  }
+  if (vtksys::SystemTools::GetEnv("PARAVIEW_CHANNEL_COALESCING_WINDOW", value))
+  {
+    this->PushBatch->CoalescingWindow = std::max(0.0, std::atof(value.c_str()));
+  }
 }
 
 //----------------------------------------------------------------------------
@@ -109,6 +314,10 @@ vtkSMSessionClient::~vtkSMSessionClient()
 
   delete this->ServerLastInvokeResult;
   this->ServerLastInvokeResult = nullptr;
+  delete this->PushBatch;
+  this->PushBatch = nullptr;
+  delete this->Channel;
+  this->Channel = nullptr;
 }
 
 //----------------------------------------------------------------------------
@@ -406,6 +615,222 @@ void vtkSMSessionClient::Initialize()
     this->SetupDataServerRenderServerConnection();
   }
   this->ProgressHandler->AddHandlers();
+  if (this->Channel->CompressionThreshold > 0)
+  {
+    this->SendChannelOptions();
+  }
+
+  std::string streams;
+  if (vtksys::SystemTools::GetEnv("PARAVIEW_DELIVERY_STREAMS", streams))
+  {
+    this->SetupStripedDeliveryConnection(std::atoi(streams.c_str()));
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkSMSessionClient::SetupStripedDeliveryConnection(int numberOfStreams)
+{
+  numberOfStreams = std::min(numberOfStreams, this->GetNumberOfProcesses(DATA_SERVER));
+  if (this->DataServerController == nullptr || numberOfStreams < 2)
+  {
+    return false;
+  }
+  if (this->GetStripedDeliveryConnection() != nullptr)
+  {
+    vtkErrorMacro("Striped delivery connection already setup.");
+    return false;
+  }
+
+  vtkSMSessionProxyManager* pxm =
+    vtkSMProxyManager::GetProxyManager()->GetSessionProxyManager(this);
+  vtkSmartPointer<vtkSMProxy> connection;
+  connection.TakeReference(pxm->NewProxy("internals", "StripedDeliveryConnection"));
+  if (!connection)
+  {
+    return false;
+  }
+
+  // only the first data-server processes wait for the client to connect.
+  vtkSMPropertyHelper(connection, "NumberOfConnections").Set(numberOfStreams);
+  connection->UpdateVTKObjects();
+  vtkSMPropertyHelper(connection, "WaitingProcess")
+    .Set(this->RenderServerController ? vtkProcessModule::PROCESS_DATA_SERVER
+                                      : vtkProcessModule::PROCESS_SERVER);
+  connection->UpdateVTKObjects();
+
+  vtkNew<vtkMPIMToNSocketConnectionPortInformation> info;
+  this->GatherInformation(DATA_SERVER, info, connection->GetGlobalID());
+  if (info->GetNumberOfConnections() < numberOfStreams)
+  {
+    vtkErrorMacro("Failed to get the ports for striped delivery.");
+    return false;
+  }
+
+  vtkSMPropertyHelper helper(connection, "Connections");
+  for (int cc = 0; cc < numberOfStreams; cc++)
+  {
+    std::ostringstream processNo;
+    processNo << cc;
+    std::ostringstream str;
+    str << info->GetProcessPort(cc);
+    helper.Set(3 * cc, processNo.str().c_str());
+    helper.Set(3 * cc + 1, str.str().c_str());
+    helper.Set(3 * cc + 2, info->GetProcessHostName(cc));
+  }
+  connection->UpdateVTKObjects();
+
+  // the data-server processes wait for the connections while the client
+  // connects to each of them.
+  vtkClientServerStream stream;
+  stream << vtkClientServerStream::Invoke << vtkClientServerID(1) // ID for vtkSMSessionCore helper.
+         << "SetStripedDeliveryConnection" << VTKOBJECT(connection)
+         << vtkClientServerStream::End;
+  this->ExecuteStream(vtkPVSession::CLIENT | vtkPVSession::DATA_SERVER, stream);
+  return this->GetStripedDeliveryConnection() != nullptr;
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSessionClient::SendChannelOptions()
+{
+  vtkMultiProcessController* controllers[2] = { this->DataServerController,
+    this->RenderServerController };
+  for (int cc = 0; cc < 2; cc++)
+  {
+    if (controllers[cc] != nullptr && (cc == 0 || controllers[1] != controllers[0]))
+    {
+      vtkChannel::vtkRecord record(this->Channel, vtkPVSessionServer::CHANNEL_OPTIONS);
+      vtkMultiProcessStream stream;
+      stream << static_cast<int>(vtkPVSessionServer::CHANNEL_OPTIONS)
+             << this->Channel->CompressionThreshold;
+      this->Channel->Trigger(controllers[cc], stream, record.Counters);
+    }
+  }
+  this->Channel->ReplyCompressionThreshold = this->Channel->CompressionThreshold;
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSessionClient::SetCompressionThreshold(int threshold)
+{
+  threshold = std::max(0, threshold);
+  if (this->Channel->CompressionThreshold != threshold)
+  {
+    this->Channel->CompressionThreshold = threshold;
+    if (this->DataServerController)
+    {
+      this->PushBatch->Flush();
+      this->SendChannelOptions();
+    }
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+int vtkSMSessionClient::GetCompressionThreshold()
+{
+  return this->Channel->CompressionThreshold;
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSessionClient::SetCoalescingWindow(double seconds)
+{
+  seconds = std::max(0.0, seconds);
+  if (this->PushBatch->CoalescingWindow != seconds)
+  {
+    this->PushBatch->CoalescingWindow = seconds;
+    if (this->PushBatch->Depth == 0)
+    {
+      this->PushBatch->Flush();
+    }
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+double vtkSMSessionClient::GetCoalescingWindow()
+{
+  return this->PushBatch->CoalescingWindow;
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSessionClient::FlushMessages()
+{
+  this->PushBatch->Flush();
+}
+
+//----------------------------------------------------------------------------
+vtkTypeInt64 vtkSMSessionClient::GetNumberOfMessages(int type)
+{
+  auto iter = this->Channel->Counters.find(type);
+  return iter != this->Channel->Counters.end() ? iter->second.Count : 0;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeInt64 vtkSMSessionClient::GetBytesSent(int type)
+{
+  auto iter = this->Channel->Counters.find(type);
+  return iter != this->Channel->Counters.end() ? iter->second.BytesSent : 0;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeInt64 vtkSMSessionClient::GetBytesReceived(int type)
+{
+  auto iter = this->Channel->Counters.find(type);
+  return iter != this->Channel->Counters.end() ? iter->second.BytesReceived : 0;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeInt64 vtkSMSessionClient::GetUncompressedBytesSent(int type)
+{
+  auto iter = this->Channel->Counters.find(type);
+  return iter != this->Channel->Counters.end() ? iter->second.UncompressedBytesSent : 0;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeInt64 vtkSMSessionClient::GetUncompressedBytesReceived(int type)
+{
+  auto iter = this->Channel->Counters.find(type);
+  return iter != this->Channel->Counters.end() ? iter->second.UncompressedBytesReceived : 0;
+}
+
+//----------------------------------------------------------------------------
+double vtkSMSessionClient::GetTotalLatency(int type)
+{
+  auto iter = this->Channel->Counters.find(type);
+  return iter != this->Channel->Counters.end() ? iter->second.Latency : 0.0;
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSessionClient::ResetMessageStatistics()
+{
+  this->Channel->Counters.clear();
+}
+
+//----------------------------------------------------------------------------
+const char* vtkSMSessionClient::GetMessageTypeName(int type)
+{
+  switch (type)
+  {
+    case vtkPVSessionServer::PUSH:
+      return "Push";
+    case vtkPVSessionServer::PULL:
+      return "Pull";
+    case vtkPVSessionServer::EXECUTE_STREAM:
+      return "ExecuteStream";
+    case vtkPVSessionServer::GATHER_INFORMATION:
+      return "GatherInformation";
+    case vtkPVSessionServer::REGISTER_SI:
+      return "RegisterSI";
+    case vtkPVSessionServer::UNREGISTER_SI:
+      return "UnRegisterSI";
+    case vtkPVSessionServer::LAST_RESULT:
+      return "LastResult";
+    case vtkPVSessionServer::PUSH_BATCH:
+      return "PushBatch";
+    case vtkPVSessionServer::CHANNEL_OPTIONS:
+      return "ChannelOptions";
+    default:
+      return "Unknown";
+  }
 }
 
 //----------------------------------------------------------------------------
@@ -522,6 +947,7 @@ bool vtkSMSessionClient::IsMPIInitialized(vtkTypeUInt32 servers)
 //----------------------------------------------------------------------------
 void vtkSMSessionClient::CloseSession()
 {
+  this->PushBatch->Flush();
   if (this->DataServerController)
   {
     this->DataServerController->TriggerRMIOnAllChildren(vtkPVSessionServer::CLOSE_SESSION);
@@ -587,15 +1013,10 @@ void vtkSMSessionClient::PushState(vtkSMMessage* message)
   }
   if (num_controllers > 0)
   {
-    vtkMultiProcessStream stream;
-    stream << static_cast<int>(vtkPVSessionServer::PUSH);
-    stream << message->SerializeAsString();
-    std::vector<unsigned char> raw_message;
-    stream.GetRawData(raw_message);
+    const std::string serialized = message->SerializeAsString();
     for (int cc = 0; cc < num_controllers; cc++)
     {
-      controllers[cc]->TriggerRMIOnAllChildren(&raw_message[0],
-        static_cast<int>(raw_message.size()), vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+      this->PushBatch->Send(controllers[cc], vtkPVSessionServer::PUSH, serialized);
     }
   }
 
@@ -627,13 +1048,8 @@ void vtkSMSessionClient::PushState(vtkSMMessage* message)
         msg.set_share_only(true);
         msg.set_client_id(this->ServerInformation->GetClientId());
 
-        vtkMultiProcessStream stream;
-        stream << static_cast<int>(vtkPVSessionServer::PUSH);
-        stream << msg.SerializeAsString();
-        std::vector<unsigned char> raw_message;
-        stream.GetRawData(raw_message);
-        this->DataServerController->TriggerRMIOnAllChildren(&raw_message[0],
-          static_cast<int>(raw_message.size()), vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+        this->PushBatch->Send(
+          this->DataServerController, vtkPVSessionServer::PUSH, msg.SerializeAsString());
       }
       else if (!remoteObject)
       {
@@ -655,9 +1071,25 @@ void vtkSMSessionClient::PushState(vtkSMMessage* message)
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkSMSessionClient::StartPushBatch()
+{
+  this->PushBatch->Depth++;
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSessionClient::EndPushBatch()
+{
+  if (this->PushBatch->Depth > 0 && --this->PushBatch->Depth == 0)
+  {
+    this->PushBatch->Flush();
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkSMSessionClient::PullState(vtkSMMessage* message)
 {
+  this->PushBatch->Flush();
   this->StartBusyWork();
   vtkTypeUInt32 location = this->GetRealLocation(message->location());
   message->set_location(location);
@@ -681,19 +1113,43 @@ void vtkSMSessionClient::PullState(vtkSMMessage* message)
 
   if (controller)
   {
+    vtkChannel::vtkRecord record(this->Channel, vtkPVSessionServer::PULL);
     vtkMultiProcessStream stream;
     stream << static_cast<int>(vtkPVSessionServer::PULL);
     stream << message->SerializeAsString();
-    std::vector<unsigned char> raw_message;
-    stream.GetRawData(raw_message);
-    controller->TriggerRMIOnAllChildren(&raw_message[0], static_cast<int>(raw_message.size()),
-      vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+    this->Channel->Trigger(controller, stream, record.Counters);
 
     // Get the reply
     vtkMultiProcessStream replyStream;
     controller->Receive(replyStream, 1, vtkPVSessionServer::REPLY_PULL);
+    record.Counters.BytesReceived += replyStream.RawSize();
+    int compressed = 0;
+    if (this->Channel->ReplyCompressionThreshold > 0)
+    {
+      replyStream >> compressed;
+    }
     std::string string;
-    replyStream >> string;
+    if (compressed)
+    {
+      unsigned char* data = nullptr;
+      unsigned int size = 0;
+      replyStream.Pop(data, size);
+      std::vector<unsigned char> payload;
+      if (vtkPVSessionServer::UncompressPayload(data, size, payload))
+      {
+        string.assign(payload.begin(), payload.end());
+      }
+      else
+      {
+        vtkErrorMacro("Failed to uncompress the state received from the server.");
+      }
+      delete[] data;
+    }
+    else
+    {
+      replyStream >> string;
+    }
+    record.Counters.UncompressedBytesReceived += static_cast<vtkTypeInt64>(string.size());
     message->ParseFromString(string);
   }
   else
@@ -727,24 +1183,51 @@ void vtkSMSessionClient::ExecuteStream(
     controllers[num_controllers++] = this->RenderServerController;
   }
 
-  if (num_controllers > 0)
+  // streams also executed on the client are sent right away since the client
+  // may wait for the servers, e.g. to connect to them.
+  if (num_controllers > 0 && this->PushBatch->IsHolding() &&
+    (location & vtkPVSession::CLIENT) == 0)
+  {
+    // held streams carry their data, the whole batch is compressed when sent.
+    const unsigned char* data;
+    size_t size;
+    cssstream.GetData(&data, &size);
+    for (int cc = 0; cc < num_controllers; cc++)
+    {
+      vtkMultiProcessStream stream;
+      stream << static_cast<int>(vtkPVSessionServer::EXECUTE_STREAM)
+             << static_cast<int>(ignore_errors);
+      stream.Push(data, static_cast<unsigned int>(size));
+      this->PushBatch->Hold(controllers[cc], stream);
+    }
+  }
+  else if (num_controllers > 0)
   {
+    this->PushBatch->Flush();
     const unsigned char* data;
     size_t size;
     cssstream.GetData(&data, &size);
 
+    // a negative size lets the server know that the stream is compressed.
+    int length = static_cast<int>(size);
+    std::vector<unsigned char> compressed;
+    if (this->Channel->Compress(data, size, compressed))
+    {
+      data = compressed.data();
+      length = static_cast<int>(compressed.size());
+    }
+
     vtkMultiProcessStream stream;
     stream << static_cast<int>(vtkPVSessionServer::EXECUTE_STREAM)
-           << static_cast<int>(ignore_errors) << static_cast<int>(size);
-    std::vector<unsigned char> raw_message;
-    stream.GetRawData(raw_message);
+           << static_cast<int>(ignore_errors) << (compressed.empty() ? length : -length);
 
     for (int cc = 0; cc < num_controllers; cc++)
     {
-      controllers[cc]->TriggerRMIOnAllChildren(&raw_message[0],
-        static_cast<int>(raw_message.size()), vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
-      controllers[cc]->Send(
-        data, static_cast<int>(size), 1, vtkPVSessionServer::EXECUTE_STREAM_TAG);
+      vtkChannel::vtkRecord record(this->Channel, vtkPVSessionServer::EXECUTE_STREAM);
+      this->Channel->Trigger(controllers[cc], stream, record.Counters);
+      controllers[cc]->Send(data, length, 1, vtkPVSessionServer::EXECUTE_STREAM_TAG);
+      record.Counters.BytesSent += length;
+      record.Counters.UncompressedBytesSent += static_cast<vtkTypeInt64>(size);
     }
   }
 
@@ -757,6 +1240,7 @@ void vtkSMSessionClient::ExecuteStream(
 //----------------------------------------------------------------------------
 const vtkClientServerStream& vtkSMSessionClient::GetLastResult(vtkTypeUInt32 location)
 {
+  this->PushBatch->Flush();
   this->StartBusyWork();
   location = this->GetRealLocation(location);
 
@@ -779,20 +1263,24 @@ const vtkClientServerStream& vtkSMSessionClient::GetLastResult(vtkTypeUInt32 loc
   {
     this->ServerLastInvokeResult->Reset();
 
+    vtkChannel::vtkRecord record(this->Channel, vtkPVSessionServer::LAST_RESULT);
     vtkMultiProcessStream stream;
     stream << static_cast<int>(vtkPVSessionServer::LAST_RESULT);
-    std::vector<unsigned char> raw_message;
-    stream.GetRawData(raw_message);
-    controller->TriggerRMIOnAllChildren(&raw_message[0], static_cast<int>(raw_message.size()),
-      vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+    this->Channel->Trigger(controller, stream, record.Counters);
 
     // Get the reply
     int size = 0;
     controller->Receive(&size, 1, 1, vtkPVSessionServer::REPLY_LAST_RESULT);
-    unsigned char* raw_data = new unsigned char[size + 1];
-    controller->Receive(raw_data, size, 1, vtkPVSessionServer::REPLY_LAST_RESULT);
-    this->ServerLastInvokeResult->SetData(raw_data, size);
-    delete[] raw_data;
+    std::vector<unsigned char> payload;
+    if (this->Channel->Receive(
+          controller, size, vtkPVSessionServer::REPLY_LAST_RESULT, payload, record.Counters))
+    {
+      this->ServerLastInvokeResult->SetData(payload.data(), payload.size());
+    }
+    else
+    {
+      vtkErrorMacro("Failed to receive the last result correctly.");
+    }
     this->EndBusyWork();
     return *this->ServerLastInvokeResult;
   }
@@ -805,6 +1293,7 @@ const vtkClientServerStream& vtkSMSessionClient::GetLastResult(vtkTypeUInt32 loc
 bool vtkSMSessionClient::GatherInformation(
   vtkTypeUInt32 location, vtkPVInformation* information, vtkTypeUInt32 globalid)
 {
+  this->PushBatch->Flush();
   this->StartBusyWork();
   if (this->RenderServerController == nullptr)
   {
@@ -833,13 +1322,6 @@ bool vtkSMSessionClient::GatherInformation(
     add_local_info = true;
   }
 
-  vtkMultiProcessStream stream;
-  stream << static_cast<int>(vtkPVSessionServer::GATHER_INFORMATION) << location
-         << information->GetClassName() << globalid;
-  information->CopyParametersToStream(stream);
-  std::vector<unsigned char> raw_message;
-  stream.GetRawData(raw_message);
-
   vtkMultiProcessController* controller = nullptr;
 
   if ((location & vtkPVSession::DATA_SERVER) != 0 ||
@@ -857,28 +1339,31 @@ bool vtkSMSessionClient::GatherInformation(
 
   if (controller)
   {
-    controller->TriggerRMIOnAllChildren(&raw_message[0], static_cast<int>(raw_message.size()),
-      vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+    vtkChannel::vtkRecord record(this->Channel, vtkPVSessionServer::GATHER_INFORMATION);
+    vtkMultiProcessStream stream;
+    stream << static_cast<int>(vtkPVSessionServer::GATHER_INFORMATION) << location
+           << information->GetClassName() << globalid;
+    information->CopyParametersToStream(stream);
+    this->Channel->Trigger(controller, stream, record.Counters);
 
     int length2 = 0;
     controller->Receive(&length2, 1, 1, vtkPVSessionServer::REPLY_GATHER_INFORMATION_TAG);
-    if (length2 <= 0)
+    if (length2 == 0)
     {
       vtkErrorMacro("Server failed to gather information.");
       this->EndBusyWork();
       return false;
     }
-    unsigned char* data2 = new unsigned char[length2];
-    if (!controller->Receive(
-          (char*)data2, length2, 1, vtkPVSessionServer::REPLY_GATHER_INFORMATION_TAG))
+    std::vector<unsigned char> data2;
+    if (!this->Channel->Receive(controller, length2,
+          vtkPVSessionServer::REPLY_GATHER_INFORMATION_TAG, data2, record.Counters))
     {
       vtkErrorMacro("Failed to receive information correctly.");
-      delete[] data2;
       this->EndBusyWork();
       return false;
     }
     vtkClientServerStream csstream;
-    csstream.SetData(data2, length2);
+    csstream.SetData(data2.data(), data2.size());
     if (add_local_info)
     {
       vtkPVInformation* tempInfo = information->NewInstance();
@@ -890,7 +1375,6 @@ bool vtkSMSessionClient::GatherInformation(
     {
       information->CopyFromStream(&csstream);
     }
-    delete[] data2;
   }
   this->EndBusyWork();
   return false;
@@ -920,15 +1404,10 @@ void vtkSMSessionClient::UnRegisterSIObject(vtkSMMessage* message)
   }
   if (num_controllers > 0)
   {
-    vtkMultiProcessStream stream;
-    stream << static_cast<int>(vtkPVSessionServer::UNREGISTER_SI);
-    stream << message->SerializeAsString();
-    std::vector<unsigned char> raw_message;
-    stream.GetRawData(raw_message);
+    const std::string serialized = message->SerializeAsString();
     for (int cc = 0; cc < num_controllers; cc++)
     {
-      controllers[cc]->TriggerRMIOnAllChildren(&raw_message[0],
-        static_cast<int>(raw_message.size()), vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+      this->PushBatch->Send(controllers[cc], vtkPVSessionServer::UNREGISTER_SI, serialized);
     }
   }
 
@@ -961,17 +1440,12 @@ void vtkSMSessionClient::RegisterSIObject(vtkSMMessage* message)
   }
   if (num_controllers > 0)
   {
-    vtkMultiProcessStream stream;
-    stream << static_cast<int>(vtkPVSessionServer::REGISTER_SI);
-    stream << message->SerializeAsString();
-    std::vector<unsigned char> raw_message;
-    stream.GetRawData(raw_message);
+    const std::string serialized = message->SerializeAsString();
     for (int cc = 0; cc < num_controllers; cc++)
     {
       if (controllers[cc] != nullptr)
       {
-        controllers[cc]->TriggerRMIOnAllChildren(&raw_message[0],
-          static_cast<int>(raw_message.size()), vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+        this->PushBatch->Send(controllers[cc], vtkPVSessionServer::REGISTER_SI, serialized);
       }
     }
   }
@@ -986,6 +1460,17 @@ void vtkSMSessionClient::RegisterSIObject(vtkSMMessage* message)
 void vtkSMSessionClient::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "CompressionThreshold: " << this->Channel->CompressionThreshold << endl;
+  os << indent << "CoalescingWindow: " << this->PushBatch->CoalescingWindow << endl;
+  os << indent << "MessageStatistics:" << endl;
+  for (const auto& item : this->Channel->Counters)
+  {
+    const auto& counters = item.second;
+    os << indent.GetNextIndent() << vtkSMSessionClient::GetMessageTypeName(item.first)
+       << ": count=" << counters.Count << " sent=" << counters.BytesSent << "/"
+       << counters.UncompressedBytesSent << " received=" << counters.BytesReceived << "/"
+       << counters.UncompressedBytesReceived << " latency=" << counters.Latency << "s" << endl;
+  }
 }
 //----------------------------------------------------------------------------
 vtkTypeUInt32 vtkSMSessionClient::GetNextGlobalUniqueIdentifier()
@@ -108,6 +108,84 @@ public:
   const vtkClientServerStream& GetLastResult(vtkTypeUInt32 location) override;
   ///@}
 
+  ///@{
+  /**
+   * Overridden to hold on to the messages that do not expect a reply, i.e.
+   * the state pushed to the server(s), the streams executed on the server(s)
+   * only and the server side objects registered or unregistered, and send
+   * them in request order as a single message per server when the outermost
+   * batch ends. Pending messages are also sent before any request that
+   * expects a reply, or that also runs on the client, so that such requests
+   * always see the messages sent before them.
+   */
+  void StartPushBatch() override;
+  void EndPushBatch() override;
+  ///@}
+
+  ///@{
+  /**
+   * Messages to the server(s), and the replies from the server(s), with a
+   * payload of at least this many bytes are compressed with LZ4. 0 disables
+   * compression. Default is 0, or the value of the
+   * `PARAVIEW_CHANNEL_COMPRESSION_THRESHOLD` environment variable.
+   */
+  void SetCompressionThreshold(int bytes);
+  int GetCompressionThreshold();
+  ///@}
+
+  ///@{
+  /**
+   * When positive, the messages sent to the server(s) outside of a push batch
+   * that do not expect a reply are held for up to this many seconds and sent
+   * as a single message per server, as in a push batch. Pending messages are
+   * sent with the first message held after the window has elapsed, before any
+   * request that expects a reply, or when FlushMessages() is called. Since
+   * nothing is sent while the client is idle, CoalescingWindowOpenedEvent is
+   * invoked when the window opens so that applications can call
+   * FlushMessages() once it has elapsed, as pqServer does. Default is 0, or
+   * the value of the `PARAVIEW_CHANNEL_COALESCING_WINDOW` environment variable.
+   */
+  void SetCoalescingWindow(double seconds);
+  double GetCoalescingWindow();
+  ///@}
+
+  /**
+   * Invoked when a message is held by the coalescing window while none was
+   * pending. The call data is the window duration in seconds, a double.
+   */
+  enum
+  {
+    CoalescingWindowOpenedEvent = 6790
+  };
+
+  /**
+   * Sends the state held in a push batch or in the coalescing window to the
+   * server(s) now.
+   */
+  void FlushMessages();
+
+  ///@{
+  /**
+   * Statistics about the messages sent to the server(s), per message type
+   * e.g. vtkPVSessionServer::PUSH or vtkPVSessionServer::GATHER_INFORMATION.
+   * Bytes are counted as sent/received on the socket and before compression
+   * (resp. after uncompression). The latency is the total time, in seconds,
+   * spent sending the messages and waiting for their replies.
+   */
+  vtkTypeInt64 GetNumberOfMessages(int type);
+  vtkTypeInt64 GetBytesSent(int type);
+  vtkTypeInt64 GetBytesReceived(int type);
+  vtkTypeInt64 GetUncompressedBytesSent(int type);
+  vtkTypeInt64 GetUncompressedBytesReceived(int type);
+  double GetTotalLatency(int type);
+  void ResetMessageStatistics();
+  ///@}
+
+  /**
+   * Returns a human readable name for a message type.
+   */
+  static const char* GetMessageTypeName(int type);
+
   ///@{
   /**
    * When Connect() is waiting for a server to connect back to the client (in
@@ -118,6 +196,17 @@ public:
   vtkSetMacro(AbortConnect, bool);
   ///@}
 
+  /**
+   * Connects the first `numberOfStreams` data-server processes directly to the
+   * client so that data delivered to the client is streamed by these
+   * processes concurrently, over one socket each, instead of being gathered
+   * on and sent by the root (see vtkMPIMoveData). The data-server processes
+   * must be reachable from the client. This is done when the session is
+   * initialized if the `PARAVIEW_DELIVERY_STREAMS` environment variable is
+   * set. Returns true on success. This can only be done once per session.
+   */
+  bool SetupStripedDeliveryConnection(int numberOfStreams);
+
   /**
    * Gracefully exits the session.
    */
@@ -280,6 +369,17 @@ private:
   int NotBusy;
   vtkTypeUInt32 LastGlobalID;
   vtkTypeUInt32 LastGlobalIDAvailable;
+
+  /**
+   * Lets the server(s) know how to compress their replies.
+   */
+  void SendChannelOptions();
+
+  class vtkChannel;
+  vtkChannel* Channel;
+
+  class vtkPushBatch;
+  vtkPushBatch* PushBatch;
 };
 
 #endif
@@ -107,6 +107,8 @@ protected:
   vtkSMProxyManagerForwarder() = default;
 };
 //*****************************************************************************
+bool vtkSMSessionProxyManager::BatchedStateLoading = false;
+
 //---------------------------------------------------------------------------
 vtkSMSessionProxyManager* vtkSMSessionProxyManager::New(vtkSMSession* session)
 {
@@ -1225,6 +1227,7 @@ void vtkSMSessionProxyManager::LoadXMLState(vtkPVXMLElement* rootElement,
   {
     spLoader = vtkSmartPointer<vtkSMStateLoader>::New();
     spLoader->SetSessionProxyManager(this);
+    spLoader->SetBatchedLoading(vtkSMSessionProxyManager::BatchedStateLoading);
   }
   else
   {
@@ -1240,6 +1243,18 @@ void vtkSMSessionProxyManager::LoadXMLState(vtkPVXMLElement* rootElement,
   this->InLoadXMLState = prev;
 }
 
+//---------------------------------------------------------------------------
+void vtkSMSessionProxyManager::SetBatchedStateLoading(bool batched)
+{
+  vtkSMSessionProxyManager::BatchedStateLoading = batched;
+}
+
+//---------------------------------------------------------------------------
+bool vtkSMSessionProxyManager::GetBatchedStateLoading()
+{
+  return vtkSMSessionProxyManager::BatchedStateLoading;
+}
+
 //---------------------------------------------------------------------------
 bool vtkSMSessionProxyManager::SaveString(
   const char* string, const char* filename, vtkTypeUInt32 location)
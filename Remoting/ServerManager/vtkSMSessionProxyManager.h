@@ -417,6 +417,17 @@ public:
    */
   vtkGetMacro(InLoadXMLState, bool);
 
+  ///@{
+  /**
+   * When set, the vtkSMStateLoader created by LoadXMLState() when none is
+   * specified loads the state in batches (see
+   * vtkSMStateLoader::SetBatchedLoading). Loaders passed to LoadXMLState() are
+   * used as is. Default is false.
+   */
+  static void SetBatchedStateLoading(bool);
+  static bool GetBatchedStateLoading();
+  ///@}
+
   /**
    * Save a string to a file at the given location.
    */
@@ -653,6 +664,8 @@ private:
   vtkSMProxyManagerObserver* Observer;
   bool InLoadXMLState;
 
+  static bool BatchedStateLoading;
+
 #ifndef __WRAP__
   static vtkSMSessionProxyManager* New() { return nullptr; }
 #endif
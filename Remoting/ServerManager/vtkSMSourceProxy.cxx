@@ -231,6 +231,19 @@ void vtkSMSourceProxy::UpdatePipelineInformation()
   this->InvokeEvent(vtkCommand::UpdateInformationEvent);
   // this->MarkModified(this);
 }
+//---------------------------------------------------------------------------
+void vtkSMSourceProxy::SetCacheTimeSteps(bool value)
+{
+  this->CreateVTKObjects();
+  if (this->ObjectsCreated)
+  {
+    vtkClientServerStream stream;
+    stream << vtkClientServerStream::Invoke << SIPROXY(this) << "SetCacheTimeSteps" << value
+           << vtkClientServerStream::End;
+    this->ExecuteStream(stream);
+  }
+}
+
 //---------------------------------------------------------------------------
 int vtkSMSourceProxy::ReadXMLAttributes(vtkSMSessionProxyManager* pm, vtkPVXMLElement* element)
 {
@@ -166,6 +166,15 @@ public:
   vtkPVDataInformation* GetRankDataInformation(unsigned int outputIdx, int rank);
   ///@}
 
+  /**
+   * Enable/disable caching the outputs of the algorithm for each time step on
+   * the processes it lives on, so that going back to a time step does not
+   * update the pipeline again. Cached outputs are released when the pipeline
+   * is modified, and all proxies share a memory budget.
+   * @sa vtkPVCompositeDataPipeline::SetCacheTimeSteps
+   */
+  void SetCacheTimeSteps(bool value);
+
   /**
    * Creates extract selection proxies for each output port if not already
    * created.
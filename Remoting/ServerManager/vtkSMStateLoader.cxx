@@ -24,6 +24,23 @@
 
 vtkObjectFactoryNewMacro(vtkSMStateLoader);
 vtkCxxSetObjectMacro(vtkSMStateLoader, ProxyLocator, vtkSMProxyLocator);
+
+namespace
+{
+//---------------------------------------------------------------------------
+void vtkUpdatePipelineInformation(vtkSMProxy* proxy)
+{
+  if (proxy->IsA("vtkSMSourceProxy"))
+  {
+    vtkSMSourceProxy::SafeDownCast(proxy)->UpdatePipelineInformation();
+  }
+  else if (proxy->IsA("vtkSMImporterProxy"))
+  {
+    proxy->UpdatePipelineInformation();
+  }
+}
+}
+
 //---------------------------------------------------------------------------
 struct vtkSMStateLoaderRegistrationInfo
 {
@@ -47,9 +64,14 @@ struct vtkSMStateLoaderInternals
   ProxyCreationOrderType ProxyCreationOrder;
   bool DeferProxyRegistration;
 
+  /// When true, CreatedNewProxy() leaves updating the pipeline information to
+  /// LoadStateInternal(), which does it for all of ProxyCreationOrder.
+  bool DeferPipelineInformation;
+
   vtkSMStateLoaderInternals()
     : KeepOriginalId(false)
     , DeferProxyRegistration(false)
+    , DeferPipelineInformation(false)
   {
   }
 };
@@ -60,6 +82,7 @@ vtkSMStateLoader::vtkSMStateLoader()
   this->Internal = new vtkSMStateLoaderInternals;
   this->ServerManagerStateElement = nullptr;
   this->KeepIdMapping = 0;
+  this->BatchedLoading = false;
   this->ProxyLocator = vtkSMProxyLocator::New();
 }
 
@@ -210,13 +233,9 @@ void vtkSMStateLoader::CreatedNewProxy(vtkTypeUInt32 id, vtkSMProxy* proxy)
 
   // Calling UpdateVTKObjects() will assign the proxy a GlobalId, if needed.
   proxy->UpdateVTKObjects();
-  if (proxy->IsA("vtkSMSourceProxy"))
-  {
-    vtkSMSourceProxy::SafeDownCast(proxy)->UpdatePipelineInformation();
-  }
-  else if (proxy->IsA("vtkSMImporterProxy"))
+  if (!this->Internal->DeferPipelineInformation)
   {
-    proxy->UpdatePipelineInformation();
+    vtkUpdatePipelineInformation(proxy);
   }
   if (this->Internal->DeferProxyRegistration)
   {
@@ -620,9 +639,20 @@ int vtkSMStateLoader::LoadStateInternal(vtkPVXMLElement* parent)
   // registered. That way, when properties on TimeKeeper or AnimationScene
   // start getting modified, the proxies they may refer to are already
   // present and registered.
+  //
+  // With BatchedLoading, the state of all these proxies is pushed in a few
+  // batches and their pipeline information is only updated once the whole
+  // graph exists, in creation order, before any of them is registered.
   std::vector<vtkSmartPointer<vtkPVXMLElement>> deferredCollections;
+  vtkSMSession* session = this->BatchedLoading ? this->GetSession() : nullptr;
+  if (session)
+  {
+    session->StartPushBatch();
+  }
   this->Internal->DeferProxyRegistration = true;
-  for (i = 0; i < numElems; i++)
+  this->Internal->DeferPipelineInformation = (session != nullptr);
+  bool status = true;
+  for (i = 0; i < numElems && status; i++)
   {
     vtkPVXMLElement* currentElement = rootElement->GetNestedElement(i);
     const char* name = currentElement->GetName();
@@ -633,9 +663,31 @@ int vtkSMStateLoader::LoadStateInternal(vtkPVXMLElement* parent)
       {
         deferredCollections.push_back(currentElement);
       }
-      else if (!this->HandleProxyCollection(currentElement))
+      else
       {
-        return 0;
+        status = this->HandleProxyCollection(currentElement) != 0;
+      }
+    }
+  }
+  this->Internal->DeferPipelineInformation = false;
+  if (session)
+  {
+    session->EndPushBatch();
+  }
+  if (!status)
+  {
+    this->Internal->ProxyCreationOrder.clear();
+    this->Internal->DeferProxyRegistration = false;
+    return 0;
+  }
+
+  if (session)
+  {
+    for (const auto& item : this->Internal->ProxyCreationOrder)
+    {
+      if (item.second)
+      {
+        vtkUpdatePipelineInformation(item.second);
       }
     }
   }
@@ -727,6 +779,7 @@ int vtkSMStateLoader::LoadStateInternal(vtkPVXMLElement* parent)
 void vtkSMStateLoader::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "BatchedLoading: " << this->BatchedLoading << endl;
 }
 
 //---------------------------------------------------------------------------
@@ -56,6 +56,20 @@ public:
   vtkBooleanMacro(KeepIdMapping, int);
   ///@}
 
+  ///@{
+  /**
+   * When set, the state pushed while creating the proxies of the state is
+   * sent to the server(s) in a few batches (see vtkSMSession::StartPushBatch)
+   * instead of one message per proxy, and the pipeline information of the
+   * source proxies is only updated once all proxies have been created. This
+   * reduces the number of round trips when loading large states over a
+   * slow connection. Default is false.
+   */
+  vtkSetMacro(BatchedLoading, bool);
+  vtkGetMacro(BatchedLoading, bool);
+  vtkBooleanMacro(BatchedLoading, bool);
+  ///@}
+
   ///@{
   /**
    * Return an array of ids. The ids are stored in the following order
@@ -153,6 +167,7 @@ protected:
   vtkPVXMLElement* ServerManagerStateElement;
   vtkSMProxyLocator* ProxyLocator;
   int KeepIdMapping;
+  bool BatchedLoading;
 
 private:
   vtkSMStateLoader(const vtkSMStateLoader&) = delete;
@@ -11,7 +11,10 @@
 #include "vtkSISourceProxy.h"
 #include "vtkSMArraySelectionDomain.h"
 #include "vtkSMInputArrayDomain.h"
+#include "vtkSMOutputPort.h"
 #include "vtkSMPTools.h"
+#include "vtkSMParaViewPipelineController.h"
+#include "vtkSMSessionProxyManager.h"
 #include "vtkSMTrace.h"
 #include "vtkThreadedCallbackQueue.h"
 #include "vtkThreads.h"
@@ -73,6 +76,54 @@ bool vtkPVGeneralSettings::GetAutoConvertProperties()
   return vtkSMInputArrayDomain::GetAutomaticPropertyConversion();
 }
 
+//----------------------------------------------------------------------------
+void vtkPVGeneralSettings::SetBatchedStateLoading(bool val)
+{
+  if (this->GetBatchedStateLoading() != val)
+  {
+    vtkSMSessionProxyManager::SetBatchedStateLoading(val);
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVGeneralSettings::GetBatchedStateLoading()
+{
+  return vtkSMSessionProxyManager::GetBatchedStateLoading();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVGeneralSettings::SetCacheTimeSteps(bool val)
+{
+  if (this->GetCacheTimeSteps() != val)
+  {
+    vtkSMParaViewPipelineController::SetCacheTimeSteps(val);
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVGeneralSettings::GetCacheTimeSteps()
+{
+  return vtkSMParaViewPipelineController::GetCacheTimeSteps();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVGeneralSettings::SetEstimateArrayRanges(bool val)
+{
+  if (this->GetEstimateArrayRanges() != val)
+  {
+    vtkSMOutputPort::SetEstimateRanges(val);
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVGeneralSettings::GetEstimateArrayRanges()
+{
+  return vtkSMOutputPort::GetEstimateRanges();
+}
+
 //----------------------------------------------------------------------------
 void vtkPVGeneralSettings::SetCacheGeometryForAnimation(bool val)
 {
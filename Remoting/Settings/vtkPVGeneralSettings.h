@@ -43,6 +43,34 @@ public:
   bool GetAutoConvertProperties();
   ///@}
 
+  ///@{
+  /**
+   * Send the state of the proxies created when loading a state file to the
+   * server(s) in a few batches instead of one message per proxy.
+   * Forwards the call to vtkSMSessionProxyManager::SetBatchedStateLoading.
+   */
+  void SetBatchedStateLoading(bool val);
+  bool GetBatchedStateLoading();
+  ///@}
+
+  ///@{
+  /**
+   * Cache the outputs of new pipeline proxies for each time step.
+   * Forwards the call to vtkSMParaViewPipelineController::SetCacheTimeSteps.
+   */
+  void SetCacheTimeSteps(bool val);
+  bool GetCacheTimeSteps();
+  ///@}
+
+  ///@{
+  /**
+   * Estimate the ranges of large arrays when gathering data information.
+   * Forwards the call to vtkSMOutputPort::SetEstimateRanges.
+   */
+  void SetEstimateArrayRanges(bool val);
+  bool GetEstimateArrayRanges();
+  ///@}
+
   ///@{
   /**
    * Determines the number of distinct values in
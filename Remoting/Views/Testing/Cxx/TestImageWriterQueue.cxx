@@ -0,0 +1,154 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkCommand.h"
+#include "vtkImageData.h"
+#include "vtkInitializationHelper.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPVSession.h"
+#include "vtkProcessModule.h"
+#include "vtkSMImageWriterQueue.h"
+#include "vtkSMParaViewPipelineController.h"
+#include "vtkSMProxy.h"
+#include "vtkSMSession.h"
+#include "vtkSMSessionProxyManager.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestErrorObserver.h"
+#include "vtkTestUtilities.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace
+{
+vtkSmartPointer<vtkImageData> MakeImage(int value)
+{
+  auto image = vtkSmartPointer<vtkImageData>::New();
+  image->SetDimensions(16, 16, 1);
+  image->AllocateScalars(VTK_UNSIGNED_CHAR, 3);
+  auto ptr = static_cast<unsigned char*>(image->GetScalarPointer());
+  std::fill(ptr, ptr + 16 * 16 * 3, static_cast<unsigned char>(value));
+  return image;
+}
+
+bool FileExists(const std::string& fileName)
+{
+  std::ifstream file(fileName);
+  return file.good();
+}
+
+int Run(vtkSMSession* session, const std::string& tempDir)
+{
+  auto pxm = session->GetSessionProxyManager();
+  vtkSmartPointer<vtkSMProxy> format;
+  format.TakeReference(pxm->NewProxy("screenshot_writers", "PNG"));
+  if (!format)
+  {
+    vtkLogF(ERROR, "Failed to create the PNG format proxy.");
+    return EXIT_FAILURE;
+  }
+  format->UpdateVTKObjects();
+
+  if (!vtkSMImageWriterQueue::CanWriteLocally(session, vtkPVSession::CLIENT) ||
+    !vtkSMImageWriterQueue::CanWriteLocally(session, vtkPVSession::DATA_SERVER))
+  {
+    vtkLogF(ERROR, "A builtin session must write locally.");
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkSMImageWriterQueue> queue;
+  queue->SetMaximumNumberOfPendingFrames(2);
+
+  // images are written in the background, with at most 2 pending at any time.
+  std::vector<std::string> fileNames;
+  for (int cc = 0; cc < 6; ++cc)
+  {
+    fileNames.push_back(tempDir + "/TestImageWriterQueue_" + std::to_string(cc) + ".png");
+    if (!queue->WriteImage(format, MakeImage(40 * cc), fileNames.back()))
+    {
+      vtkLogF(ERROR, "Failed to queue image %d.", cc);
+      return EXIT_FAILURE;
+    }
+    if (queue->GetNumberOfPendingFrames() > 2)
+    {
+      vtkLogF(ERROR, "Too many pending frames: %d.", queue->GetNumberOfPendingFrames());
+      return EXIT_FAILURE;
+    }
+  }
+  if (!queue->Flush() || queue->GetNumberOfPendingFrames() != 0)
+  {
+    vtkLogF(ERROR, "Flush failed.");
+    return EXIT_FAILURE;
+  }
+  for (const auto& fileName : fileNames)
+  {
+    if (!FileExists(fileName))
+    {
+      vtkLogF(ERROR, "'%s' was not written.", fileName.c_str());
+      return EXIT_FAILURE;
+    }
+  }
+
+  // jobs pushed on the same stream run in order.
+  vtkNew<vtkObject> stream;
+  std::mutex mutex;
+  std::vector<int> order;
+  for (int cc = 0; cc < 8; ++cc)
+  {
+    queue->Push(stream, [cc, &mutex, &order]() {
+      std::lock_guard<std::mutex> lock(mutex);
+      order.push_back(cc);
+      return true;
+    });
+  }
+  if (!queue->Flush() || order != std::vector<int>{ 0, 1, 2, 3, 4, 5, 6, 7 })
+  {
+    vtkLogF(ERROR, "Stream jobs did not run in order.");
+    return EXIT_FAILURE;
+  }
+
+  // failures are reported by the next Flush() only.
+  vtkNew<vtkTest::ErrorObserver> observer;
+  queue->AddObserver(vtkCommand::ErrorEvent, observer);
+  queue->Push(nullptr, []() { return false; });
+  if (queue->Flush() || !observer->GetError())
+  {
+    vtkLogF(ERROR, "Flush should have failed.");
+    return EXIT_FAILURE;
+  }
+  if (!queue->Flush())
+  {
+    vtkLogF(ERROR, "Failures should be reset by Flush().");
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+}
+
+extern int TestImageWriterQueue(int argc, char* argv[])
+{
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_CLIENT);
+
+  vtkNew<vtkSMParaViewPipelineController> controller;
+  vtkSMSession* session = vtkSMSession::New();
+  if (!controller->InitializeSession(session))
+  {
+    vtkLogF(ERROR, "Failed to initialize ParaView session.");
+    session->Delete();
+    vtkInitializationHelper::Finalize();
+    return EXIT_FAILURE;
+  }
+
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const int status = Run(session, tempDir);
+  delete[] tempDir;
+
+  session->Delete();
+  vtkInitializationHelper::Finalize();
+  return status;
+}
@@ -0,0 +1,167 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkActor.h"
+#include "vtkCamera.h"
+#include "vtkCellArray.h"
+#include "vtkDataObject.h"
+#include "vtkIdTypeArray.h"
+#include "vtkInformation.h"
+#include "vtkInformationIntegerKey.h"
+#include "vtkInitializationHelper.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPVHardwareSelector.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataMapper.h"
+#include "vtkProcessModule.h"
+#include "vtkRenderWindow.h"
+#include "vtkRenderer.h"
+#include "vtkSelection.h"
+#include "vtkSelectionNode.h"
+#include "vtkSmartPointer.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+// A grid of 4x4 quads in the z=0 plane, starting at x = xOrigin.
+vtkSmartPointer<vtkPolyData> MakeGrid(double xOrigin)
+{
+  vtkNew<vtkPoints> points;
+  for (int yy = 0; yy <= 4; ++yy)
+  {
+    for (int xx = 0; xx <= 4; ++xx)
+    {
+      points->InsertNextPoint(xOrigin + xx, yy, 0.0);
+    }
+  }
+  vtkNew<vtkCellArray> quads;
+  for (vtkIdType yy = 0; yy < 4; ++yy)
+  {
+    for (vtkIdType xx = 0; xx < 4; ++xx)
+    {
+      const vtkIdType p0 = yy * 5 + xx;
+      const vtkIdType quad[4] = { p0, p0 + 1, p0 + 6, p0 + 5 };
+      quads->InsertNextCell(4, quad);
+    }
+  }
+  auto grid = vtkSmartPointer<vtkPolyData>::New();
+  grid->SetPoints(points);
+  grid->SetPolys(quads);
+  return grid;
+}
+
+std::vector<vtkIdType> GetIds(vtkSelectionNode* node)
+{
+  auto ids = vtkIdTypeArray::SafeDownCast(node->GetSelectionList());
+  std::vector<vtkIdType> values;
+  for (vtkIdType cc = 0; ids && cc < ids->GetNumberOfTuples(); ++cc)
+  {
+    values.push_back(ids->GetValue(cc));
+  }
+  std::sort(values.begin(), values.end());
+  return values;
+}
+
+int GetKey(vtkSelectionNode* node, vtkInformationIntegerKey* key)
+{
+  return node->GetProperties()->Has(key) ? node->GetProperties()->Get(key) : -1;
+}
+
+// Compares the selection generated by vtkPVHardwareSelector with the one
+// generated by vtkHardwareSelector, including the order of the nodes.
+bool CompareWithSuperclass(vtkPVHardwareSelector* selector, unsigned int x1, unsigned int y1,
+  unsigned int x2, unsigned int y2)
+{
+  vtkSmartPointer<vtkSelection> sel;
+  sel.TakeReference(selector->GenerateSelection(x1, y1, x2, y2));
+  vtkSmartPointer<vtkSelection> expected;
+  expected.TakeReference(selector->vtkHardwareSelector::GenerateSelection(x1, y1, x2, y2));
+
+  if (sel->GetNumberOfNodes() != expected->GetNumberOfNodes() || sel->GetNumberOfNodes() == 0)
+  {
+    vtkLogF(ERROR, "Expected %u nodes, got %u.", expected->GetNumberOfNodes(),
+      sel->GetNumberOfNodes());
+    return false;
+  }
+  for (unsigned int cc = 0; cc < sel->GetNumberOfNodes(); ++cc)
+  {
+    vtkSelectionNode* node = sel->GetNode(cc);
+    vtkSelectionNode* expectedNode = expected->GetNode(cc);
+    for (auto key : { vtkSelectionNode::PROCESS_ID(), vtkSelectionNode::PROP_ID(),
+           vtkSelectionNode::COMPOSITE_INDEX(), vtkSelectionNode::PIXEL_COUNT() })
+    {
+      if (GetKey(node, key) != GetKey(expectedNode, key))
+      {
+        vtkLogF(ERROR, "Node %u differs for key %s: %d != %d.", cc, key->GetName(),
+          GetKey(node, key), GetKey(expectedNode, key));
+        return false;
+      }
+    }
+    if (GetIds(node) != GetIds(expectedNode))
+    {
+      vtkLogF(ERROR, "Node %u has different ids.", cc);
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+extern int TestPVHardwareSelector(int, char* argv[])
+{
+  vtkInitializationHelper::SetApplicationName("TestPVHardwareSelector");
+  vtkInitializationHelper::SetOrganizationName("Humanity");
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_CLIENT);
+
+  vtkNew<vtkRenderer> renderer;
+  for (double xOrigin : { -5.0, 1.0 })
+  {
+    vtkNew<vtkPolyDataMapper> mapper;
+    mapper->SetInputData(MakeGrid(xOrigin));
+    vtkNew<vtkActor> actor;
+    actor->SetMapper(mapper);
+    renderer->AddActor(actor);
+  }
+
+  vtkNew<vtkRenderWindow> renWin;
+  renWin->SetSize(200, 200);
+  renWin->AddRenderer(renderer);
+  renderer->ResetCamera();
+  renWin->Render();
+
+  int status = EXIT_SUCCESS;
+  vtkNew<vtkPVHardwareSelector> selector;
+  selector->SetRenderer(renderer);
+  selector->SetFieldAssociation(vtkDataObject::FIELD_ASSOCIATION_CELLS);
+  for (int pass = 0; pass < 2 && status == EXIT_SUCCESS; ++pass)
+  {
+    selector->SetArea(0, 0, 199, 199);
+    if (!selector->CaptureBuffers())
+    {
+      vtkLogF(ERROR, "Failed to capture buffers.");
+      status = EXIT_FAILURE;
+      break;
+    }
+
+    // the whole view, then regions decoded from the cache, partially or not.
+    if (!CompareWithSuperclass(selector, 0, 0, 199, 199) ||
+      !CompareWithSuperclass(selector, 0, 0, 99, 199) ||
+      !CompareWithSuperclass(selector, 50, 50, 150, 150))
+    {
+      status = EXIT_FAILURE;
+    }
+
+    // the decoded pixels must not be reused for a different frame.
+    renderer->GetActiveCamera()->Azimuth(180);
+    renderer->ResetCamera();
+    renWin->Render();
+  }
+
+  selector->SetRenderer(nullptr);
+  vtkInitializationHelper::Finalize();
+  return status;
+}
@@ -0,0 +1,180 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkClientServerStream.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDoubleArray.h"
+#include "vtkFieldData.h"
+#include "vtkIdTypeArray.h"
+#include "vtkInformation.h"
+#include "vtkLogger.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkMultiProcessStream.h"
+#include "vtkNew.h"
+#include "vtkPVHoverInformation.h"
+#include "vtkPVHoverLocator.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkStringArray.h"
+
+#include <cstdlib>
+
+#define TEST_ASSERT(x)                                                                             \
+  do                                                                                               \
+  {                                                                                                \
+    if (!(x))                                                                                      \
+    {                                                                                              \
+      vtkLogF(ERROR, "Check failed: %s", #x);                                                      \
+      return EXIT_FAILURE;                                                                         \
+    }                                                                                              \
+  } while (false)
+
+namespace
+{
+// A single triangle with a 3-component point array, a cell array, an original
+// point ids array (which is not reported) and field data.
+vtkSmartPointer<vtkPolyData> MakeTriangle(double offset)
+{
+  vtkNew<vtkPoints> points;
+  points->InsertNextPoint(offset, 0, 0);
+  points->InsertNextPoint(offset + 1, 0, 0);
+  points->InsertNextPoint(offset, 1, 0);
+  vtkNew<vtkCellArray> polys;
+  const vtkIdType triangle[3] = { 0, 1, 2 };
+  polys->InsertNextCell(3, triangle);
+
+  auto pd = vtkSmartPointer<vtkPolyData>::New();
+  pd->SetPoints(points);
+  pd->SetPolys(polys);
+
+  vtkNew<vtkDoubleArray> vectors;
+  vectors->SetName("Vectors");
+  vectors->SetNumberOfComponents(3);
+  for (vtkIdType cc = 0; cc < 3; ++cc)
+  {
+    vectors->InsertNextTuple3(offset + cc, 10 * cc, 100 * cc);
+  }
+  pd->GetPointData()->AddArray(vectors);
+
+  vtkNew<vtkIdTypeArray> originalIds;
+  originalIds->SetName("vtkOriginalPointIds");
+  for (vtkIdType cc = 0; cc < 3; ++cc)
+  {
+    originalIds->InsertNextValue(cc + 42);
+  }
+  pd->GetPointData()->AddArray(originalIds);
+
+  vtkNew<vtkDoubleArray> area;
+  area->SetName("Area");
+  area->InsertNextValue(0.5);
+  pd->GetCellData()->AddArray(area);
+
+  // 12 components, more than the number of field data components reported.
+  vtkNew<vtkDoubleArray> matrix;
+  matrix->SetName("Matrix");
+  matrix->SetNumberOfComponents(12);
+  matrix->SetNumberOfTuples(1);
+  matrix->FillValue(offset);
+  pd->GetFieldData()->AddArray(matrix);
+
+  vtkNew<vtkStringArray> label;
+  label->SetName("Label");
+  label->InsertNextValue("triangle");
+  pd->GetFieldData()->AddArray(label);
+  return pd;
+}
+}
+
+extern int TestPVHoverInformation(int, char*[])
+{
+  vtkNew<vtkMultiBlockDataSet> mb;
+  mb->SetNumberOfBlocks(2);
+  mb->SetBlock(0, MakeTriangle(0));
+  mb->SetBlock(1, MakeTriangle(5));
+  mb->GetMetaData(0u)->Set(vtkCompositeDataSet::NAME(), "left");
+  mb->GetMetaData(1u)->Set(vtkCompositeDataSet::NAME(), "right");
+
+  // leaves are looked up by their flat index.
+  vtkNew<vtkPVHoverLocator> locator;
+  locator->SetDataObject(mb);
+  TEST_ASSERT(locator->IsComposite());
+  TEST_ASSERT(locator->GetNumberOfBlocks() == 2);
+  TEST_ASSERT(locator->GetDataSet(1) == mb->GetBlock(0));
+  TEST_ASSERT(locator->GetDataSet(2) == mb->GetBlock(1));
+  TEST_ASSERT(locator->GetDataSet(3) == nullptr);
+  TEST_ASSERT(locator->GetBlockName(2) == "right");
+
+  // tables are only rebuilt when the data changes.
+  const vtkMTimeType mtime = locator->GetMTime();
+  locator->SetDataObject(mb);
+  TEST_ASSERT(locator->GetMTime() == mtime);
+  mb->SetBlock(1, nullptr);
+  locator->SetDataObject(mb);
+  TEST_ASSERT(locator->GetMTime() > mtime);
+  TEST_ASSERT(locator->GetNumberOfBlocks() == 1);
+  TEST_ASSERT(locator->GetDataSet(2) == nullptr);
+
+  auto triangle = MakeTriangle(5);
+  locator->SetDataObject(triangle);
+  TEST_ASSERT(!locator->IsComposite());
+  TEST_ASSERT(locator->GetDataSet(7) == triangle);
+  TEST_ASSERT(locator->GetBlockName(0).empty());
+
+  // point values.
+  vtkNew<vtkPVHoverInformation> info;
+  info->SetFieldAssociation(vtkDataObject::FIELD_ASSOCIATION_POINTS);
+  TEST_ASSERT(!info->CopyFromDataSet(triangle, 3, nullptr));
+  TEST_ASSERT(!info->GetFound());
+  TEST_ASSERT(info->CopyFromDataSet(triangle, 1, "right"));
+  TEST_ASSERT(info->GetFound() && info->GetComposite() && info->GetBlockName() == "right");
+  TEST_ASSERT(info->GetResultElementId() == 1);
+  TEST_ASSERT(info->GetCoordinates()[0] == 6.0);
+  TEST_ASSERT(info->GetAttributeValues().size() == 1);
+  const auto& vectors = info->GetAttributeValues()[0];
+  TEST_ASSERT(vectors.Name == "Vectors" && vectors.NumberOfComponents == 3);
+  TEST_ASSERT(vectors.Values.size() == 3 && vectors.Values[2] == 100.0);
+
+  const auto& fieldData = info->GetFieldDataValues();
+  TEST_ASSERT(fieldData.size() == 2);
+  TEST_ASSERT(fieldData[0].NumberOfComponents == 12);
+  TEST_ASSERT(static_cast<int>(fieldData[0].Values.size()) ==
+    vtkPVHoverInformation::MaximumNumberOfFieldDataComponents);
+  TEST_ASSERT(fieldData[1].IsString && fieldData[1].StringValue == "triangle");
+
+  // results survive the round trip to the client.
+  vtkClientServerStream css;
+  info->CopyToStream(&css);
+  vtkNew<vtkPVHoverInformation> received;
+  received->CopyFromStream(&css);
+  TEST_ASSERT(received->GetFound() && received->GetBlockName() == "right");
+  TEST_ASSERT(received->GetResultElementId() == 1);
+  TEST_ASSERT(received->GetCoordinates()[0] == 6.0);
+  TEST_ASSERT(received->GetAttributeValues().size() == 1);
+  TEST_ASSERT(received->GetAttributeValues()[0].Values[1] == 10.0);
+  TEST_ASSERT(received->GetFieldDataValues().size() == 2);
+  TEST_ASSERT(received->GetFieldDataValues()[1].StringValue == "triangle");
+
+  // cell values.
+  info->SetFieldAssociation(vtkDataObject::FIELD_ASSOCIATION_CELLS);
+  TEST_ASSERT(info->CopyFromDataSet(triangle, 0, nullptr));
+  TEST_ASSERT(!info->GetComposite() && info->GetCellType() == VTK_TRIANGLE);
+  TEST_ASSERT(info->GetAttributeValues().size() == 1);
+  TEST_ASSERT(info->GetAttributeValues()[0].Values[0] == 0.5);
+
+  // parameters sent to the data server.
+  info->SetCompositeIndex(2);
+  info->SetProcessId(1);
+  info->SetElementId(1234567);
+  vtkMultiProcessStream mps;
+  info->CopyParametersToStream(mps);
+  vtkNew<vtkPVHoverInformation> parameters;
+  parameters->CopyParametersFromStream(mps);
+  TEST_ASSERT(parameters->GetFieldAssociation() == vtkDataObject::FIELD_ASSOCIATION_CELLS);
+  TEST_ASSERT(parameters->GetCompositeIndex() == 2 && parameters->GetProcessId() == 1);
+  TEST_ASSERT(parameters->GetElementId() == 1234567);
+  return EXIT_SUCCESS;
+}
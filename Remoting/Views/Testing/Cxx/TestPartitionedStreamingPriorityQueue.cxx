@@ -0,0 +1,72 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkInformation.h"
+#include "vtkLogger.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPartitionedStreamingPriorityQueue.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+#define TEST_ASSERT(x)                                                                             \
+  do                                                                                               \
+  {                                                                                                \
+    if (!(x))                                                                                      \
+    {                                                                                              \
+      vtkLogF(ERROR, "Check failed: %s", #x);                                                      \
+      return EXIT_FAILURE;                                                                         \
+    }                                                                                              \
+  } while (false)
+
+extern int TestPartitionedStreamingPriorityQueue(int, char*[])
+{
+  // leaf blocks, with flat indices 1 to 4:
+  // 1: small valid bounds, 2: large valid bounds, 3: invalid bounds, 4: no bounds.
+  vtkNew<vtkMultiBlockDataSet> metadata;
+  metadata->SetNumberOfBlocks(4);
+  const double small[6] = { 0, 1, 0, 1, 0, 1 };
+  const double large[6] = { 0, 10, 0, 10, 0, 10 };
+  const double invalid[6] = { 1, -1, 1, -1, 1, -1 };
+  metadata->GetMetaData(0u)->Set(vtkStreamingDemandDrivenPipeline::BOUNDS(), small, 6);
+  metadata->GetMetaData(1u)->Set(vtkStreamingDemandDrivenPipeline::BOUNDS(), large, 6);
+  metadata->GetMetaData(2u)->Set(vtkStreamingDemandDrivenPipeline::BOUNDS(), invalid, 6);
+
+  vtkNew<vtkPartitionedStreamingPriorityQueue> queue;
+  queue->SetController(nullptr);
+  TEST_ASSERT(queue->Initialize(metadata));
+
+  double bounds[6];
+  queue->GetBounds(bounds);
+  TEST_ASSERT(bounds[0] == 0 && bounds[1] == 10);
+
+  // without an estimate, a single block is popped per call. Blocks with valid
+  // bounds come first, larger ones first, and every block is popped.
+  std::vector<unsigned int> order;
+  while (!queue->IsEmpty())
+  {
+    auto blocks = queue->PopBlocks(1);
+    TEST_ASSERT(blocks.size() == 1);
+    order.push_back(blocks[0]);
+  }
+  TEST_ASSERT(order.size() == 4);
+  TEST_ASSERT(order[0] == 2 && order[1] == 1);
+  TEST_ASSERT(std::find(order.begin(), order.end(), 3u) != order.end());
+  TEST_ASSERT(std::find(order.begin(), order.end(), 4u) != order.end());
+
+  // reported sizes are only used once synchronized.
+  queue->ReportStreamedBlocks(2, 2000);
+  TEST_ASSERT(queue->GetEstimatedBytesPerBlock() == 0.0);
+  queue->SynchronizeEstimate();
+  TEST_ASSERT(queue->GetEstimatedBytesPerBlock() == 1000.0);
+
+  // with an estimate of 1000 bytes per block, 3 blocks fit in 3500 bytes.
+  queue->Reinitialize();
+  TEST_ASSERT(queue->PopBlocks(3500).size() == 3);
+  TEST_ASSERT(queue->PopBlocks(3500).size() == 1);
+  TEST_ASSERT(queue->IsEmpty());
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,149 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkClientServerStream.h"
+#include "vtkInitializationHelper.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPVProxyMemoryUseInformation.h"
+#include "vtkPVSession.h"
+#include "vtkProcessModule.h"
+#include "vtkSMParaViewPipelineControllerWithRendering.h"
+#include "vtkSMPropertyHelper.h"
+#include "vtkSMRenderViewProxy.h"
+#include "vtkSMSession.h"
+#include "vtkSMSessionProxyManager.h"
+#include "vtkSMSourceProxy.h"
+#include "vtkSmartPointer.h"
+
+#include <cstdlib>
+#include <string>
+
+#define TEST_ASSERT(x)                                                                             \
+  do                                                                                               \
+  {                                                                                                \
+    if (!(x))                                                                                      \
+    {                                                                                              \
+      vtkLogF(ERROR, "Check failed: %s", #x);                                                      \
+      return EXIT_FAILURE;                                                                         \
+    }                                                                                              \
+  } while (false)
+
+namespace
+{
+using Info = vtkPVProxyMemoryUseInformation;
+
+int FindProxy(Info* info, vtkSMProxy* proxy)
+{
+  for (int cc = 0; cc < info->GetNumberOfProxies(); ++cc)
+  {
+    if (info->GetGlobalID(cc) == proxy->GetGlobalID())
+    {
+      return cc;
+    }
+  }
+  return -1;
+}
+
+vtkSmartPointer<vtkSMSourceProxy> CreateSource(
+  vtkSMSession* session, const char* xmlgroup, const char* xmlname, vtkSMProxy* input = nullptr)
+{
+  vtkSmartPointer<vtkSMSourceProxy> proxy;
+  proxy.TakeReference(vtkSMSourceProxy::SafeDownCast(
+    session->GetSessionProxyManager()->NewProxy(xmlgroup, xmlname)));
+  vtkNew<vtkSMParaViewPipelineController> controller;
+  controller->PreInitializeProxy(proxy);
+  if (input)
+  {
+    vtkSMPropertyHelper(proxy, "Input").Set(input);
+  }
+  controller->PostInitializeProxy(proxy);
+  controller->RegisterPipelineProxy(proxy);
+  return proxy;
+}
+
+int Run(vtkSMSession* session)
+{
+  auto wavelet = CreateSource(session, "sources", "RTAnalyticSource");
+  auto pass = CreateSource(session, "filters", "PassThrough", wavelet);
+  pass->UpdatePipeline();
+
+  vtkNew<Info> info;
+  session->GatherInformation(vtkPVSession::DATA_SERVER, info, 0);
+
+  // outputs are attributed to their producer, a 21^3 image with a float array.
+  const int waveletIndex = FindProxy(info, wavelet);
+  TEST_ASSERT(waveletIndex >= 0);
+  TEST_ASSERT(std::string(info->GetXMLName(waveletIndex)) == "RTAnalyticSource");
+  TEST_ASSERT(info->GetNumberOfRanks(waveletIndex) == 1);
+  const vtkTypeInt64 waveletBytes = info->GetBytes(waveletIndex, Info::OUTPUT, Info::SUM);
+  TEST_ASSERT(waveletBytes >= 21 * 21 * 21 * 4);
+  TEST_ASSERT(info->GetBytes(waveletIndex, Info::OUTPUT, Info::MINIMUM) == waveletBytes);
+  TEST_ASSERT(info->GetBytes(waveletIndex, Info::REPRESENTATION, Info::SUM) == 0);
+  TEST_ASSERT(info->GetTotalBytes(waveletIndex, Info::SUM) == waveletBytes);
+  TEST_ASSERT(info->GetLastExecutionTime(waveletIndex, Info::MAXIMUM) > 0.0);
+
+  // shallow copies are attributed once, to the upstream proxy.
+  const int passIndex = FindProxy(info, pass);
+  TEST_ASSERT(passIndex >= 0);
+  TEST_ASSERT(info->GetBytes(passIndex, Info::OUTPUT, Info::SUM) < waveletBytes / 2);
+
+  // the pieces held by a view are attributed to the representations.
+  vtkSmartPointer<vtkSMRenderViewProxy> view;
+  view.TakeReference(vtkSMRenderViewProxy::SafeDownCast(
+    session->GetSessionProxyManager()->NewProxy("views", "RenderView")));
+  vtkNew<vtkSMParaViewPipelineControllerWithRendering> controller;
+  controller->InitializeProxy(view);
+  controller->RegisterViewProxy(view);
+  controller->Show(pass, 0, view);
+  view->StillRender();
+
+  session->GatherInformation(vtkPVSession::DATA_SERVER, info, 0);
+  vtkTypeInt64 representationBytes = 0;
+  for (int cc = 0; cc < info->GetNumberOfProxies(); ++cc)
+  {
+    representationBytes += info->GetBytes(cc, Info::REPRESENTATION, Info::SUM);
+  }
+  TEST_ASSERT(representationBytes > 0);
+
+  // the values survive the round trip to the client.
+  vtkClientServerStream css;
+  info->CopyToStream(&css);
+  vtkNew<Info> received;
+  received->CopyFromStream(&css);
+  TEST_ASSERT(received->GetNumberOfProxies() == info->GetNumberOfProxies());
+  const int receivedIndex = FindProxy(received, wavelet);
+  TEST_ASSERT(receivedIndex >= 0);
+  TEST_ASSERT(received->GetBytes(receivedIndex, Info::OUTPUT, Info::SUM) == waveletBytes);
+  TEST_ASSERT(std::string(received->GetXMLGroup(receivedIndex)) == "sources");
+
+  // values from several ranks are summarized.
+  received->AddInformation(info);
+  TEST_ASSERT(received->GetNumberOfProxies() == info->GetNumberOfProxies());
+  TEST_ASSERT(received->GetNumberOfRanks(receivedIndex) == 2);
+  TEST_ASSERT(received->GetBytes(receivedIndex, Info::OUTPUT, Info::SUM) == 2 * waveletBytes);
+  TEST_ASSERT(received->GetBytes(receivedIndex, Info::OUTPUT, Info::MAXIMUM) == waveletBytes);
+
+  controller->UnRegisterProxy(pass);
+  controller->UnRegisterProxy(wavelet);
+  controller->UnRegisterProxy(view);
+  return EXIT_SUCCESS;
+}
+}
+
+extern int TestProxyMemoryUseInformation(int, char* argv[])
+{
+  vtkInitializationHelper::SetApplicationName("TestProxyMemoryUseInformation");
+  vtkInitializationHelper::SetOrganizationName("Humanity");
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_CLIENT);
+
+  vtkNew<vtkSMParaViewPipelineControllerWithRendering> controller;
+  vtkNew<vtkSMSession> session;
+  vtkProcessModule::GetProcessModule()->RegisterSession(session);
+  controller->InitializeSession(session);
+
+  const int status = Run(session);
+
+  vtkProcessModule::GetProcessModule()->UnRegisterSession(session);
+  vtkInitializationHelper::Finalize();
+  return status;
+}
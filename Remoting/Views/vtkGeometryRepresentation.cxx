@@ -4,14 +4,17 @@
 #include "vtkGeometryRepresentationInternal.h"
 
 #include "vtkAlgorithmOutput.h"
+#include "vtkAppendPolyData.h"
 #include "vtkBoundingBox.h"
 #include "vtkCallbackCommand.h"
 #include "vtkCommand.h"
 #include "vtkCompositeCellGridMapper.h"
 #include "vtkCompositeDataDisplayAttributes.h"
+#include "vtkCompositeDataPipeline.h"
 #include "vtkCompositePolyDataMapper.h"
 #include "vtkDataAssembly.h"
 #include "vtkDataAssemblyUtilities.h"
+#include "vtkDataObjectTreeIterator.h"
 #include "vtkDataObjectTreeRange.h"
 #include "vtkDataObjectTypes.h"
 #include "vtkHyperTreeGrid.h"
@@ -27,9 +30,12 @@
 #include "vtkPVLODActor.h"
 #include "vtkPVLogger.h"
 #include "vtkPVRenderView.h"
+#include "vtkPVStreamingMacros.h"
 #include "vtkPVTrivialProducer.h"
 #include "vtkPartitionedDataSetCollection.h"
+#include "vtkPartitionedStreamingPriorityQueue.h"
 #include "vtkPointData.h"
+#include "vtkPolyData.h"
 #include "vtkProcessModule.h"
 #include "vtkProperty.h"
 #include "vtkRenderer.h"
@@ -51,6 +57,7 @@
 #include <vtksys/SystemTools.hxx>
 
 #include <algorithm>
+#include <cassert>
 #include <memory>
 #include <numeric>
 #include <tuple>
@@ -279,6 +286,8 @@ vtkGeometryRepresentation::vtkGeometryRepresentation()
   this->UseShaderReplacements = false;
   this->ShaderReplacementsString = "";
 
+  this->StreamingPriorityQueue = vtkSmartPointer<vtkPartitionedStreamingPriorityQueue>::New();
+
   // By default, show everything.
   this->AddBlockSelector("/");
 }
@@ -403,8 +412,15 @@ int vtkGeometryRepresentation::ProcessViewRequest(
   if (request_type == vtkPVView::REQUEST_UPDATE())
   {
     // provide the "geometry" to the view so the view can deliver it to the
-    // rendering nodes as and when needed.
-    vtkPVView::SetPiece(inInfo, this, this->MultiBlockMaker->GetOutputDataObject(0));
+    // rendering nodes as and when needed. When streaming, the output of the
+    // internal pipeline changes with each streamed piece, hence we provide the
+    // data generated by the most recent non-streaming pass instead.
+    vtkPVView::SetPiece(inInfo, this,
+      this->StreamingCapablePipeline ? this->StreamedBaseData.GetPointer()
+                                     : this->MultiBlockMaker->GetOutputDataObject(0));
+
+    // let the view know that this representation is streaming capable (or not).
+    vtkPVRenderView::SetStreamable(inInfo, this, this->StreamingCapablePipeline);
 
     if (this->UseDataPartitions == true)
     {
@@ -431,9 +447,32 @@ int vtkGeometryRepresentation::ProcessViewRequest(
     // that the bounds we report include the transformation as well.
     this->ComputeVisibleDataBounds();
 
+    double bounds[6];
+    std::copy(this->VisibleDataBounds, this->VisibleDataBounds + 6, bounds);
+    if (this->StreamingCapablePipeline)
+    {
+      // only a few blocks may have been loaded so far, report the bounds of the
+      // whole dataset from the meta-data so the camera is reset correctly.
+      vtkBoundingBox bbox;
+      if (vtkMath::AreBoundsInitialized(bounds))
+      {
+        bbox.AddBounds(bounds);
+      }
+      double metaBounds[6];
+      this->StreamingPriorityQueue->GetBounds(metaBounds);
+      if (vtkMath::AreBoundsInitialized(metaBounds))
+      {
+        bbox.AddBounds(metaBounds);
+      }
+      if (bbox.IsValid())
+      {
+        bbox.GetBounds(bounds);
+      }
+    }
+
     vtkNew<vtkMatrix4x4> matrix;
     this->Actor->GetMatrix(matrix);
-    vtkPVRenderView::SetGeometryBounds(inInfo, this, this->VisibleDataBounds, matrix);
+    vtkPVRenderView::SetGeometryBounds(inInfo, this, bounds, matrix);
   }
   else if (request_type == vtkPVView::REQUEST_UPDATE_LOD())
   {
@@ -470,9 +509,37 @@ int vtkGeometryRepresentation::ProcessViewRequest(
       }
     }
   }
+  else if (request_type == vtkPVRenderView::REQUEST_STREAMING_UPDATE())
+  {
+    if (this->StreamingCapablePipeline)
+    {
+      // This is a streaming update request, request next batch of blocks.
+      double view_planes[24];
+      inInfo->Get(vtkPVRenderView::VIEW_PLANES(), view_planes);
+      if (this->StreamingUpdate(view_planes))
+      {
+        // since we indeed "had" a next piece to produce, give it to the view
+        // so it can deliver it to the rendering nodes.
+        vtkPVRenderView::SetNextStreamedPiece(inInfo, this, this->StreamedPiece);
+      }
+    }
+  }
+  else if (request_type == vtkPVRenderView::REQUEST_PROCESS_STREAMED_PIECE())
+  {
+    if (vtkDataObject* piece = vtkPVRenderView::GetCurrentStreamedPiece(inInfo, this))
+    {
+      vtkStreamingStatusMacro(<< this << ": received new piece.");
+      this->MergeStreamedPiece(vtkPVView::GetDeliveredPiece(inInfo, this), piece);
+    }
+  }
   else if (request_type == vtkPVView::REQUEST_RENDER())
   {
     auto outputData = vtkPVView::GetDeliveredPiece(inInfo, this);
+    if (this->StreamedRenderedData != nullptr && this->StreamedRenderedBase == outputData)
+    {
+      // render the delivered data along with all the pieces streamed so far.
+      outputData = this->StreamedRenderedData;
+    }
     // vtkLogF(INFO, "%p: %s", (void*)data, this->GetLogName().c_str());
     auto dataLOD = vtkPVView::GetDeliveredPieceLOD(inInfo, this);
     this->Mapper->SetInputDataObject(outputData);
@@ -511,12 +578,86 @@ int vtkGeometryRepresentation::ProcessViewRequest(
   return 1;
 }
 
+//----------------------------------------------------------------------------
+int vtkGeometryRepresentation::RequestInformation(
+  vtkInformation* rqst, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  // Determine if the input is streaming capable. A pipeline is streaming
+  // capable if it provides us with COMPOSITE_DATA_META_DATA() in the
+  // RequestInformation() pass. It implies that we can request arbitrary blocks
+  // from the input pipeline. AMR datasets are handled by dedicated
+  // representations and are not vtkDataObjectTree subclasses.
+  if (!this->InStreamingUpdate)
+  {
+    this->StreamingCapablePipeline = false;
+    if (vtkPVView::GetEnableStreaming() && inputVector[0]->GetNumberOfInformationObjects() == 1)
+    {
+      vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+      auto metadata = vtkDataObjectTree::SafeDownCast(
+        inInfo->Get(vtkCompositeDataPipeline::COMPOSITE_DATA_META_DATA()));
+      if (metadata && metadata != this->StreamingPriorityQueue->GetMetaData())
+      {
+        this->StreamingCapablePipeline = this->StreamingPriorityQueue->Initialize(metadata);
+      }
+      else if (metadata)
+      {
+        this->StreamingCapablePipeline = true;
+      }
+    }
+    vtkStreamingStatusMacro(<< this << ": streaming capable input pipeline? "
+                            << (this->StreamingCapablePipeline ? "yes" : "no"));
+  }
+  return this->Superclass::RequestInformation(rqst, inputVector, outputVector);
+}
+
 //----------------------------------------------------------------------------
 int vtkGeometryRepresentation::RequestUpdateExtent(
   vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
 {
   this->Superclass::RequestUpdateExtent(request, inputVector, outputVector);
 
+  if (this->StreamingCapablePipeline)
+  {
+    if (!this->InStreamingUpdate)
+    {
+      // the input changed for non-streaming reasons. Start streaming all over
+      // again, using the most recent view planes, if any.
+      this->StreamingPriorityQueue->Reinitialize();
+    }
+
+    // Request the next batch of blocks. The first (non-streaming) pass also
+    // requests a batch so that we don't end up loading the whole dataset.
+    std::vector<unsigned int> blocks = this->StreamingPriorityQueue->PopBlocks(
+      static_cast<vtkTypeUInt64>(this->StreamingBytesPerFrame));
+    std::sort(blocks.begin(), blocks.end());
+    this->NumberOfRequestedBlocks = static_cast<unsigned int>(blocks.size());
+    std::vector<int> cids(blocks.begin(), blocks.end());
+    vtkStreamingStatusMacro(<< this << ": requesting " << cids.size() << " blocks.");
+    for (int kk = 0; kk < inputVector[0]->GetNumberOfInformationObjects(); kk++)
+    {
+      vtkInformation* inInfo = inputVector[0]->GetInformationObject(kk);
+      inInfo->Set(vtkCompositeDataPipeline::LOAD_REQUESTED_BLOCKS(), 1);
+      if (cids.empty())
+      {
+        inInfo->Remove(vtkCompositeDataPipeline::UPDATE_COMPOSITE_INDICES());
+      }
+      else
+      {
+        inInfo->Set(vtkCompositeDataPipeline::UPDATE_COMPOSITE_INDICES(), cids.data(),
+          static_cast<int>(cids.size()));
+      }
+    }
+  }
+  else
+  {
+    for (int kk = 0; kk < inputVector[0]->GetNumberOfInformationObjects(); kk++)
+    {
+      vtkInformation* inInfo = inputVector[0]->GetInformationObject(kk);
+      inInfo->Remove(vtkCompositeDataPipeline::LOAD_REQUESTED_BLOCKS());
+      inInfo->Remove(vtkCompositeDataPipeline::UPDATE_COMPOSITE_INDICES());
+    }
+  }
+
   // ensure that the ghost-level information is setup correctly to avoid
   // internal faces for unstructured grids.
   for (int cc = 0; cc < this->GetNumberOfInputPorts(); cc++)
@@ -570,9 +711,130 @@ int vtkGeometryRepresentation::RequestData(
     this->GeometryFilter->Modified();
   }
   this->MultiBlockMaker->Update();
+
+  if (this->StreamingCapablePipeline)
+  {
+    // keep a shallow copy of the geometry since the internal pipeline's output
+    // is overwritten by each streaming pass.
+    vtkDataObject* output = this->MultiBlockMaker->GetOutputDataObject(0);
+    vtkSmartPointer<vtkDataObject> clone;
+    clone.TakeReference(output->NewInstance());
+    clone->ShallowCopy(output);
+    if (this->InStreamingUpdate)
+    {
+      this->StreamedPiece = clone;
+    }
+    else
+    {
+      this->StreamedBaseData = clone;
+      this->StreamedPiece = nullptr;
+    }
+
+    // record the size of the blocks, combined across processes before the
+    // next streaming pass to honor StreamingBytesPerFrame.
+    this->StreamingPriorityQueue->ReportStreamedBlocks(this->NumberOfRequestedBlocks,
+      static_cast<vtkTypeUInt64>(clone->GetActualMemorySize()) * 1024);
+  }
+  else
+  {
+    this->StreamedBaseData = nullptr;
+    this->StreamedPiece = nullptr;
+  }
+
+  if (!this->InStreamingUpdate)
+  {
+    // data changed, discard all pieces accumulated on the rendering side.
+    this->StreamedRenderedData = nullptr;
+    this->StreamedRenderedBase = nullptr;
+  }
   return this->Superclass::RequestData(request, inputVector, outputVector);
 }
 
+//----------------------------------------------------------------------------
+bool vtkGeometryRepresentation::StreamingUpdate(const double view_planes[24])
+{
+  assert(this->InStreamingUpdate == false);
+  if (this->StreamingPriorityQueue->IsEmpty())
+  {
+    return false;
+  }
+
+  // update the block size estimate outside of the pipeline execution since
+  // it is collective.
+  this->StreamingPriorityQueue->SynchronizeEstimate();
+
+  this->InStreamingUpdate = true;
+  vtkStreamingStatusMacro(<< this << ": doing streaming-update.");
+
+  // update the priorities using the current camera.
+  this->StreamingPriorityQueue->Update(view_planes);
+
+  // This ensures that the representation re-executes.
+  this->MarkModified();
+
+  // Execute the pipeline.
+  this->Update();
+
+  this->InStreamingUpdate = false;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkGeometryRepresentation::MergeStreamedPiece(
+  vtkDataObject* deliveredData, vtkDataObject* piece)
+{
+  auto pieceTree = vtkDataObjectTree::SafeDownCast(piece);
+  if (!pieceTree || !deliveredData)
+  {
+    return;
+  }
+
+  if (this->StreamedRenderedData == nullptr || this->StreamedRenderedBase != deliveredData)
+  {
+    // start accumulating on top of the delivered data. A shallow copy of a
+    // vtkDataObjectTree creates new internal nodes, hence replacing leaves
+    // below does not affect the delivered data.
+    this->StreamedRenderedData.TakeReference(deliveredData->NewInstance());
+    this->StreamedRenderedData->ShallowCopy(deliveredData);
+    this->StreamedRenderedBase = deliveredData;
+  }
+
+  auto renderedTree = vtkDataObjectTree::SafeDownCast(this->StreamedRenderedData);
+  if (!renderedTree || renderedTree->GetDataObjectType() != pieceTree->GetDataObjectType())
+  {
+    vtkErrorMacro("Streamed piece does not match the delivered data.");
+    return;
+  }
+
+  // Streamed blocks have the same structure as the delivered data with only
+  // the requested leaves being non-empty. Each leaf is streamed only once, so
+  // we simply insert them, appending only if a leaf is split across processes.
+  vtkSmartPointer<vtkDataObjectTreeIterator> iter;
+  iter.TakeReference(pieceTree->NewTreeIterator());
+  iter->VisitOnlyLeavesOn();
+  iter->SkipEmptyNodesOn();
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    vtkDataObject* block = iter->GetCurrentDataObject();
+    vtkDataObject* current = renderedTree->GetDataSet(iter);
+    auto currentPD = vtkPolyData::SafeDownCast(current);
+    auto blockPD = vtkPolyData::SafeDownCast(block);
+    if (currentPD && blockPD && currentPD->GetNumberOfCells() > 0)
+    {
+      vtkNew<vtkAppendPolyData> appender;
+      appender->AddInputData(currentPD);
+      appender->AddInputData(blockPD);
+      appender->Update();
+      renderedTree->SetDataSet(iter, appender->GetOutput());
+    }
+    else
+    {
+      renderedTree->SetDataSet(iter, block);
+    }
+  }
+  renderedTree->Modified();
+}
+
 //----------------------------------------------------------------------------
 bool vtkGeometryRepresentation::GetBounds(
   vtkDataObject* dataObject, double bounds[6], vtkCompositeDataDisplayAttributes* cdAttributes)
@@ -20,7 +20,9 @@
 #include "vtkParaViewDeprecation.h" // for PV_DEPRECATED
 #include "vtkProperty.h"            // needed for VTK_POINTS etc.
 #include "vtkRemotingViewsModule.h" // needed for exports
+#include "vtkSmartPointer.h"        // needed for vtkSmartPointer.
 #include "vtkVector.h"              // for vtkVector.
+#include "vtkWeakPointer.h"         // needed for vtkWeakPointer.
 
 #include <set>           // needed for std::set
 #include <string>        // needed for std::string
@@ -32,6 +34,7 @@ class vtkMapper;
 class vtkPiecewiseFunction;
 class vtkPVGeometryFilter;
 class vtkPVLODActor;
+class vtkPartitionedStreamingPriorityQueue;
 class vtkScalarsToColors;
 class vtkTexture;
 class vtkTransform;
@@ -427,6 +430,21 @@ public:
   vtkGetMacro(PlaceHolderDataType, int);
   ///@}
 
+  ///@{
+  /**
+   * Set/Get the number of bytes the representation may stream per streaming
+   * pass, summed over all data-server processes. This is only used when
+   * streaming is enabled (vtkPVView::SetEnableStreaming) and the input
+   * pipeline is streaming capable i.e. it provides composite meta-data with
+   * block bounds so that the representation can request arbitrary leaf blocks.
+   * In that case, leaf blocks are requested in order of their screen coverage
+   * and centeredness and delivered incrementally to the rendering processes.
+   * At least one block per process is streamed in each pass. Defaults to 16 MiB.
+   */
+  vtkSetClampMacro(StreamingBytesPerFrame, vtkIdType, 1, VTK_ID_MAX);
+  vtkGetMacro(StreamingBytesPerFrame, vtkIdType);
+  ///@}
+
 protected:
   vtkGeometryRepresentation();
   ~vtkGeometryRepresentation() override;
@@ -456,12 +474,37 @@ protected:
    */
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
 
+  /**
+   * Overridden to check if the input pipeline is streaming capable i.e.
+   * streaming is enabled and the input provides composite meta-data for a
+   * vtkMultiBlockDataSet or a vtkPartitionedDataSetCollection.
+   */
+  int RequestInformation(vtkInformation* rqst, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override;
+
   /**
    * Overridden to request correct ghost-level to avoid internal surfaces.
+   * When the input pipeline is streaming capable, this also requests the
+   * next batch of leaf blocks as determined by the StreamingPriorityQueue.
    */
   int RequestUpdateExtent(vtkInformation* request, vtkInformationVector** inputVector,
     vtkInformationVector* outputVector) override;
 
+  /**
+   * Returns true if this representation has a "next piece" that it streamed.
+   * This method will update the StreamingPriorityQueue using the view planes
+   * specified and then call Update() on the representation, making it
+   * reexecute and generate the geometry for the next batch of blocks.
+   */
+  bool StreamingUpdate(const double view_planes[24]);
+
+  /**
+   * Called on rendering processes to merge a streamed piece with the data
+   * currently being rendered. `deliveredData` is the data delivered by the
+   * non-streaming pass.
+   */
+  void MergeStreamedPiece(vtkDataObject* deliveredData, vtkDataObject* piece);
+
   /**
    * Adds the representation to the view.  This is called from
    * vtkView::AddRepresentation().  Subclasses should override this method.
@@ -566,6 +609,26 @@ protected:
   // This is used to be able to create the correct placeHolder in RequestData for the client
   int PlaceHolderDataType = VTK_PARTITIONED_DATA_SET_COLLECTION;
 
+  ///@{
+  /**
+   * Streaming support. StreamingCapablePipeline is only valid on data-server
+   * processes since other processes don't have the input pipeline.
+   * StreamedBaseData is the geometry produced by the most recent non-streaming
+   * pass and StreamedPiece the geometry produced by the most recent streaming
+   * pass. StreamedRenderedData accumulates streamed pieces on the rendering
+   * processes on top of StreamedRenderedBase, the delivered base data.
+   */
+  vtkSmartPointer<vtkPartitionedStreamingPriorityQueue> StreamingPriorityQueue;
+  vtkIdType StreamingBytesPerFrame = 16 * 1024 * 1024;
+  bool StreamingCapablePipeline = false;
+  bool InStreamingUpdate = false;
+  unsigned int NumberOfRequestedBlocks = 0;
+  vtkSmartPointer<vtkDataObject> StreamedBaseData;
+  vtkSmartPointer<vtkDataObject> StreamedPiece;
+  vtkSmartPointer<vtkDataObject> StreamedRenderedData;
+  vtkWeakPointer<vtkDataObject> StreamedRenderedBase;
+  ///@}
+
   // These block variables are similar to the ones in vtkCompositeDataDisplayAttributes
   // Some of them are exposed and some others are not because, as of now, they are not needed.
 
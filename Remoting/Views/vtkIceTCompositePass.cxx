@@ -338,7 +338,7 @@ void vtkIceTCompositePass::CleanupContext(const vtkRenderState*) {}
 //----------------------------------------------------------------------------
 void vtkIceTCompositePass::Render(const vtkRenderState* render_state)
 {
-  vtkVLogScopeF(PARAVIEW_LOG_RENDERING_VERBOSITY(), "%s: Render", vtkLogIdentifier(this));
+  PARAVIEW_LOG_SCOPE_F(RENDERING, "%s: Render", vtkLogIdentifier(this));
   vtkOpenGLRenderUtilities::MarkDebugEvent("vtkIceTCompositePass::Render Start");
   this->IceTContext->SetController(this->Controller);
   if (!this->IceTContext->IsValid())
@@ -627,8 +627,7 @@ void vtkIceTCompositePass::Draw(
 //----------------------------------------------------------------------------
 void vtkIceTCompositePass::UpdateTileInformation(const vtkRenderState* render_state)
 {
-  vtkVLogScopeF(
-    PARAVIEW_LOG_RENDERING_VERBOSITY(), "%s: UpdateTileInformation", vtkLogIdentifier(this));
+  PARAVIEW_LOG_SCOPE_F(RENDERING, "%s: UpdateTileInformation", vtkLogIdentifier(this));
 
   const int image_reduction_factor = std::max(1, this->ImageReductionFactor);
   const int numranks = this->Controller ? this->Controller->GetNumberOfProcesses() : 1;
@@ -156,6 +156,33 @@ vtkDataObject* vtkPVDataDeliveryManager::GetDeliveredPiece(
   return item ? item->GetDeliveredDataObject(dataKey, cacheKey) : nullptr;
 }
 
+//----------------------------------------------------------------------------
+void vtkPVDataDeliveryManager::VisitPieces(vtkPVDataRepresentation* repr,
+  const std::function<void(vtkDataObject* data, bool low_res, bool current)>& visitor)
+{
+  const auto id = repr->GetUniqueIdentifier();
+  const auto currentKey = this->GetCacheKey(repr);
+  for (const auto& ipair : this->Internals->ItemsMap)
+  {
+    if (ipair.first.first != id)
+    {
+      continue;
+    }
+    ipair.second.first.VisitDataObjects([&](double cacheKey, vtkDataObject* data) {
+      if (data)
+      {
+        visitor(data, false, cacheKey == currentKey);
+      }
+    });
+    ipair.second.second.VisitDataObjects([&](double cacheKey, vtkDataObject* data) {
+      if (data)
+      {
+        visitor(data, true, cacheKey == currentKey);
+      }
+    });
+  }
+}
+
 //----------------------------------------------------------------------------
 vtkAlgorithmOutput* vtkPVDataDeliveryManager::GetProducer(
   vtkPVDataRepresentation* repr, bool low_res, int port)
@@ -186,8 +213,8 @@ vtkInformation* vtkPVDataDeliveryManager::GetPieceInformation(
 bool vtkPVDataDeliveryManager::NeedsDelivery(
   vtkMTimeType timestamp, std::vector<unsigned int>& keys_to_deliver, bool low_res)
 {
-  vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "check for delivery (low_res=%s)",
-    (low_res ? "true" : "false"));
+  PARAVIEW_LOG_SCOPE_F(
+    DATA_MOVEMENT, "check for delivery (low_res=%s)", (low_res ? "true" : "false"));
   assert(this->View);
   vtkInternals::ItemsMapType::iterator iter;
   for (iter = this->Internals->ItemsMap.begin(); iter != this->Internals->ItemsMap.end(); ++iter)
@@ -230,8 +257,8 @@ void vtkPVDataDeliveryManager::Deliver(int low_res, unsigned int size, unsigned
 
   assert(size % 2 == 0);
 
-  vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "%s data migration",
-    (low_res ? "low-resolution" : "full resolution"));
+  PARAVIEW_LOG_SCOPE_F(
+    DATA_MOVEMENT, "%s data migration", (low_res ? "low-resolution" : "full resolution"));
   for (unsigned int cc = 0; cc < size; cc += 2)
   {
     const unsigned int id = values[cc];
@@ -247,8 +274,7 @@ void vtkPVDataDeliveryManager::Deliver(int low_res, unsigned int size, unsigned
         // doesn't deadlock (esp. in collaboration mode).
         continue;
       }
-      vtkVLogScopeF(
-        PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "move-data: %s", repr->GetLogName().c_str());
+      PARAVIEW_LOG_SCOPE_F(DATA_MOVEMENT, "move-data: %s", repr->GetLogName().c_str());
       this->MoveData(repr, low_res != 0, port);
     }
   }
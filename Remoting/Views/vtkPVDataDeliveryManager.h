@@ -30,7 +30,8 @@ class vtkInformation;
 class vtkPVDataRepresentation;
 class vtkPVView;
 
-#include <vector> // for std::vector
+#include <functional> // for std::function
+#include <vector>     // for std::vector
 
 class VTKREMOTINGVIEWS_EXPORT vtkPVDataDeliveryManager : public vtkObject
 {
@@ -95,6 +96,15 @@ public:
    */
   void ClearCache(vtkPVDataRepresentation* repr);
 
+  /**
+   * Calls `visitor` for every data object held for the representation i.e.
+   * the pieces set using `SetPiece` and the delivered pieces, at full and low
+   * resolution, for all cache keys. `current` is true for the pieces of the
+   * cache key currently used by the representation and false for cached ones.
+   */
+  void VisitPieces(vtkPVDataRepresentation* repr,
+    const std::function<void(vtkDataObject* data, bool low_res, bool current)>& visitor);
+
   ///@{
   /**
    * Provides access to the producer port for the geometry of a registered
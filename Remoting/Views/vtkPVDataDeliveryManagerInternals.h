@@ -178,6 +178,19 @@ public:
       return store.Information;
     }
 
+    template <typename Visitor>
+    void VisitDataObjects(Visitor&& visitor) const
+    {
+      for (const auto& pair : this->Data)
+      {
+        visitor(pair.first, pair.second.DataObject.GetPointer());
+        for (const auto& delivered : pair.second.DeliveredDataObjects)
+        {
+          visitor(pair.first, delivered.second.GetPointer());
+        }
+      }
+    }
+
     vtkMTimeType GetTimeStamp() const { return this->TimeStamp; }
     vtkMTimeType GetDeliveryTimeStamp(int dataKey, double cacheKey) const
     {
@@ -12,6 +12,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkPVCompositeDataPipeline.h"
 #include "vtkPVDataRepresentationPipeline.h"
+#include "vtkPVHoverLocator.h"
 #include "vtkPVTrivialProducer.h"
 #include "vtkPVView.h"
 #include "vtkSmartPointer.h"
@@ -330,6 +331,19 @@ vtkMTimeType vtkPVDataRepresentation::GetPipelineDataTime()
   return vtkMTimeType();
 }
 
+//----------------------------------------------------------------------------
+vtkPVHoverLocator* vtkPVDataRepresentation::GetHoverLocator()
+{
+  if (!this->HoverLocator)
+  {
+    this->HoverLocator = vtk::TakeSmartPointer(vtkPVHoverLocator::New());
+  }
+  const bool hasInput =
+    this->GetNumberOfInputPorts() > 0 && this->GetNumberOfInputConnections(0) > 0;
+  this->HoverLocator->SetDataObject(hasInput ? this->GetInputDataObject(0, 0) : nullptr);
+  return this->HoverLocator;
+}
+
 //----------------------------------------------------------------------------
 bool vtkPVDataRepresentation::GetNeedsUpdate()
 {
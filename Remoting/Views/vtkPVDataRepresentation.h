@@ -15,10 +15,12 @@
 #include "vtkCommand.h" // needed for vtkCommand
 #include "vtkDataRepresentation.h"
 #include "vtkRemotingViewsModule.h" // needed for exports
+#include "vtkSmartPointer.h"        // needed for vtkSmartPointer
 #include "vtkWeakPointer.h"         // needed for vtkWeakPointer
 #include <string>                   // needed for string
 
 class vtkInformationRequestKey;
+class vtkPVHoverLocator;
 
 class VTKREMOTINGVIEWS_EXPORT vtkPVDataRepresentation : public vtkDataRepresentation
 {
@@ -226,6 +228,14 @@ public:
   virtual void SetArrayIdNames(
     const char* vtkNotUsed(pointArray), const char* vtkNotUsed(cellArray)){};
 
+  /**
+   * Returns the locator used to answer hover queries (see
+   * vtkPVHoverInformation) on the input of this representation. The locator is
+   * created on first use and its cached structures are only rebuilt when the
+   * input data changes.
+   */
+  vtkPVHoverLocator* GetHoverLocator();
+
 protected:
   vtkPVDataRepresentation();
   ~vtkPVDataRepresentation() override;
@@ -264,6 +274,7 @@ private:
   Internals* Implementation;
   vtkWeakPointer<vtkView> View;
   std::string LogName;
+  vtkSmartPointer<vtkPVHoverLocator> HoverLocator;
 };
 
 #endif
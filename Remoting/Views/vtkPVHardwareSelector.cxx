@@ -3,27 +3,154 @@
 #include "vtkPVHardwareSelector.h"
 
 #include "vtkCamera.h"
+#include "vtkIdTypeArray.h"
+#include "vtkInformation.h"
 #include "vtkMultiProcessController.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVLogger.h"
 #include "vtkPVRenderView.h"
 #include "vtkPVRenderViewSettings.h"
 #include "vtkProcessModule.h"
 #include "vtkRenderer.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkSelection.h"
+#include "vtkSelectionNode.h"
 #include "vtkWeakPointer.h"
 
+#include <algorithm>
+#include <functional>
 #include <map>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 //#define vtkPVHardwareSelectorDEBUG
 #ifdef vtkPVHardwareSelectorDEBUG
 #include "vtkImageImport.h"
-#include "vtkNew.h"
 #include "vtkPNMWriter.h"
 #include "vtkWindows.h" // OK on Unix etc
 #include <sstream>
 #endif
 
+namespace
+{
+// Compact representation of vtkHardwareSelector::PixelInformation that is
+// cached for each pixel of the captured area. PropID is -1 for invalid pixels.
+struct vtkDecodedPixel
+{
+  int PropID = -1;
+  int ProcessID = -1;
+  unsigned int CompositeID = 0;
+  vtkIdType AttributeID = -1;
+};
+
+// Identifies a selected block i.e. the prop, process and composite index that
+// become a vtkSelectionNode.
+struct vtkDecodedPixelKey
+{
+  int PropID;
+  int ProcessID;
+  unsigned int CompositeID;
+
+  bool operator==(const vtkDecodedPixelKey& other) const
+  {
+    return this->PropID == other.PropID && this->ProcessID == other.ProcessID &&
+      this->CompositeID == other.CompositeID;
+  }
+};
+
+struct vtkDecodedPixelKeyHash
+{
+  std::size_t operator()(const vtkDecodedPixelKey& key) const
+  {
+    std::size_t hash = std::hash<int>()(key.PropID);
+    hash ^= std::hash<int>()(key.ProcessID) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    hash ^= std::hash<unsigned int>()(key.CompositeID) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    return hash;
+  }
+};
+
+struct vtkSelectedIds
+{
+  std::unordered_set<vtkIdType> AttributeIds;
+  vtkIdType PixelCount = 0;
+};
+
+using vtkSelectedIdsMap =
+  std::unordered_map<vtkDecodedPixelKey, vtkSelectedIds, vtkDecodedPixelKeyHash>;
+
+// Functor used to collect the unique IDs in a region of the decoded pixels.
+// Each thread accumulates into its own hash-map which are merged in Reduce().
+class vtkCollectSelectedIds
+{
+public:
+  vtkCollectSelectedIds(const std::vector<vtkDecodedPixel>& pixels, unsigned int width,
+    unsigned int x1, unsigned int x2)
+    : Pixels(pixels)
+    , Width(width)
+    , X1(x1)
+    , X2(x2)
+  {
+  }
+
+  void Initialize() {}
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkSelectedIdsMap& local = this->LocalIds.Local();
+    for (vtkIdType row = begin; row < end; ++row)
+    {
+      const std::size_t offset = static_cast<std::size_t>(row) * this->Width;
+      for (unsigned int xx = this->X1; xx <= this->X2; ++xx)
+      {
+        const vtkDecodedPixel& pixel = this->Pixels[offset + xx];
+        if (pixel.PropID < 0)
+        {
+          continue;
+        }
+        vtkSelectedIds& ids =
+          local[vtkDecodedPixelKey{ pixel.PropID, pixel.ProcessID, pixel.CompositeID }];
+        ids.PixelCount++;
+        ids.AttributeIds.insert(pixel.AttributeID);
+      }
+    }
+  }
+
+  void Reduce()
+  {
+    for (auto& local : this->LocalIds)
+    {
+      for (auto& item : local)
+      {
+        vtkSelectedIds& ids = this->Result[item.first];
+        ids.PixelCount += item.second.PixelCount;
+        if (ids.AttributeIds.empty())
+        {
+          ids.AttributeIds.swap(item.second.AttributeIds);
+        }
+        else
+        {
+          ids.AttributeIds.insert(item.second.AttributeIds.begin(), item.second.AttributeIds.end());
+        }
+      }
+    }
+  }
+
+  vtkSelectedIdsMap Result;
+
+private:
+  const std::vector<vtkDecodedPixel>& Pixels;
+  const unsigned int Width;
+  const unsigned int X1;
+  const unsigned int X2;
+  vtkSMPThreadLocal<vtkSelectedIdsMap> LocalIds;
+};
+}
+
 class vtkPVHardwareSelector::vtkInternals
 {
 public:
@@ -31,6 +158,34 @@ public:
   PropMapType PropMap;
 
   vtkWeakPointer<vtkPVRenderView> View;
+
+  ///@{
+  /**
+   * Cache of the decoded pixels for the captured area. Rows are decoded on
+   * demand; DecodedRows tracks the rows that have been decoded. This is cleared
+   * whenever the buffers are captured again. The cache is only valid for the
+   * area, viewport and capture time it was decoded for.
+   */
+  std::vector<vtkDecodedPixel> DecodedPixels;
+  std::vector<char> DecodedRows;
+  unsigned int DecodedArea[4] = { 0, 0, 0, 0 };
+  int DecodedViewport[4] = { 0, 0, 0, 0 };
+  vtkMTimeType DecodedCaptureTime = 0;
+  ///@}
+
+  void ClearDecodedPixels()
+  {
+    this->DecodedPixels.clear();
+    this->DecodedRows.clear();
+  }
+
+  bool IsDecodedFor(
+    const unsigned int area[4], const int viewport[4], vtkMTimeType captureTime) const
+  {
+    return !this->DecodedRows.empty() && this->DecodedCaptureTime == captureTime &&
+      std::equal(area, area + 4, this->DecodedArea) &&
+      std::equal(viewport, viewport + 4, this->DecodedViewport);
+  }
 };
 
 //----------------------------------------------------------------------------
@@ -139,6 +294,157 @@ vtkSelection* vtkPVHardwareSelector::PolygonSelect(int* polygonPoints, vtkIdType
   return this->GeneratePolygonSelection(polygonPoints, count);
 }
 
+//----------------------------------------------------------------------------
+void vtkPVHardwareSelector::DecodePixelRows(unsigned int y1, unsigned int y2)
+{
+  auto& internals = *this->Internals;
+  const unsigned int width = this->Area[2] - this->Area[0] + 1;
+  const unsigned int height = this->Area[3] - this->Area[1] + 1;
+
+  int viewport[4] = { 0, 0, 0, 0 };
+  if (this->Renderer)
+  {
+    const int* origin = this->Renderer->GetOrigin();
+    const int* size = this->Renderer->GetSize();
+    viewport[0] = origin[0];
+    viewport[1] = origin[1];
+    viewport[2] = size[0];
+    viewport[3] = size[1];
+  }
+  const vtkMTimeType captureTime = this->CaptureTime.GetMTime();
+  if (!internals.IsDecodedFor(this->Area, viewport, captureTime))
+  {
+    internals.DecodedPixels.assign(static_cast<std::size_t>(width) * height, vtkDecodedPixel());
+    internals.DecodedRows.assign(height, 0);
+    std::copy(this->Area, this->Area + 4, internals.DecodedArea);
+    std::copy(viewport, viewport + 4, internals.DecodedViewport);
+    internals.DecodedCaptureTime = captureTime;
+  }
+
+  // collect rows that need decoding.
+  std::vector<unsigned int> rows;
+  for (unsigned int yy = y1; yy <= y2; ++yy)
+  {
+    if (!internals.DecodedRows[yy - this->Area[1]])
+    {
+      rows.push_back(yy);
+    }
+  }
+  if (rows.empty())
+  {
+    return;
+  }
+
+  vtkVLogF(PARAVIEW_LOG_RENDERING_VERBOSITY(), "decoding %d rows of selection buffers",
+    static_cast<int>(rows.size()));
+
+  // GetPixelInformation() only reads the captured buffers and the prop map,
+  // hence it's safe to call it from multiple threads.
+  vtkSMPTools::For(0, static_cast<vtkIdType>(rows.size()), [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      const unsigned int yy = rows[cc];
+      vtkDecodedPixel* rowPixels =
+        &internals.DecodedPixels[static_cast<std::size_t>(yy - this->Area[1]) * width];
+      for (unsigned int xx = this->Area[0]; xx <= this->Area[2]; ++xx)
+      {
+        unsigned int pos[2] = { xx, yy };
+        const PixelInformation info = this->GetPixelInformation(pos, 0);
+        vtkDecodedPixel& pixel = rowPixels[xx - this->Area[0]];
+        if (info.Valid)
+        {
+          pixel.PropID = info.PropID;
+          pixel.ProcessID = info.ProcessID;
+          pixel.CompositeID = info.CompositeID;
+          pixel.AttributeID = info.AttributeID;
+        }
+      }
+      internals.DecodedRows[yy - this->Area[1]] = 1;
+    }
+  });
+}
+
+//----------------------------------------------------------------------------
+vtkSelection* vtkPVHardwareSelector::GenerateSelection(
+  unsigned int x1, unsigned int y1, unsigned int x2, unsigned int y2)
+{
+  // clamp the region to the captured area.
+  x1 = std::max(x1, this->Area[0]);
+  y1 = std::max(y1, this->Area[1]);
+  x2 = std::min(x2, this->Area[2]);
+  y2 = std::min(y2, this->Area[3]);
+
+  vtkSelection* sel = vtkSelection::New();
+  if (x1 > x2 || y1 > y2)
+  {
+    return sel;
+  }
+
+  this->DecodePixelRows(y1, y2);
+
+  const unsigned int width = this->Area[2] - this->Area[0] + 1;
+  vtkCollectSelectedIds collector(
+    this->Internals->DecodedPixels, width, x1 - this->Area[0], x2 - this->Area[0]);
+  vtkSMPTools::For(static_cast<vtkIdType>(y1 - this->Area[1]),
+    static_cast<vtkIdType>(y2 - this->Area[1]) + 1, collector);
+
+  // sort the nodes so that the selection does not depend on the order in
+  // which the threads processed the pixels. This uses the same order as
+  // vtkHardwareSelector::ConvertSelection() i.e. process, prop then composite
+  // index.
+  std::vector<std::pair<vtkDecodedPixelKey, vtkSelectedIds*>> nodes;
+  nodes.reserve(collector.Result.size());
+  for (auto& item : collector.Result)
+  {
+    nodes.emplace_back(item.first, &item.second);
+  }
+  std::sort(nodes.begin(), nodes.end(), [](const auto& a, const auto& b) {
+    return std::make_tuple(a.first.ProcessID, a.first.PropID, a.first.CompositeID) <
+      std::make_tuple(b.first.ProcessID, b.first.PropID, b.first.CompositeID);
+  });
+
+  for (const auto& node : nodes)
+  {
+    const vtkDecodedPixelKey& key = node.first;
+    const vtkSelectedIds& selectedIds = *node.second;
+
+    vtkNew<vtkSelectionNode> child;
+    child->SetContentType(vtkSelectionNode::INDICES);
+    switch (this->FieldAssociation)
+    {
+      case vtkDataObject::FIELD_ASSOCIATION_CELLS:
+        child->SetFieldType(vtkSelectionNode::CELL);
+        break;
+
+      case vtkDataObject::FIELD_ASSOCIATION_POINTS:
+        child->SetFieldType(vtkSelectionNode::POINT);
+        break;
+    }
+    vtkInformation* properties = child->GetProperties();
+    properties->Set(vtkSelectionNode::PROP_ID(), key.PropID);
+    properties->Set(vtkSelectionNode::PROP(), this->GetPropFromID(key.PropID));
+    properties->Set(vtkSelectionNode::PIXEL_COUNT(), static_cast<int>(selectedIds.PixelCount));
+    if (key.ProcessID >= 0)
+    {
+      properties->Set(vtkSelectionNode::PROCESS_ID(), key.ProcessID);
+    }
+    properties->Set(vtkSelectionNode::COMPOSITE_INDEX(), static_cast<int>(key.CompositeID));
+
+    std::vector<vtkIdType> values(
+      selectedIds.AttributeIds.begin(), selectedIds.AttributeIds.end());
+    std::sort(values.begin(), values.end());
+
+    vtkNew<vtkIdTypeArray> ids;
+    ids->SetName("SelectedIds");
+    ids->SetNumberOfComponents(1);
+    ids->SetNumberOfTuples(static_cast<vtkIdType>(values.size()));
+    std::copy(values.begin(), values.end(), ids->GetPointer(0));
+    child->SetSelectionList(ids);
+    sel->AddNode(child);
+  }
+  return sel;
+}
+
 //----------------------------------------------------------------------------
 bool vtkPVHardwareSelector::NeedToRenderForSelection()
 {
@@ -185,6 +491,9 @@ void vtkPVHardwareSelector::SavePixelBuffer(int passNo)
 {
   this->Superclass::SavePixelBuffer(passNo);
 
+  // buffers changed, the decoded pixels are no longer valid.
+  this->Internals->ClearDecodedPixels();
+
 #ifdef vtkPVHardwareSelectorDEBUG
   vtkNew<vtkImageImport> ii;
   ii->SetImportVoidPointer(this->PixBuffer[passNo], 1);
@@ -11,6 +11,11 @@
  * This class does not know, however, when the cached buffers are invalid.
  * External logic must explicitly calls InvalidateCachedSelection() to ensure
  * that the cache is not reused.
+ *
+ * In addition to the captured buffers, the IDs decoded from the buffers are
+ * cached as well. Decoding of the pixels and deduplication of the selected IDs
+ * is done in parallel using vtkSMPTools, thus repeated selections over large
+ * regions of an unchanged frame are cheap.
  */
 
 #ifndef vtkPVHardwareSelector_h
@@ -46,6 +51,16 @@ public:
    */
   vtkSelection* PolygonSelect(int* polygonPoints, vtkIdType count);
 
+  ///@{
+  /**
+   * Overridden to decode pixels and collect the selected IDs in parallel.
+   * Decoded pixels are cached until the buffers are captured again.
+   */
+  using vtkOpenGLHardwareSelector::GenerateSelection;
+  vtkSelection* GenerateSelection(
+    unsigned int x1, unsigned int y1, unsigned int x2, unsigned int y2) override;
+  ///@}
+
   /**
    * Returns true when the next call to Select() will result in renders to
    * capture the selection-buffers.
@@ -91,6 +106,12 @@ protected:
 
   void SavePixelBuffer(int passNo) override;
 
+  /**
+   * Decodes rows [y1, y2] of the captured buffers into the decoded-pixels cache,
+   * skipping rows that have already been decoded since the last capture.
+   */
+  void DecodePixelRows(unsigned int y1, unsigned int y2);
+
   vtkTimeStamp CaptureTime;
   int UniqueId;
 
@@ -0,0 +1,350 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkPVHoverInformation.h"
+
+#include "vtkCellData.h"
+#include "vtkClientServerStream.h"
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkMultiProcessController.h"
+#include "vtkMultiProcessStream.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVDataRepresentation.h"
+#include "vtkPVHoverLocator.h"
+#include "vtkPointData.h"
+#include "vtkStringArray.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace
+{
+using ArrayValue = vtkPVHoverInformation::ArrayValue;
+
+//----------------------------------------------------------------------------
+void WriteArrayValues(vtkClientServerStream& css, const std::vector<ArrayValue>& values)
+{
+  css << static_cast<unsigned int>(values.size());
+  for (const auto& value : values)
+  {
+    css << value.Name << value.NumberOfComponents << value.IsString;
+    if (value.IsString)
+    {
+      css << value.StringValue;
+    }
+    else
+    {
+      css << static_cast<unsigned int>(value.Values.size());
+      for (const double& val : value.Values)
+      {
+        css << val;
+      }
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+bool ReadArrayValues(const vtkClientServerStream& css, int& pos, std::vector<ArrayValue>& values)
+{
+  unsigned int count;
+  if (!css.GetArgument(0, pos++, &count))
+  {
+    return false;
+  }
+  values.resize(count);
+  for (auto& value : values)
+  {
+    if (!css.GetArgument(0, pos++, &value.Name) ||
+      !css.GetArgument(0, pos++, &value.NumberOfComponents) ||
+      !css.GetArgument(0, pos++, &value.IsString))
+    {
+      return false;
+    }
+    if (value.IsString)
+    {
+      if (!css.GetArgument(0, pos++, &value.StringValue))
+      {
+        return false;
+      }
+      continue;
+    }
+
+    unsigned int numValues;
+    if (!css.GetArgument(0, pos++, &numValues))
+    {
+      return false;
+    }
+    value.Values.resize(numValues);
+    for (auto& val : value.Values)
+    {
+      if (!css.GetArgument(0, pos++, &val))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+vtkStandardNewMacro(vtkPVHoverInformation);
+//----------------------------------------------------------------------------
+vtkPVHoverInformation::vtkPVHoverInformation()
+  : FieldAssociation(vtkDataObject::FIELD_ASSOCIATION_POINTS)
+  , CompositeIndex(0)
+  , ProcessId(-1)
+  , ElementId(-1)
+  , Found(false)
+  , ResultCompositeIndex(0)
+  , ResultElementId(-1)
+  , Coordinates{ 0.0, 0.0, 0.0 }
+  , CellType(0)
+  , Composite(false)
+{
+}
+
+//----------------------------------------------------------------------------
+vtkPVHoverInformation::~vtkPVHoverInformation() = default;
+
+//----------------------------------------------------------------------------
+void vtkPVHoverInformation::CopyFromObject(vtkObject* obj)
+{
+  auto repr = vtkPVDataRepresentation::SafeDownCast(obj);
+  if (!repr)
+  {
+    vtkErrorMacro("vtkPVHoverInformation can only be gathered from a vtkPVDataRepresentation.");
+    return;
+  }
+
+  auto controller = vtkMultiProcessController::GetGlobalController();
+  const int rank = controller ? controller->GetLocalProcessId() : 0;
+  if (this->ProcessId >= 0 && this->ProcessId != rank)
+  {
+    // the element is on another process.
+    return;
+  }
+
+  vtkPVHoverLocator* locator = repr->GetHoverLocator();
+  const std::string blockName = locator->GetBlockName(this->CompositeIndex);
+  if (this->CopyFromDataSet(locator->GetDataSet(this->CompositeIndex), this->ElementId,
+        locator->IsComposite() ? blockName.c_str() : nullptr))
+  {
+    this->ResultCompositeIndex = this->CompositeIndex;
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVHoverInformation::CopyFromDataSet(vtkDataSet* ds, vtkIdType id, const char* blockName)
+{
+  this->Found = false;
+  this->AttributeValues.clear();
+  this->FieldDataValues.clear();
+
+  const bool cells = (this->FieldAssociation == vtkDataObject::FIELD_ASSOCIATION_CELLS);
+  const vtkIdType count = ds ? (cells ? ds->GetNumberOfCells() : ds->GetNumberOfPoints()) : 0;
+  if (id < 0 || id >= count)
+  {
+    return false;
+  }
+
+  this->Found = true;
+  this->ResultElementId = id;
+  this->Composite = (blockName != nullptr);
+  this->BlockName = blockName ? blockName : "";
+
+  vtkFieldData* attributes;
+  const char* originalIdsName;
+  if (cells)
+  {
+    this->CellType = ds->GetCellType(id);
+    attributes = ds->GetCellData();
+    originalIdsName = "vtkOriginalCellIds";
+  }
+  else
+  {
+    ds->GetPoint(id, this->Coordinates);
+    attributes = ds->GetPointData();
+    originalIdsName = "vtkOriginalPointIds";
+  }
+
+  for (int cc = 0, max = attributes->GetNumberOfArrays(); cc < max; ++cc)
+  {
+    vtkDataArray* array = attributes->GetArray(cc);
+    if (!array || !array->GetName() || strcmp(array->GetName(), originalIdsName) == 0)
+    {
+      continue;
+    }
+    ArrayValue value;
+    value.Name = array->GetName();
+    value.NumberOfComponents = array->GetNumberOfComponents();
+    value.Values.resize(value.NumberOfComponents);
+    array->GetTuple(id, value.Values.data());
+    this->AttributeValues.push_back(std::move(value));
+  }
+
+  // field data arrays with a single tuple.
+  vtkFieldData* fieldData = ds->GetFieldData();
+  for (int cc = 0, max = fieldData ? fieldData->GetNumberOfArrays() : 0; cc < max; ++cc)
+  {
+    vtkAbstractArray* array = fieldData->GetAbstractArray(cc);
+    if (!array || !array->GetName() || array->GetNumberOfTuples() != 1)
+    {
+      continue;
+    }
+
+    ArrayValue value;
+    value.Name = array->GetName();
+    value.NumberOfComponents = array->GetNumberOfComponents();
+    if (auto sarray = vtkStringArray::SafeDownCast(array))
+    {
+      value.IsString = true;
+      value.StringValue = sarray->GetValue(0);
+    }
+    else if (auto darray = vtkDataArray::SafeDownCast(array))
+    {
+      const int numComps = std::min<int>(
+        value.NumberOfComponents, vtkPVHoverInformation::MaximumNumberOfFieldDataComponents);
+      value.Values.resize(numComps);
+      for (int comp = 0; comp < numComps; ++comp)
+      {
+        value.Values[comp] = darray->GetComponent(0, comp);
+      }
+    }
+    else
+    {
+      continue;
+    }
+    this->FieldDataValues.push_back(std::move(value));
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVHoverInformation::AddInformation(vtkPVInformation* info)
+{
+  auto other = vtkPVHoverInformation::SafeDownCast(info);
+  if (!other || !other->Found)
+  {
+    return;
+  }
+
+  // the element is found on a single process, unless it is duplicated on
+  // process boundaries in which case the first one is kept.
+  if (!this->Found)
+  {
+    this->Found = true;
+    this->ResultCompositeIndex = other->ResultCompositeIndex;
+    this->ResultElementId = other->ResultElementId;
+    std::copy(other->Coordinates, other->Coordinates + 3, this->Coordinates);
+    this->CellType = other->CellType;
+    this->Composite = other->Composite;
+    this->BlockName = other->BlockName;
+    this->AttributeValues = other->AttributeValues;
+    this->FieldDataValues = other->FieldDataValues;
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVHoverInformation::CopyToStream(vtkClientServerStream* css)
+{
+  css->Reset();
+  *css << vtkClientServerStream::Reply << this->Found;
+  if (this->Found)
+  {
+    *css << this->ResultCompositeIndex << static_cast<vtkTypeInt64>(this->ResultElementId)
+         << this->Coordinates[0] << this->Coordinates[1] << this->Coordinates[2]
+         << this->CellType << this->Composite << this->BlockName;
+    ::WriteArrayValues(*css, this->AttributeValues);
+    ::WriteArrayValues(*css, this->FieldDataValues);
+  }
+  *css << vtkClientServerStream::End;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVHoverInformation::CopyFromStream(const vtkClientServerStream* css)
+{
+  int pos = 0;
+  this->Found = false;
+  this->AttributeValues.clear();
+  this->FieldDataValues.clear();
+
+  bool found;
+  if (!css->GetArgument(0, pos++, &found))
+  {
+    vtkErrorMacro("Error parsing found flag from message.");
+    return;
+  }
+  if (!found)
+  {
+    return;
+  }
+
+  vtkTypeInt64 elementId;
+  if (!css->GetArgument(0, pos++, &this->ResultCompositeIndex) ||
+    !css->GetArgument(0, pos++, &elementId) ||
+    !css->GetArgument(0, pos++, &this->Coordinates[0]) ||
+    !css->GetArgument(0, pos++, &this->Coordinates[1]) ||
+    !css->GetArgument(0, pos++, &this->Coordinates[2]) ||
+    !css->GetArgument(0, pos++, &this->CellType) || !css->GetArgument(0, pos++, &this->Composite) ||
+    !css->GetArgument(0, pos++, &this->BlockName))
+  {
+    vtkErrorMacro("Error parsing element information from message.");
+    return;
+  }
+  this->ResultElementId = static_cast<vtkIdType>(elementId);
+
+  if (!::ReadArrayValues(*css, pos, this->AttributeValues) ||
+    !::ReadArrayValues(*css, pos, this->FieldDataValues))
+  {
+    vtkErrorMacro("Error parsing array values from message.");
+    this->AttributeValues.clear();
+    this->FieldDataValues.clear();
+    return;
+  }
+  this->Found = true;
+}
+
+#define VTK_HOVER_MAGIC_NUMBER 608819
+//----------------------------------------------------------------------------
+void vtkPVHoverInformation::CopyParametersToStream(vtkMultiProcessStream& mps)
+{
+  this->Superclass::CopyParametersToStream(mps);
+  static constexpr vtkTypeUInt32 magic_number = VTK_HOVER_MAGIC_NUMBER;
+  mps << magic_number << this->FieldAssociation << this->CompositeIndex << this->ProcessId
+      << static_cast<vtkTypeInt64>(this->ElementId);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVHoverInformation::CopyParametersFromStream(vtkMultiProcessStream& mps)
+{
+  this->Superclass::CopyParametersFromStream(mps);
+  vtkTypeUInt32 magic_number;
+  vtkTypeInt64 elementId;
+  mps >> magic_number >> this->FieldAssociation >> this->CompositeIndex >> this->ProcessId >>
+    elementId;
+  if (magic_number != VTK_HOVER_MAGIC_NUMBER)
+  {
+    vtkErrorMacro("Magic number mismatch.");
+  }
+  this->ElementId = static_cast<vtkIdType>(elementId);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVHoverInformation::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "FieldAssociation: " << this->FieldAssociation << endl;
+  os << indent << "CompositeIndex: " << this->CompositeIndex << endl;
+  os << indent << "ProcessId: " << this->ProcessId << endl;
+  os << indent << "ElementId: " << this->ElementId << endl;
+  os << indent << "Found: " << this->Found << endl;
+  if (this->Found)
+  {
+    os << indent << "ResultCompositeIndex: " << this->ResultCompositeIndex << endl;
+    os << indent << "ResultElementId: " << this->ResultElementId << endl;
+    os << indent << "BlockName: " << this->BlockName << endl;
+    os << indent << "NumberOfAttributeValues: " << this->AttributeValues.size() << endl;
+    os << indent << "NumberOfFieldDataValues: " << this->FieldDataValues.size() << endl;
+  }
+}
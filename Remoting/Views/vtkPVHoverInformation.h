@@ -0,0 +1,153 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkPVHoverInformation
+ * @brief   attribute values for a single point or cell under the cursor.
+ *
+ * vtkPVHoverInformation is used to gather the information shown in hover
+ * tooltips directly from a representation. The element is identified by its
+ * id (and composite index), as reported by a surface selection. Lookups use
+ * the vtkPVHoverLocator cached on the representation so that no
+ * extract-selection pipeline needs to be executed, and only the values of the
+ * queried element are transferred back to the client.
+ *
+ * This information must be gathered from a vtkPVDataRepresentation.
+ *
+ * @sa
+ * vtkPVHoverLocator, vtkSMTooltipSelectionPipeline
+ */
+
+#ifndef vtkPVHoverInformation_h
+#define vtkPVHoverInformation_h
+
+#include "vtkPVInformation.h"
+#include "vtkRemotingViewsModule.h" // needed for exports
+
+#include <string> // for std::string
+#include <vector> // for std::vector
+
+class vtkDataSet;
+
+class VTKREMOTINGVIEWS_EXPORT vtkPVHoverInformation : public vtkPVInformation
+{
+public:
+  static vtkPVHoverInformation* New();
+  vtkTypeMacro(vtkPVHoverInformation, vtkPVInformation);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /**
+   * Set/get the type of element to query. Accepted values are
+   * vtkDataObject::FIELD_ASSOCIATION_POINTS and
+   * vtkDataObject::FIELD_ASSOCIATION_CELLS.
+   */
+  vtkSetMacro(FieldAssociation, int);
+  vtkGetMacro(FieldAssociation, int);
+  ///@}
+
+  ///@{
+  /**
+   * The element is identified by CompositeIndex, ProcessId and ElementId, as
+   * provided by a surface selection. A ProcessId of -1 means any process.
+   */
+  vtkSetMacro(CompositeIndex, unsigned int);
+  vtkGetMacro(CompositeIndex, unsigned int);
+  vtkSetMacro(ProcessId, int);
+  vtkGetMacro(ProcessId, int);
+  vtkSetMacro(ElementId, vtkIdType);
+  vtkGetMacro(ElementId, vtkIdType);
+  ///@}
+
+  /**
+   * A single named array value.
+   */
+  struct ArrayValue
+  {
+    std::string Name;
+    int NumberOfComponents = 0;
+    std::vector<double> Values;
+    bool IsString = false;
+    std::string StringValue;
+  };
+
+  /**
+   * Returns true if the queried element was found.
+   */
+  vtkGetMacro(Found, bool);
+
+  ///@{
+  /**
+   * Information about the element found. ResultCompositeIndex and
+   * ResultElementId identify the element in the representation's input.
+   * Coordinates is only set for points and CellType only for cells.
+   */
+  vtkGetMacro(ResultCompositeIndex, unsigned int);
+  vtkGetMacro(ResultElementId, vtkIdType);
+  vtkGetVector3Macro(Coordinates, double);
+  vtkGetMacro(CellType, int);
+  ///@}
+
+  ///@{
+  /**
+   * Returns true and the name of the block if the input is a composite dataset.
+   */
+  vtkGetMacro(Composite, bool);
+  const std::string& GetBlockName() const { return this->BlockName; }
+  ///@}
+
+  ///@{
+  /**
+   * Values of the point (or cell) data arrays for the element, and the field
+   * data arrays with a single tuple. To limit the amount of data transferred,
+   * at most MaximumNumberOfFieldDataComponents components are provided for
+   * field data arrays; ArrayValue::NumberOfComponents is the actual number of
+   * components.
+   */
+  const std::vector<ArrayValue>& GetAttributeValues() const { return this->AttributeValues; }
+  const std::vector<ArrayValue>& GetFieldDataValues() const { return this->FieldDataValues; }
+  static constexpr int MaximumNumberOfFieldDataComponents = 9;
+  ///@}
+
+  /**
+   * Fill the results with the values of the element `id` of `ds`, according
+   * to FieldAssociation. This is what CopyFromObject() does with the leaf of
+   * the representation's input; it can also be used for data already moved to
+   * the client. `blockName` must be nullptr if `ds` is not a leaf of a
+   * composite dataset. Returns false if there is no such element.
+   */
+  bool CopyFromDataSet(vtkDataSet* ds, vtkIdType id, const char* blockName);
+
+  void CopyFromObject(vtkObject*) override;
+  void AddInformation(vtkPVInformation*) override;
+  void CopyToStream(vtkClientServerStream*) override;
+  void CopyFromStream(const vtkClientServerStream*) override;
+  void CopyParametersToStream(vtkMultiProcessStream&) override;
+  void CopyParametersFromStream(vtkMultiProcessStream&) override;
+
+protected:
+  vtkPVHoverInformation();
+  ~vtkPVHoverInformation() override;
+
+  // Parameters
+  int FieldAssociation;
+  unsigned int CompositeIndex;
+  int ProcessId;
+  vtkIdType ElementId;
+
+  // Results
+  bool Found;
+  unsigned int ResultCompositeIndex;
+  vtkIdType ResultElementId;
+  double Coordinates[3];
+  int CellType;
+  bool Composite;
+  std::string BlockName;
+  std::vector<ArrayValue> AttributeValues;
+  std::vector<ArrayValue> FieldDataValues;
+
+private:
+  vtkPVHoverInformation(const vtkPVHoverInformation&) = delete;
+  void operator=(const vtkPVHoverInformation&) = delete;
+};
+
+#endif
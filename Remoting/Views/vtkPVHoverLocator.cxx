@@ -0,0 +1,135 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkPVHoverLocator.h"
+
+#include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDataSet.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVDataUtilities.h"
+#include "vtkPVLogger.h"
+#include "vtkSmartPointer.h"
+#include "vtkWeakPointer.h"
+
+#include <map>
+#include <string>
+
+namespace
+{
+struct vtkHoverBlock
+{
+  vtkSmartPointer<vtkDataSet> DataSet;
+  std::string Name;
+};
+}
+
+class vtkPVHoverLocator::vtkInternals
+{
+public:
+  vtkWeakPointer<vtkDataObject> DataObject;
+  vtkMTimeType DataMTime = 0;
+  bool Composite = false;
+  std::map<unsigned int, vtkHoverBlock> Blocks;
+
+  void Build(vtkDataObject* dobj)
+  {
+    this->Blocks.clear();
+    this->Composite = false;
+    this->DataObject = dobj;
+    this->DataMTime = dobj ? dobj->GetMTime() : 0;
+
+    if (auto cd = vtkCompositeDataSet::SafeDownCast(dobj))
+    {
+      this->Composite = true;
+
+      // names are assigned on a shallow copy to avoid modifying the input.
+      auto copy = vtk::TakeSmartPointer(cd->NewInstance());
+      copy->ShallowCopy(cd);
+      vtkPVDataUtilities::AssignNamesToBlocks(copy);
+
+      auto iter = vtk::TakeSmartPointer(copy->NewIterator());
+      iter->SkipEmptyNodesOn();
+      for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+      {
+        if (auto ds = vtkDataSet::SafeDownCast(iter->GetCurrentDataObject()))
+        {
+          auto& block = this->Blocks[iter->GetCurrentFlatIndex()];
+          block.DataSet = ds;
+          block.Name = vtkPVDataUtilities::GetAssignedNameForBlock(ds);
+        }
+      }
+    }
+    else if (auto ds = vtkDataSet::SafeDownCast(dobj))
+    {
+      this->Blocks[0].DataSet = ds;
+    }
+  }
+
+  vtkHoverBlock* GetBlock(unsigned int compositeIndex)
+  {
+    auto iter = this->Blocks.find(this->Composite ? compositeIndex : 0);
+    return iter != this->Blocks.end() ? &iter->second : nullptr;
+  }
+};
+
+vtkStandardNewMacro(vtkPVHoverLocator);
+//----------------------------------------------------------------------------
+vtkPVHoverLocator::vtkPVHoverLocator()
+  : Internals(new vtkPVHoverLocator::vtkInternals())
+{
+}
+
+//----------------------------------------------------------------------------
+vtkPVHoverLocator::~vtkPVHoverLocator()
+{
+  delete this->Internals;
+  this->Internals = nullptr;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVHoverLocator::SetDataObject(vtkDataObject* dobj)
+{
+  auto& internals = *this->Internals;
+  if (internals.DataObject == dobj && (!dobj || internals.DataMTime == dobj->GetMTime()))
+  {
+    return;
+  }
+
+  vtkVLogF(PARAVIEW_LOG_RENDERING_VERBOSITY(), "rebuilding hover lookup tables");
+  internals.Build(dobj);
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVHoverLocator::IsComposite() const
+{
+  return this->Internals->Composite;
+}
+
+//----------------------------------------------------------------------------
+vtkDataSet* vtkPVHoverLocator::GetDataSet(unsigned int compositeIndex)
+{
+  auto block = this->Internals->GetBlock(compositeIndex);
+  return block ? block->DataSet.GetPointer() : nullptr;
+}
+
+//----------------------------------------------------------------------------
+std::string vtkPVHoverLocator::GetBlockName(unsigned int compositeIndex)
+{
+  auto block = this->Internals->GetBlock(compositeIndex);
+  return block ? block->Name : std::string();
+}
+
+//----------------------------------------------------------------------------
+int vtkPVHoverLocator::GetNumberOfBlocks() const
+{
+  return static_cast<int>(this->Internals->Blocks.size());
+}
+
+//----------------------------------------------------------------------------
+void vtkPVHoverLocator::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Composite: " << this->Internals->Composite << endl;
+  os << indent << "NumberOfBlocks: " << this->GetNumberOfBlocks() << endl;
+}
@@ -0,0 +1,80 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkPVHoverLocator
+ * @brief   cached lookup structures used to answer hover queries.
+ *
+ * vtkPVHoverLocator is a helper used by vtkPVDataRepresentation to answer
+ * point and cell queries made when hovering over a rendered dataset, e.g. to
+ * show tooltips, without having to execute an extract-selection pipeline.
+ *
+ * The locator keeps a table of the leaf datasets keyed by their composite
+ * (flat) index along with their names (as assigned by
+ * vtkPVDataUtilities::AssignNamesToBlocks). The table is rebuilt only when
+ * the data object passed to SetDataObject() changes, or is modified.
+ *
+ * @sa
+ * vtkPVHoverInformation
+ */
+
+#ifndef vtkPVHoverLocator_h
+#define vtkPVHoverLocator_h
+
+#include "vtkObject.h"
+#include "vtkRemotingViewsModule.h" // needed for exports
+
+#include <string> // for std::string
+
+class vtkDataObject;
+class vtkDataSet;
+
+class VTKREMOTINGVIEWS_EXPORT vtkPVHoverLocator : public vtkObject
+{
+public:
+  static vtkPVHoverLocator* New();
+  vtkTypeMacro(vtkPVHoverLocator, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Set the data object to query. Cached tables and locators are preserved if
+   * `dobj` is the same as the one passed in the previous call and has not been
+   * modified since.
+   */
+  void SetDataObject(vtkDataObject* dobj);
+
+  /**
+   * Returns true if the data object is a composite dataset.
+   */
+  bool IsComposite() const;
+
+  /**
+   * Returns the leaf dataset with the given composite index. For non-composite
+   * datasets, `compositeIndex` is ignored. Returns nullptr if no such dataset
+   * exists.
+   */
+  vtkDataSet* GetDataSet(unsigned int compositeIndex);
+
+  /**
+   * Returns the name assigned to the leaf dataset with the given composite
+   * index. Returns an empty string for non-composite datasets.
+   */
+  std::string GetBlockName(unsigned int compositeIndex);
+
+  /**
+   * Returns the number of leaf datasets in the table.
+   */
+  int GetNumberOfBlocks() const;
+
+protected:
+  vtkPVHoverLocator();
+  ~vtkPVHoverLocator() override;
+
+private:
+  vtkPVHoverLocator(const vtkPVHoverLocator&) = delete;
+  void operator=(const vtkPVHoverLocator&) = delete;
+
+  class vtkInternals;
+  vtkInternals* Internals;
+};
+
+#endif
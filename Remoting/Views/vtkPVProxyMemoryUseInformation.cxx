@@ -0,0 +1,408 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkPVProxyMemoryUseInformation.h"
+
+#include "vtkAbstractArray.h"
+#include "vtkAlgorithm.h"
+#include "vtkClientServerStream.h"
+#include "vtkCollection.h"
+#include "vtkCollectionRange.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkFieldData.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVCompositeDataPipeline.h"
+#include "vtkPVDataDeliveryManager.h"
+#include "vtkPVDataRepresentation.h"
+#include "vtkPVSessionBase.h"
+#include "vtkPVSessionCore.h"
+#include "vtkPVView.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
+#include "vtkProcessModule.h"
+#include "vtkSIProxy.h"
+
+#include <algorithm>
+#include <array>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#define vtkVerifyParseMacro(_call, _field)                                                         \
+  if (!(_call))                                                                                    \
+  {                                                                                                \
+    vtkErrorMacro("Error parsing " _field ".");                                                    \
+    return;                                                                                        \
+  }
+
+namespace
+{
+/**
+ * Counts the bytes held by data objects, skipping arrays and data objects that
+ * have already been counted so that shallow copies are attributed once.
+ */
+class vtkMemoryAccountant
+{
+public:
+  vtkTypeInt64 Add(vtkDataObject* data)
+  {
+    vtkTypeInt64 bytes = 0;
+    if (auto cd = vtkCompositeDataSet::SafeDownCast(data))
+    {
+      bytes += this->AddArrays(cd->GetFieldData(), nullptr);
+    }
+    for (auto leaf : vtkCompositeDataSet::GetDataSets<vtkDataObject>(data))
+    {
+      bytes += this->AddLeaf(leaf);
+    }
+    return bytes;
+  }
+
+private:
+  static vtkTypeInt64 GetBytes(vtkAbstractArray* array)
+  {
+    return static_cast<vtkTypeInt64>(array->GetActualMemorySize()) * 1024;
+  }
+
+  vtkTypeInt64 AddArray(vtkAbstractArray* array, vtkTypeInt64* total)
+  {
+    if (!array)
+    {
+      return 0;
+    }
+    if (total)
+    {
+      *total += GetBytes(array);
+    }
+    return this->Seen.insert(array).second ? GetBytes(array) : 0;
+  }
+
+  vtkTypeInt64 AddArrays(vtkFieldData* fd, vtkTypeInt64* total)
+  {
+    vtkTypeInt64 bytes = 0;
+    for (int cc = 0, max = fd ? fd->GetNumberOfArrays() : 0; cc < max; ++cc)
+    {
+      bytes += this->AddArray(fd->GetAbstractArray(cc), total);
+    }
+    return bytes;
+  }
+
+  vtkTypeInt64 AddLeaf(vtkDataObject* data)
+  {
+    if (!data || !this->Seen.insert(data).second)
+    {
+      return 0;
+    }
+
+    // arrays are counted individually, the remainder (cells, structure...) is
+    // attributed with the data object itself.
+    vtkTypeInt64 arrays = 0;
+    vtkTypeInt64 bytes = 0;
+    for (int type = 0; type < vtkDataObject::NUMBER_OF_ATTRIBUTE_TYPES; ++type)
+    {
+      bytes += this->AddArrays(data->GetAttributesAsFieldData(type), &arrays);
+    }
+    if (auto ps = vtkPointSet::SafeDownCast(data))
+    {
+      bytes += this->AddArray(ps->GetPoints() ? ps->GetPoints()->GetData() : nullptr, &arrays);
+    }
+    const vtkTypeInt64 total = static_cast<vtkTypeInt64>(data->GetActualMemorySize()) * 1024;
+    return bytes + std::max<vtkTypeInt64>(total - arrays, 0);
+  }
+
+  std::unordered_set<vtkObjectBase*> Seen;
+};
+}
+
+class vtkPVProxyMemoryUseInformation::vtkInternals
+{
+public:
+  struct vtkEntry
+  {
+    vtkTypeUInt32 GlobalID = 0;
+    std::string XMLGroup;
+    std::string XMLName;
+    std::string VTKClassName;
+    int NumberOfRanks = 1;
+    std::array<std::array<vtkTypeInt64, 3>, NUMBER_OF_CATEGORIES> Bytes{};
+    std::array<double, 3> ExecutionTime{};
+
+    void SetLocal(const std::array<vtkTypeInt64, NUMBER_OF_CATEGORIES>& bytes, double time)
+    {
+      for (int cc = 0; cc < NUMBER_OF_CATEGORIES; ++cc)
+      {
+        this->Bytes[cc].fill(bytes[cc]);
+      }
+      this->ExecutionTime.fill(time);
+    }
+
+    void Merge(const vtkEntry& other)
+    {
+      for (int cc = 0; cc < NUMBER_OF_CATEGORIES; ++cc)
+      {
+        auto& bytes = this->Bytes[cc];
+        bytes[MINIMUM] = std::min(bytes[MINIMUM], other.Bytes[cc][MINIMUM]);
+        bytes[MAXIMUM] = std::max(bytes[MAXIMUM], other.Bytes[cc][MAXIMUM]);
+        bytes[SUM] += other.Bytes[cc][SUM];
+      }
+      this->ExecutionTime[MINIMUM] =
+        std::min(this->ExecutionTime[MINIMUM], other.ExecutionTime[MINIMUM]);
+      this->ExecutionTime[MAXIMUM] =
+        std::max(this->ExecutionTime[MAXIMUM], other.ExecutionTime[MAXIMUM]);
+      this->ExecutionTime[SUM] += other.ExecutionTime[SUM];
+      this->NumberOfRanks += other.NumberOfRanks;
+    }
+  };
+
+  // sorted by global id.
+  std::vector<vtkEntry> Entries;
+
+  const vtkEntry* GetEntry(int index) const
+  {
+    return (index >= 0 && index < static_cast<int>(this->Entries.size()))
+      ? &this->Entries[index]
+      : nullptr;
+  }
+
+  void Add(const vtkEntry& entry)
+  {
+    auto iter = std::lower_bound(this->Entries.begin(), this->Entries.end(), entry.GlobalID,
+      [](const vtkEntry& item, vtkTypeUInt32 id) { return item.GlobalID < id; });
+    if (iter != this->Entries.end() && iter->GlobalID == entry.GlobalID)
+    {
+      iter->Merge(entry);
+    }
+    else
+    {
+      this->Entries.insert(iter, entry);
+    }
+  }
+};
+
+vtkStandardNewMacro(vtkPVProxyMemoryUseInformation);
+//----------------------------------------------------------------------------
+vtkPVProxyMemoryUseInformation::vtkPVProxyMemoryUseInformation()
+  : Internals(new vtkInternals())
+{
+}
+
+//----------------------------------------------------------------------------
+vtkPVProxyMemoryUseInformation::~vtkPVProxyMemoryUseInformation()
+{
+  delete this->Internals;
+  this->Internals = nullptr;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVProxyMemoryUseInformation::CopyFromObject(vtkObject*)
+{
+  this->Internals->Entries.clear();
+
+  auto pm = vtkProcessModule::GetProcessModule();
+  auto session = pm ? vtkPVSessionBase::SafeDownCast(pm->GetSession()) : nullptr;
+  auto core = session ? session->GetSessionCore() : nullptr;
+  if (!core)
+  {
+    return;
+  }
+
+  // objects are sorted by global id, so shared data is attributed to the
+  // proxy created first.
+  vtkNew<vtkCollection> objects;
+  core->GetAllSIObjects(objects);
+
+  vtkMemoryAccountant accountant;
+  for (auto object : vtk::Range(objects.GetPointer()))
+  {
+    auto siProxy = vtkSIProxy::SafeDownCast(object);
+    auto algorithm = siProxy ? vtkAlgorithm::SafeDownCast(siProxy->GetVTKObject()) : nullptr;
+    if (!algorithm)
+    {
+      continue;
+    }
+
+    std::array<vtkTypeInt64, NUMBER_OF_CATEGORIES> bytes{};
+    if (auto repr = vtkPVDataRepresentation::SafeDownCast(algorithm))
+    {
+      auto view = vtkPVView::SafeDownCast(repr->GetView());
+      if (auto manager = view ? view->GetDeliveryManager() : nullptr)
+      {
+        manager->VisitPieces(repr, [&](vtkDataObject* data, bool low_res, bool current) {
+          bytes[low_res ? LOD : (current ? REPRESENTATION : CACHE)] += accountant.Add(data);
+        });
+      }
+    }
+    else
+    {
+      auto executive = algorithm->GetExecutive();
+      for (int port = 0; port < algorithm->GetNumberOfOutputPorts(); ++port)
+      {
+        bytes[OUTPUT] += accountant.Add(executive->GetOutputData(port));
+      }
+    }
+
+    auto executive = vtkPVCompositeDataPipeline::SafeDownCast(algorithm->GetExecutive());
+    const double time = executive ? executive->GetLastExecutionTime() : 0.0;
+
+    vtkInternals::vtkEntry entry;
+    entry.GlobalID = siProxy->GetGlobalID();
+    entry.XMLGroup = siProxy->GetXMLGroup() ? siProxy->GetXMLGroup() : "";
+    entry.XMLName = siProxy->GetXMLName() ? siProxy->GetXMLName() : "";
+    entry.VTKClassName = algorithm->GetClassName();
+    entry.SetLocal(bytes, time);
+    this->Internals->Add(entry);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVProxyMemoryUseInformation::AddInformation(vtkPVInformation* info)
+{
+  auto other = vtkPVProxyMemoryUseInformation::SafeDownCast(info);
+  if (!other)
+  {
+    return;
+  }
+  for (const auto& entry : other->Internals->Entries)
+  {
+    this->Internals->Add(entry);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVProxyMemoryUseInformation::CopyToStream(vtkClientServerStream* css)
+{
+  css->Reset();
+  *css << vtkClientServerStream::Reply
+       << static_cast<vtkTypeUInt32>(this->Internals->Entries.size());
+  for (const auto& entry : this->Internals->Entries)
+  {
+    *css << entry.GlobalID << entry.XMLGroup << entry.XMLName << entry.VTKClassName
+         << entry.NumberOfRanks;
+    for (const auto& bytes : entry.Bytes)
+    {
+      *css << bytes[MINIMUM] << bytes[MAXIMUM] << bytes[SUM];
+    }
+    *css << entry.ExecutionTime[MINIMUM] << entry.ExecutionTime[MAXIMUM]
+         << entry.ExecutionTime[SUM];
+  }
+  *css << vtkClientServerStream::End;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVProxyMemoryUseInformation::CopyFromStream(const vtkClientServerStream* css)
+{
+  auto& entries = this->Internals->Entries;
+  entries.clear();
+
+  int offset = 0;
+  vtkTypeUInt32 count = 0;
+  vtkVerifyParseMacro(css->GetArgument(0, offset++, &count), "count");
+  entries.resize(count);
+  for (auto& entry : entries)
+  {
+    vtkVerifyParseMacro(css->GetArgument(0, offset++, &entry.GlobalID), "GlobalID");
+    vtkVerifyParseMacro(css->GetArgument(0, offset++, &entry.XMLGroup), "XMLGroup");
+    vtkVerifyParseMacro(css->GetArgument(0, offset++, &entry.XMLName), "XMLName");
+    vtkVerifyParseMacro(css->GetArgument(0, offset++, &entry.VTKClassName), "VTKClassName");
+    vtkVerifyParseMacro(css->GetArgument(0, offset++, &entry.NumberOfRanks), "NumberOfRanks");
+    for (auto& bytes : entry.Bytes)
+    {
+      for (auto& value : bytes)
+      {
+        vtkVerifyParseMacro(css->GetArgument(0, offset++, &value), "Bytes");
+      }
+    }
+    for (auto& value : entry.ExecutionTime)
+    {
+      vtkVerifyParseMacro(css->GetArgument(0, offset++, &value), "ExecutionTime");
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+int vtkPVProxyMemoryUseInformation::GetNumberOfProxies() const
+{
+  return static_cast<int>(this->Internals->Entries.size());
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt32 vtkPVProxyMemoryUseInformation::GetGlobalID(int index) const
+{
+  auto entry = this->Internals->GetEntry(index);
+  return entry ? entry->GlobalID : 0;
+}
+
+//----------------------------------------------------------------------------
+const char* vtkPVProxyMemoryUseInformation::GetXMLGroup(int index) const
+{
+  auto entry = this->Internals->GetEntry(index);
+  return entry ? entry->XMLGroup.c_str() : nullptr;
+}
+
+//----------------------------------------------------------------------------
+const char* vtkPVProxyMemoryUseInformation::GetXMLName(int index) const
+{
+  auto entry = this->Internals->GetEntry(index);
+  return entry ? entry->XMLName.c_str() : nullptr;
+}
+
+//----------------------------------------------------------------------------
+const char* vtkPVProxyMemoryUseInformation::GetVTKClassName(int index) const
+{
+  auto entry = this->Internals->GetEntry(index);
+  return entry ? entry->VTKClassName.c_str() : nullptr;
+}
+
+//----------------------------------------------------------------------------
+int vtkPVProxyMemoryUseInformation::GetNumberOfRanks(int index) const
+{
+  auto entry = this->Internals->GetEntry(index);
+  return entry ? entry->NumberOfRanks : 0;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeInt64 vtkPVProxyMemoryUseInformation::GetBytes(int index, int category, int summary) const
+{
+  auto entry = this->Internals->GetEntry(index);
+  if (!entry || category < 0 || category >= NUMBER_OF_CATEGORIES || summary < MINIMUM ||
+    summary > SUM)
+  {
+    return 0;
+  }
+  return entry->Bytes[category][summary];
+}
+
+//----------------------------------------------------------------------------
+vtkTypeInt64 vtkPVProxyMemoryUseInformation::GetTotalBytes(int index, int summary) const
+{
+  vtkTypeInt64 total = 0;
+  for (int cc = 0; cc < NUMBER_OF_CATEGORIES; ++cc)
+  {
+    total += this->GetBytes(index, cc, summary);
+  }
+  return total;
+}
+
+//----------------------------------------------------------------------------
+double vtkPVProxyMemoryUseInformation::GetLastExecutionTime(int index, int summary) const
+{
+  auto entry = this->Internals->GetEntry(index);
+  return (entry && summary >= MINIMUM && summary <= SUM) ? entry->ExecutionTime[summary] : 0.0;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVProxyMemoryUseInformation::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfProxies: " << this->GetNumberOfProxies() << endl;
+  for (const auto& entry : this->Internals->Entries)
+  {
+    os << indent.GetNextIndent() << entry.GlobalID << " (" << entry.XMLGroup << ", "
+       << entry.XMLName << "): ";
+    for (int cc = 0; cc < NUMBER_OF_CATEGORIES; ++cc)
+    {
+      os << entry.Bytes[cc][SUM] << " ";
+    }
+    os << "bytes, " << entry.ExecutionTime[MAXIMUM] << " s" << endl;
+  }
+}
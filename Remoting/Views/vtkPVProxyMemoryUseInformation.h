@@ -0,0 +1,126 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class vtkPVProxyMemoryUseInformation
+ * @brief attributes memory use and execution time to source and
+ * representation proxies.
+ *
+ * While vtkPVMemoryUseInformation reports the memory used by each process as
+ * a whole, vtkPVProxyMemoryUseInformation attributes the bytes held by data
+ * objects to the proxies holding them, on every process it is gathered from:
+ *
+ * - for sources and filters, the output data objects.
+ * - for representations, the pieces held by the view's data delivery manager,
+ *   split between the pieces for the current time (or cache key), the pieces
+ *   cached for other times and the low resolution (LOD) pieces.
+ *
+ * Arrays and data objects shared between proxies, e.g. through shallow
+ * copies, are only counted once, for the proxy with the smallest global id,
+ * which is usually the upstream one. The wall time spent in the last
+ * execution is also reported for each proxy.
+ *
+ * The values are summarized across ranks as minimum, maximum and sum. It is
+ * gathered with a global id of 0.
+ *
+ * Note that proxies are reported by global id, so the sub-proxies of a
+ * representation proxy, which hold the data, are reported separately.
+ */
+
+#ifndef vtkPVProxyMemoryUseInformation_h
+#define vtkPVProxyMemoryUseInformation_h
+
+#include "vtkPVInformation.h"
+#include "vtkRemotingViewsModule.h" //needed for exports
+
+class VTKREMOTINGVIEWS_EXPORT vtkPVProxyMemoryUseInformation : public vtkPVInformation
+{
+public:
+  static vtkPVProxyMemoryUseInformation* New();
+  vtkTypeMacro(vtkPVProxyMemoryUseInformation, vtkPVInformation);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Transfer information about a single object into this object.
+   */
+  void CopyFromObject(vtkObject*) override;
+
+  /**
+   * Merge another information object.
+   */
+  void AddInformation(vtkPVInformation*) override;
+
+  ///@{
+  /**
+   * Manage a serialized version of the information.
+   */
+  void CopyToStream(vtkClientServerStream*) override;
+  void CopyFromStream(const vtkClientServerStream*) override;
+  ///@}
+
+  enum Categories
+  {
+    OUTPUT = 0,
+    REPRESENTATION = 1,
+    CACHE = 2,
+    LOD = 3,
+    NUMBER_OF_CATEGORIES = 4
+  };
+
+  enum Summaries
+  {
+    MINIMUM = 0,
+    MAXIMUM = 1,
+    SUM = 2
+  };
+
+  /**
+   * Returns the number of proxies memory is attributed to.
+   */
+  int GetNumberOfProxies() const;
+
+  ///@{
+  /**
+   * Returns the identification of the proxy at the given index.
+   */
+  vtkTypeUInt32 GetGlobalID(int index) const;
+  const char* GetXMLGroup(int index) const;
+  const char* GetXMLName(int index) const;
+  const char* GetVTKClassName(int index) const;
+  ///@}
+
+  /**
+   * Returns the number of ranks that reported the proxy at the given index.
+   */
+  int GetNumberOfRanks(int index) const;
+
+  /**
+   * Returns the bytes held by the proxy at the given index for a category,
+   * summarized across ranks.
+   */
+  vtkTypeInt64 GetBytes(int index, int category, int summary) const;
+
+  /**
+   * Returns the total bytes held by the proxy at the given index, for all
+   * categories, summarized across ranks.
+   */
+  vtkTypeInt64 GetTotalBytes(int index, int summary) const;
+
+  /**
+   * Returns the time, in seconds, spent in the last execution of the proxy at
+   * the given index, summarized across ranks.
+   */
+  double GetLastExecutionTime(int index, int summary) const;
+
+protected:
+  vtkPVProxyMemoryUseInformation();
+  ~vtkPVProxyMemoryUseInformation() override;
+
+private:
+  vtkPVProxyMemoryUseInformation(const vtkPVProxyMemoryUseInformation&) = delete;
+  void operator=(const vtkPVProxyMemoryUseInformation&) = delete;
+
+  class vtkInternals;
+  vtkInternals* Internals;
+};
+
+#endif
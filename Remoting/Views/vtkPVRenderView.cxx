@@ -1417,7 +1417,7 @@ void vtkPVRenderView::SynchronizeForCollaboration()
 //----------------------------------------------------------------------------
 void vtkPVRenderView::Update()
 {
-  vtkVLogScopeF(PARAVIEW_LOG_RENDERING_VERBOSITY(), "%s: Update", this->GetLogName().c_str());
+  PARAVIEW_LOG_SCOPE_F(RENDERING, "%s: Update", this->GetLogName().c_str());
 
   vtkTimerLog::MarkStartEvent("RenderView::Update");
 
@@ -1508,7 +1508,7 @@ void vtkPVRenderView::CopyViewUpdateOptions(vtkPVRenderView* otherView)
 //----------------------------------------------------------------------------
 void vtkPVRenderView::UpdateLOD()
 {
-  vtkVLogScopeF(PARAVIEW_LOG_RENDERING_VERBOSITY(), "%s: UpdateLOD", this->GetLogName().c_str());
+  PARAVIEW_LOG_SCOPE_F(RENDERING, "%s: UpdateLOD", this->GetLogName().c_str());
 
   vtkTimerLog::MarkStartEvent("RenderView::UpdateLOD");
 
@@ -1549,7 +1549,7 @@ void vtkPVRenderView::UpdateLOD()
 //----------------------------------------------------------------------------
 void vtkPVRenderView::StillRender()
 {
-  vtkVLogScopeF(PARAVIEW_LOG_RENDERING_VERBOSITY(), "%s: StillRender", this->GetLogName().c_str());
+  PARAVIEW_LOG_SCOPE_F(RENDERING, "%s: StillRender", this->GetLogName().c_str());
 
   vtkTimerLog::MarkStartEvent("Still Render");
   this->GetRenderWindow()->SetDesiredUpdateRate(0.002);
@@ -1564,8 +1564,7 @@ void vtkPVRenderView::StillRender()
 //----------------------------------------------------------------------------
 void vtkPVRenderView::InteractiveRender()
 {
-  vtkVLogScopeF(
-    PARAVIEW_LOG_RENDERING_VERBOSITY(), "%s: InteractiveRender", this->GetLogName().c_str());
+  PARAVIEW_LOG_SCOPE_F(RENDERING, "%s: InteractiveRender", this->GetLogName().c_str());
 
   vtkTimerLog::MarkStartEvent("Interactive Render");
   this->GetRenderWindow()->SetDesiredUpdateRate(5.0);
@@ -1588,7 +1587,7 @@ void vtkPVRenderView::Render(bool interactive, bool skip_rendering)
     this->GetLocalProcessDoesRendering(interactive ? this->GetUseDistributedRenderingForLODRender()
                                                    : this->GetUseDistributedRenderingForRender()));
 
-  vtkVLogScopeF(PARAVIEW_LOG_RENDERING_VERBOSITY(), "Render(interactive=%s, skip_rendering=%s)",
+  PARAVIEW_LOG_SCOPE_F(RENDERING, "Render(interactive=%s, skip_rendering=%s)",
     (interactive ? "true" : "false"), (skip_rendering ? "true" : "false"));
 
   this->UpdateStereoProperties();
@@ -1677,8 +1676,8 @@ void vtkPVRenderView::Render(bool interactive, bool skip_rendering)
   if (use_ordered_compositing)
   {
     vtkTimerLog::FormatAndMarkEvent("Using ordered compositing w/ data redistribution, if needed");
-    vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(),
-      "Using ordered compositing w/ data redistribution as needed");
+    PARAVIEW_LOG_SCOPE_F(
+      DATA_MOVEMENT, "Using ordered compositing w/ data redistribution as needed");
     // Let the delivery manager redistribute data as it deems necessary.
     deliveryManager->RedistributeDataForOrderedCompositing(use_lod_rendering);
 
@@ -2355,8 +2354,7 @@ void vtkPVRenderView::UpdateCenterAxes()
 //----------------------------------------------------------------------------
 void vtkPVRenderView::StreamingUpdate(const double view_planes[24])
 {
-  vtkVLogScopeF(
-    PARAVIEW_LOG_RENDERING_VERBOSITY(), "%s: StreamingUpdate", this->GetLogName().c_str());
+  PARAVIEW_LOG_SCOPE_F(RENDERING, "%s: StreamingUpdate", this->GetLogName().c_str());
 
   vtkTimerLog::MarkStartEvent("vtkPVRenderView::StreamingUpdate");
 
@@ -2378,8 +2376,7 @@ void vtkPVRenderView::StreamingUpdate(const double view_planes[24])
 //----------------------------------------------------------------------------
 void vtkPVRenderView::DeliverStreamedPieces(unsigned int size, unsigned int* representation_ids)
 {
-  vtkVLogScopeF(
-    PARAVIEW_LOG_RENDERING_VERBOSITY(), "%s: DeliverStreamedPieces", this->GetLogName().c_str());
+  PARAVIEW_LOG_SCOPE_F(RENDERING, "%s: DeliverStreamedPieces", this->GetLogName().c_str());
 
   // the plan now is to fetch the piece and then simply give it to the
   // representation as "next piece". Representation can decide what to do with
@@ -324,7 +324,7 @@ void vtkPVRenderViewDataDeliveryManager::RedistributeDataForOrderedCompositing(b
       }
       else
       {
-        vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "regenerate kd-tree");
+        PARAVIEW_LOG_SCOPE_F(DATA_MOVEMENT, "regenerate kd-tree");
         this->Cuts = vtkDIYKdTreeUtilities::GenerateCuts(
           data_for_loadbalacing, num_ranks, /*use_cell_centers*/ false, controller);
 
@@ -437,7 +437,7 @@ void vtkPVView::CleanupAfterScreenshot()
 //----------------------------------------------------------------------------
 void vtkPVView::Update()
 {
-  vtkVLogScopeF(PARAVIEW_LOG_RENDERING_VERBOSITY(), "%s: update view", this->GetLogName().c_str());
+  PARAVIEW_LOG_SCOPE_F(RENDERING, "%s: update view", this->GetLogName().c_str());
 
   // Propagate update time.
   const int num_reprs = this->GetNumberOfRepresentations();
@@ -476,8 +476,7 @@ void vtkPVView::Update()
 //----------------------------------------------------------------------------
 void vtkPVView::SynchronizeRepresentationTemporalPipelineStates()
 {
-  vtkVLogScopeF(
-    PARAVIEW_LOG_RENDERING_VERBOSITY(), "%s: sync temporal states", this->GetLogName().c_str());
+  PARAVIEW_LOG_SCOPE_F(RENDERING, "%s: sync temporal states", this->GetLogName().c_str());
 
   std::map<unsigned int, vtkPVDataRepresentation*> repr_map;
   const int num_reprs = this->GetNumberOfRepresentations();
@@ -653,7 +652,7 @@ void vtkPVView::AllReduce(const vtkBoundingBox& arg_source, vtkBoundingBox& dest
 {
   assert(this->Session);
 
-  vtkVLogScopeF(PARAVIEW_LOG_RENDERING_VERBOSITY(), "all-reduce-bounds");
+  PARAVIEW_LOG_SCOPE_F(RENDERING, "all-reduce-bounds");
 
   vtkBoundingBox source = arg_source;
   if (!arg_source.IsValid())
@@ -761,7 +760,7 @@ void vtkPVView::AllReduce(
   const vtkTypeUInt64 arg_source, vtkTypeUInt64& dest, int operation, bool skip_data_server)
 {
   assert(this->Session);
-  vtkVLogScopeF(PARAVIEW_LOG_RENDERING_VERBOSITY(), "all-reduce (op=%d)", operation);
+  PARAVIEW_LOG_SCOPE_F(RENDERING, "all-reduce (op=%d)", operation);
 
   auto evaluator = [operation](vtkTypeUInt64 a, vtkTypeUInt64 b) {
     switch (operation)
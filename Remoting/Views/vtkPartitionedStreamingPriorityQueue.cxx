@@ -0,0 +1,280 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkPartitionedStreamingPriorityQueue.h"
+
+#include "vtkBoundingBox.h"
+#include "vtkCompositeDataPipeline.h"
+#include "vtkDataObjectTree.h"
+#include "vtkDataObjectTreeIterator.h"
+#include "vtkInformation.h"
+#include "vtkMath.h"
+#include "vtkMultiProcessController.h"
+#include "vtkObjectFactory.h"
+#include "vtkSmartPointer.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkStreamingPriorityQueue.h"
+
+#include <algorithm>
+#include <cassert>
+#include <deque>
+#include <vector>
+
+class vtkPartitionedStreamingPriorityQueue::vtkInternals
+{
+public:
+  vtkSmartPointer<vtkDataObjectTree> Metadata;
+  vtkStreamingPriorityQueue<> PriorityQueue;
+
+  // Blocks with no bounds in the meta-data cannot be prioritized using the
+  // view planes. These are streamed after all blocks with bounds.
+  std::deque<unsigned int> UnboundedBlocks;
+
+  vtkBoundingBox Bounds;
+
+  bool HasViewPlanes = false;
+  double ViewPlanes[24];
+
+  // Running totals used to estimate the size of a block. These are global
+  // values i.e. summed over all processes.
+  double StreamedBlocks = 0.0;
+  double StreamedBytes = 0.0;
+
+  // Local values reported since the last SynchronizeEstimate().
+  double PendingBlocks = 0.0;
+  double PendingBytes = 0.0;
+
+  bool PlanesChanged(const double view_planes[24]) const
+  {
+    return !this->HasViewPlanes ||
+      !std::equal(this->ViewPlanes, this->ViewPlanes + 24, view_planes);
+  }
+
+  bool IsEmpty() const { return this->PriorityQueue.empty() && this->UnboundedBlocks.empty(); }
+
+  unsigned int PopOne()
+  {
+    unsigned int id;
+    if (!this->PriorityQueue.empty())
+    {
+      id = this->PriorityQueue.top().Identifier;
+      this->PriorityQueue.pop();
+    }
+    else
+    {
+      id = this->UnboundedBlocks.front();
+      this->UnboundedBlocks.pop_front();
+    }
+    return id;
+  }
+};
+
+vtkStandardNewMacro(vtkPartitionedStreamingPriorityQueue);
+vtkCxxSetObjectMacro(vtkPartitionedStreamingPriorityQueue, Controller, vtkMultiProcessController);
+//----------------------------------------------------------------------------
+vtkPartitionedStreamingPriorityQueue::vtkPartitionedStreamingPriorityQueue()
+{
+  this->Internals = new vtkInternals();
+  this->Controller = nullptr;
+  this->SetController(vtkMultiProcessController::GetGlobalController());
+}
+
+//----------------------------------------------------------------------------
+vtkPartitionedStreamingPriorityQueue::~vtkPartitionedStreamingPriorityQueue()
+{
+  delete this->Internals;
+  this->Internals = nullptr;
+  this->SetController(nullptr);
+}
+
+//----------------------------------------------------------------------------
+bool vtkPartitionedStreamingPriorityQueue::Initialize(vtkDataObjectTree* metadata)
+{
+  auto& internals = *this->Internals;
+  internals.Metadata = metadata;
+  internals.PriorityQueue = vtkStreamingPriorityQueue<>();
+  internals.UnboundedBlocks.clear();
+  internals.Bounds.Reset();
+  if (!metadata)
+  {
+    return false;
+  }
+
+  vtkSmartPointer<vtkDataObjectTreeIterator> iter;
+  iter.TakeReference(metadata->NewTreeIterator());
+  iter->VisitOnlyLeavesOn();
+  // meta-data trees generally have no heavy data, so we must not skip empty
+  // nodes.
+  iter->SkipEmptyNodesOff();
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    vtkInformation* blockInfo = iter->HasCurrentMetaData() ? iter->GetCurrentMetaData() : nullptr;
+    const unsigned int flatIndex = iter->GetCurrentFlatIndex();
+    if (!blockInfo || !blockInfo->Has(vtkStreamingDemandDrivenPipeline::BOUNDS()))
+    {
+      internals.UnboundedBlocks.push_back(flatIndex);
+      continue;
+    }
+
+    vtkStreamingPriorityQueueItem item;
+    item.Identifier = flatIndex;
+    // all leaves are at the same level of detail.
+    item.Refinement = 0;
+
+    double block_bounds[6];
+    blockInfo->Get(vtkStreamingDemandDrivenPipeline::BOUNDS(), block_bounds);
+    item.Bounds.SetBounds(block_bounds);
+    if (!item.Bounds.IsValid())
+    {
+      // UpdatePriorities() ignores invalid bounds, such blocks would never be
+      // popped from the priority queue.
+      internals.UnboundedBlocks.push_back(flatIndex);
+      continue;
+    }
+    internals.Bounds.AddBox(item.Bounds);
+    if (blockInfo->Has(vtkCompositeDataPipeline::BLOCK_AMOUNT_OF_DETAIL()))
+    {
+      item.AmountOfDetail = blockInfo->Get(vtkCompositeDataPipeline::BLOCK_AMOUNT_OF_DETAIL());
+    }
+
+    // without view planes, prefer larger blocks; they are more likely to cover
+    // a larger portion of the screen.
+    item.Priority = item.Bounds.GetDiagonalLength();
+    internals.PriorityQueue.push(item);
+  }
+
+  if (internals.HasViewPlanes)
+  {
+    double clamp_bounds[6];
+    vtkMath::UninitializeBounds(clamp_bounds);
+    internals.PriorityQueue.UpdatePriorities(internals.ViewPlanes, clamp_bounds);
+  }
+  return !internals.IsEmpty();
+}
+
+//----------------------------------------------------------------------------
+void vtkPartitionedStreamingPriorityQueue::Reinitialize()
+{
+  if (this->Internals->Metadata)
+  {
+    vtkSmartPointer<vtkDataObjectTree> metadata = this->Internals->Metadata;
+    this->Initialize(metadata);
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkDataObjectTree* vtkPartitionedStreamingPriorityQueue::GetMetaData() const
+{
+  return this->Internals->Metadata;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPartitionedStreamingPriorityQueue::IsEmpty()
+{
+  return this->Internals->IsEmpty();
+}
+
+//----------------------------------------------------------------------------
+void vtkPartitionedStreamingPriorityQueue::Update(const double view_planes[24])
+{
+  auto& internals = *this->Internals;
+  if (!internals.Metadata || !internals.PlanesChanged(view_planes))
+  {
+    return;
+  }
+
+  std::copy(view_planes, view_planes + 24, internals.ViewPlanes);
+  internals.HasViewPlanes = true;
+
+  double clamp_bounds[6];
+  vtkMath::UninitializeBounds(clamp_bounds);
+  internals.PriorityQueue.UpdatePriorities(view_planes, clamp_bounds);
+}
+
+//----------------------------------------------------------------------------
+std::vector<unsigned int> vtkPartitionedStreamingPriorityQueue::PopBlocks(
+  vtkTypeUInt64 byteBudget)
+{
+  auto& internals = *this->Internals;
+  const int num_procs = this->Controller ? this->Controller->GetNumberOfProcesses() : 1;
+  const int myid = this->Controller ? this->Controller->GetLocalProcessId() : 0;
+  assert(myid < num_procs);
+
+  // Each round pops one block per process. Determine how many rounds fit in
+  // the budget; this must result in the same value on all processes, which is
+  // ensured since the estimate is computed from globally reduced values.
+  vtkTypeUInt64 rounds = 1;
+  const double bytesPerBlock = this->GetEstimatedBytesPerBlock();
+  if (bytesPerBlock > 0)
+  {
+    const double bytesPerRound = bytesPerBlock * num_procs;
+    rounds = std::max<vtkTypeUInt64>(1, static_cast<vtkTypeUInt64>(byteBudget / bytesPerRound));
+  }
+
+  std::vector<unsigned int> blocks;
+  for (vtkTypeUInt64 round = 0; round < rounds && !internals.IsEmpty(); ++round)
+  {
+    for (int cc = 0; cc < num_procs && !internals.IsEmpty(); ++cc)
+    {
+      const unsigned int id = internals.PopOne();
+      if (cc == myid)
+      {
+        blocks.push_back(id);
+      }
+    }
+  }
+  return blocks;
+}
+
+//----------------------------------------------------------------------------
+void vtkPartitionedStreamingPriorityQueue::ReportStreamedBlocks(
+  unsigned int numBlocks, vtkTypeUInt64 localBytes)
+{
+  this->Internals->PendingBlocks += numBlocks;
+  this->Internals->PendingBytes += static_cast<double>(localBytes);
+}
+
+//----------------------------------------------------------------------------
+void vtkPartitionedStreamingPriorityQueue::SynchronizeEstimate()
+{
+  auto& internals = *this->Internals;
+  double values[2] = { internals.PendingBlocks, internals.PendingBytes };
+  if (this->Controller && this->Controller->GetNumberOfProcesses() > 1)
+  {
+    double result[2];
+    this->Controller->AllReduce(values, result, 2, vtkCommunicator::SUM_OP);
+    values[0] = result[0];
+    values[1] = result[1];
+  }
+  internals.StreamedBlocks += values[0];
+  internals.StreamedBytes += values[1];
+  internals.PendingBlocks = 0.0;
+  internals.PendingBytes = 0.0;
+}
+
+//----------------------------------------------------------------------------
+double vtkPartitionedStreamingPriorityQueue::GetEstimatedBytesPerBlock() const
+{
+  const auto& internals = *this->Internals;
+  return internals.StreamedBlocks > 0 ? internals.StreamedBytes / internals.StreamedBlocks : 0.0;
+}
+
+//----------------------------------------------------------------------------
+void vtkPartitionedStreamingPriorityQueue::GetBounds(double bounds[6])
+{
+  if (this->Internals->Bounds.IsValid())
+  {
+    this->Internals->Bounds.GetBounds(bounds);
+  }
+  else
+  {
+    vtkMath::UninitializeBounds(bounds);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPartitionedStreamingPriorityQueue::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Controller: " << this->Controller << endl;
+  os << indent << "EstimatedBytesPerBlock: " << this->GetEstimatedBytesPerBlock() << endl;
+}
@@ -0,0 +1,147 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkPartitionedStreamingPriorityQueue
+ * @brief   implements a coverage based priority queue for partitioned
+ * multiblock datasets.
+ *
+ * vtkPartitionedStreamingPriorityQueue is used by representations supporting
+ * streaming of non-AMR composite datasets (vtkMultiBlockDataSet,
+ * vtkPartitionedDataSetCollection) to determine the order in which leaf blocks
+ * are requested from the input pipeline. This class relies on the bounds
+ * provided in the composite meta-data i.e. the
+ * vtkCompositeDataPipeline::COMPOSITE_DATA_META_DATA() produced by the reader.
+ * Priorities are computed using the same screen-coverage and centeredness
+ * metrics as vtkAMRStreamingPriorityQueue (see vtkStreamingPriorityQueue).
+ *
+ * Unlike vtkAMRStreamingPriorityQueue which pops a single block per call,
+ * this class can pop a batch of blocks that is expected to fit within a byte
+ * budget. The size of blocks is estimated from the sizes of the blocks
+ * streamed so far, reported using ReportStreamedBlocks() and combined across
+ * processes by SynchronizeEstimate().
+ *
+ * @sa
+ * vtkAMRStreamingPriorityQueue, vtkGeometryRepresentation
+ */
+
+#ifndef vtkPartitionedStreamingPriorityQueue_h
+#define vtkPartitionedStreamingPriorityQueue_h
+
+#include "vtkObject.h"
+#include "vtkRemotingViewsModule.h" // for export macros
+
+#include <vector> // for std::vector
+
+class vtkDataObjectTree;
+class vtkMultiProcessController;
+
+class VTKREMOTINGVIEWS_EXPORT vtkPartitionedStreamingPriorityQueue : public vtkObject
+{
+public:
+  static vtkPartitionedStreamingPriorityQueue* New();
+  vtkTypeMacro(vtkPartitionedStreamingPriorityQueue, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /**
+   * If the controller is specified, the queue can be used in parallel. So long
+   * as Initialize(), Update(), PopBlocks() and SynchronizeEstimate() are called
+   * on all processes and all process get the same meta-data and view_planes
+   * (which is generally true with ParaView), the blocks are distributed among
+   * the processes. SynchronizeEstimate() is collective.
+   * By default, this is set to the
+   * vtkMultiProcessController::GetGlobalController();
+   */
+  void SetController(vtkMultiProcessController*);
+  vtkGetObjectMacro(Controller, vtkMultiProcessController);
+  ///@}
+
+  /**
+   * Initializes the queue using the composite meta-data. Only leaf nodes are
+   * considered and their flat index is used as the block identifier. Leaves
+   * that do not provide vtkStreamingDemandDrivenPipeline::BOUNDS() are
+   * streamed last. Returns false if the meta-data has no leaves.
+   */
+  bool Initialize(vtkDataObjectTree* metadata);
+
+  /**
+   * Re-initializes the priority queue using the meta-data given to the most
+   * recent call to Initialize(). If view planes were provided to an earlier
+   * Update() call, priorities are recomputed using them. The estimate for
+   * bytes per block is preserved.
+   */
+  void Reinitialize();
+
+  /**
+   * Returns the meta-data passed to the most recent call to Initialize().
+   */
+  vtkDataObjectTree* GetMetaData() const;
+
+  ///@{
+  /**
+   * Updates the priorities of blocks based on the new view frustum planes.
+   * Blocks already popped are not reinserted. This is a no-op if the planes
+   * have not changed since the last call.
+   */
+  void Update(const double view_planes[24]);
+  ///@}
+
+  /**
+   * Returns if the queue is empty.
+   */
+  bool IsEmpty();
+
+  /**
+   * Pops the next batch of blocks for the local process. The number of blocks
+   * popped is chosen so that the estimated size of the blocks streamed by all
+   * processes together does not exceed `byteBudget`, with at least one block
+   * per process. Returns the flat indices of the blocks for this process. The
+   * result may be empty if the queue ran out of blocks for this process.
+   */
+  std::vector<unsigned int> PopBlocks(vtkTypeUInt64 byteBudget);
+
+  /**
+   * Record the number of blocks and the size of the data produced locally for
+   * the most recently popped batch. This only accumulates local values, which
+   * are used by the bytes-per-block estimate after the next call to
+   * SynchronizeEstimate(). It can hence be called while executing a pipeline.
+   */
+  void ReportStreamedBlocks(unsigned int numBlocks, vtkTypeUInt64 localBytes);
+
+  /**
+   * Combine the values recorded by ReportStreamedBlocks() on all processes
+   * since the previous call into the bytes-per-block estimate used by
+   * PopBlocks(), so that all processes pop the same number of blocks. This
+   * method is collective when a controller with more than one process is set
+   * and must be called outside of pipeline execution.
+   */
+  void SynchronizeEstimate();
+
+  /**
+   * Returns the current estimate of the number of bytes per block, or 0 if no
+   * block has been reported yet.
+   */
+  double GetEstimatedBytesPerBlock() const;
+
+  /**
+   * Returns the union of the bounds of all blocks in the meta-data. This is
+   * useful to report full data bounds to the view before all blocks have been
+   * streamed.
+   */
+  void GetBounds(double bounds[6]);
+
+protected:
+  vtkPartitionedStreamingPriorityQueue();
+  ~vtkPartitionedStreamingPriorityQueue() override;
+
+  vtkMultiProcessController* Controller;
+
+private:
+  vtkPartitionedStreamingPriorityQueue(const vtkPartitionedStreamingPriorityQueue&) = delete;
+  void operator=(const vtkPartitionedStreamingPriorityQueue&) = delete;
+
+  class vtkInternals;
+  vtkInternals* Internals;
+};
+
+#endif
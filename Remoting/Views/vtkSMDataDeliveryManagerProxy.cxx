@@ -99,7 +99,7 @@ bool vtkSMDataDeliveryManagerProxy::DeliverStreamedPieces()
   //    reader.
   // 2. Request streamed pieces for those representations.
 
-  vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "deliver geometry (for streaming)");
+  PARAVIEW_LOG_SCOPE_F(DATA_MOVEMENT, "deliver geometry (for streaming)");
 
   vtkNew<vtkPVStreamingPiecesInformation> info;
   this->ViewProxy->GatherInformation(info.GetPointer(), vtkPVSession::DATA_SERVER);
@@ -288,7 +288,11 @@ bool vtkSMImageExtractWriterProxy::WriteImage(
   auto convertedName =
     this->GenerateExtractsFileName(fname, extractor->GetRealExtractsOutputDirectory());
 
+  // images are encoded and written in the background while the next extracts
+  // are generated; the controller waits for them before saving the summary.
+  writer->SetImageWriterQueue(extractor->GetImageWriterQueue());
   const bool status = writer->WriteImage(convertedName.c_str(), vtkPVSession::DATA_SERVER_ROOT);
+  writer->SetImageWriterQueue(nullptr);
   if (status)
   {
     // add to summary
@@ -6,6 +6,7 @@
 #include "vtkErrorCode.h"
 #include "vtkFloatArray.h"
 #include "vtkImageData.h"
+#include "vtkImageWriter.h"
 #include "vtkMultiProcessController.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
@@ -15,6 +16,7 @@
 #include "vtkPointData.h"
 #include "vtkProcessModule.h"
 #include "vtkRenderWindow.h"
+#include "vtkSMImageWriterQueue.h"
 #include "vtkSMParaViewPipelineControllerWithRendering.h"
 #include "vtkSMProperty.h"
 #include "vtkSMPropertyHelper.h"
@@ -247,7 +249,7 @@ public:
     std::pair<vtkSmartPointer<vtkImageData>, vtkSmartPointer<vtkImageData>> result;
     if (this->BothEyes)
     {
-      vtkVLogScopeF(PARAVIEW_LOG_RENDERING_VERBOSITY(), "Capture stereo images");
+      PARAVIEW_LOG_SCOPE_F(RENDERING, "Capture stereo images");
       this->UpdateStereoMode(VTK_STEREO_LEFT, /*restoreable=*/false);
       result.first = this->CaptureImage();
       this->UpdateStereoMode(VTK_STEREO_RIGHT, /*restoreable=*/false);
@@ -255,7 +257,7 @@ public:
     }
     else
     {
-      vtkVLogScopeF(PARAVIEW_LOG_RENDERING_VERBOSITY(), "Capture image");
+      PARAVIEW_LOG_SCOPE_F(RENDERING, "Capture image");
       result.first = this->CaptureImage();
     }
     return result;
@@ -478,10 +480,12 @@ protected:
 //============================================================================
 
 vtkStandardNewMacro(vtkSMSaveScreenshotProxy);
+vtkCxxSetObjectMacro(vtkSMSaveScreenshotProxy, ImageWriterQueue, vtkSMImageWriterQueue);
 //----------------------------------------------------------------------------
 vtkSMSaveScreenshotProxy::vtkSMSaveScreenshotProxy()
   : State(nullptr)
   , UseFloatingPointBuffers(false)
+  , ImageWriterQueue(nullptr)
 {
 }
 
@@ -490,6 +494,7 @@ vtkSMSaveScreenshotProxy::~vtkSMSaveScreenshotProxy()
 {
   delete this->State;
   this->State = nullptr;
+  this->SetImageWriterQueue(nullptr);
 }
 
 //----------------------------------------------------------------------------
@@ -587,7 +592,42 @@ bool vtkSMSaveScreenshotProxy::WriteImage(
     return SymmetricReturnCode(false);
   }
 
-  vtkVLogScopeF(PARAVIEW_LOG_RENDERING_VERBOSITY(), "Save captured image to '%s'", fname);
+  PARAVIEW_LOG_SCOPE_F(RENDERING, "Save captured image to '%s'", fname);
+
+  // save paraview state as metadata
+  const bool embedState = stateXMLRoot && strcmp(format->GetXMLName(), "PNG") == 0;
+  if (embedState)
+  {
+    std::ostringstream stream;
+    stateXMLRoot->PrintXML(stream, vtkIndent());
+    vtkSMPropertyHelper metadata(format, "MetaData");
+    metadata.Set(0, "ParaViewState");
+    metadata.Set(1, stream.str().c_str());
+  }
+
+  // floating point buffers are not copied when captured, hence cannot be
+  // written in the background.
+  if (this->ImageWriterQueue && !this->UseFloatingPointBuffers &&
+    vtkImageWriter::SafeDownCast(format->GetClientSideObject()) &&
+    vtkSMImageWriterQueue::CanWriteLocally(session, location))
+  {
+    // the queue writes using a copy of the format proxy, so the image is
+    // encoded and written while the caller moves on to the next one.
+    bool status = true;
+    if (image_pair.second)
+    {
+      status = this->ImageWriterQueue->WriteImage(
+        format, image_pair.second, this->GetStereoFileName(filename, /*left=*/false));
+      status = this->ImageWriterQueue->WriteImage(
+                 format, image_pair.first, this->GetStereoFileName(filename, /*left=*/true)) &&
+        status;
+    }
+    else
+    {
+      status = this->ImageWriterQueue->WriteImage(format, image_pair.first, filename);
+    }
+    return SymmetricReturnCode(status);
+  }
 
   auto pxm = this->GetSessionProxyManager();
   auto remoteWriter = vtkSmartPointer<vtkSMSourceProxy>::Take(
@@ -601,17 +641,6 @@ bool vtkSMSaveScreenshotProxy::WriteImage(
   vtkTimerLog::MarkStartEvent("Write image to disk");
   auto remoteWriterAlgorithm = vtkAlgorithm::SafeDownCast(remoteWriter->GetClientSideObject());
 
-  // save paraview state as metadata
-  const bool embedState = stateXMLRoot && strcmp(format->GetXMLName(), "PNG") == 0;
-  if (embedState)
-  {
-    std::ostringstream stream;
-    stateXMLRoot->PrintXML(stream, vtkIndent());
-    vtkSMPropertyHelper metadata(format, "MetaData");
-    metadata.Set(0, "ParaViewState");
-    metadata.Set(1, stream.str().c_str());
-  }
-
   if (image_pair.second)
   {
     // write right-eye.
@@ -1058,4 +1087,5 @@ void vtkSMSaveScreenshotProxy::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
   os << indent << "UseFloatingPointBuffers: " << this->UseFloatingPointBuffers << endl;
+  os << indent << "ImageWriterQueue: " << this->ImageWriterQueue << endl;
 }
@@ -26,6 +26,7 @@
 
 class vtkImageData;
 class vtkPVXMLElement;
+class vtkSMImageWriterQueue;
 class vtkSMViewLayoutProxy;
 class vtkSMViewProxy;
 
@@ -48,6 +49,17 @@ public:
   bool WriteImage(const char* filename, vtkTypeUInt32 location = vtkPVSession::CLIENT,
     vtkPVXMLElement* stateXMLRoot = nullptr);
 
+  ///@{
+  /**
+   * When set, images that WriteImage() writes on the local process are handed
+   * over to this queue to be encoded and written in the background, rather than
+   * being written before WriteImage() returns. Errors while writing are then
+   * reported by vtkSMImageWriterQueue::Flush(). Default is nullptr.
+   */
+  void SetImageWriterQueue(vtkSMImageWriterQueue* queue);
+  vtkGetObjectMacro(ImageWriterQueue, vtkSMImageWriterQueue);
+  ///@}
+
   /**
    * Capture the rendered image but doesn't save it out to any file.
    */
@@ -160,6 +172,7 @@ private:
   class vtkStateLayout;
   vtkState* State;
   bool UseFloatingPointBuffers;
+  vtkSMImageWriterQueue* ImageWriterQueue;
 };
 
 #endif
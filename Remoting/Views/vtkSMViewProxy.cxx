@@ -631,7 +631,7 @@ int vtkSMViewProxy::ReadXMLAttributes(vtkSMSessionProxyManager* pm, vtkPVXMLElem
 //----------------------------------------------------------------------------
 vtkImageData* vtkSMViewProxy::CaptureWindow(int magX, int magY)
 {
-  vtkVLogScopeF(PARAVIEW_LOG_RENDERING_VERBOSITY(), "CaptureWindow");
+  PARAVIEW_LOG_SCOPE_F(RENDERING, "CaptureWindow");
   vtkSMViewProxyNS::CaptureHelper helper(this);
   if (auto img = helper.StereoCapture(magX, magY))
   {
@@ -729,12 +729,12 @@ int vtkSMViewProxy::WriteImage(const char* filename, const char* writerName, int
     return vtkErrorCode::UnknownError;
   }
 
-  vtkVLogScopeF(PARAVIEW_LOG_RENDERING_VERBOSITY(), "WriteImage to '%s'", filename);
+  PARAVIEW_LOG_SCOPE_F(RENDERING, "WriteImage to '%s'", filename);
 
   vtkSmartPointer<vtkImageData> shot;
   shot.TakeReference(this->CaptureWindow(magX, magY));
 
-  vtkVLogScopeF(PARAVIEW_LOG_RENDERING_VERBOSITY(), "Save image to disk");
+  PARAVIEW_LOG_SCOPE_F(RENDERING, "Save image to disk");
   if (vtkProcessModule::GetProcessModule()->GetSymmetricMPIMode())
   {
     return vtkSMUtilities::SaveImageOnProcessZero(shot, filename, writerName);
@@ -19,6 +19,7 @@ vtkSpreadSheetRepresentation::vtkSpreadSheetRepresentation()
   this->DataConditioner->SetSplitComponents(true);
   this->DataConditioner->SetSplitComponentsNamingMode(
     vtkSplitColumnComponents::NUMBERS_WITH_UNDERSCORES);
+  this->DataConditioner->SetUseImplicitArrays(true);
   this->CleanArrays->SetInputConnection(this->DataConditioner->GetOutputPort());
   this->CleanArrays->SetFillPartialArrays(true);
   this->CleanArrays->SetMarkFilledPartialArrays(true);
@@ -27,6 +28,7 @@ vtkSpreadSheetRepresentation::vtkSpreadSheetRepresentation()
   this->ExtractedDataConditioner->SetSplitComponents(true);
   this->ExtractedDataConditioner->SetSplitComponentsNamingMode(
     vtkSplitColumnComponents::NUMBERS_WITH_UNDERSCORES);
+  this->ExtractedDataConditioner->SetUseImplicitArrays(true);
   this->ExtractedCleanArrays->SetInputConnection(this->ExtractedDataConditioner->GetOutputPort());
   this->ExtractedCleanArrays->SetFillPartialArrays(true);
   this->ExtractedCleanArrays->SetMarkFilledPartialArrays(true);
@@ -801,7 +801,7 @@ void vtkSpreadSheetView::Update()
   // the Update(), a StillRender/InteractiveRender will be called which will ensure that the cache
   // is cleared and the correct block is fetched from the server.
 
-  vtkVLogScopeF(PARAVIEW_LOG_RENDERING_VERBOSITY(), "%s: update view", this->GetLogName().c_str());
+  PARAVIEW_LOG_SCOPE_F(RENDERING, "%s: update view", this->GetLogName().c_str());
 
   // Propagate update time.
   const int num_reprs = this->GetNumberOfRepresentations();
@@ -309,6 +309,31 @@ void CosmoHaloFinderP::executeHaloFinder()
 #endif
 }
 
+/////////////////////////////////////////////////////////////////////////
+//
+// Use halos found elsewhere in place of the serial halo finder results
+//
+/////////////////////////////////////////////////////////////////////////
+
+void CosmoHaloFinderP::setHaloStructure(const int* _haloTag,
+                                        const int* _haloStart,
+                                        const int* _haloList)
+{
+  clearHaloTag();
+  clearHaloStart();
+  clearHaloList();
+  clearHaloSize();
+
+  this->haloTag = new int[this->particleCount];
+  this->haloStart = new int[this->particleCount];
+  this->haloList = new int[this->particleCount];
+  this->haloSize = new int[this->particleCount];
+
+  std::copy(_haloTag, _haloTag + this->particleCount, this->haloTag);
+  std::copy(_haloStart, _haloStart + this->particleCount, this->haloStart);
+  std::copy(_haloList, _haloList + this->particleCount, this->haloList);
+}
+
 /////////////////////////////////////////////////////////////////////////
 //
 // At this point each serial halo finder ran and the particles handed to it
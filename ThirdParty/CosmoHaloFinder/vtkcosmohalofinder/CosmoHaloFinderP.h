@@ -110,6 +110,16 @@ public:
   // Execute the serial halo finder for this processor
   void executeHaloFinder();
 
+  // Use the halos found by another friends-of-friends implementation
+  // instead of executing the serial halo finder.  The arrays, of one value
+  // per particle, follow the conventions of the serial halo finder: haloTag
+  // is the index of the lowest particle in the halo, haloStart is the first
+  // particle in the list of a halo (-1 if the particle does not start a
+  // list) and haloList links the particles of a halo (-1 terminated).
+  void setHaloStructure(const int* haloTag,
+                        const int* haloStart,
+                        const int* haloList);
+
   // Collect the halo information from the serial halo finder
   // Save the mixed halos so as to determine which processor owns them
   void collectHalos(bool clearTag = true);
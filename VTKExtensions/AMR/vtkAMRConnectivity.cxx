@@ -34,140 +34,81 @@
 #include <algorithm>
 #include <list>
 #include <map>
+#include <unordered_map>
 
 vtkStandardNewMacro(vtkAMRConnectivity);
 
+// Disjoint sets of region ids. Each set is represented by its smallest id,
+// which is the id all the regions of the set are relabelled with.
 class vtkAMRConnectivityEquivalence
 {
 public:
-  vtkAMRConnectivityEquivalence()
-  {
-    set_to_min_id = vtkSmartPointer<vtkIntArray>::New();
-    set_to_min_id->SetNumberOfComponents(1);
-    set_to_min_id->SetNumberOfTuples(0);
-  }
-
+  vtkAMRConnectivityEquivalence() = default;
   ~vtkAMRConnectivityEquivalence() = default;
 
+  // Returns 1 if id1 and id2 were not known to be equivalent yet.
   int AddEquivalence(int id1, int id2)
   {
-    int min_id;
-    if (id1 < id2)
-    {
-      min_id = id1;
-    }
-    else
-    {
-      min_id = id2;
-    }
-
-    std::map<int, int>::iterator iter;
-
-    iter = id_to_set.find(id1);
-    int set1 = (iter == id_to_set.end() ? -1 : iter->second);
-    iter = id_to_set.find(id2);
-    int set2 = (iter == id_to_set.end() ? -1 : iter->second);
-
-    if (set1 >= 0 && set_to_min_id->GetValue(set1) < 0)
-    {
-      set1 = -1;
-    }
-    if (set2 >= 0 && set_to_min_id->GetValue(set2) < 0)
-    {
-      set2 = -1;
-    }
-
-    if (set1 >= 0 && set2 >= 0 && set1 == set2)
+    int root1 = this->Find(id1);
+    int root2 = this->Find(id2);
+    if (root1 == root2)
     {
       return 0;
     }
-    else if (set1 >= 0 && set2 >= 0)
-    {
-      // merge sets
-      int min_set, max_set;
-      if (set1 < set2)
-      {
-        min_set = set1;
-        max_set = set2;
-      }
-      else
-      {
-        min_set = set2;
-        max_set = set1;
-      }
-      for (iter = id_to_set.begin(); iter != id_to_set.end(); iter++)
-      {
-        if (iter->second == max_set)
-        {
-          id_to_set[iter->first] = min_set;
-        }
-      }
-      int max_set_min = set_to_min_id->GetValue(max_set);
-      int min_set_min = set_to_min_id->GetValue(min_set);
-      // pick the smallest of the two mins to represent the set.
-      if (max_set_min < min_set_min)
-      {
-        set_to_min_id->SetValue(min_set, max_set_min);
-      }
-      set_to_min_id->SetValue(max_set, -1);
-    }
-    else if (set1 >= 0)
-    {
-      id_to_set[id2] = set1;
-      if (id2 < set_to_min_id->GetValue(set1))
-      {
-        set_to_min_id->SetValue(set1, id2);
-      }
-    }
-    else if (set2 >= 0)
+    // keep the smallest id at the root so that it is the id of the set.
+    if (root1 < root2)
     {
-      id_to_set[id1] = set2;
-      if (id1 < set_to_min_id->GetValue(set2))
-      {
-        set_to_min_id->SetValue(set2, id1);
-      }
+      this->Parents[root2] = root1;
     }
     else
     {
-      // find an empty set.
-      int first_empty = -1;
-      for (int i = 0; i < set_to_min_id->GetNumberOfTuples(); i++)
-      {
-        if (set_to_min_id->GetValue(i) < 0)
-        {
-          first_empty = i;
-          break;
-        }
-      }
-      if (first_empty < 0)
-      {
-        first_empty = set_to_min_id->InsertNextValue(-1);
-      }
-
-      id_to_set[id1] = first_empty;
-      id_to_set[id2] = first_empty;
-      set_to_min_id->SetValue(first_empty, min_id);
-      // return zero here because its not values we've previously cared about.
+      this->Parents[root1] = root2;
     }
     return 1;
   }
 
+  // Returns the smallest id equivalent to `id`, or -1 if `id` has never been
+  // added to the equivalence.
   int GetMinimumSetId(int id)
   {
-    std::map<int, int>::iterator iter = id_to_set.find(id);
-    if (iter == id_to_set.end())
+    if (this->Parents.find(id) == this->Parents.end())
     {
-      // vtkErrorWithObjectMacro (id_to_set, << "ID out of range " << id << " (expected 0 <= x < "
-      // << id_to_set->GetNumberOfTuples () << ")");
       return -1;
     }
-    int set = id_to_set[id];
-    return (set >= 0 ? set_to_min_id->GetValue(set) : -1);
+    return this->Find(id);
+  }
+
+  std::vector<int> GetIds() const
+  {
+    std::vector<int> ids;
+    ids.reserve(this->Parents.size());
+    for (const auto& pair : this->Parents)
+    {
+      ids.push_back(pair.first);
+    }
+    return ids;
   }
 
 private:
-  std::map<int, int> id_to_set;
-  vtkSmartPointer<vtkIntArray> set_to_min_id;
+  int Find(int id)
+  {
+    auto iter = this->Parents.find(id);
+    if (iter == this->Parents.end())
+    {
+      this->Parents[id] = id;
+      return id;
+    }
+    // path halving
+    while (iter->second != iter->first)
+    {
+      auto parent = this->Parents.find(iter->second);
+      iter->second = parent->second;
+      iter = this->Parents.find(iter->second);
+    }
+    return iter->first;
+  }
+
+  std::unordered_map<int, int> Parents;
 };
 
 #if VTK_MODULE_ENABLE_VTK_ParallelMPI
@@ -233,6 +174,7 @@ vtkAMRConnectivity::vtkAMRConnectivity()
   this->Equivalence = nullptr;
   this->ResolveBlocks = 1;
   this->PropagateGhosts = 0;
+  this->EquivalenceResolution = PAIR_EXCHANGE;
 }
 
 vtkAMRConnectivity::~vtkAMRConnectivity() = default;
@@ -241,6 +183,7 @@ void vtkAMRConnectivity::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
   os << indent << "VolumeFractionSurfaceValue: " << this->VolumeFractionSurfaceValue << endl;
+  os << indent << "EquivalenceResolution: " << this->EquivalenceResolution << endl;
 }
 
 void vtkAMRConnectivity::AddInputVolumeArrayToProcess(const char* name)
@@ -491,102 +434,14 @@ int vtkAMRConnectivity::DoRequestData(vtkNonOverlappingAMR* volume, const char*
 
     vtkTimerLog::MarkStartEvent("Transferring equivalence");
     this->EquivPairs.resize(numProcs);
-    while (true)
-    {
-      int sets_changed = 0;
-      // Relabel all fragment IDs with the equivalence set number
-      // (set numbers start with 1 and 0 is considered "no set" or "no fragment")
-      for (int level = 0; level < this->Helper->GetNumberOfLevels(); level++)
-      {
-        for (int blockId = 0; blockId < this->Helper->GetNumberOfBlocksInLevel(level); blockId++)
-        {
-          vtkAMRDualGridHelperBlock* block = this->Helper->GetBlock(level, blockId);
-          if (block->ProcessId != myProc)
-          {
-            continue;
-          }
-          vtkUniformGrid* grid = volume->GetDataSet(block->Level, block->BlockId);
-          vtkIdTypeArray* regionIdArray =
-            vtkIdTypeArray::SafeDownCast(grid->GetCellData()->GetArray(this->RegionName.c_str()));
-          if (regionIdArray == nullptr)
-          {
-            vtkErrorMacro("block Image doesn't not contain the regionId just added");
-            return 0;
-          }
-          for (int i = 0; i < regionIdArray->GetNumberOfTuples(); i++)
-          {
-            vtkIdType regionId = regionIdArray->GetTuple1(i);
-            if (regionId > 0)
-            {
-              int setId = this->Equivalence->GetMinimumSetId(regionId);
-              if (setId > 0 && setId != regionId)
-              {
-                regionIdArray->SetTuple1(i, setId);
-                sets_changed = 1;
-                for (size_t p = 0; p < this->NeighborList[block->Level][block->BlockId].size(); p++)
-                {
-                  int n = this->NeighborList[block->Level][block->BlockId][p];
-                  if (this->EquivPairs[n] == nullptr)
-                  {
-                    this->EquivPairs[n] = vtkSmartPointer<vtkIntArray>::New();
-                    this->EquivPairs[n]->SetNumberOfComponents(1);
-                    this->EquivPairs[n]->SetNumberOfTuples(0);
-                  }
-                  int contained = 0;
-                  for (int e = 0; e < this->EquivPairs[n]->GetNumberOfTuples(); e += 2)
-                  {
-                    int v1 = this->EquivPairs[n]->GetValue(e);
-                    int v2 = this->EquivPairs[n]->GetValue(e + 1);
-                    if ((v1 == regionId && v2 == setId) || (v2 == regionId && v1 == setId))
-                    {
-                      contained = 1;
-                    }
-                  }
-                  if (contained == 0)
-                  {
-                    this->EquivPairs[n]->InsertNextValue(regionId);
-                    this->EquivPairs[n]->InsertNextValue(setId);
-                  }
-                }
-              }
-            }
-            else
-            {
-              regionIdArray->SetTuple1(i, 0);
-            }
-          }
-        }
-      }
-#if VTK_MODULE_ENABLE_VTK_ParallelMPI
-      if (numProcs > 1)
-      {
-        int out;
-        controller->AllReduce(&sets_changed, &out, 1, vtkCommunicator::MAX_OP);
-        sets_changed = out;
-      }
-#endif
-      if (sets_changed == 0)
-      {
-        break;
-      }
-#if VTK_MODULE_ENABLE_VTK_ParallelMPI
-      if (numProcs > 1 && !this->ExchangeEquivPairs(mpiController))
-      {
-        return 0;
-      }
-#endif
-      // clear out the pairs after sending them.
-      for (int i = 0; i < numProcs; i++)
-      {
-        if (this->EquivPairs[i] != nullptr)
-        {
-          this->EquivPairs[i]->SetNumberOfTuples(0);
-        }
-      }
-    }
+    this->ReceivedEquivPairs.resize(numProcs);
+    int resolved = this->EquivalenceResolution == LABEL_PROPAGATION
+      ? this->ResolveByLabelPropagation(volume)
+      : this->ResolveByPairExchange(volume);
 
     // clean up EquivPairs for the last time this update
     this->EquivPairs.clear();
+    this->ReceivedEquivPairs.clear();
     ValidNeighbor.clear();
     NeighborList.clear();
 
@@ -594,6 +449,10 @@ int vtkAMRConnectivity::DoRequestData(vtkNonOverlappingAMR* volume, const char*
 
     delete this->Equivalence;
     this->Equivalence = nullptr;
+    if (!resolved)
+    {
+      return 0;
+    }
   }
 
   if (PropagateGhosts)
@@ -647,6 +506,245 @@ int vtkAMRConnectivity::DoRequestData(vtkNonOverlappingAMR* volume, const char*
   return 1;
 }
 
+//----------------------------------------------------------------------------
+int vtkAMRConnectivity::ResolveByPairExchange(vtkNonOverlappingAMR* volume)
+{
+  vtkMultiProcessController* controller = vtkMultiProcessController::GetGlobalController();
+#if VTK_MODULE_ENABLE_VTK_ParallelMPI
+  vtkMPIController* mpiController = vtkMPIController::SafeDownCast(controller);
+#endif
+  int myProc = controller->GetLocalProcessId();
+  int numProcs = controller->GetNumberOfProcesses();
+
+  while (true)
+  {
+    int sets_changed = 0;
+    // Relabel all fragment IDs with the equivalence set number
+    // (set numbers start with 1 and 0 is considered "no set" or "no fragment")
+    for (int level = 0; level < this->Helper->GetNumberOfLevels(); level++)
+    {
+      for (int blockId = 0; blockId < this->Helper->GetNumberOfBlocksInLevel(level); blockId++)
+      {
+        vtkAMRDualGridHelperBlock* block = this->Helper->GetBlock(level, blockId);
+        if (block->ProcessId != myProc)
+        {
+          continue;
+        }
+        vtkUniformGrid* grid = volume->GetDataSet(block->Level, block->BlockId);
+        vtkIdTypeArray* regionIdArray =
+          vtkIdTypeArray::SafeDownCast(grid->GetCellData()->GetArray(this->RegionName.c_str()));
+        if (regionIdArray == nullptr)
+        {
+          vtkErrorMacro("block Image doesn't not contain the regionId just added");
+          return 0;
+        }
+        for (int i = 0; i < regionIdArray->GetNumberOfTuples(); i++)
+        {
+          vtkIdType regionId = regionIdArray->GetTuple1(i);
+          if (regionId > 0)
+          {
+            int setId = this->Equivalence->GetMinimumSetId(regionId);
+            if (setId > 0 && setId != regionId)
+            {
+              regionIdArray->SetTuple1(i, setId);
+              sets_changed = 1;
+              for (size_t p = 0; p < this->NeighborList[block->Level][block->BlockId].size(); p++)
+              {
+                int n = this->NeighborList[block->Level][block->BlockId][p];
+                if (this->EquivPairs[n] == nullptr)
+                {
+                  this->EquivPairs[n] = vtkSmartPointer<vtkIntArray>::New();
+                  this->EquivPairs[n]->SetNumberOfComponents(1);
+                  this->EquivPairs[n]->SetNumberOfTuples(0);
+                }
+                int contained = 0;
+                for (int e = 0; e < this->EquivPairs[n]->GetNumberOfTuples(); e += 2)
+                {
+                  int v1 = this->EquivPairs[n]->GetValue(e);
+                  int v2 = this->EquivPairs[n]->GetValue(e + 1);
+                  if ((v1 == regionId && v2 == setId) || (v2 == regionId && v1 == setId))
+                  {
+                    contained = 1;
+                  }
+                }
+                if (contained == 0)
+                {
+                  this->EquivPairs[n]->InsertNextValue(regionId);
+                  this->EquivPairs[n]->InsertNextValue(setId);
+                }
+              }
+            }
+          }
+          else
+          {
+            regionIdArray->SetTuple1(i, 0);
+          }
+        }
+      }
+    }
+#if VTK_MODULE_ENABLE_VTK_ParallelMPI
+    if (numProcs > 1)
+    {
+      int out;
+      controller->AllReduce(&sets_changed, &out, 1, vtkCommunicator::MAX_OP);
+      sets_changed = out;
+    }
+#endif
+    if (sets_changed == 0)
+    {
+      break;
+    }
+#if VTK_MODULE_ENABLE_VTK_ParallelMPI
+    if (numProcs > 1 && !this->ExchangeEquivPairs(mpiController))
+    {
+      return 0;
+    }
+#endif
+    for (int i = 0; i < numProcs; i++)
+    {
+      vtkIntArray* array = this->ReceivedEquivPairs[i];
+      for (vtkIdType e = 0; array != nullptr && e < array->GetNumberOfTuples(); e += 2)
+      {
+        this->Equivalence->AddEquivalence(array->GetValue(e), array->GetValue(e + 1));
+      }
+    }
+    // clear out the pairs after sending them.
+    for (int i = 0; i < numProcs; i++)
+    {
+      if (this->EquivPairs[i] != nullptr)
+      {
+        this->EquivPairs[i]->SetNumberOfTuples(0);
+      }
+    }
+  }
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkAMRConnectivity::ResolveByLabelPropagation(vtkNonOverlappingAMR* volume)
+{
+  vtkMultiProcessController* controller = vtkMultiProcessController::GetGlobalController();
+#if VTK_MODULE_ENABLE_VTK_ParallelMPI
+  vtkMPIController* mpiController = vtkMPIController::SafeDownCast(controller);
+#endif
+  int myProc = controller->GetLocalProcessId();
+  int numProcs = controller->GetNumberOfProcesses();
+
+  // For each neighbouring process, the region ids known to both processes and
+  // the label of each of them last sent to, or received from, that process.
+  // Region ids are unique across processes: id - 1 is a multiple of the number
+  // of processes plus the rank of the process that created it. Initially, the
+  // shared ids are the remote ids found on the boundaries processed here; the
+  // process owning them may not know about these boundaries.
+  std::vector<std::map<int, int>> sharedLabels(numProcs);
+  for (int id : this->Equivalence->GetIds())
+  {
+    int owner = (id - 1) % numProcs;
+    if (owner != myProc && this->ValidNeighbor[owner])
+    {
+      sharedLabels[owner][id] = 0;
+    }
+  }
+
+  while (true)
+  {
+    int labels_changed = 0;
+    for (int i = 0; i < numProcs; i++)
+    {
+      if (this->EquivPairs[i] != nullptr)
+      {
+        this->EquivPairs[i]->SetNumberOfTuples(0);
+      }
+      for (auto& shared : sharedLabels[i])
+      {
+        int label = this->Equivalence->GetMinimumSetId(shared.first);
+        if (label == shared.second)
+        {
+          continue;
+        }
+        if (this->EquivPairs[i] == nullptr)
+        {
+          this->EquivPairs[i] = vtkSmartPointer<vtkIntArray>::New();
+          this->EquivPairs[i]->SetNumberOfComponents(1);
+        }
+        this->EquivPairs[i]->InsertNextValue(shared.first);
+        this->EquivPairs[i]->InsertNextValue(label);
+        shared.second = label;
+        labels_changed = 1;
+      }
+    }
+#if VTK_MODULE_ENABLE_VTK_ParallelMPI
+    if (numProcs > 1)
+    {
+      int out;
+      controller->AllReduce(&labels_changed, &out, 1, vtkCommunicator::MAX_OP);
+      labels_changed = out;
+    }
+#endif
+    if (labels_changed == 0)
+    {
+      break;
+    }
+#if VTK_MODULE_ENABLE_VTK_ParallelMPI
+    if (numProcs > 1 && !this->ExchangeEquivPairs(mpiController))
+    {
+      return 0;
+    }
+#endif
+    for (int i = 0; i < numProcs; i++)
+    {
+      vtkIntArray* array = this->ReceivedEquivPairs[i];
+      for (vtkIdType e = 0; array != nullptr && e < array->GetNumberOfTuples(); e += 2)
+      {
+        int id = array->GetValue(e);
+        int label = array->GetValue(e + 1);
+        this->Equivalence->AddEquivalence(id, label);
+        // the sender knows this label, only a smaller one needs to be sent back.
+        sharedLabels[i][id] = label;
+      }
+    }
+  }
+
+  // The labels have converged, relabel the cells once.
+  for (int level = 0; level < this->Helper->GetNumberOfLevels(); level++)
+  {
+    for (int blockId = 0; blockId < this->Helper->GetNumberOfBlocksInLevel(level); blockId++)
+    {
+      vtkAMRDualGridHelperBlock* block = this->Helper->GetBlock(level, blockId);
+      if (block->ProcessId != myProc)
+      {
+        continue;
+      }
+      vtkUniformGrid* grid = volume->GetDataSet(block->Level, block->BlockId);
+      vtkIdTypeArray* regionIdArray =
+        vtkIdTypeArray::SafeDownCast(grid->GetCellData()->GetArray(this->RegionName.c_str()));
+      if (regionIdArray == nullptr)
+      {
+        vtkErrorMacro("block Image doesn't not contain the regionId just added");
+        return 0;
+      }
+      vtkIdType* regionIds = regionIdArray->GetPointer(0);
+      for (vtkIdType i = 0; i < regionIdArray->GetNumberOfTuples(); i++)
+      {
+        if (regionIds[i] > 0)
+        {
+          int setId = this->Equivalence->GetMinimumSetId(static_cast<int>(regionIds[i]));
+          if (setId > 0)
+          {
+            regionIds[i] = setId;
+          }
+        }
+        else
+        {
+          regionIds[i] = 0;
+        }
+      }
+    }
+  }
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 int vtkAMRConnectivity::WavePropagation(vtkIdType cellIdStart, vtkUniformGrid* grid,
   vtkIdTypeArray* regionId, vtkDataArray* volArray, vtkUnsignedCharArray* ghostArray)
@@ -1039,6 +1137,11 @@ int vtkAMRConnectivity::ExchangeEquivPairs(vtkMPIController* controller)
   int myProc = controller->GetLocalProcessId();
   int numProcs = controller->GetNumberOfProcesses();
 
+  for (int i = 0; i < numProcs; i++)
+  {
+    this->ReceivedEquivPairs[i] = nullptr;
+  }
+
   vtkAMRConnectivityCommRequestList receiveList;
   for (size_t i = 0; i < static_cast<unsigned int>(numProcs); i++)
   {
@@ -1147,16 +1250,11 @@ int vtkAMRConnectivity::ExchangeEquivPairs(vtkMPIController* controller)
     sendList.push_back(request);
   }
 
+  // the pairs are processed by the caller.
   while (!receiveList.empty())
   {
     vtkAMRConnectivityCommRequest request = receiveList.WaitAny();
-    vtkSmartPointer<vtkIntArray> array = request.Buffer;
-    for (int i = 0; i < array->GetNumberOfTuples(); i += 2)
-    {
-      int v1 = array->GetValue(i);
-      int v2 = array->GetValue(i + 1);
-      this->Equivalence->AddEquivalence(v1, v2);
-    }
+    this->ReceivedEquivPairs[request.SendProcess] = request.Buffer;
   }
 
   receiveList.clear();
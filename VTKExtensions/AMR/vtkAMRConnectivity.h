@@ -5,7 +5,12 @@
  * @class   vtkAMRConnectivity
  * @brief   Identify fragments in the grid
  *
- *
+ * Fragments are first identified within each block. When ResolveBlocks is
+ * enabled, the fragments touching across block boundaries are then merged and
+ * every fragment is relabelled with the smallest region id in its set. How the
+ * equivalences between region ids found on different processes are resolved
+ * is selected with EquivalenceResolution; in both modes, processes only ever
+ * communicate with the processes owning neighbouring blocks.
  *
  * .SEE vtkAMRConnectivity
  */
@@ -68,6 +73,32 @@ public:
   vtkSetMacro(PropagateGhosts, bool);
   ///@}
 
+  enum EquivalenceResolutionModes
+  {
+    PAIR_EXCHANGE = 0,
+    LABEL_PROPAGATION = 1
+  };
+
+  ///@{
+  /**
+   * Get / Set how the equivalences between region ids are resolved across
+   * processes when ResolveBlocks is enabled.
+   *
+   * With PAIR_EXCHANGE (default), the region ids of the cells are rewritten
+   * on every round and the pairs of changed ids are sent to the processes
+   * neighbouring the modified blocks until no process changes a cell.
+   *
+   * With LABEL_PROPAGATION, only the region ids shared with each neighbouring
+   * process are exchanged, along with the smallest id currently known to be
+   * equivalent to them, and only when that label changes. Each round then
+   * costs in proportion to the number of ids on the process boundaries rather
+   * than to the number of cells, and the cells are relabelled once, after the
+   * labels have converged. The resulting region ids are the same.
+   */
+  vtkSetClampMacro(EquivalenceResolution, int, PAIR_EXCHANGE, LABEL_PROPAGATION);
+  vtkGetMacro(EquivalenceResolution, int);
+  ///@}
+
 protected:
   vtkAMRConnectivity();
   ~vtkAMRConnectivity() override;
@@ -78,6 +109,7 @@ protected:
 
   bool ResolveBlocks;
   bool PropagateGhosts;
+  int EquivalenceResolution;
 
   std::string RegionName;
   vtkIdType NextRegionId;
@@ -90,6 +122,7 @@ protected:
   std::vector<bool> ValidNeighbor;
   std::vector<std::vector<std::vector<int>>> NeighborList;
   std::vector<vtkSmartPointer<vtkIntArray>> EquivPairs;
+  std::vector<vtkSmartPointer<vtkIntArray>> ReceivedEquivPairs;
 
   int FillInputPortInformation(int port, vtkInformation* info) override;
   int FillOutputPortInformation(int port, vtkInformation* info) override;
@@ -105,6 +138,8 @@ protected:
     vtkAMRDualGridHelperBlock* neighbor, int dir);
   int ExchangeBoundaries(vtkMPIController* controller);
   int ExchangeEquivPairs(vtkMPIController* controller);
+  int ResolveByPairExchange(vtkNonOverlappingAMR* volume);
+  int ResolveByLabelPropagation(vtkNonOverlappingAMR* volume);
   void ProcessBoundaryAtNeighbor(vtkNonOverlappingAMR* volume, vtkIdTypeArray* array);
 
 private:
@@ -21,6 +21,7 @@
 // Data sets
 #include "vtkAMRBox.h"
 #include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
 #include "vtkCellData.h"
 #include "vtkCompositeDataIterator.h"
 #include "vtkDataSet.h"
@@ -28,15 +29,23 @@
 #include "vtkIntArray.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiPieceDataSet.h"
+#include "vtkNew.h"
 #include "vtkNonOverlappingAMR.h"
 #include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkUniformGrid.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <ctime>
+#include <map>
+#include <memory>
 
 vtkStandardNewMacro(vtkAMRDualClip);
 
@@ -125,6 +134,17 @@ public:
   // This is used to synchronize the ghost level mask with neighbors.
   void CopyNeighborLevelMask(
     vtkAMRDualGridHelperBlock* myBlock, vtkAMRDualGridHelperBlock* neighborBlock);
+  // Same, but the level mask of the neighbor is provided.
+  void CopyNeighborLevelMask(vtkAMRDualGridHelperBlock* myBlock,
+    vtkAMRDualGridHelperBlock* neighborBlock, const unsigned char* neighborLevelMask,
+    const int neighborDualCellDimensions[3]);
+
+  // Reset the level mask to uninitialized values, so that ComputeLevelMask
+  // computes the center region again.
+  void ResetLevelMask();
+
+  // Replace the whole level mask, assuming its center region is computed.
+  void SetLevelMask(const unsigned char* levelMask);
 
   // Used to set the level mask of capped faces.
   void CapLevelMaskFace(int axis, int face);
@@ -134,6 +154,12 @@ public:
 
   vtkUnsignedCharArray* GetLevelMaskArray() { return this->LevelMaskArray; }
 
+  // Convert a pointer returned by GetEdgePointer or GetCornerPointer to an
+  // index, and back. This is used to find the entry of a point in another
+  // locator initialized for the same block.
+  vtkIdType GetEntryIndex(const vtkIdType* ptr) const { return ptr - this->XEdges; }
+  vtkIdType* GetEntryPointer(vtkIdType index) { return this->XEdges + index; }
+
 private:
   int DualCellDimensions[3];
   // Increments for translating 3d to 1d.  XIncrement = 1;
@@ -476,6 +502,20 @@ void vtkAMRDualClipLocator::CopyNeighborLevelMask(
     return;
   }
 
+  this->CopyNeighborLevelMask(myBlock, neighborBlock, neighborLocator->GetLevelMaskPointer(),
+    neighborLocator->DualCellDimensions);
+}
+
+//----------------------------------------------------------------------------
+void vtkAMRDualClipLocator::CopyNeighborLevelMask(vtkAMRDualGridHelperBlock* myBlock,
+  vtkAMRDualGridHelperBlock* neighborBlock, const unsigned char* neighborLevelMask,
+  const int neighborDualCellDimensions[3])
+{
+  if (neighborBlock->Level > myBlock->Level)
+  {
+    return;
+  }
+
   // We copy from the center region to ghost region.
 
   // Compute the intersection in the high level destination block
@@ -483,9 +523,9 @@ void vtkAMRDualClipLocator::CopyNeighborLevelMask(
   sourceExt[0] = neighborBlock->OriginIndex[0] + 1;
   sourceExt[2] = neighborBlock->OriginIndex[1] + 1;
   sourceExt[4] = neighborBlock->OriginIndex[2] + 1;
-  sourceExt[1] = sourceExt[0] + neighborLocator->DualCellDimensions[0] - 2;
-  sourceExt[3] = sourceExt[2] + neighborLocator->DualCellDimensions[1] - 2;
-  sourceExt[5] = sourceExt[4] + neighborLocator->DualCellDimensions[2] - 2;
+  sourceExt[1] = sourceExt[0] + neighborDualCellDimensions[0] - 2;
+  sourceExt[3] = sourceExt[2] + neighborDualCellDimensions[1] - 2;
+  sourceExt[5] = sourceExt[4] + neighborDualCellDimensions[2] - 2;
   int destExt[6]; // all regions (including ghosts)
   destExt[0] = myBlock->OriginIndex[0];
   destExt[2] = myBlock->OriginIndex[1];
@@ -513,7 +553,7 @@ void vtkAMRDualClipLocator::CopyNeighborLevelMask(
   destExt[5] = std::min(destExt[5], sourceExt[5]);
 
   // Loop over the extent.
-  unsigned char* sourcePtr = neighborLocator->GetLevelMaskPointer();
+  const unsigned char* sourcePtr = neighborLevelMask;
   unsigned char* destPtr = this->GetLevelMaskPointer();
   // +1 is for ghost offset.
   destPtr += (destExt[0] - myBlock->OriginIndex[0]);
@@ -582,11 +622,9 @@ void vtkAMRDualClipLocator::Initialize(int xDualCellDim, int yDualCellDim, int z
     zDualCellDim != this->DualCellDimensions[2])
   {
     if (this->XEdges)
-    { // They are all allocated at once, so separate checks are not necessary.
+    { // They are all allocated at once, in a single buffer.
       delete[] this->XEdges;
-      delete[] this->YEdges;
-      delete[] this->ZEdges;
-      delete[] this->Corners;
+      this->XEdges = this->YEdges = this->ZEdges = this->Corners = nullptr;
       this->LevelMaskArray->Delete();
       this->LevelMaskArray = nullptr;
     }
@@ -599,10 +637,10 @@ void vtkAMRDualClipLocator::Initialize(int xDualCellDim, int yDualCellDim, int z
       this->YIncrement = this->DualCellDimensions[0] + 1;
       this->ZIncrement = this->YIncrement * (this->DualCellDimensions[1] + 1);
       this->ArrayLength = this->ZIncrement * (this->DualCellDimensions[2] + 1);
-      this->XEdges = new vtkIdType[this->ArrayLength];
-      this->YEdges = new vtkIdType[this->ArrayLength];
-      this->ZEdges = new vtkIdType[this->ArrayLength];
-      this->Corners = new vtkIdType[this->ArrayLength];
+      this->XEdges = new vtkIdType[4 * static_cast<size_t>(this->ArrayLength)];
+      this->YEdges = this->XEdges + this->ArrayLength;
+      this->ZEdges = this->YEdges + this->ArrayLength;
+      this->Corners = this->ZEdges + this->ArrayLength;
       this->LevelMaskArray = vtkUnsignedCharArray::New();
       this->LevelMaskArray->SetNumberOfTuples(this->ArrayLength);
       // 255 is a special value that means the pixel is uninitialized.
@@ -618,11 +656,28 @@ void vtkAMRDualClipLocator::Initialize(int xDualCellDim, int yDualCellDim, int z
     }
   }
 
-  for (int idx = 0; idx < this->ArrayLength; ++idx)
+  std::fill_n(this->XEdges, 4 * static_cast<size_t>(this->ArrayLength), -1);
+}
+
+//----------------------------------------------------------------------------
+void vtkAMRDualClipLocator::ResetLevelMask()
+{
+  if (this->LevelMaskArray)
   {
-    this->XEdges[idx] = this->YEdges[idx] = this->ZEdges[idx] = -1;
-    this->Corners[idx] = -1;
+    // 255 is a special value that means the pixel is uninitialized.
+    memset(this->GetLevelMaskPointer(), 255, this->ArrayLength);
   }
+  this->CenterLevelMaskComputed = 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkAMRDualClipLocator::SetLevelMask(const unsigned char* levelMask)
+{
+  if (this->LevelMaskArray)
+  {
+    memcpy(this->GetLevelMaskPointer(), levelMask, this->ArrayLength);
+  }
+  this->CenterLevelMaskComputed = 1;
 }
 
 //----------------------------------------------------------------------------
@@ -936,6 +991,54 @@ void vtkAMRDualClipLocator::ShareBlockLocatorWithNeighbor(
   }
 }
 
+//============================================================================
+// Output of ProcessBlock(). Blocks are either all processed serially into the
+// output, or each into its own piece concurrently; the pieces are then
+// appended to the output in the order the blocks are processed serially.
+class vtkAMRDualClipPiece
+{
+public:
+  vtkSmartPointer<vtkUnstructuredGrid> Mesh;
+  vtkPoints* Points = nullptr;
+  vtkCellArray* Cells = nullptr;
+  vtkIntArray* BlockIdCellArray = nullptr;
+  vtkUnsignedCharArray* LevelMaskPointArray = nullptr;
+
+  // When set, blocks use the locator stored in the block so that point ids
+  // and level masks are shared with neighbor blocks. Otherwise Locator is used.
+  bool ShareLocators = false;
+  vtkAMRDualClipLocator* Locator = nullptr;
+  vtkAMRDualClipLocator* BlockLocator = nullptr;
+
+  // The block of a piece processed concurrently. ProcessBlock() sets
+  // Processed if the block has the array to clip.
+  vtkAMRDualGridHelperBlock* Block = nullptr;
+  int BlockId = 0;
+  bool Processed = false;
+
+  // When set, the locator entry of each point is saved in LocatorEntries so
+  // that points can be merged with the neighbor blocks when appending.
+  bool RecordLocatorEntries = false;
+  std::vector<vtkIdType> LocatorEntries;
+
+  // Level mask of the block with only the center region computed, and the
+  // pieces of the other local blocks. When set, ProcessBlock() completes the
+  // level mask of Locator as InitializeLevelMask() does for shared locators.
+  std::vector<unsigned char> LevelMask;
+  int DualCellDimensions[3] = { 0, 0, 0 };
+  const std::map<vtkAMRDualGridHelperBlock*, vtkAMRDualClipPiece*>* BlockPieces = nullptr;
+
+  vtkIdType InsertNextPoint(vtkIdType* ptIdPtr, const double pt[3])
+  {
+    *ptIdPtr = this->Points->InsertNextPoint(pt);
+    if (this->RecordLocatorEntries)
+    {
+      this->LocatorEntries.push_back(this->BlockLocator->GetEntryIndex(ptIdPtr));
+    }
+    return *ptIdPtr;
+  }
+};
+
 //============================================================================
 //----------------------------------------------------------------------------
 // Description:
@@ -957,21 +1060,12 @@ vtkAMRDualClip::vtkAMRDualClip()
   // Pipeline
   this->SetNumberOfOutputPorts(1);
 
-  this->LevelMaskPointArray = nullptr;
-  this->BlockIdCellArray = nullptr;
   this->Helper = nullptr;
-
-  this->BlockLocator = nullptr;
 }
 
 //----------------------------------------------------------------------------
 vtkAMRDualClip::~vtkAMRDualClip()
 {
-  if (this->BlockLocator)
-  {
-    delete this->BlockLocator;
-    this->BlockLocator = nullptr;
-  }
   this->SetController(nullptr);
 }
 
@@ -1105,58 +1199,245 @@ vtkMultiBlockDataSet* vtkAMRDualClip::DoRequestData(
     this->DistributeLevelMasks();
   }
 
-  vtkUnstructuredGrid* mesh = vtkUnstructuredGrid::New();
-  this->Points = vtkPoints::New();
-  this->Cells = vtkCellArray::New();
-  mesh->SetPoints(this->Points);
-  mpds->SetPiece(0, mesh);
+  vtkAMRDualClipPiece output;
+  this->InitializePiece(&output, hbdsInput);
+  mpds->SetPiece(0, output.Mesh);
+
+  if (vtkSMPTools::GetEstimatedNumberOfThreads() > 1 && this->Helper->GetNumberOfBlocks() > 1)
+  {
+    this->ProcessBlocks(&output, hbdsInput, arrayNameToProcess);
+  }
+  else
+  {
+    vtkAMRDualClipLocator locator;
+    output.ShareLocators = (this->EnableMergePoints != 0);
+    output.Locator = &locator;
+
+    // Loop through blocks
+    int numLevels = hbdsInput->GetNumberOfLevels();
+    int numBlocks;
+    int blockId;
+
+    // Add each block.
+    for (int level = 0; level < numLevels; ++level)
+    {
+      numBlocks = this->Helper->GetNumberOfBlocksInLevel(level);
+      for (blockId = 0; blockId < numBlocks; ++blockId)
+      {
+        vtkAMRDualGridHelperBlock* block = this->Helper->GetBlock(level, blockId);
+        this->ProcessBlock(&output, block, blockId, arrayNameToProcess);
+      }
+    }
+  }
+
+  output.Mesh->SetCells(VTK_TETRA, output.Cells);
 
-  this->BlockIdCellArray = vtkIntArray::New();
-  this->BlockIdCellArray->SetName("BlockIds");
-  mesh->GetCellData()->AddArray(this->BlockIdCellArray);
+  mpds->Delete();
+  this->Helper->Delete();
+  this->Helper = nullptr;
 
-  this->LevelMaskPointArray = vtkUnsignedCharArray::New();
-  this->LevelMaskPointArray->SetName("LevelMask");
-  mesh->GetPointData()->AddArray(this->LevelMaskPointArray);
+  return mbdsOutput0;
+}
 
-  this->Mesh = mesh;
-  this->InitializeCopyAttributes(hbdsInput, this->Mesh);
+//----------------------------------------------------------------------------
+void vtkAMRDualClip::InitializePiece(vtkAMRDualClipPiece* piece, vtkNonOverlappingAMR* hbdsInput)
+{
+  piece->Mesh = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkCellArray> cells;
+  piece->Mesh->SetPoints(points);
+  piece->Points = points;
+  piece->Cells = cells;
+
+  vtkNew<vtkIntArray> blockIds;
+  blockIds->SetName("BlockIds");
+  piece->Mesh->GetCellData()->AddArray(blockIds);
+  piece->BlockIdCellArray = blockIds;
+
+  vtkNew<vtkUnsignedCharArray> levelMask;
+  levelMask->SetName("LevelMask");
+  piece->Mesh->GetPointData()->AddArray(levelMask);
+  piece->LevelMaskPointArray = levelMask;
+
+  this->InitializeCopyAttributes(hbdsInput, piece->Mesh);
+}
 
-  // Loop through blocks
+//----------------------------------------------------------------------------
+void vtkAMRDualClip::ProcessBlocks(
+  vtkAMRDualClipPiece* output, vtkNonOverlappingAMR* hbdsInput, const char* arrayNameToProcess)
+{
+  // One piece per local block, in the order blocks are processed serially.
+  std::vector<vtkAMRDualClipPiece> pieces;
+  pieces.reserve(this->Helper->GetNumberOfBlocks());
   int numLevels = hbdsInput->GetNumberOfLevels();
-  int numBlocks;
-  int blockId;
-
-  // Add each block.
   for (int level = 0; level < numLevels; ++level)
   {
-    numBlocks = this->Helper->GetNumberOfBlocksInLevel(level);
-    for (blockId = 0; blockId < numBlocks; ++blockId)
+    int numBlocks = this->Helper->GetNumberOfBlocksInLevel(level);
+    for (int blockId = 0; blockId < numBlocks; ++blockId)
     {
       vtkAMRDualGridHelperBlock* block = this->Helper->GetBlock(level, blockId);
-      this->ProcessBlock(block, blockId, arrayNameToProcess);
+      if (block->Image == nullptr)
+      { // Remote blocks are only to setup local block bit flags.
+        continue;
+      }
+      pieces.emplace_back();
+      vtkAMRDualClipPiece& piece = pieces.back();
+      this->InitializePiece(&piece, hbdsInput);
+      piece.Block = block;
+      piece.BlockId = blockId;
+      piece.RecordLocatorEntries = (this->EnableMergePoints != 0);
     }
   }
+  std::map<vtkAMRDualGridHelperBlock*, vtkAMRDualClipPiece*> blockPieces;
+  for (auto& piece : pieces)
+  {
+    blockPieces[piece.Block] = &piece;
+  }
 
-  this->BlockIdCellArray->Delete();
-  this->BlockIdCellArray = nullptr;
-  this->LevelMaskPointArray->Delete();
-  this->LevelMaskPointArray = nullptr;
+  vtkSMPThreadLocal<std::shared_ptr<vtkAMRDualClipLocator>> locators;
+  auto getLocator = [&locators]() {
+    std::shared_ptr<vtkAMRDualClipLocator>& locator = locators.Local();
+    if (!locator)
+    {
+      locator = std::make_shared<vtkAMRDualClipLocator>();
+    }
+    return locator.get();
+  };
 
-  mesh->SetCells(VTK_TETRA, this->Cells);
+  if (this->EnableMergePoints)
+  {
+    // The level mask of a block depends on the center region of its
+    // neighbors, so centers are all computed first.
+    vtkSMPTools::For(
+      0, static_cast<vtkIdType>(pieces.size()), 1, [&](vtkIdType begin, vtkIdType end) {
+        vtkAMRDualClipLocator* locator = getLocator();
+        for (vtkIdType idx = begin; idx < end; ++idx)
+        {
+          vtkAMRDualClipPiece& piece = pieces[idx];
+          vtkImageData* image = piece.Block->Image;
+          vtkDataArray* volumeFractionArray =
+            image->GetCellData()->GetArray(this->Helper->GetArrayName());
+          if (!volumeFractionArray)
+          {
+            continue;
+          }
+          int extent[6];
+          image->GetExtent(extent);
+          piece.DualCellDimensions[0] = extent[1] - extent[0] - 1;
+          piece.DualCellDimensions[1] = extent[3] - extent[2] - 1;
+          piece.DualCellDimensions[2] = extent[5] - extent[4] - 1;
+          locator->Initialize(
+            piece.DualCellDimensions[0], piece.DualCellDimensions[1], piece.DualCellDimensions[2]);
+          locator->ResetLevelMask();
+          locator->ComputeLevelMask(
+            volumeFractionArray, this->IsoValue, this->EnableInternalDecimation);
+          const unsigned char* levelMask = locator->GetLevelMaskArray()->GetPointer(0);
+          piece.LevelMask.assign(
+            levelMask, levelMask + locator->GetLevelMaskArray()->GetNumberOfValues());
+          piece.BlockPieces = &blockPieces;
+        }
+      });
+  }
 
-  mesh->Delete();
-  this->Mesh = nullptr;
-  this->Points->Delete();
-  this->Points = nullptr;
-  this->Cells->Delete();
-  this->Cells = nullptr;
+  vtkSMPTools::For(
+    0, static_cast<vtkIdType>(pieces.size()), 1, [&](vtkIdType begin, vtkIdType end) {
+      vtkAMRDualClipLocator* locator = getLocator();
+      for (vtkIdType idx = begin; idx < end; ++idx)
+      {
+        vtkAMRDualClipPiece& piece = pieces[idx];
+        piece.Locator = locator;
+        this->ProcessBlock(&piece, piece.Block, piece.BlockId, arrayNameToProcess);
+      }
+    });
 
-  mpds->Delete();
-  this->Helper->Delete();
-  this->Helper = nullptr;
+  for (auto& piece : pieces)
+  {
+    this->AppendPiece(output, &piece);
+    // Release the memory as soon as possible.
+    piece.Mesh = nullptr;
+    piece.LocatorEntries = std::vector<vtkIdType>();
+  }
+}
 
-  return mbdsOutput0;
+//----------------------------------------------------------------------------
+void vtkAMRDualClip::AppendPiece(vtkAMRDualClipPiece* output, vtkAMRDualClipPiece* piece)
+{
+  if (!piece->Processed)
+  {
+    return;
+  }
+
+  vtkAMRDualGridHelperBlock* block = piece->Block;
+  vtkAMRDualClipLocator* blockLocator = nullptr;
+  if (this->EnableMergePoints)
+  {
+    // Replay the sharing of point ids between blocks done when blocks are
+    // processed serially, so that the output is the same.
+    blockLocator = ::vtkAMRDualClipGetBlockLocator(block);
+  }
+
+  vtkPointData* inPD = piece->Mesh->GetPointData();
+  vtkPointData* outPD = output->Mesh->GetPointData();
+  // Both meshes are initialized the same way, so arrays have the same index.
+  int numArrays = outPD->GetNumberOfArrays();
+
+  vtkIdType numPoints = piece->Points->GetNumberOfPoints();
+  std::vector<vtkIdType> pointMap(numPoints);
+  for (vtkIdType ptId = 0; ptId < numPoints; ++ptId)
+  {
+    vtkIdType* ptIdPtr = nullptr;
+    if (blockLocator)
+    {
+      ptIdPtr = blockLocator->GetEntryPointer(piece->LocatorEntries[ptId]);
+      if (*ptIdPtr >= 0)
+      { // The point was created by a neighbor block.
+        pointMap[ptId] = *ptIdPtr;
+        continue;
+      }
+    }
+    vtkIdType outId = output->Points->GetData()->InsertNextTuple(ptId, piece->Points->GetData());
+    for (int idx = 0; idx < numArrays; ++idx)
+    {
+      outPD->GetAbstractArray(idx)->InsertTuple(outId, ptId, inPD->GetAbstractArray(idx));
+    }
+    pointMap[ptId] = outId;
+    if (ptIdPtr)
+    {
+      *ptIdPtr = outId;
+    }
+  }
+
+  vtkIdType pointIds[4];
+  vtkIdType cellId = 0;
+  auto iter = vtk::TakeSmartPointer(piece->Cells->NewIterator());
+  for (iter->GoToFirstCell(); !iter->IsDoneWithTraversal(); iter->GoToNextCell(), ++cellId)
+  {
+    vtkIdType numCellPoints;
+    const vtkIdType* ptIds;
+    iter->GetCurrentCell(numCellPoints, ptIds);
+    for (int ii = 0; ii < 4; ++ii)
+    {
+      pointIds[ii] = pointMap[ptIds[ii]];
+    }
+    // Merging points can make tetrahedra degenerate.
+    if (pointIds[0] != pointIds[1] && pointIds[0] != pointIds[2] && pointIds[0] != pointIds[3] &&
+      pointIds[1] != pointIds[2] && pointIds[1] != pointIds[3] && pointIds[2] != pointIds[3])
+    {
+      output->Cells->InsertNextCell(4, pointIds);
+      output->BlockIdCellArray->InsertNextValue(piece->BlockIdCellArray->GetValue(cellId));
+    }
+  }
+
+  if (blockLocator)
+  {
+    // Copy point ids into neighbor locators.
+    this->ShareBlockLocatorWithNeighbors(block);
+    // We are done.  We no longer need the locator for this block.
+    delete blockLocator;
+    block->UserData = nullptr;
+    // Mark the block as processed (see ProcessBlock).
+    block->RegionBits[1][1][1] = 0;
+  }
 }
 
 //----------------------------------------------------------------------------
@@ -1379,8 +1660,72 @@ void vtkAMRDualClip::ShareLevelMask(vtkAMRDualGridHelperBlock* block)
 }
 
 //----------------------------------------------------------------------------
-void vtkAMRDualClip::ProcessBlock(
-  vtkAMRDualGridHelperBlock* block, int blockId, const char* arrayNameToProcess)
+// Same as InitializeLevelMask(block) for a block processed concurrently: the
+// level mask of the locator of the piece is computed from the center regions
+// computed beforehand, instead of the locators of the neighbor blocks.
+void vtkAMRDualClip::InitializeLevelMask(vtkAMRDualClipPiece* piece)
+{
+  vtkAMRDualGridHelperBlock* block = piece->Block;
+  vtkAMRDualClipLocator* locator = piece->BlockLocator;
+
+  // Ghost regions received from other processes are already in the locator
+  // of the block (see DistributeLevelMasks).
+  vtkAMRDualClipLocator* blockLocator = static_cast<vtkAMRDualClipLocator*>(block->UserData);
+  locator->SetLevelMask(blockLocator ? blockLocator->GetLevelMaskArray()->GetPointer(0)
+                                     : piece->LevelMask.data());
+
+  int xMid, yMid, zMid;
+  int xMin, xMax, yMin, yMax, zMin, zMax;
+
+  for (int level = 0; level <= block->Level; ++level)
+  {
+    // Neighborhood.
+    int levelDiff = block->Level - level;
+    xMid = block->GridIndex[0];
+    xMin = (xMid >> levelDiff) - 1;
+    xMax = (xMid + 1) >> levelDiff;
+    yMid = block->GridIndex[1];
+    yMin = (yMid >> levelDiff) - 1;
+    yMax = (yMid + 1) >> levelDiff;
+    zMid = block->GridIndex[2];
+    zMin = (zMid >> levelDiff) - 1;
+    zMax = (zMid + 1) >> levelDiff;
+
+    for (int iz = zMin; iz <= zMax; ++iz)
+    {
+      for (int iy = yMin; iy <= yMax; ++iy)
+      {
+        for (int ix = xMin; ix <= xMax; ++ix)
+        {
+          if ((ix << levelDiff) != xMid || (iy << levelDiff) != yMid || (iz << levelDiff) != zMid)
+          {
+            vtkAMRDualGridHelperBlock* neighbor = this->Helper->GetBlock(level, ix, iy, iz);
+            auto iter = neighbor ? piece->BlockPieces->find(neighbor) : piece->BlockPieces->end();
+            if (iter != piece->BlockPieces->end() && !iter->second->LevelMask.empty())
+            {
+              locator->CopyNeighborLevelMask(block, neighbor, iter->second->LevelMask.data(),
+                iter->second->DualCellDimensions);
+            }
+          }
+        }
+      }
+    }
+  }
+
+  // Take care of boundary faces which have not been set.
+  // Just reflect values over face normal
+  for (int face = 0; face < 6; ++face)
+  {
+    if (block->BoundaryBits & (1 << face))
+    {
+      locator->CapLevelMaskFace(face / 2, face % 2);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkAMRDualClip::ProcessBlock(vtkAMRDualClipPiece* piece, vtkAMRDualGridHelperBlock* block,
+  int blockId, const char* arrayNameToProcess)
 {
   vtkImageData* image = block->Image;
   if (image == nullptr)
@@ -1395,6 +1740,7 @@ void vtkAMRDualClip::ProcessBlock(
   {
     return;
   }
+  piece->Processed = true;
 
   // void* volumeFractionPtr = volumeFractionArray->GetVoidPointer(0);
   double origin[3];
@@ -1410,20 +1756,21 @@ void vtkAMRDualClip::ProcessBlock(
 
   // Locator merges points in this block.
   // Input the dimensions of the dual cells with ghosts.
-  if (this->EnableMergePoints)
+  if (piece->ShareLocators)
   {
     this->InitializeLevelMask(block);
-    this->BlockLocator = ::vtkAMRDualClipGetBlockLocator(block);
+    piece->BlockLocator = ::vtkAMRDualClipGetBlockLocator(block);
   }
   else
   { // Shared locator.
-    if (this->BlockLocator == nullptr)
+    piece->BlockLocator = piece->Locator;
+    piece->BlockLocator->Initialize(
+      extent[1] - extent[0], extent[3] - extent[2], extent[5] - extent[4]);
+    // piece->BlockLocator->CopyRegionLevelDifferences(block);
+    if (!piece->LevelMask.empty())
     {
-      this->BlockLocator = new vtkAMRDualClipLocator;
+      this->InitializeLevelMask(piece);
     }
-    this->BlockLocator->Initialize(
-      extent[1] - extent[0], extent[3] - extent[2], extent[5] - extent[4]);
-    // this->BlockLocator->CopyRegionLevelDifferences(block);
   }
   image->GetOrigin(origin);
   spacing = image->GetSpacing();
@@ -1499,7 +1846,8 @@ void vtkAMRDualClip::ProcessBlock(
           cornerOffsets[5] = xOffset + 1 + zInc;
           cornerOffsets[6] = xOffset + yInc + zInc;
           cornerOffsets[7] = xOffset + 1 + yInc + zInc;
-          this->ProcessDualCell(block, blockId, x, y, z, cornerOffsets, volumeFractionArray);
+          this->ProcessDualCell(
+            piece, block, blockId, x, y, z, cornerOffsets, volumeFractionArray);
         }
         xOffset += 1; // xInc
       }
@@ -1508,14 +1856,14 @@ void vtkAMRDualClip::ProcessBlock(
     zOffset += zInc;
   }
 
-  if (this->EnableMergePoints)
+  if (piece->ShareLocators)
   {
     this->ShareLevelMask(block);
     // Copy point ids into neighbor locators.
     this->ShareBlockLocatorWithNeighbors(block);
     // We are done.  We no longer need the locator for this block.
-    delete this->BlockLocator;
-    this->BlockLocator = nullptr;
+    delete piece->BlockLocator;
+    piece->BlockLocator = nullptr;
     block->UserData = nullptr;
     // Lets use this unused flag (owner of center region/block) to indicate
     // that the block is already processes.
@@ -1530,8 +1878,8 @@ void vtkAMRDualClip::ProcessBlock(
 //----------------------------------------------------------------------------
 // Not implemented as optimally as we could.  It can be improved by making
 // a fast path for internal cells (with no degeneracies).
-void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int blockId, int x, int y,
-  int z, vtkIdType cornerOffsets[8], vtkDataArray* volumeFractionArray)
+void vtkAMRDualClip::ProcessDualCell(vtkAMRDualClipPiece* piece, vtkAMRDualGridHelperBlock* block,
+  int blockId, int x, int y, int z, vtkIdType cornerOffsets[8], vtkDataArray* volumeFractionArray)
 {
   // compute the case index
   vtkImageData* image = block->Image;
@@ -1759,8 +2107,8 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
       // convert from VTK corner ids to bit (x,y,z) corner ids.
       if (casePtId < 8)
       { // Corner (internal point)
-        ptIdPtr = this->BlockLocator->GetCornerPointer(x, y, z, casePtId, block->OriginIndex);
-        levelMaskValue = this->BlockLocator->GetLevelMaskValue(
+        ptIdPtr = piece->BlockLocator->GetCornerPointer(x, y, z, casePtId, block->OriginIndex);
+        levelMaskValue = piece->BlockLocator->GetLevelMaskValue(
           x + ((casePtId & 1) ? 1 : 0), y + ((casePtId & 2) ? 1 : 0), z + ((casePtId & 4) ? 1 : 0));
         if (levelMaskValue == 0)
         { // bug !!!!! trying to figure out what is going on.
@@ -1812,7 +2160,7 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
           pt[0] = origin[0] + spacing[0] * (double)(1 << levelDiff) * ((double)(px) + dx);
           pt[1] = origin[1] + spacing[1] * (double)(1 << levelDiff) * ((double)(py) + dy);
           pt[2] = origin[2] + spacing[2] * (double)(1 << levelDiff) * ((double)(pz) + dz);
-          *ptIdPtr = this->Points->InsertNextPoint(pt);
+          piece->InsertNextPoint(ptIdPtr, pt);
           if (pt[1] > 100000.0)
           {
             cerr << "bug\n";
@@ -1826,14 +2174,14 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
           // Averaging could be a pre processing step but we would have to modify input attributes
           // .......
           vtkIdType offset = cornerOffsets[casePtId];
-          this->Mesh->GetPointData()->CopyData(block->Image->GetCellData(), offset, *ptIdPtr);
+          piece->Mesh->GetPointData()->CopyData(block->Image->GetCellData(), offset, *ptIdPtr);
 
-          this->LevelMaskPointArray->InsertNextValue(levelMaskValue);
+          piece->LevelMaskPointArray->InsertNextValue(levelMaskValue);
         }
       }
       else
       { // Edge (clipped cell, point on iso surface)
-        ptIdPtr = this->BlockLocator->GetEdgePointer(x, y, z, casePtId - 8);
+        ptIdPtr = piece->BlockLocator->GetEdgePointer(x, y, z, casePtId - 8);
         if (*ptIdPtr == -1)
         {
           int edge = casePtId - 8;
@@ -1850,7 +2198,7 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
             cornerPoints[pt1Idx | 1] + k * (cornerPoints[pt2Idx | 1] - cornerPoints[pt1Idx | 1]);
           pt[2] =
             cornerPoints[pt1Idx | 2] + k * (cornerPoints[pt2Idx | 2] - cornerPoints[pt1Idx | 2]);
-          *ptIdPtr = this->Points->InsertNextPoint(pt);
+          piece->InsertNextPoint(ptIdPtr, pt);
           if (pt[1] > 100000.0)
           {
             cerr << "bug\n";
@@ -1860,10 +2208,10 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
           // Find the offsets of the two attributes to interpolate
           vtkIdType offset0 = cornerOffsets[pt1Idx >> 2];
           vtkIdType offset1 = cornerOffsets[pt2Idx >> 2];
-          this->Mesh->GetPointData()->InterpolateEdge(
+          piece->Mesh->GetPointData()->InterpolateEdge(
             block->Image->GetCellData(), *ptIdPtr, offset0, offset1, k);
 
-          this->LevelMaskPointArray->InsertNextValue(levelMaskValue);
+          piece->LevelMaskPointArray->InsertNextValue(levelMaskValue);
         }
       }
       pointIds[ii] = *ptIdPtr;
@@ -1871,8 +2219,8 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
     if (pointIds[0] != pointIds[1] && pointIds[0] != pointIds[2] && pointIds[0] != pointIds[3] &&
       pointIds[1] != pointIds[2] && pointIds[1] != pointIds[3] && pointIds[2] != pointIds[3])
     {
-      this->Cells->InsertNextCell(4, pointIds);
-      this->BlockIdCellArray->InsertNextValue(blockId);
+      piece->Cells->InsertNextCell(4, pointIds);
+      piece->BlockIdCellArray->InsertNextValue(blockId);
     }
   }
 }
@@ -10,6 +10,11 @@
  * transitions are handled correctly, and second is that internal
  * cells are decimated.  I use a variation of degenerate points/cells
  * used for level transitions.
+ *
+ * When more than one thread is available (see vtkSMPTools), the blocks are
+ * processed concurrently, each with its own locator, and the points shared by
+ * blocks are merged once all blocks are processed. The output is the same as
+ * when processing the blocks serially.
  */
 
 #ifndef vtkAMRDualClip_h
@@ -36,6 +41,7 @@ class vtkAMRDualGridHelper;
 class vtkAMRDualGridHelperBlock;
 class vtkAMRDualGridHelperFace;
 class vtkAMRDualClipLocator;
+class vtkAMRDualClipPiece;
 
 class VTKPVVTKEXTENSIONSAMR_EXPORT vtkAMRDualClip : public vtkMultiBlockDataSetAlgorithm
 {
@@ -89,9 +95,6 @@ protected:
   int EnableMultiProcessCommunication;
   int EnableMergePoints;
 
-  // Needed for copying cell data to point data.
-  vtkUnstructuredGrid* Mesh;
-
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
 
   void InitializeCopyAttributes(vtkNonOverlappingAMR* hbdsInput, vtkDataSet* mesh);
@@ -107,12 +110,24 @@ protected:
 
   void ShareBlockLocatorWithNeighbors(vtkAMRDualGridHelperBlock* block);
 
-  void ProcessBlock(vtkAMRDualGridHelperBlock* block, int blockId, const char* arrayName);
+  void InitializePiece(vtkAMRDualClipPiece* piece, vtkNonOverlappingAMR* input);
+
+  /**
+   * Process the local blocks concurrently and append them to `output`.
+   */
+  void ProcessBlocks(
+    vtkAMRDualClipPiece* output, vtkNonOverlappingAMR* input, const char* arrayName);
 
-  void ProcessDualCell(vtkAMRDualGridHelperBlock* block, int blockId, int x, int y, int z,
-    vtkIdType cornerOffsets[8], vtkDataArray* volumeFractionArray);
+  void AppendPiece(vtkAMRDualClipPiece* output, vtkAMRDualClipPiece* piece);
+
+  void ProcessBlock(vtkAMRDualClipPiece* piece, vtkAMRDualGridHelperBlock* block, int blockId,
+    const char* arrayName);
+
+  void ProcessDualCell(vtkAMRDualClipPiece* piece, vtkAMRDualGridHelperBlock* block, int blockId,
+    int x, int y, int z, vtkIdType cornerOffsets[8], vtkDataArray* volumeFractionArray);
 
   void InitializeLevelMask(vtkAMRDualGridHelperBlock* block);
+  void InitializeLevelMask(vtkAMRDualClipPiece* piece);
   void ShareLevelMask(vtkAMRDualGridHelperBlock* block);
   void DistributeLevelMasks();
 
@@ -121,14 +136,8 @@ protected:
   // void MirrorCases();
   // void AddGlyph(double x, double y, double z);
 
-  // Stuff exclusively for debugging.
-  vtkIntArray* BlockIdCellArray;
-  vtkUnsignedCharArray* LevelMaskPointArray;
-
   // Ivars used to reduce method parrameters.
   vtkAMRDualGridHelper* Helper;
-  vtkPoints* Points;
-  vtkCellArray* Cells;
 
   vtkMultiProcessController* Controller;
 
@@ -137,8 +146,6 @@ protected:
   int* MessageBuffer;
   int* MessageBufferLength;
 
-  vtkAMRDualClipLocator* BlockLocator;
-
 private:
   vtkAMRDualClip(const vtkAMRDualClip&) = delete;
   void operator=(const vtkAMRDualClip&) = delete;
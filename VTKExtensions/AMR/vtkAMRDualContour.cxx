@@ -20,16 +20,23 @@
 // Data sets
 #include "vtkAMRBox.h"
 #include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
 #include "vtkCellData.h"
 #include "vtkCompositeDataIterator.h"
 #include "vtkDataSet.h"
 #include "vtkFloatArray.h"
 #include "vtkImageData.h"
+#include "vtkIntArray.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiPieceDataSet.h"
+#include "vtkNew.h"
 #include "vtkNonOverlappingAMR.h"
 #include "vtkPointData.h"
+#include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkUniformGrid.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
@@ -37,6 +44,7 @@
 #include <algorithm>
 #include <cmath>
 #include <ctime>
+#include <memory>
 
 vtkStandardNewMacro(vtkAMRDualContour);
 
@@ -94,6 +102,13 @@ public:
   void ShareBlockLocatorWithNeighbor(
     vtkAMRDualGridHelperBlock* block, vtkAMRDualGridHelperBlock* neighbor);
 
+  // Description:
+  // Convert a pointer returned by GetEdgePointer or GetCornerPointer to an
+  // index, and back. This is used to find the entry of a point in another
+  // locator initialized for the same block.
+  vtkIdType GetEntryIndex(const vtkIdType* ptr) const { return ptr - this->XEdges; }
+  vtkIdType* GetEntryPointer(vtkIdType index) { return this->XEdges + index; }
+
 private:
   int DualCellDimensions[3];
   // Increments for translating 3d to 1d.  XIncrement = 1;
@@ -146,13 +161,9 @@ void vtkAMRDualContourEdgeLocator::Initialize(int xDualCellDim, int yDualCellDim
   if (xDualCellDim != this->DualCellDimensions[0] || yDualCellDim != this->DualCellDimensions[1] ||
     zDualCellDim != this->DualCellDimensions[2])
   {
-    if (this->XEdges)
-    { // They are all allocated at once, so separate checks are not necessary.
-      delete[] this->XEdges;
-      delete[] this->YEdges;
-      delete[] this->ZEdges;
-      delete[] this->Corners;
-    }
+    // They are all allocated at once, in a single buffer.
+    delete[] this->XEdges;
+    this->XEdges = this->YEdges = this->ZEdges = this->Corners = nullptr;
     if (xDualCellDim > 0 && yDualCellDim > 0 && zDualCellDim > 0)
     {
       this->DualCellDimensions[0] = xDualCellDim;
@@ -162,10 +173,10 @@ void vtkAMRDualContourEdgeLocator::Initialize(int xDualCellDim, int yDualCellDim
       this->YIncrement = this->DualCellDimensions[0] + 1;
       this->ZIncrement = this->YIncrement * (this->DualCellDimensions[1] + 1);
       this->ArrayLength = this->ZIncrement * (this->DualCellDimensions[2] + 1);
-      this->XEdges = new vtkIdType[this->ArrayLength];
-      this->YEdges = new vtkIdType[this->ArrayLength];
-      this->ZEdges = new vtkIdType[this->ArrayLength];
-      this->Corners = new vtkIdType[this->ArrayLength];
+      this->XEdges = new vtkIdType[4 * static_cast<size_t>(this->ArrayLength)];
+      this->YEdges = this->XEdges + this->ArrayLength;
+      this->ZEdges = this->YEdges + this->ArrayLength;
+      this->Corners = this->ZEdges + this->ArrayLength;
     }
     else
     {
@@ -177,11 +188,7 @@ void vtkAMRDualContourEdgeLocator::Initialize(int xDualCellDim, int yDualCellDim
     }
   }
 
-  for (int idx = 0; idx < this->ArrayLength; ++idx)
-  {
-    this->XEdges[idx] = this->YEdges[idx] = this->ZEdges[idx] = -1;
-    this->Corners[idx] = -1;
-  }
+  std::fill_n(this->XEdges, 4 * static_cast<size_t>(this->ArrayLength), -1);
 
   int x, y, z;
   for (z = 0; z < 3; ++z)
@@ -554,6 +561,46 @@ void vtkAMRDualContourEdgeLocator::ShareBlockLocatorWithNeighbor(
   }
 }
 
+//============================================================================
+// Output of ProcessBlock(). Blocks are either all processed serially into the
+// output, or each into its own piece concurrently; the pieces are then
+// appended to the output in the order the blocks are processed serially.
+class vtkAMRDualContourPiece
+{
+public:
+  vtkSmartPointer<vtkPolyData> Mesh;
+  vtkPoints* Points = nullptr;
+  vtkCellArray* Faces = nullptr;
+  vtkIntArray* BlockIdCellArray = nullptr;
+
+  // When set, blocks use the locator stored in the block so that point ids
+  // are shared with neighbor blocks. Otherwise Locator is used.
+  bool ShareLocators = false;
+  vtkAMRDualContourEdgeLocator* Locator = nullptr;
+  vtkAMRDualContourEdgeLocator* BlockLocator = nullptr;
+
+  // The block of a piece processed concurrently. ProcessBlock() sets
+  // Processed if the block has the array to contour.
+  vtkAMRDualGridHelperBlock* Block = nullptr;
+  int BlockId = 0;
+  bool Processed = false;
+
+  // When set, the locator entry of each point is saved in LocatorEntries so
+  // that points can be merged with the neighbor blocks when appending.
+  bool RecordLocatorEntries = false;
+  std::vector<vtkIdType> LocatorEntries;
+
+  vtkIdType InsertNextPoint(vtkIdType* ptIdPtr, const double pt[3])
+  {
+    *ptIdPtr = this->Points->InsertNextPoint(pt);
+    if (this->RecordLocatorEntries)
+    {
+      this->LocatorEntries.push_back(this->BlockLocator->GetEntryIndex(ptIdPtr));
+    }
+    return *ptIdPtr;
+  }
+};
+
 //============================================================================
 //----------------------------------------------------------------------------
 // Description:
@@ -577,20 +624,12 @@ vtkAMRDualContour::vtkAMRDualContour()
   this->SetNumberOfOutputPorts(1);
 
   this->TemperatureArray = nullptr;
-  this->BlockIdCellArray = nullptr;
   this->Helper = nullptr;
-
-  this->BlockLocator = nullptr;
 }
 
 //----------------------------------------------------------------------------
 vtkAMRDualContour::~vtkAMRDualContour()
 {
-  if (this->BlockLocator)
-  {
-    delete this->BlockLocator;
-    this->BlockLocator = nullptr;
-  }
   this->SetController(nullptr);
 }
 
@@ -729,7 +768,11 @@ void vtkAMRDualContour::FinalizeRequest()
 vtkMultiBlockDataSet* vtkAMRDualContour::DoRequestData(
   vtkNonOverlappingAMR* hbdsInput, const char* arrayNameToProcess)
 {
+  // Regions are copied between processes on this thread, before any block is
+  // processed, since controllers are not meant to be used from SMP threads.
   this->Helper->SetupData(hbdsInput, arrayNameToProcess);
+  const bool concurrent =
+    vtkSMPTools::GetEstimatedNumberOfThreads() > 1 && this->Helper->GetNumberOfBlocks() > 1;
 
   vtkMultiBlockDataSet* mbdsOutput0 = vtkMultiBlockDataSet::New();
   mbdsOutput0->SetNumberOfBlocks(1);
@@ -738,48 +781,197 @@ vtkMultiBlockDataSet* vtkAMRDualContour::DoRequestData(
 
   mpds->SetNumberOfPieces(0);
 
-  this->Mesh = vtkPolyData::New();
-  this->Points = vtkPoints::New();
-  this->Faces = vtkCellArray::New();
-  this->Mesh->SetPoints(this->Points);
-  this->Mesh->SetPolys(this->Faces);
-  mpds->SetPiece(0, this->Mesh);
+  vtkAMRDualContourPiece output;
+  this->InitializePiece(&output, hbdsInput);
+  mpds->SetPiece(0, output.Mesh);
 
-  this->InitializeCopyAttributes(hbdsInput, this->Mesh);
+  if (concurrent)
+  {
+    this->ProcessBlocks(&output, hbdsInput, arrayNameToProcess);
+  }
+  else
+  {
+    vtkAMRDualContourEdgeLocator locator;
+    output.ShareLocators = (this->EnableMergePoints != 0);
+    output.Locator = &locator;
+
+    // Loop through blocks
+    int numLevels = hbdsInput->GetNumberOfLevels();
+
+    // Add each block.
+    for (int level = 0; level < numLevels; ++level)
+    {
+      int numBlocks = this->Helper->GetNumberOfBlocksInLevel(level);
+      for (int blockId = 0; blockId < numBlocks; ++blockId)
+      {
+        vtkAMRDualGridHelperBlock* block = this->Helper->GetBlock(level, blockId);
+        this->ProcessBlock(&output, block, blockId, arrayNameToProcess);
+      }
+    }
+  }
+
+  this->FinalizeCopyAttributes(output.Mesh);
+
+  mpds->Delete();
+
+  return mbdsOutput0;
+}
+
+//----------------------------------------------------------------------------
+void vtkAMRDualContour::InitializePiece(
+  vtkAMRDualContourPiece* piece, vtkNonOverlappingAMR* hbdsInput)
+{
+  piece->Mesh = vtkSmartPointer<vtkPolyData>::New();
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkCellArray> faces;
+  piece->Mesh->SetPoints(points);
+  piece->Mesh->SetPolys(faces);
+  piece->Points = points;
+  piece->Faces = faces;
+
+  this->InitializeCopyAttributes(hbdsInput, piece->Mesh);
 
   // For debugging.
-  this->BlockIdCellArray = vtkIntArray::New();
-  this->BlockIdCellArray->SetName("BlockIds");
-  this->Mesh->GetCellData()->AddArray(this->BlockIdCellArray);
+  vtkNew<vtkIntArray> blockIds;
+  blockIds->SetName("BlockIds");
+  piece->Mesh->GetCellData()->AddArray(blockIds);
+  piece->BlockIdCellArray = blockIds;
+}
 
-  // Loop through blocks
+//----------------------------------------------------------------------------
+void vtkAMRDualContour::ProcessBlocks(
+  vtkAMRDualContourPiece* output, vtkNonOverlappingAMR* hbdsInput, const char* arrayNameToProcess)
+{
+  // One piece per local block, in the order blocks are processed serially.
+  std::vector<vtkAMRDualContourPiece> pieces;
+  pieces.reserve(this->Helper->GetNumberOfBlocks());
   int numLevels = hbdsInput->GetNumberOfLevels();
-
-  // Add each block.
   for (int level = 0; level < numLevels; ++level)
   {
     int numBlocks = this->Helper->GetNumberOfBlocksInLevel(level);
     for (int blockId = 0; blockId < numBlocks; ++blockId)
     {
       vtkAMRDualGridHelperBlock* block = this->Helper->GetBlock(level, blockId);
-      this->ProcessBlock(block, blockId, arrayNameToProcess);
+      if (block->Image == nullptr)
+      { // Remote blocks are only to setup local block bit flags.
+        continue;
+      }
+      pieces.emplace_back();
+      vtkAMRDualContourPiece& piece = pieces.back();
+      this->InitializePiece(&piece, hbdsInput);
+      piece.Block = block;
+      piece.BlockId = blockId;
+      piece.RecordLocatorEntries = (this->EnableMergePoints != 0);
     }
   }
 
-  this->FinalizeCopyAttributes(this->Mesh);
-  this->BlockIdCellArray->Delete();
-  this->BlockIdCellArray = nullptr;
+  vtkSMPThreadLocal<std::shared_ptr<vtkAMRDualContourEdgeLocator>> locators;
+  vtkSMPTools::For(
+    0, static_cast<vtkIdType>(pieces.size()), 1, [&](vtkIdType begin, vtkIdType end) {
+      std::shared_ptr<vtkAMRDualContourEdgeLocator>& locator = locators.Local();
+      if (!locator)
+      {
+        locator = std::make_shared<vtkAMRDualContourEdgeLocator>();
+      }
+      for (vtkIdType idx = begin; idx < end; ++idx)
+      {
+        vtkAMRDualContourPiece& piece = pieces[idx];
+        piece.Locator = locator.get();
+        this->ProcessBlock(&piece, piece.Block, piece.BlockId, arrayNameToProcess);
+      }
+    });
 
-  this->Mesh->Delete();
-  this->Mesh = nullptr;
-  this->Points->Delete();
-  this->Points = nullptr;
-  this->Faces->Delete();
-  this->Faces = nullptr;
+  for (auto& piece : pieces)
+  {
+    this->AppendPiece(output, &piece);
+    // Release the memory as soon as possible.
+    piece.Mesh = nullptr;
+    piece.LocatorEntries = std::vector<vtkIdType>();
+  }
+}
 
-  mpds->Delete();
+//----------------------------------------------------------------------------
+void vtkAMRDualContour::AppendPiece(vtkAMRDualContourPiece* output, vtkAMRDualContourPiece* piece)
+{
+  if (!piece->Processed)
+  {
+    return;
+  }
 
-  return mbdsOutput0;
+  vtkAMRDualGridHelperBlock* block = piece->Block;
+  vtkAMRDualContourEdgeLocator* blockLocator = nullptr;
+  if (this->EnableMergePoints)
+  {
+    // Replay the sharing of point ids between blocks done when blocks are
+    // processed serially, so that the output is the same.
+    blockLocator = ::vtkAMRDualContourGetBlockLocator(block);
+  }
+
+  vtkPointData* inPD = piece->Mesh->GetPointData();
+  vtkPointData* outPD = output->Mesh->GetPointData();
+  // Both meshes are initialized the same way, so arrays have the same index.
+  int numArrays = outPD->GetNumberOfArrays();
+
+  vtkIdType numPoints = piece->Points->GetNumberOfPoints();
+  std::vector<vtkIdType> pointMap(numPoints);
+  for (vtkIdType ptId = 0; ptId < numPoints; ++ptId)
+  {
+    vtkIdType* ptIdPtr = nullptr;
+    if (blockLocator)
+    {
+      ptIdPtr = blockLocator->GetEntryPointer(piece->LocatorEntries[ptId]);
+      if (*ptIdPtr >= 0)
+      { // The point was created by a neighbor block.
+        pointMap[ptId] = *ptIdPtr;
+        continue;
+      }
+    }
+    vtkIdType outId = output->Points->GetData()->InsertNextTuple(ptId, piece->Points->GetData());
+    for (int idx = 0; idx < numArrays; ++idx)
+    {
+      outPD->GetAbstractArray(idx)->InsertTuple(outId, ptId, inPD->GetAbstractArray(idx));
+    }
+    pointMap[ptId] = outId;
+    if (ptIdPtr)
+    {
+      *ptIdPtr = outId;
+    }
+  }
+
+  std::vector<vtkIdType> cellPointIds;
+  vtkIdType cellId = 0;
+  auto iter = vtk::TakeSmartPointer(piece->Faces->NewIterator());
+  for (iter->GoToFirstCell(); !iter->IsDoneWithTraversal(); iter->GoToNextCell(), ++cellId)
+  {
+    vtkIdType numCellPoints;
+    const vtkIdType* ptIds;
+    iter->GetCurrentCell(numCellPoints, ptIds);
+    cellPointIds.resize(numCellPoints);
+    for (vtkIdType idx = 0; idx < numCellPoints; ++idx)
+    {
+      cellPointIds[idx] = pointMap[ptIds[idx]];
+    }
+    // Merging points can make triangles degenerate.
+    if (numCellPoints == 3 &&
+      (cellPointIds[0] == cellPointIds[1] || cellPointIds[0] == cellPointIds[2] ||
+        cellPointIds[1] == cellPointIds[2]))
+    {
+      continue;
+    }
+    output->Faces->InsertNextCell(numCellPoints, cellPointIds.data());
+    output->BlockIdCellArray->InsertNextValue(piece->BlockIdCellArray->GetValue(cellId));
+  }
+
+  if (blockLocator)
+  {
+    // Copy point ids into neighbor locators.
+    this->ShareBlockLocatorWithNeighbors(block);
+    // We are done.  We no longer need the locator for this block.
+    delete blockLocator;
+    block->UserData = nullptr;
+    // Mark the block as processed (see ProcessBlock).
+    block->RegionBits[1][1][1] = 0;
+  }
 }
 
 //----------------------------------------------------------------------------
@@ -831,7 +1023,7 @@ void vtkAMRDualContour::ShareBlockLocatorWithNeighbors(vtkAMRDualGridHelperBlock
 }
 
 //----------------------------------------------------------------------------
-void vtkAMRDualContour::ProcessBlock(
+void vtkAMRDualContour::ProcessBlock(vtkAMRDualContourPiece* piece,
   vtkAMRDualGridHelperBlock* block, int blockId, const char* arrayNameToProcess)
 {
   vtkImageData* image = block->Image;
@@ -847,6 +1039,7 @@ void vtkAMRDualContour::ProcessBlock(
   {
     return;
   }
+  piece->Processed = true;
 
   double origin[3];
   double* spacing;
@@ -861,19 +1054,16 @@ void vtkAMRDualContour::ProcessBlock(
 
   // Locator merges points in this block.
   // Input the dimensions of the dual cells with ghosts.
-  if (this->EnableMergePoints)
+  if (piece->ShareLocators)
   {
-    this->BlockLocator = ::vtkAMRDualContourGetBlockLocator(block);
+    piece->BlockLocator = ::vtkAMRDualContourGetBlockLocator(block);
   }
   else
   { // Shared locator.
-    if (this->BlockLocator == nullptr)
-    {
-      this->BlockLocator = new vtkAMRDualContourEdgeLocator;
-    }
-    this->BlockLocator->Initialize(
+    piece->BlockLocator = piece->Locator;
+    piece->BlockLocator->Initialize(
       extent[1] - extent[0], extent[3] - extent[2], extent[5] - extent[4]);
-    this->BlockLocator->CopyRegionLevelDifferences(block);
+    piece->BlockLocator->CopyRegionLevelDifferences(block);
   }
   image->GetOrigin(origin);
   spacing = image->GetSpacing();
@@ -954,7 +1144,8 @@ void vtkAMRDualContour::ProcessBlock(
           cornerOffsets[5] = xOffset + 1 + zInc;
           cornerOffsets[6] = xOffset + 1 + yInc + zInc;
           cornerOffsets[7] = xOffset + yInc + zInc;
-          this->ProcessDualCell(block, blockId, x, y, z, cornerOffsets, volumeFractionArray);
+          this->ProcessDualCell(
+            piece, block, blockId, x, y, z, cornerOffsets, volumeFractionArray);
         }
         xOffset += 1; // xInc
       }
@@ -963,13 +1154,13 @@ void vtkAMRDualContour::ProcessBlock(
     zOffset += zInc;
   }
 
-  if (this->EnableMergePoints)
+  if (piece->ShareLocators)
   {
     // Copy point ids into neighbor locators.
     this->ShareBlockLocatorWithNeighbors(block);
     // We are done.  We no longer need the locator for this block.
-    delete this->BlockLocator;
-    this->BlockLocator = nullptr;
+    delete piece->BlockLocator;
+    piece->BlockLocator = nullptr;
     block->UserData = nullptr;
     // Lets use this unused flag (owner of center region/block) to indicate
     // that the block is already processes.
@@ -1041,8 +1232,9 @@ static int vtkAMRDualLegacyIdToBitIdMap[8] = { 0, 1, 3, 2, 4, 5, 7, 6 };
 // Not implemented as optimally as we could.  It can be improved by making
 // a fast path for internal cells (with no degeneracies).
 // Corner offsets are absolute (relative to origin / 0).
-void vtkAMRDualContour::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int blockId, int x, int y,
-  int z, vtkIdType cornerOffsets[8], vtkDataArray* volumeFractionArray)
+void vtkAMRDualContour::ProcessDualCell(vtkAMRDualContourPiece* piece,
+  vtkAMRDualGridHelperBlock* block, int blockId, int x, int y, int z, vtkIdType cornerOffsets[8],
+  vtkDataArray* volumeFractionArray)
 {
   // compute the case index
   vtkImageData* image = block->Image;
@@ -1279,7 +1471,7 @@ void vtkAMRDualContour::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int bl
     // Only permanently keep locator for edges shared between two blocks.
     for (int ii = 0; ii < 3; ++ii, ++edge) // insert triangle
     {
-      vtkIdType* ptIdPtr = this->BlockLocator->GetEdgePointer(x, y, z, *edge);
+      vtkIdType* ptIdPtr = piece->BlockLocator->GetEdgePointer(x, y, z, *edge);
 
       if (*ptIdPtr == -1)
       {
@@ -1307,31 +1499,32 @@ void vtkAMRDualContour::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int bl
           cornerPoints[pt1Idx | 1] + k * (cornerPoints[pt2Idx | 1] - cornerPoints[pt1Idx | 1]);
         pt[2] =
           cornerPoints[pt1Idx | 2] + k * (cornerPoints[pt2Idx | 2] - cornerPoints[pt1Idx | 2]);
-        *ptIdPtr = this->Points->InsertNextPoint(pt);
+        piece->InsertNextPoint(ptIdPtr, pt);
         // Interpolate attributes
         // Find the offsets of the two attributes to interpolate
         vtkIdType offset0 = cornerOffsets[vtkAMRDualIsoEdgeToVTKPointsTable[*edge][0]];
         vtkIdType offset1 = cornerOffsets[vtkAMRDualIsoEdgeToVTKPointsTable[*edge][1]];
-        this->InterpolateAttributes(block->Image, offset0, offset1, k, this->Mesh, *ptIdPtr);
+        this->InterpolateAttributes(block->Image, offset0, offset1, k, piece->Mesh, *ptIdPtr);
       }
       edgePointIds[*edge] = pointIds[ii] = *ptIdPtr;
     }
     if (pointIds[0] != pointIds[1] && pointIds[0] != pointIds[2] && pointIds[1] != pointIds[2])
     {
-      this->Faces->InsertNextCell(3, pointIds);
-      this->BlockIdCellArray->InsertNextValue(blockId);
+      piece->Faces->InsertNextCell(3, pointIds);
+      piece->BlockIdCellArray->InsertNextValue(blockId);
     }
   }
 
   if (this->EnableCapping)
   {
-    this->CapCell(x, y, z, cubeBoundaryBits, cubeCase, edgePointIds, cornerPoints, cornerOffsets,
-      blockId, block->Image);
+    this->CapCell(piece, x, y, z, cubeBoundaryBits, cubeCase, edgePointIds, cornerPoints,
+      cornerOffsets, blockId, block->Image);
   }
 }
 
 //----------------------------------------------------------------------------
-void vtkAMRDualContour::AddCapPolygon(int ptCount, vtkIdType* pointIds, int blockId)
+void vtkAMRDualContour::AddCapPolygon(
+  vtkAMRDualContourPiece* piece, int ptCount, vtkIdType* pointIds, int blockId)
 {
   if (this->TriangulateCap)
   {
@@ -1347,8 +1540,8 @@ void vtkAMRDualContour::AddCapPolygon(int ptCount, vtkIdType* pointIds, int bloc
         tri[2] = pointIds[low];
         if (tri[0] != tri[1] && tri[0] != tri[2] && tri[1] != tri[2])
         {
-          this->Faces->InsertNextCell(3, tri);
-          this->BlockIdCellArray->InsertNextValue(blockId);
+          piece->Faces->InsertNextCell(3, tri);
+          piece->BlockIdCellArray->InsertNextValue(blockId);
         }
       }
       else
@@ -1358,16 +1551,16 @@ void vtkAMRDualContour::AddCapPolygon(int ptCount, vtkIdType* pointIds, int bloc
         tri[2] = pointIds[low];
         if (tri[0] != tri[1] && tri[0] != tri[2] && tri[1] != tri[2])
         {
-          this->Faces->InsertNextCell(3, tri);
-          this->BlockIdCellArray->InsertNextValue(blockId);
+          piece->Faces->InsertNextCell(3, tri);
+          piece->BlockIdCellArray->InsertNextValue(blockId);
         }
         tri[0] = pointIds[high];
         tri[1] = pointIds[high + 1];
         tri[2] = pointIds[low];
         if (tri[0] != tri[1] && tri[0] != tri[2] && tri[1] != tri[2])
         {
-          this->Faces->InsertNextCell(3, tri);
-          this->BlockIdCellArray->InsertNextValue(blockId);
+          piece->Faces->InsertNextCell(3, tri);
+          piece->BlockIdCellArray->InsertNextValue(blockId);
         }
       }
       ++low;
@@ -1377,8 +1570,8 @@ void vtkAMRDualContour::AddCapPolygon(int ptCount, vtkIdType* pointIds, int bloc
   else
   {
     // Do not worry about degenerate polygons in this path.
-    this->Faces->InsertNextCell(ptCount, pointIds);
-    this->BlockIdCellArray->InsertNextValue(blockId);
+    piece->Faces->InsertNextCell(ptCount, pointIds);
+    piece->BlockIdCellArray->InsertNextValue(blockId);
   }
 }
 
@@ -1390,6 +1583,8 @@ void vtkAMRDualContour::AddCapPolygon(int ptCount, vtkIdType* pointIds, int bloc
 // It ends up being a little long to duplicate the code 6 times,
 // but it is still fast.
 void vtkAMRDualContour::CapCell(
+  // Output of the block.
+  vtkAMRDualContourPiece* piece,
   // cell index in block coordinates.
   int cellX, int cellY, int cellZ,
   // Which cell faces need to be capped.
@@ -1424,12 +1619,12 @@ void vtkAMRDualContour::CapCell(
         if (*capPtr < 4)
         {
           cornerIdx = (vtkAMRDualIsoNXCapEdgeMap[*capPtr]);
-          ptIdPtr = this->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
+          ptIdPtr = piece->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
           if (*ptIdPtr == -1)
           {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
-            this->CopyAttributes(
-              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+            piece->InsertNextPoint(ptIdPtr, cornerPoints + (cornerIdx << 2));
+            this->CopyAttributes(inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]],
+              piece->Mesh, *ptIdPtr);
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1439,7 +1634,7 @@ void vtkAMRDualContour::CapCell(
         }
         ++capPtr;
       }
-      this->AddCapPolygon(ptCount, pointIds, blockId);
+      this->AddCapPolygon(piece, ptCount, pointIds, blockId);
       if (*capPtr == -1)
       {
         ++capPtr;
@@ -1460,12 +1655,12 @@ void vtkAMRDualContour::CapCell(
         if (*capPtr < 4)
         {
           cornerIdx = (vtkAMRDualIsoPXCapEdgeMap[*capPtr]);
-          ptIdPtr = this->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
+          ptIdPtr = piece->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
           if (*ptIdPtr == -1)
           {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
-            this->CopyAttributes(
-              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+            piece->InsertNextPoint(ptIdPtr, cornerPoints + (cornerIdx << 2));
+            this->CopyAttributes(inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]],
+              piece->Mesh, *ptIdPtr);
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1475,7 +1670,7 @@ void vtkAMRDualContour::CapCell(
         }
         ++capPtr;
       }
-      this->AddCapPolygon(ptCount, pointIds, blockId);
+      this->AddCapPolygon(piece, ptCount, pointIds, blockId);
       if (*capPtr == -1)
       {
         ++capPtr;
@@ -1497,12 +1692,12 @@ void vtkAMRDualContour::CapCell(
         if (*capPtr < 4)
         {
           cornerIdx = (vtkAMRDualIsoNYCapEdgeMap[*capPtr]);
-          ptIdPtr = this->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
+          ptIdPtr = piece->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
           if (*ptIdPtr == -1)
           {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
-            this->CopyAttributes(
-              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+            piece->InsertNextPoint(ptIdPtr, cornerPoints + (cornerIdx << 2));
+            this->CopyAttributes(inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]],
+              piece->Mesh, *ptIdPtr);
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1512,7 +1707,7 @@ void vtkAMRDualContour::CapCell(
         }
         ++capPtr;
       }
-      this->AddCapPolygon(ptCount, pointIds, blockId);
+      this->AddCapPolygon(piece, ptCount, pointIds, blockId);
       if (*capPtr == -1)
       {
         ++capPtr;
@@ -1534,12 +1729,12 @@ void vtkAMRDualContour::CapCell(
         if (*capPtr < 4)
         {
           cornerIdx = (vtkAMRDualIsoPYCapEdgeMap[*capPtr]);
-          ptIdPtr = this->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
+          ptIdPtr = piece->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
           if (*ptIdPtr == -1)
           {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
-            this->CopyAttributes(
-              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+            piece->InsertNextPoint(ptIdPtr, cornerPoints + (cornerIdx << 2));
+            this->CopyAttributes(inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]],
+              piece->Mesh, *ptIdPtr);
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1549,7 +1744,7 @@ void vtkAMRDualContour::CapCell(
         }
         ++capPtr;
       }
-      this->AddCapPolygon(ptCount, pointIds, blockId);
+      this->AddCapPolygon(piece, ptCount, pointIds, blockId);
       if (*capPtr == -1)
       {
         ++capPtr;
@@ -1570,12 +1765,12 @@ void vtkAMRDualContour::CapCell(
         if (*capPtr < 4)
         {
           cornerIdx = (vtkAMRDualIsoNZCapEdgeMap[*capPtr]);
-          ptIdPtr = this->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
+          ptIdPtr = piece->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
           if (*ptIdPtr == -1)
           {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
-            this->CopyAttributes(
-              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+            piece->InsertNextPoint(ptIdPtr, cornerPoints + (cornerIdx << 2));
+            this->CopyAttributes(inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]],
+              piece->Mesh, *ptIdPtr);
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1585,7 +1780,7 @@ void vtkAMRDualContour::CapCell(
         }
         ++capPtr;
       }
-      this->AddCapPolygon(ptCount, pointIds, blockId);
+      this->AddCapPolygon(piece, ptCount, pointIds, blockId);
       if (*capPtr == -1)
       {
         ++capPtr;
@@ -1607,12 +1802,12 @@ void vtkAMRDualContour::CapCell(
         if (*capPtr < 4)
         {
           cornerIdx = (vtkAMRDualIsoPZCapEdgeMap[*capPtr]);
-          ptIdPtr = this->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
+          ptIdPtr = piece->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
           if (*ptIdPtr == -1)
           {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
-            this->CopyAttributes(
-              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+            piece->InsertNextPoint(ptIdPtr, cornerPoints + (cornerIdx << 2));
+            this->CopyAttributes(inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]],
+              piece->Mesh, *ptIdPtr);
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1622,7 +1817,7 @@ void vtkAMRDualContour::CapCell(
         }
         ++capPtr;
       }
-      this->AddCapPolygon(ptCount, pointIds, blockId);
+      this->AddCapPolygon(piece, ptCount, pointIds, blockId);
       if (*capPtr == -1)
       {
         ++capPtr;
@@ -12,6 +12,12 @@
  *
  * Input should be a vtkNonOverlappingAMR data.
  *
+ * When more than one thread is available (see vtkSMPTools), the blocks are
+ * processed concurrently, each with its own locator, and the points shared by
+ * blocks are merged once all blocks are processed. The regions copied between
+ * processes are then received while processing the blocks that do not need
+ * them. The output is the same as when processing the blocks serially.
+ *
  * This will turn on validation and debug i/o of the filter.
  * \code{.cpp}
  * #define vtkAMRDualContourDEBUG
@@ -43,6 +49,7 @@ class vtkAMRDualGridHelper;
 class vtkAMRDualGridHelperBlock;
 class vtkAMRDualGridHelperFace;
 class vtkAMRDualContourEdgeLocator;
+class vtkAMRDualContourPiece;
 
 class VTKPVVTKEXTENSIONSAMR_EXPORT vtkAMRDualContour : public vtkMultiBlockDataSetAlgorithm
 {
@@ -143,16 +150,30 @@ protected:
 
   void ShareBlockLocatorWithNeighbors(vtkAMRDualGridHelperBlock* block);
 
-  void ProcessBlock(vtkAMRDualGridHelperBlock* block, int blockId, const char* arrayName);
+  void InitializePiece(vtkAMRDualContourPiece* piece, vtkNonOverlappingAMR* input);
+
+  /**
+   * Process the local blocks concurrently and append them to `output`.
+   */
+  void ProcessBlocks(
+    vtkAMRDualContourPiece* output, vtkNonOverlappingAMR* input, const char* arrayName);
 
-  void ProcessDualCell(vtkAMRDualGridHelperBlock* block, int blockId, int x, int y, int z,
-    vtkIdType cornerOffsets[8], vtkDataArray* volumeFractionArray);
+  void AppendPiece(vtkAMRDualContourPiece* output, vtkAMRDualContourPiece* piece);
 
-  void AddCapPolygon(int ptCount, vtkIdType* pointIds, int blockId);
+  void ProcessBlock(vtkAMRDualContourPiece* piece, vtkAMRDualGridHelperBlock* block, int blockId,
+    const char* arrayName);
+
+  void ProcessDualCell(vtkAMRDualContourPiece* piece, vtkAMRDualGridHelperBlock* block,
+    int blockId, int x, int y, int z, vtkIdType cornerOffsets[8],
+    vtkDataArray* volumeFractionArray);
+
+  void AddCapPolygon(vtkAMRDualContourPiece* piece, int ptCount, vtkIdType* pointIds, int blockId);
 
   // This method is getting too many arguments!
   // Capping was an after thought...
   void CapCell(
+    // Output of the block.
+    vtkAMRDualContourPiece* piece,
     // block coordinates
     int cellX, int cellY, int cellZ,
     // Which cell faces need to be capped.
@@ -171,14 +192,10 @@ protected:
     vtkDataSet* inData);
 
   // Stuff exclusively for debugging.
-  vtkIntArray* BlockIdCellArray;
   vtkFloatArray* TemperatureArray;
 
   // Ivars used to reduce method parrameters.
   vtkAMRDualGridHelper* Helper;
-  vtkPolyData* Mesh;
-  vtkPoints* Points;
-  vtkCellArray* Faces;
 
   vtkMultiProcessController* Controller;
 
@@ -187,8 +204,6 @@ protected:
   int* MessageBuffer;
   int* MessageBufferLength;
 
-  vtkAMRDualContourEdgeLocator* BlockLocator;
-
   // Stuff for passing cell attributes to point attributes.
   void InitializeCopyAttributes(vtkNonOverlappingAMR* hbdsInput, vtkDataSet* mesh);
   void InterpolateAttributes(vtkDataSet* uGrid, vtkIdType offset0, vtkIdType offset1, double k,
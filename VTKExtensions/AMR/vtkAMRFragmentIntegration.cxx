@@ -19,6 +19,7 @@
 #include "vtkIdTypeArray.h"
 #include "vtkKdTreePointLocator.h"
 #include "vtkMultiProcessController.h"
+#include "vtkNew.h"
 #include "vtkNonOverlappingAMR.h"
 #include "vtkPointData.h"
 #include "vtkSmartPointer.h"
@@ -28,7 +29,92 @@
 #include "vtkUnsignedCharArray.h"
 
 #include <map>
+#include <string>
+#include <utility>
 #include <vector>
+
+namespace
+{
+using FragmentValuesType = std::map<vtkIdType, std::vector<double>>;
+
+//----------------------------------------------------------------------------
+// Sums the values integrated for each fragment on all processes. The values of
+// a fragment are reduced on, and only kept by, the process whose rank is the
+// fragment id modulo the number of processes. Every pair of processes exchanges
+// a single message: on each step, a process is paired with the process whose
+// rank adds up to the step number, and the lower rank sends first.
+void ReduceFragmentsByKey(
+  vtkMultiProcessController* controller, FragmentValuesType& fragValues, int numValues)
+{
+  const int myProc = controller->GetLocalProcessId();
+  const int numProcs = controller->GetNumberOfProcesses();
+  const int tag = 728574;
+
+  std::vector<vtkSmartPointer<vtkDoubleArray>> sendArrays(numProcs);
+  for (int p = 0; p < numProcs; p++)
+  {
+    sendArrays[p] = vtkSmartPointer<vtkDoubleArray>::New();
+    sendArrays[p]->SetNumberOfComponents(numValues + 1);
+  }
+
+  FragmentValuesType owned;
+  for (auto& frag : fragValues)
+  {
+    int owner = static_cast<int>(frag.first % numProcs);
+    if (owner == myProc)
+    {
+      owned[frag.first] = std::move(frag.second);
+      continue;
+    }
+    vtkDoubleArray* array = sendArrays[owner];
+    array->InsertNextValue(static_cast<double>(frag.first));
+    for (double value : frag.second)
+    {
+      array->InsertNextValue(value);
+    }
+  }
+  fragValues.clear();
+
+  for (int step = 0; step < numProcs; step++)
+  {
+    int partner = (step - myProc + numProcs) % numProcs;
+    if (partner == myProc)
+    {
+      continue;
+    }
+    vtkNew<vtkDoubleArray> received;
+    if (myProc < partner)
+    {
+      controller->Send(sendArrays[partner], partner, tag);
+      controller->Receive(received, partner, tag);
+    }
+    else
+    {
+      controller->Receive(received, partner, tag);
+      controller->Send(sendArrays[partner], partner, tag);
+    }
+    sendArrays[partner] = nullptr;
+
+    const double* data = received->GetPointer(0);
+    for (vtkIdType t = 0; t < received->GetNumberOfTuples(); t++)
+    {
+      const double* tuple = data + t * (numValues + 1);
+      std::vector<double>& values = owned[static_cast<vtkIdType>(tuple[0])];
+      if (values.empty())
+      {
+        values.resize(numValues, 0.0);
+      }
+      for (int v = 0; v < numValues; v++)
+      {
+        values[v] += tuple[v + 1];
+      }
+    }
+  }
+
+  fragValues.swap(owned);
+}
+}
+
 vtkStandardNewMacro(vtkAMRFragmentIntegration);
 
 vtkAMRFragmentIntegration::vtkAMRFragmentIntegration() = default;
@@ -85,122 +171,23 @@ vtkTable* vtkAMRFragmentIntegration::DoRequestData(vtkNonOverlappingAMR* volume,
 {
   vtkMultiProcessController* controller = vtkMultiProcessController::GetGlobalController();
 
-  vtkTable* fragments = vtkTable::New();
-
-  std::map<vtkIdType, vtkIdType> fragIndices;
-
-  vtkTimerLog::MarkStartEvent("Finding max region");
-
-  vtkCompositeDataIterator* iter = volume->NewIterator();
-  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
-  {
-    vtkUniformGrid* grid = vtkUniformGrid::SafeDownCast(iter->GetCurrentDataObject());
-    if (!grid)
-    {
-      vtkErrorMacro("NonOverlappingAMR not made up of UniformGrids");
-      return nullptr;
-    }
-    std::string regionName("RegionId-");
-    regionName += volumeName;
-    vtkDataArray* regionId = grid->GetCellData()->GetArray(regionName.c_str());
-    if (!regionId)
-    {
-      vtkErrorMacro("No RegionID in volume.  Run Connectivity filter.");
-      return nullptr;
-    }
-    vtkUnsignedCharArray* ghostArray = grid->GetCellGhostArray();
-    if (!ghostArray)
-    {
-      vtkErrorMacro("No ghost array attached to the CTH volume data");
-      return nullptr;
-    }
-    for (int c = 0; c < grid->GetNumberOfCells(); c++)
-    {
-      vtkIdType fragId = static_cast<vtkIdType>(regionId->GetTuple1(c));
-      if ((ghostArray->GetValue(c) & vtkDataSetAttributes::DUPLICATECELL) == 0)
-      {
-        vtkIdType index = fragIndices.size();
-        fragIndices[fragId] = index;
-      }
-    }
-  }
-  vtkIdType totalFragments = fragIndices.size();
-  /*
-  if (controller != 0)
-    {
-    vtkIdType outTotal;
-    controller->AllReduce (&totalFragments, &outTotal, 1, vtkCommunicator::SUM_OP);
-    totalFragments = outTotal;
-    }
-    */
-  vtkTimerLog::MarkEndEvent("Finding max region");
-
-  vtkTimerLog::MarkStartEvent("Initializing arrays");
-  vtkIdTypeArray* fragIdArray = vtkIdTypeArray::New();
-  fragIdArray->SetName("Fragment ID");
-  fragIdArray->SetNumberOfComponents(1);
-  fragIdArray->SetNumberOfTuples(totalFragments + 1);
-  fragments->AddColumn(fragIdArray);
-  fragIdArray->Delete();
-
-  vtkDoubleArray* fragVolume = vtkDoubleArray::New();
-  fragVolume->SetName("Fragment Volume");
-  fragVolume->SetNumberOfComponents(1);
-  fragVolume->SetNumberOfTuples(totalFragments + 1);
-  fragments->AddColumn(fragVolume);
-  fragVolume->Delete();
-
-  vtkDoubleArray* fragMass = vtkDoubleArray::New();
-  fragMass->SetName("Fragment Mass");
-  fragMass->SetNumberOfComponents(1);
-  fragMass->SetNumberOfTuples(totalFragments + 1);
-  fragments->AddColumn(fragMass);
-  fragMass->Delete();
-
-  std::vector<vtkSmartPointer<vtkDoubleArray>> volWeightArrays(volumeWeightedNames.size());
-  for (size_t v = 0; v < volumeWeightedNames.size(); v++)
-  {
-    volWeightArrays[v] = vtkSmartPointer<vtkDoubleArray>::New();
-    std::string name("Volume Weighted ");
-    name += volumeWeightedNames[v];
-    volWeightArrays[v]->SetName(name.c_str());
-    volWeightArrays[v]->SetNumberOfComponents(1);
-    volWeightArrays[v]->SetNumberOfTuples(totalFragments + 1);
-    fragments->AddColumn(volWeightArrays[v]);
-  }
+  std::string regionName("RegionId-");
+  regionName += volumeName;
 
-  std::vector<vtkSmartPointer<vtkDoubleArray>> massWeightArrays(massWeightedNames.size());
-  for (size_t m = 0; m < massWeightedNames.size(); m++)
-  {
-    massWeightArrays[m] = vtkSmartPointer<vtkDoubleArray>::New();
-    std::string name("Mass Weighted ");
-    name += massWeightedNames[m];
-    massWeightArrays[m]->SetName(name.c_str());
-    massWeightArrays[m]->SetNumberOfComponents(1);
-    massWeightArrays[m]->SetNumberOfTuples(totalFragments + 1);
-    fragments->AddColumn(massWeightArrays[m]);
-  }
+  const size_t numVolWeighted = volumeWeightedNames.size();
+  const size_t numMassWeighted = massWeightedNames.size();
+  const int numValues = static_cast<int>(2 + numVolWeighted + numMassWeighted);
 
-  for (int i = 0; i < fragIdArray->GetNumberOfTuples(); i++)
-  {
-    fragIdArray->SetTuple1(i, 0);
-    fragVolume->SetTuple1(i, 0);
-    fragMass->SetTuple1(i, 0);
-    for (size_t v = 0; v < volumeWeightedNames.size(); v++)
-    {
-      volWeightArrays[v]->SetTuple1(i, 0);
-    }
-    for (size_t m = 0; m < massWeightedNames.size(); m++)
-    {
-      massWeightArrays[m]->SetTuple1(i, 0);
-    }
-  }
-  vtkTimerLog::MarkEndEvent("Initializing arrays");
+  // The integrated values of each fragment, keyed by region id: volume, mass,
+  // then the volume and mass weighted sums.
+  FragmentValuesType fragValues;
 
-  std::vector<vtkDataArray*> preVolWeightArrays(volumeWeightedNames.size());
-  std::vector<vtkDataArray*> preMassWeightArrays(massWeightedNames.size());
+  std::vector<vtkDataArray*> preVolWeightArrays(numVolWeighted);
+  std::vector<vtkDataArray*> preMassWeightArrays(numMassWeighted);
 
   vtkTimerLog::MarkStartEvent("Independent integration");
+  vtkSmartPointer<vtkCompositeDataIterator> iter;
+  iter.TakeReference(volume->NewIterator());
   for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
   {
     vtkUniformGrid* grid = vtkUniformGrid::SafeDownCast(iter->GetCurrentDataObject());
@@ -215,8 +202,6 @@ vtkTable* vtkAMRFragmentIntegration::DoRequestData(vtkNonOverlappingAMR* volume,
       vtkErrorMacro("No ghost array attached to the CTH volume data");
       return nullptr;
     }
-    std::string regionName("RegionId-");
-    regionName += volumeName;
     vtkDataArray* regionId = grid->GetCellData()->GetArray(regionName.c_str());
     if (!regionId)
     {
@@ -235,45 +220,38 @@ vtkTable* vtkAMRFragmentIntegration::DoRequestData(vtkNonOverlappingAMR* volume,
       vtkErrorMacro(<< "There is no " << massName << " in cell field");
       return nullptr;
     }
-    for (size_t v = 0; v < volumeWeightedNames.size(); v++)
+    for (size_t v = 0; v < numVolWeighted; v++)
     {
       preVolWeightArrays[v] = grid->GetCellData()->GetArray(volumeWeightedNames[v].c_str());
     }
-    for (size_t m = 0; m < massWeightedNames.size(); m++)
+    for (size_t m = 0; m < numMassWeighted; m++)
     {
       preMassWeightArrays[m] = grid->GetCellData()->GetArray(massWeightedNames[m].c_str());
     }
     double* spacing = grid->GetSpacing();
     double cellVol = spacing[0] * spacing[1] * spacing[2];
-    for (int c = 0; c < grid->GetNumberOfCells(); c++)
+    for (vtkIdType c = 0; c < grid->GetNumberOfCells(); c++)
     {
       if (regionId->GetTuple1(c) > 0.0 &&
         (ghostArray->GetValue(c) & vtkDataSetAttributes::DUPLICATECELL) == 0)
       {
         vtkIdType fragId = static_cast<vtkIdType>(regionId->GetTuple1(c));
-        std::map<vtkIdType, vtkIdType>::iterator loc = fragIndices.find(fragId);
-        if (loc == fragIndices.end())
+        std::vector<double>& values = fragValues[fragId];
+        if (values.empty())
         {
-          vtkErrorMacro(<< "Invalid Region Id " << fragId);
+          values.resize(numValues, 0.0);
         }
-        int index = fragIndices[fragId];
-        fragIdArray->SetTuple1(index, fragId);
         double vol = volArray->GetTuple1(c) * cellVol / 255.0;
-        fragVolume->SetTuple1(index, fragVolume->GetTuple1(index) + vol);
         double mass = massArray->GetTuple1(c);
-        fragMass->SetTuple1(index, fragMass->GetTuple1(index) + mass);
-
-        for (size_t v = 0; v < volumeWeightedNames.size(); v++)
+        values[0] += vol;
+        values[1] += mass;
+        for (size_t v = 0; v < numVolWeighted; v++)
         {
-          double value = volWeightArrays[v]->GetTuple1(index);
-          value += preVolWeightArrays[v]->GetTuple1(c) * vol;
-          volWeightArrays[v]->SetTuple1(index, value);
+          values[2 + v] += preVolWeightArrays[v]->GetTuple1(c) * vol;
         }
-        for (size_t m = 0; m < massWeightedNames.size(); m++)
+        for (size_t m = 0; m < numMassWeighted; m++)
         {
-          double value = massWeightArrays[m]->GetTuple1(index);
-          value += preMassWeightArrays[m]->GetTuple1(c) * mass;
-          massWeightArrays[m]->SetTuple1(index, value);
+          values[2 + numVolWeighted + m] += preMassWeightArrays[m]->GetTuple1(c) * mass;
         }
       }
     }
@@ -281,187 +259,54 @@ vtkTable* vtkAMRFragmentIntegration::DoRequestData(vtkNonOverlappingAMR* volume,
   vtkTimerLog::MarkEndEvent("Independent integration");
 
   vtkTimerLog::MarkStartEvent("Combining integration");
-
-  int myProc = 0;
-  int numProcs = 1;
-  if (controller != nullptr)
+  if (controller != nullptr && controller->GetNumberOfProcesses() > 1)
   {
-    myProc = controller->GetLocalProcessId();
-    numProcs = controller->GetNumberOfProcesses();
-
-    vtkIdTypeArray* fragIndicesReceive = vtkIdTypeArray::New();
-    fragIndicesReceive->SetNumberOfComponents(2);
-
-    vtkDoubleArray* fragVolumeReceive = vtkDoubleArray::New();
-    fragVolumeReceive->SetNumberOfComponents(1);
-    // fragVolumeReceive->SetNumberOfTuples (totalFragments + 1);
-
-    vtkDoubleArray* fragMassReceive = vtkDoubleArray::New();
-    fragMassReceive->SetNumberOfComponents(1);
-    // fragMassReceive->SetNumberOfTuples (totalFragments + 1);
-
-    std::vector<vtkSmartPointer<vtkDoubleArray>> volWeightReceive(volumeWeightedNames.size());
-    for (size_t v = 0; v < volumeWeightedNames.size(); v++)
-    {
-      volWeightReceive[v] = vtkSmartPointer<vtkDoubleArray>::New();
-      volWeightReceive[v]->SetNumberOfComponents(1);
-      // volWeightReceive[v]->SetNumberOfTuples (totalFragments + 1);
-    }
-
-    std::vector<vtkSmartPointer<vtkDoubleArray>> massWeightReceive(massWeightedNames.size());
-    for (size_t m = 0; m < massWeightedNames.size(); m++)
-    {
-      massWeightReceive[m] = vtkDoubleArray::New();
-      massWeightReceive[m]->SetNumberOfComponents(1);
-      // massWeightReceive[m]->SetNumberOfTuples (totalFragments + 1);
-    }
-
-    int tag = 728574;
-    int pivot = (numProcs > 1 ? (numProcs + 1) / 2 : 0);
-    while (pivot > 0 && myProc < (pivot * 2))
-    {
-      if (myProc >= pivot)
-      {
-        int tuples = static_cast<int>(fragIndices.size());
-        vtkIdTypeArray* fragIndicesArray = vtkIdTypeArray::New();
-        fragIndicesArray->SetNumberOfComponents(2);
-        fragIndicesArray->SetNumberOfTuples(tuples);
-
-        std::map<vtkIdType, vtkIdType>::iterator mapiter;
-        int ind = 0;
-        for (mapiter = fragIndices.begin(); mapiter != fragIndices.end(); mapiter++)
-        {
-          fragIndicesArray->SetComponent(ind, 0, mapiter->first);
-          fragIndicesArray->SetComponent(ind, 1, mapiter->second);
-          ind++;
-        }
-
-        controller->Send(&tuples, 1, myProc - pivot, tag + pivot + 0);
-        controller->Send(fragIndicesArray, myProc - pivot, tag + pivot + 1);
-        controller->Send(fragVolume, myProc - pivot, tag + pivot + 2);
-        controller->Send(fragMass, myProc - pivot, tag + pivot + 3);
-
-        int off = 4;
-        for (size_t v = 0; v < volumeWeightedNames.size(); v++)
-        {
-          controller->Send(volWeightArrays[v], myProc - pivot, tag + pivot + off);
-          off++;
-        }
+    ReduceFragmentsByKey(controller, fragValues, numValues);
+  }
 
-        for (size_t m = 0; m < massWeightedNames.size(); m++)
-        {
-          controller->Send(massWeightArrays[m], myProc - pivot, tag + pivot + off);
-          off++;
-        }
+  vtkTable* fragments = vtkTable::New();
+  vtkIdType numFragments = static_cast<vtkIdType>(fragValues.size());
 
-        fragIndicesArray->Delete();
-      }
-      else if ((myProc + pivot) < numProcs)
-      {
-        int tuples = 0;
-        controller->Receive(&tuples, 1, myProc + pivot, tag + pivot + 0);
-        fragIndicesReceive->SetNumberOfTuples(tuples);
-        controller->Receive(fragIndicesReceive, myProc + pivot, tag + pivot + 1);
-        fragVolumeReceive->SetNumberOfTuples(tuples + 1);
-        controller->Receive(fragVolumeReceive, myProc + pivot, tag + pivot + 2);
-        fragMassReceive->SetNumberOfTuples(tuples + 1);
-        controller->Receive(fragMassReceive, myProc + pivot, tag + pivot + 3);
-
-        int off = 4;
-        for (size_t v = 0; v < volumeWeightedNames.size(); v++)
-        {
-          volWeightReceive[v]->SetNumberOfTuples(tuples + 1);
-          controller->Receive(volWeightReceive[v], myProc + pivot, tag + pivot + off);
-          off++;
-        }
+  vtkNew<vtkIdTypeArray> fragIdArray;
+  fragIdArray->SetName("Fragment ID");
+  fragIdArray->SetNumberOfTuples(numFragments);
+  fragments->AddColumn(fragIdArray);
 
-        for (size_t m = 0; m < massWeightedNames.size(); m++)
-        {
-          massWeightReceive[m]->SetNumberOfTuples(tuples + 1);
-          controller->Receive(massWeightReceive[m], myProc + pivot, tag + pivot + off);
-          off++;
-        }
+  vtkNew<vtkDoubleArray> fragVolume;
+  fragVolume->SetName("Fragment Volume");
+  fragVolume->SetNumberOfTuples(numFragments);
+  fragments->AddColumn(fragVolume);
 
-        for (int i = 0; i < fragIndicesReceive->GetNumberOfTuples(); i++)
-        {
-          vtkIdType fragId = fragIndicesReceive->GetComponent(i, 0);
-          vtkIdType remoteIndex = fragIndicesReceive->GetComponent(i, 1);
-          std::map<vtkIdType, vtkIdType>::iterator loc = fragIndices.find(fragId);
-          if (loc == fragIndices.end())
-          {
-            size_t index = fragIndices.size();
-            fragIndices[fragId] = index;
-            fragIdArray->InsertNextTuple1(fragId);
-            fragVolume->InsertNextTuple(remoteIndex, fragVolumeReceive);
-            fragMass->InsertNextTuple(remoteIndex, fragMassReceive);
-            for (size_t v = 0; v < volumeWeightedNames.size(); v++)
-            {
-              volWeightArrays[v]->InsertNextTuple(remoteIndex, volWeightReceive[v]);
-            }
-            for (size_t m = 0; m < massWeightedNames.size(); m++)
-            {
-              massWeightArrays[m]->InsertNextTuple(remoteIndex, massWeightReceive[m]);
-            }
-          }
-          else
-          {
-            int index = fragIndices[fragId];
-            fragIdArray->SetTuple1(index, fragId);
-            fragVolume->SetTuple1(
-              index, fragVolume->GetTuple1(index) + fragVolumeReceive->GetTuple1(remoteIndex));
-            fragMass->SetTuple1(
-              index, fragMass->GetTuple1(index) + fragMassReceive->GetTuple1(remoteIndex));
-            for (size_t v = 0; v < volumeWeightedNames.size(); v++)
-            {
-              volWeightArrays[v]->SetTuple1(index,
-                volWeightArrays[v]->GetTuple1(index) + volWeightReceive[v]->GetTuple1(remoteIndex));
-            }
-            for (size_t m = 0; m < massWeightedNames.size(); m++)
-            {
-              massWeightArrays[m]->SetTuple1(index,
-                massWeightArrays[m]->GetTuple1(index) +
-                  massWeightReceive[m]->GetTuple1(remoteIndex));
-            }
-          }
-        }
-      }
-      pivot /= 2;
-    }
+  vtkNew<vtkDoubleArray> fragMass;
+  fragMass->SetName("Fragment Mass");
+  fragMass->SetNumberOfTuples(numFragments);
+  fragments->AddColumn(fragMass);
 
-    fragIndicesReceive->Delete();
-    fragVolumeReceive->Delete();
-    fragMassReceive->Delete();
+  std::vector<vtkSmartPointer<vtkDoubleArray>> weightArrays(numVolWeighted + numMassWeighted);
+  for (size_t w = 0; w < weightArrays.size(); w++)
+  {
+    std::string name = w < numVolWeighted
+      ? "Volume Weighted " + volumeWeightedNames[w]
+      : "Mass Weighted " + massWeightedNames[w - numVolWeighted];
+    weightArrays[w] = vtkSmartPointer<vtkDoubleArray>::New();
+    weightArrays[w]->SetName(name.c_str());
+    weightArrays[w]->SetNumberOfTuples(numFragments);
+    fragments->AddColumn(weightArrays[w]);
   }
 
-  if (myProc == 0)
+  vtkIdType row = 0;
+  for (const auto& frag : fragValues)
   {
-    int row = 0;
-    while (row < fragments->GetNumberOfRows())
+    const std::vector<double>& values = frag.second;
+    fragIdArray->SetValue(row, frag.first);
+    fragVolume->SetValue(row, values[0]);
+    fragMass->SetValue(row, values[1]);
+    for (size_t w = 0; w < weightArrays.size(); w++)
     {
-      if (fragIdArray->GetValue(row) == 0)
-      {
-        fragments->RemoveRow(row);
-      }
-      else
-      {
-        for (size_t v = 0; v < volumeWeightedNames.size(); v++)
-        {
-          double weightAvg = volWeightArrays[v]->GetTuple1(row) / fragVolume->GetTuple1(row);
-          volWeightArrays[v]->SetTuple1(row, weightAvg);
-        }
-        for (size_t m = 0; m < massWeightedNames.size(); m++)
-        {
-          double weightAvg = massWeightArrays[m]->GetTuple1(row) / fragMass->GetTuple1(row);
-          massWeightArrays[m]->SetTuple1(row, weightAvg);
-        }
-
-        row++;
-      }
+      double weight = w < numVolWeighted ? values[0] : values[1];
+      weightArrays[w]->SetValue(row, values[2 + w] / weight);
     }
-  }
-  else
-  {
-    fragments->SetNumberOfRows(0);
+    row++;
   }
   vtkTimerLog::MarkEndEvent("Combining integration");
   return fragments;
@@ -11,6 +11,12 @@
  *
  *   Output 0: A multiblock containing tables of fragments, one block
  *             for each requested material
+ *
+ * In parallel, the values integrated for each fragment are reduced by key:
+ * every process sends the partial values of a fragment directly to the
+ * process whose rank is the fragment id modulo the number of processes, which
+ * is the only process producing a row for that fragment. The tables are thus
+ * distributed across processes, with rows sorted by fragment id.
  */
 
 #ifndef vtkAMRFragmentIntegration_h
@@ -28,6 +28,7 @@ vtkAMRFragmentsFilter::vtkAMRFragmentsFilter()
   this->UseWatertightSurface = false;
   this->IntegrateFragments = true;
   this->VolumeFractionSurfaceValue = 0.5;
+  this->EquivalenceResolution = vtkAMRConnectivity::PAIR_EXCHANGE;
 
   this->Producer = vtkTrivialProducer::New();
   this->Extract = vtkExtractCTHPart::New();
@@ -171,6 +172,7 @@ int vtkAMRFragmentsFilter::RequestData(vtkInformation* vtkNotUsed(request),
 
   this->Connectivity->SetResolveBlocks(true);
   this->Connectivity->SetVolumeFractionSurfaceValue(this->VolumeFractionSurfaceValue);
+  this->Connectivity->SetEquivalenceResolution(this->EquivalenceResolution);
 
   this->Contour->SetVolumeFractionSurfaceValue(this->VolumeFractionSurfaceValue);
   this->Extract->SetVolumeFractionSurfaceValue(this->VolumeFractionSurfaceValue);
@@ -100,6 +100,15 @@ public:
   vtkSetMacro(VolumeFractionSurfaceValue, double);
   ///@}
 
+  ///@{
+  /**
+   * Get / Set how region equivalences are resolved across processes, see
+   * vtkAMRConnectivity::SetEquivalenceResolution().
+   */
+  vtkSetMacro(EquivalenceResolution, int);
+  vtkGetMacro(EquivalenceResolution, int);
+  ///@}
+
 protected:
   vtkAMRFragmentsFilter();
   ~vtkAMRFragmentsFilter() override;
@@ -108,6 +117,7 @@ protected:
   bool UseWatertightSurface;
   bool IntegrateFragments;
   double VolumeFractionSurfaceValue;
+  int EquivalenceResolution;
 
   vtkTrivialProducer* Producer;
   vtkExtractCTHPart* Extract;
@@ -0,0 +1,144 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkLogger.h"
+#include "vtkPVTraceRecorder.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define TEST_ASSERT(x)                                                                             \
+  do                                                                                               \
+  {                                                                                                \
+    if (!(x))                                                                                      \
+    {                                                                                              \
+      vtkLogF(ERROR, "Check failed: %s", #x);                                                      \
+      return false;                                                                                \
+    }                                                                                              \
+  } while (false)
+
+namespace
+{
+const char* CountCall(int& count)
+{
+  ++count;
+  return "counted";
+}
+
+// The arguments of a trace scope are only evaluated when tracing is enabled.
+bool TestScope()
+{
+  int count = 0;
+  vtkPVTraceRecorder::SetEnabled(false);
+  {
+    vtkPVTraceScopeF("TEST", "disabled %s", CountCall(count));
+  }
+  TEST_ASSERT(count == 0);
+  TEST_ASSERT(vtkPVTraceRecorder::GetNumberOfRecordedEvents() == 0);
+
+  vtkPVTraceRecorder::SetEnabled(true);
+  {
+    vtkPVTraceScopeF("TEST", "enabled %s", CountCall(count));
+  }
+  vtkPVTraceRecorder::SetEnabled(false);
+  TEST_ASSERT(count == 1);
+  const auto events = vtkPVTraceRecorder::GetEvents();
+  TEST_ASSERT(events.size() == 1);
+  TEST_ASSERT(std::string(events[0].Category) == "TEST");
+  TEST_ASSERT(std::string(events[0].Name) == "enabled counted");
+  TEST_ASSERT(events[0].Duration >= 0);
+  vtkPVTraceRecorder::Clear();
+  return true;
+}
+
+// Once full, the buffer keeps the most recent events, oldest first.
+bool TestWraparound()
+{
+  vtkPVTraceRecorder::SetCapacity(10);
+  TEST_ASSERT(vtkPVTraceRecorder::GetCapacity() == 16);
+
+  vtkPVTraceRecorder::SetEnabled(true);
+  for (int cc = 0; cc < 40; ++cc)
+  {
+    vtkPVTraceRecorder::Record("TEST", std::to_string(cc).c_str(), cc, 2 * cc);
+  }
+  // long names are truncated.
+  const std::string longName(100, 'x');
+  vtkPVTraceRecorder::Record("TEST", longName.c_str(), 40, 80);
+  vtkPVTraceRecorder::SetEnabled(false);
+  vtkPVTraceRecorder::Record("TEST", "ignored", 41, 82);
+
+  TEST_ASSERT(vtkPVTraceRecorder::GetNumberOfRecordedEvents() == 41);
+  const auto events = vtkPVTraceRecorder::GetEvents();
+  TEST_ASSERT(events.size() == 16);
+  for (int cc = 0; cc < 15; ++cc)
+  {
+    TEST_ASSERT(events[cc].Begin == 25 + cc && events[cc].Duration == 25 + cc);
+    TEST_ASSERT(std::to_string(25 + cc) == events[cc].Name);
+  }
+  TEST_ASSERT(std::string(events[15].Name) == longName.substr(0, 63));
+
+  vtkPVTraceRecorder::Clear();
+  TEST_ASSERT(vtkPVTraceRecorder::GetEvents().empty());
+  TEST_ASSERT(vtkPVTraceRecorder::GetNumberOfRecordedEvents() == 0);
+  return true;
+}
+
+// Events read while other threads overwrite them are either skipped or
+// complete, never a mix of two events.
+bool TestConcurrentReads()
+{
+  constexpr int numberOfWriters = 4;
+  constexpr vtkTypeInt64 eventsPerWriter = 20000;
+  vtkPVTraceRecorder::SetCapacity(256);
+  vtkPVTraceRecorder::SetEnabled(true);
+
+  std::atomic<int> running{ numberOfWriters };
+  std::vector<std::thread> writers;
+  for (int writer = 0; writer < numberOfWriters; ++writer)
+  {
+    writers.emplace_back([writer, &running]() {
+      for (vtkTypeInt64 cc = 0; cc < eventsPerWriter; ++cc)
+      {
+        const vtkTypeInt64 begin = writer * eventsPerWriter + cc;
+        vtkPVTraceRecorder::Record("TEST", std::to_string(begin).c_str(), begin, 2 * begin + 1);
+      }
+      --running;
+    });
+  }
+
+  bool consistent = true;
+  int reads = 0;
+  while (running > 0 || reads == 0)
+  {
+    const auto events = vtkPVTraceRecorder::GetEvents();
+    consistent = consistent && events.size() <= 256;
+    for (const auto& event : events)
+    {
+      consistent = consistent && event.Duration == event.Begin + 1 &&
+        std::to_string(event.Begin) == event.Name;
+    }
+    ++reads;
+  }
+  for (auto& writer : writers)
+  {
+    writer.join();
+  }
+  vtkPVTraceRecorder::SetEnabled(false);
+
+  TEST_ASSERT(consistent);
+  TEST_ASSERT(vtkPVTraceRecorder::GetNumberOfRecordedEvents() == numberOfWriters * eventsPerWriter);
+  TEST_ASSERT(vtkPVTraceRecorder::GetEvents().size() == 256);
+  vtkPVTraceRecorder::Clear();
+  return true;
+}
+}
+
+extern int TestPVTraceRecorder(int, char*[])
+{
+  vtkPVTraceRecorder::SetEnabled(false);
+  vtkPVTraceRecorder::Clear();
+  return TestScope() && TestWraparound() && TestConcurrentReads() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
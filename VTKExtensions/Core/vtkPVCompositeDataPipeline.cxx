@@ -13,15 +13,138 @@
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVPostFilterExecutive.h"
+#include "vtkPVTraceRecorder.h"
+#include "vtkSmartPointer.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <vtksys/SystemTools.hxx>
+
+#include <algorithm>
 #include <cassert>
+#include <cstdlib>
+#include <list>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+// What identifies the outputs of an executive for a time step.
+struct vtkTimeStepKey
+{
+  double Time;
+  int Piece;
+  int NumberOfPieces;
+  int GhostLevels;
+
+  bool operator==(const vtkTimeStepKey& other) const
+  {
+    return this->Time == other.Time && this->Piece == other.Piece &&
+      this->NumberOfPieces == other.NumberOfPieces && this->GhostLevels == other.GhostLevels;
+  }
+};
+
+struct vtkTimeStepEntry
+{
+  vtkPVCompositeDataPipeline* Executive;
+  vtkTimeStepKey Key;
+  // pipeline MTime when the outputs were generated.
+  vtkMTimeType PipelineMTime;
+  std::vector<vtkSmartPointer<vtkDataObject>> Outputs;
+  vtkTypeInt64 Size;
+};
+
+// Cache shared by all executives, most recently used entries first.
+struct vtkTimeStepCache
+{
+  std::mutex Mutex;
+  std::list<vtkTimeStepEntry> Entries;
+  vtkTypeInt64 Size = 0;
+  vtkTypeInt64 Limit = 1024 * 1024;
+  vtkIdType Hits = 0;
+  vtkIdType Misses = 0;
+  vtkIdType Evictions = 0;
+
+  vtkTimeStepCache()
+  {
+    std::string value;
+    if (vtksys::SystemTools::GetEnv("PARAVIEW_TIME_STEP_CACHE_LIMIT", value))
+    {
+      this->Limit = std::max<vtkTypeInt64>(0, std::atoll(value.c_str()));
+    }
+  }
+
+  // Removes the entries of an executive, or only those generated before its
+  // pipeline was last modified when `pipelineMTime` is not 0.
+  void Remove(vtkPVCompositeDataPipeline* executive, vtkMTimeType pipelineMTime = 0)
+  {
+    for (auto iter = this->Entries.begin(); iter != this->Entries.end();)
+    {
+      if (iter->Executive == executive &&
+        (pipelineMTime == 0 || iter->PipelineMTime != pipelineMTime))
+      {
+        this->Size -= iter->Size;
+        iter = this->Entries.erase(iter);
+      }
+      else
+      {
+        ++iter;
+      }
+    }
+  }
+
+  void Evict()
+  {
+    while (this->Size > this->Limit && !this->Entries.empty())
+    {
+      this->Size -= this->Entries.back().Size;
+      this->Entries.pop_back();
+      ++this->Evictions;
+    }
+  }
+};
+
+vtkTimeStepCache& GetTimeStepCache()
+{
+  static vtkTimeStepCache cache;
+  return cache;
+}
+
+// Returns false if the request is not for a particular time step.
+bool GetTimeStepKey(vtkInformation* outInfo, vtkTimeStepKey& key)
+{
+  using vtkSDDP = vtkStreamingDemandDrivenPipeline;
+  if (outInfo == nullptr || !outInfo->Has(vtkSDDP::UPDATE_TIME_STEP()))
+  {
+    return false;
+  }
+  key.Time = outInfo->Get(vtkSDDP::UPDATE_TIME_STEP());
+  key.Piece = outInfo->Has(vtkSDDP::UPDATE_PIECE_NUMBER())
+    ? outInfo->Get(vtkSDDP::UPDATE_PIECE_NUMBER())
+    : -1;
+  key.NumberOfPieces = outInfo->Has(vtkSDDP::UPDATE_NUMBER_OF_PIECES())
+    ? outInfo->Get(vtkSDDP::UPDATE_NUMBER_OF_PIECES())
+    : -1;
+  key.GhostLevels = outInfo->Has(vtkSDDP::UPDATE_NUMBER_OF_GHOST_LEVELS())
+    ? outInfo->Get(vtkSDDP::UPDATE_NUMBER_OF_GHOST_LEVELS())
+    : 0;
+  return true;
+}
+}
 
 vtkStandardNewMacro(vtkPVCompositeDataPipeline);
 //----------------------------------------------------------------------------
 vtkPVCompositeDataPipeline::vtkPVCompositeDataPipeline() = default;
 
 //----------------------------------------------------------------------------
-vtkPVCompositeDataPipeline::~vtkPVCompositeDataPipeline() = default;
+vtkPVCompositeDataPipeline::~vtkPVCompositeDataPipeline()
+{
+  if (this->CacheTimeSteps)
+  {
+    auto& cache = ::GetTimeStepCache();
+    std::lock_guard<std::mutex> lock(cache.Mutex);
+    cache.Remove(this);
+  }
+}
 
 //----------------------------------------------------------------------------
 void vtkPVCompositeDataPipeline::CopyDefaultInformation(vtkInformation* request, int direction,
@@ -73,8 +196,248 @@ void vtkPVCompositeDataPipeline::ResetPipelineInformation(int port, vtkInformati
   this->Superclass::ResetPipelineInformation(port, info);
 }
 
+//----------------------------------------------------------------------------
+int vtkPVCompositeDataPipeline::ExecuteInformation(
+  vtkInformation* request, vtkInformationVector** inInfoVec, vtkInformationVector* outInfoVec)
+{
+  vtkPVTraceRecorder::Scope scope("PIPELINE", "RequestInformation", this->Algorithm);
+  return this->Superclass::ExecuteInformation(request, inInfoVec, outInfoVec);
+}
+
+//----------------------------------------------------------------------------
+int vtkPVCompositeDataPipeline::ExecuteData(
+  vtkInformation* request, vtkInformationVector** inInfoVec, vtkInformationVector* outInfoVec)
+{
+  vtkPVTraceRecorder::Scope scope("EXECUTION", "RequestData", this->Algorithm);
+  const vtkTypeInt64 start = vtkPVTraceRecorder::Now();
+  const int result = this->Superclass::ExecuteData(request, inInfoVec, outInfoVec);
+  this->LastExecutionTime = (vtkPVTraceRecorder::Now() - start) * 1e-9;
+  ++this->NumberOfExecutions;
+  if (result && this->CacheTimeSteps)
+  {
+    this->CacheTimeStep(outInfoVec);
+  }
+  return result;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeBool vtkPVCompositeDataPipeline::ProcessRequest(
+  vtkInformation* request, vtkInformationVector** inInfoVec, vtkInformationVector* outInfoVec)
+{
+  if (this->CacheTimeSteps && this->Algorithm && request->Has(REQUEST_DATA()))
+  {
+    const int outputPort = request->Has(FROM_OUTPUT_PORT()) ? request->Get(FROM_OUTPUT_PORT()) : -1;
+    if (this->NeedToExecuteData(outputPort, inInfoVec, outInfoVec) &&
+      this->RestoreTimeStep(request, inInfoVec, outInfoVec))
+    {
+      // as after an execution, the outputs and the earlier passes are now
+      // up to date.
+      this->DataTime.Modified();
+      this->InformationTime.Modified();
+      this->DataObjectTime.Modified();
+      return 1;
+    }
+  }
+  return this->Superclass::ProcessRequest(request, inInfoVec, outInfoVec);
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVCompositeDataPipeline::RestoreTimeStep(
+  vtkInformation* request, vtkInformationVector** inInfoVec, vtkInformationVector* outInfoVec)
+{
+  const int numPorts = outInfoVec->GetNumberOfInformationObjects();
+  vtkTimeStepKey key;
+  if (numPorts == 0 || !::GetTimeStepKey(outInfoVec->GetInformationObject(0), key))
+  {
+    return false;
+  }
+
+  auto& cache = ::GetTimeStepCache();
+  std::unique_lock<std::mutex> lock(cache.Mutex);
+  cache.Remove(this, this->PipelineMTime);
+  auto iter = std::find_if(cache.Entries.begin(), cache.Entries.end(),
+    [this, &key](const vtkTimeStepEntry& entry)
+    { return entry.Executive == this && entry.Key == key; });
+  if (iter == cache.Entries.end())
+  {
+    ++cache.Misses;
+    return false;
+  }
+  for (int cc = 0; cc < numPorts; ++cc)
+  {
+    vtkDataObject* output = outInfoVec->GetInformationObject(cc)->Get(vtkDataObject::DATA_OBJECT());
+    vtkDataObject* cached =
+      cc < static_cast<int>(iter->Outputs.size()) ? iter->Outputs[cc].GetPointer() : nullptr;
+    if (output == nullptr || cached == nullptr ||
+      output->GetDataObjectType() != cached->GetDataObjectType())
+    {
+      // the output type changed, the entry can't be used.
+      cache.Size -= iter->Size;
+      cache.Entries.erase(iter);
+      ++cache.Misses;
+      return false;
+    }
+  }
+
+  ++cache.Hits;
+  cache.Entries.splice(cache.Entries.begin(), cache.Entries, iter);
+  std::vector<vtkSmartPointer<vtkDataObject>> outputs = iter->Outputs;
+  lock.unlock();
+
+  vtkPVTraceRecorder::Scope scope("EXECUTION", "TimeStepCacheHit", this->Algorithm);
+  for (int cc = 0; cc < numPorts; ++cc)
+  {
+    vtkInformation* outInfo = outInfoVec->GetInformationObject(cc);
+    outInfo->Get(vtkDataObject::DATA_OBJECT())->ShallowCopy(outputs[cc]);
+  }
+  this->MarkOutputsGenerated(request, inInfoVec, outInfoVec);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVCompositeDataPipeline::CacheTimeStep(vtkInformationVector* outInfoVec)
+{
+  const int numPorts = outInfoVec->GetNumberOfInformationObjects();
+  vtkTimeStepKey key;
+  if (numPorts == 0 || !::GetTimeStepKey(outInfoVec->GetInformationObject(0), key))
+  {
+    return;
+  }
+
+  vtkTimeStepEntry entry;
+  entry.Executive = this;
+  entry.Key = key;
+  entry.PipelineMTime = this->PipelineMTime;
+  entry.Size = 0;
+  for (int cc = 0; cc < numPorts; ++cc)
+  {
+    vtkDataObject* output = outInfoVec->GetInformationObject(cc)->Get(vtkDataObject::DATA_OBJECT());
+    vtkSmartPointer<vtkDataObject> copy;
+    if (output)
+    {
+      copy.TakeReference(output->NewInstance());
+      copy->ShallowCopy(output);
+      entry.Size += static_cast<vtkTypeInt64>(copy->GetActualMemorySize());
+    }
+    entry.Outputs.push_back(copy);
+  }
+
+  auto& cache = ::GetTimeStepCache();
+  std::lock_guard<std::mutex> lock(cache.Mutex);
+  cache.Remove(this, this->PipelineMTime);
+  if (entry.Size > cache.Limit)
+  {
+    return;
+  }
+  auto iter = std::find_if(cache.Entries.begin(), cache.Entries.end(),
+    [this, &key](const vtkTimeStepEntry& item)
+    { return item.Executive == this && item.Key == key; });
+  if (iter != cache.Entries.end())
+  {
+    cache.Size -= iter->Size;
+    cache.Entries.erase(iter);
+  }
+  cache.Size += entry.Size;
+  cache.Entries.push_front(std::move(entry));
+  cache.Evict();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVCompositeDataPipeline::SetCacheTimeSteps(bool value)
+{
+  if (this->CacheTimeSteps != value)
+  {
+    this->CacheTimeSteps = value;
+    if (!value)
+    {
+      auto& cache = ::GetTimeStepCache();
+      std::lock_guard<std::mutex> lock(cache.Mutex);
+      cache.Remove(this);
+    }
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVCompositeDataPipeline::SetTimeStepCacheLimit(vtkTypeInt64 limit)
+{
+  auto& cache = ::GetTimeStepCache();
+  std::lock_guard<std::mutex> lock(cache.Mutex);
+  cache.Limit = std::max<vtkTypeInt64>(0, limit);
+  cache.Evict();
+}
+
+//----------------------------------------------------------------------------
+vtkTypeInt64 vtkPVCompositeDataPipeline::GetTimeStepCacheLimit()
+{
+  auto& cache = ::GetTimeStepCache();
+  std::lock_guard<std::mutex> lock(cache.Mutex);
+  return cache.Limit;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeInt64 vtkPVCompositeDataPipeline::GetTimeStepCacheSize()
+{
+  auto& cache = ::GetTimeStepCache();
+  std::lock_guard<std::mutex> lock(cache.Mutex);
+  return cache.Size;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkPVCompositeDataPipeline::GetTimeStepCacheHits()
+{
+  auto& cache = ::GetTimeStepCache();
+  std::lock_guard<std::mutex> lock(cache.Mutex);
+  return cache.Hits;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkPVCompositeDataPipeline::GetTimeStepCacheMisses()
+{
+  auto& cache = ::GetTimeStepCache();
+  std::lock_guard<std::mutex> lock(cache.Mutex);
+  return cache.Misses;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkPVCompositeDataPipeline::GetTimeStepCacheEvictions()
+{
+  auto& cache = ::GetTimeStepCache();
+  std::lock_guard<std::mutex> lock(cache.Mutex);
+  return cache.Evictions;
+}
+
+//----------------------------------------------------------------------------
+double vtkPVCompositeDataPipeline::GetTimeStepCacheHitRate()
+{
+  auto& cache = ::GetTimeStepCache();
+  std::lock_guard<std::mutex> lock(cache.Mutex);
+  const vtkIdType requests = cache.Hits + cache.Misses;
+  return requests > 0 ? static_cast<double>(cache.Hits) / requests : 0.0;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVCompositeDataPipeline::ResetTimeStepCacheStatistics()
+{
+  auto& cache = ::GetTimeStepCache();
+  std::lock_guard<std::mutex> lock(cache.Mutex);
+  cache.Hits = cache.Misses = cache.Evictions = 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVCompositeDataPipeline::ClearTimeStepCache()
+{
+  auto& cache = ::GetTimeStepCache();
+  std::lock_guard<std::mutex> lock(cache.Mutex);
+  cache.Entries.clear();
+  cache.Size = 0;
+}
+
 //----------------------------------------------------------------------------
 void vtkPVCompositeDataPipeline::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "LastExecutionTime: " << this->LastExecutionTime << endl;
+  os << indent << "NumberOfExecutions: " << this->NumberOfExecutions << endl;
+  os << indent << "CacheTimeSteps: " << this->CacheTimeSteps << endl;
 }
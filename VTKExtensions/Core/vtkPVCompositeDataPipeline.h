@@ -12,6 +12,12 @@
  *     algorithms are passed along to the input vtkPVPostFilter, if one exists.
  *     vtkPVPostFilter is used to automatically extract components or generated
  *     derived arrays such as magnitude array for vectors.
+ * \li Time step cache :- when CacheTimeSteps is enabled, the outputs produced
+ *     for each time step are kept (shallow copies) and reused when the same
+ *     time step, piece and ghost levels are requested again, without updating
+ *     the upstream pipeline. Cached outputs are discarded as soon as the
+ *     pipeline is modified. All executives share a memory budget, beyond which
+ *     the least recently used outputs are evicted.
  */
 
 #ifndef vtkPVCompositeDataPipeline_h
@@ -27,6 +33,65 @@ public:
   vtkTypeMacro(vtkPVCompositeDataPipeline, vtkCompositeDataPipeline);
   void PrintSelf(ostream& os, vtkIndent indent) override;
 
+  ///@{
+  /**
+   * Returns the wall time, in seconds, spent in the last execution of the
+   * algorithm (RequestData) and the number of executions so far.
+   */
+  vtkGetMacro(LastExecutionTime, double);
+  vtkGetMacro(NumberOfExecutions, vtkIdType);
+  ///@}
+
+  ///@{
+  /**
+   * Enable/disable caching the outputs of the algorithm for each time step.
+   * Default is false. Disabling it releases the cached outputs.
+   */
+  void SetCacheTimeSteps(bool);
+  vtkGetMacro(CacheTimeSteps, bool);
+  vtkBooleanMacro(CacheTimeSteps, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Memory budget, in KiB, shared by the time step caches of all executives.
+   * Default is 1 GiB, or the value of the PARAVIEW_TIME_STEP_CACHE_LIMIT
+   * environment variable (in KiB).
+   */
+  static void SetTimeStepCacheLimit(vtkTypeInt64 limit);
+  static vtkTypeInt64 GetTimeStepCacheLimit();
+  ///@}
+
+  /**
+   * Returns the memory, in KiB, used by the time step caches of all
+   * executives.
+   */
+  static vtkTypeInt64 GetTimeStepCacheSize();
+
+  ///@{
+  /**
+   * Statistics of the time step caches of all executives: the number of
+   * requests served from the cache (hits), the number of executions for time
+   * steps that were not cached (misses) and the number of evicted outputs.
+   */
+  static vtkIdType GetTimeStepCacheHits();
+  static vtkIdType GetTimeStepCacheMisses();
+  static vtkIdType GetTimeStepCacheEvictions();
+  static double GetTimeStepCacheHitRate();
+  static void ResetTimeStepCacheStatistics();
+  ///@}
+
+  /**
+   * Releases the outputs cached by all executives.
+   */
+  static void ClearTimeStepCache();
+
+  /**
+   * Overridden to serve REQUEST_DATA from the time step cache when possible.
+   */
+  vtkTypeBool ProcessRequest(vtkInformation* request, vtkInformationVector** inInfoVec,
+    vtkInformationVector* outInfoVec) override;
+
 protected:
   vtkPVCompositeDataPipeline();
   ~vtkPVCompositeDataPipeline() override;
@@ -38,6 +103,29 @@ protected:
   // Remove update/whole extent when resetting pipeline information.
   void ResetPipelineInformation(int port, vtkInformation*) override;
 
+  // Record the algorithm execution as an event when tracing is enabled (see
+  // vtkPVTraceRecorder).
+  int ExecuteInformation(vtkInformation* request, vtkInformationVector** inInfoVec,
+    vtkInformationVector* outInfoVec) override;
+  int ExecuteData(vtkInformation* request, vtkInformationVector** inInfoVec,
+    vtkInformationVector* outInfoVec) override;
+
+  /**
+   * Copies the cached outputs for the requested time step, if any, to the
+   * outputs. Returns false if there are none.
+   */
+  bool RestoreTimeStep(vtkInformation* request, vtkInformationVector** inInfoVec,
+    vtkInformationVector* outInfoVec);
+
+  /**
+   * Adds the outputs for the requested time step to the cache.
+   */
+  void CacheTimeStep(vtkInformationVector* outInfoVec);
+
+  double LastExecutionTime = 0.0;
+  vtkIdType NumberOfExecutions = 0;
+  bool CacheTimeSteps = false;
+
 private:
   vtkPVCompositeDataPipeline(const vtkPVCompositeDataPipeline&) = delete;
   void operator=(const vtkPVCompositeDataPipeline&) = delete;
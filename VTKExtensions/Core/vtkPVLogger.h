@@ -35,6 +35,7 @@
 #define vtkPVLogger_h
 
 #include "vtkLogger.h"
+#include "vtkPVTraceRecorder.h"           // for vtkPVTraceScopeF
 #include "vtkPVVTKExtensionsCoreModule.h" // needed for export macro
 
 class VTKPVVTKEXTENSIONSCORE_EXPORT vtkPVLogger : public vtkLogger
@@ -223,4 +224,17 @@ private:
  * @endcode
  */
 #define PARAVIEW_LOG_CATALYST_VERBOSITY() vtkPVLogger::GetCatalystVerbosity()
+
+/**
+ * Macro to open a log scope for one of the categories defined above that is
+ * also recorded as an event by vtkPVTraceRecorder when tracing is enabled.
+ * `category` is the category name without the `PARAVIEW_LOG_` prefix e.g.
+ *
+ * @code{cpp}
+ *  PARAVIEW_LOG_SCOPE_F(DATA_MOVEMENT, "deliver %s", name);
+ * @endcode
+ */
+#define PARAVIEW_LOG_SCOPE_F(category, ...)                                                        \
+  vtkPVTraceScopeF(#category, __VA_ARGS__);                                                        \
+  vtkVLogScopeF(PARAVIEW_LOG_##category##_VERBOSITY(), __VA_ARGS__)
 #endif
@@ -0,0 +1,306 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkPVTraceRecorder.h"
+
+#include "vtkLogger.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#include <atomic>
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+
+namespace
+{
+// Each slot is guarded by a sequence number: 2 * index + 1 while the event
+// with the given index is being written and 2 * index + 2 once it is complete.
+struct vtkSlot
+{
+  std::atomic<vtkTypeUInt64> Sequence{ 0 };
+  vtkPVTraceRecorder::Event Data;
+};
+
+struct vtkBuffer
+{
+  explicit vtkBuffer(vtkTypeUInt64 capacity)
+    : Slots(new vtkSlot[capacity])
+    , Mask(capacity - 1)
+  {
+  }
+
+  std::unique_ptr<vtkSlot[]> Slots;
+  const vtkTypeUInt64 Mask;
+  std::atomic<vtkTypeUInt64> Head{ 0 };
+  std::atomic<vtkTypeUInt64> Start{ 0 };
+};
+
+struct vtkState
+{
+  vtkState()
+  {
+    if (const char* capacity = vtksys::SystemTools::GetEnv("PARAVIEW_TRACE_CAPACITY"))
+    {
+      this->Capacity = vtkState::RoundCapacity(std::atoll(capacity));
+    }
+    const char* enabled = vtksys::SystemTools::GetEnv("PARAVIEW_TRACE_EVENTS");
+    if (enabled && std::atoi(enabled) != 0)
+    {
+      this->Allocate();
+      this->Enabled.store(true);
+      vtkLogF(TRACE, "event tracing enabled by `PARAVIEW_TRACE_EVENTS`");
+    }
+  }
+
+  static vtkTypeUInt64 RoundCapacity(long long requested)
+  {
+    vtkTypeUInt64 capacity = 1;
+    while (capacity < static_cast<vtkTypeUInt64>(requested > 1 ? requested : 1))
+    {
+      capacity <<= 1;
+    }
+    return capacity;
+  }
+
+  // must be called with this->Mutex locked or during construction.
+  void Allocate()
+  {
+    // buffers are never freed before exit since a writer that saw tracing
+    // enabled may still be using a replaced buffer.
+    this->Buffers.emplace_back(new vtkBuffer(this->Capacity));
+    this->Buffer.store(this->Buffers.back().get(), std::memory_order_release);
+  }
+
+  std::mutex Mutex;
+  std::atomic<bool> Enabled{ false };
+  std::atomic<vtkBuffer*> Buffer{ nullptr };
+  std::vector<std::unique_ptr<vtkBuffer>> Buffers;
+  vtkTypeUInt64 Capacity = 65536;
+};
+
+vtkState& GetState()
+{
+  static vtkState state;
+  return state;
+}
+
+vtkTypeUInt32 GetThreadIndex()
+{
+  static std::atomic<vtkTypeUInt32> nextIndex{ 0 };
+  thread_local vtkTypeUInt32 index = nextIndex++;
+  return index;
+}
+
+void CopyName(char (&destination)[64], const char* source)
+{
+  std::strncpy(destination, source ? source : "", sizeof(destination) - 1);
+  destination[sizeof(destination) - 1] = '\0';
+}
+}
+
+//----------------------------------------------------------------------------
+vtkPVTraceRecorder::vtkPVTraceRecorder() = default;
+
+//----------------------------------------------------------------------------
+vtkPVTraceRecorder::~vtkPVTraceRecorder() = default;
+
+//----------------------------------------------------------------------------
+void vtkPVTraceRecorder::SetEnabled(bool enabled)
+{
+  auto& state = GetState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+  if (enabled && state.Buffer.load() == nullptr)
+  {
+    state.Allocate();
+  }
+  state.Enabled.store(enabled, std::memory_order_release);
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVTraceRecorder::GetEnabled()
+{
+  return GetState().Enabled.load(std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTraceRecorder::SetCapacity(vtkIdType capacity)
+{
+  auto& state = GetState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+  if (state.Enabled.load())
+  {
+    vtkLogF(WARNING, "cannot change the trace capacity while tracing is enabled");
+    return;
+  }
+  const vtkTypeUInt64 rounded = vtkState::RoundCapacity(capacity);
+  if (rounded != state.Capacity)
+  {
+    state.Capacity = rounded;
+    if (state.Buffer.load() != nullptr)
+    {
+      state.Allocate();
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkPVTraceRecorder::GetCapacity()
+{
+  auto& state = GetState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+  return static_cast<vtkIdType>(state.Capacity);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTraceRecorder::Clear()
+{
+  if (auto buffer = GetState().Buffer.load(std::memory_order_acquire))
+  {
+    buffer->Start.store(buffer->Head.load());
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkPVTraceRecorder::GetNumberOfRecordedEvents()
+{
+  auto buffer = GetState().Buffer.load(std::memory_order_acquire);
+  return buffer ? static_cast<vtkIdType>(buffer->Head.load() - buffer->Start.load()) : 0;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeInt64 vtkPVTraceRecorder::Now()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch())
+    .count();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTraceRecorder::Record(
+  const char* category, const char* name, vtkTypeInt64 begin, vtkTypeInt64 end)
+{
+  auto& state = GetState();
+  vtkBuffer* buffer = state.Buffer.load(std::memory_order_acquire);
+  if (!buffer || !state.Enabled.load(std::memory_order_relaxed))
+  {
+    return;
+  }
+
+  const vtkTypeUInt64 index = buffer->Head.fetch_add(1, std::memory_order_relaxed);
+  vtkSlot& slot = buffer->Slots[index & buffer->Mask];
+  slot.Sequence.store(2 * index + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  slot.Data.Begin = begin;
+  slot.Data.Duration = end - begin;
+  slot.Data.Category = category;
+  slot.Data.Thread = GetThreadIndex();
+  CopyName(slot.Data.Name, name);
+
+  slot.Sequence.store(2 * index + 2, std::memory_order_release);
+}
+
+//----------------------------------------------------------------------------
+std::vector<vtkPVTraceRecorder::Event> vtkPVTraceRecorder::GetEvents()
+{
+  std::vector<Event> events;
+  vtkBuffer* buffer = GetState().Buffer.load(std::memory_order_acquire);
+  if (!buffer)
+  {
+    return events;
+  }
+
+  const vtkTypeUInt64 head = buffer->Head.load(std::memory_order_acquire);
+  const vtkTypeUInt64 capacity = buffer->Mask + 1;
+  vtkTypeUInt64 first = buffer->Start.load();
+  if (head > capacity && head - capacity > first)
+  {
+    first = head - capacity;
+  }
+  events.reserve(static_cast<size_t>(head - first));
+  for (vtkTypeUInt64 index = first; index < head; ++index)
+  {
+    const vtkSlot& slot = buffer->Slots[index & buffer->Mask];
+    const vtkTypeUInt64 sequence = slot.Sequence.load(std::memory_order_acquire);
+    if (sequence != 2 * index + 2)
+    {
+      continue; // being written or already overwritten.
+    }
+    Event event = slot.Data;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.Sequence.load(std::memory_order_relaxed) == sequence)
+    {
+      events.push_back(event);
+    }
+  }
+  return events;
+}
+
+//----------------------------------------------------------------------------
+vtkPVTraceRecorder::Scope::Scope()
+  : Category(nullptr)
+  , Begin(-1)
+{
+}
+
+//----------------------------------------------------------------------------
+vtkPVTraceRecorder::Scope::Scope(const char* category, const char* format, ...)
+  : Category(category)
+  , Begin(-1)
+{
+  if (!vtkPVTraceRecorder::GetEnabled())
+  {
+    return;
+  }
+  va_list args;
+  va_start(args, format);
+  std::vsnprintf(this->Name, sizeof(this->Name), format, args);
+  va_end(args);
+  this->Begin = vtkPVTraceRecorder::Now();
+}
+
+//----------------------------------------------------------------------------
+vtkPVTraceRecorder::Scope::Scope(const char* category, const char* action, vtkObjectBase* object)
+  : Category(category)
+  , Begin(-1)
+{
+  if (!vtkPVTraceRecorder::GetEnabled())
+  {
+    return;
+  }
+  std::snprintf(this->Name, sizeof(this->Name), "%s: %s", action,
+    object ? object->GetObjectDescription().c_str() : "(none)");
+  this->Begin = vtkPVTraceRecorder::Now();
+}
+
+//----------------------------------------------------------------------------
+vtkPVTraceRecorder::Scope::Scope(Scope&& other) noexcept
+  : Category(other.Category)
+  , Begin(other.Begin)
+{
+  std::memcpy(this->Name, other.Name, sizeof(this->Name));
+  other.Begin = -1;
+}
+
+//----------------------------------------------------------------------------
+vtkPVTraceRecorder::Scope::~Scope()
+{
+  if (this->Begin >= 0)
+  {
+    vtkPVTraceRecorder::Record(this->Category, this->Name, this->Begin, vtkPVTraceRecorder::Now());
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTraceRecorder::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Enabled: " << vtkPVTraceRecorder::GetEnabled() << endl;
+  os << indent << "Capacity: " << vtkPVTraceRecorder::GetCapacity() << endl;
+  os << indent << "NumberOfRecordedEvents: " << vtkPVTraceRecorder::GetNumberOfRecordedEvents()
+     << endl;
+}
@@ -0,0 +1,163 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class vtkPVTraceRecorder
+ * @brief records timed events of this process in a ring buffer
+ *
+ * vtkPVTraceRecorder keeps the most recent timed events, e.g. pipeline
+ * executions, data movement and rendering passes, of this process in a fixed
+ * size ring buffer. Recording is lock-free and, when tracing is disabled,
+ * costs a single atomic load per event, so instrumentation can be left in
+ * place. The oldest events are overwritten once the buffer is full.
+ *
+ * Events are usually recorded using `vtkPVTraceScopeF` which records the
+ * time spent in the enclosing scope, or `PARAVIEW_LOG_SCOPE_F` (see
+ * vtkPVLogger) which also opens a log scope for a ParaView logging category.
+ *
+ * @code{cpp}
+ * vtkPVTraceScopeF("RENDERING", "%s: render", name);
+ * @endcode
+ *
+ * Tracing is disabled by default. It can be enabled using SetEnabled() or by
+ * setting the environment variable `PARAVIEW_TRACE_EVENTS` to a non-zero
+ * value. `PARAVIEW_TRACE_CAPACITY` overrides the default capacity.
+ *
+ * Events recorded on all processes can be collected using
+ * vtkPVTraceInformation and exported as a Chrome trace.
+ */
+
+#ifndef vtkPVTraceRecorder_h
+#define vtkPVTraceRecorder_h
+
+#include "vtkObject.h"
+#include "vtkPVVTKExtensionsCoreModule.h" // needed for export macro
+
+#if !defined(__VTK_WRAP__)
+#include <vector> // for std::vector
+#endif
+
+class VTKPVVTKEXTENSIONSCORE_EXPORT vtkPVTraceRecorder : public vtkObject
+{
+public:
+  vtkTypeMacro(vtkPVTraceRecorder, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /**
+   * Enable or disable recording of events. Default is disabled unless the
+   * environment variable `PARAVIEW_TRACE_EVENTS` is set to a non-zero value.
+   */
+  static void SetEnabled(bool enabled);
+  static bool GetEnabled();
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the maximum number of events kept, rounded up to a power of two.
+   * Changing the capacity discards recorded events and is ignored while
+   * tracing is enabled. Default is 65536.
+   */
+  static void SetCapacity(vtkIdType capacity);
+  static vtkIdType GetCapacity();
+  ///@}
+
+  /**
+   * Discard all recorded events.
+   */
+  static void Clear();
+
+  /**
+   * Returns the number of events recorded since the last Clear(), including
+   * the ones that have been overwritten.
+   */
+  static vtkIdType GetNumberOfRecordedEvents();
+
+  /**
+   * Returns the current time, in nanoseconds, on the monotonic clock used to
+   * time stamp events.
+   */
+  static vtkTypeInt64 Now();
+
+#if !defined(__VTK_WRAP__)
+  /**
+   * A recorded event. Times are in nanoseconds, see Now().
+   */
+  struct Event
+  {
+    vtkTypeInt64 Begin;
+    vtkTypeInt64 Duration;
+    const char* Category;
+    vtkTypeUInt32 Thread;
+    char Name[64] = {};
+  };
+
+  /**
+   * Record an event. `category` must be a string with static storage
+   * duration, e.g. a literal. `name` is truncated to 63 characters.
+   */
+  static void Record(
+    const char* category, const char* name, vtkTypeInt64 begin, vtkTypeInt64 end);
+
+  /**
+   * Returns the recorded events still in the buffer, oldest first. Events
+   * being written while this is called are skipped.
+   */
+  static std::vector<Event> GetEvents();
+
+  /**
+   * Records the time spent between its construction and destruction. Nothing
+   * is formatted when tracing is disabled. A default constructed scope
+   * records nothing.
+   */
+  class VTKPVVTKEXTENSIONSCORE_EXPORT Scope
+  {
+  public:
+    Scope();
+    Scope(const char* category, const char* format, ...);
+    /**
+     * Names the event "<action>: <object description>".
+     */
+    Scope(const char* category, const char* action, vtkObjectBase* object);
+    Scope(Scope&& other) noexcept;
+    ~Scope();
+
+  private:
+    Scope(const Scope&) = delete;
+    void operator=(const Scope&) = delete;
+    void operator=(Scope&&) = delete;
+
+    const char* Category;
+    vtkTypeInt64 Begin;
+    char Name[64] = {};
+  };
+#endif
+
+protected:
+  vtkPVTraceRecorder();
+  ~vtkPVTraceRecorder() override;
+
+private:
+  vtkPVTraceRecorder(const vtkPVTraceRecorder&) = delete;
+  void operator=(const vtkPVTraceRecorder&) = delete;
+};
+
+#define vtkPVTraceRecorderConcatImpl(s1, s2) s1##s2
+#define vtkPVTraceRecorderConcat(s1, s2) vtkPVTraceRecorderConcatImpl(s1, s2)
+
+/**
+ * Records the time spent in the enclosing scope under the given category,
+ * with a printf-like formatted name e.g.
+ *
+ * @code{cpp}
+ *  vtkPVTraceScopeF("DATA_MOVEMENT", "move-data: %s", name);
+ * @endcode
+ *
+ * As with vtkVLogScopeF, the arguments are not evaluated when tracing is
+ * disabled.
+ */
+#define vtkPVTraceScopeF(category, ...)                                                            \
+  auto vtkPVTraceRecorderConcat(vtk_trace_scope_, __LINE__) = vtkPVTraceRecorder::GetEnabled()     \
+    ? vtkPVTraceRecorder::Scope(category, __VA_ARGS__)                                             \
+    : vtkPVTraceRecorder::Scope()
+
+#endif
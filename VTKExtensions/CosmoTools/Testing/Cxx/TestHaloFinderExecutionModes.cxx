@@ -0,0 +1,127 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <vtk_mpi.h>
+
+#include "HaloFinderTestHelpers.h"
+
+#include "vtkDataArray.h"
+#include "vtkMPIController.h"
+#include "vtkMath.h"
+#include "vtkSMPTools.h"
+
+#include <cmath>
+#include <map>
+#include <vector>
+
+namespace
+{
+struct HaloSummary
+{
+  double Count;
+  double CenterOfMass[3];
+  double Center[3];
+};
+
+std::vector<double> GetValues(vtkDataArray* array)
+{
+  std::vector<double> values(array->GetNumberOfTuples());
+  for (vtkIdType cc = 0; cc < array->GetNumberOfTuples(); ++cc)
+  {
+    values[cc] = array->GetComponent(cc, 0);
+  }
+  return values;
+}
+
+std::map<double, HaloSummary> GetHalos(vtkUnstructuredGrid* summaries)
+{
+  vtkPointData* pd = summaries->GetPointData();
+  vtkDataArray* tags = pd->GetArray("fof_halo_tag");
+  std::map<double, HaloSummary> halos;
+  for (vtkIdType cc = 0; cc < summaries->GetNumberOfPoints(); ++cc)
+  {
+    HaloSummary& halo = halos[tags->GetComponent(cc, 0)];
+    halo.Count = pd->GetArray("fof_halo_count")->GetComponent(cc, 0);
+    pd->GetArray("fof_halo_com")->GetTuple(cc, halo.CenterOfMass);
+    pd->GetArray("fof_center")->GetTuple(cc, halo.Center);
+  }
+  return halos;
+}
+
+int runHaloFinderTest(int argc, char* argv[])
+{
+  vtkSMPTools::Initialize(4);
+  HaloFinderTestHelpers::HaloFinderTestVTKObjects to =
+    HaloFinderTestHelpers::SetupHaloFinderTest(argc, argv, vtkPANLHaloFinder::MOST_BOUND_PARTICLE);
+  vtkPANLHaloFinder* haloFinder = to.haloFinder;
+  // threading is opt-in.
+  if (haloFinder->GetExecutionMode() != vtkPANLHaloFinder::SERIAL)
+  {
+    std::cerr << "The halo finder is not serial by default." << std::endl;
+    return 0;
+  }
+  const std::vector<double> serialTags =
+    GetValues(haloFinder->GetOutput(0)->GetPointData()->GetArray("fof_halo_tag"));
+  const std::map<double, HaloSummary> serialHalos = GetHalos(haloFinder->GetOutput(1));
+
+  haloFinder->SetExecutionMode(vtkPANLHaloFinder::THREADED);
+  haloFinder->Update();
+  if (haloFinder->GetPhaseTime(vtkPANLHaloFinder::FOF_LINKING_PHASE) <= 0.0)
+  {
+    std::cerr << "The threaded halo finder did not run." << std::endl;
+    return 0;
+  }
+  const std::vector<double> threadedTags =
+    GetValues(haloFinder->GetOutput(0)->GetPointData()->GetArray("fof_halo_tag"));
+  const std::map<double, HaloSummary> threadedHalos = GetHalos(haloFinder->GetOutput(1));
+
+  // halo membership and tags must match exactly.
+  if (threadedTags != serialTags)
+  {
+    std::cerr << "Particle halo tags differ between execution modes." << std::endl;
+    return 0;
+  }
+  if (serialHalos.empty() || threadedHalos.size() != serialHalos.size())
+  {
+    std::cerr << "Found " << threadedHalos.size() << " threaded halos and "
+              << serialHalos.size() << " serial halos." << std::endl;
+    return 0;
+  }
+
+  // properties are summed in a different order, and the most bound particle
+  // may change when potentials are within rounding of each other.
+  const double linkingLength = haloFinder->GetBB() * haloFinder->GetRL() / haloFinder->GetNP();
+  for (const auto& serial : serialHalos)
+  {
+    auto threaded = threadedHalos.find(serial.first);
+    if (threaded == threadedHalos.end() || threaded->second.Count != serial.second.Count)
+    {
+      std::cerr << "Halo " << serial.first << " differs between execution modes." << std::endl;
+      return 0;
+    }
+    if (std::sqrt(vtkMath::Distance2BetweenPoints(
+          threaded->second.CenterOfMass, serial.second.CenterOfMass)) > 1e-4 ||
+      std::sqrt(vtkMath::Distance2BetweenPoints(threaded->second.Center, serial.second.Center)) >
+        linkingLength)
+    {
+      std::cerr << "Halo " << serial.first << " has a different center." << std::endl;
+      return 0;
+    }
+  }
+  return 1;
+}
+}
+
+extern int TestHaloFinderExecutionModes(int argc, char* argv[])
+{
+  MPI_Init(&argc, &argv);
+
+  vtkNew<vtkMPIController> controller;
+  controller->Initialize();
+  vtkMultiProcessController::SetGlobalController(controller.GetPointer());
+
+  int retVal = runHaloFinderTest(argc, argv);
+
+  controller->Finalize();
+  return !retVal;
+}
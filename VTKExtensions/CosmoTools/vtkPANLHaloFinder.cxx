@@ -8,12 +8,15 @@
 #include "vtkFloatArray.h"
 #include "vtkInformation.h"
 #include "vtkIntArray.h"
+#include "vtkLogger.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiProcessController.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkTypeInt64Array.h"
 #include "vtkUnstructuredGrid.h"
 
@@ -25,7 +28,13 @@
 #include "Partition.h"
 #include "SubHaloFinder.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <numeric>
 #include <vector>
 
 namespace
@@ -108,6 +117,377 @@ private:
   std::vector<POSVEL_T> mass;
   std::vector<ID_T> id;
 };
+
+// Stores the time elapsed between its construction and destruction.
+class PhaseTimer
+{
+public:
+  PhaseTimer(double& time)
+    : Time(time)
+    , Start(std::chrono::steady_clock::now())
+  {
+  }
+
+  ~PhaseTimer()
+  {
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - this->Start;
+    this->Time = elapsed.count();
+  }
+
+private:
+  double& Time;
+  std::chrono::steady_clock::time_point Start;
+};
+
+// Friends-of-friends linking of the particles of a rank using all threads.
+//
+// Particles are bucketed into cells at least as large as the linking length
+// and sorted by cell, so that each particle only needs to be compared with the
+// particles of its own and neighboring cells, which are contiguous in memory.
+// Cells are processed concurrently and linked particles are merged using a
+// lock-free union-find in which the root of a set is always its lowest particle
+// index. Distances are compared exactly as in cosmotk::CosmoHaloFinder, so the
+// halos, and their tags, are the same as the ones of the serial halo finder.
+class ThreadedFOF
+{
+public:
+  ThreadedFOF(long numParticles, const POSVEL_T* x, const POSVEL_T* y, const POSVEL_T* z,
+    POSVEL_T bb)
+    : NumberOfParticles(static_cast<int>(numParticles))
+    , BB(bb)
+  {
+    this->Position[0] = x;
+    this->Position[1] = y;
+    this->Position[2] = z;
+  }
+
+  // Fills the halo structure using the conventions of the serial halo finder.
+  void Execute(std::vector<int>& haloTag, std::vector<int>& haloStart, std::vector<int>& haloList)
+  {
+    const int numParticles = this->NumberOfParticles;
+    haloTag.resize(numParticles);
+    haloStart.resize(numParticles);
+    haloList.resize(numParticles);
+    if (numParticles == 0)
+    {
+      return;
+    }
+
+    this->BuildCells();
+
+    this->Parent = std::vector<std::atomic<int>>(numParticles);
+    vtkSMPTools::For(0, numParticles, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType p = begin; p < end; ++p)
+      {
+        this->Parent[p].store(static_cast<int>(p), std::memory_order_relaxed);
+      }
+    });
+
+    const int numCells = this->Dimensions[0] * this->Dimensions[1] * this->Dimensions[2];
+    vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType cell = begin; cell < end; ++cell)
+      {
+        this->LinkCell(static_cast<int>(cell));
+      }
+    });
+
+    vtkSMPTools::For(0, numParticles, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType p = begin; p < end; ++p)
+      {
+        haloTag[p] = this->Find(static_cast<int>(p));
+        haloStart[p] = -1;
+      }
+    });
+
+    // Lists are built in increasing particle order, so that each list starts
+    // at the root of its halo.
+    for (int p = numParticles - 1; p >= 0; --p)
+    {
+      haloList[p] = haloStart[haloTag[p]];
+      haloStart[haloTag[p]] = p;
+    }
+
+    this->Parent.clear();
+    this->CellStart.clear();
+    this->SortedIds.clear();
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      this->SortedPosition[axis].clear();
+    }
+  }
+
+private:
+  int Find(int p)
+  {
+    int parent = this->Parent[p].load(std::memory_order_relaxed);
+    while (parent != p)
+    {
+      // path halving; parents only ever move to lower indices of the same set.
+      const int grandParent = this->Parent[parent].load(std::memory_order_relaxed);
+      if (grandParent != parent)
+      {
+        this->Parent[p].compare_exchange_weak(parent, grandParent, std::memory_order_relaxed);
+      }
+      p = grandParent;
+      parent = this->Parent[p].load(std::memory_order_relaxed);
+    }
+    return p;
+  }
+
+  void Unite(int a, int b)
+  {
+    while (true)
+    {
+      a = this->Find(a);
+      b = this->Find(b);
+      if (a == b)
+      {
+        return;
+      }
+      if (a > b)
+      {
+        std::swap(a, b);
+      }
+      // link the highest root below the lowest one.
+      int expected = b;
+      if (this->Parent[b].compare_exchange_strong(expected, a))
+      {
+        return;
+      }
+    }
+  }
+
+  void BuildCells()
+  {
+    const int numParticles = this->NumberOfParticles;
+
+    double bounds[6];
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      const POSVEL_T* pos = this->Position[axis];
+      auto range = std::minmax_element(pos, pos + numParticles);
+      bounds[2 * axis] = *range.first;
+      bounds[2 * axis + 1] = *range.second;
+    }
+
+    // Cells are at least as large as the linking length, and enlarged to keep
+    // the number of cells in the order of the number of particles.
+    double cellSize = std::max(static_cast<double>(this->BB), 1e-6);
+    const double maxNumberOfCells = 2.0 * numParticles + 27.0;
+    while (true)
+    {
+      double numCells = 1.0;
+      for (int axis = 0; axis < 3; ++axis)
+      {
+        this->Dimensions[axis] =
+          static_cast<int>(std::floor((bounds[2 * axis + 1] - bounds[2 * axis]) / cellSize)) + 1;
+        numCells *= this->Dimensions[axis];
+      }
+      if (numCells <= maxNumberOfCells)
+      {
+        break;
+      }
+      cellSize *= std::cbrt(numCells / maxNumberOfCells) * 1.01;
+    }
+
+    std::vector<int> cellIds(numParticles);
+    vtkSMPTools::For(0, numParticles, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType p = begin; p < end; ++p)
+      {
+        int ijk[3];
+        for (int axis = 0; axis < 3; ++axis)
+        {
+          const double x = this->Position[axis][p] - bounds[2 * axis];
+          const int index = static_cast<int>(x / cellSize);
+          ijk[axis] = std::min(std::max(index, 0), this->Dimensions[axis] - 1);
+        }
+        cellIds[p] = ijk[0] + this->Dimensions[0] * (ijk[1] + this->Dimensions[1] * ijk[2]);
+      }
+    });
+
+    // counting sort of the particles by cell, keeping particle order in cells.
+    const int numCells = this->Dimensions[0] * this->Dimensions[1] * this->Dimensions[2];
+    this->CellStart.assign(numCells + 1, 0);
+    for (int p = 0; p < numParticles; ++p)
+    {
+      ++this->CellStart[cellIds[p] + 1];
+    }
+    std::partial_sum(this->CellStart.begin(), this->CellStart.end(), this->CellStart.begin());
+    std::vector<int> next(this->CellStart.begin(), this->CellStart.end() - 1);
+    this->SortedIds.resize(numParticles);
+    for (int p = 0; p < numParticles; ++p)
+    {
+      this->SortedIds[next[cellIds[p]]++] = p;
+    }
+
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      this->SortedPosition[axis].resize(numParticles);
+    }
+    vtkSMPTools::For(0, numParticles, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        for (int axis = 0; axis < 3; ++axis)
+        {
+          this->SortedPosition[axis][i] = this->Position[axis][this->SortedIds[i]];
+        }
+      }
+    });
+  }
+
+  // Links the particles of a cell with the ones of the same cell and of the
+  // following half of its neighbors, so that each pair of cells is visited once.
+  void LinkCell(int cell)
+  {
+    const int first = this->CellStart[cell];
+    const int last = this->CellStart[cell + 1];
+    if (first == last)
+    {
+      return;
+    }
+
+    const int* dims = this->Dimensions;
+    const int ci = cell % dims[0];
+    const int cj = (cell / dims[0]) % dims[1];
+    const int ck = cell / (dims[0] * dims[1]);
+    for (int dk = 0; dk <= 1; ++dk)
+    {
+      for (int dj = (dk == 0 ? 0 : -1); dj <= 1; ++dj)
+      {
+        for (int di = (dk == 0 && dj == 0 ? 0 : -1); di <= 1; ++di)
+        {
+          const int ni = ci + di, nj = cj + dj, nk = ck + dk;
+          if (ni < 0 || ni >= dims[0] || nj < 0 || nj >= dims[1] || nk >= dims[2])
+          {
+            continue;
+          }
+          const int neighbor = ni + dims[0] * (nj + dims[1] * nk);
+          const bool sameCell = (neighbor == cell);
+          for (int i = first; i < last; ++i)
+          {
+            const int start = sameCell ? i + 1 : this->CellStart[neighbor];
+            this->LinkParticle(i, start, this->CellStart[neighbor + 1]);
+          }
+        }
+      }
+    }
+  }
+
+  void LinkParticle(int i, int first, int last)
+  {
+    const POSVEL_T bb = this->BB;
+    const POSVEL_T xi = this->SortedPosition[0][i];
+    const POSVEL_T yi = this->SortedPosition[1][i];
+    const POSVEL_T zi = this->SortedPosition[2][i];
+    for (int j = first; j < last; ++j)
+    {
+      POSVEL_T xdist = std::fabs(this->SortedPosition[0][j] - xi);
+      POSVEL_T ydist = std::fabs(this->SortedPosition[1][j] - yi);
+      POSVEL_T zdist = std::fabs(this->SortedPosition[2][j] - zi);
+      if ((xdist < bb) && (ydist < bb) && (zdist < bb))
+      {
+        POSVEL_T dist = xdist * xdist + ydist * ydist + zdist * zdist;
+        if (dist < bb * bb)
+        {
+          this->Unite(this->SortedIds[i], this->SortedIds[j]);
+        }
+      }
+    }
+  }
+
+  int NumberOfParticles;
+  POSVEL_T BB;
+  const POSVEL_T* Position[3];
+
+  int Dimensions[3];
+  std::vector<int> CellStart;
+  std::vector<int> SortedIds;
+  std::vector<POSVEL_T> SortedPosition[3];
+  std::vector<std::atomic<int>> Parent;
+};
+
+// Finds the centers of a range of halos, listed in Order. Each thread uses its
+// own buffers to extract the particles of a halo.
+class FindCentersWorker
+{
+public:
+  int Mode;
+  double BB;
+  double SmoothingLength;
+  double DistanceConvertFactor;
+  double RL;
+  int NP;
+  double OmegaMatter;
+  double OmegaCB;
+  double Hubble;
+  double RedShift;
+
+  int NumberOfHalos;
+  int* HaloCount;
+  cosmotk::FOFHaloProperties* FOF;
+  vtkPoints* Points;
+  vtkFloatArray* Centers;
+  const std::vector<int>* Order;
+
+  vtkSMPThreadLocal<std::unique_ptr<ExtractHalo>> HaloData;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    auto& haloData = this->HaloData.Local();
+    if (!haloData)
+    {
+      haloData.reset(new ExtractHalo(this->NumberOfHalos, this->HaloCount, this->FOF));
+    }
+
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      const int halo = (*this->Order)[i];
+      haloData->SetCurrentHalo(halo);
+      cosmotk::HaloCenterFinder centerFinder;
+      haloData->SetParticles(centerFinder);
+      centerFinder.setParameters(this->BB, this->SmoothingLength, this->DistanceConvertFactor,
+        this->RL, this->NP, this->OmegaMatter, this->OmegaCB, this->Hubble, this->RedShift);
+      int centerIndex = -1;
+      if (this->Mode == vtkPANLHaloFinder::MOST_BOUND_PARTICLE)
+      {
+        float minPotential;
+        if (haloData->GetNumberOfParticlesInCurrentHalo() < MBP_THRESHOLD)
+        {
+          centerIndex = centerFinder.mostBoundParticleN2(&minPotential);
+        }
+        else
+        {
+          centerIndex = centerFinder.mostBoundParticleAStar(&minPotential);
+        }
+      }
+      else if (this->Mode == vtkPANLHaloFinder::MOST_CONNECTED_PARTICLE)
+      {
+        if (haloData->GetNumberOfParticlesInCurrentHalo() < MCP_THRESHOLD)
+        {
+          centerIndex = centerFinder.mostConnectedParticleN2();
+        }
+        else
+        {
+          centerIndex = centerFinder.mostConnectedParticleChainMesh();
+        }
+      }
+      else
+      {
+        centerIndex = centerFinder.mostConnectedParticleHist();
+      }
+      float center[] = { 0.0, 0.0, 0.0 };
+      if (centerIndex >= 0)
+      {
+        double point[3];
+        this->Points->GetPoint(haloData->GetActualIndex(centerIndex), point);
+        center[0] = point[0];
+        center[1] = point[1];
+        center[2] = point[2];
+      }
+      this->Centers->SetTypedTuple(halo, center);
+    }
+  }
+};
 }
 
 class vtkPANLHaloFinder::vtkInternals
@@ -142,10 +522,13 @@ public:
   std::vector<POSVEL_T> fofZVel;
   std::vector<POSVEL_T> fofVelDisp;
 
+  double PhaseTimes[vtkPANLHaloFinder::NUMBER_OF_PHASES];
+
   vtkInternals()
   {
     this->fof = nullptr;
     this->haloFinder = nullptr;
+    std::fill(this->PhaseTimes, this->PhaseTimes + vtkPANLHaloFinder::NUMBER_OF_PHASES, 0.0);
   }
 
   ~vtkInternals()
@@ -208,6 +591,7 @@ vtkPANLHaloFinder::vtkPANLHaloFinder()
   this->MinCandidateSize = 200;
   this->NumSPHNeighbors = 64;
   this->NumNeighbors = 20;
+  this->ExecutionMode = SERIAL;
 
   this->CenterFindingMode = NONE;
   this->SmoothingLength = 0.0;
@@ -226,6 +610,40 @@ vtkPANLHaloFinder::~vtkPANLHaloFinder()
 void vtkPANLHaloFinder::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "ExecutionMode: " << this->ExecutionMode << endl;
+  for (int phase = 0; phase < NUMBER_OF_PHASES; ++phase)
+  {
+    os << indent << "PhaseTime (" << vtkPANLHaloFinder::GetPhaseName(phase)
+       << "): " << this->Internal->PhaseTimes[phase] << endl;
+  }
+}
+
+double vtkPANLHaloFinder::GetPhaseTime(int phase)
+{
+  return (phase >= 0 && phase < NUMBER_OF_PHASES) ? this->Internal->PhaseTimes[phase] : 0.0;
+}
+
+const char* vtkPANLHaloFinder::GetPhaseName(int phase)
+{
+  switch (phase)
+  {
+    case DISTRIBUTE_PHASE:
+      return "distribute particles";
+    case GHOST_EXCHANGE_PHASE:
+      return "exchange ghost particles";
+    case FOF_LINKING_PHASE:
+      return "friends-of-friends linking";
+    case HALO_MERGING_PHASE:
+      return "merge halos across ranks";
+    case HALO_PROPERTIES_PHASE:
+      return "compute halo properties";
+    case CENTER_FINDING_PHASE:
+      return "find halo centers";
+    case SUBHALO_FINDING_PHASE:
+      return "find subhalos";
+    default:
+      return "unknown";
+  }
 }
 
 int vtkPANLHaloFinder::RequestInformation(
@@ -260,6 +678,9 @@ int vtkPANLHaloFinder::RequestData(
 
   cosmotk::Partition::initialize();
 
+  auto& phaseTimes = this->Internal->PhaseTimes;
+  std::fill(phaseTimes, phaseTimes + NUMBER_OF_PHASES, 0.0);
+
   if (grid != nullptr)
   {
     this->ExtractDataArrays(grid, 0);
@@ -278,14 +699,33 @@ int vtkPANLHaloFinder::RequestData(
       }
     }
   }
-  this->DistributeInput();
-  this->CreateGhostParticles();
+  {
+    vtkLogScopeF(TRACE, "%s", GetPhaseName(DISTRIBUTE_PHASE));
+    PhaseTimer timer(phaseTimes[DISTRIBUTE_PHASE]);
+    this->DistributeInput();
+  }
+  {
+    vtkLogScopeF(TRACE, "%s", GetPhaseName(GHOST_EXCHANGE_PHASE));
+    PhaseTimer timer(phaseTimes[GHOST_EXCHANGE_PHASE]);
+    this->CreateGhostParticles();
+  }
   this->ExecuteHaloFinder(output, fofProperties);
-  this->FindCenters(output, fofProperties);
+  {
+    vtkLogScopeF(TRACE, "%s", GetPhaseName(CENTER_FINDING_PHASE));
+    PhaseTimer timer(phaseTimes[CENTER_FINDING_PHASE]);
+    this->FindCenters(output, fofProperties);
+  }
   if (this->RunSubHaloFinder)
   {
+    vtkLogScopeF(TRACE, "%s", GetPhaseName(SUBHALO_FINDING_PHASE));
+    PhaseTimer timer(phaseTimes[SUBHALO_FINDING_PHASE]);
     this->ExecuteSubHaloFinder(output, subFofProperties);
   }
+
+  for (int phase = 0; phase < NUMBER_OF_PHASES; ++phase)
+  {
+    vtkLogF(TRACE, "%s: %g s", GetPhaseName(phase), phaseTimes[phase]);
+  }
   return 1;
 }
 
@@ -359,6 +799,7 @@ void vtkPANLHaloFinder::CreateGhostParticles()
 void vtkPANLHaloFinder::ExecuteHaloFinder(
   vtkUnstructuredGrid* allParticles, vtkUnstructuredGrid* fofProperties)
 {
+  auto& phaseTimes = this->Internal->PhaseTimes;
   this->Internal->haloFinder = new cosmotk::CosmoHaloFinderP();
   this->Internal->haloFinder->setParameters(
     "", this->RL, this->DeadSize, this->NP, this->PMin, this->BB, this->NMin);
@@ -366,8 +807,35 @@ void vtkPANLHaloFinder::ExecuteHaloFinder(
     &this->Internal->yy[0], &this->Internal->zz[0], &this->Internal->vx[0], &this->Internal->vy[0],
     &this->Internal->vz[0], &this->Internal->potential[0], &this->Internal->tag[0],
     &this->Internal->mask[0], &this->Internal->status[0]);
-  this->Internal->haloFinder->executeHaloFinder();
-  this->Internal->haloFinder->collectHalos(false);
+  if (this->ExecutionMode == THREADED && this->NMin <= 1)
+  {
+    vtkLogScopeF(TRACE, "%s (%d threads)", GetPhaseName(FOF_LINKING_PHASE),
+      vtkSMPTools::GetEstimatedNumberOfThreads());
+    PhaseTimer timer(phaseTimes[FOF_LINKING_PHASE]);
+    // same linking length as the one used by the serial halo finder.
+    const POSVEL_T rL = static_cast<POSVEL_T>(this->RL);
+    const POSVEL_T bb =
+      static_cast<POSVEL_T>(this->BB) * static_cast<POSVEL_T>((1.0 * rL) / this->NP);
+    std::vector<int> haloTag, haloStart, haloList;
+    ThreadedFOF linker(this->Internal->xx.size(), this->Internal->xx.data(),
+      this->Internal->yy.data(), this->Internal->zz.data(), bb);
+    linker.Execute(haloTag, haloStart, haloList);
+    this->Internal->haloFinder->setHaloStructure(haloTag.data(), haloStart.data(), haloList.data());
+  }
+  else
+  {
+    vtkLogScopeF(TRACE, "%s (serial)", GetPhaseName(FOF_LINKING_PHASE));
+    PhaseTimer timer(phaseTimes[FOF_LINKING_PHASE]);
+    this->Internal->haloFinder->executeHaloFinder();
+  }
+  {
+    vtkLogScopeF(TRACE, "%s", GetPhaseName(HALO_MERGING_PHASE));
+    PhaseTimer timer(phaseTimes[HALO_MERGING_PHASE]);
+    this->Internal->haloFinder->collectHalos(false);
+  }
+
+  vtkLogScopeF(TRACE, "%s", GetPhaseName(HALO_PROPERTIES_PHASE));
+  PhaseTimer timer(phaseTimes[HALO_PROPERTIES_PHASE]);
   this->Internal->fof = new cosmotk::FOFHaloProperties();
   int numberOfFOFHalos = this->Internal->haloFinder->getNumberOfHalos();
   int* fofHalos = this->Internal->haloFinder->getHalos();
@@ -646,7 +1114,9 @@ void vtkPANLHaloFinder::ExecuteSubHaloFinder(
 void vtkPANLHaloFinder::FindCenters(
   vtkUnstructuredGrid* allParticles, vtkUnstructuredGrid* fofProperties)
 {
-  if (this->CenterFindingMode == vtkPANLHaloFinder::NONE)
+  if (this->CenterFindingMode != MOST_BOUND_PARTICLE &&
+    this->CenterFindingMode != MOST_CONNECTED_PARTICLE &&
+    this->CenterFindingMode != HIST_CENTER_FINDING)
   {
     return;
   }
@@ -661,55 +1131,37 @@ void vtkPANLHaloFinder::FindCenters(
   centers->SetNumberOfComponents(3);
   centers->SetNumberOfTuples(numberOfFOFHalos);
 
-  ExtractHalo haloData(numberOfFOFHalos, fofHaloCount, this->Internal->fof);
-  for (int halo = 0; halo < numberOfFOFHalos; ++halo)
+  std::vector<int> order(numberOfFOFHalos);
+  std::iota(order.begin(), order.end(), 0);
+
+  FindCentersWorker worker;
+  worker.Mode = this->CenterFindingMode;
+  worker.BB = this->BB;
+  worker.SmoothingLength = this->SmoothingLength;
+  worker.DistanceConvertFactor = this->DistanceConvertFactor;
+  worker.RL = this->RL;
+  worker.NP = this->NP;
+  worker.OmegaMatter = OmegaMatter;
+  worker.OmegaCB = OmegaCB;
+  worker.Hubble = this->Hubble;
+  worker.RedShift = this->RedShift;
+  worker.NumberOfHalos = numberOfFOFHalos;
+  worker.HaloCount = fofHaloCount;
+  worker.FOF = this->Internal->fof;
+  worker.Points = allParticles->GetPoints();
+  worker.Centers = centers;
+  worker.Order = &order;
+  if (this->ExecutionMode == THREADED)
   {
-    haloData.SetCurrentHalo(halo);
-    cosmotk::HaloCenterFinder centerFinder;
-    haloData.SetParticles(centerFinder);
-    centerFinder.setParameters(this->BB, this->SmoothingLength, this->DistanceConvertFactor,
-      this->RL, this->NP, OmegaMatter, OmegaCB, this->Hubble, this->RedShift);
-    int centerIndex = -1;
-    if (this->CenterFindingMode == MOST_BOUND_PARTICLE)
-    {
-      float minPotential;
-      if (haloData.GetNumberOfParticlesInCurrentHalo() < MBP_THRESHOLD)
-      {
-        centerIndex = centerFinder.mostBoundParticleN2(&minPotential);
-      }
-      else
-      {
-        centerIndex = centerFinder.mostBoundParticleAStar(&minPotential);
-      }
-    }
-    else if (this->CenterFindingMode == MOST_CONNECTED_PARTICLE)
-    {
-      if (haloData.GetNumberOfParticlesInCurrentHalo() < MCP_THRESHOLD)
-      {
-        centerIndex = centerFinder.mostConnectedParticleN2();
-      }
-      else
-      {
-        centerIndex = centerFinder.mostConnectedParticleChainMesh();
-      }
-    }
-    else if (this->CenterFindingMode == HIST_CENTER_FINDING)
-    {
-      centerIndex = centerFinder.mostConnectedParticleHist();
-    }
-    else
-    {
-      return;
-    }
-    float center[] = { 0.0, 0.0, 0.0 };
-    if (centerIndex >= 0)
-    {
-      double* point = allParticles->GetPoint(haloData.GetActualIndex(centerIndex));
-      center[0] = point[0];
-      center[1] = point[1];
-      center[2] = point[2];
-    }
-    centers->SetTypedTuple(halo, center);
+    // the cost of center finding grows quickly with the size of a halo, so
+    // the largest halos are scheduled first to balance the load of threads.
+    std::stable_sort(order.begin(), order.end(),
+      [&](int a, int b) { return fofHaloCount[a] > fofHaloCount[b]; });
+    vtkSMPTools::For(0, numberOfFOFHalos, 1, worker);
+  }
+  else
+  {
+    worker(0, numberOfFOFHalos);
   }
   fofProperties->GetPointData()->AddArray(centers.GetPointer());
 }
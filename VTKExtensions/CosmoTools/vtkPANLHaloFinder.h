@@ -23,6 +23,11 @@
  * The third output is empty unless subhalo finding is turned on.  If subhalo
  * finding is on, this output is similar to the second output except with data
  * for each subhalo rather than each halo.  It contains one point per subhalo.
+ *
+ * Optionally, the friends-of-friends linking and the center finding use all
+ * the threads of vtkSMPTools within each rank (see ExecutionMode). The time
+ * spent in each phase of the last execution can be queried using
+ * GetPhaseTime() and is logged at the TRACE verbosity.
  */
 
 #include "vtkPVVTKExtensionsCosmoToolsModule.h" // For export macro
@@ -212,6 +217,58 @@ public:
   vtkGetMacro(CenterFindingMode, int);
   ///@}
 
+  enum ExecutionModes
+  {
+    SERIAL = 0,
+    THREADED = 1
+  };
+
+  ///@{
+  /**
+   * Gets/Sets how halos are found within a rank.
+   *
+   * SERIAL runs the k-d tree based friends-of-friends linking of the halo
+   * finder and finds the center of one halo at a time.
+   *
+   * THREADED buckets the particles into cells of at least the linking length,
+   * sorts them by cell and links the particles of neighboring cells
+   * concurrently. Halo membership and tags are the same as with SERIAL, but
+   * particles are listed in a different order within halos, so halo
+   * properties may differ in their last bits. Centers of different halos are
+   * found concurrently. When NMin is larger than 1, linking is always
+   * serial since the neighbor count criterion is defined on the k-d tree.
+   * The most bound particle of a halo may differ from the SERIAL one when
+   * potentials are within rounding of each other.
+   *
+   * Default: SERIAL
+   */
+  vtkSetClampMacro(ExecutionMode, int, SERIAL, THREADED);
+  vtkGetMacro(ExecutionMode, int);
+  ///@}
+
+  enum Phases
+  {
+    DISTRIBUTE_PHASE = 0,
+    GHOST_EXCHANGE_PHASE,
+    FOF_LINKING_PHASE,
+    HALO_MERGING_PHASE,
+    HALO_PROPERTIES_PHASE,
+    CENTER_FINDING_PHASE,
+    SUBHALO_FINDING_PHASE,
+    NUMBER_OF_PHASES
+  };
+
+  /**
+   * Returns the time, in seconds, spent by this rank in a phase of the last
+   * execution, or 0 if the phase did not run.
+   */
+  double GetPhaseTime(int phase);
+
+  /**
+   * Returns the name of a phase, as reported in the log.
+   */
+  static const char* GetPhaseName(int phase);
+
   ///@{
   /**
    * Gets/Sets the smoothing length used by the center finders
@@ -295,6 +352,7 @@ protected:
   int NumNeighbors;
 
   bool RunSubHaloFinder;
+  int ExecutionMode;
 
   // Center finding parameters
   int CenterFindingMode;
@@ -23,6 +23,7 @@
 #include "vtkMultiPieceDataSet.h"
 #include "vtkNonOverlappingAMR.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkUniformGrid.h"
 #include "vtkUnstructuredGrid.h"
 // Data types, Arrays & Containers
@@ -34,6 +35,7 @@
 #include "vtkDoubleArray.h"
 #include "vtkFloatArray.h"
 #include "vtkIntArray.h"
+#include "vtkLogger.h"
 #include "vtkMaterialInterfaceIdList.h"
 #include "vtkMaterialInterfacePieceLoading.h"
 #include "vtkMaterialInterfacePieceTransaction.h"
@@ -41,6 +43,7 @@
 #include "vtkMaterialInterfaceProcessLoading.h"
 #include "vtkMaterialInterfaceProcessRing.h"
 #include "vtkMaterialInterfaceToProcMap.h"
+#include "vtkNew.h"
 #include "vtkPointAccumulator.h"
 #include "vtkPointData.h"
 #include "vtkUnsignedCharArray.h"
@@ -68,6 +71,9 @@ using std::vector;
 #include <string>
 using std::string;
 #include <algorithm>
+#include <map>
+#include <utility>
+#include <unordered_map>
 // ansi c
 #include <cmath>
 #include <ctime>
@@ -227,6 +233,135 @@ int GetEnabledArrayNames(vtkDataArraySelection* das, vector<string>& names)
   }
   return nEnabled;
 }
+
+// Send a variable length buffer of ids, size first.
+void SendIds(vtkMultiProcessController* controller, const vector<int>& buf, int proc, int tag)
+{
+  int size = static_cast<int>(buf.size());
+  controller->Send(&size, 1, proc, tag);
+  if (size > 0)
+  {
+    controller->Send(buf.data(), size, proc, tag + 1);
+  }
+}
+
+// Receive a buffer sent with SendIds.
+void ReceiveIds(vtkMultiProcessController* controller, vector<int>& buf, int proc, int tag)
+{
+  int size = 0;
+  controller->Receive(&size, 1, proc, tag);
+  buf.resize(size);
+  if (size > 0)
+  {
+    controller->Receive(buf.data(), size, proc, tag + 1);
+  }
+}
+
+// Swap buffers with another process.  The process with the smaller id sends
+// first.  When every process handles its partners in increasing order, the
+// pairs are handled in the same order everywhere and blocking sends cannot
+// deadlock.
+void ExchangeIds(vtkMultiProcessController* controller, const vector<int>& sendBuf,
+  vector<int>& recvBuf, int proc, int tag)
+{
+  if (controller->GetLocalProcessId() < proc)
+  {
+    SendIds(controller, sendBuf, proc, tag);
+    ReceiveIds(controller, recvBuf, proc, tag);
+  }
+  else
+  {
+    ReceiveIds(controller, recvBuf, proc, tag);
+    SendIds(controller, sendBuf, proc, tag);
+  }
+}
+
+// Return the process owning a global fragment id.  procOffsets holds the
+// first global id of each process, processes without fragments share the
+// offset of the next one.
+int FindFragmentOwner(const int* procOffsets, int numProcs, int id)
+{
+  const int* next = std::upper_bound(procOffsets, procOffsets + numProcs, id);
+  return static_cast<int>(next - procOffsets) - 1;
+}
+
+// Find the processes to exchange with, given the processes we send to.  The
+// destinations of all processes are gathered, so that a process also
+// exchanges with the processes that send to it, and both processes of a
+// pair agree on it.  Partners are sorted for ExchangeIds.
+void FindExchangePartners(
+  vtkMultiProcessController* controller, const vector<int>& destinations, vector<int>& partners)
+{
+  const int numProcs = controller->GetNumberOfProcesses();
+  const int myProcId = controller->GetLocalProcessId();
+  const vtkIdType numDestinations = static_cast<vtkIdType>(destinations.size());
+  vector<vtkIdType> lengths(numProcs);
+  controller->AllGather(&numDestinations, lengths.data(), 1);
+  vector<vtkIdType> offsets(numProcs);
+  vtkIdType total = 0;
+  for (int ii = 0; ii < numProcs; ++ii)
+  {
+    offsets[ii] = total;
+    total += lengths[ii];
+  }
+
+  partners = destinations;
+  if (total > 0)
+  {
+    vector<int> allDestinations(total);
+    controller->AllGatherV(destinations.data(), allDestinations.data(), numDestinations,
+      lengths.data(), offsets.data());
+    for (int ii = 0; ii < numProcs; ++ii)
+    {
+      for (vtkIdType jj = offsets[ii]; jj < offsets[ii] + lengths[ii]; ++jj)
+      {
+        if (allDestinations[jj] == myProcId)
+        {
+          partners.push_back(ii);
+        }
+      }
+    }
+  }
+  std::sort(partners.begin(), partners.end());
+  partners.erase(std::unique(partners.begin(), partners.end()), partners.end());
+  partners.erase(std::remove(partners.begin(), partners.end(), myProcId), partners.end());
+}
+
+// Swap arrays with another process, in the same order as ExchangeIds.
+void ExchangeArrays(vtkMultiProcessController* controller, vtkDoubleArray* sendArray,
+  vtkDoubleArray* recvArray, int proc, int tag)
+{
+  if (controller->GetLocalProcessId() < proc)
+  {
+    controller->Send(sendArray, proc, tag);
+    controller->Receive(recvArray, proc, tag);
+  }
+  else
+  {
+    controller->Receive(recvArray, proc, tag);
+    controller->Send(sendArray, proc, tag);
+  }
+}
+
+// Replace the tuples of an array by their sums over the tuples sharing
+// the same slot.
+void SumTuplesBySlot(vtkDoubleArray* array, const vector<int>& slots, int numSlots)
+{
+  const int nComps = array->GetNumberOfComponents();
+  vector<double> summed(static_cast<size_t>(numSlots) * nComps, 0.0);
+  const double* pIn = array->GetPointer(0);
+  for (size_t i = 0; i < slots.size(); ++i)
+  {
+    double* pOut = summed.data() + static_cast<size_t>(slots[i]) * nComps;
+    for (int q = 0; q < nComps; ++q)
+    {
+      pOut[q] += pIn[q];
+    }
+    pIn += nComps;
+  }
+  array->SetNumberOfTuples(numSlots);
+  std::copy(summed.begin(), summed.end(), array->GetPointer(0));
+}
 };
 //============================================================================
 // A class that implements an equivalent set.  It is used to combine fragments
@@ -257,6 +392,11 @@ public:
 
   void DeepCopy(vtkMaterialInterfaceEquivalenceSet* in);
 
+  // Replace the set with already resolved set ids for the members
+  // [firstMemberId, firstMemberId + numberOfMembers).  Other members
+  // are only equivalent to themselves.
+  void SetResolvedSetIds(int firstMemberId, const int* setIds, int numberOfMembers);
+
   // Needed for sending the set over MPI.
   // Be very careful with the pointer.
   int* GetPointer() { return this->EquivalenceArray->GetPointer(0); }
@@ -274,6 +414,8 @@ private:
   // To merge connected framgments that have different ids because they were
   // traversed by different processes or passes.
   vtkIntArray* EquivalenceArray;
+  // Id of the first member stored in the array.
+  int FirstMemberId;
 
   // Return the id of the equivalent set.
   int GetReference(int memberId);
@@ -284,6 +426,7 @@ private:
 vtkMaterialInterfaceEquivalenceSet::vtkMaterialInterfaceEquivalenceSet()
 {
   this->Resolved = 0;
+  this->FirstMemberId = 0;
   this->EquivalenceArray = vtkIntArray::New();
 }
 
@@ -302,6 +445,7 @@ vtkMaterialInterfaceEquivalenceSet::~vtkMaterialInterfaceEquivalenceSet()
 void vtkMaterialInterfaceEquivalenceSet::Initialize()
 {
   this->Resolved = 0;
+  this->FirstMemberId = 0;
   this->EquivalenceArray->Initialize();
 }
 
@@ -309,15 +453,26 @@ void vtkMaterialInterfaceEquivalenceSet::Initialize()
 void vtkMaterialInterfaceEquivalenceSet::DeepCopy(vtkMaterialInterfaceEquivalenceSet* in)
 {
   this->Resolved = in->Resolved;
+  this->FirstMemberId = in->FirstMemberId;
   this->EquivalenceArray->DeepCopy(in->EquivalenceArray);
 }
 
+//----------------------------------------------------------------------------
+void vtkMaterialInterfaceEquivalenceSet::SetResolvedSetIds(
+  int firstMemberId, const int* setIds, int numberOfMembers)
+{
+  this->EquivalenceArray->SetNumberOfTuples(numberOfMembers);
+  std::copy(setIds, setIds + numberOfMembers, this->EquivalenceArray->GetPointer(0));
+  this->FirstMemberId = firstMemberId;
+  this->Resolved = 1;
+}
+
 //----------------------------------------------------------------------------
 void vtkMaterialInterfaceEquivalenceSet::Print()
 {
   vtkIdType num = this->GetNumberOfMembers();
   cerr << num << endl;
-  for (vtkIdType ii = 0; ii < num; ++ii)
+  for (vtkIdType ii = this->FirstMemberId; ii < this->FirstMemberId + num; ++ii)
   {
     cerr << "  " << ii << " : " << this->GetEquivalentSetId(ii) << endl;
   }
@@ -344,11 +499,12 @@ int vtkMaterialInterfaceEquivalenceSet::GetEquivalentSetId(int memberId)
 // Return the id of the equivalent set.
 int vtkMaterialInterfaceEquivalenceSet::GetReference(int memberId)
 {
-  if (memberId >= this->EquivalenceArray->GetNumberOfTuples())
+  const int index = memberId - this->FirstMemberId;
+  if (index < 0 || index >= this->EquivalenceArray->GetNumberOfTuples())
   { // We might consider this an error ...
     return memberId;
   }
-  return this->EquivalenceArray->GetValue(memberId);
+  return this->EquivalenceArray->GetValue(index);
 }
 
 //----------------------------------------------------------------------------
@@ -452,6 +608,120 @@ int vtkMaterialInterfaceEquivalenceSet::ResolveEquivalences()
   return count;
 }
 
+//============================================================================
+// A sparse union-find used to resolve the equivalences between processes.
+// Only ids of sets that touch a process boundary are stored.  The root of
+// every set is its smallest member so that all processes agree on it
+// regardless of the order in which equivalences were added.
+class vtkMaterialInterfaceUnionFind
+{
+public:
+  // Makes two ids equivalent.  Return true if they were not already.
+  bool AddEquivalence(int id1, int id2);
+
+  // Add (id, equivalent id) pairs, as returned by GetEquivalences.
+  // Return true if any set was merged.
+  bool AddEquivalences(const vector<int>& pairs);
+
+  // Return the smallest id equivalent to memberId.  Ids that were never
+  // added are only equivalent to themselves.
+  int GetEquivalentSetId(int memberId);
+
+  // Fill pairs with (id, set id) for every id that is not the root of its set.
+  void GetEquivalences(vector<int>& pairs);
+
+  // Fill ids with the roots of all sets.
+  void GetSetIds(vector<int>& ids);
+
+  int GetNumberOfMembers() { return static_cast<int>(this->Parents.size()); }
+
+private:
+  std::unordered_map<int, int> Parents;
+};
+
+//----------------------------------------------------------------------------
+bool vtkMaterialInterfaceUnionFind::AddEquivalence(int id1, int id2)
+{
+  this->Parents.emplace(id1, id1);
+  this->Parents.emplace(id2, id2);
+  const int root1 = this->GetEquivalentSetId(id1);
+  const int root2 = this->GetEquivalentSetId(id2);
+  if (root1 < root2)
+  {
+    this->Parents[root2] = root1;
+  }
+  else if (root2 < root1)
+  {
+    this->Parents[root1] = root2;
+  }
+  return root1 != root2;
+}
+
+//----------------------------------------------------------------------------
+bool vtkMaterialInterfaceUnionFind::AddEquivalences(const vector<int>& pairs)
+{
+  bool merged = false;
+  const size_t num = pairs.size() / 2;
+  for (size_t ii = 0; ii < num; ++ii)
+  {
+    merged = this->AddEquivalence(pairs[2 * ii], pairs[2 * ii + 1]) || merged;
+  }
+  return merged;
+}
+
+//----------------------------------------------------------------------------
+int vtkMaterialInterfaceUnionFind::GetEquivalentSetId(int memberId)
+{
+  auto iter = this->Parents.find(memberId);
+  if (iter == this->Parents.end())
+  {
+    return memberId;
+  }
+  int root = memberId;
+  while (iter->second != root)
+  {
+    root = iter->second;
+    iter = this->Parents.find(root);
+  }
+  // Path compression, so that the next look up is immediate.
+  while (memberId != root)
+  {
+    int& parent = this->Parents.find(memberId)->second;
+    memberId = parent;
+    parent = root;
+  }
+  return root;
+}
+
+//----------------------------------------------------------------------------
+void vtkMaterialInterfaceUnionFind::GetEquivalences(vector<int>& pairs)
+{
+  pairs.clear();
+  for (auto& item : this->Parents)
+  {
+    // Only values are modified here, so the iterator remains valid.
+    const int root = this->GetEquivalentSetId(item.first);
+    if (root != item.first)
+    {
+      pairs.push_back(item.first);
+      pairs.push_back(root);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkMaterialInterfaceUnionFind::GetSetIds(vector<int>& ids)
+{
+  ids.clear();
+  for (auto& item : this->Parents)
+  {
+    if (item.second == item.first)
+    {
+      ids.push_back(item.first);
+    }
+  }
+}
+
 //============================================================================
 // Helper object to clip hexahedra with implicit half sphere.
 class vtkMaterialInterfaceFilterHalfSphere
@@ -1529,6 +1799,163 @@ int vtkMaterialInterfaceFilterRingBuffer::Pop(vtkMaterialInterfaceFilterIterator
 
 //============================================================================
 
+//----------------------------------------------------------------------------
+// Everything that changes while fragments are extracted from blocks.  Blocks
+// can be processed concurrently as long as each one uses its own workspace.
+// The attributes of the fragments found are kept here, in the order the
+// fragments were found, until they are collected by the filter.
+class vtkMaterialInterfaceFilterWorkspace
+{
+public:
+  vtkMaterialInterfaceFilterWorkspace();
+  ~vtkMaterialInterfaceFilterWorkspace();
+
+  // Size the accumulators like the arrays of integrated attributes.
+  void Initialize(const vector<vtkDoubleArray*>& volumeWtdAvgs,
+    const vector<vtkDoubleArray*>& massWtdAvgs, const vector<vtkDoubleArray*>& sums);
+
+  // Save the attributes of the current fragment, clear the
+  // accumulators and move to the next fragment.
+  void SaveFragment(bool clipWithPlane, bool computeMoments);
+
+  int GetNumberOfFragments() { return static_cast<int>(this->FragmentVolumes.size()); }
+
+  // When set, the search does not leave this block.  Fragment voxels of
+  // other blocks are saved as neighbors and connected once all the
+  // blocks are processed.
+  vtkMaterialInterfaceFilterBlock* Block;
+  vector<std::pair<vtkMaterialInterfaceFilterIterator, vtkMaterialInterfaceFilterIterator>>
+    BlockNeighbors;
+
+  // Id of the current fragment.
+  int FragmentId;
+  // Pairs of equivalent fragment ids.
+  vector<int> Equivalences;
+
+  // Accumulators for the current fragment.
+  vtkPolyData* CurrentFragmentMesh;
+  double FragmentVolume;
+  double ClipDepthMin;
+  double ClipDepthMax;
+  vector<double> FragmentMoment; // =(Myz, Mxz, Mxy, m)
+  vector<vector<double>> FragmentVolumeWtdAvg;
+  vector<vector<double>> FragmentMassWtdAvg;
+  vector<vector<double>> FragmentSum;
+
+  // Attributes of the fragments found.
+  vector<vtkPolyData*> FragmentMeshes;
+  vector<double> FragmentVolumes;
+  vector<double> ClipDepthMinimums;
+  vector<double> ClipDepthMaximums;
+  vector<double> FragmentMoments;
+  vector<vector<double>> FragmentVolumeWtdAvgs;
+  vector<vector<double>> FragmentMassWtdAvgs;
+  vector<vector<double>> FragmentSums;
+
+  // For computing the point on corners and edges of a face.
+  vtkMaterialInterfaceFilterIterator FaceNeighbors[32];
+  double FaceCornerPoints[12];
+  double FaceEdgePoints[12];
+  int FaceEdgeFlags[4];
+
+private:
+  vtkMaterialInterfaceFilterWorkspace(const vtkMaterialInterfaceFilterWorkspace&) = delete;
+  void operator=(const vtkMaterialInterfaceFilterWorkspace&) = delete;
+};
+
+//----------------------------------------------------------------------------
+vtkMaterialInterfaceFilterWorkspace::vtkMaterialInterfaceFilterWorkspace()
+{
+  this->Block = nullptr;
+  this->FragmentId = 0;
+  this->CurrentFragmentMesh = nullptr;
+  this->FragmentVolume = 0.0;
+  this->ClipDepthMin = VTK_FLOAT_MAX;
+  this->ClipDepthMax = 0.0;
+  this->FragmentMoment.resize(4, 0.0);
+}
+
+//----------------------------------------------------------------------------
+vtkMaterialInterfaceFilterWorkspace::~vtkMaterialInterfaceFilterWorkspace()
+{
+  // Only if the fragments have not been collected.
+  ClearVectorOfVtkPointers(this->FragmentMeshes);
+}
+
+//----------------------------------------------------------------------------
+void vtkMaterialInterfaceFilterWorkspace::Initialize(const vector<vtkDoubleArray*>& volumeWtdAvgs,
+  const vector<vtkDoubleArray*>& massWtdAvgs, const vector<vtkDoubleArray*>& sums)
+{
+  this->FragmentVolumeWtdAvg.resize(volumeWtdAvgs.size());
+  this->FragmentVolumeWtdAvgs.resize(volumeWtdAvgs.size());
+  for (size_t i = 0; i < volumeWtdAvgs.size(); ++i)
+  {
+    this->FragmentVolumeWtdAvg[i].resize(volumeWtdAvgs[i]->GetNumberOfComponents(), 0.0);
+  }
+  this->FragmentMassWtdAvg.resize(massWtdAvgs.size());
+  this->FragmentMassWtdAvgs.resize(massWtdAvgs.size());
+  for (size_t i = 0; i < massWtdAvgs.size(); ++i)
+  {
+    this->FragmentMassWtdAvg[i].resize(massWtdAvgs[i]->GetNumberOfComponents(), 0.0);
+  }
+  this->FragmentSum.resize(sums.size());
+  this->FragmentSums.resize(sums.size());
+  for (size_t i = 0; i < sums.size(); ++i)
+  {
+    this->FragmentSum[i].resize(sums[i]->GetNumberOfComponents(), 0.0);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkMaterialInterfaceFilterWorkspace::SaveFragment(bool clipWithPlane, bool computeMoments)
+{
+  // the id is implicit given by its position in the vector, but only
+  // until fragments are resolved. After resolution we add addributes such
+  // as id, volume, summations averages, etc..
+  this->CurrentFragmentMesh->Squeeze();
+  this->FragmentMeshes.push_back(this->CurrentFragmentMesh);
+  this->CurrentFragmentMesh = nullptr;
+  // Save the volume from the last fragment and clear the accumulator.
+  this->FragmentVolumes.push_back(this->FragmentVolume);
+  this->FragmentVolume = 0.0;
+  if (clipWithPlane)
+  {
+    this->ClipDepthMaximums.push_back(this->ClipDepthMax);
+    this->ClipDepthMinimums.push_back(this->ClipDepthMin);
+  }
+  this->ClipDepthMax = 0.0;
+  this->ClipDepthMin = VTK_FLOAT_MAX;
+  if (computeMoments)
+  {
+    this->FragmentMoments.insert(
+      this->FragmentMoments.end(), this->FragmentMoment.begin(), this->FragmentMoment.end());
+    FillVector(this->FragmentMoment, 0.0);
+  }
+  // for the weighted averages and summed scalars/vectors...
+  for (size_t i = 0; i < this->FragmentVolumeWtdAvg.size(); ++i)
+  {
+    this->FragmentVolumeWtdAvgs[i].insert(this->FragmentVolumeWtdAvgs[i].end(),
+      this->FragmentVolumeWtdAvg[i].begin(), this->FragmentVolumeWtdAvg[i].end());
+    FillVector(this->FragmentVolumeWtdAvg[i], 0.0);
+  }
+  for (size_t i = 0; i < this->FragmentMassWtdAvg.size(); ++i)
+  {
+    this->FragmentMassWtdAvgs[i].insert(this->FragmentMassWtdAvgs[i].end(),
+      this->FragmentMassWtdAvg[i].begin(), this->FragmentMassWtdAvg[i].end());
+    FillVector(this->FragmentMassWtdAvg[i], 0.0);
+  }
+  for (size_t i = 0; i < this->FragmentSum.size(); ++i)
+  {
+    this->FragmentSums[i].insert(
+      this->FragmentSums[i].end(), this->FragmentSum[i].begin(), this->FragmentSum[i].end());
+    FillVector(this->FragmentSum[i], 0.0);
+  }
+  // Move to next fragment.
+  ++this->FragmentId;
+}
+
+//============================================================================
+
 //----------------------------------------------------------------------------
 // Description:
 // Construct object with initial range (0,1) and single contour value
@@ -1596,18 +2023,13 @@ vtkMaterialInterfaceFilter::vtkMaterialInterfaceFilter()
   this->GlobalOrigin[0] = this->GlobalOrigin[1] = this->GlobalOrigin[2] = 0.0;
   this->RootSpacing[0] = this->RootSpacing[1] = this->RootSpacing[2] = 1.0;
 
-  this->FragmentId = 0;
-  this->FragmentVolume = 0.0;
   this->FragmentVolumes = nullptr;
-  this->FragmentMoment.resize(4, 0.0);
   this->FragmentMoments = nullptr;
   this->FragmentAABBCenters = nullptr;
   this->FragmentOBBs = nullptr;
   this->FragmentSplitGeometry = nullptr;
 
   // Keep depth of crater along clip plane normal.
-  this->ClipDepthMax = 0.0;
-  this->ClipDepthMin = VTK_FLOAT_MAX;
   this->ClipDepthMaximums = nullptr;
   this->ClipDepthMinimums = nullptr;
 
@@ -1622,10 +2044,6 @@ vtkMaterialInterfaceFilter::vtkMaterialInterfaceFilter()
   this->ResolvedFragmentCenters = nullptr;
   this->ResolvedFragmentOBBs = nullptr;
 
-  this->FaceNeighbors = new vtkMaterialInterfaceFilterIterator[32];
-
-  this->CurrentFragmentMesh = nullptr;
-
   this->NVolumeWtdAvgs = 0;
   this->NToSum = 0;
   this->ComputeMoments = false;
@@ -1667,11 +2085,6 @@ vtkMaterialInterfaceFilter::~vtkMaterialInterfaceFilter()
   this->GlobalOrigin[0] = this->GlobalOrigin[1] = this->GlobalOrigin[2] = 0.0;
   this->RootSpacing[0] = this->RootSpacing[1] = this->RootSpacing[2] = 1.0;
 
-  this->FragmentId = 0;
-  this->FragmentVolume = 0.0;
-  this->ClipDepthMax = 0.0;
-  this->ClipDepthMin = VTK_FLOAT_MAX;
-
   this->SetClipFunction(nullptr);
 
   CheckAndReleaseVtkPointer(this->ClipDepthMaximums);
@@ -1688,9 +2101,6 @@ vtkMaterialInterfaceFilter::~vtkMaterialInterfaceFilter()
   delete this->EquivalenceSet;
   this->EquivalenceSet = nullptr;
 
-  delete[] this->FaceNeighbors;
-  this->FaceNeighbors = nullptr;
-
   // clean up PV interface
   this->MaterialArraySelection->RemoveObserver(this->SelectionObserver);
   this->MaterialArraySelection->Delete();
@@ -2735,6 +3145,8 @@ void vtkMaterialInterfaceFilter::ShareGhostBlocks()
   int myProc = this->Controller->GetLocalProcessId();
   vtkCommunicator* com = this->Controller->GetCommunicator();
 
+  this->GhostBlockRequestingProcesses.clear();
+
   // Bad things can happen if not all processes call
   // MPI_Alltoallv this at the same time. (mpich)
   this->Controller->Barrier();
@@ -2946,6 +3358,8 @@ void vtkMaterialInterfaceFilter::HandleGhostBlockRequests()
       block->ExtractExtent(buf, ext);
       // Send the block.
       this->Controller->Send(buf, dataSize, otherProc, 433240);
+      // Remember who holds our ghost blocks for sharing equivalences.
+      this->GhostBlockRequestingProcesses.push_back(otherProc);
     }
   }
   delete[] buf;
@@ -3108,16 +3522,11 @@ void vtkMaterialInterfaceFilter::PrepareForPass(vtkNonOverlappingAMR* hbdsInput,
   vector<string>& volumeWtdAvgArrayNames, vector<string>& massWtdAvgArrayNames,
   vector<string>& summedArrayNames, vector<string>& integratedArrayNames)
 {
-  this->FragmentId = 0;
-
-  this->FragmentVolume = 0.0;
   ReNewVtkPointer(this->FragmentVolumes);
   this->FragmentVolumes->SetName("Volume");
 
   if (this->ClipWithPlane)
   {
-    this->ClipDepthMax = 0.0;
-    this->ClipDepthMin = VTK_FLOAT_MAX;
     ReNewVtkPointer(this->ClipDepthMaximums);
     ReNewVtkPointer(this->ClipDepthMinimums);
     this->ClipDepthMaximums->SetName("ClipDepthMax");
@@ -3126,8 +3535,6 @@ void vtkMaterialInterfaceFilter::PrepareForPass(vtkNonOverlappingAMR* hbdsInput,
 
   if (this->ComputeMoments)
   {
-    this->FragmentMoment.clear();
-    this->FragmentMoment.resize(4, 0.0);
     ReNewVtkPointer(this->FragmentMoments);
     this->FragmentMoments->SetNumberOfComponents(4);
     this->FragmentMoments->SetName("Moments");
@@ -3165,11 +3572,9 @@ void vtkMaterialInterfaceFilter::PrepareForPass(vtkNonOverlappingAMR* hbdsInput,
   // Configure data structures
   // 1) Volume weighted average of attribute over the
   // fragment set up containers
-  this->FragmentVolumeWtdAvg.clear();
-  this->FragmentVolumeWtdAvg.resize(this->NVolumeWtdAvgs);
   ClearVectorOfVtkPointers(this->FragmentVolumeWtdAvgs);
   this->FragmentVolumeWtdAvgs.resize(this->NVolumeWtdAvgs);
-  // set up data array and accumulator for each weighted average
+  // set up data array for each weighted average
   for (int j = 0; j < this->NVolumeWtdAvgs; ++j)
   {
     // data array
@@ -3188,16 +3593,12 @@ void vtkMaterialInterfaceFilter::PrepareForPass(vtkNonOverlappingAMR* hbdsInput,
     ostringstream osIntegratedArrayName;
     osIntegratedArrayName << "VolumeWeightedAverage-" << thisArrayName;
     this->FragmentVolumeWtdAvgs[j]->SetName(osIntegratedArrayName.str().c_str());
-    // accumulator
-    this->FragmentVolumeWtdAvg[j].resize(nComp, 0.0);
   }
   // 2) Mass weighted average of attribute over the fragment
   // set up containers
-  this->FragmentMassWtdAvg.clear();
-  this->FragmentMassWtdAvg.resize(this->NMassWtdAvgs);
   ClearVectorOfVtkPointers(this->FragmentMassWtdAvgs);
   this->FragmentMassWtdAvgs.resize(this->NMassWtdAvgs);
-  // set up data array and accumulator for each weighted average
+  // set up data array for each weighted average
   for (int j = 0; j < this->NMassWtdAvgs; ++j)
   {
     // data array
@@ -3216,16 +3617,12 @@ void vtkMaterialInterfaceFilter::PrepareForPass(vtkNonOverlappingAMR* hbdsInput,
     ostringstream osIntegratedArrayName;
     osIntegratedArrayName << "MassWeightedAverage-" << thisArrayName;
     this->FragmentMassWtdAvgs[j]->SetName(osIntegratedArrayName.str().c_str());
-    // accumulator
-    this->FragmentMassWtdAvg[j].resize(nComp, 0.0);
   }
   // 3) Summation of attribute over the fragment
   // set up containers
-  this->FragmentSum.clear();
-  this->FragmentSum.resize(this->NToSum);
   ClearVectorOfVtkPointers(this->FragmentSums);
   this->FragmentSums.resize(this->NToSum);
-  // set up data array and accumulator for each weighted average
+  // set up data array for each weighted average
   for (int j = 0; j < this->NToSum; ++j)
   {
     // data array
@@ -3244,8 +3641,6 @@ void vtkMaterialInterfaceFilter::PrepareForPass(vtkNonOverlappingAMR* hbdsInput,
     ostringstream osIntegratedArrayName;
     osIntegratedArrayName << "Summation-" << thisArrayName;
     this->FragmentSums[j]->SetName(osIntegratedArrayName.str().c_str());
-    // accumulator
-    this->FragmentSum[j].resize(nComp, 0.0);
   }
 
   // 4) Unique list of integrated attributes
@@ -3473,12 +3868,8 @@ int vtkMaterialInterfaceFilter::RequestData(vtkInformation* vtkNotUsed(request),
     // Lets profile to see what takes the most time for large number of processes.
     this->ProcessBlocksTimer->StartTimer();
 #endif
-    int blockId;
-    for (blockId = 0; blockId < this->NumberOfInputBlocks; ++blockId)
-    {
-      // build fragments
-      this->ProcessBlock(blockId);
-    }
+    // build fragments
+    this->ProcessBlocks();
 #ifdef vtkMaterialInterfaceFilterPROFILE
     // Lets profile to see what takes the most time for large number of processes.
     this->ProcessBlocksTimer->StopTimer();
@@ -3622,17 +4013,172 @@ int vtkMaterialInterfaceFilter::RequestData(vtkInformation* vtkNotUsed(request),
 }
 
 //----------------------------------------------------------------------------
-int vtkMaterialInterfaceFilter::ProcessBlock(int blockId)
-{
+// Extract fragments from all local blocks. Blocks are processed concurrently
+// when more than one thread is available. Each block then numbers its
+// fragments from 0 and does not follow fragments into other blocks. Once all
+// blocks are done, fragment ids are offset in block order, so that resolved
+// fragments are numbered as when blocks are processed one after the other,
+// and fragments are connected across block boundaries, including into ghost
+// blocks.
+void vtkMaterialInterfaceFilter::ProcessBlocks()
+{
+  const int numberOfBlocks = this->NumberOfInputBlocks;
+  if (numberOfBlocks < 2 || vtkSMPTools::GetEstimatedNumberOfThreads() < 2)
+  {
+    vtkMaterialInterfaceFilterWorkspace workspace;
+    workspace.Initialize(
+      this->FragmentVolumeWtdAvgs, this->FragmentMassWtdAvgs, this->FragmentSums);
+    for (int blockId = 0; blockId < numberOfBlocks; ++blockId)
+    {
 #ifdef vtkMaterialInterfaceFilterDEBUG
-  ostringstream progressMesg;
-  progressMesg << "vtkMaterialInterfaceFilter::ProcessBlock(" << blockId << ") , Material "
-               << this->MaterialId;
-  this->SetProgressText(progressMesg.str().c_str());
+      ostringstream progressMesg;
+      progressMesg << "vtkMaterialInterfaceFilter::ProcessBlock(" << blockId << ") , Material "
+                   << this->MaterialId;
+      this->SetProgressText(progressMesg.str().c_str());
 #endif
-  this->Progress += this->ProgressBlockInc;
+      this->Progress += this->ProgressBlockInc;
+      this->UpdateProgress(this->Progress);
+      // build fragments
+      this->ProcessBlock(&workspace, blockId);
+    }
+    this->CollectFragments(&workspace, 0);
+    return;
+  }
+
+  vtkLogScopeF(TRACE, "process %d blocks using %d threads", numberOfBlocks,
+    vtkSMPTools::GetEstimatedNumberOfThreads());
+  vector<vtkMaterialInterfaceFilterWorkspace> workspaces(numberOfBlocks);
+  vtkSMPTools::For(0, numberOfBlocks, 1, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType blockId = begin; blockId < end; ++blockId)
+    {
+      vtkMaterialInterfaceFilterWorkspace& workspace = workspaces[blockId];
+      workspace.Block = this->InputBlocks[blockId];
+      workspace.Initialize(
+        this->FragmentVolumeWtdAvgs, this->FragmentMassWtdAvgs, this->FragmentSums);
+      this->ProcessBlock(&workspace, static_cast<int>(blockId));
+    }
+  });
+  this->Progress += numberOfBlocks * this->ProgressBlockInc;
   this->UpdateProgress(this->Progress);
 
+  // Fragments of block i are numbered after those of blocks 0 to i-1.
+  vector<int> firstFragmentIds(numberOfBlocks, 0);
+  int numberOfFragments = 0;
+  for (int blockId = 0; blockId < numberOfBlocks; ++blockId)
+  {
+    firstFragmentIds[blockId] = numberOfFragments;
+    numberOfFragments += workspaces[blockId].GetNumberOfFragments();
+    this->CollectFragments(&workspaces[blockId], firstFragmentIds[blockId]);
+  }
+  vtkSMPTools::For(0, numberOfBlocks, 1, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType blockId = begin; blockId < end; ++blockId)
+    {
+      vtkMaterialInterfaceFilterBlock* block = this->InputBlocks[blockId];
+      const int offset = firstFragmentIds[blockId];
+      if (block == nullptr || offset == 0)
+      {
+        continue;
+      }
+      int ext[6];
+      block->GetCellExtent(ext);
+      const int numberOfCells =
+        (ext[1] - ext[0] + 1) * (ext[3] - ext[2] + 1) * (ext[5] - ext[4] + 1);
+      int* fragmentIds = block->GetFragmentIdPointer();
+      for (int ii = 0; ii < numberOfCells; ++ii)
+      {
+        if (fragmentIds[ii] >= 0)
+        {
+          fragmentIds[ii] += offset;
+        }
+      }
+    }
+  });
+
+  // Connect fragments across block boundaries. Ghost voxels that have not
+  // been visited yet take the id of the fragment that reaches them first, as
+  // they would have if the blocks had been processed one after the other.
+  // Ghost voxels are not integrated and do not generate faces.
+  vtkMaterialInterfaceFilterWorkspace connector;
+  vtkMaterialInterfaceFilterRingBuffer queue;
+  for (int blockId = 0; blockId < numberOfBlocks; ++blockId)
+  {
+    for (auto& neighbors : workspaces[blockId].BlockNeighbors)
+    {
+      vtkMaterialInterfaceFilterIterator& next = neighbors.second;
+      if (*(next.FragmentIdPointer) == -1)
+      {
+        connector.FragmentId = *(neighbors.first.FragmentIdPointer);
+        *(next.FragmentIdPointer) = connector.FragmentId;
+        queue.Push(&next);
+        this->ConnectFragment(&connector, &queue);
+      }
+      else
+      {
+        this->AddEquivalence(&connector, &neighbors.first, &next);
+      }
+    }
+  }
+  for (size_t ii = 0; ii < connector.Equivalences.size(); ii += 2)
+  {
+    this->EquivalenceSet->AddEquivalence(
+      connector.Equivalences[ii], connector.Equivalences[ii + 1]);
+  }
+}
+
+//----------------------------------------------------------------------------
+// Move the fragments found using a workspace to the arrays indexed by
+// fragment id. Fragment ids of the workspace are offset by firstFragmentId.
+void vtkMaterialInterfaceFilter::CollectFragments(
+  vtkMaterialInterfaceFilterWorkspace* ws, int firstFragmentId)
+{
+  const int numberOfFragments = ws->GetNumberOfFragments();
+  for (int localId = 0; localId < numberOfFragments; ++localId)
+  {
+    const int fragmentId = firstFragmentId + localId;
+    this->EquivalenceSet->AddEquivalence(fragmentId, fragmentId);
+    this->FragmentMeshes.push_back(ws->FragmentMeshes[localId]);
+    this->FragmentVolumes->InsertTuple1(fragmentId, ws->FragmentVolumes[localId]);
+    if (this->ClipWithPlane)
+    {
+      this->ClipDepthMaximums->InsertTuple1(fragmentId, ws->ClipDepthMaximums[localId]);
+      this->ClipDepthMinimums->InsertTuple1(fragmentId, ws->ClipDepthMinimums[localId]);
+    }
+    if (this->ComputeMoments)
+    {
+      this->FragmentMoments->InsertTuple(fragmentId, &ws->FragmentMoments[4 * localId]);
+    }
+    // for the weighted averages and summed scalars/vectors...
+    for (int i = 0; i < this->NVolumeWtdAvgs; ++i)
+    {
+      const int nComps = this->FragmentVolumeWtdAvgs[i]->GetNumberOfComponents();
+      this->FragmentVolumeWtdAvgs[i]->InsertTuple(
+        fragmentId, &ws->FragmentVolumeWtdAvgs[i][nComps * localId]);
+    }
+    for (int i = 0; i < this->NMassWtdAvgs; ++i)
+    {
+      const int nComps = this->FragmentMassWtdAvgs[i]->GetNumberOfComponents();
+      this->FragmentMassWtdAvgs[i]->InsertTuple(
+        fragmentId, &ws->FragmentMassWtdAvgs[i][nComps * localId]);
+    }
+    for (int i = 0; i < this->NToSum; ++i)
+    {
+      const int nComps = this->FragmentSums[i]->GetNumberOfComponents();
+      this->FragmentSums[i]->InsertTuple(fragmentId, &ws->FragmentSums[i][nComps * localId]);
+    }
+  }
+  // the meshes are now owned by the filter.
+  ws->FragmentMeshes.clear();
+
+  for (size_t ii = 0; ii < ws->Equivalences.size(); ii += 2)
+  {
+    this->EquivalenceSet->AddEquivalence(
+      firstFragmentId + ws->Equivalences[ii], firstFragmentId + ws->Equivalences[ii + 1]);
+  }
+}
+
+//----------------------------------------------------------------------------
+int vtkMaterialInterfaceFilter::ProcessBlock(vtkMaterialInterfaceFilterWorkspace* ws, int blockId)
+{
   vtkMaterialInterfaceFilterBlock* block = this->InputBlocks[blockId];
   if (block == nullptr)
   {
@@ -3672,65 +4218,14 @@ int vtkMaterialInterfaceFilter::ProcessBlock(int blockId)
         if (*(xIterator->FragmentIdPointer) == -1 &&
           *(xIterator->VolumeFractionPointer) > this->scaledMaterialFractionThreshold)
         { // We have a new fragment.
-          this->CurrentFragmentMesh = this->NewFragmentMesh();
-          this->EquivalenceSet->AddEquivalence(this->FragmentId, this->FragmentId);
+          ws->CurrentFragmentMesh = this->NewFragmentMesh();
           // We have to mark every voxel we push on the queue.
-          *(xIterator->FragmentIdPointer) = this->FragmentId;
+          *(xIterator->FragmentIdPointer) = ws->FragmentId;
           // There should be no need to clear the queue.
           queue->Push(xIterator);
-          this->ConnectFragment(queue);
-          // save the current fragment mesh
-          // the id is implicit given by its position in the vector, but only
-          // until fragments are resolved. After resolution we add addributes such
-          // as id, volume, summations averages, etc..
-          this->CurrentFragmentMesh->Squeeze();
-          this->FragmentMeshes.push_back(this->CurrentFragmentMesh);
-          // Save the volume from the last fragment.
-          this->FragmentVolumes->InsertTuple1(this->FragmentId, this->FragmentVolume);
-          if (this->ClipWithPlane)
-          {
-            this->ClipDepthMaximums->InsertTuple1(this->FragmentId, this->ClipDepthMax);
-            this->ClipDepthMinimums->InsertTuple1(this->FragmentId, this->ClipDepthMin);
-          }
-          // clear the volume accumulator
-          this->FragmentVolume = 0.0;
-          this->ClipDepthMax = 0.0;
-          this->ClipDepthMin = VTK_FLOAT_MAX;
-          if (this->ComputeMoments)
-          {
-            // Save the moments from the last fragment
-            this->FragmentMoments->InsertTuple(this->FragmentId, &this->FragmentMoment[0]);
-            // clear the moment accumulator
-            FillVector(this->FragmentMoment, 0.0);
-          }
-          // for the volume weighted averaged scalars/vectors...
-          for (int i = 0; i < this->NVolumeWtdAvgs; ++i)
-          {
-            // update the integrated value, independent of ncomps
-            this->FragmentVolumeWtdAvgs[i]->InsertTuple(
-              this->FragmentId, &this->FragmentVolumeWtdAvg[i][0]);
-            // clear the accumulator
-            FillVector(this->FragmentVolumeWtdAvg[i], 0.0);
-          }
-          // for the mass weighted averaged scalars/vectors...
-          for (int i = 0; i < this->NMassWtdAvgs; ++i)
-          {
-            // update the integrated value, independent of ncomps
-            this->FragmentMassWtdAvgs[i]->InsertTuple(
-              this->FragmentId, &this->FragmentMassWtdAvg[i][0]);
-            // clear the accumulator
-            FillVector(this->FragmentMassWtdAvg[i], 0.0);
-          }
-          // for the summed scalars/vectors...
-          for (int i = 0; i < this->NToSum; ++i)
-          {
-            // update the integrated value, independent of ncomps
-            this->FragmentSums[i]->InsertTuple(this->FragmentId, &this->FragmentSum[i][0]);
-            // clear the accumulator
-            FillVector(this->FragmentSum[i], 0.0);
-          }
-          // Move to next fragment.
-          ++this->FragmentId;
+          this->ConnectFragment(ws, queue);
+          // save the current fragment and move to the next one.
+          ws->SaveFragment(this->ClipWithPlane != 0, this->ComputeMoments);
         }
         xIterator->FlatIndex += cellIncs[0]; // 1/ncomp
         xIterator->VolumeFractionPointer += cellIncs[0];
@@ -4118,8 +4613,9 @@ int vtkMaterialInterfaceFilter::ComputeDisplacementFactors(
 // It will be modified with the sub voxel displacement.
 // The return value indicates that an edge may be non manifold.
 // It returns the y or z axis index of the edge that may be non manifold.
-int vtkMaterialInterfaceFilter::SubVoxelPositionCorner(double* point,
-  vtkMaterialInterfaceFilterIterator* pointNeighborIterators[8], int rootNeighborIdx, int faceAxis)
+int vtkMaterialInterfaceFilter::SubVoxelPositionCorner(vtkMaterialInterfaceFilterWorkspace* ws,
+  double* point, vtkMaterialInterfaceFilterIterator* pointNeighborIterators[8], int rootNeighborIdx,
+  int faceAxis)
 {
   int retVal;
 
@@ -4167,8 +4663,8 @@ int vtkMaterialInterfaceFilter::SubVoxelPositionCorner(double* point,
     projection = (point[0] - this->ClipCenter[0]) * this->ClipPlaneNormal[0];
     projection += (point[1] - this->ClipCenter[1]) * this->ClipPlaneNormal[1];
     projection += (point[2] - this->ClipCenter[2]) * this->ClipPlaneNormal[2];
-    this->ClipDepthMax = std::max(this->ClipDepthMax, projection);
-    this->ClipDepthMin = std::min(this->ClipDepthMin, projection);
+    ws->ClipDepthMax = std::max(ws->ClipDepthMax, projection);
+    ws->ClipDepthMin = std::min(ws->ClipDepthMin, projection);
   }
 
   return retVal;
@@ -4185,8 +4681,9 @@ int vtkMaterialInterfaceFilter::SubVoxelPositionCorner(double* point,
 // Now to fix cracks.  If neighbors are higher level,
 // I need to have more than 4 points for a face.
 // I am only going to support transitions of 1 level.
-void vtkMaterialInterfaceFilter::CreateFace(vtkMaterialInterfaceFilterIterator* in,
-  vtkMaterialInterfaceFilterIterator* out, int axis, int outMaxFlag)
+void vtkMaterialInterfaceFilter::CreateFace(vtkMaterialInterfaceFilterWorkspace* ws,
+  vtkMaterialInterfaceFilterIterator* in, vtkMaterialInterfaceFilterIterator* out, int axis,
+  int outMaxFlag)
 {
   if (in->Block == nullptr || in->Block->GetGhostFlag())
   {
@@ -4209,8 +4706,8 @@ void vtkMaterialInterfaceFilter::CreateFace(vtkMaterialInterfaceFilterIterator*
   // Add points to the output.  Create separate points for each triangle.
   // We can worry about merging points later.
   vtkMaterialInterfaceFilterIterator* cornerNeighbors[8];
-  vtkPoints* points = this->CurrentFragmentMesh->GetPoints(); // TODO for performance store?
-  vtkCellArray* polys = this->CurrentFragmentMesh->GetPolys();
+  vtkPoints* points = ws->CurrentFragmentMesh->GetPoints(); // TODO for performance store?
+  vtkCellArray* polys = ws->CurrentFragmentMesh->GetPolys();
   vtkIdType quadCornerIds[4];
   vtkIdType quadMidIds[4];
   vtkIdType triPtIds[3];
@@ -4221,10 +4718,10 @@ void vtkMaterialInterfaceFilter::CreateFace(vtkMaterialInterfaceFilterIterator*
 
   // Compute the corner and edge points (before subpixel positioning).
   // Store the results in ivars.
-  this->ComputeFacePoints(in, out, axis, outMaxFlag);
+  this->ComputeFacePoints(ws, in, out, axis, outMaxFlag);
   // Find the neighbor iterators.
   // Store the results in ivars.
-  this->ComputeFaceNeighbors(in, out, axis, outMaxFlag);
+  this->ComputeFaceNeighbors(ws, in, out, axis, outMaxFlag);
 
   // A word about indexing:
   // face neighbors 2x4x4 indexed face normal axis first, axis1, then axis2.
@@ -4259,55 +4756,55 @@ void vtkMaterialInterfaceFilter::CreateFace(vtkMaterialInterfaceFilterIterator*
   // to perform connectivity on the 2x2x2 point neighbors.
   int inNeighborIdx;
 
-  cornerNeighbors[i0] = &(this->FaceNeighbors[0]);
-  cornerNeighbors[i1] = &(this->FaceNeighbors[1]);
-  cornerNeighbors[i2] = &(this->FaceNeighbors[2]);
-  cornerNeighbors[i3] = &(this->FaceNeighbors[3]);
-  cornerNeighbors[i4] = &(this->FaceNeighbors[8]);
-  cornerNeighbors[i5] = &(this->FaceNeighbors[9]);
-  cornerNeighbors[i6] = &(this->FaceNeighbors[10]);
-  cornerNeighbors[i7] = &(this->FaceNeighbors[11]);
+  cornerNeighbors[i0] = &(ws->FaceNeighbors[0]);
+  cornerNeighbors[i1] = &(ws->FaceNeighbors[1]);
+  cornerNeighbors[i2] = &(ws->FaceNeighbors[2]);
+  cornerNeighbors[i3] = &(ws->FaceNeighbors[3]);
+  cornerNeighbors[i4] = &(ws->FaceNeighbors[8]);
+  cornerNeighbors[i5] = &(ws->FaceNeighbors[9]);
+  cornerNeighbors[i6] = &(ws->FaceNeighbors[10]);
+  cornerNeighbors[i7] = &(ws->FaceNeighbors[11]);
   inNeighborIdx = outMaxFlag ? i6 : i7; // Face neighbor 10 or 11
   manifoldIssue[0] =
-    this->SubVoxelPositionCorner(this->FaceCornerPoints, cornerNeighbors, inNeighborIdx, axis);
+    this->SubVoxelPositionCorner(ws, ws->FaceCornerPoints, cornerNeighbors, inNeighborIdx, axis);
   // 1 =>
-  quadCornerIds[0] = points->InsertNextPoint(this->FaceCornerPoints);
-  cornerNeighbors[i0] = &(this->FaceNeighbors[4]);
-  cornerNeighbors[i1] = &(this->FaceNeighbors[5]);
-  cornerNeighbors[i2] = &(this->FaceNeighbors[6]);
-  cornerNeighbors[i3] = &(this->FaceNeighbors[7]);
-  cornerNeighbors[i4] = &(this->FaceNeighbors[12]);
-  cornerNeighbors[i5] = &(this->FaceNeighbors[13]);
-  cornerNeighbors[i6] = &(this->FaceNeighbors[14]);
-  cornerNeighbors[i7] = &(this->FaceNeighbors[15]);
+  quadCornerIds[0] = points->InsertNextPoint(ws->FaceCornerPoints);
+  cornerNeighbors[i0] = &(ws->FaceNeighbors[4]);
+  cornerNeighbors[i1] = &(ws->FaceNeighbors[5]);
+  cornerNeighbors[i2] = &(ws->FaceNeighbors[6]);
+  cornerNeighbors[i3] = &(ws->FaceNeighbors[7]);
+  cornerNeighbors[i4] = &(ws->FaceNeighbors[12]);
+  cornerNeighbors[i5] = &(ws->FaceNeighbors[13]);
+  cornerNeighbors[i6] = &(ws->FaceNeighbors[14]);
+  cornerNeighbors[i7] = &(ws->FaceNeighbors[15]);
   inNeighborIdx = outMaxFlag ? i4 : i5; // Face neighbor 12 or 13
-  manifoldIssue[1] =
-    this->SubVoxelPositionCorner(this->FaceCornerPoints + 3, cornerNeighbors, inNeighborIdx, axis);
-  quadCornerIds[1] = points->InsertNextPoint(this->FaceCornerPoints + 3);
-  cornerNeighbors[i0] = &(this->FaceNeighbors[16]);
-  cornerNeighbors[i1] = &(this->FaceNeighbors[17]);
-  cornerNeighbors[i2] = &(this->FaceNeighbors[18]);
-  cornerNeighbors[i3] = &(this->FaceNeighbors[19]);
-  cornerNeighbors[i4] = &(this->FaceNeighbors[24]);
-  cornerNeighbors[i5] = &(this->FaceNeighbors[25]);
-  cornerNeighbors[i6] = &(this->FaceNeighbors[26]);
-  cornerNeighbors[i7] = &(this->FaceNeighbors[27]);
+  manifoldIssue[1] = this->SubVoxelPositionCorner(
+    ws, ws->FaceCornerPoints + 3, cornerNeighbors, inNeighborIdx, axis);
+  quadCornerIds[1] = points->InsertNextPoint(ws->FaceCornerPoints + 3);
+  cornerNeighbors[i0] = &(ws->FaceNeighbors[16]);
+  cornerNeighbors[i1] = &(ws->FaceNeighbors[17]);
+  cornerNeighbors[i2] = &(ws->FaceNeighbors[18]);
+  cornerNeighbors[i3] = &(ws->FaceNeighbors[19]);
+  cornerNeighbors[i4] = &(ws->FaceNeighbors[24]);
+  cornerNeighbors[i5] = &(ws->FaceNeighbors[25]);
+  cornerNeighbors[i6] = &(ws->FaceNeighbors[26]);
+  cornerNeighbors[i7] = &(ws->FaceNeighbors[27]);
   inNeighborIdx = outMaxFlag ? i2 : i3; // Face neighbor 18 or 19
-  manifoldIssue[2] =
-    this->SubVoxelPositionCorner(this->FaceCornerPoints + 6, cornerNeighbors, inNeighborIdx, axis);
-  quadCornerIds[2] = points->InsertNextPoint(this->FaceCornerPoints + 6);
-  cornerNeighbors[i0] = &(this->FaceNeighbors[20]);
-  cornerNeighbors[i1] = &(this->FaceNeighbors[21]);
-  cornerNeighbors[i2] = &(this->FaceNeighbors[22]);
-  cornerNeighbors[i3] = &(this->FaceNeighbors[23]);
-  cornerNeighbors[i4] = &(this->FaceNeighbors[28]);
-  cornerNeighbors[i5] = &(this->FaceNeighbors[29]);
-  cornerNeighbors[i6] = &(this->FaceNeighbors[30]);
-  cornerNeighbors[i7] = &(this->FaceNeighbors[31]);
+  manifoldIssue[2] = this->SubVoxelPositionCorner(
+    ws, ws->FaceCornerPoints + 6, cornerNeighbors, inNeighborIdx, axis);
+  quadCornerIds[2] = points->InsertNextPoint(ws->FaceCornerPoints + 6);
+  cornerNeighbors[i0] = &(ws->FaceNeighbors[20]);
+  cornerNeighbors[i1] = &(ws->FaceNeighbors[21]);
+  cornerNeighbors[i2] = &(ws->FaceNeighbors[22]);
+  cornerNeighbors[i3] = &(ws->FaceNeighbors[23]);
+  cornerNeighbors[i4] = &(ws->FaceNeighbors[28]);
+  cornerNeighbors[i5] = &(ws->FaceNeighbors[29]);
+  cornerNeighbors[i6] = &(ws->FaceNeighbors[30]);
+  cornerNeighbors[i7] = &(ws->FaceNeighbors[31]);
   inNeighborIdx = outMaxFlag ? i0 : i1; // Face neighbor 20 or 21
-  manifoldIssue[3] =
-    this->SubVoxelPositionCorner(this->FaceCornerPoints + 9, cornerNeighbors, inNeighborIdx, axis);
-  quadCornerIds[3] = points->InsertNextPoint(this->FaceCornerPoints + 9);
+  manifoldIssue[3] = this->SubVoxelPositionCorner(
+    ws, ws->FaceCornerPoints + 9, cornerNeighbors, inNeighborIdx, axis);
+  quadCornerIds[3] = points->InsertNextPoint(ws->FaceCornerPoints + 9);
 
   // If both corners of an edge have an issue, the we need an extra
   // point on the edge to generate a hole.
@@ -4320,93 +4817,93 @@ void vtkMaterialInterfaceFilter::CreateFace(vtkMaterialInterfaceFilterIterator*
   if (manifoldIssue[0] != 0 && manifoldIssue[1] != 0 && tmp[manifoldIssue[0]] == 1 &&
     tmp[manifoldIssue[1]] == 1)
   {
-    this->FaceEdgeFlags[0] = 1;
+    ws->FaceEdgeFlags[0] = 1;
   }
 
   if (manifoldIssue[0] != 0 && manifoldIssue[2] != 0 && tmp[manifoldIssue[0]] == 2 &&
     tmp[manifoldIssue[2]] == 2)
   {
-    this->FaceEdgeFlags[1] = 1;
+    ws->FaceEdgeFlags[1] = 1;
   }
   if (manifoldIssue[1] != 0 && manifoldIssue[3] != 0 && tmp[manifoldIssue[1]] == 2 &&
     tmp[manifoldIssue[3]] == 2)
   {
-    this->FaceEdgeFlags[2] = 1;
+    ws->FaceEdgeFlags[2] = 1;
   }
   if (manifoldIssue[2] != 0 && manifoldIssue[3] && tmp[manifoldIssue[2]] == 1 &&
     tmp[manifoldIssue[3]] == 1)
   {
-    this->FaceEdgeFlags[3] = 1;
+    ws->FaceEdgeFlags[3] = 1;
   }
 
   // Now for the mid edge point if the neighbors on that side are smaller.
-  if (this->FaceEdgeFlags[0])
-  {
-    cornerNeighbors[i0] = &(this->FaceNeighbors[2]);
-    cornerNeighbors[i1] = &(this->FaceNeighbors[3]);
-    cornerNeighbors[i2] = &(this->FaceNeighbors[4]);
-    cornerNeighbors[i3] = &(this->FaceNeighbors[5]);
-    cornerNeighbors[i4] = &(this->FaceNeighbors[10]);
-    cornerNeighbors[i5] = &(this->FaceNeighbors[11]);
-    cornerNeighbors[i6] = &(this->FaceNeighbors[12]);
-    cornerNeighbors[i7] = &(this->FaceNeighbors[13]);
+  if (ws->FaceEdgeFlags[0])
+  {
+    cornerNeighbors[i0] = &(ws->FaceNeighbors[2]);
+    cornerNeighbors[i1] = &(ws->FaceNeighbors[3]);
+    cornerNeighbors[i2] = &(ws->FaceNeighbors[4]);
+    cornerNeighbors[i3] = &(ws->FaceNeighbors[5]);
+    cornerNeighbors[i4] = &(ws->FaceNeighbors[10]);
+    cornerNeighbors[i5] = &(ws->FaceNeighbors[11]);
+    cornerNeighbors[i6] = &(ws->FaceNeighbors[12]);
+    cornerNeighbors[i7] = &(ws->FaceNeighbors[13]);
     // Two choices here (10, 12) because they both are the same voxel.
     inNeighborIdx = outMaxFlag ? i4 : i5;
-    this->SubVoxelPositionCorner(this->FaceEdgePoints, cornerNeighbors, inNeighborIdx, axis);
-    quadMidIds[0] = points->InsertNextPoint(this->FaceEdgePoints);
-  }
-  if (this->FaceEdgeFlags[1])
-  {
-    cornerNeighbors[i0] = &(this->FaceNeighbors[8]);
-    cornerNeighbors[i1] = &(this->FaceNeighbors[9]);
-    cornerNeighbors[i2] = &(this->FaceNeighbors[10]);
-    cornerNeighbors[i3] = &(this->FaceNeighbors[11]);
-    cornerNeighbors[i4] = &(this->FaceNeighbors[16]);
-    cornerNeighbors[i5] = &(this->FaceNeighbors[17]);
-    cornerNeighbors[i6] = &(this->FaceNeighbors[18]);
-    cornerNeighbors[i7] = &(this->FaceNeighbors[19]);
+    this->SubVoxelPositionCorner(ws, ws->FaceEdgePoints, cornerNeighbors, inNeighborIdx, axis);
+    quadMidIds[0] = points->InsertNextPoint(ws->FaceEdgePoints);
+  }
+  if (ws->FaceEdgeFlags[1])
+  {
+    cornerNeighbors[i0] = &(ws->FaceNeighbors[8]);
+    cornerNeighbors[i1] = &(ws->FaceNeighbors[9]);
+    cornerNeighbors[i2] = &(ws->FaceNeighbors[10]);
+    cornerNeighbors[i3] = &(ws->FaceNeighbors[11]);
+    cornerNeighbors[i4] = &(ws->FaceNeighbors[16]);
+    cornerNeighbors[i5] = &(ws->FaceNeighbors[17]);
+    cornerNeighbors[i6] = &(ws->FaceNeighbors[18]);
+    cornerNeighbors[i7] = &(ws->FaceNeighbors[19]);
     // Two choices here (10, 18) because they both are the same voxel.
     inNeighborIdx = outMaxFlag ? i2 : i3;
-    this->SubVoxelPositionCorner(this->FaceEdgePoints + 3, cornerNeighbors, inNeighborIdx, axis);
-    quadMidIds[1] = points->InsertNextPoint(this->FaceEdgePoints + 3);
-  }
-  if (this->FaceEdgeFlags[2])
-  {
-    cornerNeighbors[i0] = &(this->FaceNeighbors[12]);
-    cornerNeighbors[i1] = &(this->FaceNeighbors[13]);
-    cornerNeighbors[i2] = &(this->FaceNeighbors[14]);
-    cornerNeighbors[i3] = &(this->FaceNeighbors[15]);
-    cornerNeighbors[i4] = &(this->FaceNeighbors[20]);
-    cornerNeighbors[i5] = &(this->FaceNeighbors[21]);
-    cornerNeighbors[i6] = &(this->FaceNeighbors[22]);
-    cornerNeighbors[i7] = &(this->FaceNeighbors[23]);
+    this->SubVoxelPositionCorner(ws, ws->FaceEdgePoints + 3, cornerNeighbors, inNeighborIdx, axis);
+    quadMidIds[1] = points->InsertNextPoint(ws->FaceEdgePoints + 3);
+  }
+  if (ws->FaceEdgeFlags[2])
+  {
+    cornerNeighbors[i0] = &(ws->FaceNeighbors[12]);
+    cornerNeighbors[i1] = &(ws->FaceNeighbors[13]);
+    cornerNeighbors[i2] = &(ws->FaceNeighbors[14]);
+    cornerNeighbors[i3] = &(ws->FaceNeighbors[15]);
+    cornerNeighbors[i4] = &(ws->FaceNeighbors[20]);
+    cornerNeighbors[i5] = &(ws->FaceNeighbors[21]);
+    cornerNeighbors[i6] = &(ws->FaceNeighbors[22]);
+    cornerNeighbors[i7] = &(ws->FaceNeighbors[23]);
     // Two choices here (12, 20) because they both are the same voxel.
     inNeighborIdx = outMaxFlag ? i0 : i1;
-    this->SubVoxelPositionCorner(this->FaceEdgePoints + 6, cornerNeighbors, inNeighborIdx, axis);
-    quadMidIds[2] = points->InsertNextPoint(this->FaceEdgePoints + 6);
-  }
-  if (this->FaceEdgeFlags[3])
-  {
-    cornerNeighbors[i0] = &(this->FaceNeighbors[18]);
-    cornerNeighbors[i1] = &(this->FaceNeighbors[19]);
-    cornerNeighbors[i2] = &(this->FaceNeighbors[20]);
-    cornerNeighbors[i3] = &(this->FaceNeighbors[21]);
-    cornerNeighbors[i4] = &(this->FaceNeighbors[26]);
-    cornerNeighbors[i5] = &(this->FaceNeighbors[27]);
-    cornerNeighbors[i6] = &(this->FaceNeighbors[28]);
-    cornerNeighbors[i7] = &(this->FaceNeighbors[29]);
+    this->SubVoxelPositionCorner(ws, ws->FaceEdgePoints + 6, cornerNeighbors, inNeighborIdx, axis);
+    quadMidIds[2] = points->InsertNextPoint(ws->FaceEdgePoints + 6);
+  }
+  if (ws->FaceEdgeFlags[3])
+  {
+    cornerNeighbors[i0] = &(ws->FaceNeighbors[18]);
+    cornerNeighbors[i1] = &(ws->FaceNeighbors[19]);
+    cornerNeighbors[i2] = &(ws->FaceNeighbors[20]);
+    cornerNeighbors[i3] = &(ws->FaceNeighbors[21]);
+    cornerNeighbors[i4] = &(ws->FaceNeighbors[26]);
+    cornerNeighbors[i5] = &(ws->FaceNeighbors[27]);
+    cornerNeighbors[i6] = &(ws->FaceNeighbors[28]);
+    cornerNeighbors[i7] = &(ws->FaceNeighbors[29]);
     // Two choices here (18, 20) because they both are the same voxel.
     inNeighborIdx = outMaxFlag ? i0 : i1;
-    this->SubVoxelPositionCorner(this->FaceEdgePoints + 9, cornerNeighbors, inNeighborIdx, axis);
-    quadMidIds[3] = points->InsertNextPoint(this->FaceEdgePoints + 9);
+    this->SubVoxelPositionCorner(ws, ws->FaceEdgePoints + 9, cornerNeighbors, inNeighborIdx, axis);
+    quadMidIds[3] = points->InsertNextPoint(ws->FaceEdgePoints + 9);
   }
 
   // Now there are 9 possibilities
   // (10 if you count the two ways to triangulate the simple quad).
   // No edges, $ cases with one mid point, 4 cases with two mid points.
   // That is all because the face is always the smallest of the two in/out voxels.
-  int caseIdx = this->FaceEdgeFlags[0] | (this->FaceEdgeFlags[1] << 1) |
-    (this->FaceEdgeFlags[2] << 2) | (this->FaceEdgeFlags[3] << 3);
+  int caseIdx = ws->FaceEdgeFlags[0] | (ws->FaceEdgeFlags[1] << 1) |
+    (ws->FaceEdgeFlags[2] << 2) | (ws->FaceEdgeFlags[3] << 3);
 
   // c2 e3 c3
   // e1    e2
@@ -4552,10 +5049,10 @@ void vtkMaterialInterfaceFilter::CreateFace(vtkMaterialInterfaceFilterIterator*
       // This will help us decide which way to split up the quad into triangles.
       double d0011 = 0.0;
       double d0110 = 0.0;
-      double* pt00 = this->FaceCornerPoints;
-      double* pt01 = this->FaceCornerPoints + 3;
-      double* pt10 = this->FaceCornerPoints + 6;
-      double* pt11 = this->FaceCornerPoints + 9;
+      double* pt00 = ws->FaceCornerPoints;
+      double* pt01 = ws->FaceCornerPoints + 3;
+      double* pt10 = ws->FaceCornerPoints + 6;
+      double* pt11 = ws->FaceCornerPoints + 9;
       for (int ii = 0; ii < 3; ++ii)
       {
         double tmp2 = pt00[ii] - pt11[ii];
@@ -4605,7 +5102,7 @@ void vtkMaterialInterfaceFilter::CreateFace(vtkMaterialInterfaceFilterIterator*
 
     // fragment
     vtkDoubleArray* destArray =
-      dynamic_cast<vtkDoubleArray*>(this->CurrentFragmentMesh->GetCellData()->GetArray(i));
+      dynamic_cast<vtkDoubleArray*>(ws->CurrentFragmentMesh->GetCellData()->GetArray(i));
     for (vtkIdType ii = 0; ii < numTris; ++ii)
     {
       destArray->InsertNextTuple(&thisTup[0]);
@@ -4614,13 +5111,13 @@ void vtkMaterialInterfaceFilter::CreateFace(vtkMaterialInterfaceFilterIterator*
 // Cell data attributes for debugging.
 #ifdef vtkMaterialInterfaceFilterDEBUG
   vtkIntArray* levelArray =
-    dynamic_cast<vtkIntArray*>(this->CurrentFragmentMesh->GetCellData()->GetArray("Level"));
+    dynamic_cast<vtkIntArray*>(ws->CurrentFragmentMesh->GetCellData()->GetArray("Level"));
 
   vtkIntArray* blockIdArray =
-    dynamic_cast<vtkIntArray*>(this->CurrentFragmentMesh->GetCellData()->GetArray("BlockId"));
+    dynamic_cast<vtkIntArray*>(ws->CurrentFragmentMesh->GetCellData()->GetArray("BlockId"));
 
   vtkIntArray* procIdArray =
-    dynamic_cast<vtkIntArray*>(this->CurrentFragmentMesh->GetCellData()->GetArray("ProcId"));
+    dynamic_cast<vtkIntArray*>(ws->CurrentFragmentMesh->GetCellData()->GetArray("ProcId"));
 
   for (vtkIdType ii = 0; ii < numTris; ++ii)
   {
@@ -4634,8 +5131,9 @@ void vtkMaterialInterfaceFilter::CreateFace(vtkMaterialInterfaceFilterIterator*
 //----------------------------------------------------------------------------
 // Computes the face and edge middle points of the shared contact face
 // between the two iterators.
-void vtkMaterialInterfaceFilter::ComputeFacePoints(vtkMaterialInterfaceFilterIterator* in,
-  vtkMaterialInterfaceFilterIterator* out, int axis, int outMaxFlag)
+void vtkMaterialInterfaceFilter::ComputeFacePoints(vtkMaterialInterfaceFilterWorkspace* ws,
+  vtkMaterialInterfaceFilterIterator* in, vtkMaterialInterfaceFilterIterator* out, int axis,
+  int outMaxFlag)
 {
   vtkMaterialInterfaceFilterIterator* smaller;
   double* origin;
@@ -4675,41 +5173,42 @@ void vtkMaterialInterfaceFilter::ComputeFacePoints(vtkMaterialInterfaceFilterIte
   // 6 9
   // 0 3
   // First set them all to the origin.
-  this->FaceCornerPoints[0] = this->FaceCornerPoints[3] = this->FaceCornerPoints[6] =
-    this->FaceCornerPoints[9] = faceOrigin[0];
-  this->FaceCornerPoints[1] = this->FaceCornerPoints[4] = this->FaceCornerPoints[7] =
-    this->FaceCornerPoints[10] = faceOrigin[1];
-  this->FaceCornerPoints[2] = this->FaceCornerPoints[5] = this->FaceCornerPoints[8] =
-    this->FaceCornerPoints[11] = faceOrigin[2];
+  ws->FaceCornerPoints[0] = ws->FaceCornerPoints[3] = ws->FaceCornerPoints[6] =
+    ws->FaceCornerPoints[9] = faceOrigin[0];
+  ws->FaceCornerPoints[1] = ws->FaceCornerPoints[4] = ws->FaceCornerPoints[7] =
+    ws->FaceCornerPoints[10] = faceOrigin[1];
+  ws->FaceCornerPoints[2] = ws->FaceCornerPoints[5] = ws->FaceCornerPoints[8] =
+    ws->FaceCornerPoints[11] = faceOrigin[2];
   // Now offset them to the corners.
-  this->FaceCornerPoints[3 + axis1] += spacing[axis1];
-  this->FaceCornerPoints[9 + axis1] += spacing[axis1];
-  this->FaceCornerPoints[6 + axis2] += spacing[axis2];
-  this->FaceCornerPoints[9 + axis2] += spacing[axis2];
+  ws->FaceCornerPoints[3 + axis1] += spacing[axis1];
+  ws->FaceCornerPoints[9 + axis1] += spacing[axis1];
+  ws->FaceCornerPoints[6 + axis2] += spacing[axis2];
+  ws->FaceCornerPoints[9 + axis2] += spacing[axis2];
 
   // Now do the same for the edge points
   //   3
   // 1   2
   //   0
   // First set them all to the origin.
-  this->FaceEdgePoints[0] = this->FaceEdgePoints[3] = this->FaceEdgePoints[6] =
-    this->FaceEdgePoints[9] = faceOrigin[0];
-  this->FaceEdgePoints[1] = this->FaceEdgePoints[4] = this->FaceEdgePoints[7] =
-    this->FaceEdgePoints[10] = faceOrigin[1];
-  this->FaceEdgePoints[2] = this->FaceEdgePoints[5] = this->FaceEdgePoints[8] =
-    this->FaceEdgePoints[11] = faceOrigin[2];
+  ws->FaceEdgePoints[0] = ws->FaceEdgePoints[3] = ws->FaceEdgePoints[6] =
+    ws->FaceEdgePoints[9] = faceOrigin[0];
+  ws->FaceEdgePoints[1] = ws->FaceEdgePoints[4] = ws->FaceEdgePoints[7] =
+    ws->FaceEdgePoints[10] = faceOrigin[1];
+  ws->FaceEdgePoints[2] = ws->FaceEdgePoints[5] = ws->FaceEdgePoints[8] =
+    ws->FaceEdgePoints[11] = faceOrigin[2];
   // Now offset the points to the middle of the edges.
-  this->FaceEdgePoints[axis1] += halfSpacing[axis1];
-  this->FaceEdgePoints[9 + axis1] += halfSpacing[axis1];
-  this->FaceEdgePoints[6 + axis1] += spacing[axis1];
-  this->FaceEdgePoints[3 + axis2] += halfSpacing[axis2];
-  this->FaceEdgePoints[6 + axis2] += halfSpacing[axis2];
-  this->FaceEdgePoints[9 + axis2] += spacing[axis2];
+  ws->FaceEdgePoints[axis1] += halfSpacing[axis1];
+  ws->FaceEdgePoints[9 + axis1] += halfSpacing[axis1];
+  ws->FaceEdgePoints[6 + axis1] += spacing[axis1];
+  ws->FaceEdgePoints[3 + axis2] += halfSpacing[axis2];
+  ws->FaceEdgePoints[6 + axis2] += halfSpacing[axis2];
+  ws->FaceEdgePoints[9 + axis2] += spacing[axis2];
 }
 
 //----------------------------------------------------------------------------
-void vtkMaterialInterfaceFilter::ComputeFaceNeighbors(vtkMaterialInterfaceFilterIterator* in,
-  vtkMaterialInterfaceFilterIterator* out, int axis, int outMaxFlag)
+void vtkMaterialInterfaceFilter::ComputeFaceNeighbors(vtkMaterialInterfaceFilterWorkspace* ws,
+  vtkMaterialInterfaceFilterIterator* in, vtkMaterialInterfaceFilterIterator* out, int axis,
+  int outMaxFlag)
 {
   int axis1 = (axis + 1) % 3;
   int axis2 = (axis + 2) % 3;
@@ -4756,17 +5255,17 @@ void vtkMaterialInterfaceFilter::ComputeFaceNeighbors(vtkMaterialInterfaceFilter
   // for subdivision.
   if (outMaxFlag)
   {
-    this->FaceNeighbors[10] = this->FaceNeighbors[12] = this->FaceNeighbors[18] =
-      this->FaceNeighbors[20] = *in;
-    this->FaceNeighbors[11] = this->FaceNeighbors[13] = this->FaceNeighbors[19] =
-      this->FaceNeighbors[21] = *out;
+    ws->FaceNeighbors[10] = ws->FaceNeighbors[12] = ws->FaceNeighbors[18] =
+      ws->FaceNeighbors[20] = *in;
+    ws->FaceNeighbors[11] = ws->FaceNeighbors[13] = ws->FaceNeighbors[19] =
+      ws->FaceNeighbors[21] = *out;
   }
   else
   {
-    this->FaceNeighbors[10] = this->FaceNeighbors[12] = this->FaceNeighbors[18] =
-      this->FaceNeighbors[20] = *out;
-    this->FaceNeighbors[11] = this->FaceNeighbors[13] = this->FaceNeighbors[19] =
-      this->FaceNeighbors[21] = *in;
+    ws->FaceNeighbors[10] = ws->FaceNeighbors[12] = ws->FaceNeighbors[18] =
+      ws->FaceNeighbors[20] = *out;
+    ws->FaceNeighbors[11] = ws->FaceNeighbors[13] = ws->FaceNeighbors[19] =
+      ws->FaceNeighbors[21] = *in;
   }
 
   // Ok, we have 24 neighbors to compute.
@@ -4776,91 +5275,91 @@ void vtkMaterialInterfaceFilter::ComputeFaceNeighbors(vtkMaterialInterfaceFilter
   // increments: 1, 2, 8
   // Start at the corner and march around the edges.
   faceIndex[axis2] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 3, this->FaceNeighbors + 11);
+  this->FindNeighbor(faceIndex, faceLevel, ws->FaceNeighbors + 3, ws->FaceNeighbors + 11);
   faceIndex[axis1] += 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 5, this->FaceNeighbors + 3);
+  this->FindNeighbor(faceIndex, faceLevel, ws->FaceNeighbors + 5, ws->FaceNeighbors + 3);
   faceIndex[axis1] += 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 7, this->FaceNeighbors + 5);
+  this->FindNeighbor(faceIndex, faceLevel, ws->FaceNeighbors + 7, ws->FaceNeighbors + 5);
   faceIndex[axis2] += 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 15, this->FaceNeighbors + 7);
+  this->FindNeighbor(faceIndex, faceLevel, ws->FaceNeighbors + 15, ws->FaceNeighbors + 7);
   faceIndex[axis2] += 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 23, this->FaceNeighbors + 15);
+  this->FindNeighbor(faceIndex, faceLevel, ws->FaceNeighbors + 23, ws->FaceNeighbors + 15);
   faceIndex[axis2] += 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 31, this->FaceNeighbors + 23);
+  this->FindNeighbor(faceIndex, faceLevel, ws->FaceNeighbors + 31, ws->FaceNeighbors + 23);
   faceIndex[axis1] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 29, this->FaceNeighbors + 31);
+  this->FindNeighbor(faceIndex, faceLevel, ws->FaceNeighbors + 29, ws->FaceNeighbors + 31);
   faceIndex[axis1] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 27, this->FaceNeighbors + 29);
+  this->FindNeighbor(faceIndex, faceLevel, ws->FaceNeighbors + 27, ws->FaceNeighbors + 29);
   faceIndex[axis1] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 25, this->FaceNeighbors + 27);
+  this->FindNeighbor(faceIndex, faceLevel, ws->FaceNeighbors + 25, ws->FaceNeighbors + 27);
   faceIndex[axis2] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 17, this->FaceNeighbors + 25);
+  this->FindNeighbor(faceIndex, faceLevel, ws->FaceNeighbors + 17, ws->FaceNeighbors + 25);
   faceIndex[axis2] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 9, this->FaceNeighbors + 17);
+  this->FindNeighbor(faceIndex, faceLevel, ws->FaceNeighbors + 9, ws->FaceNeighbors + 17);
   faceIndex[axis2] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 1, this->FaceNeighbors + 9);
+  this->FindNeighbor(faceIndex, faceLevel, ws->FaceNeighbors + 1, ws->FaceNeighbors + 9);
   // Now for the other side (min axis).
   faceIndex[axis] -= 1;  // Move to the other layer
   faceIndex[axis1] += 1; // Start below reference block.
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 2, this->FaceNeighbors + 10);
+  this->FindNeighbor(faceIndex, faceLevel, ws->FaceNeighbors + 2, ws->FaceNeighbors + 10);
   faceIndex[axis1] += 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 4, this->FaceNeighbors + 2);
+  this->FindNeighbor(faceIndex, faceLevel, ws->FaceNeighbors + 4, ws->FaceNeighbors + 2);
   faceIndex[axis1] += 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 6, this->FaceNeighbors + 4);
+  this->FindNeighbor(faceIndex, faceLevel, ws->FaceNeighbors + 6, ws->FaceNeighbors + 4);
   faceIndex[axis2] += 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 14, this->FaceNeighbors + 6);
+  this->FindNeighbor(faceIndex, faceLevel, ws->FaceNeighbors + 14, ws->FaceNeighbors + 6);
   faceIndex[axis2] += 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 22, this->FaceNeighbors + 14);
+  this->FindNeighbor(faceIndex, faceLevel, ws->FaceNeighbors + 22, ws->FaceNeighbors + 14);
   faceIndex[axis2] += 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 30, this->FaceNeighbors + 22);
+  this->FindNeighbor(faceIndex, faceLevel, ws->FaceNeighbors + 30, ws->FaceNeighbors + 22);
   faceIndex[axis1] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 28, this->FaceNeighbors + 30);
+  this->FindNeighbor(faceIndex, faceLevel, ws->FaceNeighbors + 28, ws->FaceNeighbors + 30);
   faceIndex[axis1] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 26, this->FaceNeighbors + 28);
+  this->FindNeighbor(faceIndex, faceLevel, ws->FaceNeighbors + 26, ws->FaceNeighbors + 28);
   faceIndex[axis1] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 24, this->FaceNeighbors + 26);
+  this->FindNeighbor(faceIndex, faceLevel, ws->FaceNeighbors + 24, ws->FaceNeighbors + 26);
   faceIndex[axis2] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 16, this->FaceNeighbors + 24);
+  this->FindNeighbor(faceIndex, faceLevel, ws->FaceNeighbors + 16, ws->FaceNeighbors + 24);
   faceIndex[axis2] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 8, this->FaceNeighbors + 16);
+  this->FindNeighbor(faceIndex, faceLevel, ws->FaceNeighbors + 8, ws->FaceNeighbors + 16);
   faceIndex[axis2] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 0, this->FaceNeighbors + 8);
+  this->FindNeighbor(faceIndex, faceLevel, ws->FaceNeighbors + 0, ws->FaceNeighbors + 8);
 
   // Split edges if neighbors are a higher level than face.
   --faceLevel;
-  this->FaceEdgeFlags[0] = 0;
+  ws->FaceEdgeFlags[0] = 0;
   // Checking equivalences (this->FaceNeighbor[2] != this->FaceNeighbor[4])
   // May be faster and work fine.
-  if (this->FaceNeighbors[2].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[3].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[4].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[5].Block->GetLevel() > faceLevel)
+  if (ws->FaceNeighbors[2].Block->GetLevel() > faceLevel ||
+    ws->FaceNeighbors[3].Block->GetLevel() > faceLevel ||
+    ws->FaceNeighbors[4].Block->GetLevel() > faceLevel ||
+    ws->FaceNeighbors[5].Block->GetLevel() > faceLevel)
   {
-    this->FaceEdgeFlags[0] = 1;
+    ws->FaceEdgeFlags[0] = 1;
   }
-  this->FaceEdgeFlags[1] = 0;
-  if (this->FaceNeighbors[8].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[9].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[16].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[17].Block->GetLevel() > faceLevel)
+  ws->FaceEdgeFlags[1] = 0;
+  if (ws->FaceNeighbors[8].Block->GetLevel() > faceLevel ||
+    ws->FaceNeighbors[9].Block->GetLevel() > faceLevel ||
+    ws->FaceNeighbors[16].Block->GetLevel() > faceLevel ||
+    ws->FaceNeighbors[17].Block->GetLevel() > faceLevel)
   {
-    this->FaceEdgeFlags[1] = 1;
+    ws->FaceEdgeFlags[1] = 1;
   }
-  this->FaceEdgeFlags[2] = 0;
-  if (this->FaceNeighbors[14].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[15].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[22].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[23].Block->GetLevel() > faceLevel)
+  ws->FaceEdgeFlags[2] = 0;
+  if (ws->FaceNeighbors[14].Block->GetLevel() > faceLevel ||
+    ws->FaceNeighbors[15].Block->GetLevel() > faceLevel ||
+    ws->FaceNeighbors[22].Block->GetLevel() > faceLevel ||
+    ws->FaceNeighbors[23].Block->GetLevel() > faceLevel)
   {
-    this->FaceEdgeFlags[2] = 1;
+    ws->FaceEdgeFlags[2] = 1;
   }
-  this->FaceEdgeFlags[3] = 0;
-  if (this->FaceNeighbors[26].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[27].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[28].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[29].Block->GetLevel() > faceLevel)
+  ws->FaceEdgeFlags[3] = 0;
+  if (ws->FaceNeighbors[26].Block->GetLevel() > faceLevel ||
+    ws->FaceNeighbors[27].Block->GetLevel() > faceLevel ||
+    ws->FaceNeighbors[28].Block->GetLevel() > faceLevel ||
+    ws->FaceNeighbors[29].Block->GetLevel() > faceLevel)
   {
-    this->FaceEdgeFlags[3] = 1;
+    ws->FaceEdgeFlags[3] = 1;
   }
 }
 
@@ -5323,7 +5822,8 @@ inline int vtkMaterialInterfaceFilter::AccumulateMoments(double* moments, // =(M
 // This integrates quantities at the same time.
 // This is called only when the voxel is part of a fragment.
 // I tried to create a generic API to replace the hard coded conditional ifs.
-void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingBuffer* queue)
+void vtkMaterialInterfaceFilter::ConnectFragment(
+  vtkMaterialInterfaceFilterWorkspace* ws, vtkMaterialInterfaceFilterRingBuffer* queue)
 {
   while (queue->GetSize())
   {
@@ -5343,14 +5843,14 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
       double voxelVolumeFrac =
         dX[0] * dX[1] * dX[2] * (double)(*(iterator.VolumeFractionPointer)) / 255.0;
 #endif
-      this->FragmentVolume += voxelVolumeFrac;
+      ws->FragmentVolume += voxelVolumeFrac;
       // The clip depth is accumulated in SubvoxelPositionCorner.
       // accumulate volume weighted average
       for (int i = 0; i < this->NVolumeWtdAvgs; ++i)
       {
         vtkDataArray* arrayToIntegrate = iterator.Block->GetVolumeWtdAvgArray(i);
         int nComps = arrayToIntegrate->GetNumberOfComponents();
-        this->Accumulate(&this->FragmentVolumeWtdAvg[i][0], arrayToIntegrate, nComps,
+        this->Accumulate(&ws->FragmentVolumeWtdAvg[i][0], arrayToIntegrate, nComps,
           iterator.FlatIndex, voxelVolumeFrac);
       }
       // accumulate mass weighted average
@@ -5362,7 +5862,7 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
         const double* X0 = iterator.Block->GetOrigin();
         double X[3] = { X0[0] + dX[0] * (0.5 + iterator.Index[0]),
           X0[1] + dX[1] * (0.5 + iterator.Index[1]), X0[2] + dX[2] * (0.5 + iterator.Index[2]) };
-        this->AccumulateMoments(&this->FragmentMoment[0], massArray, iterator.FlatIndex, X);
+        this->AccumulateMoments(&ws->FragmentMoment[0], massArray, iterator.FlatIndex, X);
         // mass weighted averages
         double voxelMass;
         massArray->GetTuple(iterator.FlatIndex, &voxelMass);
@@ -5370,7 +5870,7 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
         {
           vtkDataArray* arrayToIntegrate = iterator.Block->GetMassWtdAvgArray(i);
           int nComps = arrayToIntegrate->GetNumberOfComponents();
-          this->Accumulate(&this->FragmentMassWtdAvg[i][0], arrayToIntegrate, nComps,
+          this->Accumulate(&ws->FragmentMassWtdAvg[i][0], arrayToIntegrate, nComps,
             iterator.FlatIndex, voxelMass);
         }
       }
@@ -5380,7 +5880,7 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
         vtkDataArray* arrayToIntegrate = iterator.Block->GetArrayToSum(i);
         int nComps = arrayToIntegrate->GetNumberOfComponents();
         this->Accumulate(
-          &this->FragmentSum[i][0], arrayToIntegrate, nComps, iterator.FlatIndex, 1.0);
+          &ws->FragmentSum[i][0], arrayToIntegrate, nComps, iterator.FlatIndex, 1.0);
       }
     }
 
@@ -5406,17 +5906,21 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
         next.VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold)
       {
         // Neighbor is outside of fragment.  Make a face.
-        this->CreateFace(&iterator, &next, ii, 0);
+        this->CreateFace(ws, &iterator, &next, ii, 0);
+      }
+      else if (ws->Block && next.Block != ws->Block)
+      { // Neighbor is in another block. Connect it once all blocks are processed.
+        ws->BlockNeighbors.emplace_back(iterator, next);
       }
       else if (next.FragmentIdPointer[0] == -1)
       { // We have not visited this neighbor yet. Mark the voxel and recurse.
-        *(next.FragmentIdPointer) = this->FragmentId;
+        *(next.FragmentIdPointer) = ws->FragmentId;
         queue->Push(&next);
       }
       else
       { // The last case is that we have already visited this voxel and it
         // is in the same fragment.
-        this->AddEquivalence(&iterator, &next);
+        this->AddEquivalence(ws, &iterator, &next);
       }
 
       // Handle the case when the new iterator is a higher level.
@@ -5437,17 +5941,21 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
             next2.VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold)
           {
             // Neighbor is outside of fragment.  Make a face.
-            this->CreateFace(&iterator, &next2, ii, 0);
+            this->CreateFace(ws, &iterator, &next2, ii, 0);
+          }
+          else if (ws->Block && next2.Block != ws->Block)
+          { // Neighbor is in another block. Connect it once all blocks are processed.
+            ws->BlockNeighbors.emplace_back(iterator, next2);
           }
           else if (next2.FragmentIdPointer[0] == -1)
           { // We have not visited this neighbor yet. Mark the voxel and recurse.
-            *(next2.FragmentIdPointer) = this->FragmentId;
+            *(next2.FragmentIdPointer) = ws->FragmentId;
             queue->Push(&next2);
           }
           else
           { // The last case is that we have already visited this voxel and it
             // is in the same fragment.
-            this->AddEquivalence(&next2, &next);
+            this->AddEquivalence(ws, &next2, &next);
           }
         }
         // Take the fist iterator found and move +Z
@@ -5458,17 +5966,21 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
             next2.VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold)
           {
             // Neighbor is outside of fragment.  Make a face.
-            this->CreateFace(&iterator, &next2, ii, 0);
+            this->CreateFace(ws, &iterator, &next2, ii, 0);
+          }
+          else if (ws->Block && next2.Block != ws->Block)
+          { // Neighbor is in another block. Connect it once all blocks are processed.
+            ws->BlockNeighbors.emplace_back(iterator, next2);
           }
           else if (next2.FragmentIdPointer[0] == -1)
           { // We have not visited this neighbor yet. Mark the voxel and recurse.
-            *(next2.FragmentIdPointer) = this->FragmentId;
+            *(next2.FragmentIdPointer) = ws->FragmentId;
             queue->Push(&next2);
           }
           else
           { // The last case is that we have already visited this voxel and it
             // is in the same fragment.
-            this->AddEquivalence(&next2, &next);
+            this->AddEquivalence(ws, &next2, &next);
           }
         }
         // To get the +Y+Z start with the +Z iterator and move +Y put results in "next"
@@ -5479,17 +5991,21 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
             next.VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold)
           {
             // Neighbor is outside of fragment.  Make a face.
-            this->CreateFace(&iterator, &next, ii, 0);
+            this->CreateFace(ws, &iterator, &next, ii, 0);
+          }
+          else if (ws->Block && next.Block != ws->Block)
+          { // Neighbor is in another block. Connect it once all blocks are processed.
+            ws->BlockNeighbors.emplace_back(iterator, next);
           }
           else if (next.FragmentIdPointer[0] == -1)
           { // We have not visited this neighbor yet. Mark the voxel and recurse.
-            *(next.FragmentIdPointer) = this->FragmentId;
+            *(next.FragmentIdPointer) = ws->FragmentId;
             queue->Push(&next);
           }
           else
           { // The last case is that we have already visited this voxel and it
             // is in the same fragment.
-            this->AddEquivalence(&next2, &next);
+            this->AddEquivalence(ws, &next2, &next);
           }
         }
       }
@@ -5499,17 +6015,21 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
       if (next.VolumeFractionPointer == nullptr ||
         next.VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold)
       { // Neighbor is outside of fragment.  Make a face.
-        this->CreateFace(&iterator, &next, ii, 1);
+        this->CreateFace(ws, &iterator, &next, ii, 1);
+      }
+      else if (ws->Block && next.Block != ws->Block)
+      { // Neighbor is in another block. Connect it once all blocks are processed.
+        ws->BlockNeighbors.emplace_back(iterator, next);
       }
       else if (next.FragmentIdPointer[0] == -1)
       { // We have not visited this neighbor yet. Mark the voxel and recurse.
-        *(next.FragmentIdPointer) = this->FragmentId;
+        *(next.FragmentIdPointer) = ws->FragmentId;
         queue->Push(&next);
       }
       else
       { // The last case is that we have already visited this voxel and it
         // is in the same fragment.
-        this->AddEquivalence(&iterator, &next);
+        this->AddEquivalence(ws, &iterator, &next);
       }
       // Same case as above with the same logic to visit the
       // four smaller cells that touch this face of the current block.
@@ -5525,17 +6045,21 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
             next2.VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold)
           {
             // Neighbor is outside of fragment.  Make a face.
-            this->CreateFace(&iterator, &next2, ii, 1);
+            this->CreateFace(ws, &iterator, &next2, ii, 1);
+          }
+          else if (ws->Block && next2.Block != ws->Block)
+          { // Neighbor is in another block. Connect it once all blocks are processed.
+            ws->BlockNeighbors.emplace_back(iterator, next2);
           }
           else if (next2.FragmentIdPointer[0] == -1)
           { // We have not visited this neighbor yet. Mark the voxel and recurse.
-            *(next2.FragmentIdPointer) = this->FragmentId;
+            *(next2.FragmentIdPointer) = ws->FragmentId;
             queue->Push(&next2);
           }
           else
           { // The last case is that we have already visited this voxel and it
             // is in the same fragment.
-            this->AddEquivalence(&next2, &next);
+            this->AddEquivalence(ws, &next2, &next);
           }
         }
         // Take the fist iterator found and move +Z
@@ -5546,17 +6070,21 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
             next2.VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold)
           {
             // Neighbor is outside of fragment.  Make a face.
-            this->CreateFace(&iterator, &next2, ii, 1);
+            this->CreateFace(ws, &iterator, &next2, ii, 1);
+          }
+          else if (ws->Block && next2.Block != ws->Block)
+          { // Neighbor is in another block. Connect it once all blocks are processed.
+            ws->BlockNeighbors.emplace_back(iterator, next2);
           }
           else if (next2.FragmentIdPointer[0] == -1)
           { // We have not visited this neighbor yet. Mark the voxel and recurse.
-            *(next2.FragmentIdPointer) = this->FragmentId;
+            *(next2.FragmentIdPointer) = ws->FragmentId;
             queue->Push(&next2);
           }
           else
           { // The last case is that we have already visited this voxel and it
             // is in the same fragment.
-            this->AddEquivalence(&next2, &next);
+            this->AddEquivalence(ws, &next2, &next);
           }
         }
         // To get the +Y+Z start with the +Z iterator and move +Y put results in "next"
@@ -5567,17 +6095,21 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
             next.VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold)
           {
             // Neighbor is outside of fragment.  Make a face.
-            this->CreateFace(&iterator, &next, ii, 1);
+            this->CreateFace(ws, &iterator, &next, ii, 1);
+          }
+          else if (ws->Block && next.Block != ws->Block)
+          { // Neighbor is in another block. Connect it once all blocks are processed.
+            ws->BlockNeighbors.emplace_back(iterator, next);
           }
           else if (next.FragmentIdPointer[0] == -1)
           { // We have not visited this neighbor yet. Mark the voxel and recurse.
-            *(next.FragmentIdPointer) = this->FragmentId;
+            *(next.FragmentIdPointer) = ws->FragmentId;
             queue->Push(&next);
           }
           else
           { // The last case is that we have already visited this voxel and it
             // is in the same fragment.
-            this->AddEquivalence(&next2, &next);
+            this->AddEquivalence(ws, &next2, &next);
           }
         }
       }
@@ -6180,7 +6712,7 @@ void vtkMaterialInterfaceFilter::SetUpperLoadingBound(int nPolys)
 // Chains can leave orphans, loops break when two nodes in the loop are
 // equated a second time.
 // Lets try a directed tree
-void vtkMaterialInterfaceFilter::AddEquivalence(
+void vtkMaterialInterfaceFilter::AddEquivalence(vtkMaterialInterfaceFilterWorkspace* ws,
   vtkMaterialInterfaceFilterIterator* neighbor1, vtkMaterialInterfaceFilterIterator* neighbor2)
 {
   int id1 = *(neighbor1->FragmentIdPointer);
@@ -6188,7 +6720,8 @@ void vtkMaterialInterfaceFilter::AddEquivalence(
 
   if (id1 != id2 && id1 != -1 && id2 != -1)
   {
-    this->EquivalenceSet->AddEquivalence(id1, id2);
+    ws->Equivalences.push_back(id1);
+    ws->Equivalences.push_back(id2);
   }
 }
 
@@ -7299,719 +7832,379 @@ int vtkMaterialInterfaceFilter::GatherGeometricAttributes(const int recipientPro
 }
 
 //----------------------------------------------------------------------------
-// Collect all of  integrated attribute arrays from all
-// other processes. Need to pass in containers that are
-// initialized with empty arrays.
-//
-// Buffers are allocated. when unpacked the attribute arrays
-// are not copied from the buffer rather they point to
-// the appropriate location in the buffer. The buffers should
-// be deleted by caller after arrays are not needed.
-//
-// return 0 on error.
-int vtkMaterialInterfaceFilter::CollectIntegratedAttributes(
-  vector<vtkMaterialInterfaceCommBuffer>& buffers, vector<vtkDoubleArray*>& volumes,
-  vector<vtkDoubleArray*>& clipDepthMaxs, vector<vtkDoubleArray*>& clipDepthMins,
-  vector<vtkDoubleArray*>& moments, vector<vector<vtkDoubleArray*>>& volumeWtdAvgs,
-  vector<vector<vtkDoubleArray*>>& massWtdAvgs, vector<vector<vtkDoubleArray*>>& sums)
-{
-  const int myProcId = this->Controller->GetLocalProcessId();
-  const int nProcs = this->Controller->GetNumberOfProcesses();
-  const int msgBase = 200000;
-
-  // size buffer's header's
-  // here we work with a single block(material)
-  vtkMaterialInterfaceCommBuffer::SizeHeader(buffers, 1);
-
-  // receive & unpack
-  for (int procId = 0; procId < nProcs; ++procId)
-  {
-    // skip mine
-    if (procId == myProcId)
-    {
-      continue;
-    }
-    int thisMsgId = msgBase;
-    // receive buffer's header
-    this->Controller->Receive(
-      buffers[procId].GetHeader(), buffers[procId].GetHeaderSize(), procId, thisMsgId);
-    ++thisMsgId;
-    // size attribute's buffer from incoming header
-    buffers[procId].SizeBuffer();
-    // receive attribute's data
-    this->Controller->Receive(
-      buffers[procId].GetBuffer(), buffers[procId].GetBufferSize(), procId, thisMsgId);
-    ++thisMsgId;
-    // unpack attribute data
-    // We will point into the comm buffer rather than copy
-    const unsigned int nToUnpack = buffers[procId].GetNumberOfTuples(0);
-    // volume
-    buffers[procId].UnPack(volumes[procId], 1, nToUnpack, false);
-    if (this->ClipWithPlane)
-    {
-      buffers[procId].UnPack(clipDepthMaxs[procId], 1, nToUnpack, false);
-      buffers[procId].UnPack(clipDepthMins[procId], 1, nToUnpack, false);
-    }
-    // moments
-    if (this->ComputeMoments)
-    {
-      buffers[procId].UnPack(moments[procId], 4, nToUnpack, false);
-    }
-    // volume weighted averages
-    for (int i = 0; i < this->NVolumeWtdAvgs; ++i)
-    {
-      const unsigned int nCompsAvg = this->FragmentVolumeWtdAvgs[i]->GetNumberOfComponents();
-      buffers[procId].UnPack(volumeWtdAvgs[procId][i], nCompsAvg, nToUnpack, false);
-    }
-    // mass weighted averages
-    for (int i = 0; i < this->NMassWtdAvgs; ++i)
-    {
-      const unsigned int nCompsAvg = this->FragmentMassWtdAvgs[i]->GetNumberOfComponents();
-      buffers[procId].UnPack(massWtdAvgs[procId][i], nCompsAvg, nToUnpack, false);
-    }
-    // sums
-    for (int i = 0; i < this->NToSum; ++i)
-    {
-      const unsigned int nCompsSum = this->FragmentSums[i]->GetNumberOfComponents();
-      buffers[procId].UnPack(sums[procId][i], nCompsSum, nToUnpack, false);
-    }
-  }
-
-  return 1;
-}
-//----------------------------------------------------------------------------
-// Replaces our own interated attributes with those received
-// from another process.
+// Make new arrays to hold the resolved integarted attributes,
+// and initialize to zero.
 //
 // return 0 on error.
-int vtkMaterialInterfaceFilter::ReceiveIntegratedAttributes(const int sourceProcId)
+int vtkMaterialInterfaceFilter::PrepareToResolveIntegratedAttributes()
 {
-  const int msgBase = 200000;
-
-  // prepare the comm buffer to receive attribute data
-  // pertaining to a single block(material)
-  vtkMaterialInterfaceCommBuffer buffer;
-  buffer.SizeHeader(1);
-
-  int thisMsgId = msgBase;
-  // receive buffer's header
-  this->Controller->Receive(buffer.GetHeader(), buffer.GetHeaderSize(), sourceProcId, thisMsgId);
-  ++thisMsgId;
-  // size buffer via on incoming header
-  buffer.SizeBuffer();
-  // receive attribute's data
-  this->Controller->Receive(buffer.GetBuffer(), buffer.GetBufferSize(), sourceProcId, thisMsgId);
-  ++thisMsgId;
+  int nComps;
+  double* pResolved = nullptr;
+  vtkIdType bytesPerComponent = sizeof(double) * this->NumberOfResolvedFragments;
 
-  // unpack attribute data, with an explicit copy
-  // into a local array
-  const unsigned int nToUnPack = buffer.GetNumberOfTuples(0);
   // volume
-  ReNewVtkArrayPointer(this->FragmentVolumes, this->FragmentVolumes->GetName());
-  buffer.UnPack(this->FragmentVolumes, 1, nToUnPack, true);
-  // Clip Depth
+  nComps = 1;
+  NewVtkArrayPointer(this->FragmentVolumes, nComps, this->NumberOfResolvedFragments,
+    this->FragmentVolumes->GetName());
+  pResolved = this->FragmentVolumes->GetPointer(0);
+  memset(pResolved, 0, bytesPerComponent);
+
+  // clip depths
   if (this->ClipWithPlane)
   {
-    ReNewVtkArrayPointer(this->ClipDepthMaximums, this->ClipDepthMaximums->GetName());
-    buffer.UnPack(this->ClipDepthMaximums, 1, nToUnPack, true);
-    ReNewVtkArrayPointer(this->ClipDepthMinimums, this->ClipDepthMinimums->GetName());
-    buffer.UnPack(this->ClipDepthMinimums, 1, nToUnPack, true);
+    nComps = 1;
+    NewVtkArrayPointer(this->ClipDepthMaximums, nComps, this->NumberOfResolvedFragments,
+      this->ClipDepthMaximums->GetName());
+    pResolved = this->ClipDepthMaximums->GetPointer(0);
+    memset(pResolved, 0, bytesPerComponent);
+    NewVtkArrayPointer(this->ClipDepthMinimums, nComps, this->NumberOfResolvedFragments,
+      this->ClipDepthMinimums->GetName());
+    pResolved = this->ClipDepthMinimums->GetPointer(0);
+    memset(pResolved, 0, bytesPerComponent);
   }
+
   // moments
   if (this->ComputeMoments)
   {
-    ReNewVtkArrayPointer(this->FragmentMoments, this->FragmentMoments->GetName());
-    buffer.UnPack(this->FragmentMoments, 4, nToUnPack, true);
+    nComps = 4;
+    NewVtkArrayPointer(this->FragmentMoments, nComps, this->NumberOfResolvedFragments,
+      this->FragmentMoments->GetName());
+    pResolved = this->FragmentMoments->GetPointer(0);
+    memset(pResolved, 0, nComps * bytesPerComponent);
   }
   // volume weighted averages
   for (int i = 0; i < this->NVolumeWtdAvgs; ++i)
   {
-    int nCompsVWAvg = this->FragmentVolumeWtdAvgs[i]->GetNumberOfComponents();
-    ReNewVtkArrayPointer(this->FragmentVolumeWtdAvgs[i], this->FragmentVolumeWtdAvgs[i]->GetName());
-    buffer.UnPack(this->FragmentVolumeWtdAvgs[i], nCompsVWAvg, nToUnPack, true);
+    nComps = this->FragmentVolumeWtdAvgs[i]->GetNumberOfComponents();
+    NewVtkArrayPointer(this->FragmentVolumeWtdAvgs[i], nComps, this->NumberOfResolvedFragments,
+      this->FragmentVolumeWtdAvgs[i]->GetName());
+    pResolved = this->FragmentVolumeWtdAvgs[i]->GetPointer(0);
+    memset(pResolved, 0, nComps * bytesPerComponent);
   }
   // mass weighted averages
   for (int i = 0; i < this->NMassWtdAvgs; ++i)
   {
-    int nCompsMWAvg = this->FragmentMassWtdAvgs[i]->GetNumberOfComponents();
-    ReNewVtkArrayPointer(this->FragmentMassWtdAvgs[i], this->FragmentMassWtdAvgs[i]->GetName());
-    buffer.UnPack(this->FragmentMassWtdAvgs[i], nCompsMWAvg, nToUnPack, true);
+    nComps = this->FragmentMassWtdAvgs[i]->GetNumberOfComponents();
+    NewVtkArrayPointer(this->FragmentMassWtdAvgs[i], nComps, this->NumberOfResolvedFragments,
+      this->FragmentMassWtdAvgs[i]->GetName());
+    pResolved = this->FragmentMassWtdAvgs[i]->GetPointer(0);
+    memset(pResolved, 0, nComps * bytesPerComponent);
   }
   // sums
   for (int i = 0; i < this->NToSum; ++i)
   {
-    int nCompsSum = this->FragmentSums[i]->GetNumberOfComponents();
-    ReNewVtkArrayPointer(this->FragmentSums[i], this->FragmentSums[i]->GetName());
-    buffer.UnPack(this->FragmentSums[i], nCompsSum, nToUnPack, true);
+    nComps = this->FragmentSums[i]->GetNumberOfComponents();
+    NewVtkArrayPointer(this->FragmentSums[i], nComps, this->NumberOfResolvedFragments,
+      this->FragmentSums[i]->GetName());
+    pResolved = this->FragmentSums[i]->GetPointer(0);
+    memset(pResolved, 0, nComps * bytesPerComponent);
   }
 
   return 1;
 }
 
 //----------------------------------------------------------------------------
-// Send my integrated attributes to another process.
+// Sum the integrated attributes of the local fragments that belong to the
+// same resolved fragment, so that a single tuple per resolved fragment is
+// sent to the process that reduces it. All the attributes are accumulated
+// linearly, including the weighted averages which are divided by the
+// resolved weight, so this does not change the result.
 //
 // return 0 on error.
-int vtkMaterialInterfaceFilter::SendIntegratedAttributes(const int recipientProcId)
+int vtkMaterialInterfaceFilter::SumIntegratedAttributesBySet(vector<int>& resolvedIds)
 {
   const int myProcId = this->Controller->GetLocalProcessId();
-  const int msgBase = 200000;
+  const int offset = this->LocalToGlobalOffsets[myProcId];
+  const int nLocal = this->NumberOfRawFragmentsInProcess[myProcId];
 
-  // estimate buffer size (in bytes)
-  const vtkIdType nToSend = this->FragmentVolumes->GetNumberOfTuples();
-  unsigned int totalNumberOfComps = 1 + (this->ComputeMoments ? 4 : 0); // volume + moments
-  if (this->ClipWithPlane)
-  {
-    totalNumberOfComps += this->ClipDepthMaximums->GetNumberOfComponents();
-    totalNumberOfComps += this->ClipDepthMinimums->GetNumberOfComponents();
-  }
-  for (int i = 0; i < this->NVolumeWtdAvgs; ++i) // + volume weighted averages
-  {
-    totalNumberOfComps += this->FragmentVolumeWtdAvgs[i]->GetNumberOfComponents();
-  }
-  for (int i = 0; i < this->NMassWtdAvgs; ++i) // + mass weighted averages
-  {
-    totalNumberOfComps += this->FragmentMassWtdAvgs[i]->GetNumberOfComponents();
-  }
-  for (int i = 0; i < this->NToSum; ++i) // + sums
+  // one slot per resolved fragment, in order of appearance.
+  std::unordered_map<int, int> slotOfSetId;
+  vector<int> slots(nLocal);
+  resolvedIds.clear();
+  for (int i = 0; i < nLocal; ++i)
   {
-    totalNumberOfComps += this->FragmentSums[i]->GetNumberOfComponents();
+    const int setId = this->EquivalenceSet->GetEquivalentSetId(i + offset);
+    auto inserted = slotOfSetId.emplace(setId, static_cast<int>(resolvedIds.size()));
+    if (inserted.second)
+    {
+      resolvedIds.push_back(setId);
+    }
+    slots[i] = inserted.first->second;
   }
-  const vtkIdType bufferSize = nToSend * totalNumberOfComps * sizeof(double);
+  const int nSlots = static_cast<int>(resolvedIds.size());
 
-  // prepare a comm buffer
-  // Will use only a single block(material) of attribute data
-  // We size the buffer, and set the number of fragments.
-  vtkMaterialInterfaceCommBuffer buffer;
-  buffer.Initialize(myProcId, 1, bufferSize);
-  buffer.SetNumberOfTuples(0, nToSend);
-
-  // pack attributes into the buffer
-  // volume
-  buffer.Pack(this->FragmentVolumes);
+  SumTuplesBySlot(this->FragmentVolumes, slots, nSlots);
   if (this->ClipWithPlane)
   {
-    buffer.Pack(this->ClipDepthMaximums);
-    buffer.Pack(this->ClipDepthMinimums);
+    SumTuplesBySlot(this->ClipDepthMaximums, slots, nSlots);
+    SumTuplesBySlot(this->ClipDepthMinimums, slots, nSlots);
   }
-  // moments
   if (this->ComputeMoments)
   {
-    buffer.Pack(this->FragmentMoments);
+    SumTuplesBySlot(this->FragmentMoments, slots, nSlots);
   }
-  // volume weighted averages
-  for (int i = 0; i < this->NVolumeWtdAvgs; ++i)
+  for (int k = 0; k < this->NVolumeWtdAvgs; ++k)
   {
-    buffer.Pack(this->FragmentVolumeWtdAvgs[i]);
+    SumTuplesBySlot(this->FragmentVolumeWtdAvgs[k], slots, nSlots);
   }
-  // mass weighted averages
-  for (int i = 0; i < this->NMassWtdAvgs; ++i)
+  for (int k = 0; k < this->NMassWtdAvgs; ++k)
   {
-    buffer.Pack(this->FragmentMassWtdAvgs[i]);
+    SumTuplesBySlot(this->FragmentMassWtdAvgs[k], slots, nSlots);
   }
-  // sums
-  for (int i = 0; i < this->NToSum; ++i)
+  for (int k = 0; k < this->NToSum; ++k)
   {
-    buffer.Pack(this->FragmentSums[i]);
+    SumTuplesBySlot(this->FragmentSums[k], slots, nSlots);
   }
-
-  // send the buffer in two parts, first the header, followed by
-  // the attribute data
-  int thisMsgId = msgBase;
-  // buffer's header
-  this->Controller->Send(buffer.GetHeader(), buffer.GetHeaderSize(), recipientProcId, thisMsgId);
-  ++thisMsgId;
-  // packed attributes
-  this->Controller->Send(buffer.GetBuffer(), buffer.GetBufferSize(), recipientProcId, thisMsgId);
-  ++thisMsgId;
-
   return 1;
 }
 
 //----------------------------------------------------------------------------
-// Send my integrated attribute arrays to all other processes.
+// Fill arrays with the integrated attribute arrays, in the order their
+// components are packed for the reduction.
+void vtkMaterialInterfaceFilter::GetIntegratedAttributeArrays(vector<vtkDoubleArray*>& arrays)
+{
+  arrays.clear();
+  arrays.push_back(this->FragmentVolumes);
+  if (this->ClipWithPlane)
+  {
+    arrays.push_back(this->ClipDepthMaximums);
+    arrays.push_back(this->ClipDepthMinimums);
+  }
+  if (this->ComputeMoments)
+  {
+    arrays.push_back(this->FragmentMoments);
+  }
+  arrays.insert(arrays.end(), this->FragmentVolumeWtdAvgs.begin(),
+    this->FragmentVolumeWtdAvgs.begin() + this->NVolumeWtdAvgs);
+  arrays.insert(arrays.end(), this->FragmentMassWtdAvgs.begin(),
+    this->FragmentMassWtdAvgs.begin() + this->NMassWtdAvgs);
+  arrays.insert(
+    arrays.end(), this->FragmentSums.begin(), this->FragmentSums.begin() + this->NToSum);
+}
+
+//----------------------------------------------------------------------------
+// Sum the attributes of the fragments that are split over processes and
+// finish the weighted averages. The attributes are reduced by key: the
+// tuples of a resolved fragment are sent to, and resolved on, the process
+// whose rank is the fragment id modulo the number of processes. Each process
+// only exchanges with the processes it has tuples for. The resolved tuples
+// are sent back to the processes that had a piece of the fragment, and all
+// of them to the controlling process which builds the statistics output.
 //
 // return 0 on error.
-int vtkMaterialInterfaceFilter::BroadcastIntegratedAttributes(const int sourceProcId)
+int vtkMaterialInterfaceFilter::ResolveIntegratedAttributes(const int controllingProcId)
 {
-#ifdef vtkMaterialInterfaceFilterDEBUG
-  ostringstream progressMesg;
-  progressMesg << "vtkMaterialInterfaceFilter::BroadcastIntegratedAttributes("
-               << ") , Material " << this->MaterialId;
-  this->SetProgressText(progressMesg.str().c_str());
-#endif
-  this->Progress += this->ProgressResolutionInc;
-  this->UpdateProgress(this->Progress);
-
   const int myProcId = this->Controller->GetLocalProcessId();
   const int nProcs = this->Controller->GetNumberOfProcesses();
+  const int msgId = 200010;
 
-  // anything to do?
-  if (nProcs == 1)
+  vector<int> resolvedIds;
+  this->SumIntegratedAttributesBySet(resolvedIds);
+
+  // A tuple holds the components of all of the arrays.
+  vector<vtkDoubleArray*> arrays;
+  this->GetIntegratedAttributeArrays(arrays);
+  int nValues = 0;
+  for (vtkDoubleArray* array : arrays)
   {
-    return 1;
+    nValues += array->GetNumberOfComponents();
   }
 
-  // send mine to all
-  if (myProcId == sourceProcId)
+  // Pack our tuples with their resolved id, by the process that reduces
+  // them.
+  std::map<int, vector<double>> reduced;
+  std::map<int, vtkSmartPointer<vtkDoubleArray>> toSend;
+  vector<double> values(nValues);
+  const int nSlots = static_cast<int>(resolvedIds.size());
+  for (int i = 0; i < nSlots; ++i)
   {
-    for (int procId = 0; procId < nProcs; ++procId)
+    double* pValues = values.data();
+    for (vtkDoubleArray* array : arrays)
+    {
+      array->GetTuple(i, pValues);
+      pValues += array->GetNumberOfComponents();
+    }
+    const int reducingProcId = resolvedIds[i] % nProcs;
+    if (reducingProcId == myProcId)
     {
-      // skip me
-      if (procId == sourceProcId)
+      vector<double>& sum = reduced[resolvedIds[i]];
+      sum.resize(nValues, 0.0);
+      for (int q = 0; q < nValues; ++q)
       {
-        continue;
+        sum[q] += values[q];
       }
-      this->SendIntegratedAttributes(procId);
+      continue;
+    }
+    vtkSmartPointer<vtkDoubleArray>& array = toSend[reducingProcId];
+    if (array == nullptr)
+    {
+      array = vtkSmartPointer<vtkDoubleArray>::New();
+      array->SetNumberOfComponents(nValues + 1);
+    }
+    array->InsertNextValue(resolvedIds[i]);
+    for (double value : values)
+    {
+      array->InsertNextValue(value);
     }
   }
-  // receive from source
-  else
-  {
-    this->ReceiveIntegratedAttributes(sourceProcId);
-  }
-
-  return 1;
-}
-
-//----------------------------------------------------------------------------
-// Create some buffers to hold the other processes attribute arrays.
-// Copy our current data into these arrays as well.
-//
-// return 0 on error.
-int vtkMaterialInterfaceFilter::PrepareToCollectIntegratedAttributes(
-  vector<vtkMaterialInterfaceCommBuffer>& buffers, vector<vtkDoubleArray*>& volumes,
-  vector<vtkDoubleArray*>& clipDepthMaxs, vector<vtkDoubleArray*>& clipDepthMins,
-  vector<vtkDoubleArray*>& moments, vector<vector<vtkDoubleArray*>>& volumeWtdAvgs,
-  vector<vector<vtkDoubleArray*>>& massWtdAvgs, vector<vector<vtkDoubleArray*>>& sums)
-{
-  const int myProcId = this->Controller->GetLocalProcessId();
-  const int nProcs = this->Controller->GetNumberOfProcesses();
 
-  // set up for collect
-  // buffers
-  buffers.resize(nProcs);
-  // volumes
-  ResizeVectorOfVtkPointers(volumes, nProcs);
-  volumes[myProcId]->Delete();
-  volumes[myProcId] = this->FragmentVolumes;
-  // ClipDepths
-  if (this->ClipWithPlane)
+  // The controlling process gets every resolved tuple.
+  vector<int> destinations;
+  for (auto& item : toSend)
   {
-    ResizeVectorOfVtkPointers(clipDepthMaxs, nProcs);
-    clipDepthMaxs[myProcId]->Delete();
-    clipDepthMaxs[myProcId] = this->ClipDepthMaximums;
-    ResizeVectorOfVtkPointers(clipDepthMins, nProcs);
-    clipDepthMins[myProcId]->Delete();
-    clipDepthMins[myProcId] = this->ClipDepthMinimums;
+    destinations.push_back(item.first);
   }
-  // moments
-  if (this->ComputeMoments)
+  if (myProcId != controllingProcId)
   {
-    ResizeVectorOfVtkPointers(moments, nProcs);
-    moments[myProcId]->Delete();
-    moments[myProcId] = this->FragmentMoments;
+    destinations.push_back(controllingProcId);
   }
-  // volume weighted averages
-  if (this->NVolumeWtdAvgs > 0)
+  vector<int> partners;
+  FindExchangePartners(this->Controller, destinations, partners);
+
+  // Sum the tuples of the fragments we reduce, keeping the ids each
+  // partner sent.
+  vtkNew<vtkDoubleArray> empty;
+  empty->SetNumberOfComponents(nValues + 1);
+  vtkNew<vtkDoubleArray> received;
+  vector<vector<int>> partnerIds(partners.size());
+  for (size_t k = 0; k < partners.size(); ++k)
   {
-    volumeWtdAvgs.resize(nProcs);
-    for (int procId = 0; procId < nProcs; ++procId)
+    auto iter = toSend.find(partners[k]);
+    ExchangeArrays(this->Controller, iter != toSend.end() ? iter->second.Get() : empty.Get(),
+      received, partners[k], msgId);
+    const double* pReceived = received->GetPointer(0);
+    const vtkIdType nReceived = received->GetNumberOfValues() / (nValues + 1);
+    for (vtkIdType i = 0; i < nReceived; ++i)
     {
-      if (procId == myProcId)
-      {
-        volumeWtdAvgs[procId] = this->FragmentVolumeWtdAvgs;
-      }
-      else
+      const int resolvedId = static_cast<int>(pReceived[0]);
+      vector<double>& sum = reduced[resolvedId];
+      sum.resize(nValues, 0.0);
+      for (int q = 0; q < nValues; ++q)
       {
-        ResizeVectorOfVtkPointers(volumeWtdAvgs[procId], this->NVolumeWtdAvgs);
+        sum[q] += pReceived[q + 1];
       }
+      partnerIds[k].push_back(resolvedId);
+      pReceived += nValues + 1;
     }
   }
-  // mass weighted averages
-  if (this->NMassWtdAvgs > 0)
+  toSend.clear();
+
+  // Weighted averages are divided by the resolved weights, volume or
+  // mass.  Mass weighted averages are only computed with the moments.
+  const int volumeIdx = 0;
+  const int massIdx = this->ClipWithPlane ? 6 : 4;
+  int firstWtdAvgIdx = massIdx - 3;
+  if (this->ComputeMoments)
   {
-    massWtdAvgs.resize(nProcs);
-    for (int procId = 0; procId < nProcs; ++procId)
+    firstWtdAvgIdx += 4;
+  }
+  for (auto& item : reduced)
+  {
+    vector<double>& sum = item.second;
+    int idx = firstWtdAvgIdx;
+    for (int k = 0; k < this->NVolumeWtdAvgs; ++k)
     {
-      if (procId == myProcId)
+      const int nComps = this->FragmentVolumeWtdAvgs[k]->GetNumberOfComponents();
+      for (int q = 0; q < nComps; ++q, ++idx)
       {
-        massWtdAvgs[procId] = this->FragmentMassWtdAvgs;
+        sum[idx] /= sum[volumeIdx];
       }
-      else
+    }
+    for (int k = 0; k < this->NMassWtdAvgs; ++k)
+    {
+      const int nComps = this->FragmentMassWtdAvgs[k]->GetNumberOfComponents();
+      for (int q = 0; q < nComps; ++q, ++idx)
       {
-        ResizeVectorOfVtkPointers(massWtdAvgs[procId], this->NMassWtdAvgs);
+        sum[idx] = this->ComputeMoments ? sum[idx] / sum[massIdx] : 0.0;
       }
     }
   }
-  // sums
-  if (this->NToSum > 0)
+
+  // Store the resolved tuples in new arrays, indexed by resolved id.
+  this->PrepareToResolveIntegratedAttributes();
+  this->GetIntegratedAttributeArrays(arrays);
+  auto setTuple = [&arrays](int resolvedId, const double* pValues) {
+    for (vtkDoubleArray* array : arrays)
+    {
+      array->SetTuple(resolvedId, pValues);
+      pValues += array->GetNumberOfComponents();
+    }
+  };
+  for (auto& item : reduced)
   {
-    sums.resize(nProcs);
-    for (int procId = 0; procId < nProcs; ++procId)
+    setTuple(item.first, item.second.data());
+  }
+
+  // Send the resolved tuples back.
+  vtkNew<vtkDoubleArray> resolved;
+  resolved->SetNumberOfComponents(nValues + 1);
+  auto addTuple = [&resolved](int resolvedId, const vector<double>& sum) {
+    resolved->InsertNextValue(resolvedId);
+    for (double value : sum)
+    {
+      resolved->InsertNextValue(value);
+    }
+  };
+  for (size_t k = 0; k < partners.size(); ++k)
+  {
+    resolved->SetNumberOfTuples(0);
+    if (partners[k] == controllingProcId)
     {
-      if (procId == myProcId)
+      for (auto& item : reduced)
       {
-        sums[procId] = this->FragmentSums;
+        addTuple(item.first, item.second);
       }
-      else
+    }
+    else
+    {
+      for (int resolvedId : partnerIds[k])
       {
-        ResizeVectorOfVtkPointers(sums[procId], this->NToSum);
+        addTuple(resolvedId, reduced[resolvedId]);
       }
     }
+    ExchangeArrays(this->Controller, resolved, received, partners[k], msgId + 1);
+    const double* pReceived = received->GetPointer(0);
+    const vtkIdType nReceived = received->GetNumberOfValues() / (nValues + 1);
+    for (vtkIdType i = 0; i < nReceived; ++i)
+    {
+      setTuple(static_cast<int>(pReceived[0]), pReceived + 1);
+      pReceived += nValues + 1;
+    }
   }
+
   return 1;
 }
-
 //----------------------------------------------------------------------------
-// Create some buffers to hold the other processes attribute arrays.
-// Copy our current data into these arrays as well.
-//
-// return 0 on error.
-int vtkMaterialInterfaceFilter::CleanUpAfterCollectIntegratedAttributes(
-  vector<vtkMaterialInterfaceCommBuffer>& buffers, vector<vtkDoubleArray*>& volumes,
-  vector<vtkDoubleArray*>& clipDepthMaxs, vector<vtkDoubleArray*>& clipDepthMins,
-  vector<vtkDoubleArray*>& moments, vector<vector<vtkDoubleArray*>>& volumeWtdAvgs,
-  vector<vector<vtkDoubleArray*>>& massWtdAvgs, vector<vector<vtkDoubleArray*>>& sums)
+// Free memory that we won't be needing.which has been
+// allocated on our behalf.
+void vtkMaterialInterfaceFilter::PrepareForResolveEquivalences()
 {
-  const int nProcs = this->Controller->GetNumberOfProcesses();
+#ifdef vtkMaterialInterfaceFilterDEBUG
+  ostringstream progressMesg;
+  progressMesg << "vtkMaterialInterfaceFilter::PrepareForResolveEquivalences("
+               << ") , Material " << this->MaterialId;
+  this->SetProgressText(progressMesg.str().c_str());
+#endif
+  this->Progress += this->ProgressResolutionInc;
+  this->UpdateProgress(this->Progress);
 
-  // volumes
-  ClearVectorOfVtkPointers(volumes);
-  // clip depths
-  if (this->ClipWithPlane)
+  // equivalences
+  this->EquivalenceSet->Squeeze();
+  // volume
+  this->FragmentVolumes->Squeeze();
+  // Clip depth
+  if (this->ClipWithPlane && this->ClipDepthMaximums)
   {
-    ClearVectorOfVtkPointers(clipDepthMaxs);
-    ClearVectorOfVtkPointers(clipDepthMins);
+    this->ClipDepthMaximums->Squeeze();
+    this->ClipDepthMinimums->Squeeze();
   }
   // moments
   if (this->ComputeMoments)
   {
-    ClearVectorOfVtkPointers(moments);
+    this->FragmentMoments->Squeeze();
   }
-  // volume weighted averages
-  if (this->NVolumeWtdAvgs > 0)
-  {
-    for (int procId = 0; procId < nProcs; ++procId)
-    {
-      ClearVectorOfVtkPointers(volumeWtdAvgs[procId]);
-    }
-  }
-  // mass weighted averages
-  if (this->NMassWtdAvgs > 0)
-  {
-    for (int procId = 0; procId < nProcs; ++procId)
-    {
-      ClearVectorOfVtkPointers(massWtdAvgs[procId]);
-    }
-  }
-  // sums
-  if (this->NToSum > 0)
-  {
-    for (int procId = 0; procId < nProcs; ++procId)
-    {
-      ClearVectorOfVtkPointers(sums[procId]);
-    }
-  }
-  // buffers
-  buffers.clear();
-
-  return 1;
-}
-
-//----------------------------------------------------------------------------
-// Make new arrays to hold the resolved integarted attributes,
-// and initialize to zero.
-//
-// return 0 on error.
-int vtkMaterialInterfaceFilter::PrepareToResolveIntegratedAttributes()
-{
-  int nComps;
-  double* pResolved = nullptr;
-  vtkIdType bytesPerComponent = sizeof(double) * this->NumberOfResolvedFragments;
-
-  // volume
-  nComps = 1;
-  NewVtkArrayPointer(this->FragmentVolumes, nComps, this->NumberOfResolvedFragments,
-    this->FragmentVolumes->GetName());
-  pResolved = this->FragmentVolumes->GetPointer(0);
-  memset(pResolved, 0, bytesPerComponent);
-
-  // clip depths
-  if (this->ClipWithPlane)
-  {
-    nComps = 1;
-    NewVtkArrayPointer(this->ClipDepthMaximums, nComps, this->NumberOfResolvedFragments,
-      this->ClipDepthMaximums->GetName());
-    pResolved = this->ClipDepthMaximums->GetPointer(0);
-    memset(pResolved, 0, bytesPerComponent);
-    NewVtkArrayPointer(this->ClipDepthMinimums, nComps, this->NumberOfResolvedFragments,
-      this->ClipDepthMinimums->GetName());
-    pResolved = this->ClipDepthMinimums->GetPointer(0);
-    memset(pResolved, 0, bytesPerComponent);
-  }
-
-  // moments
-  if (this->ComputeMoments)
-  {
-    nComps = 4;
-    NewVtkArrayPointer(this->FragmentMoments, nComps, this->NumberOfResolvedFragments,
-      this->FragmentMoments->GetName());
-    pResolved = this->FragmentMoments->GetPointer(0);
-    memset(pResolved, 0, nComps * bytesPerComponent);
-  }
-  // volume weighted averages
-  for (int i = 0; i < this->NVolumeWtdAvgs; ++i)
-  {
-    nComps = this->FragmentVolumeWtdAvgs[i]->GetNumberOfComponents();
-    NewVtkArrayPointer(this->FragmentVolumeWtdAvgs[i], nComps, this->NumberOfResolvedFragments,
-      this->FragmentVolumeWtdAvgs[i]->GetName());
-    pResolved = this->FragmentVolumeWtdAvgs[i]->GetPointer(0);
-    memset(pResolved, 0, nComps * bytesPerComponent);
-  }
-  // mass weighted averages
-  for (int i = 0; i < this->NMassWtdAvgs; ++i)
-  {
-    nComps = this->FragmentMassWtdAvgs[i]->GetNumberOfComponents();
-    NewVtkArrayPointer(this->FragmentMassWtdAvgs[i], nComps, this->NumberOfResolvedFragments,
-      this->FragmentMassWtdAvgs[i]->GetName());
-    pResolved = this->FragmentMassWtdAvgs[i]->GetPointer(0);
-    memset(pResolved, 0, nComps * bytesPerComponent);
-  }
-  // sums
-  for (int i = 0; i < this->NToSum; ++i)
-  {
-    nComps = this->FragmentSums[i]->GetNumberOfComponents();
-    NewVtkArrayPointer(this->FragmentSums[i], nComps, this->NumberOfResolvedFragments,
-      this->FragmentSums[i]->GetName());
-    pResolved = this->FragmentSums[i]->GetPointer(0);
-    memset(pResolved, 0, nComps * bytesPerComponent);
-  }
-
-  return 1;
-}
-
-//----------------------------------------------------------------------------
-// This is a gather operation that includes requisite calculations
-// to finish integrations. The integrated arrays on the controlling
-// process are resolved, but other procs are not updated.
-//
-// return 0 on error.
-int vtkMaterialInterfaceFilter::ResolveIntegratedAttributes(const int controllingProcId)
-{
-  const int myProcId = this->Controller->GetLocalProcessId();
-  const int nProcs = this->Controller->GetNumberOfProcesses();
-
-  // controller gathers and resolves
-  if (myProcId == controllingProcId)
-  {
-    vector<vtkMaterialInterfaceCommBuffer> buffers;
-    vector<vtkDoubleArray*> volumes;
-    vector<vtkDoubleArray*> clipDepthMaxs;
-    vector<vtkDoubleArray*> clipDepthMins;
-    vector<vtkDoubleArray*> moments;
-    vector<vector<vtkDoubleArray*>> volumeWtdAvgs;
-    vector<vector<vtkDoubleArray*>> massWtdAvgs;
-    vector<vector<vtkDoubleArray*>> sums;
-    // prepare collect buffers
-    this->PrepareToCollectIntegratedAttributes(
-      buffers, volumes, clipDepthMaxs, clipDepthMins, moments, volumeWtdAvgs, massWtdAvgs, sums);
-    // collect
-    this->CollectIntegratedAttributes(
-      buffers, volumes, clipDepthMaxs, clipDepthMins, moments, volumeWtdAvgs, massWtdAvgs, sums);
-
-    // prepare for resolution
-    this->PrepareToResolveIntegratedAttributes();
-    // resolve attributes
-    // First pass we'll resolve attributes which
-    // are needed to resolve other attributes (eg weights)
-    int procBaseEqSetId = 0;
-    for (int procId = 0; procId < nProcs; ++procId)
-    {
-      int eqSetId;
-      double* pResolved;
-      const double* pUnresolved;
-      int nUnresolved = this->NumberOfRawFragmentsInProcess[procId];
-
-      // volume
-      pUnresolved = volumes[procId]->GetPointer(0);
-      pResolved = this->FragmentVolumes->GetPointer(0);
-      eqSetId = procBaseEqSetId;
-      for (int i = 0; i < nUnresolved; ++i)
-      {
-        int resIdx = this->EquivalenceSet->GetEquivalentSetId(eqSetId);
-        pResolved[resIdx] += pUnresolved[0];
-        ++pUnresolved;
-        ++eqSetId;
-      }
-      // clip depth
-      if (this->ClipWithPlane)
-      {
-        pUnresolved = clipDepthMaxs[procId]->GetPointer(0);
-        pResolved = this->ClipDepthMaximums->GetPointer(0);
-        eqSetId = procBaseEqSetId;
-        for (int i = 0; i < nUnresolved; ++i)
-        {
-          int resIdx = this->EquivalenceSet->GetEquivalentSetId(eqSetId);
-          pResolved[resIdx] += pUnresolved[0];
-          ++pUnresolved;
-          ++eqSetId;
-        }
-        pUnresolved = clipDepthMins[procId]->GetPointer(0);
-        pResolved = this->ClipDepthMinimums->GetPointer(0);
-        eqSetId = procBaseEqSetId;
-        for (int i = 0; i < nUnresolved; ++i)
-        {
-          int resIdx = this->EquivalenceSet->GetEquivalentSetId(eqSetId);
-          pResolved[resIdx] += pUnresolved[0];
-          ++pUnresolved;
-          ++eqSetId;
-        }
-      }
-      // moments
-      if (this->ComputeMoments)
-      {
-        pUnresolved = moments[procId]->GetPointer(0);
-        pResolved = this->FragmentMoments->GetPointer(0);
-        eqSetId = procBaseEqSetId;
-        for (int i = 0; i < nUnresolved; ++i)
-        {
-          int resIdx = 4 * this->EquivalenceSet->GetEquivalentSetId(eqSetId);
-          for (int q = 0; q < 4; ++q)
-          {
-            pResolved[resIdx + q] += pUnresolved[q];
-          }
-          pUnresolved += 4;
-          ++eqSetId;
-        }
-      }
-      procBaseEqSetId += nUnresolved;
-    }
-
-    // Second pass, resolve attributes which depend on
-    // other attributes (eg weighted averages)
-    procBaseEqSetId = 0;
-    for (int procId = 0; procId < nProcs; ++procId)
-    {
-      int eqSetId;
-      double* pResolved;
-      const double* pUnresolved;
-      int nUnresolved = this->NumberOfRawFragmentsInProcess[procId];
-      // volume weighted averages
-      double* pWt;  // these have to do with weights
-      int nCompsWt; //
-      int wtComp;   //
-      for (int k = 0; k < this->NVolumeWtdAvgs; ++k)
-      {
-        pUnresolved = volumeWtdAvgs[procId][k]->GetPointer(0);
-        pResolved = this->FragmentVolumeWtdAvgs[k]->GetPointer(0);
-        int nComps = this->FragmentVolumeWtdAvgs[k]->GetNumberOfComponents();
-        pWt = this->FragmentVolumes->GetPointer(0);
-        nCompsWt = 1;
-        wtComp = 0;
-        eqSetId = procBaseEqSetId;
-        for (int i = 0; i < nUnresolved; ++i)
-        {
-          int resId = this->EquivalenceSet->GetEquivalentSetId(eqSetId);
-          int resIdx = nComps * resId;
-          int wtIdx = nCompsWt * resId;
-          for (int q = 0; q < nComps; ++q)
-          {
-            pResolved[resIdx + q] += pUnresolved[q] / pWt[wtIdx];
-          }
-          pUnresolved += nComps;
-          ++eqSetId;
-        }
-      }
-      // mass weighted averages (Mx,My,Mz,Mass)
-      if (this->ComputeMoments)
-      {
-        for (int k = 0; k < this->NMassWtdAvgs; ++k)
-        {
-          pUnresolved = massWtdAvgs[procId][k]->GetPointer(0);
-          pResolved = this->FragmentMassWtdAvgs[k]->GetPointer(0);
-          int nComps = this->FragmentMassWtdAvgs[k]->GetNumberOfComponents();
-          nCompsWt = 4;
-          wtComp = 3;
-          pWt = this->FragmentMoments->GetPointer(0) + wtComp;
-          eqSetId = procBaseEqSetId;
-          for (int i = 0; i < nUnresolved; ++i)
-          {
-            int resId = this->EquivalenceSet->GetEquivalentSetId(eqSetId);
-            int resIdx = nComps * resId;
-            int wtIdx = nCompsWt * resId;
-            for (int q = 0; q < nComps; ++q)
-            {
-              pResolved[resIdx + q] += pUnresolved[q] / pWt[wtIdx];
-            }
-            pUnresolved += nComps;
-            ++eqSetId;
-          }
-        }
-      }
-      // sums
-      for (int k = 0; k < this->NToSum; ++k)
-      {
-        pUnresolved = sums[procId][k]->GetPointer(0);
-        pResolved = this->FragmentSums[k]->GetPointer(0);
-        int nComps = this->FragmentSums[k]->GetNumberOfComponents();
-        eqSetId = procBaseEqSetId;
-        for (int i = 0; i < nUnresolved; ++i)
-        {
-          int resIdx = nComps * this->EquivalenceSet->GetEquivalentSetId(eqSetId);
-          for (int q = 0; q < nComps; ++q)
-          {
-            pResolved[resIdx + q] += pUnresolved[q];
-          }
-          pUnresolved += nComps;
-          ++eqSetId;
-        }
-      }
-      procBaseEqSetId += nUnresolved;
-    }
-    // clean up
-    this->CleanUpAfterCollectIntegratedAttributes(
-      buffers, volumes, clipDepthMaxs, clipDepthMins, moments, volumeWtdAvgs, massWtdAvgs, sums);
-  }
-  // others send unresolved integrated attributes
-  else
-  {
-    this->SendIntegratedAttributes(controllingProcId);
-  }
-
-  return 1;
-}
-//----------------------------------------------------------------------------
-// Free memory that we won't be needing.which has been
-// allocated on our behalf.
-void vtkMaterialInterfaceFilter::PrepareForResolveEquivalences()
-{
-#ifdef vtkMaterialInterfaceFilterDEBUG
-  ostringstream progressMesg;
-  progressMesg << "vtkMaterialInterfaceFilter::PrepareForResolveEquivalences("
-               << ") , Material " << this->MaterialId;
-  this->SetProgressText(progressMesg.str().c_str());
-#endif
-  this->Progress += this->ProgressResolutionInc;
-  this->UpdateProgress(this->Progress);
-
-  // equivalences
-  this->EquivalenceSet->Squeeze();
-  // volume
-  this->FragmentVolumes->Squeeze();
-  // Clip depth
-  if (this->ClipWithPlane && this->ClipDepthMaximums)
-  {
-    this->ClipDepthMaximums->Squeeze();
-    this->ClipDepthMinimums->Squeeze();
-  }
-  // moments
-  if (this->ComputeMoments)
-  {
-    this->FragmentMoments->Squeeze();
-  }
-  // volume weighted average
-  for (int i = 0; i < this->NVolumeWtdAvgs; ++i)
+  // volume weighted average
+  for (int i = 0; i < this->NVolumeWtdAvgs; ++i)
   {
     this->FragmentVolumeWtdAvgs[i]->Squeeze();
   }
@@ -8072,7 +8265,6 @@ void vtkMaterialInterfaceFilter::ResolveEquivalences()
   // Accumulate contributions from fragemnts who were
   // previously split.
   this->ResolveIntegratedAttributes(0);
-  this->BroadcastIntegratedAttributes(0);
 #ifdef vtkMaterialInterfaceFilterDEBUG
   cerr << "[" << __LINE__ << "] " << myProcId
        << " memory commitment after ResolveIntegratedAttributes is:" << endl
@@ -8108,6 +8300,11 @@ void vtkMaterialInterfaceFilter::ResolveEquivalences()
 //----------------------------------------------------------------------------
 // This also fills in the arrays NumberOfRawFragments and LocalToGlobalOffsets
 // as a side effect. (also NumberOfResolvedFragments).
+//
+// Equivalences are resolved without gathering them on a single process:
+// each process first reduces its fragments to their local sets, then
+// equivalences between sets of neighboring processes are found from the
+// ghost blocks, and only those are merged between processes.
 void vtkMaterialInterfaceFilter::GatherEquivalenceSets(vtkMaterialInterfaceEquivalenceSet* set)
 {
 #ifdef vtkMaterialInterfaceFilterDEBUG
@@ -8120,27 +8317,12 @@ void vtkMaterialInterfaceFilter::GatherEquivalenceSets(vtkMaterialInterfaceEquiv
   this->UpdateProgress(this->Progress);
 
   const int numProcs = this->Controller->GetNumberOfProcesses();
-  const int myProcId = this->Controller->GetLocalProcessId();
   const int numLocalMembers = set->GetNumberOfMembers();
 
   // Find a mapping between local fragment id and the global fragment ids.
-  if (myProcId == 0)
   {
-    this->NumberOfRawFragmentsInProcess[0] = numLocalMembers;
-    for (int ii = 1; ii < numProcs; ++ii)
-    {
-      this->Controller->Receive(this->NumberOfRawFragmentsInProcess + ii, 1, ii, 875034);
-    }
-    // Now send the results back to all processes.
-    for (int ii = 1; ii < numProcs; ++ii)
-    {
-      this->Controller->Send(this->NumberOfRawFragmentsInProcess, numProcs, ii, 875035);
-    }
-  }
-  else
-  {
-    this->Controller->Send(&numLocalMembers, 1, 0, 875034);
-    this->Controller->Receive(this->NumberOfRawFragmentsInProcess, numProcs, 0, 875035);
+    vtkLogScopeF(TRACE, "gather number of fragments");
+    this->Controller->AllGather(&numLocalMembers, this->NumberOfRawFragmentsInProcess, 1);
   }
   // Compute offsets.
   int totalNumberOfIds = 0;
@@ -8152,218 +8334,356 @@ void vtkMaterialInterfaceFilter::GatherEquivalenceSets(vtkMaterialInterfaceEquiv
   }
   this->TotalNumberOfRawFragments = totalNumberOfIds;
 
-  // Change the set to a global set.
-  vtkMaterialInterfaceEquivalenceSet* globalSet = new vtkMaterialInterfaceEquivalenceSet;
-  // This just initializes the set so that every set has one member.
-  //  Every id is equivalent to itself and no others.
-  if (totalNumberOfIds > 0)
-  { // This crashes if there no fragemnts extracted.
-    globalSet->AddEquivalence(totalNumberOfIds - 1, totalNumberOfIds - 1);
-  }
-  // Add the equivalences from our process.
-  int myOffset = this->LocalToGlobalOffsets[myProcId];
-  int memberSetId;
+  // Every local fragment is replaced by the smallest member of its local
+  // set.  Only these need to be known by other processes.
+  vector<int> localSetIds(numLocalMembers);
   for (int ii = 0; ii < numLocalMembers; ++ii)
   {
-    memberSetId = set->GetEquivalentSetId(ii);
-    // This will be inefficient until I make the scheduled improvemnt to the
-    // add method (Ordered multilevel tree instead of a one level tree).
-    globalSet->AddEquivalence(ii + myOffset, memberSetId + myOffset);
+    localSetIds[ii] = set->GetEquivalentSetId(ii);
   }
 
-  // cerr << myProcId << " Input set: " << endl;
-  // set->Print();
-  // cerr << myProcId << " global set: " << endl;
-  // globalSet->Print();
-
   // Now add equivalents between processes.
-  // Send all the ghost blocks to the process that owns the block.
+  // Send the ghost blocks back to the process that owns the block.
   // Compare ids and add the equivalences.
-  this->ShareGhostEquivalences(globalSet, this->LocalToGlobalOffsets);
-
-  // cerr << "Global after ghost: " << myProcId << endl;
-  // globalSet->Print();
-
-  // Merge all of the processes global sets.
-  // Clean the global set so that the resulting set ids are sequential.
-  this->MergeGhostEquivalenceSets(globalSet);
-
-  // cerr << "Global after merge: " << myProcId << endl;
-  // globalSet->Print();
-
-  // free what do not need
-  globalSet->Squeeze();
+  vtkMaterialInterfaceUnionFind boundarySet;
+  vector<int> neighbors;
+  {
+    vtkLogScopeF(TRACE, "share ghost equivalences");
+    this->ShareGhostEquivalences(&boundarySet, localSetIds, this->LocalToGlobalOffsets, neighbors);
+  }
 
-  // Copy the equivalences to the local set for returning our results.
-  // The ids will be the global ids so the GetId method will work.
-  set->DeepCopy(globalSet);
+  // Merge the equivalences of all processes.
+  {
+    vtkLogScopeF(TRACE, "merge ghost equivalences");
+    this->MergeGhostEquivalenceSets(&boundarySet);
+  }
 
-  delete globalSet;
+  // Make the set ids sequential.
+  {
+    vtkLogScopeF(TRACE, "resolve set ids");
+    this->ResolveGlobalSetIds(set, &boundarySet, localSetIds);
+  }
 }
 
 //----------------------------------------------------------------------------
+// Union find across all processes.  The set id of a boundary id is sent to
+// the process that owns the id, and the owner of each set id is asked for
+// the set id it has for it, which replaces ours.  This is pointer jumping:
+// the paths to the smallest member of a set halve every round, so the
+// number of rounds grows with the log of the number of processes a fragment
+// spans.  Both messages only go to the owners of the ids we hold, not to
+// every process.  The rounds stop when an AllReduce reports that no set was
+// merged anywhere.
 void vtkMaterialInterfaceFilter::MergeGhostEquivalenceSets(
-  vtkMaterialInterfaceEquivalenceSet* globalSet)
+  vtkMaterialInterfaceUnionFind* boundarySet)
 {
+  const int numProcs = this->Controller->GetNumberOfProcesses();
   const int myProcId = this->Controller->GetLocalProcessId();
-  int* buf = globalSet->GetPointer();
-  const int numIds = globalSet->GetNumberOfMembers();
-
-  // At this point all the sets are global and have the same number of ids.
-  // Send all the sets to process 0 to be merged.
-  if (myProcId > 0)
-  {
-    this->Controller->Send(buf, numIds, 0, 342320);
-    // Now receive the final equivalences.
-    this->Controller->Receive(&this->NumberOfResolvedFragments, 1, 0, 342321);
-    // Domain has numIds,  range has NumberOfResolvedFragments
-    this->Controller->Receive(buf, numIds, 0, 342322);
-    // We have to mark the set as resolved because the set being
-    // received has been resolved.  If we do not do this then
-    // We cannot get the proper set id.  Using the pointer
-    // here is a bad api.  TODO: Fix the API and make "Resolved" private.
-    globalSet->Resolved = 1;
-    return;
-  }
 
-  // Only process 0 from here out.
+  // The set id last sent for each id.
+  std::unordered_map<int, int> sentSetIds;
+  std::map<int, vector<int>> setIdsToSend;
+  std::map<int, vector<int>> queries;
+  vector<int> pairs;
+  vector<int> roots;
+  vector<int> destinations;
+  vector<int> partners;
+  vector<vector<int>> receivedQueries;
+  vector<int> sendBuf;
+  vector<int> recvBuf;
+  int merged = 1;
+  int numberOfRounds = 0;
+  for (;;)
+  {
+    setIdsToSend.clear();
+    boundarySet->GetEquivalences(pairs);
+    for (size_t ii = 0; ii + 1 < pairs.size(); ii += 2)
+    {
+      const int owner = FindFragmentOwner(this->LocalToGlobalOffsets, numProcs, pairs[ii]);
+      auto iter = sentSetIds.find(pairs[ii]);
+      if (owner != myProcId && (iter == sentSetIds.end() || iter->second != pairs[ii + 1]))
+      {
+        setIdsToSend[owner].push_back(pairs[ii]);
+        setIdsToSend[owner].push_back(pairs[ii + 1]);
+        sentSetIds[pairs[ii]] = pairs[ii + 1];
+      }
+    }
 
-  int numProcs = this->Controller->GetNumberOfProcesses();
-  int* tmp;
-  tmp = new int[numIds];
-  for (int ii = 1; ii < numProcs; ++ii)
-  {
-    this->Controller->Receive(tmp, numIds, ii, 342320);
-    // Merge the values.
-    for (int jj = 0; jj < numIds; ++jj)
+    int localUpdated = (merged || !setIdsToSend.empty()) ? 1 : 0;
+    int globalUpdated = 0;
+    this->Controller->AllReduce(&localUpdated, &globalUpdated, 1, vtkCommunicator::MAX_OP);
+    if (!globalUpdated)
+    {
+      break;
+    }
+
+    queries.clear();
+    boundarySet->GetSetIds(roots);
+    for (int root : roots)
     {
-      if (tmp[jj] != jj)
-      { // TODO: Make sure this is efficient.  Avoid n^2.
-        globalSet->AddEquivalence(jj, tmp[jj]);
+      const int owner = FindFragmentOwner(this->LocalToGlobalOffsets, numProcs, root);
+      if (owner != myProcId)
+      {
+        queries[owner].push_back(root);
       }
     }
-  }
-  delete[] tmp;
+    destinations.clear();
+    for (auto& item : setIdsToSend)
+    {
+      destinations.push_back(item.first);
+    }
+    for (auto& item : queries)
+    {
+      destinations.push_back(item.first);
+    }
+    FindExchangePartners(this->Controller, destinations, partners);
 
-  // Make the set ids sequential.
-  this->NumberOfResolvedFragments = globalSet->ResolveEquivalences();
+    // Send the set ids of the ids the partner owns, and the set ids we
+    // want the partner's set id of.
+    merged = 0;
+    receivedQueries.assign(partners.size(), vector<int>());
+    for (size_t kk = 0; kk < partners.size(); ++kk)
+    {
+      const int otherProc = partners[kk];
+      sendBuf.assign(1, 0);
+      auto toSend = setIdsToSend.find(otherProc);
+      if (toSend != setIdsToSend.end())
+      {
+        sendBuf[0] = static_cast<int>(toSend->second.size());
+        sendBuf.insert(sendBuf.end(), toSend->second.begin(), toSend->second.end());
+      }
+      auto toAsk = queries.find(otherProc);
+      if (toAsk != queries.end())
+      {
+        sendBuf.insert(sendBuf.end(), toAsk->second.begin(), toAsk->second.end());
+      }
+      ExchangeIds(this->Controller, sendBuf, recvBuf, otherProc, 342320);
+      const size_t numSetIds = recvBuf.empty() ? 0 : static_cast<size_t>(recvBuf[0]) + 1;
+      for (size_t ii = 1; ii + 1 < numSetIds; ii += 2)
+      {
+        merged = boundarySet->AddEquivalence(recvBuf[ii], recvBuf[ii + 1]) || merged;
+      }
+      if (numSetIds < recvBuf.size())
+      {
+        receivedQueries[kk].assign(recvBuf.begin() + numSetIds, recvBuf.end());
+      }
+    }
 
-  // The pointers should still be valid.
-  // The array should not resize here.
-  // Number of resolved fragemnts will be smaller
-  // than TotalNumberOfRawFragments
-  for (int ii = 1; ii < numProcs; ++ii)
-  {
-    this->Controller->Send(&this->NumberOfResolvedFragments, 1, ii, 342321);
-    // Domain has numIds,  range has NumberOfResolvedFragments
-    this->Controller->Send(buf, numIds, ii, 342322);
+    // Answer with the set ids updated by the ones we just received.
+    for (size_t kk = 0; kk < partners.size(); ++kk)
+    {
+      sendBuf.clear();
+      for (int setId : receivedQueries[kk])
+      {
+        sendBuf.push_back(setId);
+        sendBuf.push_back(boundarySet->GetEquivalentSetId(setId));
+      }
+      ExchangeIds(this->Controller, sendBuf, recvBuf, partners[kk], 342322);
+      merged = boundarySet->AddEquivalences(recvBuf) || merged;
+    }
+    ++numberOfRounds;
   }
+
+  vtkLogF(TRACE, "%d boundary set ids merged in %d rounds", boundarySet->GetNumberOfMembers(),
+    numberOfRounds);
 }
 
 //----------------------------------------------------------------------------
-void vtkMaterialInterfaceFilter::ShareGhostEquivalences(
-  vtkMaterialInterfaceEquivalenceSet* globalSet, int* procOffsets)
+// Assign sequential ids to the resolved sets.  Sets are numbered by process,
+// using the number of sets whose smallest member each process owns.  The
+// resolved id of a set that spans processes is then asked from the process
+// that owns its smallest member.  Every process only gets the ids of its
+// own fragments.
+void vtkMaterialInterfaceFilter::ResolveGlobalSetIds(vtkMaterialInterfaceEquivalenceSet* set,
+  vtkMaterialInterfaceUnionFind* boundarySet, const vector<int>& localSetIds)
 {
   const int numProcs = this->Controller->GetNumberOfProcesses();
   const int myProcId = this->Controller->GetLocalProcessId();
-  int sendMsg[8];
+  const int numLocalMembers = static_cast<int>(localSetIds.size());
+  const int myOffset = this->LocalToGlobalOffsets[myProcId];
 
-  // Loop through the other processes.
-  for (int otherProc = 0; otherProc < numProcs; ++otherProc)
+  // A fragment that is the smallest member of its global set starts a
+  // new resolved set.
+  vector<int> resolvedIds(numLocalMembers, -1);
+  int numLocalSets = 0;
+  for (int ii = 0; ii < numLocalMembers; ++ii)
   {
-    if (otherProc == myProcId)
+    if (localSetIds[ii] == ii && boundarySet->GetEquivalentSetId(ii + myOffset) == ii + myOffset)
     {
-      this->ReceiveGhostFragmentIds(globalSet, procOffsets);
+      resolvedIds[ii] = numLocalSets++;
     }
-    else
+  }
+
+  // Sets are numbered in process order.
+  vector<int> numSetsInProcess(numProcs);
+  this->Controller->AllGather(&numLocalSets, numSetsInProcess.data(), 1);
+  int firstSetId = 0;
+  this->NumberOfResolvedFragments = 0;
+  for (int ii = 0; ii < numProcs; ++ii)
+  {
+    if (ii == myProcId)
     {
-      // Loop through our ghost blocks sending the
-      // ones that are owned by otherProc.
-      int num = static_cast<int>(this->GhostBlocks.size());
-      for (int blockId = 0; blockId < num; ++blockId)
+      firstSetId = this->NumberOfResolvedFragments;
+    }
+    this->NumberOfResolvedFragments += numSetsInProcess[ii];
+  }
+  for (int ii = 0; ii < numLocalMembers; ++ii)
+  {
+    if (resolvedIds[ii] >= 0)
+    {
+      resolvedIds[ii] += firstSetId;
+    }
+  }
+
+  // Ask the owners of the smallest members of our sets that span
+  // processes for their resolved ids.
+  std::map<int, vector<int>> queries;
+  std::unordered_map<int, int> boundaryResolvedIds;
+  for (int ii = 0; ii < numLocalMembers; ++ii)
+  {
+    const int setId = boundarySet->GetEquivalentSetId(localSetIds[ii] + myOffset);
+    const int owner = FindFragmentOwner(this->LocalToGlobalOffsets, numProcs, setId);
+    if (owner != myProcId && boundaryResolvedIds.emplace(setId, -1).second)
+    {
+      queries[owner].push_back(setId);
+    }
+  }
+  vector<int> destinations;
+  for (auto& item : queries)
+  {
+    destinations.push_back(item.first);
+  }
+  vector<int> partners;
+  FindExchangePartners(this->Controller, destinations, partners);
+
+  vector<int> sendBuf;
+  vector<int> recvBuf;
+  vector<int> empty;
+  for (int otherProc : partners)
+  {
+    auto toAsk = queries.find(otherProc);
+    ExchangeIds(
+      this->Controller, toAsk != queries.end() ? toAsk->second : empty, recvBuf, otherProc, 342324);
+    sendBuf.clear();
+    for (int setId : recvBuf)
+    {
+      const int localId = setId - myOffset;
+      sendBuf.push_back(setId);
+      sendBuf.push_back(localId >= 0 && localId < numLocalMembers ? resolvedIds[localId] : -1);
+    }
+    ExchangeIds(this->Controller, sendBuf, recvBuf, otherProc, 342326);
+    for (size_t ii = 0; ii + 1 < recvBuf.size(); ii += 2)
+    {
+      boundaryResolvedIds[recvBuf[ii]] = recvBuf[ii + 1];
+    }
+  }
+
+  // Now every fragment can be resolved.
+  for (int ii = 0; ii < numLocalMembers; ++ii)
+  {
+    if (resolvedIds[ii] < 0)
+    {
+      const int setId = boundarySet->GetEquivalentSetId(localSetIds[ii] + myOffset);
+      if (setId >= myOffset && setId < myOffset + numLocalMembers)
+      {
+        resolvedIds[ii] = resolvedIds[setId - myOffset];
+      }
+      else
       {
-        vtkMaterialInterfaceFilterBlock* block = this->GhostBlocks[blockId];
-        if (block && block->GetOwnerProcessId() == otherProc && block->GetGhostFlag())
+        auto iter = boundaryResolvedIds.find(setId);
+        if (iter == boundaryResolvedIds.end() || iter->second < 0)
         {
-          sendMsg[0] = myProcId;
-          // Since this is a ghost block, the remote block id
-          // will be different than the id we use.
-          // We just want to make it easy for the process that owns this block
-          // to match the ghost block with the aoriginal.
-          sendMsg[1] = block->GetBlockId();
-          int* ext = sendMsg + 2;
-          block->GetCellExtent(ext);
-          this->Controller->Send(sendMsg, 8, otherProc, 722265);
-          // Now send the fragment id array.
-          int* framentIds = block->GetFragmentIdPointer();
-          this->Controller->Send(framentIds,
-            (ext[1] - ext[0] + 1) * (ext[3] - ext[2] + 1) * (ext[5] - ext[4] + 1), otherProc,
-            722266);
-        } // End if ghost  block owned by other process.
-      }   // End loop over all blocks.
-      // Send the message that indicates we have nothing more to send.
-      sendMsg[0] = myProcId;
-      sendMsg[1] = -1;
-      this->Controller->Send(sendMsg, 8, otherProc, 722265);
-    } // End if we should send or receive.
-  }   // End loop over all processes.
-}
-
-//----------------------------------------------------------------------------
-// Receive all the gost blocks from remote processes and
-// find the equivalences.
-void vtkMaterialInterfaceFilter::ReceiveGhostFragmentIds(
-  vtkMaterialInterfaceEquivalenceSet* globalSet, int* procOffsets)
-{
-  int msg[8];
-  int otherProc;
-  int blockId;
-  vtkMaterialInterfaceFilterBlock* block;
-  int bufSize = 0;
-  int* buf = nullptr;
-  int dataSize;
-  int* remoteExt;
-  int localId, remoteId;
+          vtkErrorMacro("Missing resolved id for fragment set " << setId << ".");
+          resolvedIds[ii] = 0;
+        }
+        else
+        {
+          resolvedIds[ii] = iter->second;
+        }
+      }
+    }
+  }
+
+  // The ids will be the global ids so the GetId method will work.
+  set->SetResolvedSetIds(myOffset, resolvedIds.data(), numLocalMembers);
+}
+
+//----------------------------------------------------------------------------
+// Exchange the fragment ids of ghost blocks with the processes that own
+// them, and find the equivalences between local and remote sets.
+void vtkMaterialInterfaceFilter::ShareGhostEquivalences(vtkMaterialInterfaceUnionFind* boundarySet,
+  const vector<int>& localSetIds, int* procOffsets, vector<int>& neighbors)
+{
   const int myProcId = this->Controller->GetLocalProcessId();
-  int localOffset = procOffsets[myProcId];
-  int remoteOffset;
+  const int numLocalMembers = static_cast<int>(localSetIds.size());
+  const int localOffset = procOffsets[myProcId];
 
-  // We do not receive requests from our own process.
-  int remainingProcs = this->Controller->GetNumberOfProcesses() - 1;
-  while (remainingProcs != 0)
+  // We exchange with the processes that own our ghost blocks and
+  // with the processes that hold our blocks as ghosts. The relation
+  // is symmetric so both processes of a pair agree on it.
+  neighbors = this->GhostBlockRequestingProcesses;
+  for (vtkMaterialInterfaceFilterBlock* block : this->GhostBlocks)
   {
-    this->Controller->Receive(msg, 8, vtkMultiProcessController::ANY_SOURCE, 722265);
-    otherProc = msg[0];
-    blockId = msg[1];
-    if (blockId == -1)
+    if (block && block->GetGhostFlag())
     {
-      --remainingProcs;
+      neighbors.push_back(block->GetOwnerProcessId());
     }
-    else
+  }
+  std::sort(neighbors.begin(), neighbors.end());
+  neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+
+  vector<int> sendBuf;
+  vector<int> recvBuf;
+  for (int otherProc : neighbors)
+  {
+    // Pack the ghost blocks owned by otherProc.
+    sendBuf.clear();
+    for (vtkMaterialInterfaceFilterBlock* block : this->GhostBlocks)
     {
-      // Find the block.
-      block = this->InputBlocks[blockId];
-      if (block == nullptr)
-      { // Sanity check. This will lock up!
-        vtkErrorMacro("Missing block request.");
-        return;
-      }
-      // Receive the ghost fragment ids.
-      remoteExt = msg + 2;
-      dataSize = (remoteExt[1] - remoteExt[0] + 1) * (remoteExt[3] - remoteExt[2] + 1) *
-        (remoteExt[5] - remoteExt[4] + 1);
-      if (bufSize < dataSize)
+      if (block && block->GetOwnerProcessId() == otherProc && block->GetGhostFlag())
       {
-        delete[] buf;
-        buf = new int[dataSize];
-        bufSize = dataSize;
+        // Since this is a ghost block, the remote block id
+        // will be different than the id we use.
+        // We just want to make it easy for the process that owns this block
+        // to match the ghost block with the aoriginal.
+        sendBuf.push_back(block->GetBlockId());
+        int ext[6];
+        block->GetCellExtent(ext);
+        sendBuf.insert(sendBuf.end(), ext, ext + 6);
+        // Send the set ids rather than the fragment ids.
+        int* fragmentIds = block->GetFragmentIdPointer();
+        int num = (ext[1] - ext[0] + 1) * (ext[3] - ext[2] + 1) * (ext[5] - ext[4] + 1);
+        for (int ii = 0; ii < num; ++ii)
+        {
+          const int id = fragmentIds[ii];
+          sendBuf.push_back(id >= 0 && id < numLocalMembers ? localSetIds[id] : -1);
+        }
       }
-      remoteOffset = procOffsets[otherProc];
-      this->Controller->Receive(buf, dataSize, otherProc, 722266);
-      // We have our block, and the remote fragmentIds.
-      // Now for the equivalences.
+    }
+    ExchangeIds(this->Controller, sendBuf, recvBuf, otherProc, 722265);
+
+    // We have our blocks, and the remote set ids.
+    // Now for the equivalences.
+    const int remoteOffset = procOffsets[otherProc];
+    size_t pos = 0;
+    while (pos + 7 <= recvBuf.size())
+    {
+      int blockId = recvBuf[pos];
+      const int* remoteExt = recvBuf.data() + pos + 1;
+      pos += 7;
+      const size_t dataSize = static_cast<size_t>(remoteExt[1] - remoteExt[0] + 1) *
+        (remoteExt[3] - remoteExt[2] + 1) * (remoteExt[5] - remoteExt[4] + 1);
+      if (blockId < 0 || blockId >= this->NumberOfInputBlocks ||
+        this->InputBlocks[blockId] == nullptr || pos + dataSize > recvBuf.size())
+      { // Sanity check.  Keep going so the other processes do not lock up.
+        vtkErrorMacro("Missing block request.");
+        break;
+      }
+      const int* remoteSetIds = recvBuf.data() + pos;
+      pos += dataSize;
+
       // Loop through all of the voxels.
-      int* remoteFragmentIds = buf;
+      vtkMaterialInterfaceFilterBlock* block = this->InputBlocks[blockId];
       int* localFragmentIds = block->GetFragmentIdPointer();
       int localExt[6];
       int localIncs[3];
@@ -8381,14 +8701,15 @@ void vtkMaterialInterfaceFilter::ReceiveGhostFragmentIds(
           px = py;
           for (int ix = remoteExt[0]; ix <= remoteExt[1]; ++ix)
           {
-            // Convert local fragment ids to global ids.
-            localId = *px;
-            remoteId = *remoteFragmentIds;
-            if (localId >= 0 && remoteId >= 0)
+            // Convert local set ids to global ids.
+            const int localId = *px;
+            const int remoteId = *remoteSetIds;
+            if (localId >= 0 && localId < numLocalMembers && remoteId >= 0)
             {
-              globalSet->AddEquivalence(localId + localOffset, remoteId + remoteOffset);
+              boundarySet->AddEquivalence(
+                localSetIds[localId] + localOffset, remoteId + remoteOffset);
             }
-            ++remoteFragmentIds;
+            ++remoteSetIds;
             ++px;
           }
           py += localIncs[1];
@@ -8397,7 +8718,6 @@ void vtkMaterialInterfaceFilter::ReceiveGhostFragmentIds(
       }
     }
   }
-  delete[] buf;
 }
 
 //----------------------------------------------------------------------------
@@ -19,6 +19,13 @@
  * \code{.cpp}
  * #define vtkMaterialInterfaceFilterPROFILE
  * \endcode
+ *
+ * Local blocks are processed concurrently using vtkSMPTools, fragments
+ * crossing block boundaries are joined before they are resolved between
+ * processes.
+ *
+ * The time taken by each phase of the resolution of fragments split between
+ * processes is logged with TRACE verbosity.
  */
 
 #ifndef vtkMaterialInterfaceFilter_h
@@ -51,7 +58,9 @@ class vtkMaterialInterfaceLevel;
 class vtkMaterialInterfaceFilterBlock;
 class vtkMaterialInterfaceFilterIterator;
 class vtkMaterialInterfaceEquivalenceSet;
+class vtkMaterialInterfaceUnionFind;
 class vtkMaterialInterfaceFilterRingBuffer;
+class vtkMaterialInterfaceFilterWorkspace;
 class vtkMaterialInterfacePieceLoading;
 class vtkMaterialInterfaceCommBuffer;
 
@@ -337,22 +346,27 @@ protected:
     std::vector<std::string>& integratedArrayNames);
   // Create a new fragment/piece.
   vtkPolyData* NewFragmentMesh();
+  // Process all local blocks, concurrently when possible.
+  void ProcessBlocks();
+  // Move the fragments found using a workspace to the arrays indexed by fragment id.
+  void CollectFragments(vtkMaterialInterfaceFilterWorkspace* ws, int firstFragmentId);
   // Process each cell, looking for fragments.
-  int ProcessBlock(int blockId);
+  int ProcessBlock(vtkMaterialInterfaceFilterWorkspace* ws, int blockId);
   // Cell has been identified as inside the fragment. Integrate, and
   // generate fragment surface etc...
-  void ConnectFragment(vtkMaterialInterfaceFilterRingBuffer* iterator);
+  void ConnectFragment(
+    vtkMaterialInterfaceFilterWorkspace* ws, vtkMaterialInterfaceFilterRingBuffer* iterator);
   void GetNeighborIterator(vtkMaterialInterfaceFilterIterator* next,
     vtkMaterialInterfaceFilterIterator* iterator, int axis0, int maxFlag0, int axis1, int maxFlag1,
     int axis2, int maxFlag2);
   void GetNeighborIteratorPad(vtkMaterialInterfaceFilterIterator* next,
     vtkMaterialInterfaceFilterIterator* iterator, int axis0, int maxFlag0, int axis1, int maxFlag1,
     int axis2, int maxFlag2);
-  void CreateFace(vtkMaterialInterfaceFilterIterator* in, vtkMaterialInterfaceFilterIterator* out,
-    int axis, int outMaxFlag);
+  void CreateFace(vtkMaterialInterfaceFilterWorkspace* ws, vtkMaterialInterfaceFilterIterator* in,
+    vtkMaterialInterfaceFilterIterator* out, int axis, int outMaxFlag);
   int ComputeDisplacementFactors(vtkMaterialInterfaceFilterIterator* pointNeighborIterators[8],
     double displacmentFactors[3], int rootNeighborIdx, int faceAxis);
-  int SubVoxelPositionCorner(double* point,
+  int SubVoxelPositionCorner(vtkMaterialInterfaceFilterWorkspace* ws, double* point,
     vtkMaterialInterfaceFilterIterator* pointNeighborIterators[8], int rootNeighborIdx,
     int faceAxis);
   void FindPointNeighbors(vtkMaterialInterfaceFilterIterator* iteratorMin0,
@@ -365,6 +379,8 @@ protected:
   int GetNumberOfLocalBlocks(vtkNonOverlappingAMR* input);
   // Complex ghost layer Handling.
   std::vector<vtkMaterialInterfaceFilterBlock*> GhostBlocks;
+  // Processes that requested ghost blocks from us (may contain duplicates).
+  std::vector<int> GhostBlockRequestingProcesses;
   void ShareGhostBlocks();
   void HandleGhostBlockRequests();
   int ComputeRequiredGhostExtent(int level, int inExt[6], int outExt[6]);
@@ -375,51 +391,30 @@ protected:
   vtkMultiProcessController* Controller;
 
   vtkMaterialInterfaceEquivalenceSet* EquivalenceSet;
-  void AddEquivalence(
+  void AddEquivalence(vtkMaterialInterfaceFilterWorkspace* ws,
     vtkMaterialInterfaceFilterIterator* neighbor1, vtkMaterialInterfaceFilterIterator* neighbor2);
   //
   void PrepareForResolveEquivalences();
   //
   void ResolveEquivalences();
   void GatherEquivalenceSets(vtkMaterialInterfaceEquivalenceSet* set);
-  void ShareGhostEquivalences(vtkMaterialInterfaceEquivalenceSet* globalSet, int* procOffsets);
-  void ReceiveGhostFragmentIds(vtkMaterialInterfaceEquivalenceSet* globalSet, int* procOffset);
-  void MergeGhostEquivalenceSets(vtkMaterialInterfaceEquivalenceSet* globalSet);
+  void ShareGhostEquivalences(vtkMaterialInterfaceUnionFind* boundarySet,
+    const std::vector<int>& localSetIds, int* procOffsets, std::vector<int>& neighbors);
+  void MergeGhostEquivalenceSets(vtkMaterialInterfaceUnionFind* boundarySet);
+  void ResolveGlobalSetIds(vtkMaterialInterfaceEquivalenceSet* set,
+    vtkMaterialInterfaceUnionFind* boundarySet, const std::vector<int>& localSetIds);
 
   // Sum/finalize attribute's contribution for those
   // which are split over multiple processes.
   int ResolveIntegratedAttributes(int controllingProcId);
+  // Sum the attributes of local fragments that resolve to the same
+  // fragment. Returns the resolved id of each remaining tuple.
+  int SumIntegratedAttributesBySet(std::vector<int>& resolvedIds);
   // Initialize our attribute arrays to ho9ld resolved attributes
   int PrepareToResolveIntegratedAttributes();
+  // Get the integrated attribute arrays, in the order they are reduced.
+  void GetIntegratedAttributeArrays(std::vector<vtkDoubleArray*>& arrays);
 
-  // Send my integrated attributes to another process.
-  int SendIntegratedAttributes(int recipientProcId);
-  // Receive integrated attributes from another process.
-  int ReceiveIntegratedAttributes(int sourceProcId);
-  // Size buffers etc...
-  int PrepareToCollectIntegratedAttributes(std::vector<vtkMaterialInterfaceCommBuffer>& buffers,
-    std::vector<vtkDoubleArray*>& volumes, std::vector<vtkDoubleArray*>& clipDepthMaxs,
-    std::vector<vtkDoubleArray*>& clipDepthMins, std::vector<vtkDoubleArray*>& moments,
-    std::vector<std::vector<vtkDoubleArray*>>& volumeWtdAvgs,
-    std::vector<std::vector<vtkDoubleArray*>>& massWtdAvgs,
-    std::vector<std::vector<vtkDoubleArray*>>& sums);
-  // Free resources.
-  int CleanUpAfterCollectIntegratedAttributes(std::vector<vtkMaterialInterfaceCommBuffer>& buffers,
-    std::vector<vtkDoubleArray*>& volumes, std::vector<vtkDoubleArray*>& clipDepthMaxs,
-    std::vector<vtkDoubleArray*>& clipDepthMins, std::vector<vtkDoubleArray*>& moments,
-    std::vector<std::vector<vtkDoubleArray*>>& volumeWtdAvgs,
-    std::vector<std::vector<vtkDoubleArray*>>& massWtdAvgs,
-    std::vector<std::vector<vtkDoubleArray*>>& sums);
-  // Receive all integrated attribute arrays from all other
-  // processes.
-  int CollectIntegratedAttributes(std::vector<vtkMaterialInterfaceCommBuffer>& buffers,
-    std::vector<vtkDoubleArray*>& volumes, std::vector<vtkDoubleArray*>& clipDepthMaxs,
-    std::vector<vtkDoubleArray*>& clipDepthMins, std::vector<vtkDoubleArray*>& moments,
-    std::vector<std::vector<vtkDoubleArray*>>& volumeWtdAvgs,
-    std::vector<std::vector<vtkDoubleArray*>>& massWtdAvgs,
-    std::vector<std::vector<vtkDoubleArray*>>& sums);
-  // Send my integrated attributes to all other processes.
-  int BroadcastIntegratedAttributes(int sourceProcessId);
   // Send my geometric attribuites to a controller.
   int SendGeometricAttributes(int controllingProcId);
   // size buffers & new containers
@@ -514,36 +509,23 @@ protected:
   char* MaterialFractionArrayName;
   vtkSetStringMacro(MaterialFractionArrayName);
 
-  // while processing a material array this holds
-  // a pointer to the output poly data
-  // data set
-  vtkPolyData* CurrentFragmentMesh;
   // As pieces/fragments are found they are stored here
   // until resolution.
   std::vector<vtkPolyData*> FragmentMeshes;
 
-  // TODO? this could be cleaned up (somewhat) by
-  // adding an integration class which encapsulates
-  // all of the supported operations.
+  // The accumulators for the current fragment are kept in
+  // vtkMaterialInterfaceFilterWorkspace.
   /// class vtkMaterialInterfaceFilterIntegrator
   ///{
-  // Local id of current fragment
-  int FragmentId;
-  // Accumulator for the volume of the current fragment.
-  double FragmentVolume;
   // Fragment volumes indexed by the fragment id. It's a local
   // per-process indexing until fragments have been resolved
   vtkDoubleArray* FragmentVolumes;
 
   // Min and max depth of crater.
   // These are only computed when the clip plane is on.
-  double ClipDepthMin;
-  double ClipDepthMax;
   vtkDoubleArray* ClipDepthMinimums;
   vtkDoubleArray* ClipDepthMaximums;
 
-  // Accumulator for moments of the current fragment
-  std::vector<double> FragmentMoment; // =(Myz, Mxz, Mxy, m)
   // Moments indexed by fragment id
   vtkDoubleArray* FragmentMoments;
   // Centers of fragment AABBs, only computed if moments are not
@@ -552,8 +534,6 @@ protected:
   bool ComputeMoments;
 
   // Weighted average, where weights correspond to fragment volume.
-  // Accumulators one for each array to average, scalar or vector
-  std::vector<std::vector<double>> FragmentVolumeWtdAvg;
   // weighted averages indexed by fragment id.
   std::vector<vtkDoubleArray*> FragmentVolumeWtdAvgs;
   // number of arrays for which to compute the weighted average
@@ -562,8 +542,6 @@ protected:
   std::vector<std::string> VolumeWtdAvgArrayNames;
 
   // Weighted average, where weights correspond to fragment mass.
-  // Accumulators one for each array to average, scalar or vector
-  std::vector<std::vector<double>> FragmentMassWtdAvg;
   // weighted averages indexed by fragment id.
   std::vector<vtkDoubleArray*> FragmentMassWtdAvgs;
   // number of arrays for which to compute the weighted average
@@ -580,8 +558,6 @@ protected:
   int NToIntegrate;
 
   // Sum of data over the fragment.
-  // Accumulators, one for each array to sum
-  std::vector<std::vector<double>> FragmentSum;
   // sums indexed by fragment id.
   std::vector<vtkDoubleArray*> FragmentSums;
   // number of arrays for which to compute the weighted average
@@ -645,20 +621,14 @@ protected:
   // It could be changed into the primary storage of blocks.
   std::vector<vtkMaterialInterfaceLevel*> Levels;
 
-  // Ivars for computing the point on corners and edges of a face.
-  vtkMaterialInterfaceFilterIterator* FaceNeighbors;
-  // Permutation of the neighbors. Axis0 normal to face.
-  int faceAxis0;
-  int faceAxis1;
-  int faceAxis2;
-  double FaceCornerPoints[12];
-  double FaceEdgePoints[12];
-  int FaceEdgeFlags[4];
+  // For computing the point on corners and edges of a face.
   // outMaxFlag implies out is positive direction of axis.
-  void ComputeFacePoints(vtkMaterialInterfaceFilterIterator* in,
-    vtkMaterialInterfaceFilterIterator* out, int axis, int outMaxFlag);
-  void ComputeFaceNeighbors(vtkMaterialInterfaceFilterIterator* in,
-    vtkMaterialInterfaceFilterIterator* out, int axis, int outMaxFlag);
+  void ComputeFacePoints(vtkMaterialInterfaceFilterWorkspace* ws,
+    vtkMaterialInterfaceFilterIterator* in, vtkMaterialInterfaceFilterIterator* out, int axis,
+    int outMaxFlag);
+  void ComputeFaceNeighbors(vtkMaterialInterfaceFilterWorkspace* ws,
+    vtkMaterialInterfaceFilterIterator* in, vtkMaterialInterfaceFilterIterator* out, int axis,
+    int outMaxFlag);
 
   long ComputeProximity(const int faceIdx[3], int faceLevel, const int ext[6], int refLevel);
 
@@ -2,23 +2,307 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkPVGenerateGlobalIds.h"
 
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
 #include "vtkDataSet.h"
+#include "vtkDataSetAttributes.h"
 #include "vtkDemandDrivenPipeline.h"
 #include "vtkGenerateGlobalIds.h"
 #include "vtkHyperTreeGrid.h"
 #include "vtkHyperTreeGridGenerateGlobalIds.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkLogger.h"
+#include "vtkMatrix3x3.h"
+#include "vtkMultiProcessController.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRectilinearGrid.h"
+#include "vtkSmartPointer.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkStructuredGrid.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <cstring>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace
+{
+/**
+ * Identifies the mesh of a dataset. `MTimes` are those of its points, cells
+ * and ghost arrays, which are compared first; `Arrays` are the arrays whose
+ * content is hashed when the MTimes differ.
+ */
+struct vtkMeshKey
+{
+  std::string ClassName;
+  vtkIdType NumberOfPoints = 0;
+  vtkIdType NumberOfCells = 0;
+  std::vector<double> Structure;
+  std::vector<vtkMTimeType> MTimes;
+  std::vector<vtkDataArray*> Arrays;
+
+  bool HasSameStructure(const vtkMeshKey& other) const
+  {
+    return this->ClassName == other.ClassName && this->NumberOfPoints == other.NumberOfPoints &&
+      this->NumberOfCells == other.NumberOfCells && this->Structure == other.Structure;
+  }
+};
+
+void vtkAddMeshObject(vtkMeshKey& key, vtkObject* object, vtkDataArray* array)
+{
+  key.MTimes.push_back(object ? object->GetMTime() : 0);
+  key.Arrays.push_back(array);
+}
+
+void vtkAddCells(vtkMeshKey& key, vtkCellArray* cells)
+{
+  vtkAddMeshObject(key, cells, cells ? cells->GetOffsetsArray() : nullptr);
+  vtkAddMeshObject(key, cells, cells ? cells->GetConnectivityArray() : nullptr);
+}
+
+void vtkAddStructure(vtkMeshKey& key, const int extent[6])
+{
+  key.Structure.insert(key.Structure.end(), extent, extent + 6);
+}
+
+// Returns false for dataset types whose mesh cannot be identified.
+bool vtkGetMeshKey(vtkDataSet* ds, vtkMeshKey& key)
+{
+  key = vtkMeshKey();
+  key.ClassName = ds->GetClassName();
+  key.NumberOfPoints = ds->GetNumberOfPoints();
+  key.NumberOfCells = ds->GetNumberOfCells();
+  for (vtkDataSetAttributes* attributes :
+    { static_cast<vtkDataSetAttributes*>(ds->GetPointData()),
+      static_cast<vtkDataSetAttributes*>(ds->GetCellData()) })
+  {
+    vtkDataArray* ghosts = attributes->GetArray(vtkDataSetAttributes::GhostArrayName());
+    vtkAddMeshObject(key, ghosts, ghosts);
+  }
+
+  if (auto ug = vtkUnstructuredGrid::SafeDownCast(ds))
+  {
+    vtkPoints* points = ug->GetPoints();
+    vtkAddMeshObject(key, points, points ? points->GetData() : nullptr);
+    vtkAddCells(key, ug->GetCells());
+    vtkAddMeshObject(key, ug->GetCellTypesArray(), ug->GetCellTypesArray());
+  }
+  else if (auto pd = vtkPolyData::SafeDownCast(ds))
+  {
+    vtkPoints* points = pd->GetPoints();
+    vtkAddMeshObject(key, points, points ? points->GetData() : nullptr);
+    vtkAddCells(key, pd->GetVerts());
+    vtkAddCells(key, pd->GetLines());
+    vtkAddCells(key, pd->GetPolys());
+    vtkAddCells(key, pd->GetStrips());
+  }
+  else if (auto sg = vtkStructuredGrid::SafeDownCast(ds))
+  {
+    vtkPoints* points = sg->GetPoints();
+    vtkAddMeshObject(key, points, points ? points->GetData() : nullptr);
+    vtkAddStructure(key, sg->GetExtent());
+  }
+  else if (auto rg = vtkRectilinearGrid::SafeDownCast(ds))
+  {
+    vtkAddMeshObject(key, rg->GetXCoordinates(), rg->GetXCoordinates());
+    vtkAddMeshObject(key, rg->GetYCoordinates(), rg->GetYCoordinates());
+    vtkAddMeshObject(key, rg->GetZCoordinates(), rg->GetZCoordinates());
+    vtkAddStructure(key, rg->GetExtent());
+  }
+  else if (auto image = vtkImageData::SafeDownCast(ds))
+  {
+    vtkAddStructure(key, image->GetExtent());
+    key.Structure.insert(key.Structure.end(), image->GetOrigin(), image->GetOrigin() + 3);
+    key.Structure.insert(key.Structure.end(), image->GetSpacing(), image->GetSpacing() + 3);
+    const double* direction = image->GetDirectionMatrix()->GetData();
+    key.Structure.insert(key.Structure.end(), direction, direction + 9);
+  }
+  else
+  {
+    return false;
+  }
+  return true;
+}
+
+vtkTypeUInt64 vtkMix(vtkTypeUInt64 hash, vtkTypeUInt64 value)
+{
+  hash ^= value;
+  hash *= 0x9e3779b97f4a7c15ull;
+  return hash ^ (hash >> 32);
+}
+
+// Hashes the raw values of the mesh arrays. This is a single pass over memory,
+// much cheaper than merging points across ranks.
+vtkTypeUInt64 vtkComputeHash(const vtkMeshKey& key)
+{
+  vtkTypeUInt64 hash = 0;
+  for (vtkDataArray* array : key.Arrays)
+  {
+    if (!array)
+    {
+      hash = vtkMix(hash, 0);
+      continue;
+    }
+    const size_t size = static_cast<size_t>(array->GetNumberOfValues()) *
+      static_cast<size_t>(array->GetDataTypeSize());
+    hash = vtkMix(hash, static_cast<vtkTypeUInt64>(array->GetDataType()));
+    hash = vtkMix(hash, static_cast<vtkTypeUInt64>(size));
+    if (size == 0)
+    {
+      continue;
+    }
+    const auto* bytes = static_cast<const unsigned char*>(array->GetVoidPointer(0));
+    size_t cc = 0;
+    vtkTypeUInt64 word;
+    for (; cc + sizeof(word) <= size; cc += sizeof(word))
+    {
+      std::memcpy(&word, bytes + cc, sizeof(word));
+      hash = vtkMix(hash, word);
+    }
+    if (cc < size)
+    {
+      word = 0;
+      std::memcpy(&word, bytes + cc, size - cc);
+      hash = vtkMix(hash, word);
+    }
+  }
+  return hash;
+}
+
+// Returns true if all ranks pass true.
+bool vtkAllRanks(bool value)
+{
+  auto controller = vtkMultiProcessController::GetGlobalController();
+  int result = value ? 1 : 0;
+  if (controller && controller->GetNumberOfProcesses() > 1)
+  {
+    const int local = result;
+    controller->AllReduce(&local, &result, 1, vtkCommunicator::MIN_OP);
+  }
+  return result == 1;
+}
+
+bool vtkGetStructuredExtent(vtkDataSet* ds, int extent[6])
+{
+  if (auto image = vtkImageData::SafeDownCast(ds))
+  {
+    image->GetExtent(extent);
+  }
+  else if (auto rg = vtkRectilinearGrid::SafeDownCast(ds))
+  {
+    rg->GetExtent(extent);
+  }
+  else if (auto sg = vtkStructuredGrid::SafeDownCast(ds))
+  {
+    sg->GetExtent(extent);
+  }
+  else
+  {
+    return false;
+  }
+  return true;
+}
+}
+
+class vtkPVGenerateGlobalIds::vtkInternals
+{
+public:
+  // Output of the last point-merging execution, and the key of its input.
+  vtkSmartPointer<vtkDataSet> Output;
+  vtkMeshKey Key;
+  vtkTypeUInt64 Hash = 0;
+  vtkMTimeType FilterMTime = 0;
+
+  // Names of the point and cell arrays added by vtkGenerateGlobalIds.
+  std::set<std::string> GeneratedArrays[2];
+
+  static vtkDataSetAttributes* GetAttributes(vtkDataSet* ds, int index)
+  {
+    return index == 0 ? static_cast<vtkDataSetAttributes*>(ds->GetPointData())
+                      : static_cast<vtkDataSetAttributes*>(ds->GetCellData());
+  }
+
+  void Store(vtkDataSet* input, vtkDataSet* output, const vtkMeshKey& key, vtkTypeUInt64 hash)
+  {
+    this->Output = vtk::TakeSmartPointer(output->NewInstance());
+    this->Output->ShallowCopy(output);
+    this->Key = key;
+    this->Key.Arrays.clear();
+    this->Hash = hash;
+    for (int index = 0; index < 2; ++index)
+    {
+      vtkDataSetAttributes* inputAttributes = this->GetAttributes(input, index);
+      vtkDataSetAttributes* outputAttributes = this->GetAttributes(output, index);
+      auto& generated = this->GeneratedArrays[index];
+      generated.clear();
+      generated.insert(vtkDataSetAttributes::GhostArrayName());
+      for (int cc = 0; cc < outputAttributes->GetNumberOfArrays(); ++cc)
+      {
+        const char* name = outputAttributes->GetArrayName(cc);
+        if (name && !inputAttributes->GetAbstractArray(name))
+        {
+          generated.insert(name);
+        }
+      }
+    }
+  }
+
+  // Passes `input` to `output` with the cached generated arrays.
+  void Reuse(vtkDataSet* input, vtkDataSet* output)
+  {
+    output->ShallowCopy(input);
+    for (int index = 0; index < 2; ++index)
+    {
+      vtkDataSetAttributes* cached = this->GetAttributes(this->Output, index);
+      vtkDataSetAttributes* attributes = this->GetAttributes(output, index);
+      for (const auto& name : this->GeneratedArrays[index])
+      {
+        if (auto array = cached->GetAbstractArray(name.c_str()))
+        {
+          attributes->RemoveArray(name.c_str());
+          attributes->AddArray(array);
+        }
+      }
+      for (int attribute = 0; attribute < vtkDataSetAttributes::NUM_ATTRIBUTES; ++attribute)
+      {
+        vtkAbstractArray* array = cached->GetAbstractAttribute(attribute);
+        if (array && array->GetName() && this->GeneratedArrays[index].count(array->GetName()))
+        {
+          attributes->SetActiveAttribute(array->GetName(), attribute);
+        }
+      }
+    }
+  }
+};
 
 vtkStandardNewMacro(vtkPVGenerateGlobalIds);
 
+//----------------------------------------------------------------------------
+vtkPVGenerateGlobalIds::vtkPVGenerateGlobalIds()
+  : Internals(new vtkPVGenerateGlobalIds::vtkInternals())
+{
+}
+
+//----------------------------------------------------------------------------
+vtkPVGenerateGlobalIds::~vtkPVGenerateGlobalIds() = default;
+
 //----------------------------------------------------------------------------
 void vtkPVGenerateGlobalIds::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
   os << indent << "Tolerance: " << this->Tolerance << endl;
+  os << indent << "ComputeStructuredIdsFromExtents: " << this->ComputeStructuredIdsFromExtents
+     << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -33,13 +317,12 @@ int vtkPVGenerateGlobalIds::RequestData(vtkInformation* vtkNotUsed(request),
 
   if (inputDS && outputDS)
   {
-    vtkNew<vtkGenerateGlobalIds> generateGlobalIds;
-    generateGlobalIds->SetInputData(inputDS);
-    generateGlobalIds->SetTolerance(this->GetTolerance());
-    generateGlobalIds->Update();
-
-    outputDS->ShallowCopy(generateGlobalIds->GetOutput(0));
-    return 1;
+    if (this->ComputeStructuredIdsFromExtents &&
+      this->GenerateFromExtents(inInfo, inputDS, outputDS))
+    {
+      return 1;
+    }
+    return this->GenerateUsingCache(inputDS, outputDS);
   }
 
   vtkHyperTreeGrid* inputHTG = vtkHyperTreeGrid::GetData(inInfo);
@@ -59,6 +342,166 @@ int vtkPVGenerateGlobalIds::RequestData(vtkInformation* vtkNotUsed(request),
   return 0;
 }
 
+//----------------------------------------------------------------------------
+int vtkPVGenerateGlobalIds::GenerateUsingCache(vtkDataSet* input, vtkDataSet* output)
+{
+  auto& internals = *this->Internals;
+
+  vtkMeshKey key;
+  const bool supported = vtkGetMeshKey(input, key);
+  bool hashed = false;
+  vtkTypeUInt64 hash = 0;
+  bool unchanged = false;
+  if (supported && internals.Output && internals.FilterMTime == this->GetMTime() &&
+    internals.Key.HasSameStructure(key))
+  {
+    // the mesh is unchanged if its points and cells were not modified or, for
+    // readers that create new arrays on every time step, if their content is
+    // identical.
+    unchanged = internals.Key.MTimes == key.MTimes;
+    if (!unchanged)
+    {
+      hash = vtkComputeHash(key);
+      hashed = true;
+      unchanged = hash == internals.Hash;
+    }
+  }
+
+  // vtkGenerateGlobalIds is collective: all ranks must reuse their cache or none.
+  if (vtkAllRanks(unchanged))
+  {
+    vtkLogF(TRACE, "reusing cached global ids");
+    internals.Key.MTimes = key.MTimes;
+    internals.Reuse(input, output);
+    return 1;
+  }
+
+  vtkLogScopeF(TRACE, "generate global ids");
+  vtkNew<vtkGenerateGlobalIds> generateGlobalIds;
+  generateGlobalIds->SetInputData(input);
+  generateGlobalIds->SetTolerance(this->GetTolerance());
+  generateGlobalIds->Update();
+
+  output->ShallowCopy(generateGlobalIds->GetOutput(0));
+
+  internals.Output = nullptr;
+  if (supported)
+  {
+    internals.Store(input, output, key, hashed ? hash : vtkComputeHash(key));
+    internals.FilterMTime = this->GetMTime();
+  }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVGenerateGlobalIds::GenerateFromExtents(
+  vtkInformation* inInfo, vtkDataSet* input, vtkDataSet* output)
+{
+  int extent[6];
+  int wholeExtent[6];
+  bool supported = vtkGetStructuredExtent(input, extent) && !input->HasAnyGhostCells() &&
+    inInfo->Has(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT());
+  if (supported && input->GetNumberOfPoints() > 0)
+  {
+    inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), wholeExtent);
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      supported &= wholeExtent[2 * axis] <= extent[2 * axis] &&
+        extent[2 * axis] <= extent[2 * axis + 1] &&
+        extent[2 * axis + 1] <= wholeExtent[2 * axis + 1];
+    }
+  }
+  if (!vtkAllRanks(supported))
+  {
+    vtkLogF(TRACE, "global ids cannot be computed from extents on all ranks");
+    return false;
+  }
+
+  vtkLogScopeF(TRACE, "compute global ids from extents");
+  output->ShallowCopy(input);
+
+  const vtkIdType numberOfPoints = input->GetNumberOfPoints();
+  const vtkIdType numberOfCells = input->GetNumberOfCells();
+
+  vtkNew<vtkIdTypeArray> pointIds;
+  pointIds->SetName("GlobalPointIds");
+  pointIds->SetNumberOfTuples(numberOfPoints);
+
+  vtkNew<vtkIdTypeArray> cellIds;
+  cellIds->SetName("GlobalCellIds");
+  cellIds->SetNumberOfTuples(numberOfCells);
+
+  vtkNew<vtkUnsignedCharArray> ghosts;
+  ghosts->SetName(vtkDataSetAttributes::GhostArrayName());
+  ghosts->SetNumberOfTuples(numberOfPoints);
+  if (auto inputGhosts = input->GetPointData()->GetArray(vtkDataSetAttributes::GhostArrayName()))
+  {
+    ghosts->DeepCopy(inputGhosts);
+  }
+  else
+  {
+    ghosts->FillValue(0);
+  }
+
+  if (numberOfPoints > 0)
+  {
+    // points and cells are numbered in the whole extent, in the same order as
+    // the local ones.
+    vtkIdType wholeDims[3];
+    vtkIdType wholeCellDims[3];
+    vtkIdType cellDims[3];
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      wholeDims[axis] = wholeExtent[2 * axis + 1] - wholeExtent[2 * axis] + 1;
+      wholeCellDims[axis] = std::max<vtkIdType>(wholeDims[axis] - 1, 1);
+      cellDims[axis] = std::max(extent[2 * axis + 1] - extent[2 * axis], 1);
+    }
+
+    vtkIdType* pointIdsPtr = pointIds->GetPointer(0);
+    unsigned char* ghostsPtr = ghosts->GetPointer(0);
+    vtkIdType pointId = 0;
+    for (int k = extent[4]; k <= extent[5]; ++k)
+    {
+      for (int j = extent[2]; j <= extent[3]; ++j)
+      {
+        for (int i = extent[0]; i <= extent[1]; ++i, ++pointId)
+        {
+          pointIdsPtr[pointId] = (i - wholeExtent[0]) +
+            wholeDims[0] * ((j - wholeExtent[2]) + wholeDims[1] * (k - wholeExtent[4]));
+
+          // points on an upper face inside the whole extent belong to the
+          // piece starting there.
+          if ((i == extent[1] && i < wholeExtent[1]) || (j == extent[3] && j < wholeExtent[3]) ||
+            (k == extent[5] && k < wholeExtent[5]))
+          {
+            ghostsPtr[pointId] |= vtkDataSetAttributes::DUPLICATEPOINT;
+          }
+        }
+      }
+    }
+
+    vtkIdType* cellIdsPtr = cellIds->GetPointer(0);
+    vtkIdType cellId = 0;
+    for (int k = extent[4]; k < extent[4] + cellDims[2]; ++k)
+    {
+      for (int j = extent[2]; j < extent[2] + cellDims[1]; ++j)
+      {
+        for (int i = extent[0]; i < extent[0] + cellDims[0]; ++i, ++cellId)
+        {
+          cellIdsPtr[cellId] = (i - wholeExtent[0]) +
+            wholeCellDims[0] * ((j - wholeExtent[2]) + wholeCellDims[1] * (k - wholeExtent[4]));
+        }
+      }
+    }
+  }
+
+  output->GetPointData()->RemoveArray(vtkDataSetAttributes::GhostArrayName());
+  output->GetPointData()->AddArray(ghosts);
+  output->GetPointData()->SetGlobalIds(pointIds);
+  output->GetCellData()->SetGlobalIds(cellIds);
+  return true;
+}
+
 //----------------------------------------------------------------------------
 int vtkPVGenerateGlobalIds::FillInputPortInformation(int vtkNotUsed(port), vtkInformation* info)
 {
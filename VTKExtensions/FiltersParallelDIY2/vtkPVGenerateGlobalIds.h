@@ -11,6 +11,14 @@
  * points appropriately. vtkPVGenerateGlobalIds works across all blocks in the input datasets
  * and across all ranks.
  *
+ * Generating global ids for a vtkDataSet requires merging points across all
+ * ranks. To avoid repeating this for time-varying data on a static mesh, the
+ * generated arrays are cached and reused as long as the mesh of the input is
+ * unchanged, either because its points and cells have not been modified or
+ * because their content is identical. For structured inputs, global ids can
+ * also be computed from the extents directly (see
+ * ComputeStructuredIdsFromExtents).
+ *
  * @sa vtkGenerateGlobalIds vtkHyperTreeGridGenerateGlobalIds
  */
 
@@ -20,6 +28,10 @@
 #include "vtkPVVTKExtensionsFiltersParallelDIY2Module.h" // needed for exports
 #include "vtkPassInputTypeAlgorithm.h"
 
+#include <memory> // for std::unique_ptr
+
+class vtkDataSet;
+
 class VTKPVVTKEXTENSIONSFILTERSPARALLELDIY2_EXPORT vtkPVGenerateGlobalIds
   : public vtkPassInputTypeAlgorithm
 {
@@ -41,9 +53,28 @@ public:
   vtkGetMacro(Tolerance, double);
   ///@}
 
+  ///@{
+  /**
+   * When enabled and the input is a vtkImageData, vtkRectilinearGrid or
+   * vtkStructuredGrid without ghost cells, global ids are computed from the
+   * position of each point and cell in the whole extent, without any
+   * communication. Points on the upper faces of an extent that are not on the
+   * boundary of the whole extent are flagged as duplicate points, since they
+   * are owned by the neighboring piece. Ids differ from those generated by the
+   * default point-merging approach and Tolerance is ignored.
+   *
+   * Falls back to the default approach if any rank cannot use it.
+   *
+   * Default is false.
+   */
+  vtkSetMacro(ComputeStructuredIdsFromExtents, bool);
+  vtkGetMacro(ComputeStructuredIdsFromExtents, bool);
+  vtkBooleanMacro(ComputeStructuredIdsFromExtents, bool);
+  ///@}
+
 protected:
-  vtkPVGenerateGlobalIds() = default;
-  ~vtkPVGenerateGlobalIds() override = default;
+  vtkPVGenerateGlobalIds();
+  ~vtkPVGenerateGlobalIds() override;
 
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
   int FillInputPortInformation(int, vtkInformation*) override;
@@ -52,7 +83,23 @@ private:
   vtkPVGenerateGlobalIds(const vtkPVGenerateGlobalIds&) = delete;
   void operator=(const vtkPVGenerateGlobalIds&) = delete;
 
+  /**
+   * Generate global ids for a vtkDataSet, reusing the arrays generated by the
+   * last execution if the mesh of the input is unchanged.
+   */
+  int GenerateUsingCache(vtkDataSet* input, vtkDataSet* output);
+
+  /**
+   * Compute global ids from extents. Returns false, without modifying
+   * `output`, if `input` is not supported on every rank.
+   */
+  bool GenerateFromExtents(vtkInformation* inInfo, vtkDataSet* input, vtkDataSet* output);
+
   double Tolerance = 0.0;
+  bool ComputeStructuredIdsFromExtents = false;
+
+  class vtkInternals;
+  std::unique_ptr<vtkInternals> Internals;
 };
 
 #endif
@@ -2,28 +2,727 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkPVGhostCellsGenerator.h"
 
+#include "vtkCellArray.h"
+#include "vtkCompositeDataIterator.h"
 #include "vtkConvertToPartitionedDataSetCollection.h"
 #include "vtkDataAssembly.h"
 #include "vtkDataObjectTree.h"
 #include "vtkDataObjectTreeIterator.h"
 #include "vtkDataSet.h"
+#include "vtkDataSetAttributes.h"
 #include "vtkDemandDrivenPipeline.h"
 #include "vtkHyperTreeGrid.h"
 #include "vtkHyperTreeGridGhostCellsGenerator.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkLogger.h"
+#include "vtkMatrix3x3.h"
 #include "vtkMultiProcessController.h"
+#include "vtkMultiProcessStream.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPartitionedDataSet.h"
 #include "vtkPartitionedDataSetCollection.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRectilinearGrid.h"
+#include "vtkStructuredGrid.h"
+#include "vtkTable.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <numeric>
+#include <set>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace
+{
+constexpr const char* SOURCE_ARRAY_NAME = "__vtkPVGhostCellsGeneratorSource";
+constexpr int PLAN_TAG = 28740;
+constexpr int DATA_TAG = 28741;
+
+const int ASSOCIATIONS[] = { vtkDataObject::FIELD_ASSOCIATION_POINTS,
+  vtkDataObject::FIELD_ASSOCIATION_CELLS };
+
+using vtkLeaves = std::vector<std::pair<unsigned int, vtkDataSet*>>;
+
+// Collects the non-null leaves of `dobj` with their flat index. Returns false if
+// a leaf is not a vtkDataSet.
+bool vtkGetLeaves(vtkDataObject* dobj, vtkLeaves& leaves)
+{
+  leaves.clear();
+  if (auto ds = vtkDataSet::SafeDownCast(dobj))
+  {
+    leaves.emplace_back(0, ds);
+    return true;
+  }
+  auto tree = vtkDataObjectTree::SafeDownCast(dobj);
+  if (!tree)
+  {
+    return false;
+  }
+  auto iter = vtk::TakeSmartPointer(tree->NewIterator());
+  iter->SkipEmptyNodesOn();
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    auto ds = vtkDataSet::SafeDownCast(iter->GetCurrentDataObject());
+    if (!ds)
+    {
+      return false;
+    }
+    leaves.emplace_back(iter->GetCurrentFlatIndex(), ds);
+  }
+  return true;
+}
+
+vtkDataSetAttributes* vtkGetAttributes(vtkDataSet* ds, int association)
+{
+  return association == vtkDataObject::FIELD_ASSOCIATION_POINTS
+    ? static_cast<vtkDataSetAttributes*>(ds->GetPointData())
+    : static_cast<vtkDataSetAttributes*>(ds->GetCellData());
+}
+
+vtkIdType vtkGetNumberOfElements(vtkDataSet* ds, int association)
+{
+  return association == vtkDataObject::FIELD_ASSOCIATION_POINTS ? ds->GetNumberOfPoints()
+                                                                : ds->GetNumberOfCells();
+}
+
+vtkMTimeType vtkGetMTime(vtkObject* object)
+{
+  return object ? object->GetMTime() : 0;
+}
+
+/**
+ * Identifies the mesh of a block: two blocks with equal keys have the same
+ * points, cells and ghost flags.
+ */
+struct vtkMeshKey
+{
+  std::string ClassName;
+  vtkIdType NumberOfPoints = 0;
+  vtkIdType NumberOfCells = 0;
+  std::vector<vtkMTimeType> MTimes;
+  std::vector<double> Structure;
+
+  bool operator==(const vtkMeshKey& other) const
+  {
+    return this->ClassName == other.ClassName && this->NumberOfPoints == other.NumberOfPoints &&
+      this->NumberOfCells == other.NumberOfCells && this->MTimes == other.MTimes &&
+      this->Structure == other.Structure;
+  }
+};
+
+// Returns false for dataset types whose mesh cannot be identified.
+bool vtkGetMeshKey(vtkDataSet* ds, vtkMeshKey& key)
+{
+  key = vtkMeshKey();
+  key.ClassName = ds->GetClassName();
+  key.NumberOfPoints = ds->GetNumberOfPoints();
+  key.NumberOfCells = ds->GetNumberOfCells();
+  for (int association : ASSOCIATIONS)
+  {
+    key.MTimes.push_back(vtkGetMTime(
+      vtkGetAttributes(ds, association)->GetArray(vtkDataSetAttributes::GhostArrayName())));
+  }
+
+  int extent[6];
+  if (auto ug = vtkUnstructuredGrid::SafeDownCast(ds))
+  {
+    key.MTimes.push_back(vtkGetMTime(ug->GetPoints()));
+    key.MTimes.push_back(vtkGetMTime(ug->GetCells()));
+    key.MTimes.push_back(vtkGetMTime(ug->GetCellTypesArray()));
+  }
+  else if (auto pd = vtkPolyData::SafeDownCast(ds))
+  {
+    key.MTimes.push_back(vtkGetMTime(pd->GetPoints()));
+    key.MTimes.push_back(vtkGetMTime(pd->GetVerts()));
+    key.MTimes.push_back(vtkGetMTime(pd->GetLines()));
+    key.MTimes.push_back(vtkGetMTime(pd->GetPolys()));
+    key.MTimes.push_back(vtkGetMTime(pd->GetStrips()));
+  }
+  else if (auto sg = vtkStructuredGrid::SafeDownCast(ds))
+  {
+    key.MTimes.push_back(vtkGetMTime(sg->GetPoints()));
+    sg->GetExtent(extent);
+    key.Structure.assign(extent, extent + 6);
+  }
+  else if (auto rg = vtkRectilinearGrid::SafeDownCast(ds))
+  {
+    key.MTimes.push_back(vtkGetMTime(rg->GetXCoordinates()));
+    key.MTimes.push_back(vtkGetMTime(rg->GetYCoordinates()));
+    key.MTimes.push_back(vtkGetMTime(rg->GetZCoordinates()));
+    rg->GetExtent(extent);
+    key.Structure.assign(extent, extent + 6);
+  }
+  else if (auto image = vtkImageData::SafeDownCast(ds))
+  {
+    image->GetExtent(extent);
+    key.Structure.assign(extent, extent + 6);
+    key.Structure.insert(key.Structure.end(), image->GetOrigin(), image->GetOrigin() + 3);
+    key.Structure.insert(key.Structure.end(), image->GetSpacing(), image->GetSpacing() + 3);
+    const double* direction = image->GetDirectionMatrix()->GetData();
+    key.Structure.insert(key.Structure.end(), direction, direction + 9);
+  }
+  else
+  {
+    return false;
+  }
+  return true;
+}
+
+/**
+ * Elements of one association copied from a block on the source rank to a
+ * block on the target rank. Only the ids used by the local rank are kept.
+ */
+struct vtkTransfer
+{
+  vtkSmartPointer<vtkIdList> SourceIds = vtkSmartPointer<vtkIdList>::New();
+  vtkSmartPointer<vtkIdList> TargetIds = vtkSmartPointer<vtkIdList>::New();
+};
+
+// (source block, target block, association)
+using vtkTransferKey = std::tuple<int, int, int>;
+using vtkTransfers = std::map<vtkTransferKey, vtkTransfer>;
+
+// Exchanges messages with each partner. Partners are visited in increasing rank
+// order and the lower rank of each pair sends first, so blocking sends cannot
+// deadlock. `partners` must be symmetric across ranks.
+template <typename SendFunctor, typename ReceiveFunctor>
+void vtkExchange(vtkMultiProcessController* controller, const std::set<int>& partners,
+  SendFunctor&& send, ReceiveFunctor&& receive)
+{
+  if (partners.empty())
+  {
+    return;
+  }
+  const int rank = controller->GetLocalProcessId();
+  for (int partner : partners)
+  {
+    if (rank < partner)
+    {
+      send(partner);
+      receive(partner);
+    }
+    else
+    {
+      receive(partner);
+      send(partner);
+    }
+  }
+}
+
+// Copies the tuples `sourceIds` of the arrays of `source` to the tuples
+// `targetIds` of the arrays of `target` with the same name.
+void vtkCopyTuples(
+  vtkDataSetAttributes* target, vtkIdList* targetIds, vtkFieldData* source, vtkIdList* sourceIds)
+{
+  for (int cc = 0; cc < target->GetNumberOfArrays(); ++cc)
+  {
+    vtkAbstractArray* array = target->GetAbstractArray(cc);
+    vtkAbstractArray* sourceArray = source->GetAbstractArray(array->GetName());
+    if (sourceArray && sourceArray->GetDataType() == array->GetDataType() &&
+      sourceArray->GetNumberOfComponents() == array->GetNumberOfComponents())
+    {
+      array->InsertTuples(targetIds, sourceIds, sourceArray);
+    }
+  }
+}
+}
+
+class vtkPVGhostCellsGenerator::vtkInternals
+{
+public:
+  bool Valid = false;
+  vtkMTimeType FilterMTime = 0;
+  std::vector<vtkMeshKey> Keys;
+
+  // Output of the last full generation, without the source arrays.
+  vtkSmartPointer<vtkDataObject> Output;
+
+  // For each output block, the index of the local input block it was generated
+  // from and the names of the arrays added by the generator (ghost flags,
+  // global or process ids) which are reused as is.
+  std::vector<int> Templates;
+  std::vector<std::set<std::string>> GeneratedArrays[2];
+
+  vtkTransfers Local;
+  std::map<int, vtkTransfers> Sends;
+  std::map<int, vtkTransfers> Receives;
+
+  void Reset()
+  {
+    this->Valid = false;
+    this->Keys.clear();
+    this->Output = nullptr;
+    this->Templates.clear();
+    this->GeneratedArrays[0].clear();
+    this->GeneratedArrays[1].clear();
+    this->Local.clear();
+    this->Sends.clear();
+    this->Receives.clear();
+  }
+
+  static int AllReduceMin(vtkMultiProcessController* controller, int value)
+  {
+    int result = value;
+    if (controller && controller->GetNumberOfProcesses() > 1)
+    {
+      controller->AllReduce(&value, &result, 1, vtkCommunicator::MIN_OP);
+    }
+    return result;
+  }
+
+  static bool GetKeys(vtkDataObject* input, vtkLeaves& leaves, std::vector<vtkMeshKey>& keys)
+  {
+    if (!vtkGetLeaves(input, leaves))
+    {
+      return false;
+    }
+    keys.resize(leaves.size());
+    for (size_t cc = 0; cc < leaves.size(); ++cc)
+    {
+      if (!vtkGetMeshKey(leaves[cc].second, keys[cc]))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  static bool IsValid(const vtkLeaves& leaves, const vtkTransferKey& key, vtkIdList* ids)
+  {
+    const int block = std::get<0>(key);
+    if (block < 0 || block >= static_cast<int>(leaves.size()))
+    {
+      return false;
+    }
+    const vtkIdType count = vtkGetNumberOfElements(leaves[block].second, std::get<2>(key));
+    return std::all_of(
+      ids->begin(), ids->end(), [count](vtkIdType id) { return id >= 0 && id < count; });
+  }
+
+  /**
+   * Returns a copy of `input` in which each point and cell carries the rank,
+   * block and id it comes from.
+   */
+  static vtkSmartPointer<vtkDataObject> Tag(vtkDataObject* input, int rank)
+  {
+    auto tag = [rank](vtkDataSet* ds, int block)
+    {
+      for (int association : ASSOCIATIONS)
+      {
+        const vtkIdType count = vtkGetNumberOfElements(ds, association);
+        vtkNew<vtkIdTypeArray> source;
+        source->SetName(SOURCE_ARRAY_NAME);
+        source->SetNumberOfComponents(3);
+        source->SetNumberOfTuples(count);
+        vtkIdType* ptr = source->GetPointer(0);
+        for (vtkIdType id = 0; id < count; ++id)
+        {
+          ptr[3 * id] = rank;
+          ptr[3 * id + 1] = block;
+          ptr[3 * id + 2] = id;
+        }
+        vtkGetAttributes(ds, association)->AddArray(source);
+      }
+    };
+
+    auto tagged = vtk::TakeSmartPointer(input->NewInstance());
+    if (auto ds = vtkDataSet::SafeDownCast(tagged))
+    {
+      ds->ShallowCopy(input);
+      tag(ds, 0);
+      return tagged;
+    }
+
+    auto inputTree = vtkDataObjectTree::SafeDownCast(input);
+    auto taggedTree = vtkDataObjectTree::SafeDownCast(tagged);
+    taggedTree->CopyStructure(inputTree);
+    auto iter = vtk::TakeSmartPointer(inputTree->NewIterator());
+    iter->SkipEmptyNodesOn();
+    int block = 0;
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem(), ++block)
+    {
+      auto ds = vtkDataSet::SafeDownCast(iter->GetCurrentDataObject());
+      auto copy = vtk::TakeSmartPointer(ds->NewInstance());
+      copy->ShallowCopy(ds);
+      tag(copy, block);
+      taggedTree->SetDataSet(iter, copy);
+    }
+    return tagged;
+  }
+
+  /**
+   * Builds the plan from the output generated for the tagged input and removes
+   * the source arrays from `output`. This is collective.
+   */
+  bool Build(vtkDataObject* input, vtkDataObject* output, vtkMultiProcessController* controller)
+  {
+    const int rank = controller ? controller->GetLocalProcessId() : 0;
+    const int numberOfProcesses = controller ? controller->GetNumberOfProcesses() : 1;
+
+    vtkLeaves inputLeaves;
+    vtkLeaves outputLeaves;
+    bool valid =
+      this->GetKeys(input, inputLeaves, this->Keys) && vtkGetLeaves(output, outputLeaves);
+
+    std::map<unsigned int, int> inputBlocks;
+    for (size_t cc = 0; cc < inputLeaves.size(); ++cc)
+    {
+      inputBlocks[inputLeaves[cc].first] = static_cast<int>(cc);
+    }
+
+    for (int target = 0; valid && target < static_cast<int>(outputLeaves.size()); ++target)
+    {
+      auto iter = inputBlocks.find(outputLeaves[target].first);
+      if (iter == inputBlocks.end())
+      {
+        valid = false;
+        break;
+      }
+      this->Templates.push_back(iter->second);
+      vtkDataSet* inputDS = inputLeaves[iter->second].second;
+      vtkDataSet* outputDS = outputLeaves[target].second;
+
+      for (int aa = 0; aa < 2 && valid; ++aa)
+      {
+        const int association = ASSOCIATIONS[aa];
+        vtkDataSetAttributes* attributes = vtkGetAttributes(outputDS, association);
+        auto source = vtkIdTypeArray::SafeDownCast(attributes->GetArray(SOURCE_ARRAY_NAME));
+        if (!source || source->GetNumberOfComponents() != 3)
+        {
+          valid = false;
+          break;
+        }
+        const vtkIdType* ptr = source->GetPointer(0);
+        for (vtkIdType id = 0, max = source->GetNumberOfTuples(); id < max; ++id)
+        {
+          const int sourceRank = static_cast<int>(ptr[3 * id]);
+          const vtkTransferKey key(static_cast<int>(ptr[3 * id + 1]), target, association);
+          auto& transfer = sourceRank == rank ? this->Local[key] : this->Receives[sourceRank][key];
+          transfer.SourceIds->InsertNextId(ptr[3 * id + 2]);
+          transfer.TargetIds->InsertNextId(id);
+          valid &= sourceRank >= 0 && sourceRank < numberOfProcesses;
+        }
+        attributes->RemoveArray(SOURCE_ARRAY_NAME);
+
+        std::set<std::string> generated{ vtkDataSetAttributes::GhostArrayName() };
+        vtkDataSetAttributes* inputAttributes = vtkGetAttributes(inputDS, association);
+        for (int cc = 0; cc < attributes->GetNumberOfArrays(); ++cc)
+        {
+          const char* name = attributes->GetArrayName(cc);
+          if (name && !inputAttributes->GetAbstractArray(name))
+          {
+            generated.insert(name);
+          }
+        }
+        this->GeneratedArrays[aa].push_back(std::move(generated));
+      }
+    }
+
+    for (const auto& pair : this->Local)
+    {
+      valid &= this->IsValid(inputLeaves, pair.first, pair.second.SourceIds);
+    }
+
+    // let each source rank know which of its elements this rank needs.
+    std::vector<int> counts(numberOfProcesses, 0);
+    for (const auto& pair : this->Receives)
+    {
+      if (pair.first >= 0 && pair.first < numberOfProcesses)
+      {
+        counts[pair.first] = static_cast<int>(pair.second.size());
+      }
+    }
+    std::vector<int> allCounts(counts);
+    if (numberOfProcesses > 1)
+    {
+      allCounts.resize(static_cast<size_t>(numberOfProcesses) * numberOfProcesses);
+      controller->AllGather(counts.data(), allCounts.data(), numberOfProcesses);
+    }
+    std::set<int> partners;
+    for (int cc = 0; cc < numberOfProcesses; ++cc)
+    {
+      if (cc != rank && (counts[cc] > 0 || allCounts[cc * numberOfProcesses + rank] > 0))
+      {
+        partners.insert(cc);
+      }
+    }
+
+    vtkExchange(
+      controller, partners,
+      [&](int partner)
+      {
+        vtkMultiProcessStream stream;
+        const auto& transfers = this->Receives[partner];
+        stream << static_cast<int>(transfers.size());
+        for (const auto& pair : transfers)
+        {
+          vtkIdList* ids = pair.second.SourceIds;
+          stream << std::get<0>(pair.first) << std::get<1>(pair.first) << std::get<2>(pair.first)
+                 << static_cast<vtkTypeInt64>(ids->GetNumberOfIds());
+          for (vtkIdType cc = 0; cc < ids->GetNumberOfIds(); ++cc)
+          {
+            stream << static_cast<vtkTypeInt64>(ids->GetId(cc));
+          }
+        }
+        controller->Send(stream, partner, PLAN_TAG);
+      },
+      [&](int partner)
+      {
+        vtkMultiProcessStream stream;
+        controller->Receive(stream, partner, PLAN_TAG);
+        auto& transfers = this->Sends[partner];
+        int count;
+        stream >> count;
+        for (int cc = 0; cc < count; ++cc)
+        {
+          int sourceBlock, targetBlock, association;
+          vtkTypeInt64 numberOfIds;
+          stream >> sourceBlock >> targetBlock >> association >> numberOfIds;
+          const vtkTransferKey key(sourceBlock, targetBlock, association);
+          vtkIdList* ids = transfers[key].SourceIds;
+          ids->SetNumberOfIds(numberOfIds);
+          for (vtkTypeInt64 id = 0; id < numberOfIds; ++id)
+          {
+            vtkTypeInt64 value;
+            stream >> value;
+            ids->SetId(id, value);
+          }
+          valid &= this->IsValid(inputLeaves, key, ids);
+        }
+      });
+
+    // only the target ids of received elements are needed from now on.
+    for (auto& pair : this->Receives)
+    {
+      for (auto& transfer : pair.second)
+      {
+        transfer.second.SourceIds = nullptr;
+      }
+    }
+
+    this->Valid = this->AllReduceMin(controller, valid ? 1 : 0) == 1;
+    if (this->Valid)
+    {
+      this->Output = vtk::TakeSmartPointer(output->NewInstance());
+      this->Output->ShallowCopy(output);
+    }
+    return this->Valid;
+  }
+
+  /**
+   * Adds arrays matching the non-generated arrays of `input` to `target`.
+   */
+  static void InitializeAttributes(vtkDataSetAttributes* target, vtkDataSetAttributes* input,
+    const std::set<std::string>& generated, vtkIdType count)
+  {
+    for (int cc = 0; cc < input->GetNumberOfArrays(); ++cc)
+    {
+      vtkAbstractArray* array = input->GetAbstractArray(cc);
+      if (!array->GetName() || generated.count(array->GetName()))
+      {
+        continue;
+      }
+      auto copy = vtk::TakeSmartPointer(vtkAbstractArray::CreateArray(array->GetDataType()));
+      copy->SetName(array->GetName());
+      copy->SetNumberOfComponents(array->GetNumberOfComponents());
+      copy->CopyComponentNames(array);
+      copy->SetNumberOfTuples(count);
+      if (auto dataArray = vtkDataArray::SafeDownCast(copy))
+      {
+        dataArray->Fill(0.0);
+      }
+      target->AddArray(copy);
+    }
+    for (int attribute = 0; attribute < vtkDataSetAttributes::NUM_ATTRIBUTES; ++attribute)
+    {
+      vtkAbstractArray* array = input->GetAbstractAttribute(attribute);
+      if (array && array->GetName() && target->GetAbstractArray(array->GetName()))
+      {
+        target->SetActiveAttribute(array->GetName(), attribute);
+      }
+    }
+  }
+
+  /**
+   * Adds the generated arrays of `cached` to `target`.
+   */
+  static void AddGeneratedArrays(vtkDataSetAttributes* target, vtkDataSetAttributes* cached,
+    const std::set<std::string>& generated)
+  {
+    for (int cc = 0; cc < cached->GetNumberOfArrays(); ++cc)
+    {
+      vtkAbstractArray* array = cached->GetAbstractArray(cc);
+      if (array->GetName() && generated.count(array->GetName()))
+      {
+        target->AddArray(array);
+      }
+    }
+    for (int attribute = 0; attribute < vtkDataSetAttributes::NUM_ATTRIBUTES; ++attribute)
+    {
+      vtkAbstractArray* array = cached->GetAbstractAttribute(attribute);
+      if (array && array->GetName() && generated.count(array->GetName()))
+      {
+        target->SetActiveAttribute(array->GetName(), attribute);
+      }
+    }
+  }
+
+  /**
+   * Generates the output using the cached plan: the mesh of the cached output
+   * is reused and only point and cell data arrays are exchanged. This is
+   * collective.
+   */
+  int Execute(vtkDataObject* input, vtkDataObject* output, vtkMultiProcessController* controller)
+  {
+    vtkLeaves inputLeaves;
+    vtkLeaves cachedLeaves;
+    vtkGetLeaves(input, inputLeaves);
+    vtkGetLeaves(this->Output, cachedLeaves);
+
+    std::vector<vtkDataSet*> outputLeaves;
+    if (auto ds = vtkDataSet::SafeDownCast(output))
+    {
+      ds->CopyStructure(cachedLeaves[0].second);
+      outputLeaves.push_back(ds);
+    }
+    else
+    {
+      auto cachedTree = vtkDataObjectTree::SafeDownCast(this->Output);
+      auto outputTree = vtkDataObjectTree::SafeDownCast(output);
+      outputTree->CopyStructure(cachedTree);
+      auto iter = vtk::TakeSmartPointer(cachedTree->NewIterator());
+      iter->SkipEmptyNodesOn();
+      for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+      {
+        auto cached = vtkDataSet::SafeDownCast(iter->GetCurrentDataObject());
+        auto ds = vtk::TakeSmartPointer(cached->NewInstance());
+        ds->CopyStructure(cached);
+        outputTree->SetDataSet(iter, ds);
+        outputLeaves.push_back(ds);
+      }
+      output->GetFieldData()->ShallowCopy(input->GetFieldData());
+    }
+
+    for (size_t target = 0; target < outputLeaves.size(); ++target)
+    {
+      vtkDataSet* inputDS = inputLeaves[this->Templates[target]].second;
+      vtkDataSet* outputDS = outputLeaves[target];
+      outputDS->GetFieldData()->ShallowCopy(inputDS->GetFieldData());
+      for (int aa = 0; aa < 2; ++aa)
+      {
+        vtkGetAttributes(outputDS, ASSOCIATIONS[aa])->Initialize();
+        this->InitializeAttributes(vtkGetAttributes(outputDS, ASSOCIATIONS[aa]),
+          vtkGetAttributes(inputDS, ASSOCIATIONS[aa]), this->GeneratedArrays[aa][target],
+          vtkGetNumberOfElements(outputDS, ASSOCIATIONS[aa]));
+      }
+    }
+
+    for (const auto& pair : this->Local)
+    {
+      const int association = std::get<2>(pair.first);
+      vtkCopyTuples(vtkGetAttributes(outputLeaves[std::get<1>(pair.first)], association),
+        pair.second.TargetIds,
+        vtkGetAttributes(inputLeaves[std::get<0>(pair.first)].second, association),
+        pair.second.SourceIds);
+    }
+
+    std::set<int> partners;
+    for (const auto& pair : this->Sends)
+    {
+      partners.insert(pair.first);
+    }
+    for (const auto& pair : this->Receives)
+    {
+      partners.insert(pair.first);
+    }
+
+    vtkNew<vtkIdList> sequence;
+    vtkExchange(
+      controller, partners,
+      [&](int partner)
+      {
+        for (const auto& pair : this->Sends[partner])
+        {
+          vtkDataSetAttributes* source =
+            vtkGetAttributes(inputLeaves[std::get<0>(pair.first)].second, std::get<2>(pair.first));
+          vtkIdList* ids = pair.second.SourceIds;
+          vtkNew<vtkTable> table;
+          for (int cc = 0; cc < source->GetNumberOfArrays(); ++cc)
+          {
+            vtkAbstractArray* array = source->GetAbstractArray(cc);
+            if (!array->GetName() ||
+              strcmp(array->GetName(), vtkDataSetAttributes::GhostArrayName()) == 0)
+            {
+              continue;
+            }
+            auto column =
+              vtk::TakeSmartPointer(vtkAbstractArray::CreateArray(array->GetDataType()));
+            column->SetName(array->GetName());
+            column->SetNumberOfComponents(array->GetNumberOfComponents());
+            column->SetNumberOfTuples(ids->GetNumberOfIds());
+            array->GetTuples(ids, column);
+            table->AddColumn(column);
+          }
+          controller->Send(table, partner, DATA_TAG);
+        }
+      },
+      [&](int partner)
+      {
+        for (const auto& pair : this->Receives[partner])
+        {
+          vtkNew<vtkTable> table;
+          controller->Receive(table, partner, DATA_TAG);
+          vtkIdList* ids = pair.second.TargetIds;
+          sequence->SetNumberOfIds(ids->GetNumberOfIds());
+          std::iota(sequence->begin(), sequence->end(), 0);
+          vtkCopyTuples(
+            vtkGetAttributes(outputLeaves[std::get<1>(pair.first)], std::get<2>(pair.first)), ids,
+            table->GetRowData(), sequence);
+        }
+      });
+
+    for (size_t target = 0; target < outputLeaves.size(); ++target)
+    {
+      for (int aa = 0; aa < 2; ++aa)
+      {
+        this->AddGeneratedArrays(vtkGetAttributes(outputLeaves[target], ASSOCIATIONS[aa]),
+          vtkGetAttributes(cachedLeaves[target].second, ASSOCIATIONS[aa]),
+          this->GeneratedArrays[aa][target]);
+      }
+    }
+    return 1;
+  }
+};
 
 vtkStandardNewMacro(vtkPVGhostCellsGenerator);
 
+//----------------------------------------------------------------------------
+vtkPVGhostCellsGenerator::vtkPVGhostCellsGenerator()
+  : Internals(new vtkPVGhostCellsGenerator::vtkInternals())
+{
+}
+
+//----------------------------------------------------------------------------
+vtkPVGhostCellsGenerator::~vtkPVGhostCellsGenerator() = default;
+
 //----------------------------------------------------------------------------
 void vtkPVGhostCellsGenerator::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "CacheExchangePlan: " << this->CacheExchangePlan << endl;
+  os << indent << "ExchangePlanReused: " << this->ExchangePlanReused << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -102,6 +801,7 @@ int vtkPVGhostCellsGenerator::RequestData(vtkInformation* vtkNotUsed(request),
 {
   vtkDataObject* input = vtkDataObject::GetData(inputVector[0]);
   vtkDataObject* output = vtkDataObject::GetData(outputVector);
+  this->ExchangePlanReused = false;
 
   if (!input)
   {
@@ -226,9 +926,55 @@ int vtkPVGhostCellsGenerator::RequestData(vtkInformation* vtkNotUsed(request),
     return 1;
   }
 
+  if (this->CacheExchangePlan)
+  {
+    return this->GhostCellsGeneratorUsingExchangePlan(input, output);
+  }
+  this->Internals->Reset();
   return this->GhostCellsGeneratorUsingSuperclassInstance(input, output);
 }
 
+//----------------------------------------------------------------------------
+int vtkPVGhostCellsGenerator::GhostCellsGeneratorUsingExchangePlan(
+  vtkDataObject* inputDO, vtkDataObject* outputDO)
+{
+  auto& internals = *this->Internals;
+  vtkMultiProcessController* controller = this->GetController();
+
+  vtkLeaves leaves;
+  std::vector<vtkMeshKey> keys;
+  const bool supported = vtkInternals::GetKeys(inputDO, leaves, keys);
+  const bool reusable = supported && internals.Valid &&
+    internals.FilterMTime == this->GetMTime() && internals.Keys == keys;
+
+  // all ranks must take the same path since both are collective.
+  const int status = vtkInternals::AllReduceMin(controller, reusable ? 2 : (supported ? 1 : 0));
+  if (status == 2)
+  {
+    vtkLogF(TRACE, "exchange attributes using the cached ghost exchange plan");
+    this->ExchangePlanReused = true;
+    return internals.Execute(inputDO, outputDO, controller);
+  }
+
+  internals.Reset();
+  if (status == 0)
+  {
+    return this->GhostCellsGeneratorUsingSuperclassInstance(inputDO, outputDO);
+  }
+
+  vtkLogScopeF(TRACE, "generate ghosts and build the exchange plan");
+  const int rank = controller ? controller->GetLocalProcessId() : 0;
+  auto tagged = vtkInternals::Tag(inputDO, rank);
+  const int result = this->GhostCellsGeneratorUsingSuperclassInstance(tagged, outputDO);
+  if (result == 1 && !internals.Build(inputDO, outputDO, controller))
+  {
+    vtkLogF(TRACE, "the ghost exchange plan could not be built and is not cached");
+    internals.Reset();
+  }
+  internals.FilterMTime = this->GetMTime();
+  return result;
+}
+
 //----------------------------------------------------------------------------
 int vtkPVGhostCellsGenerator::FillInputPortInformation(int port, vtkInformation* info)
 {
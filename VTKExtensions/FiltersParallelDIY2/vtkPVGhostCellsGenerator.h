@@ -8,6 +8,13 @@
  * derivates. In the case of a composite dataset containing HTG, the output will always be a
  * vtkPartitionedDataSetCollection. Ghost Cells are computed separately for each individual
  * partition/block of the composite structure.
+ *
+ * For vtkDataSet inputs and composites of vtkDataSet, the exchange pattern
+ * computed when generating ghosts can be cached (see CacheExchangePlan). When
+ * the mesh of the input is unchanged across executions, as is typical for time
+ * series computed on a fixed mesh, only the point and cell data arrays are
+ * then exchanged through the cached plan instead of generating the ghosts
+ * again.
  */
 
 #ifndef vtkPVGhostCellsGenerator_h
@@ -17,6 +24,8 @@
 #include "vtkPVVTKExtensionsFiltersParallelDIY2Module.h" // needed for exports
 #include "vtkParaViewDeprecation.h"                      // for PARAVIEW_DEPRECATED_IN_5_14_0
 
+#include <memory> // for std::unique_ptr
+
 class vtkDataObject;
 
 class VTKPVVTKEXTENSIONSFILTERSPARALLELDIY2_EXPORT vtkPVGhostCellsGenerator
@@ -27,9 +36,35 @@ public:
   vtkTypeMacro(vtkPVGhostCellsGenerator, vtkGhostCellsGenerator);
   void PrintSelf(ostream& os, vtkIndent indent) override;
 
+  ///@{
+  /**
+   * When enabled, the filter records, for every point and cell of the output,
+   * the rank, block and id of the input element it was copied from. As long as
+   * the filter is not modified and the mesh of every input block is unchanged
+   * (same points and cells MTime for unstructured data, same extents and
+   * geometry for structured data), later executions reuse this plan: only the
+   * point and cell data arrays of the input are exchanged and the ghost
+   * topology of the previous output is reused.
+   *
+   * Building the plan costs an extra pass over the generated ghosts, which is
+   * wasted when the mesh changes at every execution.
+   *
+   * Not used for vtkHyperTreeGrid inputs. Default is false.
+   */
+  vtkSetMacro(CacheExchangePlan, bool);
+  vtkGetMacro(CacheExchangePlan, bool);
+  vtkBooleanMacro(CacheExchangePlan, bool);
+  ///@}
+
+  /**
+   * Returns true if the last execution reused the cached exchange plan instead
+   * of generating the ghosts.
+   */
+  vtkGetMacro(ExchangePlanReused, bool);
+
 protected:
-  vtkPVGhostCellsGenerator() = default;
-  ~vtkPVGhostCellsGenerator() override = default;
+  vtkPVGhostCellsGenerator();
+  ~vtkPVGhostCellsGenerator() override;
 
   int RequestDataObject(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
@@ -45,7 +80,18 @@ private:
   vtkPVGhostCellsGenerator(const vtkPVGhostCellsGenerator&) = delete;
   void operator=(const vtkPVGhostCellsGenerator&) = delete;
 
+  /**
+   * Generate ghosts for a vtkDataSet or a composite of vtkDataSet, reusing the
+   * cached exchange plan when possible or building it otherwise.
+   */
+  int GhostCellsGeneratorUsingExchangePlan(vtkDataObject* inputDO, vtkDataObject* outputDO);
+
   bool HasCompositeHTG = false;
+  bool CacheExchangePlan = false;
+  bool ExchangePlanReused = false;
+
+  class vtkInternals;
+  std::unique_ptr<vtkInternals> Internals;
 };
 
 #endif
@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
 // SPDX-License-Identifier: BSD-3-Clause
 
+#include "vtkBitArray.h"
 #include "vtkDataTabulator.h"
 #include "vtkFieldData.h"
 #include "vtkIntArray.h"
@@ -8,7 +9,10 @@
 #include "vtkMultiBlockDataSet.h"
 #include "vtkNew.h"
 #include "vtkPartitionedDataSet.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkTable.h"
 
 #include <algorithm>
 #include <initializer_list>
@@ -86,9 +90,73 @@ bool TestNonMultiblockFieldData()
     "block 0: expecting 2 tuples");
   return true;
 }
+
+bool TestImplicitArrays()
+{
+  vtkNew<vtkPolyData> pd;
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(4);
+  for (vtkIdType idx = 0; idx < 4; ++idx)
+  {
+    points->SetPoint(idx, idx, 0, 0);
+  }
+  pd->SetPoints(points);
+
+  // vtkBitArray components can not be viewed, they are copied instead.
+  vtkNew<vtkBitArray> flags;
+  flags->SetName("flags");
+  flags->SetNumberOfComponents(2);
+  flags->SetComponentName(0, "A");
+  flags->SetComponentName(1, "B");
+  flags->SetNumberOfTuples(4);
+  for (vtkIdType idx = 0; idx < 4; ++idx)
+  {
+    flags->SetComponent(idx, 0, idx % 2);
+    flags->SetComponent(idx, 1, 1 - idx % 2);
+  }
+  pd->GetPointData()->AddArray(flags);
+
+  vtkNew<vtkPolyData> emptyPD;
+  vtkNew<vtkMultiBlockDataSet> mb;
+  mb->SetBlock(0, pd);
+  mb->SetBlock(1, emptyPD);
+
+  vtkNew<vtkDataTabulator> tabulator;
+  tabulator->SetInputData(mb);
+  tabulator->SetFieldAssociation(vtkDataObject::FIELD_ASSOCIATION_POINTS);
+  tabulator->SetSplitComponents(true);
+  tabulator->SetUseImplicitArrays(true);
+  tabulator->Update();
+
+  auto output = vtkPartitionedDataSet::SafeDownCast(tabulator->GetOutputDataObject(0));
+  VERIFY(output != nullptr, "vtkPartitionedDataSet expected.");
+  VERIFY(output->GetNumberOfPartitions() == 2, "2 partitions expected.");
+  auto table = vtkTable::SafeDownCast(output->GetPartitionAsDataObject(0));
+  VERIFY(table && table->GetNumberOfRows() == 4, "block 0: expecting 4 rows");
+  auto flagA = vtkDataArray::SafeDownCast(table->GetColumnByName("flags_A"));
+  auto flagB = vtkDataArray::SafeDownCast(table->GetColumnByName("flags_B"));
+  VERIFY(flagA && flagB, "block 0: split components of a bit array expected");
+  for (vtkIdType idx = 0; idx < 4; ++idx)
+  {
+    VERIFY(flagA->GetComponent(idx, 0) == idx % 2 && flagB->GetComponent(idx, 0) == 1 - idx % 2,
+      "block 0: incorrect split component values");
+  }
+  auto ids = vtkDataArray::SafeDownCast(table->GetColumnByName("vtkOriginalIndices"));
+  VERIFY(ids && ids->GetNumberOfTuples() == 4 && ids->GetComponent(3, 0) == 3,
+    "block 0: incorrect vtkOriginalIndices");
+
+  // empty blocks have the same columns.
+  auto empty = vtkTable::SafeDownCast(output->GetPartitionAsDataObject(1));
+  VERIFY(empty && empty->GetNumberOfRows() == 0, "block 1: expecting an empty table");
+  VERIFY(empty->GetColumnByName("vtkOriginalIndices") != nullptr,
+    "block 1: vtkOriginalIndices expected");
+  return true;
+}
 }
 
 extern int TestDataTabulator(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
 {
-  return TestMultiblockFieldData() && TestNonMultiblockFieldData() ? EXIT_SUCCESS : EXIT_FAILURE;
+  return TestMultiblockFieldData() && TestNonMultiblockFieldData() && TestImplicitArrays()
+    ? EXIT_SUCCESS
+    : EXIT_FAILURE;
 }
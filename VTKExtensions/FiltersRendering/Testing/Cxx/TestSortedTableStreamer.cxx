@@ -0,0 +1,232 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkAffineArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkDummyController.h"
+#include "vtkIdTypeArray.h"
+#include "vtkIntArray.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPartitionedDataSet.h"
+#include "vtkSortedTableStreamer.h"
+#include "vtkTable.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#define VERIFY(x, y)                                                                               \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    vtkLogF(ERROR, "%s", std::string(y).c_str());                                                  \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+constexpr vtkIdType NB_ROWS = 20000;
+constexpr vtkIdType BLOCK_SIZE = 1024;
+
+// Distinct values, in an order unrelated to the row order.
+double Value(vtkIdType id)
+{
+  return static_cast<double>((id * 7919) % NB_ROWS);
+}
+
+// Values with many duplicates.
+int Group(vtkIdType id)
+{
+  return static_cast<int>(id % 37);
+}
+
+vtkSmartPointer<vtkTable> CreateTable(vtkIdType begin, vtkIdType end)
+{
+  vtkNew<vtkIdTypeArray> ids;
+  ids->SetName("ids");
+  vtkNew<vtkDoubleArray> values;
+  values->SetName("values");
+  vtkNew<vtkIntArray> groups;
+  groups->SetName("groups");
+  for (vtkIdType id = begin; id < end; ++id)
+  {
+    ids->InsertNextValue(id);
+    values->InsertNextValue(Value(id));
+    groups->InsertNextValue(Group(id));
+  }
+  auto table = vtkSmartPointer<vtkTable>::New();
+  table->AddColumn(ids);
+  table->AddColumn(values);
+  table->AddColumn(groups);
+  return table;
+}
+
+// Requests the given blocks and compares them with the sorted values. Every
+// row must also keep the values of its other columns.
+bool CheckBlocks(vtkSortedTableStreamer* streamer, const std::vector<double>& sorted,
+  const std::vector<vtkIdType>& blocks)
+{
+  const std::string column = streamer->GetColumnNameToSort();
+  const bool inverted = streamer->GetInvertOrder() != 0;
+  const vtkIdType total = static_cast<vtkIdType>(sorted.size());
+  for (vtkIdType block : blocks)
+  {
+    streamer->SetBlock(block);
+    streamer->Update();
+    vtkTable* output = streamer->GetOutput();
+    const std::string where = column + (inverted ? " (inverted)" : "") + ", block " +
+      std::to_string(block) + ": ";
+
+    const vtkIdType first = std::min(block * BLOCK_SIZE, total);
+    const vtkIdType expectedRows = std::min(first + BLOCK_SIZE, total) - first;
+    VERIFY(output->GetNumberOfRows() == expectedRows,
+      where + "expected " + std::to_string(expectedRows) + " rows, got " +
+        std::to_string(output->GetNumberOfRows()));
+    if (expectedRows == 0)
+    {
+      continue;
+    }
+
+    auto ids = vtkIdTypeArray::SafeDownCast(output->GetColumnByName("ids"));
+    auto values = vtkDataArray::SafeDownCast(output->GetColumnByName("values"));
+    auto groups = vtkDataArray::SafeDownCast(output->GetColumnByName("groups"));
+    auto sortedColumn = vtkDataArray::SafeDownCast(output->GetColumnByName(column.c_str()));
+    VERIFY(ids && values && groups && sortedColumn, where + "missing columns");
+    for (vtkIdType row = 0; row < expectedRows; ++row)
+    {
+      const vtkIdType index = first + row;
+      const double expected = sorted[inverted ? total - 1 - index : index];
+      VERIFY(sortedColumn->GetTuple1(row) == expected,
+        where + "row " + std::to_string(row) + " has " +
+          std::to_string(sortedColumn->GetTuple1(row)) + " instead of " +
+          std::to_string(expected));
+      const vtkIdType id = ids->GetValue(row);
+      VERIFY(values->GetTuple1(row) == Value(id) && groups->GetTuple1(row) == Group(id),
+        where + "row " + std::to_string(row) + " mixes values of different rows");
+    }
+  }
+  return true;
+}
+
+bool CheckColumn(vtkSortedTableStreamer* streamer, const char* column,
+  std::vector<double> (*sortedValues)(), const std::vector<vtkIdType>& blocks)
+{
+  const std::vector<double> sorted = sortedValues();
+  streamer->SetColumnNameToSort(column);
+  for (int inverted = 0; inverted < 2; ++inverted)
+  {
+    streamer->SetInvertOrder(inverted);
+    if (!CheckBlocks(streamer, sorted, blocks))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::vector<double> SortedValues()
+{
+  std::vector<double> sorted;
+  for (vtkIdType id = 0; id < NB_ROWS; ++id)
+  {
+    sorted.push_back(Value(id));
+  }
+  std::sort(sorted.begin(), sorted.end());
+  return sorted;
+}
+
+std::vector<double> SortedGroups()
+{
+  std::vector<double> sorted;
+  for (vtkIdType id = 0; id < NB_ROWS; ++id)
+  {
+    sorted.push_back(Group(id));
+  }
+  std::sort(sorted.begin(), sorted.end());
+  return sorted;
+}
+
+// Implicit ids above 2^53, which doubles round, must be sorted and delivered
+// exactly.
+bool CheckLargeIds(vtkMultiProcessController* controller)
+{
+  constexpr vtkIdType count = 1500;
+  constexpr vtkIdType base = vtkIdType(1) << 53;
+  vtkNew<vtkAffineArray<vtkIdType>> large;
+  large->SetBackend(std::make_shared<vtkAffineImplicitBackend<vtkIdType>>(-1, base + count));
+  large->SetNumberOfTuples(count);
+  large->SetName("large");
+  vtkNew<vtkTable> table;
+  table->AddColumn(large);
+  vtkNew<vtkPartitionedDataSet> input;
+  input->SetPartition(0, table);
+
+  vtkNew<vtkSortedTableStreamer> streamer;
+  streamer->SetController(controller);
+  streamer->SetInputData(input);
+  streamer->SetBlockSize(BLOCK_SIZE);
+  streamer->SetColumnNameToSort("large");
+  for (vtkIdType block = 0; block < 2; ++block)
+  {
+    streamer->SetBlock(block);
+    streamer->Update();
+    vtkTable* output = streamer->GetOutput();
+    auto ids = vtkIdTypeArray::SafeDownCast(output->GetColumnByName("large"));
+    VERIFY(ids && ids->GetNumberOfTuples() == std::min(BLOCK_SIZE, count - block * BLOCK_SIZE),
+      "large ids, block " + std::to_string(block) + ": vtkIdTypeArray expected");
+    for (vtkIdType row = 0; row < ids->GetNumberOfTuples(); ++row)
+    {
+      VERIFY(ids->GetValue(row) == base + 1 + block * BLOCK_SIZE + row,
+        "large ids, block " + std::to_string(block) + ": row " + std::to_string(row) +
+          " has " + std::to_string(ids->GetValue(row)));
+    }
+  }
+  return true;
+}
+}
+
+extern int TestSortedTableStreamer(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  // Two partitions, merged by the streamer.
+  vtkNew<vtkPartitionedDataSet> input;
+  input->SetPartition(0, CreateTable(0, NB_ROWS / 3));
+  input->SetPartition(1, CreateTable(NB_ROWS / 3, NB_ROWS));
+
+  vtkNew<vtkDummyController> controller;
+  vtkNew<vtkSortedTableStreamer> streamer;
+  streamer->SetController(controller);
+  streamer->SetInputData(input);
+  streamer->SetBlockSize(BLOCK_SIZE);
+
+  // Blocks 0 to 7 are served by the top-K prefix (8192 rows), the next ones by
+  // the full sort and its samples. Block 19 is partial and block 20 is empty.
+  // Block 0 is requested again once the array is fully sorted.
+  const std::vector<vtkIdType> blocks = { 0, 7, 3, 8, 12, 19, 20, 0, 5 };
+  bool success = CheckColumn(streamer, "values", SortedValues, blocks) &&
+    CheckColumn(streamer, "groups", SortedGroups, blocks) && CheckLargeIds(controller);
+
+  // Modifying the input drops the cached order.
+  auto values = vtkDoubleArray::SafeDownCast(
+    vtkTable::SafeDownCast(input->GetPartitionAsDataObject(1))->GetColumnByName("values"));
+  double minimum = 0.0;
+  for (vtkIdType idx = 0; idx < values->GetNumberOfTuples(); ++idx)
+  {
+    values->SetValue(idx, -values->GetValue(idx));
+    minimum = std::min(minimum, values->GetValue(idx));
+  }
+  values->Modified();
+  input->Modified();
+  streamer->SetColumnNameToSort("values");
+  streamer->SetInvertOrder(0);
+  streamer->SetBlock(0);
+  streamer->Update();
+  vtkTable* output = streamer->GetOutput();
+  success = success && output->GetNumberOfRows() == BLOCK_SIZE &&
+    output->GetColumnByName("values")->GetVariantValue(0).ToDouble() == minimum;
+  if (!success)
+  {
+    vtkLogF(ERROR, "Failed.");
+  }
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,121 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkDoubleArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkLogger.h"
+#include "vtkMPIController.h"
+#include "vtkNew.h"
+#include "vtkPartitionedDataSet.h"
+#include "vtkSortedTableStreamer.h"
+#include "vtkTable.h"
+
+#include <algorithm>
+#include <initializer_list>
+
+namespace
+{
+constexpr vtkIdType NB_ROWS = 20000;
+constexpr vtkIdType BLOCK_SIZE = 1024;
+
+// Distinct values, so that the sorted values are 0 to NB_ROWS - 1 whatever
+// the process holding them.
+double Value(vtkIdType id)
+{
+  return static_cast<double>((id * 7919) % NB_ROWS);
+}
+
+bool CheckBlock(vtkSortedTableStreamer* streamer, vtkMultiProcessController* contr,
+  vtkIdType block, bool inverted)
+{
+  streamer->SetInvertOrder(inverted ? 1 : 0);
+  streamer->SetBlock(block);
+  streamer->Update();
+
+  // The block is only on the process that merged it.
+  vtkTable* output = streamer->GetOutput();
+  const vtkIdType first = std::min(block * BLOCK_SIZE, NB_ROWS);
+  const vtkIdType expectedRows = std::min(first + BLOCK_SIZE, NB_ROWS) - first;
+  vtkIdType localRows = output->GetNumberOfRows();
+  vtkIdType rows = 0;
+  contr->AllReduce(&localRows, &rows, 1, vtkCommunicator::SUM_OP);
+  if (rows != expectedRows)
+  {
+    vtkLogF(ERROR, "block %lld: expected %lld rows, got %lld", static_cast<long long>(block),
+      static_cast<long long>(expectedRows), static_cast<long long>(rows));
+    return false;
+  }
+
+  auto ids = vtkIdTypeArray::SafeDownCast(output->GetColumnByName("ids"));
+  auto values = vtkDataArray::SafeDownCast(output->GetColumnByName("values"));
+  for (vtkIdType row = 0; row < localRows; ++row)
+  {
+    const vtkIdType index = first + row;
+    const double expected = static_cast<double>(inverted ? NB_ROWS - 1 - index : index);
+    if (!ids || !values || values->GetTuple1(row) != expected ||
+      Value(ids->GetValue(row)) != expected)
+    {
+      vtkLogF(ERROR, "block %lld: wrong row %lld", static_cast<long long>(block),
+        static_cast<long long>(row));
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+extern int TestSortedTableStreamerMPI(int argc, char* argv[])
+{
+  vtkMPIController* contr = vtkMPIController::New();
+  contr->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(contr);
+
+  const int myRank = contr->GetLocalProcessId();
+  const int numRanks = contr->GetNumberOfProcesses();
+
+  // Each process holds a slice of the rows; their values are spread over the
+  // whole range, so every block is made of the rows of several processes.
+  vtkNew<vtkIdTypeArray> ids;
+  ids->SetName("ids");
+  vtkNew<vtkDoubleArray> values;
+  values->SetName("values");
+  for (vtkIdType id = myRank * NB_ROWS / numRanks; id < (myRank + 1) * NB_ROWS / numRanks; ++id)
+  {
+    ids->InsertNextValue(id);
+    values->InsertNextValue(Value(id));
+  }
+  vtkNew<vtkTable> table;
+  table->AddColumn(ids);
+  table->AddColumn(values);
+  vtkNew<vtkPartitionedDataSet> input;
+  input->SetPartition(0, table);
+
+  vtkNew<vtkSortedTableStreamer> streamer;
+  streamer->SetController(contr);
+  streamer->SetInputData(input);
+  streamer->SetBlockSize(BLOCK_SIZE);
+  streamer->SetColumnNameToSort("values");
+
+  // Blocks 0 and 7 use the top-K prefixes, blocks 8 and 19 the gathered
+  // samples, then block 0 is served from the fully sorted arrays.
+  int success = 1;
+  for (bool inverted : { false, true })
+  {
+    for (vtkIdType block : { 0, 7, 8, 19, 0 })
+    {
+      // every process takes part in each update, even after a failure.
+      if (!CheckBlock(streamer, contr, block, inverted))
+      {
+        success = 0;
+      }
+    }
+  }
+
+  int all_success;
+  contr->AllReduce(&success, &all_success, 1, vtkCommunicator::LOGICAL_AND_OP);
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  contr->Finalize();
+  contr->Delete();
+  return all_success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -2,13 +2,17 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkDataTabulator.h"
 
+#include "vtkAffineArray.h"
 #include "vtkAttributeDataToTableFilter.h"
 #include "vtkCompositeDataSet.h"
 #include "vtkDataAssembly.h"
 #include "vtkDataAssemblyUtilities.h"
 #include "vtkDataObjectTreeIterator.h"
+#include "vtkDataSetAttributes.h"
 #include "vtkExtractBlockUsingDataAssembly.h"
 #include "vtkFieldData.h"
+#include "vtkImplicitArray.h"
+#include "vtkImplicitColumnBackends.h"
 #include "vtkInformation.h"
 #include "vtkInformationIntegerKey.h"
 #include "vtkLogger.h"
@@ -23,7 +27,9 @@
 #include "vtkUniformGridAMRDataIterator.h"
 
 #include <cassert>
+#include <memory>
 #include <string>
+#include <vector>
 
 namespace
 {
@@ -33,6 +39,112 @@ vtkTable* NewFieldDataWrapper(vtkDataObject* dobj)
   dummy->GetFieldData()->PassData(dobj->GetFieldData());
   return dummy;
 }
+
+//----------------------------------------------------------------------------
+template <typename ValueType>
+vtkDataArray* NewComponentView(vtkDataArray* array, int component)
+{
+  auto view = vtkImplicitArray<vtkComponentImplicitBackend<ValueType>>::New();
+  view->ConstructBackend(array, component);
+  view->SetNumberOfComponents(1);
+  view->SetNumberOfTuples(array->GetNumberOfTuples());
+  return view;
+}
+
+//----------------------------------------------------------------------------
+/**
+ * Same as vtkSplitColumnComponents, but the split components and magnitudes
+ * are implicit arrays viewing the multi-component columns of the table.
+ * Returns false, leaving the table unchanged, if a multi-component column is
+ * not a data array.
+ */
+bool SplitComponentsImplicitly(vtkTable* table, int namingMode)
+{
+  // vtkSplitColumnComponents is run on an empty table with the same columns
+  // so that the columns are named and annotated the same way.
+  vtkNew<vtkTable> layout;
+  for (vtkIdType cc = 0, max = table->GetNumberOfColumns(); cc < max; ++cc)
+  {
+    auto column = table->GetColumn(cc);
+    if (column->GetNumberOfComponents() > 1 && !vtkDataArray::SafeDownCast(column))
+    {
+      return false;
+    }
+    auto empty = vtkSmartPointer<vtkAbstractArray>::Take(
+      vtkAbstractArray::CreateArray(column->GetDataType()));
+    empty->SetName(column->GetName());
+    empty->SetNumberOfComponents(column->GetNumberOfComponents());
+    empty->CopyComponentNames(column);
+    layout->AddColumn(empty);
+  }
+
+  vtkNew<vtkSplitColumnComponents> splitter;
+  splitter->SetInputData(layout);
+  splitter->SetNamingMode(namingMode);
+  splitter->Update();
+  vtkTable* split = splitter->GetOutput();
+
+  vtkNew<vtkDataSetAttributes> rowData;
+  vtkSmartPointer<vtkTable> copies;
+  for (vtkIdType cc = 0, max = split->GetNumberOfColumns(); cc < max; ++cc)
+  {
+    auto column = split->GetColumn(cc);
+    auto info = column->HasInformation() ? column->GetInformation() : nullptr;
+    if (!info || !info->Has(vtkSplitColumnComponents::ORIGINAL_ARRAY_NAME()))
+    {
+      // column passed as is
+      rowData->AddArray(table->GetColumnByName(column->GetName()));
+      continue;
+    }
+
+    auto original = vtkDataArray::SafeDownCast(
+      table->GetColumnByName(info->Get(vtkSplitColumnComponents::ORIGINAL_ARRAY_NAME())));
+    const int component = info->Has(vtkSplitColumnComponents::ORIGINAL_COMPONENT_NUMBER())
+      ? info->Get(vtkSplitColumnComponents::ORIGINAL_COMPONENT_NUMBER())
+      : -1;
+    vtkDataArray* view = nullptr;
+    if (original)
+    {
+      switch (column->GetDataType())
+      {
+        vtkTemplateMacro(view = ::NewComponentView<VTK_TT>(original, component));
+      }
+    }
+    if (view)
+    {
+      view->SetName(column->GetName());
+      view->CopyInformation(info);
+      rowData->AddArray(view);
+      view->FastDelete();
+      continue;
+    }
+
+    // no view for this value type, e.g. bits: use a copy, split the usual way.
+    if (!copies)
+    {
+      vtkNew<vtkSplitColumnComponents> copier;
+      copier->SetInputData(table);
+      copier->SetNamingMode(namingMode);
+      copier->Update();
+      copies = copier->GetOutput();
+    }
+    rowData->AddArray(copies->GetColumnByName(column->GetName()));
+  }
+  table->SetRowData(rowData);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void AddOriginalIds(vtkTable* table)
+{
+  // added to empty tables too, as vtkAttributeDataToTableFilter does, so that
+  // the columns are the same on all ranks.
+  vtkNew<vtkAffineArray<vtkIdType>> ids;
+  ids->SetBackend(std::make_shared<vtkAffineImplicitBackend<vtkIdType>>(1, 0));
+  ids->SetNumberOfTuples(table->GetNumberOfRows());
+  ids->SetName("vtkOriginalIndices");
+  table->AddColumn(ids);
+}
 }
 
 vtkStandardNewMacro(vtkDataTabulator);
@@ -46,6 +158,7 @@ vtkDataTabulator::vtkDataTabulator()
   , GenerateOriginalIds(true)
   , SplitComponents(false)
   , SplitComponentsNamingMode(vtkSplitColumnComponents::NAMES_WITH_UNDERSCORES)
+  , UseImplicitArrays(false)
   , ActiveAssemblyForSelectors(nullptr)
 {
   this->SetActiveAssemblyForSelectors("Hierarchy");
@@ -202,7 +315,47 @@ vtkSmartPointer<vtkDataObject> vtkDataTabulator::Transform(vtkDataObject* data)
   adtf->SetAddMetaData(true);
   adtf->SetGenerateCellConnectivity(this->GenerateCellConnectivity);
   adtf->SetFieldAssociation(this->FieldAssociation);
-  adtf->SetGenerateOriginalIds(this->GenerateOriginalIds);
+  adtf->SetGenerateOriginalIds(this->GenerateOriginalIds && !this->UseImplicitArrays);
+
+  if (this->UseImplicitArrays)
+  {
+    adtf->Update();
+    vtkSmartPointer<vtkDataObject> output = adtf->GetOutputDataObject(0);
+    std::vector<vtkTable*> tables;
+    if (auto ptd = vtkPartitionedDataSet::SafeDownCast(output))
+    {
+      for (unsigned int cc = 0, max = ptd->GetNumberOfPartitions(); cc < max; ++cc)
+      {
+        tables.push_back(vtkTable::SafeDownCast(ptd->GetPartitionAsDataObject(cc)));
+      }
+    }
+    else
+    {
+      tables.push_back(vtkTable::SafeDownCast(output));
+    }
+
+    for (auto table : tables)
+    {
+      if (!table)
+      {
+        continue;
+      }
+      if (this->SplitComponents &&
+        !::SplitComponentsImplicitly(table, this->SplitComponentsNamingMode))
+      {
+        vtkNew<vtkSplitColumnComponents> splitter;
+        splitter->SetInputData(table);
+        splitter->SetNamingMode(this->SplitComponentsNamingMode);
+        splitter->Update();
+        table->ShallowCopy(splitter->GetOutput());
+      }
+      if (this->GenerateOriginalIds)
+      {
+        ::AddOriginalIds(table);
+      }
+    }
+    return output;
+  }
 
   if (this->SplitComponents)
   {
@@ -99,6 +99,19 @@ public:
   vtkGetMacro(GenerateOriginalIds, bool);
   ///@}
 
+  ///@{
+  /**
+   * When set, the columns that are not input arrays, i.e. the
+   * vtkOriginalIndices array and the split components, are implicit arrays
+   * computed from the input arrays instead of copies of them, so that
+   * tabulating does not allocate memory proportional to the size of the input.
+   * Values are then only copied when rows are extracted from the output, e.g.
+   * by vtkSortedTableStreamer. Default is false.
+   */
+  vtkSetMacro(UseImplicitArrays, bool);
+  vtkGetMacro(UseImplicitArrays, bool);
+  ///@}
+
   /**
    * Used to identify a node in composite datasets.
    */
@@ -137,6 +150,7 @@ private:
   bool GenerateOriginalIds;
   int SplitComponents;
   int SplitComponentsNamingMode;
+  bool UseImplicitArrays;
   std::set<std::string> Selectors;
   char* ActiveAssemblyForSelectors;
 };
@@ -0,0 +1,217 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @file vtkImplicitColumnBackends.h
+ * @brief vtkImplicitArray backends used to tabulate data without copying it.
+ *
+ * vtkComponentImplicitBackend exposes one component, or the magnitude, of a
+ * data array and vtkConcatenatedImplicitBackend exposes a sequence of data
+ * arrays and repeated tuples as a single array. Both read the viewed arrays on
+ * demand: a table built with them only references the arrays of its input and
+ * values are only copied when rows are extracted from it, e.g. by
+ * vtkSortedTableStreamer.
+ *
+ * Viewed arrays using the standard memory layout with the same value type are
+ * read directly, others through vtkImplicitColumnGetComponent(). Viewed arrays
+ * must not be resized while they are viewed.
+ */
+
+#ifndef vtkImplicitColumnBackends_h
+#define vtkImplicitColumnBackends_h
+
+#include "vtkAOSDataArrayTemplate.h"
+#include "vtkDataArray.h"
+#include "vtkSmartPointer.h"
+#include "vtkVariant.h"
+#include "vtkVariantCast.h"
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+//----------------------------------------------------------------------------
+/**
+ * Read a component of an array of any memory layout as a ValueType. 64-bit
+ * integers are read through vtkAbstractArray::GetVariantValue() since
+ * vtkDataArray::GetComponent() rounds values above 2^53, e.g. large ids.
+ */
+template <typename ValueType>
+ValueType vtkImplicitColumnGetComponent(vtkDataArray* array, vtkIdType tupleIdx, int compIdx)
+{
+  if constexpr (std::is_integral<ValueType>::value && sizeof(ValueType) == 8)
+  {
+    return vtkVariantCast<ValueType>(
+      array->GetVariantValue(tupleIdx * array->GetNumberOfComponents() + compIdx));
+  }
+  else
+  {
+    return static_cast<ValueType>(array->GetComponent(tupleIdx, compIdx));
+  }
+}
+
+//----------------------------------------------------------------------------
+template <typename ValueType>
+class vtkComponentImplicitBackend final
+{
+public:
+  /**
+   * View the given component of an array, or the magnitude of its tuples if
+   * component is negative.
+   */
+  vtkComponentImplicitBackend(vtkDataArray* array, int component)
+    : Array(array)
+    , Component(component)
+    , NumberOfComponents(array->GetNumberOfComponents())
+  {
+    if (auto aos = vtkArrayDownCast<vtkAOSDataArrayTemplate<ValueType>>(array))
+    {
+      this->Values = aos->GetPointer(0);
+    }
+  }
+
+  ValueType operator()(vtkIdType idx) const
+  {
+    if (this->Component >= 0)
+    {
+      return this->Values
+        ? this->Values[idx * this->NumberOfComponents + this->Component]
+        : vtkImplicitColumnGetComponent<ValueType>(this->Array, idx, this->Component);
+    }
+    double sum = 0;
+    for (int cc = 0; cc < this->NumberOfComponents; ++cc)
+    {
+      const double value = this->Values
+        ? static_cast<double>(this->Values[idx * this->NumberOfComponents + cc])
+        : this->Array->GetComponent(idx, cc);
+      sum += value * value;
+    }
+    return static_cast<ValueType>(std::sqrt(sum));
+  }
+
+  unsigned long getMemorySize() const
+  {
+    // the viewed array is not owned
+    return 1;
+  }
+
+private:
+  vtkSmartPointer<vtkDataArray> Array;
+  const ValueType* Values = nullptr;
+  int Component;
+  int NumberOfComponents;
+};
+
+//----------------------------------------------------------------------------
+template <typename ValueType>
+class vtkConcatenatedImplicitBackend final
+{
+public:
+  explicit vtkConcatenatedImplicitBackend(int numberOfComponents = 1)
+    : NumberOfComponents(numberOfComponents)
+  {
+  }
+
+  /**
+   * Append all the tuples of an array with the same number of components.
+   */
+  void AppendArray(vtkDataArray* array)
+  {
+    Piece piece;
+    piece.Array = array;
+    if (auto aos = vtkArrayDownCast<vtkAOSDataArrayTemplate<ValueType>>(array))
+    {
+      piece.Values = aos->GetPointer(0);
+    }
+    this->AppendPiece(std::move(piece), array->GetNumberOfTuples());
+  }
+
+  /**
+   * Append a tuple repeated count times.
+   */
+  void AppendTuple(const ValueType* tuple, vtkIdType count)
+  {
+    Piece piece;
+    piece.Tuple.assign(tuple, tuple + this->NumberOfComponents);
+    this->AppendPiece(std::move(piece), count);
+  }
+
+  vtkIdType GetNumberOfTuples() const { return this->Offsets.back(); }
+
+  ValueType operator()(vtkIdType idx) const
+  {
+    return this->mapComponent(
+      idx / this->NumberOfComponents, static_cast<int>(idx % this->NumberOfComponents));
+  }
+
+  void mapTuple(vtkIdType tupleIdx, ValueType* tuple) const
+  {
+    const size_t pieceIdx = this->FindPiece(tupleIdx);
+    const vtkIdType localIdx = tupleIdx - this->Offsets[pieceIdx];
+    for (int cc = 0; cc < this->NumberOfComponents; ++cc)
+    {
+      tuple[cc] = this->GetComponent(this->Pieces[pieceIdx], localIdx, cc);
+    }
+  }
+
+  ValueType mapComponent(vtkIdType tupleIdx, int compIdx) const
+  {
+    const size_t pieceIdx = this->FindPiece(tupleIdx);
+    return this->GetComponent(
+      this->Pieces[pieceIdx], tupleIdx - this->Offsets[pieceIdx], compIdx);
+  }
+
+  unsigned long getMemorySize() const
+  {
+    // only the bookkeeping is owned, not the viewed arrays
+    const size_t bytes = this->Pieces.size() *
+      (sizeof(Piece) + sizeof(vtkIdType) + this->NumberOfComponents * sizeof(ValueType));
+    return static_cast<unsigned long>(std::ceil(bytes / 1024.0));
+  }
+
+private:
+  struct Piece
+  {
+    vtkSmartPointer<vtkDataArray> Array;
+    const ValueType* Values = nullptr;
+    std::vector<ValueType> Tuple; // repeated tuple when there is no array
+  };
+
+  void AppendPiece(Piece&& piece, vtkIdType count)
+  {
+    if (count > 0)
+    {
+      this->Pieces.push_back(std::move(piece));
+      this->Offsets.push_back(this->Offsets.back() + count);
+    }
+  }
+
+  size_t FindPiece(vtkIdType tupleIdx) const
+  {
+    // Offsets[i] is the first tuple of the i-th piece.
+    return std::upper_bound(this->Offsets.begin() + 1, this->Offsets.end(), tupleIdx) -
+      this->Offsets.begin() - 1;
+  }
+
+  ValueType GetComponent(const Piece& piece, vtkIdType localIdx, int compIdx) const
+  {
+    if (piece.Values)
+    {
+      return piece.Values[localIdx * this->NumberOfComponents + compIdx];
+    }
+    if (piece.Array)
+    {
+      return vtkImplicitColumnGetComponent<ValueType>(piece.Array, localIdx, compIdx);
+    }
+    return piece.Tuple[compIdx];
+  }
+
+  int NumberOfComponents;
+  std::vector<Piece> Pieces;
+  std::vector<vtkIdType> Offsets = { 0 };
+};
+
+#endif // vtkImplicitColumnBackends_h
+
+// VTK-HeaderTest-Exclude: vtkImplicitColumnBackends.h
@@ -30,7 +30,12 @@
 #include "vtkTimerLog.h"
 
 #include "vtk_zlib.h"
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <memory>
 #include <sstream>
+#include <thread>
 #include <vector>
 
 bool vtkMPIMoveData::UseZLibCompression = false;
@@ -66,6 +71,92 @@ void unsetGlobalIdsAttribute(vtkDataObject* piece)
     it->Delete();
   }
 }
+
+// Reads a single piece marshalled by vtkMPIMoveData::MarshalDataToBuffer.
+// vtkTimerLog is not thread safe, so `markEvents` must be false when reading
+// pieces concurrently.
+vtkSmartPointer<vtkDataObject> vtkMPIMoveDataReadPiece(
+  char* bufferArray, vtkIdType bufferLength, bool is_image_data, bool markEvents = true)
+{
+  char* realBuffer = nullptr;
+  if (bufferLength > 4 && strncmp(bufferArray, "zlib", 4) == 0)
+  {
+    // sender used zlib compression. Decompress it.
+    vtkIdType compressed_length = bufferLength - 8; // remove the zlib header.
+    vtkIdType uncompressed_length = 0;
+    for (int cc = 0; cc < 4; cc++)
+    {
+      uncompressed_length = uncompressed_length | ((0xff & (bufferArray[4 + cc])) << 8 * cc);
+    }
+
+    // using zlib compression.
+    realBuffer = new char[uncompressed_length];
+    uLongf destLen = uncompressed_length;
+    if (markEvents)
+    {
+      vtkTimerLog::MarkStartEvent("Zlib uncompress");
+    }
+    uncompress(reinterpret_cast<Bytef*>(realBuffer), &destLen,
+      reinterpret_cast<const Bytef*>(bufferArray + 8), compressed_length);
+    if (markEvents)
+    {
+      vtkTimerLog::MarkEndEvent("Zlib uncompress");
+    }
+
+    bufferArray = realBuffer;
+    bufferLength = uncompressed_length;
+  }
+
+  vtkSmartPointer<vtkDataObject> piece;
+
+  // Setup a reader.
+  vtkDataReader* reader = vtkGenericDataObjectReader::New();
+  reader->ReadFromInputStringOn();
+
+  vtkCharArray* mystring = vtkCharArray::New();
+  mystring->SetArray(bufferArray, bufferLength, 1);
+  reader->SetInputArray(mystring);
+  reader->Modified(); // For append loop
+  reader->Update();
+
+  if (is_image_data)
+  {
+    // FIXME: EXTENT and ORIGIN in vtkImageData are lost by reader/writer.
+    // The header hack we used isn't going to work for composite datasets. We
+    // need a more intrusive fix in the reader/writer itself.
+    int extent[6] = { 0, 0, 0, 0, 0, 0 };
+    float origin[3] = { 0, 0, 0 };
+    int values_read = sscanf(reader->GetHeader(), "EXTENT %d %d %d %d %d %d ORIGIN %f %f %f",
+      &extent[0], &extent[1], &extent[2], &extent[3], &extent[4], &extent[5], &origin[0],
+      &origin[1], &origin[2]);
+    if (values_read != 9)
+    {
+      vtkGenericWarningMacro("EXTENT and ORIGIN may not have been read correctly.");
+    }
+    vtkImageData* clone =
+      vtkImageData::SafeDownCast(reader->GetOutputDataObject(0)->NewInstance());
+    clone->ShallowCopy(reader->GetOutputDataObject(0));
+    clone->SetOrigin(origin[0], origin[1], origin[2]);
+    clone->SetExtent(extent);
+    // reconstructing data distributted on MPI node, so global ids are valid
+    // global ids attributes are removed when appending data so we set
+    // the active global ids attribute to nullptr which keeps the global ids array.
+    unsetGlobalIdsAttribute(clone);
+    piece.TakeReference(clone);
+  }
+  else
+  {
+    piece = reader->GetOutputDataObject(0);
+    // reconstructing data distributted on MPI node, so global ids are valid
+    unsetGlobalIdsAttribute(piece);
+  }
+  mystring->Delete();
+  mystring = nullptr;
+  reader->Delete();
+  reader = nullptr;
+  delete[] realBuffer;
+  return piece;
+}
 };
 
 vtkStandardNewMacro(vtkMPIMoveData);
@@ -73,12 +164,14 @@ vtkStandardNewMacro(vtkMPIMoveData);
 vtkCxxSetObjectMacro(vtkMPIMoveData, Controller, vtkMultiProcessController);
 vtkCxxSetObjectMacro(vtkMPIMoveData, ClientDataServerSocketController, vtkMultiProcessController);
 vtkCxxSetObjectMacro(vtkMPIMoveData, MPIMToNSocketConnection, vtkMPIMToNSocketConnection);
+vtkCxxSetObjectMacro(vtkMPIMoveData, StripedDeliveryConnection, vtkMPIMToNSocketConnection);
 //-----------------------------------------------------------------------------
 vtkMPIMoveData::vtkMPIMoveData()
 {
   this->Controller = nullptr;
   this->ClientDataServerSocketController = nullptr;
   this->MPIMToNSocketConnection = nullptr;
+  this->StripedDeliveryConnection = nullptr;
 
   this->SetController(vtkMultiProcessController::GetGlobalController());
 
@@ -110,6 +203,7 @@ vtkMPIMoveData::~vtkMPIMoveData()
   this->SetController(nullptr);
   this->SetClientDataServerSocketController(nullptr);
   this->SetMPIMToNSocketConnection(nullptr);
+  this->SetStripedDeliveryConnection(nullptr);
   this->ClearBuffer();
 }
 
@@ -150,6 +244,7 @@ void vtkMPIMoveData::InitializeForCommunicationForParaView()
 
   this->SetController(pm->GetGlobalController());
   this->SetMPIMToNSocketConnection(session->GetMPIMToNSocketConnection());
+  this->SetStripedDeliveryConnection(session->GetStripedDeliveryConnection());
 }
 
 //----------------------------------------------------------------------------
@@ -410,13 +505,12 @@ int vtkMPIMoveData::RequestData(
   {
     if (this->Server == vtkMPIMoveData::DATA_SERVER)
     {
-      this->DataServerGatherToZero(input, output);
-      this->DataServerSendToClient(output);
+      this->DataServerCollectToClient(input, output);
       return 1;
     }
     if (this->Server == vtkMPIMoveData::CLIENT)
     {
-      this->ClientReceiveFromDataServer(output);
+      this->ClientReceiveCollectedFromDataServer(output);
       return 1;
     }
     // Render server does nothing
@@ -431,8 +525,7 @@ int vtkMPIMoveData::RequestData(
       if (this->Server == vtkMPIMoveData::DATA_SERVER)
       {
         vtkDataObject* tmp = input->NewInstance();
-        this->DataServerGatherToZero(input, tmp);
-        this->DataServerSendToClient(tmp);
+        this->DataServerCollectToClient(input, tmp);
         tmp->Delete();
         tmp = nullptr;
         vtkVLogF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "pass-through");
@@ -441,7 +534,7 @@ int vtkMPIMoveData::RequestData(
       }
       if (this->Server == vtkMPIMoveData::CLIENT)
       {
-        this->ClientReceiveFromDataServer(output);
+        this->ClientReceiveCollectedFromDataServer(output);
         return 1;
       }
     }
@@ -457,8 +550,7 @@ int vtkMPIMoveData::RequestData(
         output->Initialize();
 
         // Collect to client.
-        this->DataServerGatherToZero(input, output);
-        this->DataServerSendToClient(output);
+        this->DataServerCollectToClient(input, output);
         output->Initialize();
         return 1;
       }
@@ -469,7 +561,7 @@ int vtkMPIMoveData::RequestData(
       }
       if (this->Server == vtkMPIMoveData::CLIENT)
       {
-        this->ClientReceiveFromDataServer(output);
+        this->ClientReceiveCollectedFromDataServer(output);
         return 1;
       }
     }
@@ -512,7 +604,7 @@ void vtkMPIMoveData::DataServerAllToN(vtkDataObject* input, vtkDataObject* outpu
   }
 
   // Perform the M to N operation.
-  vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "redistribute MxN (M=%d, N=%d)", m, n);
+  PARAVIEW_LOG_SCOPE_F(DATA_MOVEMENT, "redistribute MxN (M=%d, N=%d)", m, n);
   vtkAllToNRedistributeCompositePolyData* AllToN = nullptr;
   AllToN = vtkAllToNRedistributeCompositePolyData::New();
   AllToN->SetController(controller);
@@ -539,7 +631,7 @@ void vtkMPIMoveData::DataServerGatherAll(vtkDataObject* input, vtkDataObject* ou
     return;
   }
 
-  vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "gather-all");
+  PARAVIEW_LOG_SCOPE_F(DATA_MOVEMENT, "gather-all");
 
   int idx;
   auto com = this->Controller->GetCommunicator();
@@ -612,7 +704,7 @@ void vtkMPIMoveData::DataServerGatherToZero(vtkDataObject* input, vtkDataObject*
 
   vtkTimerLog::MarkStartEvent("Dataserver gathering to 0");
 
-  vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "gather-to-0");
+  PARAVIEW_LOG_SCOPE_F(DATA_MOVEMENT, "gather-to-0");
   int idx;
   int myId = this->Controller->GetLocalProcessId();
   auto com = this->Controller->GetCommunicator();
@@ -686,7 +778,7 @@ void vtkMPIMoveData::DataServerSendToRenderServer(vtkDataObject* output)
     return;
   }
 
-  vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "send-to-renderserver");
+  PARAVIEW_LOG_SCOPE_F(DATA_MOVEMENT, "send-to-renderserver");
 
   // int fixme;
   // We might be able to eliminate this marshal.
@@ -709,7 +801,7 @@ void vtkMPIMoveData::RenderServerReceiveFromDataServer(vtkDataObject* output)
     return;
   }
 
-  vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "receive-from-dataserver");
+  PARAVIEW_LOG_SCOPE_F(DATA_MOVEMENT, "receive-from-dataserver");
 
   this->ClearBuffer();
   com->Receive(&(this->NumberOfBuffers), 1, 1, 23480);
@@ -747,7 +839,7 @@ void vtkMPIMoveData::DataServerZeroSendToRenderServerZero(vtkDataObject* data)
       return;
     }
 
-    vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "send-to-renderserver-root");
+    PARAVIEW_LOG_SCOPE_F(DATA_MOVEMENT, "send-to-renderserver-root");
 
     // int fixme;
     // We might be able to eliminate this marshal.
@@ -775,7 +867,7 @@ void vtkMPIMoveData::RenderServerZeroReceiveFromDataServerZero(vtkDataObject* da
       return;
     }
 
-    vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "receive-from-dataserver-root");
+    PARAVIEW_LOG_SCOPE_F(DATA_MOVEMENT, "receive-from-dataserver-root");
 
     this->ClearBuffer();
     com->Receive(&(this->NumberOfBuffers), 1, 1, 23480);
@@ -810,7 +902,7 @@ void vtkMPIMoveData::DataServerSendToClient(vtkDataObject* output)
 
   if (myId == 0)
   {
-    vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "send-to-client");
+    PARAVIEW_LOG_SCOPE_F(DATA_MOVEMENT, "send-to-client");
     vtkTimerLog::MarkStartEvent("Dataserver sending to client");
     this->ClearBuffer();
     this->MarshalDataToBuffer(output);
@@ -834,7 +926,7 @@ void vtkMPIMoveData::ClientReceiveFromDataServer(vtkDataObject* output)
     return;
   }
 
-  vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "receive-from-dataserver");
+  PARAVIEW_LOG_SCOPE_F(DATA_MOVEMENT, "receive-from-dataserver");
 
   this->ClearBuffer();
   com->Receive(&(this->NumberOfBuffers), 1, 1, 23490);
@@ -854,6 +946,182 @@ void vtkMPIMoveData::ClientReceiveFromDataServer(vtkDataObject* output)
   this->ClearBuffer();
 }
 
+//-----------------------------------------------------------------------------
+void vtkMPIMoveData::DataServerCollectToClient(vtkDataObject* input, vtkDataObject* output)
+{
+  const int numProcs = this->Controller->GetNumberOfProcesses();
+  const bool striped = this->StripedDeliveryConnection != nullptr &&
+    this->StripedDeliveryConnection->GetNumberOfConnections() > 1 && numProcs > 1 &&
+    !this->SkipDataServerGatherToZero;
+
+  // the client cannot tell whether the data is striped or not, e.g. when the
+  // gather is skipped, so the root tells it.
+  if (this->StripedDeliveryConnection && this->ClientDataServerSocketController &&
+    this->Controller->GetLocalProcessId() == 0)
+  {
+    int flag = striped ? 1 : 0;
+    this->ClientDataServerSocketController->Send(&flag, 1, 1, 23493);
+  }
+
+  if (striped)
+  {
+    this->DataServerStripedSendToClient(input);
+  }
+  else
+  {
+    this->DataServerGatherToZero(input, output);
+    this->DataServerSendToClient(output);
+  }
+}
+
+//-----------------------------------------------------------------------------
+void vtkMPIMoveData::ClientReceiveCollectedFromDataServer(vtkDataObject* output)
+{
+  int striped = 0;
+  if (this->StripedDeliveryConnection)
+  {
+    this->ClientDataServerSocketController->Receive(&striped, 1, 1, 23493);
+  }
+
+  if (striped)
+  {
+    this->ClientStripedReceiveFromDataServer(output);
+  }
+  else
+  {
+    this->ClientReceiveFromDataServer(output);
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Processes connected to the client forward their own piece and the pieces of
+// the processes `numStreams` apart, e.g. with 2 streams, process 0 sends the
+// pieces of processes 0, 2, 4... and process 1 those of processes 1, 3, 5...
+void vtkMPIMoveData::DataServerStripedSendToClient(vtkDataObject* input)
+{
+  const int numProcs = this->Controller->GetNumberOfProcesses();
+  const int myId = this->Controller->GetLocalProcessId();
+  const int numStreams =
+    std::min(numProcs, this->StripedDeliveryConnection->GetNumberOfConnections());
+  const int stream = myId % numStreams;
+
+  this->ClearBuffer();
+  this->MarshalDataToBuffer(input);
+
+  if (myId != stream)
+  {
+    PARAVIEW_LOG_SCOPE_F(DATA_MOVEMENT, "send-to-stream %d", stream);
+    this->Controller->Send(&this->BufferTotalLength, 1, stream, 23494);
+    this->Controller->Send(this->Buffers, this->BufferTotalLength, stream, 23495);
+    this->ClearBuffer();
+    return;
+  }
+
+  vtkSocketCommunicator* com = this->StripedDeliveryConnection->GetSocketCommunicator();
+  if (com == nullptr)
+  {
+    vtkErrorMacro("Missing striped delivery socket on process " << myId << ".");
+    this->ClearBuffer();
+    return;
+  }
+
+  PARAVIEW_LOG_SCOPE_F(DATA_MOVEMENT, "striped-send-to-client (streams=%d)", numStreams);
+  vtkTimerLog::MarkStartEvent("Dataserver striped sending to client");
+
+  std::vector<int> ranks(1, myId);
+  std::vector<vtkIdType> lengths(1, this->BufferTotalLength);
+  std::vector<std::unique_ptr<char[]>> buffers;
+  buffers.emplace_back(this->Buffers);
+  this->Buffers = nullptr;
+  this->ClearBuffer();
+
+  for (int rank = myId + numStreams; rank < numProcs; rank += numStreams)
+  {
+    vtkIdType length = 0;
+    this->Controller->Receive(&length, 1, rank, 23494);
+    buffers.emplace_back(new char[length]);
+    this->Controller->Receive(buffers.back().get(), length, rank, 23495);
+    ranks.push_back(rank);
+    lengths.push_back(length);
+  }
+
+  int count = static_cast<int>(ranks.size());
+  com->Send(&count, 1, 1, 23496);
+  com->Send(ranks.data(), count, 1, 23497);
+  com->Send(lengths.data(), count, 1, 23498);
+  for (int cc = 0; cc < count; ++cc)
+  {
+    com->Send(buffers[cc].get(), lengths[cc], 1, 23499);
+  }
+  vtkTimerLog::MarkEndEvent("Dataserver striped sending to client");
+}
+
+//-----------------------------------------------------------------------------
+void vtkMPIMoveData::ClientStripedReceiveFromDataServer(vtkDataObject* output)
+{
+  const int numStreams = this->StripedDeliveryConnection->GetNumberOfSocketCommunicators();
+  const bool is_image_data = output->IsA("vtkImageData") != 0;
+
+  PARAVIEW_LOG_SCOPE_F(DATA_MOVEMENT, "striped-receive-from-dataserver (streams=%d)", numStreams);
+
+  struct Piece
+  {
+    int Rank;
+    vtkSmartPointer<vtkDataObject> Data;
+  };
+  std::vector<std::vector<Piece>> streams(numStreams);
+
+  // receive from every socket concurrently, reading the pieces as they arrive
+  // so that parsing overlaps with the transfer on the other sockets.
+  std::vector<std::thread> threads;
+  for (int cc = 0; cc < numStreams; ++cc)
+  {
+    vtkSocketCommunicator* com = this->StripedDeliveryConnection->GetSocketCommunicator(cc);
+    if (com == nullptr)
+    {
+      vtkErrorMacro("Missing striped delivery socket " << cc << ".");
+      continue;
+    }
+    threads.emplace_back(
+      [com, is_image_data](std::vector<Piece>& pieces)
+      {
+        int count = 0;
+        com->Receive(&count, 1, 1, 23496);
+        std::vector<int> ranks(count);
+        std::vector<vtkIdType> lengths(count);
+        com->Receive(ranks.data(), count, 1, 23497);
+        com->Receive(lengths.data(), count, 1, 23498);
+        for (int idx = 0; idx < count; ++idx)
+        {
+          std::unique_ptr<char[]> buffer(new char[lengths[idx]]);
+          com->Receive(buffer.get(), lengths[idx], 1, 23499);
+          pieces.push_back(Piece{ ranks[idx],
+            vtkMPIMoveDataReadPiece(buffer.get(), lengths[idx], is_image_data, false) });
+        }
+      },
+      std::ref(streams[cc]));
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  // merge in rank order, as when the data is gathered on the data server root.
+  std::vector<Piece> ordered;
+  for (auto& pieces : streams)
+  {
+    std::move(pieces.begin(), pieces.end(), std::back_inserter(ordered));
+  }
+  std::sort(ordered.begin(), ordered.end(),
+    [](const Piece& a, const Piece& b) { return a.Rank < b.Rank; });
+  std::vector<vtkSmartPointer<vtkDataObject>> pieces;
+  for (auto& piece : ordered)
+  {
+    pieces.push_back(piece.Data);
+  }
+  vtkMPIMoveDataMerge(pieces, output);
+}
+
 //-----------------------------------------------------------------------------
 void vtkMPIMoveData::RenderServerZeroBroadcast(vtkDataObject* data)
 {
@@ -864,7 +1132,7 @@ void vtkMPIMoveData::RenderServerZeroBroadcast(vtkDataObject* data)
     return;
   }
 
-  vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "broadcast");
+  PARAVIEW_LOG_SCOPE_F(DATA_MOVEMENT, "broadcast");
   int myId = this->Controller->GetLocalProcessId();
 
   auto com = this->Controller->GetCommunicator();
@@ -1026,78 +1294,7 @@ void vtkMPIMoveData::ReconstructDataFromBuffer(vtkDataObject* data)
     char* bufferArray = this->Buffers + this->BufferOffsets[idx];
     vtkIdType bufferLength = this->BufferLengths[idx];
 
-    char* realBuffer = nullptr;
-    if (bufferLength > 4 && strncmp(bufferArray, "zlib", 4) == 0)
-    {
-      // sender used zlib compression. Decompress it.
-      vtkIdType compressed_length = bufferLength - 8; // remove the zlib header.
-      vtkIdType uncompressed_length = 0;
-      for (int cc = 0; cc < 4; cc++)
-      {
-        uncompressed_length = uncompressed_length | ((0xff & (bufferArray[4 + cc])) << 8 * cc);
-      }
-
-      // using zlib compression.
-      realBuffer = new char[uncompressed_length];
-      uLongf destLen = uncompressed_length;
-      vtkTimerLog::MarkStartEvent("Zlib uncompress");
-      uncompress(reinterpret_cast<Bytef*>(realBuffer), &destLen,
-        reinterpret_cast<const Bytef*>(bufferArray + 8), compressed_length);
-      vtkTimerLog::MarkEndEvent("Zlib uncompress");
-
-      bufferArray = realBuffer;
-      bufferLength = uncompressed_length;
-    }
-
-    // Setup a reader.
-    vtkDataReader* reader = vtkGenericDataObjectReader::New();
-    reader->ReadFromInputStringOn();
-
-    vtkCharArray* mystring = vtkCharArray::New();
-    mystring->SetArray(bufferArray, bufferLength, 1);
-    reader->SetInputArray(mystring);
-    reader->Modified(); // For append loop
-    reader->Update();
-
-    if (is_image_data)
-    {
-      // FIXME: EXTENT and ORIGIN in vtkImageData are lost by reader/writer.
-      // The header hack we used isn't going to work for composite datasets. We
-      // need a more intrusive fix in the reader/writer itself.
-      int extent[6] = { 0, 0, 0, 0, 0, 0 };
-      float origin[3] = { 0, 0, 0 };
-      int values_read = sscanf(reader->GetHeader(), "EXTENT %d %d %d %d %d %d ORIGIN %f %f %f",
-        &extent[0], &extent[1], &extent[2], &extent[3], &extent[4], &extent[5], &origin[0],
-        &origin[1], &origin[2]);
-      if (values_read != 9)
-      {
-        vtkWarningMacro("EXTENT and ORIGIN may not have been read correctly.");
-      }
-      vtkImageData* clone =
-        vtkImageData::SafeDownCast(reader->GetOutputDataObject(0)->NewInstance());
-      clone->ShallowCopy(reader->GetOutputDataObject(0));
-      clone->SetOrigin(origin[0], origin[1], origin[2]);
-      clone->SetExtent(extent);
-      // reconstructing data distributted on MPI node, so global ids are valid
-      // global ids attributes are removed when appending data so we set
-      // the active global ids attribute to nullptr which keeps the global ids array.
-      unsetGlobalIdsAttribute(clone);
-      pieces.push_back(clone);
-      clone->Delete();
-    }
-    else
-    {
-      vtkDataObject* output = reader->GetOutputDataObject(0);
-      // reconstructing data distributted on MPI node, so global ids are valid
-      unsetGlobalIdsAttribute(output);
-      pieces.push_back(output);
-    }
-    mystring->Delete();
-    mystring = nullptr;
-    reader->Delete();
-    reader = nullptr;
-    delete[] realBuffer;
-    realBuffer = nullptr;
+    pieces.push_back(vtkMPIMoveDataReadPiece(bufferArray, bufferLength, is_image_data));
   }
 
   vtkMPIMoveDataMerge(pieces, data);
@@ -1111,6 +1308,7 @@ void vtkMPIMoveData::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Server: " << this->Server << endl;
   os << indent << "MoveMode: " << this->MoveMode << endl;
   os << indent << "SkipDataServerGatherToZero: " << this->SkipDataServerGatherToZero << endl;
+  os << indent << "StripedDeliveryConnection: " << this->StripedDeliveryConnection << endl;
   os << indent << "OutputDataType: ";
   if (this->OutputDataType == VTK_POLY_DATA)
   {
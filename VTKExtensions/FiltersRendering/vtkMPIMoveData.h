@@ -10,6 +10,13 @@
  * processes. It can redistributed polydata from M to N processors.
  * Update: This filter can now support delivering vtkUniformGridAMR datasets in
  * PASS_THROUGH and/or COLLECT modes.
+ *
+ * When a striped delivery connection is set on the data server and the
+ * client, data collected to the client is not gathered on the data server
+ * root. Instead, the data server processes connected to the client each
+ * forward the pieces of a subset of the processes to the client over their
+ * own socket, and the client receives and reads the pieces of all sockets
+ * concurrently before merging them.
  */
 
 #ifndef vtkMPIMoveData_h
@@ -51,11 +58,16 @@ public:
    * ClientDataServerController==0  => One MPI program.
    * MPIMToNSocketConnection==0 => Client-DataServer.
    * MPIMToNSocketConnection==1 => Client-DataServer-RenderServer.
+   * StripedDeliveryConnection is optionally set on the data server and the
+   * client. It has sockets between several data server processes and the
+   * client which are used to send collected data to the client.
    */
   void SetController(vtkMultiProcessController* controller);
   void SetMPIMToNSocketConnection(vtkMPIMToNSocketConnection* sc);
   void SetClientDataServerSocketController(vtkMultiProcessController*);
   vtkGetObjectMacro(ClientDataServerSocketController, vtkMultiProcessController);
+  void SetStripedDeliveryConnection(vtkMPIMToNSocketConnection* sc);
+  vtkGetObjectMacro(StripedDeliveryConnection, vtkMPIMToNSocketConnection);
   ///@}
 
   ///@{
@@ -142,6 +154,7 @@ protected:
   vtkMultiProcessController* Controller;
   vtkMultiProcessController* ClientDataServerSocketController;
   vtkMPIMToNSocketConnection* MPIMToNSocketConnection;
+  vtkMPIMToNSocketConnection* StripedDeliveryConnection;
 
   void DataServerAllToN(vtkDataObject* inData, vtkDataObject* outData, int n);
   void DataServerGatherAll(vtkDataObject* input, vtkDataObject* output);
@@ -154,6 +167,19 @@ protected:
   void DataServerSendToClient(vtkDataObject* output);
   void ClientReceiveFromDataServer(vtkDataObject* output);
 
+  ///@{
+  /**
+   * Collects the data to the client, either by gathering it on the data
+   * server root which sends it to the client, or striped over the sockets of
+   * the StripedDeliveryConnection. `output` is only used as scratch space on
+   * the data server.
+   */
+  void DataServerCollectToClient(vtkDataObject* input, vtkDataObject* output);
+  void ClientReceiveCollectedFromDataServer(vtkDataObject* output);
+  void DataServerStripedSendToClient(vtkDataObject* input);
+  void ClientStripedReceiveFromDataServer(vtkDataObject* output);
+  ///@}
+
   int NumberOfBuffers;
   vtkIdType* BufferLengths;
   vtkIdType* BufferOffsets;
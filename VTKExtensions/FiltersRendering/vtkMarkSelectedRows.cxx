@@ -3,9 +3,12 @@
 #include "vtkMarkSelectedRows.h"
 
 #include "vtkCharArray.h"
+#include "vtkConstantArray.h"
 #include "vtkDataTabulator.h"
 #include "vtkIdTypeArray.h"
+#include "vtkImplicitColumnBackends.h"
 #include "vtkInformation.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPartitionedDataSet.h"
 #include "vtkTable.h"
@@ -120,41 +123,39 @@ int vtkMarkSelectedRows::RequestData(
     const auto numRows = inputTable->GetNumberOfRows();
     auto clone = vtkTable::New();
     clone->ShallowCopy(inputTable);
-
-    vtkCharArray* selected = vtkCharArray::New();
-    selected->SetName("__vtkIsSelected__");
-    selected->SetNumberOfTuples(numRows);
-    selected->FillValue(0);
-
-    clone->AddColumn(selected);
-    selected->FastDelete();
-
     output->SetPartition(cc, clone);
     clone->FastDelete();
 
-    if (numRows == 0)
+    vtkIdTypeArray* selectedIds = nullptr;
+    auto extractedIter = extractedInputMap.find(::GetCompositeId(input, cc));
+    if (numRows > 0 && extractedIter != extractedInputMap.end() && extractedIter->second)
     {
-      continue;
+      selectedIds = vtkIdTypeArray::SafeDownCast(
+        extractedIter->second->GetColumnByName(originalIdArrayName));
     }
 
-    auto cid = ::GetCompositeId(input, cc);
-    if (extractedInputMap.find(cid) == extractedInputMap.end())
-    {
-      continue;
-    }
-
-    auto extractedTable = extractedInputMap[cid];
-    auto selectedIds =
-      vtkIdTypeArray::SafeDownCast(extractedTable->GetColumnByName(originalIdArrayName));
     if (!selectedIds || selectedIds->GetNumberOfTuples() == 0)
     {
+      // nothing selected in this partition, avoid allocating a column of zeros.
+      vtkNew<vtkConstantArray<char>> notSelected;
+      notSelected->SetName("__vtkIsSelected__");
+      notSelected->SetNumberOfValues(numRows);
+      notSelected->ConstructBackend(0);
+      clone->AddColumn(notSelected);
       continue;
     }
 
-    auto inputIds = vtkIdTypeArray::SafeDownCast(clone->GetColumnByName("vtkOriginalIndices"));
+    vtkNew<vtkCharArray> selected;
+    selected->SetName("__vtkIsSelected__");
+    selected->SetNumberOfTuples(numRows);
+    selected->FillValue(0);
+    clone->AddColumn(selected);
+
+    // vtkOriginalIndices may be an implicit array, see vtkDataTabulator::UseImplicitArrays.
+    auto inputIds = vtkDataArray::SafeDownCast(clone->GetColumnByName("vtkOriginalIndices"));
     for (vtkIdType idx = 0; idx < numRows; ++idx)
     {
-      vtkIdType id = inputIds ? inputIds->GetTypedComponent(idx, 0) : idx;
+      vtkIdType id = inputIds ? vtkImplicitColumnGetComponent<vtkIdType>(inputIds, idx, 0) : idx;
       if (selectedIds->LookupTypedValue(id) != -1)
       {
         selected->SetTypedComponent(idx, 0, 1);
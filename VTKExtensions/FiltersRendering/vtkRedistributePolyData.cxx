@@ -234,6 +234,17 @@ int vtkRedistributePolyData::RequestData(vtkInformation* vtkNotUsed(request),
     // added
 
     origNumCells[type] = std::min(origNumCells[type], numCells[type]);
+
+    // ... with a keep list, a processor may both send and receive cells
+    //   of a type, the cells kept are the ones not received ...
+    if (keepCellList != nullptr)
+    {
+      origNumCells[type] = numCells[type];
+      for (i = 0; i < cntRec; i++)
+      {
+        origNumCells[type] -= recNum[type][i];
+      }
+    }
   }
 
 #if VTK_REDIST_DO_TIMING
@@ -316,7 +327,7 @@ int vtkRedistributePolyData::RequestData(vtkInformation* vtkNotUsed(request),
   // ... find memory requirements for on processor copy ...
   vtkIdType numPointsOnProc = 0;
   vtkIdType numCellPtsOnProc[NUM_CELL_TYPES];
-  this->FindMemReq(origNumCells, input, numPointsOnProc, numCellPtsOnProc);
+  this->FindMemReq(origNumCells, input, numPointsOnProc, numCellPtsOnProc, keepCellList);
 
 #if VTK_REDIST_DO_TIMING
   ::timerInfo8.timer->StopTimer();
@@ -1667,8 +1678,8 @@ void vtkRedistributePolyData::AllocateArrays(vtkDataArray* Data, vtkIdType numTo
 }
 //----------------------------------------------------------------------
 //*****************************************************************
-void vtkRedistributePolyData::FindMemReq(
-  vtkIdType* origNumCells, vtkPolyData* input, vtkIdType& numPoints, vtkIdType* numCellPts)
+void vtkRedistributePolyData::FindMemReq(vtkIdType* origNumCells, vtkPolyData* input,
+  vtkIdType& numPoints, vtkIdType* numCellPts, vtkIdType** keepCellList)
 //*****************************************************************
 {
   // ... count number of cellpoints, corresponding points and
@@ -1706,6 +1717,11 @@ void vtkRedistributePolyData::FindMemReq(
       numCellPts[type] = 0;
       for (cellId = 0; cellId < origNumCells[type]; cellId++, cellIter->GoToNextCell())
       {
+        // ... the cells kept are listed when they are not the first ones ...
+        if (keepCellList != nullptr)
+        {
+          cellIter->GoToCell(keepCellList[type][cellId]);
+        }
         vtkIdList* cell = cellIter->GetCurrentCell();
         const vtkIdType npts = cell->GetNumberOfIds();
         numCellPts[type]++;
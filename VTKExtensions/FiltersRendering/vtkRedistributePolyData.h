@@ -106,7 +106,7 @@ protected:
   void ReceiveCells(
     vtkIdType*, vtkIdType*, vtkPolyData*, int, vtkIdType*, vtkIdType*, vtkIdType, vtkIdType);
 
-  void FindMemReq(vtkIdType*, vtkPolyData*, vtkIdType&, vtkIdType*);
+  void FindMemReq(vtkIdType*, vtkPolyData*, vtkIdType&, vtkIdType*, vtkIdType** = nullptr);
 
   void AllocateCellDataArrays(vtkDataSetAttributes*, vtkIdType**, int, vtkIdType*);
   void AllocatePointDataArrays(vtkDataSetAttributes*, vtkIdType*, int, vtkIdType);
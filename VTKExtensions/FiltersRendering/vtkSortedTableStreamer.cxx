@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkSortedTableStreamer.h"
 
+#include "vtkAOSDataArrayTemplate.h"
 #include "vtkCellArray.h"
 #include "vtkCommunicator.h"
 #include "vtkCompositeDataSet.h"
@@ -12,20 +13,26 @@
 #include "vtkDoubleArray.h"
 #include "vtkExtractSelection.h"
 #include "vtkIdTypeArray.h"
+#include "vtkImplicitArray.h"
+#include "vtkImplicitColumnBackends.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkIntArray.h"
 #include "vtkMath.h"
 #include "vtkMinimalStandardRandomSequence.h"
 #include "vtkMultiProcessController.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPartitionedDataSet.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStringArray.h"
 #include "vtkTable.h"
-#include "vtkUnsignedIntArray.h"
+#include "vtkTypeTraits.h"
 
 #include <algorithm>
+#include <limits>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <unordered_map>
@@ -34,6 +41,35 @@
 
 using std::ostringstream;
 
+namespace
+{
+//----------------------------------------------------------------------------
+template <typename ValueType>
+vtkSmartPointer<vtkDataArray> NewConcatenatedArray(
+  const std::shared_ptr<vtkConcatenatedImplicitBackend<ValueType>>& backend,
+  int numberOfComponents)
+{
+  vtkNew<vtkImplicitArray<vtkConcatenatedImplicitBackend<ValueType>>> array;
+  array->SetBackend(backend);
+  array->SetNumberOfComponents(numberOfComponents);
+  array->SetNumberOfTuples(backend->GetNumberOfTuples());
+  return array;
+}
+
+//----------------------------------------------------------------------------
+template <typename ValueType>
+vtkSmartPointer<vtkDataArray> ConcatenateArrays(
+  const std::vector<vtkDataArray*>& arrays, int numberOfComponents)
+{
+  auto backend = std::make_shared<vtkConcatenatedImplicitBackend<ValueType>>(numberOfComponents);
+  for (auto array : arrays)
+  {
+    backend->AppendArray(array);
+  }
+  return ::NewConcatenatedArray(backend, numberOfComponents);
+}
+}
+
 //****************************************************************************
 class vtkSortedTableStreamer::InternalsBase
 {
@@ -62,6 +98,25 @@ public:
   //         << " - Type: set var debug = false" << endl;
   //    while (debug) sleep(5);
   //    }
+  // --------------------------------------------------------------------------
+  // Returns a new array to copy the values of an array into. Implicit arrays,
+  // which can not be extended, give an array using the standard layout. As
+  // implicit arrays of vtkIdType report the type vtkIdType is an alias of, a
+  // vtkIdTypeArray is used for these so that ids keep their usual type.
+  static vtkAbstractArray* NewConcreteInstance(vtkAbstractArray* array)
+  {
+    if (array->GetArrayType() != vtkAbstractArray::ImplicitArray)
+    {
+      return array->NewInstance();
+    }
+    int dataType = array->GetDataType();
+    if (dataType == vtkTypeTraits<vtkIdType>::VTK_TYPE_ID)
+    {
+      dataType = VTK_ID_TYPE;
+    }
+    return vtkAbstractArray::CreateArray(dataType);
+  }
+
   // --------------------------------------------------------------------------
   static void MergeTable(
     vtkIdType processId, vtkTable* otherTable, vtkTable* mergedTable, vtkIdType minSize)
@@ -78,7 +133,7 @@ public:
 
       if (needNewArray)
       {
-        dstArray = otherArray->NewInstance();
+        dstArray = NewConcreteInstance(otherArray);
         dstArray->SetNumberOfComponents(otherArray->GetNumberOfComponents());
         dstArray->SetName(otherArray->GetName());
         dstArray->Allocate(minSize * otherArray->GetNumberOfComponents());
@@ -466,6 +521,7 @@ public:
     {
       this->Array = nullptr;
       this->Histo = nullptr;
+      this->ArraySize = 0;
     }
 
     ~ArraySorter() { this->Clear(); }
@@ -482,6 +538,7 @@ public:
         delete this->Histo;
         this->Histo = nullptr;
       }
+      this->ArraySize = 0;
     }
     void FillArray(vtkIdType numTuples)
     {
@@ -500,8 +557,9 @@ public:
       }
     }
 
-    void Update(T* dataPtr, vtkIdType numTuples, int numComponents, int selectedComponent,
-      vtkIdType histogramSize, double* scalarRange, bool reverseOrder)
+    // Fill the sortable array with the values of the selected component, or
+    // their magnitude if selectedComponent is negative, without sorting it.
+    void Fill(T* dataPtr, vtkIdType numTuples, int numComponents, int selectedComponent)
     {
       // Clear memory if needed
       this->Clear();
@@ -512,46 +570,120 @@ public:
       }
 
       // Allocate memory and fill the structure
-      this->Histo = new Histogram(histogramSize);
-      this->Histo->Inverted = reverseOrder;
-      this->Histo->SetScalarRange(scalarRange);
       this->ArraySize = numTuples;
       this->Array = new SortableArrayItem[this->ArraySize];
 
-      // Fill the sortable array
-      for (vtkIdType i = 0; i < this->ArraySize; ++i)
-      {
-        this->Array[i].OriginalIndex = i;
-        double value = 0;
-        double tmp;
-        if (selectedComponent < 0)
+      SortableArrayItem* array = this->Array;
+      vtkSMPTools::For(0, numTuples, [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType i = begin; i < end; ++i)
         {
-          // Compute magnitude
-          for (int k = 0; k < numComponents; k++)
+          array[i].OriginalIndex = i;
+          if (selectedComponent < 0)
           {
-            tmp = static_cast<double>(dataPtr[k + i * numComponents]);
-            value += tmp * tmp;
+            // Compute magnitude
+            double value = 0;
+            for (int k = 0; k < numComponents; k++)
+            {
+              double tmp = static_cast<double>(dataPtr[k + i * numComponents]);
+              value += tmp * tmp;
+            }
+            value = sqrt(value) / sqrt(static_cast<double>(numComponents));
+            array[i].Value = static_cast<T>(value);
+          }
+          else
+          {
+            array[i].Value = dataPtr[selectedComponent + i * numComponents];
           }
-          value = sqrt(value) / sqrt(static_cast<double>(numComponents));
-          this->Array[i].Value = static_cast<T>(value);
-        }
-        else
-        {
-          this->Array[i].Value = dataPtr[selectedComponent + i * numComponents];
-          value = static_cast<double>(this->Array[i].Value);
         }
-        this->Histo->AddValue(value);
+      });
+    }
+
+    // Same as above, reading the values from a data array. Arrays that do not
+    // use the standard layout, e.g. implicit arrays, are read value by value
+    // rather than through GetVoidPointer() which would copy them, and with
+    // their value type so that 64-bit ids are not rounded.
+    void Fill(vtkDataArray* data, int selectedComponent)
+    {
+      const vtkIdType numTuples = data->GetNumberOfTuples();
+      const int numComponents = data->GetNumberOfComponents();
+      if (auto aos = vtkArrayDownCast<vtkAOSDataArrayTemplate<T>>(data))
+      {
+        this->Fill(aos->GetPointer(0), numTuples, numComponents, selectedComponent);
+        return;
       }
 
-      // Sort it
-      if (reverseOrder)
+      // Clear memory if needed
+      this->Clear();
+
+      if (numComponents == 1 && selectedComponent < 0)
       {
-        std::sort(this->Array, this->Array + this->ArraySize, SortableArrayItem::Ascendent);
+        selectedComponent = 0; // We can not compute magnitude on scalar value
       }
-      else
+
+      // Allocate memory and fill the structure
+      this->ArraySize = numTuples;
+      this->Array = new SortableArrayItem[this->ArraySize];
+
+      SortableArrayItem* array = this->Array;
+      vtkSMPTools::For(0, numTuples, [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType i = begin; i < end; ++i)
+        {
+          array[i].OriginalIndex = i;
+          if (selectedComponent < 0)
+          {
+            // Compute magnitude
+            double value = 0;
+            for (int k = 0; k < numComponents; k++)
+            {
+              double tmp = data->GetComponent(i, k);
+              value += tmp * tmp;
+            }
+            value = sqrt(value) / sqrt(static_cast<double>(numComponents));
+            array[i].Value = static_cast<T>(value);
+          }
+          else
+          {
+            array[i].Value = vtkImplicitColumnGetComponent<T>(data, i, selectedComponent);
+          }
+        }
+      });
+    }
+
+    // Move the prefixSize first items of the sorted order at the beginning of
+    // the array and sort them. The remaining items are left unsorted.
+    void SortPrefix(vtkIdType prefixSize, bool reverseOrder)
+    {
+      auto compare = reverseOrder ? SortableArrayItem::Ascendent : SortableArrayItem::Descendent;
+      SortableArrayItem* prefixEnd = this->Array + std::min(prefixSize, this->ArraySize);
+      std::nth_element(this->Array, prefixEnd, this->Array + this->ArraySize, compare);
+      vtkSMPTools::Sort(this->Array, prefixEnd, compare);
+    }
+
+    // Sort the items following a prefix already sorted by SortPrefix(), which
+    // completes the sort of the whole array.
+    void SortRemaining(vtkIdType prefixSize, bool reverseOrder)
+    {
+      auto compare = reverseOrder ? SortableArrayItem::Ascendent : SortableArrayItem::Descendent;
+      SortableArrayItem* prefixEnd = this->Array + std::min(prefixSize, this->ArraySize);
+      vtkSMPTools::Sort(prefixEnd, this->Array + this->ArraySize, compare);
+    }
+
+    void Update(T* dataPtr, vtkIdType numTuples, int numComponents, int selectedComponent,
+      vtkIdType histogramSize, double* scalarRange, bool reverseOrder)
+    {
+      this->Fill(dataPtr, numTuples, numComponents, selectedComponent);
+
+      // Build the histogram
+      this->Histo = new Histogram(histogramSize);
+      this->Histo->Inverted = reverseOrder;
+      this->Histo->SetScalarRange(scalarRange);
+      for (vtkIdType i = 0; i < this->ArraySize; ++i)
       {
-        std::sort(this->Array, this->Array + this->ArraySize, SortableArrayItem::Descendent);
+        this->Histo->AddValue(static_cast<double>(this->Array[i].Value));
       }
+
+      // Sort it
+      this->SortRemaining(0, reverseOrder);
     }
 
     void SortProcessId(vtkIdType* dataPtr, vtkIdType numTuples, vtkIdType histogramSize,
@@ -588,11 +720,19 @@ public:
     }
   };
 
+  // A value sampled from the sorted array of a process. Samples of all the
+  // processes, sorted, bracket the location of any global index.
+  struct Sample
+  {
+    T Value;
+    int ProcessId;
+    vtkIdType Index; // Index in the sorted array of ProcessId
+  };
+
   Internals()
   {
     // Only used for testing
     this->LocalSorter = nullptr;
-    this->GlobalHistogram = nullptr;
     this->Debug = false;
   }
 
@@ -601,6 +741,7 @@ public:
     // Default values
     this->SelectedComponent = 0;
     this->NeedToBuildCache = true;
+    this->Sortable = -1;
     this->DataToSort = dataToSort;
 
     this->InputMTime = input->GetMTime();
@@ -617,18 +758,19 @@ public:
 
     // Create internal objects
     this->LocalSorter = new ArraySorter();
-    this->GlobalHistogram = new Histogram(HISTOGRAM_SIZE);
   }
 
-  ~Internals() override
-  {
-    delete this->LocalSorter;
-    delete this->GlobalHistogram;
-  }
+  ~Internals() override { delete this->LocalSorter; }
 
   // --------------------------------------------------------------------------
   bool IsSortable() override
   {
+    // The answer only changes with the selected component
+    if (this->Sortable != -1)
+    {
+      return this->Sortable == 1;
+    }
+
     // See if one process is able to sort the table,
     // if not then just say NOT sortable
     int localCanSort = (this->DataToSort == nullptr) ? 0 : 1;
@@ -636,6 +778,7 @@ public:
     this->MPI->AllReduce(&localCanSort, &globalCanSort, 1, vtkCommunicator::MAX_OP);
     if (globalCanSort == 0)
     {
+      this->Sortable = 0;
       return false;
     }
 
@@ -690,6 +833,7 @@ public:
     this->CommonRange[0] -= epsilon;
     this->CommonRange[1] += epsilon;
 
+    this->Sortable = sortable ? 1 : 0;
     return sortable;
   }
 
@@ -698,9 +842,12 @@ public:
   {
     // We are building the cache so no need to build it next time
     this->NeedToBuildCache = false;
-
-    // Communication buffer
-    vtkIdType* bufferHistogramValues = new vtkIdType[this->NumProcs * HISTOGRAM_SIZE];
+    this->InvertOrder = invertOrder;
+    this->SortedPrefixSize = 0;
+    this->FullySorted = false;
+    this->Samples.clear();
+    this->SamplesLowerBound.clear();
+    this->SamplesUpperBound.clear();
 
     // Is there something to sort ???
     if (!sortableArray)
@@ -710,45 +857,153 @@ public:
       {
         this->LocalSorter->FillArray(this->DataToSort->GetNumberOfTuples());
       }
+      return 1;
+    }
+
+    // Only gather the values to sort: the sort itself is done lazily, first
+    // for the top values, then for the whole array, see Compute().
+    if (this->DataToSort)
+    {
+      this->LocalSorter->Fill(this->DataToSort, this->SelectedComponent);
     }
     else
     {
-      if (this->DataToSort)
-      {
-        // Sort and build local histogram
-        this->LocalSorter->Update(static_cast<T*>(this->DataToSort->GetVoidPointer(0)),
-          this->DataToSort->GetNumberOfTuples(), this->DataToSort->GetNumberOfComponents(),
-          this->SelectedComponent, HISTOGRAM_SIZE, this->CommonRange, invertOrder);
-      }
-      else
-      {
-        // Build empty local histogram
-        this->LocalSorter->Clear();
-        this->LocalSorter->Histo = new Histogram(HISTOGRAM_SIZE);
-        this->LocalSorter->Histo->SetScalarRange(this->CommonRange);
-        this->LocalSorter->Histo->Inverted = invertOrder;
-      }
+      this->LocalSorter->Clear();
+    }
 
-      // Initialize the global histogram with same range
-      this->LocalSorter->Histo->CopyRangeTo(*this->GlobalHistogram);
+    // Share the number of values of every process
+    vtkIdType localSize = this->LocalSorter->ArraySize;
+    this->LocalSizes.resize(this->NumProcs);
+    this->MPI->AllGather(&localSize, this->LocalSizes.data(), 1);
+    this->TotalSize = 0;
+    for (vtkIdType size : this->LocalSizes)
+    {
+      this->TotalSize += size;
+    }
+    return 1;
+  }
+
+  // --------------------------------------------------------------------------
+  // Sort the whole local array and build the global samples used to locate a
+  // global index on each process without any further communication.
+  void SortAll()
+  {
+    if (this->FullySorted)
+    {
+      return;
+    }
+    this->FullySorted = true;
+    this->LocalSorter->SortRemaining(this->SortedPrefixSize, this->InvertOrder);
+    this->SortedPrefixSize = this->LocalSorter->ArraySize;
 
-      // Make sure that the global histogram is properly initialized
-      this->GlobalHistogram->ClearHistogramValues();
-      this->GlobalHistogram->Inverted = invertOrder;
+    // Every process samples its sorted array with the same stride so that
+    // each sample stands for the same number of values.
+    const vtkIdType stride =
+      std::max<vtkIdType>(1, (this->TotalSize + MAX_NUMBER_OF_SAMPLES - 1) / MAX_NUMBER_OF_SAMPLES);
+    std::vector<vtkIdType> samplesSizes(this->NumProcs);
+    std::vector<vtkIdType> samplesOffsets(this->NumProcs);
+    vtkIdType numberOfSamples = 0;
+    for (int pid = 0; pid < this->NumProcs; ++pid)
+    {
+      samplesSizes[pid] = (this->LocalSizes[pid] + stride - 1) / stride;
+      samplesOffsets[pid] = numberOfSamples;
+      numberOfSamples += samplesSizes[pid];
+    }
 
-      // Send local histogram and receive every histogram from everybody
-      this->MPI->AllGather(this->LocalSorter->Histo->Values, bufferHistogramValues, HISTOGRAM_SIZE);
+    std::vector<T> localValues(samplesSizes[this->Me]);
+    for (vtkIdType idx = 0; idx < samplesSizes[this->Me]; ++idx)
+    {
+      localValues[idx] = this->LocalSorter->Array[idx * stride].Value;
+    }
+    std::vector<T> values(numberOfSamples);
+    this->MPI->AllGatherV(localValues.data(), values.data(), samplesSizes[this->Me],
+      samplesSizes.data(), samplesOffsets.data());
 
-      // Merge all histogram into the GlobalHistogram
-      for (int idx = 0, nb = this->NumProcs * HISTOGRAM_SIZE; idx < nb; ++idx)
+    this->Samples.resize(numberOfSamples);
+    for (int pid = 0; pid < this->NumProcs; ++pid)
+    {
+      for (vtkIdType idx = 0; idx < samplesSizes[pid]; ++idx)
       {
-        this->GlobalHistogram->TotalValues += bufferHistogramValues[idx];
-        this->GlobalHistogram->Values[idx % HISTOGRAM_SIZE] += bufferHistogramValues[idx];
+        this->Samples[samplesOffsets[pid] + idx] =
+          Sample{ values[samplesOffsets[pid] + idx], pid, idx * stride };
       }
     }
+    std::sort(this->Samples.begin(), this->Samples.end(),
+      [this](const Sample& a, const Sample& b) { return this->IsBefore(a, b); });
 
-    delete[] bufferHistogramValues;
-    return 1;
+    // Bound the number of values located before each sample. For its own
+    // process the count is exact, for the others it lies between the last
+    // sample before and the first sample after it.
+    std::vector<vtkIdType> seen(this->NumProcs, 0);
+    auto lower = [&](int pid) { return seen[pid] > 0 ? (seen[pid] - 1) * stride + 1 : 0; };
+    auto upper = [&](int pid) { return std::min(seen[pid] * stride, this->LocalSizes[pid]); };
+    vtkIdType lowerSum = 0;
+    vtkIdType upperSum = 0;
+    this->SamplesLowerBound.resize(numberOfSamples);
+    this->SamplesUpperBound.resize(numberOfSamples);
+    for (vtkIdType idx = 0; idx < numberOfSamples; ++idx)
+    {
+      const Sample& sample = this->Samples[idx];
+      const int pid = sample.ProcessId;
+      this->SamplesLowerBound[idx] = sample.Index + lowerSum - lower(pid);
+      this->SamplesUpperBound[idx] = sample.Index + upperSum - upper(pid);
+      lowerSum -= lower(pid);
+      upperSum -= upper(pid);
+      seen[pid]++;
+      lowerSum += lower(pid);
+      upperSum += upper(pid);
+    }
+  }
+
+  // --------------------------------------------------------------------------
+  // Global order: by value, then by process id, then by local sorted index.
+  bool IsValueBefore(const T& a, const T& b) const
+  {
+    return this->InvertOrder ? (b < a) : (a < b);
+  }
+  bool IsBefore(const Sample& a, const Sample& b) const
+  {
+    if (this->IsValueBefore(a.Value, b.Value))
+    {
+      return true;
+    }
+    if (this->IsValueBefore(b.Value, a.Value))
+    {
+      return false;
+    }
+    if (a.ProcessId != b.ProcessId)
+    {
+      return this->InvertOrder ? (a.ProcessId > b.ProcessId) : (a.ProcessId < b.ProcessId);
+    }
+    return a.Index < b.Index;
+  }
+
+  // --------------------------------------------------------------------------
+  // Number of local values located before the given sample in the global order
+  vtkIdType GetNumberOfValuesBefore(const Sample& sample) const
+  {
+    if (sample.ProcessId == this->Me)
+    {
+      return sample.Index;
+    }
+    const SortableArrayItem* begin = this->LocalSorter->Array;
+    const SortableArrayItem* end = begin + this->LocalSorter->ArraySize;
+    const bool processBefore =
+      this->InvertOrder ? (this->Me > sample.ProcessId) : (this->Me < sample.ProcessId);
+    if (processBefore)
+    {
+      // Local values equal to the sample are before it
+      return std::upper_bound(begin, end, sample.Value,
+               [this](const T& value, const SortableArrayItem& item) {
+                 return this->IsValueBefore(value, item.Value);
+               }) -
+        begin;
+    }
+    return std::lower_bound(begin, end, sample.Value,
+             [this](const SortableArrayItem& item, const T& value) {
+               return this->IsValueBefore(item.Value, value);
+             }) -
+      begin;
   }
 
   // --------------------------------------------------------------------------
@@ -891,194 +1146,227 @@ public:
   {
     // ------------------------------------------------------------------------
     // Make sure that the Cache is built
-    //    This will sort the local array, that's why we don't want to do it
-    //    at each execution. Specially when we only change the requested block.
+    //    This gathers the values to sort. The sorted order is then kept for
+    //    all the following blocks, until the input or the sorted array change.
     // ------------------------------------------------------------------------
     if (this->NeedToBuildCache)
     {
       this->BuildCache(true, revertOrder);
     }
 
-    // ------------------------------------------------------------------------
-    // Search for lower bound
-    // ------------------------------------------------------------------------
-    vtkIdType nbElementsToRemoveFromHead = 0;
-    vtkIdType localOffset = 0;
-    vtkIdType nbElementsInBar = 0;
-    this->SearchGlobalIndexLocation((block * blockSize), this->LocalSorter->Histo,
-      this->GlobalHistogram, nbElementsToRemoveFromHead, localOffset, nbElementsInBar);
-
-    // ------------------------------------------------------------------------
-    // Search for upper bound
-    // ------------------------------------------------------------------------
-    vtkIdType upperOffset = 0;
-    vtkIdType globalUpperOffset = 0;
-    vtkIdType searchIdx = (this->GlobalHistogram->TotalValues < (block + 1) * blockSize)
-      ? this->GlobalHistogram->TotalValues
-      : ((block + 1) * blockSize);
-    searchIdx--; // It is not a size it is an index (so -1)
-
-    this->SearchGlobalIndexLocation(searchIdx, this->LocalSorter->Histo, this->GlobalHistogram,
-      globalUpperOffset, upperOffset, nbElementsInBar);
-
-    // We have to include our searched index (so +1)
-    vtkIdType localSize = (upperOffset + nbElementsInBar) - localOffset + 1;
+    // Global range of the requested block
+    const vtkIdType first = std::min(block * blockSize, this->TotalSize);
+    const vtkIdType last = std::min(first + blockSize, this->TotalSize);
+    const vtkIdType localSize = this->LocalSorter->ArraySize;
 
     // ------------------------------------------------------------------------
-    // Build local subset table
+    // Find the local values that may belong to the block
     // ------------------------------------------------------------------------
-    vtkSmartPointer<vtkTable> localSubset;
-    localSubset.TakeReference(
-      this->NewSubsetTable(input, this->LocalSorter, localOffset, localSize));
+    vtkIdType candidatesBegin = 0;
+    vtkIdType candidatesEnd = 0;
+    if (!this->FullySorted && last <= TOP_K_SIZE)
+    {
+      // Top values: the first blocks are within the TOP_K_SIZE first values
+      // of every process, which are much faster to get than a full sort.
+      if (this->SortedPrefixSize == 0)
+      {
+        this->LocalSorter->SortPrefix(TOP_K_SIZE, this->InvertOrder);
+        this->SortedPrefixSize = TOP_K_SIZE;
+      }
+      candidatesEnd = std::min(last, localSize);
+    }
+    else
+    {
+      this->SortAll();
 
-    // ------------------------------------------------------------------------
-    // Find the process that will merge all subset table
-    // ------------------------------------------------------------------------
-    int mergePid = GetMergingProcessId(localSubset.GetPointer());
+      // Samples known to be before the first value and after the last one
+      auto lowerSample = std::upper_bound(
+        this->SamplesUpperBound.begin(), this->SamplesUpperBound.end(), first);
+      auto upperSample =
+        std::lower_bound(this->SamplesLowerBound.begin(), this->SamplesLowerBound.end(), last);
+      const auto lowerIdx = lowerSample - this->SamplesUpperBound.begin();
+      const auto upperIdx = upperSample - this->SamplesLowerBound.begin();
+      if (lowerIdx > 0)
+      {
+        candidatesBegin = this->GetNumberOfValuesBefore(this->Samples[lowerIdx - 1]);
+      }
+      candidatesEnd = localSize;
+      if (upperSample != this->SamplesLowerBound.end())
+      {
+        candidatesEnd = this->GetNumberOfValuesBefore(this->Samples[upperIdx]);
+      }
+    }
 
     // ------------------------------------------------------------------------
-    // Add local meta-data in case of merge process
+    // Share the candidate ranges and find the process that will merge the
+    // block, i.e. the one that has the most candidates.
     // ------------------------------------------------------------------------
-    if (this->NumProcs > 1 && this->Me == mergePid)
+    vtkIdType localCandidates[2] = { candidatesBegin, candidatesEnd - candidatesBegin };
+    std::vector<vtkIdType> candidates(2 * this->NumProcs);
+    this->MPI->AllGather(localCandidates, candidates.data(), 2);
+    int mergePid = 0;
+    vtkIdType numberOfValuesBefore = 0;
+    for (int pid = 0; pid < this->NumProcs; pid++)
     {
-      vtkSmartPointer<vtkIdTypeArray> processIdArray = vtkSmartPointer<vtkIdTypeArray>::New();
-      processIdArray->SetName("vtkOriginalProcessIds");
-      processIdArray->SetNumberOfComponents(1);
-      processIdArray->Allocate((blockSize < localSize) ? localSize : blockSize);
-      for (vtkIdType idx = 0; idx < localSubset->GetNumberOfRows(); idx++)
+      numberOfValuesBefore += candidates[2 * pid];
+      if (candidates[2 * pid + 1] > candidates[2 * mergePid + 1])
       {
-        processIdArray->InsertNextTuple1(mergePid);
+        mergePid = pid;
       }
-      localSubset->GetRowData()->AddArray(processIdArray);
     }
 
     // ------------------------------------------------------------------------
-    // Send local subset array to process mergePid
+    // Select the values of the block among the candidates on process mergePid
+    // and tell every process which range of its sorted array belongs to it.
     // ------------------------------------------------------------------------
+    std::vector<Sample> selection;
+    std::vector<vtkIdType> ranges(2 * this->NumProcs, 0);
     if (this->Me != mergePid)
     {
-      this->MPI->Send(localSubset.GetPointer(), mergePid, VTK_TABLE_EXCHANGE_TAG);
+      if (localCandidates[1] > 0)
+      {
+        std::vector<T> values(localCandidates[1]);
+        for (vtkIdType idx = 0; idx < localCandidates[1]; ++idx)
+        {
+          values[idx] = this->LocalSorter->Array[candidatesBegin + idx].Value;
+        }
+        this->MPI->Send(values.data(), localCandidates[1], mergePid, VTK_VALUES_EXCHANGE_TAG);
+      }
     }
-
-    // ------------------------------------------------------------------------
-    // Merging procedure only on process mergePid
-    // ------------------------------------------------------------------------
-    if (this->Me == mergePid)
+    else
     {
-      vtkSmartPointer<vtkTable> tmp = vtkSmartPointer<vtkTable>::New();
-      for (int i = 0; i < this->NumProcs; i++)
+      std::vector<T> values;
+      for (int pid = 0; pid < this->NumProcs; pid++)
       {
-        if (i == mergePid)
+        const vtkIdType offset = candidates[2 * pid];
+        const vtkIdType size = candidates[2 * pid + 1];
+        if (size == 0)
+        {
           continue;
-
-        this->MPI->Receive(tmp.GetPointer(), i, VTK_TABLE_EXCHANGE_TAG);
-        this->MergeTable(i, tmp.GetPointer(), localSubset.GetPointer(), blockSize);
+        }
+        values.resize(size);
+        if (pid == mergePid)
+        {
+          for (vtkIdType idx = 0; idx < size; ++idx)
+          {
+            values[idx] = this->LocalSorter->Array[offset + idx].Value;
+          }
+        }
+        else
+        {
+          this->MPI->Receive(values.data(), size, pid, VTK_VALUES_EXCHANGE_TAG);
+        }
+        for (vtkIdType idx = 0; idx < size; ++idx)
+        {
+          selection.push_back(Sample{ values[idx], pid, offset + idx });
+        }
       }
 
-      // Sort new table/array
-      if (!this->DataToSort)
+      // Keep the values of the block, sorted
+      auto compare = [this](const Sample& a, const Sample& b) { return this->IsBefore(a, b); };
+      const vtkIdType nbToSkip = std::min(
+        first - numberOfValuesBefore, static_cast<vtkIdType>(selection.size()));
+      const vtkIdType nbToKeep =
+        std::min(last - first, static_cast<vtkIdType>(selection.size()) - nbToSkip);
+      auto blockBegin = selection.begin() + nbToSkip;
+      auto blockEnd = blockBegin + nbToKeep;
+      std::nth_element(selection.begin(), blockBegin, selection.end(), compare);
+      std::nth_element(blockBegin, blockEnd, selection.end(), compare);
+      std::sort(blockBegin, blockEnd, compare);
+      selection.erase(blockEnd, selection.end());
+      selection.erase(selection.begin(), blockBegin);
+
+      // Values of a process within a block are contiguous in its sorted array
+      for (int pid = 0; pid < this->NumProcs; pid++)
       {
-        // This mean that no output can be provided
-        // cout << "ERROR the merge process have no DataArray." << endl;
-        return 1;
+        ranges[2 * pid] = std::numeric_limits<vtkIdType>::max();
       }
-      vtkDataArray* subsetArray =
-        vtkDataArray::SafeDownCast(localSubset->GetColumnByName(this->DataToSort->GetName()));
-
-      if (!subsetArray)
+      for (const Sample& item : selection)
       {
-        vtkSortedTableStreamer::PrintInfo(localSubset.GetPointer());
+        ranges[2 * item.ProcessId] = std::min(ranges[2 * item.ProcessId], item.Index);
+        ranges[2 * item.ProcessId + 1]++;
       }
+      for (int pid = 0; pid < this->NumProcs; pid++)
+      {
+        if (ranges[2 * pid + 1] == 0)
+        {
+          ranges[2 * pid] = 0;
+        }
+      }
+    }
+    vtkIdType localRange[2] = { 0, 0 };
+    this->MPI->Scatter(ranges.data(), localRange, 2, mergePid);
 
-      ArraySorter sorter;
-      sorter.Update(static_cast<T*>(subsetArray->GetVoidPointer(0)),
-        subsetArray->GetNumberOfTuples(), subsetArray->GetNumberOfComponents(),
-        this->SelectedComponent, HISTOGRAM_SIZE, this->CommonRange, revertOrder);
-
-      // trim it (remove head and tail that don't belong to the result)
-      localSubset.TakeReference(this->NewSubsetTable(
-        localSubset.GetPointer(), &sorter, nbElementsToRemoveFromHead, blockSize));
-
-      // Add extra information such as structured indices, block number...
-      this->DecorateTable(input, localSubset.GetPointer(), mergePid);
+    // ------------------------------------------------------------------------
+    // Build local subset table
+    // ------------------------------------------------------------------------
+    vtkSmartPointer<vtkTable> localSubset;
+    localSubset.TakeReference(
+      this->NewSubsetTable(input, this->LocalSorter, localRange[0], localRange[1]));
 
-      // ShallowCopy it to the output
-      output->ShallowCopy(localSubset.GetPointer());
-    }
-    else
+    // ------------------------------------------------------------------------
+    // Send local subset array to process mergePid
+    // ------------------------------------------------------------------------
+    if (this->Me != mergePid)
     {
+      this->MPI->Send(localSubset.GetPointer(), mergePid, VTK_TABLE_EXCHANGE_TAG);
+
       // Ask other processes to provide metadata for table decoration
       this->DecorateTable(input, nullptr, mergePid);
+      return 1;
     }
 
-    return 1;
-  }
-
-  // --------------------------------------------------------------------------
-  // nbGlobalToSkip is the number of elements that should be skipped at the end
-  // if you exactly want to reach the searchedGlobalIndex.
-  // localOffset is the corresponding local index in the sorted table to the
-  // global index of (searchedGlobalIndex - nbGlobalToSkip)
-  // nbInLocalBar is the local number of elements that are available
-  // in the histogram bar where the searchedGlobalIndex has been found.
-  // nbInLocalBar is used when you want to get an upper bound that
-  // will include the searchedGlobalIndex.
-  void SearchGlobalIndexLocation(vtkIdType searchedGlobalIndex, Histogram* localHistogram,
-    Histogram* globalHistogram, vtkIdType& nbGlobalToSkip, vtkIdType& localOffset,
-    vtkIdType& nbInLocalBar)
-  {
-    // Communication buffer
-    vtkIdType* bufferHistogramValues = new vtkIdType[this->NumProcs * HISTOGRAM_SIZE];
-
-    // Local internal working var
-    vtkIdType histogramBarIdx = -1;
-    double currentRange[2];
-    vtkIdType idx, idxEnd;
-
-    // Setup initial histogram range and values
-    Histogram _globalHistogram;
-    Histogram _localHistogram;
-    localHistogram->CopyTo(_localHistogram);
-    globalHistogram->CopyTo(_globalHistogram);
-
-    // Reset local offsets
-    localOffset = 0;
-    nbGlobalToSkip = searchedGlobalIndex;
-
-    do
+    // ------------------------------------------------------------------------
+    // Merging procedure only on process mergePid
+    // ------------------------------------------------------------------------
+    if (this->NumProcs > 1)
     {
-      nbGlobalToSkip -= _globalHistogram.GetNewRange(nbGlobalToSkip, histogramBarIdx, currentRange);
-
-      localOffset += _localHistogram.GetNumberOfElements(0, histogramBarIdx);
-      nbInLocalBar = _localHistogram.GetNumberOfElements(histogramBarIdx, histogramBarIdx + 1);
-
-      // Based on a narrowed range, build local histogram to get closer to the
-      // real index of the object
-      _localHistogram.SetScalarRange(currentRange);
-      _localHistogram.ClearHistogramValues();
-
-      idxEnd = localOffset + nbInLocalBar;
-      for (idx = localOffset; idx < idxEnd; ++idx)
+      // Add local meta-data
+      vtkSmartPointer<vtkIdTypeArray> processIdArray = vtkSmartPointer<vtkIdTypeArray>::New();
+      processIdArray->SetName("vtkOriginalProcessIds");
+      processIdArray->SetNumberOfComponents(1);
+      processIdArray->Allocate(blockSize);
+      for (vtkIdType idx = 0; idx < localSubset->GetNumberOfRows(); idx++)
       {
-        _localHistogram.AddValue(this->LocalSorter->Array[idx].Value);
+        processIdArray->InsertNextTuple1(mergePid);
       }
+      localSubset->GetRowData()->AddArray(processIdArray);
+    }
 
-      // Exchange local histo with everyone
-      this->MPI->AllGather(_localHistogram.Values, bufferHistogramValues, HISTOGRAM_SIZE);
+    // Rows of each process are appended one process after the other
+    std::vector<vtkIdType> rowOffsets(this->NumProcs, 0);
+    vtkIdType nbRows = localSubset->GetNumberOfRows();
+    vtkSmartPointer<vtkTable> tmp = vtkSmartPointer<vtkTable>::New();
+    for (int i = 0; i < this->NumProcs; i++)
+    {
+      if (i == mergePid)
+        continue;
 
-      // Build global histogram
-      _globalHistogram.SetScalarRange(currentRange);
-      _globalHistogram.ClearHistogramValues();
+      this->MPI->Receive(tmp.GetPointer(), i, VTK_TABLE_EXCHANGE_TAG);
+      this->MergeTable(i, tmp.GetPointer(), localSubset.GetPointer(), blockSize);
+      rowOffsets[i] = nbRows;
+      nbRows += tmp->GetNumberOfRows();
+    }
 
-      idxEnd = this->NumProcs * HISTOGRAM_SIZE;
-      for (idx = 0; idx < idxEnd; ++idx)
-      {
-        _globalHistogram.TotalValues += bufferHistogramValues[idx];
-        _globalHistogram.Values[idx % HISTOGRAM_SIZE] += bufferHistogramValues[idx];
-      }
-    } while (nbGlobalToSkip > 0 && _globalHistogram.CanBeReduced());
+    // Put the rows in the order of the selection, no need to sort them again
+    ArraySorter order;
+    order.FillArray(static_cast<vtkIdType>(selection.size()));
+    for (vtkIdType idx = 0; idx < order.ArraySize; ++idx)
+    {
+      const Sample& item = selection[idx];
+      order.Array[idx].OriginalIndex =
+        rowOffsets[item.ProcessId] + item.Index - ranges[2 * item.ProcessId];
+    }
+    localSubset.TakeReference(
+      this->NewSubsetTable(localSubset.GetPointer(), &order, 0, order.ArraySize));
+
+    // Add extra information such as structured indices, block number...
+    this->DecorateTable(input, localSubset.GetPointer(), mergePid);
+
+    // ShallowCopy it to the output
+    output->ShallowCopy(localSubset.GetPointer());
 
-    delete[] bufferHistogramValues;
+    return 1;
   }
 
   // --------------------------------------------------------------------------
@@ -1093,7 +1381,7 @@ public:
       vtkAbstractArray* srcArray = srcTable->GetColumn(colIdx);
 
       // Manage subset items
-      vtkAbstractArray* subArray = srcArray->NewInstance();
+      vtkAbstractArray* subArray = NewConcreteInstance(srcArray);
       subArray->SetNumberOfComponents(srcArray->GetNumberOfComponents());
       subArray->SetName(srcArray->GetName());
       subArray->Allocate(size * srcArray->GetNumberOfComponents());
@@ -1102,13 +1390,31 @@ public:
         subArray->CopyInformation(sinfo);
       }
 
+      // InsertNextTuple() reads the tuples of implicit arrays as doubles, which
+      // rounds 64-bit integers such as ids above 2^53: copy their values.
+      const int numComponents = srcArray->GetNumberOfComponents();
+      const bool copyValues = srcArray->GetArrayType() == vtkAbstractArray::ImplicitArray &&
+        srcArray->GetDataTypeSize() == 8 && srcArray->GetDataType() != VTK_DOUBLE;
+      auto insertTuple = [&](vtkIdType srcIdx) {
+        if (!copyValues)
+        {
+          return subArray->InsertNextTuple(srcIdx, srcArray);
+        }
+        for (int comp = 0; comp < numComponents; ++comp)
+        {
+          subArray->InsertVariantValue(
+            subArray->GetMaxId() + 1, srcArray->GetVariantValue(srcIdx * numComponents + comp));
+        }
+        return subArray->GetNumberOfTuples() - 1;
+      };
+
       vtkIdType max = size + offset;
       if (sorter != nullptr && sorter->Array != nullptr)
       {
         max = (max > sorter->ArraySize) ? sorter->ArraySize : max;
         for (vtkIdType idx = offset; idx < max; ++idx)
         {
-          if (subArray->InsertNextTuple(sorter->Array[idx].OriginalIndex, srcArray) == -1)
+          if (insertTuple(sorter->Array[idx].OriginalIndex) == -1)
           {
             cout << "ERROR NewSubsetTable::InsertNextTuple is not working." << endl;
           }
@@ -1119,7 +1425,7 @@ public:
         max = (max > srcTable->GetNumberOfRows()) ? srcTable->GetNumberOfRows() : max;
         for (vtkIdType idx = offset; idx < max; ++idx)
         {
-          if (subArray->InsertNextTuple(idx, srcArray) == -1)
+          if (insertTuple(idx) == -1)
           {
             cout << "ERROR NewSubsetTable::InsertNextTuple is not working." << endl;
           }
@@ -1144,13 +1450,17 @@ public:
   }
 
   // --------------------------------------------------------------------------
-  void InvalidateCache() override { this->NeedToBuildCache = true; }
+  void InvalidateCache() override
+  {
+    this->NeedToBuildCache = true;
+    this->Sortable = -1;
+  }
 
   // --------------------------------------------------------------------------
   bool IsInvalid(vtkTable* input, vtkDataArray* dataToProcess) override
   {
-    return !dataToProcess || input->GetMTime() != this->InputMTime ||
-      dataToProcess->GetMTime() != this->DataMTime;
+    return !dataToProcess || dataToProcess != this->DataToSort ||
+      input->GetMTime() != this->InputMTime || dataToProcess->GetMTime() != this->DataMTime;
   }
 
   // --------------------------------------------------------------------------
@@ -1356,16 +1666,31 @@ private:
   vtkMTimeType DataMTime;     // Keep the original data MTime
   vtkDataArray* DataToSort;   // DataArray to sort
   ArraySorter* LocalSorter;   // Local ArraySorter based on global range
-  Histogram* GlobalHistogram; // Globaly merged Histogram based on global range
   double CommonRange[2];      // Scalar range used across processes
   int Me;                     // Current process ID
   int NumProcs;               // Number of processes involved
   vtkCommunicator* MPI;       // MPI communicator to send/receive/gather
   int SelectedComponent;      // Component used to sort array
+  int Sortable;               // Cached result of IsSortable(), -1 if unknown
   bool NeedToBuildCache;
+  bool InvertOrder;                         // Order of the cached sort
+  bool FullySorted;                         // Is the whole local array sorted
+  vtkIdType SortedPrefixSize;               // Number of sorted values at the head
+  vtkIdType TotalSize;                      // Number of values across processes
+  std::vector<vtkIdType> LocalSizes;        // Number of values of each process
+  std::vector<Sample> Samples;              // Globally sorted samples
+  std::vector<vtkIdType> SamplesLowerBound; // Min number of values before each sample
+  std::vector<vtkIdType> SamplesUpperBound; // Max number of values before each sample
   bool Debug;
 
   const static int VTK_TABLE_EXCHANGE_TAG = 50;
+  const static int VTK_VALUES_EXCHANGE_TAG = 51;
+  // Number of values sorted first on each process to serve the first blocks
+  // without a full sort.
+  static constexpr vtkIdType TOP_K_SIZE = 8192;
+  // Number of samples across processes used to locate a global index. The
+  // more samples, the less candidate values to exchange for each block.
+  static constexpr vtkIdType MAX_NUMBER_OF_SAMPLES = 1 << 18;
   // HISTOGRAM_SIZE could be computed dynamically based on the type of the
   // array to sort but to make sure that unsigned char won't be distributed
   // correctly we set the histogram size to be their max number of element
@@ -1419,13 +1744,22 @@ vtkSmartPointer<vtkTable> vtkSortedTableStreamer::MergeBlocks(vtkPartitionedData
     return vtkTable::SafeDownCast(ptd->GetPartitionAsDataObject(0));
   }
 
-  auto result = vtkSmartPointer<vtkTable>::New();
-  const vtkIdType allocationSize = ptd->GetNumberOfElements(vtkDataObject::ROW);
+  std::vector<vtkTable*> tables;
+  std::vector<std::string> names;
+  std::unordered_set<std::string> namesSet;
   for (unsigned int cc = 0, max = ptd->GetNumberOfPartitions(); cc < max; ++cc)
   {
     if (auto partition = vtkTable::SafeDownCast(ptd->GetPartitionAsDataObject(cc)))
     {
-      InternalsBase::MergeTable(-1, partition, result.GetPointer(), allocationSize);
+      tables.push_back(partition);
+      for (vtkIdType col = 0, maxCol = partition->GetNumberOfColumns(); col < maxCol; ++col)
+      {
+        const char* name = partition->GetColumnName(col);
+        if (name && namesSet.insert(name).second)
+        {
+          names.emplace_back(name);
+        }
+      }
     }
     else if (auto dobj = ptd->GetPartitionAsDataObject(cc))
     {
@@ -1433,6 +1767,71 @@ vtkSmartPointer<vtkTable> vtkSortedTableStreamer::MergeBlocks(vtkPartitionedData
         "Incompatible data type in the input : " << dobj->GetClassName() << " " << cc);
     }
   }
+
+  // Columns that are data arrays of the same type in all the partitions are
+  // merged by implicit arrays viewing them, so that the values are only copied
+  // for the requested block. Other columns are copied.
+  std::unordered_map<std::string, vtkSmartPointer<vtkDataArray>> views;
+  for (const auto& name : names)
+  {
+    auto reference = vtkDataArray::SafeDownCast(tables[0]->GetColumnByName(name.c_str()));
+    std::vector<vtkDataArray*> pieces;
+    for (auto table : tables)
+    {
+      auto piece = vtkDataArray::SafeDownCast(table->GetColumnByName(name.c_str()));
+      if (!reference || !piece || piece->GetDataType() != reference->GetDataType() ||
+        piece->GetNumberOfComponents() != reference->GetNumberOfComponents())
+      {
+        pieces.clear();
+        break;
+      }
+      pieces.push_back(piece);
+    }
+
+    vtkSmartPointer<vtkDataArray> view;
+    if (!pieces.empty())
+    {
+      switch (reference->GetDataType())
+      {
+        vtkTemplateMacro(
+          view = ::ConcatenateArrays<VTK_TT>(pieces, reference->GetNumberOfComponents()));
+      }
+    }
+    if (view)
+    {
+      view->SetName(name.c_str());
+      view->CopyComponentNames(reference);
+      view->CopyInformation(reference->GetInformation());
+      views[name] = view;
+    }
+  }
+
+  auto copies = vtkSmartPointer<vtkTable>::New();
+  if (views.size() < names.size())
+  {
+    const vtkIdType allocationSize = ptd->GetNumberOfElements(vtkDataObject::ROW);
+    for (auto table : tables)
+    {
+      vtkNew<vtkTable> remainder;
+      for (vtkIdType col = 0, maxCol = table->GetNumberOfColumns(); col < maxCol; ++col)
+      {
+        const char* name = table->GetColumnName(col);
+        if (name && views.find(name) == views.end())
+        {
+          remainder->AddColumn(table->GetColumn(col));
+        }
+      }
+      InternalsBase::MergeTable(-1, remainder, copies.GetPointer(), allocationSize);
+    }
+  }
+
+  auto result = vtkSmartPointer<vtkTable>::New();
+  for (const auto& name : names)
+  {
+    auto view = views.find(name);
+    result->AddColumn(
+      view != views.end() ? view->second.GetPointer() : copies->GetColumnByName(name.c_str()));
+  }
   return result;
 }
 
@@ -1456,11 +1855,13 @@ void vtkSortedTableStreamer::PopulateFieldDataArrays(
 }
 
 //----------------------------------------------------------------------------
-vtkSmartPointer<vtkUnsignedIntArray> vtkSortedTableStreamer::GenerateCompositeIndexArray(
+vtkSmartPointer<vtkDataArray> vtkSortedTableStreamer::GenerateCompositeIndexArray(
   vtkPartitionedDataSet* ptd, vtkIdType maxSize)
 {
-  vtkNew<vtkUnsignedIntArray> compositeIndex;
-  compositeIndex->SetName("vtkCompositeIndexArray");
+  // The index is the same for all the rows of a partition: repeat it rather
+  // than storing it for each row.
+  std::shared_ptr<vtkConcatenatedImplicitBackend<unsigned int>> compositeIndex;
+  int numberOfComponents = 1;
 
   for (unsigned int cc = 0, max = ptd->GetNumberOfPartitions(); cc < max; ++cc)
   {
@@ -1474,33 +1875,38 @@ vtkSmartPointer<vtkUnsignedIntArray> vtkSortedTableStreamer::GenerateCompositeIn
     const bool is_amr_info = metadata->Has(vtkDataTabulator::HIERARCHICAL_LEVEL()) &&
       metadata->Has(vtkDataTabulator::HIERARCHICAL_INDEX());
     const int num_components = is_amr_info ? 2 : 1;
-    if (compositeIndex->GetNumberOfTuples() == 0)
+    if (!compositeIndex)
     {
-      compositeIndex->SetNumberOfComponents(num_components);
-      compositeIndex->Allocate(num_components * maxSize);
+      numberOfComponents = num_components;
+      compositeIndex =
+        std::make_shared<vtkConcatenatedImplicitBackend<unsigned int>>(numberOfComponents);
     }
-    assert(num_components == compositeIndex->GetNumberOfComponents());
+    assert(num_components == numberOfComponents);
 
     if (is_amr_info)
     {
       const unsigned int tuple[2] = { static_cast<unsigned int>(
                                         metadata->Get(vtkDataTabulator::HIERARCHICAL_LEVEL())),
         static_cast<unsigned int>(metadata->Get(vtkDataTabulator::HIERARCHICAL_INDEX())) };
-      for (vtkIdType rows = 0, maxRows = table->GetNumberOfRows(); rows < maxRows; ++rows)
-      {
-        compositeIndex->InsertNextTypedTuple(tuple);
-      }
+      compositeIndex->AppendTuple(tuple, table->GetNumberOfRows());
     }
     else if (metadata->Has(vtkDataTabulator::COMPOSITE_INDEX()))
     {
       const unsigned int composite_index = metadata->Get(vtkDataTabulator::COMPOSITE_INDEX());
-      for (vtkIdType rows = 0, maxRows = table->GetNumberOfRows(); rows < maxRows; ++rows)
-      {
-        compositeIndex->InsertNextTypedTuple(&composite_index);
-      }
+      compositeIndex->AppendTuple(&composite_index, table->GetNumberOfRows());
     }
   }
-  return compositeIndex;
+
+  if (!compositeIndex)
+  {
+    compositeIndex = std::make_shared<vtkConcatenatedImplicitBackend<unsigned int>>();
+  }
+  assert(compositeIndex->GetNumberOfTuples() <= maxSize);
+  (void)maxSize;
+
+  auto array = ::NewConcatenatedArray(compositeIndex, numberOfComponents);
+  array->SetName("vtkCompositeIndexArray");
+  return array;
 }
 
 //----------------------------------------------------------------------------
@@ -1571,7 +1977,7 @@ vtkSmartPointer<vtkStringArray> vtkSortedTableStreamer::GenerateBlockNameArray(
 }
 
 //----------------------------------------------------------------------------
-vtkSmartPointer<vtkIdTypeArray> vtkSortedTableStreamer::GenerateBlockIndicesArray(
+vtkSmartPointer<vtkDataArray> vtkSortedTableStreamer::GenerateBlockIndicesArray(
   vtkPartitionedDataSet* ptd, vtkStringArray* blockNames, vtkIdType maxSize)
 {
   // now create a map of block names to indices.
@@ -1583,9 +1989,9 @@ vtkSmartPointer<vtkIdTypeArray> vtkSortedTableStreamer::GenerateBlockIndicesArra
     nameMap[name] = counter++;
   }
 
-  auto blockIndices = vtkSmartPointer<vtkIdTypeArray>::New();
-  blockIndices->Allocate(maxSize);
-  blockIndices->SetName("vtkBlockNameIndices");
+  // The index is the same for all the rows of a partition: repeat it rather
+  // than storing it for each row.
+  auto blockIndices = std::make_shared<vtkConcatenatedImplicitBackend<vtkIdType>>();
   for (unsigned int cc = 0, max = ptd->GetNumberOfPartitions(); cc < max; ++cc)
   {
     std::string name("invalid");
@@ -1597,26 +2003,22 @@ vtkSmartPointer<vtkIdTypeArray> vtkSortedTableStreamer::GenerateBlockIndicesArra
 
     if (auto partition = vtkTable::SafeDownCast(ptd->GetPartitionAsDataObject(cc)))
     {
-      const auto count = partition->GetNumberOfRows();
-      for (vtkIdType jj = 0; jj < count; ++jj)
-      {
-        blockIndices->InsertNextValue(index);
-      }
+      blockIndices->AppendTuple(&index, partition->GetNumberOfRows());
     }
   }
 
   assert(blockIndices->GetNumberOfTuples() == maxSize);
+  (void)maxSize;
 
-  return blockIndices;
+  auto array = ::NewConcatenatedArray(blockIndices, 1);
+  array->SetName("vtkBlockNameIndices");
+  return array;
 }
 
 //----------------------------------------------------------------------------
-int vtkSortedTableStreamer::RequestData(vtkInformation* vtkNotUsed(request),
-  vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+vtkSmartPointer<vtkTable> vtkSortedTableStreamer::PrepareInput(vtkPartitionedDataSet* inputPTD)
 {
   // Manage multiblock dataset by merging data into a single vtkTable
-  auto inputPTD = vtkPartitionedDataSet::GetData(inputVector[0], 0);
-
   vtkSmartPointer<vtkTable> input = this->MergeBlocks(inputPTD);
   if (this->ShowFieldData)
   {
@@ -1659,6 +2061,32 @@ int vtkSortedTableStreamer::RequestData(vtkInformation* vtkNotUsed(request),
       input->GetRowData()->AddArray(blockIndicesArray);
     }
   }
+  return input;
+}
+
+//----------------------------------------------------------------------------
+int vtkSortedTableStreamer::RequestData(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  auto inputPTD = vtkPartitionedDataSet::GetData(inputVector[0], 0);
+
+  // Only prepare the input table again when the input changed, so that
+  // requesting another block reuses it as well as the cached sort.
+  int needToPrepare = !this->PreparedInput || inputPTD->GetMTime() != this->PreparedInputMTime ||
+    this->ShowFieldData != this->PreparedShowFieldData;
+  if (this->Controller && this->Controller->GetNumberOfProcesses() > 1)
+  {
+    int globalNeedToPrepare;
+    this->Controller->AllReduce(&needToPrepare, &globalNeedToPrepare, 1, vtkCommunicator::MAX_OP);
+    needToPrepare = globalNeedToPrepare;
+  }
+  if (needToPrepare)
+  {
+    this->PreparedInput = this->PrepareInput(inputPTD);
+    this->PreparedInputMTime = inputPTD->GetMTime();
+    this->PreparedShowFieldData = this->ShowFieldData;
+  }
+  vtkTable* input = this->PreparedInput;
 
   // Get input data
   vtkInformation* outInfo = outputVector->GetInformationObject(0);
@@ -9,6 +9,17 @@
  * This filter is used quickly get a sorted subset of a given vtkTable.
  * By sorted we mean a subset build from a global sort even if some optimisation
  * allow us to skip a global table sorting.
+ *
+ * The sorted order is cached until the input, the column to sort, the selected
+ * component or the order change, so that requesting another block only
+ * exchanges the values around that block. The first blocks are served from the
+ * top values of each process, without waiting for a full sort. Further blocks
+ * use a full local sort and global samples of the sorted values, gathered once,
+ * to locate the block on each process without any search across processes.
+ *
+ * The partitions of the input are merged, and the composite indices added, as
+ * implicit arrays viewing the input arrays: values are only copied for the
+ * rows of the requested block, which are delivered as regular arrays.
  */
 
 #ifndef vtkSortedTableStreamer_h
@@ -20,12 +31,10 @@
 #include <utility> // for std::pair
 
 class vtkDataArray;
-class vtkIdTypeArray;
 class vtkMultiProcessController;
 class vtkPartitionedDataSet;
 class vtkStringArray;
 class vtkTable;
-class vtkUnsignedIntArray;
 
 class VTKPVVTKEXTENSIONSFILTERSRENDERING_EXPORT vtkSortedTableStreamer : public vtkTableAlgorithm
 {
@@ -139,15 +148,24 @@ private:
 
   vtkSmartPointer<vtkTable> MergeBlocks(vtkPartitionedDataSet* cd);
 
+  /**
+   * Merge the partitions into a single table with the composite metadata.
+   */
+  vtkSmartPointer<vtkTable> PrepareInput(vtkPartitionedDataSet* ptd);
+
+  vtkSmartPointer<vtkTable> PreparedInput;
+  vtkMTimeType PreparedInputMTime = 0;
+  bool PreparedShowFieldData = false;
+
   /**
    * Add field data columns defined by block to the output table.
    */
   void PopulateFieldDataArrays(vtkPartitionedDataSet* ptd, vtkSmartPointer<vtkTable> outTable);
 
-  vtkSmartPointer<vtkUnsignedIntArray> GenerateCompositeIndexArray(
+  vtkSmartPointer<vtkDataArray> GenerateCompositeIndexArray(
     vtkPartitionedDataSet* cd, vtkIdType maxSize);
   vtkSmartPointer<vtkStringArray> GenerateBlockNameArray(vtkPartitionedDataSet* cd);
-  vtkSmartPointer<vtkIdTypeArray> GenerateBlockIndicesArray(
+  vtkSmartPointer<vtkDataArray> GenerateBlockIndicesArray(
     vtkPartitionedDataSet* cd, vtkStringArray* blockNames, vtkIdType maxSize);
 };
 
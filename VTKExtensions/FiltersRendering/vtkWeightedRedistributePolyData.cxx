@@ -4,13 +4,205 @@
 #include "vtkWeightedRedistributePolyData.h"
 
 #include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
 #include "vtkMath.h"
 #include "vtkMultiProcessController.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVCompositeDataPipeline.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
 #include "vtkPolyData.h"
 
+#include <algorithm>
+#include <array>
+#include <map>
+#include <numeric>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 #define NUM_CELL_TYPES 4
 
+namespace
+{
+using vtkTypeCosts = std::array<double, NUM_CELL_TYPES>;
+using vtkTypeCounts = std::array<vtkIdType, NUM_CELL_TYPES>;
+
+//-------------------------------------------------------------------
+// bytes of attributes carried by each tuple of `data`.
+double vtkTupleBytes(vtkDataSetAttributes* data)
+{
+  double bytes = 0.;
+  for (int i = 0; i < data->GetNumberOfArrays(); ++i)
+  {
+    if (vtkDataArray* array = data->GetArray(i))
+    {
+      bytes += array->GetNumberOfComponents() * array->GetDataTypeSize();
+    }
+  }
+  return bytes;
+}
+
+//-------------------------------------------------------------------
+// cost of each cell of `input`, by type, either read from `userCosts` or
+// estimated from the number of primitives and bytes of attributes.
+void vtkComputeCellCosts(vtkPolyData* input, vtkDataArray* userCosts, double costPerPrimitive,
+  double costPerByte, std::vector<double> costs[NUM_CELL_TYPES])
+{
+  vtkCellArray* cellArrays[NUM_CELL_TYPES] = { input->GetVerts(), input->GetLines(),
+    input->GetPolys(), input->GetStrips() };
+
+  double pointBytes = vtkTupleBytes(input->GetPointData());
+  if (input->GetPoints())
+  {
+    pointBytes += 3 * input->GetPoints()->GetData()->GetDataTypeSize();
+  }
+  const double cellBytes = vtkTupleBytes(input->GetCellData());
+
+  // ... cell data is ordered verts, lines, polys then strips ...
+  vtkIdType cellId = 0;
+  for (int type = 0; type < NUM_CELL_TYPES; type++)
+  {
+    costs[type].clear();
+    if (!cellArrays[type])
+    {
+      continue;
+    }
+    const vtkIdType numCells = cellArrays[type]->GetNumberOfCells();
+    costs[type].resize(numCells);
+    for (vtkIdType i = 0; i < numCells; ++i, ++cellId)
+    {
+      if (userCosts)
+      {
+        costs[type][i] = std::max(0., userCosts->GetComponent(cellId, 0));
+        continue;
+      }
+      const vtkIdType npts = cellArrays[type]->GetCellSize(i);
+      // ... vertices, line segments, then triangles for polys and strips ...
+      const vtkIdType primitives = std::max<vtkIdType>(npts - std::min(type, 2), 1);
+      costs[type][i] =
+        costPerPrimitive * primitives + costPerByte * (cellBytes + npts * pointBytes);
+    }
+  }
+}
+}
+
+//-------------------------------------------------------------------
+class vtkWeightedRedistributePolyData::vtkInternals
+{
+public:
+  // cost given by each owner to each of its receivers, by type.
+  using Flows = std::vector<std::map<int, vtkTypeCosts>>;
+
+  // (owner, receiver) pairs of the previous cost schedule, by type. Only
+  // used on processor 0.
+  std::set<std::pair<int, int>> Partners[NUM_CELL_TYPES];
+
+  // processor each local input cell was sent to by the previous execution,
+  // keyed on its global id, when cell owners are tracked.
+  std::unordered_map<vtkIdType, int> Owners;
+  int OwnersNumberOfProcesses = 0;
+
+  /**
+   * Match processors owning more than their goal with processors owning
+   * less. `costs` holds the NUM_CELL_TYPES costs owned by each processor and
+   * `weights` the normalized weight of each processor.
+   */
+  void Match(const std::vector<double>& costs, const std::vector<double>& weights,
+    bool lazy, double tolerance, Flows& flows)
+  {
+    const int numProcs = static_cast<int>(weights.size());
+    flows.assign(numProcs, std::map<int, vtkTypeCosts>());
+
+    std::vector<double> goals(costs.size());
+    std::vector<double> load(numProcs, 0.);
+    std::vector<double> goal(numProcs, 0.);
+    for (int type = 0; type < NUM_CELL_TYPES; type++)
+    {
+      double total = 0.;
+      for (int id = 0; id < numProcs; id++)
+      {
+        total += costs[id * NUM_CELL_TYPES + type];
+      }
+      for (int id = 0; id < numProcs; id++)
+      {
+        goals[id * NUM_CELL_TYPES + type] = total * weights[id];
+        load[id] += costs[id * NUM_CELL_TYPES + type];
+        goal[id] += goals[id * NUM_CELL_TYPES + type];
+      }
+    }
+
+    if (lazy)
+    {
+      bool balanced = true;
+      for (int id = 0; id < numProcs && balanced; id++)
+      {
+        balanced = load[id] <= goal[id] * (1. + tolerance);
+      }
+      if (balanced)
+      {
+        // ... nothing moves, keep the partners for the next execution ...
+        return;
+      }
+    }
+
+    for (int type = 0; type < NUM_CELL_TYPES; type++)
+    {
+      std::vector<double> excess(numProcs);
+      std::vector<int> senders;
+      for (int id = 0; id < numProcs; id++)
+      {
+        const int index = id * NUM_CELL_TYPES + type;
+        excess[id] = costs[index] - goals[index];
+        if (excess[id] > (lazy ? tolerance * goals[index] : 0.))
+        {
+          senders.push_back(id);
+        }
+      }
+      std::stable_sort(senders.begin(), senders.end(),
+        [&excess](int a, int b) { return excess[a] > excess[b]; });
+
+      std::set<std::pair<int, int>> partners;
+      for (int sender : senders)
+      {
+        double amount = excess[sender];
+        while (amount > 0.)
+        {
+          // ... prefer previous partners, then the largest deficit ...
+          int receiver = -1;
+          bool previous = false;
+          for (int id = 0; id < numProcs; id++)
+          {
+            if (excess[id] >= 0.)
+            {
+              continue;
+            }
+            const bool isPartner = this->Partners[type].count(std::make_pair(sender, id)) > 0;
+            if (receiver < 0 || (isPartner && !previous) ||
+              (isPartner == previous && excess[id] < excess[receiver]))
+            {
+              receiver = id;
+              previous = isPartner;
+            }
+          }
+          if (receiver < 0)
+          {
+            break;
+          }
+          const double moved = std::min(amount, -excess[receiver]);
+          flows[sender][receiver][type] += moved;
+          excess[receiver] += moved;
+          amount -= moved;
+          partners.insert(std::make_pair(sender, receiver));
+        }
+      }
+      this->Partners[type] = std::move(partners);
+    }
+  }
+};
+
 //-------------------------------------------------------------------
 vtkStandardNewMacro(vtkWeightedRedistributePolyData);
 
@@ -19,6 +211,15 @@ vtkStandardNewMacro(vtkWeightedRedistributePolyData);
 vtkWeightedRedistributePolyData::vtkWeightedRedistributePolyData()
 {
   this->Weights = nullptr;
+  this->BalanceMode = CELL_COUNT;
+  this->CostArrayName = nullptr;
+  this->CostPerPrimitive = 1.0;
+  this->CostPerAttributeByte = 0.02;
+  this->UseMeasuredCosts = false;
+  this->TrackCellOwners = false;
+  this->LazyRebalancing = false;
+  this->ImbalanceTolerance = 0.05;
+  this->Internals = new vtkInternals();
 }
 
 //-------------------------------------------------------------------
@@ -26,6 +227,8 @@ vtkWeightedRedistributePolyData::vtkWeightedRedistributePolyData()
 vtkWeightedRedistributePolyData::~vtkWeightedRedistributePolyData()
 {
   delete[] Weights;
+  this->SetCostArrayName(nullptr);
+  delete this->Internals;
 }
 
 //-------------------------------------------------------------------
@@ -33,6 +236,15 @@ vtkWeightedRedistributePolyData::~vtkWeightedRedistributePolyData()
 void vtkWeightedRedistributePolyData::PrintSelf(ostream& os, vtkIndent indent)
 {
   vtkRedistributePolyData::PrintSelf(os, indent);
+  os << indent << "BalanceMode: " << this->BalanceMode << endl;
+  os << indent << "CostArrayName: " << (this->CostArrayName ? this->CostArrayName : "(none)")
+     << endl;
+  os << indent << "CostPerPrimitive: " << this->CostPerPrimitive << endl;
+  os << indent << "CostPerAttributeByte: " << this->CostPerAttributeByte << endl;
+  os << indent << "UseMeasuredCosts: " << this->UseMeasuredCosts << endl;
+  os << indent << "TrackCellOwners: " << this->TrackCellOwners << endl;
+  os << indent << "LazyRebalancing: " << this->LazyRebalancing << endl;
+  os << indent << "ImbalanceTolerance: " << this->ImbalanceTolerance << endl;
 }
 
 //*****************************************************************
@@ -77,6 +289,12 @@ void vtkWeightedRedistributePolyData::MakeSchedule(vtkPolyData* input, vtkCommSc
   //
   //*****************************************************************
 
+  if (this->BalanceMode == COST)
+  {
+    this->MakeCostSchedule(input, localSched);
+    return;
+  }
+
   // get total number of polys and figure out how many each processor should have
 
   int type;
@@ -683,3 +901,481 @@ void vtkWeightedRedistributePolyData::MakeSchedule(vtkPolyData* input, vtkCommSc
 
   delete[] remoteSched;
 }
+
+//*****************************************************************
+void vtkWeightedRedistributePolyData::MakeCostSchedule(
+  vtkPolyData* input, vtkCommSched* localSched)
+{
+  //*****************************************************************
+  // purpose: This routine sets up a schedule to shift cells around so
+  //          the cost of the cells owned by each processor is
+  //          proportional to its weight. Processor 0 matches the costs
+  //          of the owners, each processor then picks the cells it sends
+  //          to their new owner.
+  //
+  //*****************************************************************
+
+  if (!this->Controller)
+  {
+    vtkErrorMacro("need controller to balance cells");
+    return;
+  }
+  const int myId = this->Controller->GetLocalProcessId();
+  const int numProcs = this->Controller->GetNumberOfProcesses();
+
+  vtkDataArray* userCosts = nullptr;
+  if (this->CostArrayName && this->CostArrayName[0])
+  {
+    userCosts = input->GetCellData()->GetArray(this->CostArrayName);
+    if (!userCosts)
+    {
+      vtkDebugMacro("cost array '" << this->CostArrayName << "' not found, using cost model");
+    }
+  }
+
+  std::vector<double> costs[NUM_CELL_TYPES];
+  vtkComputeCellCosts(
+    input, userCosts, this->CostPerPrimitive, this->CostPerAttributeByte, costs);
+
+  int type;
+  if (this->UseMeasuredCosts && !userCosts)
+  {
+    // ... scale the model so that the cells of this processor cost the
+    //  time the producer of the input last spent executing here ...
+    vtkAlgorithm* producer =
+      this->GetNumberOfInputConnections(0) > 0 ? this->GetInputAlgorithm() : nullptr;
+    auto executive =
+      producer ? vtkPVCompositeDataPipeline::SafeDownCast(producer->GetExecutive()) : nullptr;
+    const double measured = executive ? executive->GetLastExecutionTime() : 0.;
+    int localMeasured = measured > 0. ? 1 : 0;
+    int allMeasured = 0;
+    this->Controller->AllReduce(&localMeasured, &allMeasured, 1, vtkCommunicator::MIN_OP);
+
+    double modelCost = 0.;
+    for (type = 0; type < NUM_CELL_TYPES; type++)
+    {
+      modelCost = std::accumulate(costs[type].begin(), costs[type].end(), modelCost);
+    }
+    if (allMeasured && modelCost > 0.)
+    {
+      for (type = 0; type < NUM_CELL_TYPES; type++)
+      {
+        for (double& cost : costs[type])
+        {
+          cost *= measured / modelCost;
+        }
+      }
+    }
+    else if (!allMeasured)
+    {
+      vtkDebugMacro("execution time not measured on every processor, using cost model");
+    }
+  }
+
+  // ... find the owner of each cell, and the number and cost of the
+  //  cells of each owner ...
+  vtkDataArray* globalIds = nullptr;
+  if (this->TrackCellOwners)
+  {
+    globalIds = input->GetCellData()->GetGlobalIds();
+    if (!globalIds)
+    {
+      vtkWarningMacro("TrackCellOwners requires cell global ids, cell owners are not tracked.");
+    }
+  }
+  if (!globalIds || this->Internals->OwnersNumberOfProcesses != numProcs)
+  {
+    this->Internals->Owners.clear();
+  }
+  this->Internals->OwnersNumberOfProcesses = numProcs;
+
+  std::vector<int> owners[NUM_CELL_TYPES];
+  std::map<int, std::pair<vtkIdType, vtkTypeCosts>> owned;
+  vtkIdType cellId = 0;
+  for (type = 0; type < NUM_CELL_TYPES; type++)
+  {
+    owners[type].assign(costs[type].size(), myId);
+    for (size_t i = 0; i < costs[type].size(); i++, cellId++)
+    {
+      if (globalIds)
+      {
+        auto iter =
+          this->Internals->Owners.find(static_cast<vtkIdType>(globalIds->GetTuple1(cellId)));
+        if (iter != this->Internals->Owners.end())
+        {
+          owners[type][i] = iter->second;
+        }
+      }
+      auto& entry = owned[owners[type][i]];
+      entry.first++;
+      entry.second[type] += costs[type][i];
+    }
+  }
+
+  // ... processor 0 gathers [owner, number of cells, cost of each type]
+  //  for every owner of the cells of each processor ...
+  std::vector<double> localOwned;
+  for (const auto& entry : owned)
+  {
+    localOwned.push_back(entry.first);
+    localOwned.push_back(static_cast<double>(entry.second.first));
+    localOwned.insert(localOwned.end(), entry.second.second.begin(), entry.second.second.end());
+  }
+  const int ownedSize = 2 + NUM_CELL_TYPES;
+  vtkIdType localLength = static_cast<vtkIdType>(localOwned.size());
+  std::vector<vtkIdType> lengths(numProcs, 0);
+  std::vector<vtkIdType> offsets(numProcs, 0);
+  this->Controller->Gather(&localLength, lengths.data(), 1, 0);
+  for (int id = 1; id < numProcs; id++)
+  {
+    offsets[id] = offsets[id - 1] + lengths[id - 1];
+  }
+  std::vector<double> allOwned(myId == 0 ? offsets[numProcs - 1] + lengths[numProcs - 1] : 0);
+  this->Controller->GatherV(
+    localOwned.data(), allOwned.data(), localLength, lengths.data(), offsets.data(), 0);
+
+  // ... the schedule of each processor is packed as
+  //  [numMoves, (owner, receiver, cost of each type)...,
+  //   numSend, sendTo..., numReceive, receiveFrom...] ...
+  std::vector<double> schedule;
+  if (myId == 0)
+  {
+    std::vector<double> weights(numProcs, 1. / numProcs);
+    if (this->Weights)
+    {
+      double weightSum = 0.;
+      for (int id = 0; id < numProcs; id++)
+      {
+        weightSum += this->Weights[id];
+      }
+      for (int id = 0; id < numProcs; id++)
+      {
+        weights[id] = weightSum > 0 ? this->Weights[id] / weightSum : 0.;
+      }
+    }
+
+    // ... cost held by each processor for each owner, and total cost of
+    //  each owner ...
+    std::vector<std::map<int, vtkTypeCosts>> held(numProcs);
+    std::vector<std::set<int>> destinations(numProcs);
+    std::vector<double> ownerCosts(static_cast<size_t>(NUM_CELL_TYPES) * numProcs, 0.);
+    for (int id = 0; id < numProcs; id++)
+    {
+      for (vtkIdType pos = offsets[id]; pos < offsets[id] + lengths[id]; pos += ownedSize)
+      {
+        const int owner = static_cast<int>(allOwned[pos]);
+        vtkTypeCosts& cost = held[id][owner];
+        for (type = 0; type < NUM_CELL_TYPES; type++)
+        {
+          cost[type] = allOwned[pos + 2 + type];
+          ownerCosts[owner * NUM_CELL_TYPES + type] += cost[type];
+        }
+        if (owner != id && allOwned[pos + 1] > 0)
+        {
+          destinations[id].insert(owner);
+        }
+      }
+    }
+
+    vtkInternals::Flows flows;
+    this->Internals->Match(
+      ownerCosts, weights, this->LazyRebalancing, this->ImbalanceTolerance, flows);
+
+    // ... what an owner gives to a receiver is taken from the processors
+    //  holding its cells, in proportion to the cost they hold ...
+    std::vector<std::map<std::pair<int, int>, vtkTypeCosts>> moves(numProcs);
+    for (int owner = 0; owner < numProcs; owner++)
+    {
+      for (const auto& flow : flows[owner])
+      {
+        for (int id = 0; id < numProcs; id++)
+        {
+          auto iter = held[id].find(owner);
+          if (iter == held[id].end())
+          {
+            continue;
+          }
+          vtkTypeCosts share{};
+          bool moved = false;
+          for (type = 0; type < NUM_CELL_TYPES; type++)
+          {
+            const double ownerCost = ownerCosts[owner * NUM_CELL_TYPES + type];
+            if (flow.second[type] > 0. && ownerCost > 0.)
+            {
+              share[type] = flow.second[type] * iter->second[type] / ownerCost;
+              moved = moved || share[type] > 0.;
+            }
+          }
+          if (moved)
+          {
+            moves[id][std::make_pair(owner, flow.first)] = share;
+            if (flow.first != id)
+            {
+              destinations[id].insert(flow.first);
+            }
+          }
+        }
+      }
+    }
+
+    std::vector<std::vector<int>> sources(numProcs);
+    for (int id = 0; id < numProcs; id++)
+    {
+      for (int destination : destinations[id])
+      {
+        sources[destination].push_back(id);
+      }
+    }
+    for (int id = numProcs - 1; id >= 0; id--)
+    {
+      std::vector<double> packed;
+      packed.push_back(static_cast<double>(moves[id].size()));
+      for (const auto& move : moves[id])
+      {
+        packed.push_back(move.first.first);
+        packed.push_back(move.first.second);
+        packed.insert(packed.end(), move.second.begin(), move.second.end());
+      }
+      packed.push_back(static_cast<double>(destinations[id].size()));
+      packed.insert(packed.end(), destinations[id].begin(), destinations[id].end());
+      packed.push_back(static_cast<double>(sources[id].size()));
+      packed.insert(packed.end(), sources[id].begin(), sources[id].end());
+      if (id == 0)
+      {
+        schedule = std::move(packed);
+        break;
+      }
+      int length = static_cast<int>(packed.size());
+      this->Controller->Send(&length, 1, id, COST_SCHED_LEN_TAG);
+      this->Controller->Send(packed.data(), length, id, COST_SCHED_TAG);
+    }
+  }
+  else
+  {
+    int length = 0;
+    this->Controller->Receive(&length, 1, 0, COST_SCHED_LEN_TAG);
+    schedule.resize(length);
+    this->Controller->Receive(schedule.data(), length, 0, COST_SCHED_TAG);
+  }
+
+  size_t pos = 0;
+  // ... receivers of each owner, with the cost to give them, by type ...
+  std::map<int, std::vector<std::pair<int, vtkTypeCosts>>> moves;
+  const size_t numMoves = static_cast<size_t>(schedule[pos++]);
+  for (size_t i = 0; i < numMoves; i++)
+  {
+    const int owner = static_cast<int>(schedule[pos++]);
+    const int receiver = static_cast<int>(schedule[pos++]);
+    vtkTypeCosts cost;
+    for (type = 0; type < NUM_CELL_TYPES; type++)
+    {
+      cost[type] = schedule[pos++];
+    }
+    moves[owner].emplace_back(receiver, cost);
+  }
+  std::vector<int> sendTo(static_cast<size_t>(schedule[pos++]));
+  for (size_t i = 0; i < sendTo.size(); i++)
+  {
+    sendTo[i] = static_cast<int>(schedule[pos++]);
+  }
+  std::vector<int> receiveFrom(static_cast<size_t>(schedule[pos++]));
+  for (size_t i = 0; i < receiveFrom.size(); i++)
+  {
+    receiveFrom[i] = static_cast<int>(schedule[pos++]);
+  }
+
+  // ... cells go to their owner, except the ones given to receivers. These
+  //  are taken from the end of the cells of their owner, rounding each
+  //  cell to the nearest, and split between receivers in order ...
+  std::vector<int> destinations[NUM_CELL_TYPES];
+  std::copy(owners, owners + NUM_CELL_TYPES, destinations);
+  for (type = 0; type < NUM_CELL_TYPES; type++)
+  {
+    for (const auto& ownerMoves : moves)
+    {
+      const std::vector<double>& cellCosts = costs[type];
+      std::vector<vtkIdType> cells;
+      for (size_t i = 0; i < cellCosts.size(); i++)
+      {
+        if (owners[type][i] == ownerMoves.first)
+        {
+          cells.push_back(static_cast<vtkIdType>(i));
+        }
+      }
+      double total = 0.;
+      int lastReceiver = -1;
+      for (const auto& move : ownerMoves.second)
+      {
+        total += move.second[type];
+        lastReceiver = move.second[type] > 0. ? move.first : lastReceiver;
+      }
+      if (lastReceiver < 0 || cells.empty())
+      {
+        continue;
+      }
+
+      size_t first = cells.size();
+      double tailCost = 0.;
+      while (first > 0 && tailCost + 0.5 * cellCosts[cells[first - 1]] < total)
+      {
+        tailCost += cellCosts[cells[--first]];
+      }
+      size_t next = first;
+      for (const auto& move : ownerMoves.second)
+      {
+        double given = 0.;
+        while (next < cells.size() && given + 0.5 * cellCosts[cells[next]] < move.second[type])
+        {
+          given += cellCosts[cells[next]];
+          destinations[type][cells[next++]] = move.first;
+        }
+      }
+      for (; next < cells.size(); next++)
+      {
+        destinations[type][cells[next]] = lastReceiver;
+      }
+    }
+  }
+
+  // ... list the cells kept and sent to each destination, and record
+  //  where each cell goes for the next execution ...
+  std::vector<vtkIdType> keepCells[NUM_CELL_TYPES];
+  std::map<int, std::array<std::vector<vtkIdType>, NUM_CELL_TYPES>> sendCells;
+  for (int destination : sendTo)
+  {
+    sendCells[destination];
+  }
+  if (globalIds)
+  {
+    this->Internals->Owners.clear();
+  }
+  cellId = 0;
+  for (type = 0; type < NUM_CELL_TYPES; type++)
+  {
+    for (size_t i = 0; i < destinations[type].size(); i++, cellId++)
+    {
+      const int destination = destinations[type][i];
+      if (destination == myId)
+      {
+        keepCells[type].push_back(static_cast<vtkIdType>(i));
+      }
+      else if (sendCells.count(destination))
+      {
+        sendCells[destination][type].push_back(static_cast<vtkIdType>(i));
+      }
+      else
+      {
+        vtkErrorMacro("cell scheduled for processor " << destination << " that expects none.");
+        keepCells[type].push_back(static_cast<vtkIdType>(i));
+        continue;
+      }
+      if (globalIds)
+      {
+        this->Internals->Owners[static_cast<vtkIdType>(globalIds->GetTuple1(cellId))] =
+          destination;
+      }
+    }
+  }
+
+  // ... tell receivers how many cells of each type to expect ...
+  std::vector<vtkTypeCounts> sendNumber(sendTo.size());
+  for (size_t i = 0; i < sendTo.size(); i++)
+  {
+    for (type = 0; type < NUM_CELL_TYPES; type++)
+    {
+      sendNumber[i][type] = static_cast<vtkIdType>(sendCells[sendTo[i]][type].size());
+    }
+    this->Controller->Send(sendNumber[i].data(), NUM_CELL_TYPES, sendTo[i], COST_NUM_CELLS_TAG);
+  }
+  vtkTypeCounts numCells{};
+  for (type = 0; type < NUM_CELL_TYPES; type++)
+  {
+    numCells[type] = static_cast<vtkIdType>(keepCells[type].size());
+  }
+  std::vector<vtkTypeCounts> receiveNumber(receiveFrom.size());
+  for (size_t i = 0; i < receiveFrom.size(); i++)
+  {
+    this->Controller->Receive(
+      receiveNumber[i].data(), NUM_CELL_TYPES, receiveFrom[i], COST_NUM_CELLS_TAG);
+    for (type = 0; type < NUM_CELL_TYPES; type++)
+    {
+      numCells[type] += receiveNumber[i][type];
+    }
+  }
+
+  // ... drop exchanges where rounding left no cell to ship, both sides
+  //  know the counts so they drop the same ones ...
+  auto isEmpty = [](const vtkTypeCounts& counts)
+  { return std::all_of(counts.begin(), counts.end(), [](vtkIdType n) { return n == 0; }); };
+  std::vector<size_t> sends;
+  std::vector<size_t> receives;
+  for (size_t i = 0; i < sendTo.size(); i++)
+  {
+    if (!isEmpty(sendNumber[i]))
+    {
+      sends.push_back(i);
+    }
+  }
+  for (size_t i = 0; i < receiveFrom.size(); i++)
+  {
+    if (!isEmpty(receiveNumber[i]))
+    {
+      receives.push_back(i);
+    }
+  }
+
+  // ... destinations and sources are in increasing order, as
+  //  OrderSchedule() expects ...
+  localSched->NumberOfCells = new vtkIdType[NUM_CELL_TYPES];
+  std::copy(numCells.begin(), numCells.end(), localSched->NumberOfCells);
+  localSched->KeepCellList = new vtkIdType*[NUM_CELL_TYPES];
+  for (type = 0; type < NUM_CELL_TYPES; type++)
+  {
+    localSched->KeepCellList[type] = new vtkIdType[keepCells[type].size()];
+    std::copy(keepCells[type].begin(), keepCells[type].end(), localSched->KeepCellList[type]);
+  }
+  localSched->SendCount = static_cast<int>(sends.size());
+  localSched->ReceiveCount = static_cast<int>(receives.size());
+  if (localSched->SendCount > 0)
+  {
+    localSched->SendTo = new int[localSched->SendCount];
+    localSched->SendNumber = new vtkIdType*[NUM_CELL_TYPES];
+    localSched->SendCellList = new vtkIdType**[localSched->SendCount];
+    for (type = 0; type < NUM_CELL_TYPES; type++)
+    {
+      localSched->SendNumber[type] = new vtkIdType[localSched->SendCount];
+    }
+    for (int i = 0; i < localSched->SendCount; i++)
+    {
+      const int destination = sendTo[sends[i]];
+      localSched->SendTo[i] = destination;
+      localSched->SendCellList[i] = new vtkIdType*[NUM_CELL_TYPES];
+      for (type = 0; type < NUM_CELL_TYPES; type++)
+      {
+        const std::vector<vtkIdType>& cells = sendCells[destination][type];
+        localSched->SendNumber[type][i] = static_cast<vtkIdType>(cells.size());
+        localSched->SendCellList[i][type] = new vtkIdType[cells.size()];
+        std::copy(cells.begin(), cells.end(), localSched->SendCellList[i][type]);
+      }
+    }
+  }
+  if (localSched->ReceiveCount > 0)
+  {
+    localSched->ReceiveFrom = new int[localSched->ReceiveCount];
+    localSched->ReceiveNumber = new vtkIdType*[NUM_CELL_TYPES];
+    for (type = 0; type < NUM_CELL_TYPES; type++)
+    {
+      localSched->ReceiveNumber[type] = new vtkIdType[localSched->ReceiveCount];
+    }
+    for (int i = 0; i < localSched->ReceiveCount; i++)
+    {
+      localSched->ReceiveFrom[i] = receiveFrom[receives[i]];
+      for (type = 0; type < NUM_CELL_TYPES; type++)
+      {
+        localSched->ReceiveNumber[type][i] = receiveNumber[receives[i]][type];
+      }
+    }
+  }
+  vtkDebugMacro("cost schedule: sending to " << localSched->SendCount << " and receiving from "
+                                            << localSched->ReceiveCount << " processors");
+}
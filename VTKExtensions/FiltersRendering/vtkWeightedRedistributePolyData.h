@@ -4,6 +4,24 @@
 /**
  * @class   vtkWeightedRedistributePolyData
  * @brief   do weighted balance of cells on processors
+ *
+ * By default the cells of each type are divided up between the processors
+ * in proportion to the weights set with SetWeights(). When BalanceMode is
+ * COST, each cell is instead weighted by its estimated render and filter
+ * cost: a per-primitive cost plus the bytes of point and cell attributes
+ * it carries, or a cost supplied by the user in the cell data array named
+ * by CostArrayName. With UseMeasuredCosts on, the estimate is scaled on each
+ * processor to the time the producer of the input last spent executing there.
+ *
+ * In COST mode, cells are balanced by owner. A cell is owned by the
+ * processor holding it unless TrackCellOwners is on, in which case it is
+ * owned by the processor it was sent to by the previous execution, found
+ * from the cell global ids. Only the cost an owner holds above its goal is
+ * given to other processors, so between two executions (e.g. time steps)
+ * only the cells whose owner must change are reassigned. With
+ * LazyRebalancing on, owners give cells away only when they exceed their
+ * goal by more than ImbalanceTolerance, preferably to the processors they
+ * gave cells to the previous time.
  */
 
 #ifndef vtkWeightedRedistributePolyData_h
@@ -30,6 +48,91 @@ public:
 
   void SetWeights(int, int, float);
 
+  enum BalanceModes
+  {
+    CELL_COUNT = 0,
+    COST = 1
+  };
+
+  ///@{
+  /**
+   * Set/Get whether cells are balanced by count (CELL_COUNT) or by their
+   * estimated cost (COST). Default is CELL_COUNT.
+   */
+  vtkSetClampMacro(BalanceMode, int, CELL_COUNT, COST);
+  vtkGetMacro(BalanceMode, int);
+  void SetBalanceModeToCellCount() { this->SetBalanceMode(CELL_COUNT); }
+  void SetBalanceModeToCost() { this->SetBalanceMode(COST); }
+  ///@}
+
+  ///@{
+  /**
+   * Name of a cell data array holding a user-supplied cost for each cell,
+   * e.g. timings collected by the simulation or by a previous analysis. When
+   * set and present, its first component replaces the cost model, which is
+   * used otherwise. Only used in COST mode.
+   */
+  vtkSetStringMacro(CostArrayName);
+  vtkGetStringMacro(CostArrayName);
+  ///@}
+
+  ///@{
+  /**
+   * Cost model used in COST mode when no cost array is available. The
+   * cost of a cell is CostPerPrimitive times its number of primitives
+   * (vertices, line segments or triangles) plus CostPerAttributeByte times
+   * the bytes of cell data and of point data for each of its points.
+   * Defaults are 1 and 0.02.
+   */
+  vtkSetClampMacro(CostPerPrimitive, double, 0.0, VTK_DOUBLE_MAX);
+  vtkGetMacro(CostPerPrimitive, double);
+  vtkSetClampMacro(CostPerAttributeByte, double, 0.0, VTK_DOUBLE_MAX);
+  vtkGetMacro(CostPerAttributeByte, double);
+  ///@}
+
+  ///@{
+  /**
+   * When on, the cost model is scaled on each processor so that its cells
+   * cost, together, the wall time the producer of the input spent in its
+   * last execution on that processor, as recorded by
+   * vtkPVCompositeDataPipeline. Cells produced by slow processors are then
+   * heavier than cells of fast ones. The model is used as is unless every
+   * processor has a measured time, and costs read from CostArrayName are
+   * never scaled. Only used in COST mode. Default is off.
+   */
+  vtkSetMacro(UseMeasuredCosts, bool);
+  vtkGetMacro(UseMeasuredCosts, bool);
+  vtkBooleanMacro(UseMeasuredCosts, bool);
+  ///@}
+
+  ///@{
+  /**
+   * When on, COST mode records the processor each cell is sent to, keyed on
+   * the cell global ids, and the next execution sends each cell back to that
+   * processor unless balancing the costs requires a new owner. Cells without
+   * a recorded owner are owned by the processor holding them. Requires cell
+   * global ids. Default is off.
+   */
+  vtkSetMacro(TrackCellOwners, bool);
+  vtkGetMacro(TrackCellOwners, bool);
+  vtkBooleanMacro(TrackCellOwners, bool);
+  ///@}
+
+  ///@{
+  /**
+   * When on, COST mode only moves cells if a processor owns more than its
+   * goal by more than ImbalanceTolerance (a fraction of the goal). Only
+   * those processors then give cells away, down to their goal, preferably
+   * to the processors they gave cells to in the previous schedule. Default
+   * is off.
+   */
+  vtkSetMacro(LazyRebalancing, bool);
+  vtkGetMacro(LazyRebalancing, bool);
+  vtkBooleanMacro(LazyRebalancing, bool);
+  vtkSetClampMacro(ImbalanceTolerance, double, 0.0, VTK_DOUBLE_MAX);
+  vtkGetMacro(ImbalanceTolerance, double);
+  ///@}
+
 protected:
   vtkWeightedRedistributePolyData();
   ~vtkWeightedRedistributePolyData() override;
@@ -41,15 +144,36 @@ protected:
     SCHED_LEN_1_TAG = 300,
     SCHED_LEN_2_TAG = 301,
     SCHED_1_TAG = 310,
-    SCHED_2_TAG = 311
+    SCHED_2_TAG = 311,
+
+    COST_SCHED_LEN_TAG = 320,
+    COST_SCHED_TAG = 321,
+    COST_NUM_CELLS_TAG = 322
   };
 
   void MakeSchedule(vtkPolyData* input, vtkCommSched*) override;
+
+  /**
+   * Build the schedule when BalanceMode is COST.
+   */
+  virtual void MakeCostSchedule(vtkPolyData* input, vtkCommSched*);
+
   float* Weights;
+  int BalanceMode;
+  char* CostArrayName;
+  double CostPerPrimitive;
+  double CostPerAttributeByte;
+  bool UseMeasuredCosts;
+  bool TrackCellOwners;
+  bool LazyRebalancing;
+  double ImbalanceTolerance;
 
 private:
   vtkWeightedRedistributePolyData(const vtkWeightedRedistributePolyData&) = delete;
   void operator=(const vtkWeightedRedistributePolyData&) = delete;
+
+  class vtkInternals;
+  vtkInternals* Internals;
 };
 
 //****************************************************************
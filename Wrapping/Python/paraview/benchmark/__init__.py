@@ -11,6 +11,12 @@ of spheres and moves the camera around the scene.  To run the benchmark,
 either explicitly import manyspheres from paraview.benchmark and call it's
 run method, or call the manyspheres.py module directly via pvbatch or pvpython.
 
+suite is a benchmark harness running parameterized scenarios on synthetic
+data (reading, filtering, data delivery, rendering, state loading and
+client-server round trips). It writes the results as JSON and can compare
+them against a baseline to flag regressions, e.g.
+`pvpython -m paraview.benchmark.suite -o results.json -b baseline.json`.
+
 ::
 
     TODO: this doesn't handle split render/data server mode
@@ -0,0 +1,540 @@
+'''
+A benchmark suite producing repeatable, machine-readable results.
+
+Each scenario builds its pipeline from deterministic synthetic data, so no
+external files are needed, and is run for a number of warm-up iterations
+followed by timed iterations. Only the timed part of an iteration is measured;
+changes needed to force re-execution, e.g. modifying a property, are done
+beforehand.
+
+For each scenario, the results record the timing statistics (median, mean,
+standard deviation and percentiles), the throughput and the memory high-water
+mark, i.e. the largest peak resident memory of the client and server processes
+during the timed iterations. Results are written as JSON and can be compared
+against a stored baseline to flag regressions.
+
+Peaks are reset before the timed iterations on Linux only. Elsewhere, they
+cover the lifetime of the processes, so that memory used by earlier scenarios
+is included; the ``memory_peak_scope`` field of the results tells which one was
+measured.
+
+To run all scenarios and save the results::
+
+    pvpython -m paraview.benchmark.suite -o results.json
+
+To compare a run against a baseline (the exit code is non-zero when a
+regression is found), or two result files without running anything::
+
+    pvpython -m paraview.benchmark.suite -b baseline.json
+    pvpython -m paraview.benchmark.suite --compare results.json baseline.json
+
+Scenarios take parameters that can be overridden from the command line e.g.
+``-p dimension=200``. Use ``--list`` to see the scenarios and their
+parameters. New scenarios are added by subclassing `Scenario` and decorating
+the class with `register`.
+'''
+
+from __future__ import absolute_import, print_function
+
+import collections
+import json
+import math
+import os
+import platform
+import shutil
+import sys
+import tempfile
+import time
+
+# version of the results format.
+FORMAT_VERSION = 3
+
+_scenarios = collections.OrderedDict()
+
+
+def register(cls):
+    '''Class decorator adding a `Scenario` subclass to the suite.'''
+    _scenarios[cls.name] = cls
+    return cls
+
+
+def get_scenarios():
+    '''Returns an ordered dictionary of the registered scenario classes, by
+    name.'''
+    return collections.OrderedDict(_scenarios)
+
+
+class Scenario(object):
+    '''Base class for benchmark scenarios.
+
+    `setup` builds the pipeline, `prepare` is called before each iteration
+    and is not timed, `iteration` is the timed part and `teardown` releases
+    everything that was created. `work` returns the number of items, in
+    `unit`, processed by one iteration and is used to report throughput.
+    '''
+    name = None
+    description = ''
+    parameters = {}
+    unit = 'iterations'
+
+    def __init__(self, **parameters):
+        self.params = dict(self.parameters)
+        self.params.update(parameters)
+
+    def setup(self):
+        pass
+
+    def prepare(self, index):
+        pass
+
+    def iteration(self, index):
+        raise NotImplementedError
+
+    def teardown(self):
+        from paraview import simple
+        simple.ResetSession()
+
+    def work(self):
+        return 1
+
+
+def _wavelet(dimension):
+    from paraview import simple
+    d2 = dimension // 2
+    return simple.Wavelet(WholeExtent=[-d2, d2, -d2, d2, -d2, d2], Maximum=255.0)
+
+
+def _isosurfaces(count, index):
+    # values alternate between two nearby sets so that each iteration
+    # re-executes the filter with the same amount of work.
+    shift = 1e-3 * (index % 2)
+    return [40.0 + 200.0 * (i + 0.5) / count + shift for i in range(count)]
+
+
+@register
+class ReaderScenario(Scenario):
+    name = 'reader'
+    description = 'read an XML image data file written from a wavelet'
+    parameters = {'dimension': 100}
+    unit = 'cells'
+
+    def setup(self):
+        from paraview import simple
+        # the file is written by the data server, which is expected to share
+        # the temporary directory with the client in client-server mode.
+        self.directory = tempfile.mkdtemp(prefix='pvbenchmark')
+        self.filename = os.path.join(self.directory, 'wavelet.pvti')
+        wavelet = _wavelet(self.params['dimension'])
+        simple.SaveData(self.filename, proxy=wavelet)
+        self.cells = wavelet.GetDataInformation().GetNumberOfCells()
+        simple.Delete(wavelet)
+
+    def iteration(self, index):
+        from paraview import simple
+        reader = simple.OpenDataFile(self.filename)
+        reader.UpdatePipeline()
+        simple.Delete(reader)
+
+    def teardown(self):
+        Scenario.teardown(self)
+        shutil.rmtree(self.directory, ignore_errors=True)
+
+    def work(self):
+        return self.cells
+
+
+@register
+class FilterScenario(Scenario):
+    name = 'contour'
+    description = 'contour a wavelet'
+    parameters = {'dimension': 100, 'isosurfaces': 10}
+    unit = 'cells'
+
+    def setup(self):
+        from paraview import simple
+        self.wavelet = _wavelet(self.params['dimension'])
+        self.wavelet.UpdatePipeline()
+        self.contour = simple.Contour(Input=self.wavelet, ContourBy=['POINTS', 'RTData'])
+
+    def prepare(self, index):
+        self.contour.Isosurfaces = _isosurfaces(self.params['isosurfaces'], index)
+
+    def iteration(self, index):
+        self.contour.UpdatePipeline()
+
+    def work(self):
+        return self.wavelet.GetDataInformation().GetNumberOfCells()
+
+
+@register
+class DeliveryScenario(Scenario):
+    name = 'delivery'
+    description = 'update a render view showing a contour, delivering the geometry for rendering'
+    parameters = {'dimension': 100, 'isosurfaces': 10}
+    unit = 'cells'
+
+    def setup(self):
+        from paraview import simple
+        self.wavelet = _wavelet(self.params['dimension'])
+        self.contour = simple.Contour(Input=self.wavelet, ContourBy=['POINTS', 'RTData'],
+                                      Isosurfaces=_isosurfaces(self.params['isosurfaces'], 0))
+        self.view = simple.CreateRenderView()
+        simple.Show(self.contour, self.view)
+        simple.Render(self.view)
+
+    def prepare(self, index):
+        self.contour.Isosurfaces = _isosurfaces(self.params['isosurfaces'], index + 1)
+        self.contour.UpdatePipeline()
+
+    def iteration(self, index):
+        self.view.Update()
+
+    def work(self):
+        return self.contour.GetDataInformation().GetNumberOfCells()
+
+
+@register
+class RenderScenario(Scenario):
+    name = 'render'
+    description = 'still render a contour while orbiting the camera, including compositing'
+    parameters = {'dimension': 100, 'isosurfaces': 10, 'view_size': [400, 400]}
+    unit = 'frames'
+
+    def setup(self):
+        from paraview import simple
+        wavelet = _wavelet(self.params['dimension'])
+        contour = simple.Contour(Input=wavelet, ContourBy=['POINTS', 'RTData'],
+                                 Isosurfaces=_isosurfaces(self.params['isosurfaces'], 0))
+        self.view = simple.CreateRenderView(ViewSize=self.params['view_size'])
+        simple.Show(contour, self.view)
+        simple.Render(self.view)
+
+    def prepare(self, index):
+        self.view.GetActiveCamera().Azimuth(1.0)
+
+    def iteration(self, index):
+        self.view.StillRender()
+
+
+@register
+class StateScenario(Scenario):
+    name = 'state'
+    description = 'load a state file with a chain of filters'
+    parameters = {'filters': 50}
+    unit = 'proxies'
+
+    def setup(self):
+        from paraview import simple
+        self.directory = tempfile.mkdtemp(prefix='pvbenchmark')
+        self.filename = os.path.join(self.directory, 'state.pvsm')
+        source = simple.Sphere()
+        for i in range(self.params['filters']):
+            source = simple.Calculator(Input=source, ResultArrayName='result%d' % i)
+        simple.SaveState(self.filename)
+
+    def prepare(self, index):
+        from paraview import simple
+        simple.ResetSession()
+
+    def iteration(self, index):
+        from paraview import simple
+        simple.LoadState(self.filename)
+
+    def teardown(self):
+        Scenario.teardown(self)
+        shutil.rmtree(self.directory, ignore_errors=True)
+
+    def work(self):
+        return self.params['filters'] + 1
+
+
+@register
+class RoundTripScenario(Scenario):
+    name = 'roundtrip'
+    description = 'gather a small information object from all processes'
+    parameters = {'requests': 100}
+    unit = 'requests'
+
+    def setup(self):
+        from paraview import servermanager
+        self.session = servermanager.ActiveConnection.Session
+
+    def iteration(self, index):
+        from paraview import servermanager
+        for i in range(self.params['requests']):
+            info = servermanager.vtkPVMemoryUseInformation()
+            self.session.GatherInformation(self.session.CLIENT_AND_SERVERS, info, 0)
+
+    def teardown(self):
+        pass
+
+    def work(self):
+        return self.params['requests']
+
+
+def get_memory_peak(reset=False):
+    '''Returns the largest peak resident memory, in KiB, of the client and all
+    server processes, and whether all of them could reset their peak. When
+    `reset` is true, every process resets its peak to its current memory use
+    once it has been reported.'''
+    from paraview import servermanager
+    session = servermanager.ActiveConnection.Session
+    info = servermanager.vtkPVMemoryUseInformation()
+    info.SetResetPeakMemoryUse(reset)
+    session.GatherInformation(session.CLIENT_AND_SERVERS, info, 0)
+    count = info.GetSize()
+    peak = max([info.GetProcMemoryPeak(i) for i in range(count)] or [0])
+    return peak, count > 0 and all(info.GetProcMemoryPeakReset(i) for i in range(count))
+
+
+def percentile(values, p):
+    '''Returns the p-th percentile (0 to 100) of the values, interpolating
+    between the closest ranks.'''
+    ordered = sorted(values)
+    if not ordered:
+        return float('nan')
+    position = (len(ordered) - 1) * p / 100.0
+    lower = int(math.floor(position))
+    upper = min(lower + 1, len(ordered) - 1)
+    return ordered[lower] + (ordered[upper] - ordered[lower]) * (position - lower)
+
+
+def summarize(times):
+    '''Returns the statistics of a list of timings, in seconds.'''
+    count = len(times)
+    mean = sum(times) / count
+    variance = sum((t - mean) ** 2 for t in times) / (count - 1) if count > 1 else 0.0
+    return collections.OrderedDict([
+        ('median', percentile(times, 50)),
+        ('mean', mean),
+        ('stddev', math.sqrt(variance)),
+        ('min', min(times)),
+        ('max', max(times)),
+        ('p10', percentile(times, 10)),
+        ('p90', percentile(times, 90)),
+        ('p95', percentile(times, 95))])
+
+
+def run_scenario(cls, repeat=10, warmup=2, **parameters):
+    '''Runs a scenario and returns its results as a dictionary.'''
+    scenario = cls(**parameters)
+    scenario.setup()
+    try:
+        for index in range(warmup):
+            scenario.prepare(index)
+            scenario.iteration(index)
+
+        times = []
+        _, reset = get_memory_peak(reset=True)
+        for index in range(warmup, warmup + repeat):
+            scenario.prepare(index)
+            start = time.perf_counter()
+            scenario.iteration(index)
+            times.append(time.perf_counter() - start)
+        memory, _ = get_memory_peak()
+        work = scenario.work()
+    finally:
+        scenario.teardown()
+
+    result = collections.OrderedDict()
+    result['parameters'] = scenario.params
+    result['repeat'] = repeat
+    result['warmup'] = warmup
+    result.update(summarize(times))
+    result['throughput'] = work / result['median'] if result['median'] > 0 else None
+    result['throughput_unit'] = '%s/s' % scenario.unit
+    result['memory_peak_kib'] = memory
+    result['memory_peak_scope'] = 'scenario' if reset else 'process'
+    result['times'] = times
+    return result
+
+
+def run(scenarios=None, repeat=10, warmup=2, parameters=None, verbose=True):
+    '''Runs the named scenarios, all of them by default, and returns the
+    results. `parameters` overrides the default parameters of every scenario
+    that has them.'''
+    import paraview
+    from paraview import servermanager
+
+    parameters = parameters or {}
+    connection = servermanager.ActiveConnection
+    results = collections.OrderedDict()
+    results['format'] = FORMAT_VERSION
+    results['paraview_version'] = paraview.__version_full__
+    results['python_version'] = platform.python_version()
+    results['platform'] = platform.platform()
+    results['remote'] = connection.IsRemote()
+    results['processes'] = connection.GetNumberOfDataPartitions()
+    results['scenarios'] = collections.OrderedDict()
+
+    for name in (scenarios or list(_scenarios.keys())):
+        if name not in _scenarios:
+            raise ValueError('Unknown scenario \'%s\'' % name)
+        cls = _scenarios[name]
+        overrides = dict((key, value) for key, value in parameters.items()
+                         if key in cls.parameters)
+        if verbose:
+            print('Running %s %s' % (name, overrides or ''))
+        results['scenarios'][name] = run_scenario(cls, repeat, warmup, **overrides)
+    return results
+
+
+def compare(current, baseline, tolerance=0.1, min_difference=1e-3):
+    '''Compares results against a baseline. Returns a list of dictionaries,
+    one per scenario found in both, with the relative change of the median
+    time and of the memory high-water mark. A change is flagged as a
+    regression when it exceeds `tolerance`; timings also need to differ by
+    more than `min_difference` seconds so that noise in very short scenarios is
+    not reported. Scenarios run with different parameters are reported as not
+    comparable. Memory peaks of different scopes are not compared and their
+    change is None.'''
+    comparison = []
+    for name, result in current['scenarios'].items():
+        reference = baseline['scenarios'].get(name)
+        if reference is None:
+            continue
+        entry = collections.OrderedDict([('scenario', name)])
+        if result['parameters'] != reference['parameters']:
+            entry['comparable'] = False
+            entry['regression'] = False
+            comparison.append(entry)
+            continue
+        entry['comparable'] = True
+        entry['median'] = result['median']
+        entry['baseline_median'] = reference['median']
+        entry['time_change'] = result['median'] / reference['median'] - 1.0 \
+            if reference['median'] > 0 else 0.0
+        entry['memory_peak_kib'] = result['memory_peak_kib']
+        entry['baseline_memory_peak_kib'] = reference['memory_peak_kib']
+        if result['memory_peak_scope'] != reference['memory_peak_scope']:
+            entry['memory_change'] = None
+        else:
+            entry['memory_change'] = \
+                float(result['memory_peak_kib']) / reference['memory_peak_kib'] - 1.0 \
+                if reference['memory_peak_kib'] > 0 else 0.0
+        time_regression = entry['time_change'] > tolerance and \
+            result['median'] - reference['median'] > min_difference
+        memory_regression = entry['memory_change'] is not None and \
+            entry['memory_change'] > tolerance
+        entry['regression'] = time_regression or memory_regression
+        comparison.append(entry)
+    return comparison
+
+
+def print_results(results, outfile=sys.stdout):
+    print('%-12s %12s %12s %12s %12s %20s' %
+          ('scenario', 'median (s)', 'p10 (s)', 'p90 (s)', 'peak (MiB)', 'throughput'),
+          file=outfile)
+    for name, result in results['scenarios'].items():
+        throughput = '%.4g %s' % (result['throughput'], result['throughput_unit']) \
+            if result['throughput'] is not None else '-'
+        print('%-12s %12.6f %12.6f %12.6f %12.1f %20s' %
+              (name, result['median'], result['p10'], result['p90'],
+               result['memory_peak_kib'] / 1024.0, throughput), file=outfile)
+
+
+def print_comparison(comparison, outfile=sys.stdout):
+    print('%-12s %12s %12s %12s %12s' %
+          ('scenario', 'median (s)', 'baseline (s)', 'time', 'memory'), file=outfile)
+    for entry in comparison:
+        if not entry['comparable']:
+            print('%-12s (not comparable, parameters differ)' % entry['scenario'], file=outfile)
+            continue
+        memory = '%+11.1f%%' % (100.0 * entry['memory_change']) \
+            if entry['memory_change'] is not None else '%12s' % '-'
+        print('%-12s %12.6f %12.6f %+11.1f%% %s%s' %
+              (entry['scenario'], entry['median'], entry['baseline_median'],
+               100.0 * entry['time_change'], memory,
+               '  REGRESSION' if entry['regression'] else ''), file=outfile)
+
+
+def load_results(filename):
+    with open(filename, 'r') as f:
+        results = json.load(f)
+    if results.get('format') != FORMAT_VERSION:
+        raise ValueError('%s: unsupported results format' % filename)
+    return results
+
+
+def save_results(results, filename):
+    with open(filename, 'w') as f:
+        json.dump(results, f, indent=2)
+
+
+def _parse_parameter(text):
+    import ast
+    name, _, value = text.partition('=')
+    try:
+        return name, ast.literal_eval(value)
+    except (ValueError, SyntaxError):
+        return name, value
+
+
+def main(argv):
+    import argparse
+    parser = argparse.ArgumentParser(
+        description='Run the ParaView benchmark suite')
+    parser.add_argument('-l', '--list', action='store_true',
+                        help='List the scenarios and their parameters')
+    parser.add_argument('-s', '--scenario', action='append', dest='scenarios',
+                        help='Scenario to run (may be repeated, default is all)')
+    parser.add_argument('-p', '--parameter', action='append', default=[],
+                        type=_parse_parameter,
+                        help='Override a scenario parameter, e.g. dimension=200')
+    parser.add_argument('-r', '--repeat', default=10, type=int,
+                        help='Number of timed iterations')
+    parser.add_argument('-w', '--warmup', default=2, type=int,
+                        help='Number of iterations run before timing')
+    parser.add_argument('-o', '--output', type=str,
+                        help='JSON file to write the results to')
+    parser.add_argument('-b', '--baseline', type=str,
+                        help='JSON file with baseline results to compare against')
+    parser.add_argument('-t', '--tolerance', default=0.1, type=float,
+                        help='Relative change above which a regression is reported')
+    parser.add_argument('--compare', nargs=2, metavar=('RESULTS', 'BASELINE'),
+                        help='Compare two result files without running anything')
+
+    args = parser.parse_args(argv)
+
+    if args.list:
+        for name, cls in _scenarios.items():
+            print('%-12s %s' % (name, cls.description))
+            print('%-12s parameters: %s' % ('', cls.parameters))
+        return 0
+
+    if args.compare:
+        comparison = compare(load_results(args.compare[0]), load_results(args.compare[1]),
+                             args.tolerance)
+        print_comparison(comparison)
+        return 1 if any(entry['regression'] for entry in comparison) else 0
+
+    from paraview import servermanager
+    from paraview.simple import Connect
+
+    servermanager.SetProgressPrintingEnabled(0)
+    options = servermanager.vtkRemotingCoreConfiguration.GetInstance()
+    url = options.GetServerURL()
+    if url:
+        import re
+        m = re.match('([^:/]*://)?([^:]*)(:([0-9]+))?', url)
+        if m.group(4):
+            Connect(m.group(2), m.group(4))
+        else:
+            Connect(m.group(2))
+    elif not servermanager.ActiveConnection:
+        Connect()
+
+    results = run(args.scenarios, args.repeat, args.warmup, dict(args.parameter))
+    print_results(results)
+    if args.output:
+        save_results(results, args.output)
+
+    if args.baseline:
+        comparison = compare(results, load_results(args.baseline), args.tolerance)
+        print_comparison(comparison)
+        return 1 if any(entry['regression'] for entry in comparison) else 0
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))